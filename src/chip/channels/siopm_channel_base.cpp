@@ -21,6 +21,13 @@ static const int kInstrumentGainDbMin = -70;
 static const int kInstrumentGainDbMax = 6;
 static const int kInstrumentGainDbDefault = 0;
 
+static const double kIdleThresholdDbMin = -120.0;
+static const double kIdleThresholdDbMax = -20.0;
+static const double kIdleThresholdDbDefault = -72.0;
+static const double kIdleHoldTimeDefault = 50.0;
+// Output has to rise this far above the threshold (~6dB) to restart the hold time.
+static const double kIdleHysteresisRatio = 2.0;
+
 static inline double _db_to_linear(double p_db) {
 	return std::pow(10.0, p_db / 20.0);
 }
@@ -161,6 +168,84 @@ void SiOPMChannelBase::set_pan(int p_value) {
 	_pan = CLAMP(p_value, -64, 64) + 64;
 }
 
+// Control rate.
+
+int SiOPMChannelBase::_get_control_block_size() const {
+	return _audio_rate_modulation ? 0 : _sound_chip->get_control_block_size();
+}
+
+// Idle detection.
+
+void SiOPMChannelBase::set_idle_threshold_db(double p_db) {
+	_idle_threshold_db = CLAMP(p_db, kIdleThresholdDbMin, kIdleThresholdDbMax);
+	_idle_threshold = _db_to_linear(_idle_threshold_db);
+}
+
+void SiOPMChannelBase::set_idle_hold_time(double p_ms) {
+	_idle_hold_time = MAX(p_ms, 0.0);
+}
+
+static inline int _pipe_peak(SinglyLinkedList<int>::Element *p_buffer_start, int p_length) {
+	int peak = 0;
+	SinglyLinkedList<int>::Element *target = p_buffer_start;
+	for (int i = 0; i < p_length; i++) {
+		const int value = target->value < 0 ? -target->value : target->value;
+		if (value > peak) {
+			peak = value;
+		}
+		target = target->next();
+	}
+	return peak;
+}
+
+void SiOPMChannelBase::_report_idle_peak(SinglyLinkedList<int>::Element *p_buffer_start, int p_length) {
+	const int peak = _pipe_peak(p_buffer_start, p_length);
+	_report_idle_peak_normalized(peak * (1.0 / (1 << SiOPMRefTable::LOG_VOLUME_BITS)), p_length);
+}
+
+void SiOPMChannelBase::_report_idle_peak_stereo(SinglyLinkedList<int>::Element *p_left_start, SinglyLinkedList<int>::Element *p_right_start, int p_length) {
+	const int peak = MAX(_pipe_peak(p_left_start, p_length), _pipe_peak(p_right_start, p_length));
+	_report_idle_peak_normalized(peak * (1.0 / (1 << SiOPMRefTable::LOG_VOLUME_BITS)), p_length);
+}
+
+void SiOPMChannelBase::_report_idle_peak_normalized(double p_peak, int p_length) {
+	if (p_peak > _idle_block_peak) {
+		_idle_block_peak = p_peak;
+	}
+	_idle_block_samples += p_length;
+}
+
+void SiOPMChannelBase::_reset_idle_detector() {
+	_idle_block_peak = 0.0;
+	_idle_block_samples = 0;
+	_idle_quiet_samples = 0;
+	_is_decayed = false;
+}
+
+bool SiOPMChannelBase::_update_idle_detector() {
+	if (_is_note_on || _kill_fade_remaining_samples > 0) {
+		// Held notes never decay, and hard stops finish on their own.
+		_idle_quiet_samples = 0;
+		_is_decayed = false;
+	} else if (_idle_block_samples > 0) {
+		if (_idle_block_peak < _idle_threshold) {
+			_idle_quiet_samples += _idle_block_samples;
+		} else if (_idle_block_peak > _idle_threshold * kIdleHysteresisRatio) {
+			_idle_quiet_samples = 0;
+		}
+
+		const int sampling_rate = _table ? _table->sampling_rate : 44100;
+		_is_decayed = _idle_quiet_samples >= (int)(_idle_hold_time * sampling_rate * 0.001);
+	}
+	if (_idle_block_samples > 0) {
+		_output_level = _idle_block_peak;
+	}
+
+	_idle_block_peak = 0.0;
+	_idle_block_samples = 0;
+	return _is_decayed;
+}
+
 //
 
 void SiOPMChannelBase::set_filter_type(int p_type) {
@@ -350,7 +435,7 @@ void SiOPMChannelBase::set_output(OutputMode p_output_mode, int p_pipe_index) {
 	_base_pipe = (_output_mode == OutputMode::OUTPUT_ADD ? _out_pipe : _sound_chip->get_zero_buffer());
 }
 
-void SiOPMChannelBase::set_volume_tables(int (&p_velocity_table)[SiOPMRefTable::TL_TABLE_SIZE], int (&p_expression_table)[SiOPMRefTable::TL_TABLE_SIZE]) {
+void SiOPMChannelBase::set_volume_tables(const int (&p_velocity_table)[SiOPMRefTable::TL_TABLE_SIZE], const int (&p_expression_table)[SiOPMRefTable::TL_TABLE_SIZE]) {
 	COPY_TL_TABLE(_velocity_table, p_velocity_table);
 	COPY_TL_TABLE(_expression_table, p_expression_table);
 }
@@ -431,6 +516,8 @@ void SiOPMChannelBase::note_on() {
 	// the channel while the new note is starting, causing missing attacks/dropped notes.
 	cancel_kill_fade();
 
+	_reset_idle_detector();
+
 	_lfo_phase = 0; // Reset.
 	if (_filter_on) {
 		_reset_sv_filter_state();
@@ -478,6 +565,10 @@ void SiOPMChannelBase::reset_channel_buffer_status() {
 	// into the output pipes from the beginning of the next audio frame.
 	_buffer_index = 0;
 
+	if (_update_idle_detector()) {
+		_is_idling = true;
+	}
+
 	// Reset read/write cursors for all pipes that the channel may use.
 	if (_in_pipe) {
 		_in_pipe->front();
@@ -677,6 +768,7 @@ void SiOPMChannelBase::buffer(int p_length) {
 	if (_kill_fade_remaining_samples > 0) {
 		_apply_kill_fade(mono_out, p_length);
 	}
+	_report_idle_peak(mono_out, p_length);
 
 	if (_output_mode == OutputMode::OUTPUT_STANDARD && !_mute) {
 		const bool is_redirected_main_stream = (_streams[0] != nullptr && _streams[0] != _sound_chip->get_output_stream());
@@ -720,11 +812,16 @@ void SiOPMChannelBase::initialize(SiOPMChannelBase *p_prev, int p_buffer_index)
 
 		_instrument_gain = p_prev->_instrument_gain;
 		_instrument_gain_db = p_prev->_instrument_gain_db;
+		_idle_threshold_db = p_prev->_idle_threshold_db;
+		_idle_threshold = p_prev->_idle_threshold;
+		_idle_hold_time = p_prev->_idle_hold_time;
+		_audio_rate_modulation = p_prev->_audio_rate_modulation;
 		_pan = p_prev->_pan;
 		_has_effect_send = p_prev->_has_effect_send;
 		_mute = p_prev->_mute;
 		COPY_TL_TABLE(_velocity_table, p_prev->_velocity_table);
 		COPY_TL_TABLE(_expression_table, p_prev->_expression_table);
+		set_ref_stencil(p_prev->_ref_stencil);
 	} else if (!p_prev) {
 		_volumes.write[0] = 0.5;
 		_streams.write[0] = nullptr;
@@ -734,16 +831,22 @@ void SiOPMChannelBase::initialize(SiOPMChannelBase *p_prev, int p_buffer_index)
 		}
 
 		set_instrument_gain_db(kInstrumentGainDbDefault);
+		set_idle_threshold_db(kIdleThresholdDbDefault);
+		set_idle_hold_time(kIdleHoldTimeDefault);
+		_audio_rate_modulation = false;
 		_pan = 64;
 		_has_effect_send = false;
 		_mute = false;
 		COPY_TL_TABLE(_velocity_table, _table->eg_total_level_tables[SiOPMRefTable::VM_LINEAR]);
 		COPY_TL_TABLE(_expression_table, _table->eg_total_level_tables[SiOPMRefTable::VM_LINEAR]);
+		set_ref_stencil(nullptr);
 	}
 
 	// Buffer index.
 	_is_note_on = false;
 	_is_idling = true;
+	_reset_idle_detector();
+	_output_level = 0.0;
 	_buffer_index = p_buffer_index;
 
 	// LFO.
@@ -773,6 +876,7 @@ void SiOPMChannelBase::reset() {
 	_is_note_on = false;
 	_is_idling = true;
 	cancel_kill_fade();
+	_reset_idle_detector();
 }
 
 String SiOPMChannelBase::_to_string() const {
@@ -801,10 +905,16 @@ void SiOPMChannelBase::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_master_volume", "value"), &SiOPMChannelBase::set_master_volume);
 	ClassDB::bind_method(D_METHOD("get_master_volume_linear"), &SiOPMChannelBase::get_master_volume_linear);
 	ClassDB::bind_method(D_METHOD("set_master_volume_linear", "value"), &SiOPMChannelBase::set_master_volume_linear);
+	// Idle detection
+	ClassDB::bind_method(D_METHOD("get_idle_threshold_db"), &SiOPMChannelBase::get_idle_threshold_db);
+	ClassDB::bind_method(D_METHOD("set_idle_threshold_db", "db"), &SiOPMChannelBase::set_idle_threshold_db);
+	ClassDB::bind_method(D_METHOD("get_idle_hold_time"), &SiOPMChannelBase::get_idle_hold_time);
+	ClassDB::bind_method(D_METHOD("set_idle_hold_time", "ms"), &SiOPMChannelBase::set_idle_hold_time);
+	ClassDB::bind_method(D_METHOD("is_decayed"), &SiOPMChannelBase::is_decayed);
 }
 
 SiOPMChannelBase::SiOPMChannelBase(SiOPMSoundChip *p_chip) {
-	_table = SiOPMRefTable::get_instance();
+	_table = p_chip ? p_chip->get_ref_table() : SiOPMRefTable::get_instance();
 	_sound_chip = p_chip;
 	_process_function = Callable(this, "_no_process");
 
@@ -813,6 +923,7 @@ SiOPMChannelBase::SiOPMChannelBase(SiOPMSoundChip *p_chip) {
 	_volumes.clear();
 	_volumes.resize_zeroed(SiOPMSoundChip::STREAM_SEND_SIZE);
 	set_instrument_gain_db(kInstrumentGainDbDefault);
+	set_idle_threshold_db(kIdleThresholdDbDefault);
 }
 
 SiOPMChannelBase::~SiOPMChannelBase() {
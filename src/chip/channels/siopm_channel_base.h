@@ -74,6 +74,8 @@ protected:
 
 	SiOPMRefTable *_table = nullptr;
 	SiOPMSoundChip *_sound_chip = nullptr;
+	// Tables of the sequence data played by the owning track, if any.
+	const SiOPMRefStencil *_ref_stencil = nullptr;
 
 	Callable _process_function;
 
@@ -88,6 +90,36 @@ protected:
 	int _kill_fade_total_samples = 0;
 	int _kill_fade_remaining_samples = 0;
 
+	// Control-rate modulation.
+	// When the chip has a control block size, channels that support it advance their LFO
+	// and envelopes once per block and ramp linearly inside it. Voices that rely on
+	// audio-rate envelope behavior opt out.
+	bool _audio_rate_modulation = false;
+
+	// The control block size this channel should use, 0 for audio rate.
+	int _get_control_block_size() const;
+
+	// Energy-based idle detection.
+	// Channels report the peak of everything they render. Once a voice is released and
+	// its output stays under the threshold for the hold time, it is considered decayed
+	// and falls back to buffer_no_process() until the next note.
+	double _idle_threshold_db = -72.0;
+	double _idle_threshold = 0.0; // Linear, relative to the pipe full scale.
+	double _idle_hold_time = 50.0; // In milliseconds.
+	double _idle_block_peak = 0.0;
+	int _idle_block_samples = 0;
+	int _idle_quiet_samples = 0;
+	bool _is_decayed = false;
+	// Peak of the last evaluated block, kept for voice stealing.
+	double _output_level = 0.0;
+
+	void _report_idle_peak(SinglyLinkedList<int>::Element *p_buffer_start, int p_length);
+	void _report_idle_peak_stereo(SinglyLinkedList<int>::Element *p_left_start, SinglyLinkedList<int>::Element *p_right_start, int p_length);
+	void _report_idle_peak_normalized(double p_peak, int p_length);
+	void _reset_idle_detector();
+	// Evaluates the previous block, must be called once from reset_channel_buffer_status().
+	bool _update_idle_detector();
+
 	// Pipe buffer.
 
 	int _buffer_index = 0;
@@ -177,6 +209,8 @@ public:
 	virtual void set_channel_params(const Ref<SiOPMChannelParams> &p_params, bool p_with_volume, bool p_with_modulation = true) {}
 
 	virtual void set_wave_data(const Ref<SiOPMWaveBase> &p_wave_data) {}
+	const SiOPMRefStencil *get_ref_stencil() const { return _ref_stencil; }
+	virtual void set_ref_stencil(const SiOPMRefStencil *p_stencil) { _ref_stencil = p_stencil; }
 	virtual void set_channel_number(int p_value) {}
 	virtual void set_register(int p_address, int p_data) {}
 
@@ -219,6 +253,16 @@ public:
 	virtual int64_t get_reported_source_sample() const { return -1; }
 	virtual double get_reported_clip_time_steps() const { return -1.0; }
 
+	double get_idle_threshold_db() const { return _idle_threshold_db; }
+	void set_idle_threshold_db(double p_db);
+	double get_idle_hold_time() const { return _idle_hold_time; }
+	void set_idle_hold_time(double p_ms);
+	bool is_decayed() const { return _is_decayed; }
+	double get_output_level() const { return _output_level; }
+
+	bool is_audio_rate_modulation() const { return _audio_rate_modulation; }
+	void set_audio_rate_modulation(bool p_enabled) { _audio_rate_modulation = p_enabled; }
+
 	virtual bool is_filter_active() const { return _filter_on; }
 	virtual int get_filter_type() const { return _filter_type; }
 	virtual void set_filter_type(int p_type);
@@ -254,7 +298,7 @@ public:
 	virtual void set_input(int p_level, int p_pipe_index);
 	virtual void set_ring_modulation(int p_level, int p_pipe_index);
 	virtual void set_output(OutputMode p_output_mode, int p_pipe_index);
-	virtual void set_volume_tables(int (&p_velocity_table)[SiOPMRefTable::TL_TABLE_SIZE], int (&p_expression_table)[SiOPMRefTable::TL_TABLE_SIZE]);
+	virtual void set_volume_tables(const int (&p_velocity_table)[SiOPMRefTable::TL_TABLE_SIZE], const int (&p_expression_table)[SiOPMRefTable::TL_TABLE_SIZE]);
 
 	// Processing.
 
@@ -264,6 +308,7 @@ public:
 	virtual void start_kill_fade(int p_samples = -1);
 	// Cancel any pending hard-stop fade (e.g. when reusing a channel for a new note).
 	virtual void cancel_kill_fade();
+	bool is_kill_fading() const { return _kill_fade_remaining_samples > 0; }
 
 	virtual void reset_channel_buffer_status();
 	virtual void buffer(int p_length);
@@ -40,7 +40,7 @@ SiOPMOperator *SiOPMChannelFM::_alloc_operator() {
 		_operator_pool.pop_back();
 		if (op != nullptr) {
 			// Pooled operators survive driver rebuilds. Refresh both the owning
-			// sound chip and the global ref-table-backed caches before reuse so
+			// sound chip and the ref-table-backed caches before reuse so
 			// subsequent initialize() calls rebuild pitch math at the new rate.
 			// from a trivial inline setter into a real implementation in siopm_operator.cpp (line 870) 
 			op->update_sound_chip(_sound_chip);
@@ -140,6 +140,7 @@ void SiOPMChannelFM::get_channel_params(const Ref<SiOPMChannelParams> &p_params)
 	}
 	p_params->set_instrument_gain_db(get_instrument_gain_db());
 	p_params->set_pan(_pan);
+	p_params->set_audio_rate_modulation(_audio_rate_modulation);
 
 	for (int i = 0; i < _operator_count; i++) {
 		_operators[i]->get_operator_params(p_params->get_operator_params(i));
@@ -154,73 +155,53 @@ void SiOPMChannelFM::get_channel_params(const Ref<SiOPMChannelParams> &p_params)
 	p_params->set_carrier_mask(mask);
 }
 
-void SiOPMChannelFM::_apply_common_channel_params(const Ref<SiOPMChannelParams> &p_params, bool p_with_volume, bool p_with_modulation) {
-	set_frequency_ratio(p_params->get_envelope_frequency_ratio());
+void SiOPMChannelFM::_apply_common_channel_params(const SiOPMChannelProgram &p_program, bool p_with_volume, bool p_with_modulation) {
+	set_frequency_ratio(p_program.envelope_frequency_ratio);
 
 	if (p_with_modulation) {
-		initialize_lfo(p_params->get_lfo_wave_shape());
-
-		set_lfo_time_mode(p_params->get_lfo_time_mode());
-		switch (p_params->get_lfo_time_mode()) {
-			case LFO_TIME_MODE_RATE:
-				set_lfo_frequency_step(p_params->get_lfo_rate_value());
-				break;
-			case LFO_TIME_MODE_TIME:
-				set_lfo_frequency_step(p_params->get_lfo_time_value());
-				break;
-			default:
-				set_lfo_frequency_step(p_params->get_lfo_beat_value());
-				break;
-		}
+		initialize_lfo(p_program.lfo_wave_shape);
+
+		set_lfo_time_mode(p_program.lfo_time_mode);
+		set_lfo_frequency_step(p_program.lfo_frequency_step);
 
-		set_amplitude_modulation(p_params->get_amplitude_modulation_depth());
-		set_pitch_modulation(p_params->get_pitch_modulation_depth());
+		set_amplitude_modulation(p_program.amplitude_modulation_depth);
+		set_pitch_modulation(p_program.pitch_modulation_depth);
+		set_audio_rate_modulation(p_program.audio_rate_modulation);
 	}
 
 	if (p_with_volume) {
+		double *volumes = _volumes.ptrw();
 		for (int i = 0; i < SiOPMSoundChip::STREAM_SEND_SIZE; i++) {
-			_volumes.write[i] = p_params->get_master_volume(i);
-		}
-
-		_has_effect_send = false;
-		for (int i = 1; i < SiOPMSoundChip::STREAM_SEND_SIZE; i++) {
-			if (_volumes[i] > 0) {
-				_has_effect_send = true;
-				break;
-			}
+			volumes[i] = p_program.master_volumes[i];
 		}
 
-		_pan = p_params->get_pan();
+		_has_effect_send = p_program.has_effect_send;
+		_pan = p_program.pan;
 	}
-	set_instrument_gain_db(p_params->get_instrument_gain_db());
-
-	_filter_type = p_params->get_filter_type();
-	{
-		int filter_cutoff = p_params->get_filter_cutoff();
-		int filter_resonance = p_params->get_filter_resonance();
-		int filter_ar = p_params->get_filter_attack_rate();
-		int filter_dr1 = p_params->get_filter_decay_rate1();
-		int filter_dr2 = p_params->get_filter_decay_rate2();
-		int filter_rr = p_params->get_filter_release_rate();
-		int filter_dc1 = p_params->get_filter_decay_offset1();
-		int filter_dc2 = p_params->get_filter_decay_offset2();
-		int filter_sc = p_params->get_filter_sustain_offset();
-		int filter_rc = p_params->get_filter_release_offset();
-		set_sv_filter(filter_cutoff, filter_resonance, filter_ar, filter_dr1, filter_dr2, filter_rr, filter_dc1, filter_dc2, filter_sc, filter_rc);
+	if (p_program.instrument_gain_db != _instrument_gain_db) {
+		set_instrument_gain_db(p_program.instrument_gain_db);
 	}
+
+	_filter_type = p_program.filter_type;
+	set_sv_filter(p_program.filter_cutoff, p_program.filter_resonance, p_program.filter_attack_rate, p_program.filter_decay_rate1, p_program.filter_decay_rate2, p_program.filter_release_rate, p_program.filter_decay_offset1, p_program.filter_decay_offset2, p_program.filter_sustain_offset, p_program.filter_release_offset);
 }
 
 void SiOPMChannelFM::set_channel_params(const Ref<SiOPMChannelParams> &p_params, bool p_with_volume, bool p_with_modulation) {
-	if (p_params->get_operator_count() == 0) {
+	set_channel_program(p_params->get_program(), p_with_volume, p_with_modulation);
+}
+
+void SiOPMChannelFM::set_channel_program(const SiOPMChannelProgram &p_program, bool p_with_volume, bool p_with_modulation) {
+	if (p_program.operator_count == 0) {
 		return;
 	}
 
-	set_algorithm(p_params->get_operator_count(), p_params->is_analog_like(), p_params->get_algorithm());
-	set_feedback(p_params->get_feedback(), p_params->get_feedback_connection());
-	_apply_common_channel_params(p_params, p_with_volume, p_with_modulation);
+	// Rewiring is skipped by set_algorithm() itself when the layout doesn't change.
+	set_algorithm(p_program.operator_count, p_program.analog_like, p_program.algorithm);
+	set_feedback(p_program.feedback, p_program.feedback_connection);
+	_apply_common_channel_params(p_program, p_with_volume, p_with_modulation);
 
 	for (int i = 0; i < _operator_count; i++) {
-		_operators[i]->set_operator_params(p_params->get_operator_params(i));
+		_operators[i]->set_operator_program(p_program.operators[i]);
 	}
 }
 
@@ -289,6 +270,16 @@ void SiOPMChannelFM::set_wave_data(const Ref<SiOPMWaveBase> &p_wave_data) {
 	}
 }
 
+void SiOPMChannelFM::set_ref_stencil(const SiOPMRefStencil *p_stencil) {
+	SiOPMChannelBase::set_ref_stencil(p_stencil);
+
+	for (SiOPMOperator *op : _operators) {
+		if (op) {
+			op->set_ref_stencil(p_stencil);
+		}
+	}
+}
+
 void SiOPMChannelFM::set_channel_number(int p_value) {
 	_register_map_channel = p_value;
 }
@@ -683,7 +674,7 @@ void SiOPMChannelFM::set_parameters(Vector<int> p_params) {
 
 void SiOPMChannelFM::set_types(int p_pg_type, SiONPitchTableType p_pt_type) {
 	if (p_pg_type >= SiONPulseGeneratorType::PULSE_PCM) {
-		Ref<SiOPMWavePCMTable> pcm_table = _table->get_pcm_data(p_pg_type - SiONPulseGeneratorType::PULSE_PCM);
+		Ref<SiOPMWavePCMTable> pcm_table = _table->get_pcm_data(p_pg_type - SiONPulseGeneratorType::PULSE_PCM, _ref_stencil);
 		if (pcm_table.is_valid()) {
 			set_wave_data(pcm_table);
 		}
@@ -908,7 +899,26 @@ void SiOPMChannelFM::_update_lfo(int p_op_count) {
 	}
 
 	_lfo_phase = (_lfo_phase + 1) & 255;
+	_update_lfo_output(p_op_count);
 
+	_lfo_timer += _lfo_timer_initial;
+}
+
+void SiOPMChannelFM::_update_lfo_block(int p_op_count, int p_length) {
+	_lfo_timer -= _lfo_timer_step * p_length;
+	if (_lfo_timer >= 0) {
+		return;
+	}
+
+	// Same number of steps as p_length calls to _update_lfo(), at most one per sample.
+	for (int i = 0; i < p_length && _lfo_timer < 0; i++) {
+		_lfo_phase = (_lfo_phase + 1) & 255;
+		_lfo_timer += _lfo_timer_initial;
+	}
+	_update_lfo_output(p_op_count);
+}
+
+void SiOPMChannelFM::_update_lfo_output(int p_op_count) {
 	int value_base = _lfo_wave_table[_lfo_phase];
 	_amplitude_modulation_output_level = (value_base * _amplitude_modulation_depth) >> 7 << 3;
 	_pitch_modulation_output_level = (((value_base << 1) - 255) * _pitch_modulation_depth) >> 8;
@@ -925,8 +935,6 @@ void SiOPMChannelFM::_update_lfo(int p_op_count) {
 	if (p_op_count > 3 && _operators[3]) {
 		_operators[3]->set_pm_detune(_pitch_modulation_output_level);
 	}
-
-	_lfo_timer += _lfo_timer_initial;
 }
 
 void SiOPMChannelFM::_process_operator1_lfo_off(int p_length) {
@@ -1297,6 +1305,86 @@ void SiOPMChannelFM::_process_operator4(int p_length) {
 	_out_pipe->set(out_pipe);
 }
 
+void SiOPMChannelFM::_process_control_rate(int p_length, int p_block_size) {
+	SinglyLinkedList<int>::Element *in_pipe   = _in_pipe->get();
+	SinglyLinkedList<int>::Element *base_pipe = _base_pipe->get();
+	SinglyLinkedList<int>::Element *out_pipe  = _out_pipe->get();
+
+	const int op_count = _operator_count;
+	SiOPMOperator *ops[4] = { _operators[0], _operators[1], _operators[2], _operators[3] };
+	int am_shifts[4] = {};
+	for (int i = 0; i < op_count; i++) {
+		am_shifts[i] = ops[i]->get_amplitude_modulation_shift();
+	}
+	// Like _process_operator1_lfo_off(), a single operator ignores the LFO when it is off.
+	const bool lfo_enabled = op_count > 1 || _lfo_on;
+
+	for (int offset = 0; offset < p_length; offset += p_block_size) {
+		const int block_length = MIN(p_block_size, p_length - offset);
+
+		// Update LFO and EG for the whole block, then ramp towards the new values.
+		int am_ramp = 0;
+		int am_ramp_step = 0;
+		if (lfo_enabled) {
+			const int am_start = _amplitude_modulation_output_level;
+			_update_lfo_block(op_count, block_length);
+			am_ramp = am_start << CONTROL_RAMP_BITS;
+			am_ramp_step = (_amplitude_modulation_output_level - am_start) * (1 << CONTROL_RAMP_BITS) / block_length;
+		}
+		for (int i = 0; i < op_count; i++) {
+			ops[i]->tick_eg_block(_eg_timer_initial, block_length);
+		}
+
+		for (int j = 0; j < block_length; j++) {
+			am_ramp += am_ramp_step;
+			const int am_level = am_ramp >> CONTROL_RAMP_BITS;
+
+			if (op_count == 1) {
+				SiOPMOperator *ope0 = ops[0];
+				ope0->tick_eg_ramp();
+				ope0->tick_pulse_generator();
+				int output = ope0->get_super_output(in_pipe->value, _input_level, am_level >> am_shifts[0]);
+
+				ope0->get_feed_pipe()->get()->value = output;
+				out_pipe->value = output + base_pipe->value;
+			} else {
+				// Clear pipes.
+				_pipe0->get()->value = 0;
+				_pipe1->get()->value = 0;
+
+				for (int i = 0; i < op_count; i++) {
+					SiOPMOperator *ope = ops[i];
+					ope->tick_eg_ramp();
+					ope->tick_pulse_generator();
+
+					// Operator 0 takes the channel input, the others their own in pipe.
+					int output = (i == 0)
+							? ope->get_super_output(in_pipe->value, _input_level, am_level >> am_shifts[i])
+							: ope->get_super_output(ope->get_in_pipe()->get()->value, ope->get_fm_shift(), am_level >> am_shifts[i]);
+
+					ope->get_feed_pipe()->get()->value = output;
+					ope->get_out_pipe()->get()->value  = output + ope->get_base_pipe()->get()->value;
+				}
+
+				out_pipe->value = _pipe0->get()->value + base_pipe->value;
+			}
+
+			// Increment pointers.
+			in_pipe = in_pipe->next();
+			base_pipe = base_pipe->next();
+			out_pipe = out_pipe->next();
+		}
+
+		for (int i = 0; i < op_count; i++) {
+			ops[i]->end_eg_ramp();
+		}
+	}
+
+	_in_pipe->set(in_pipe);
+	_base_pipe->set(base_pipe);
+	_out_pipe->set(out_pipe);
+}
+
 void SiOPMChannelFM::_process_pcm_lfo_off(int p_length) {
 	SinglyLinkedList<int>::Element *in_pipe   = _in_pipe->get();
 	SinglyLinkedList<int>::Element *base_pipe = _base_pipe->get();
@@ -1623,6 +1711,10 @@ void SiOPMChannelFM::reset_channel_buffer_status() {
 			break;
 		}
 	}
+	// Operators in a long release stay above the EG threshold well after they become inaudible.
+	if (_update_idle_detector()) {
+		_is_idling = true;
+	}
 
 	// Reset stereo pipe cursors.
 	if (_stereo_left_pipe) {
@@ -1639,6 +1731,12 @@ void SiOPMChannelFM::buffer(int p_length) {
 		return;
 	}
 
+	// Follow the chip's super voice limit, which changes with the render quality.
+	const int super_voice_limit = _sound_chip->get_super_voice_limit();
+	for (int i = 0; i < _operator_count; i++) {
+		_operators[i]->set_super_voice_limit(super_voice_limit);
+	}
+
 	bool stereo_mode = _is_stereo_super_mode();
 
 	// Preserve the start of the output pipes.
@@ -1651,39 +1749,53 @@ void SiOPMChannelFM::buffer(int p_length) {
 	// atomically via _update_process_function(), so no validity check needed.
 	// The validity check itself was causing crashes due to Callable internal state
 	// access from the audio thread during concurrent updates.
-	_process_function.call(p_length);
+	const int control_block_size = _get_control_block_size();
+	if (control_block_size > 0 && !stereo_mode && _process_function_type <= PROCESS_OP4) {
+		_process_control_rate(p_length, control_block_size);
+	} else {
+		_process_function.call(p_length);
+	}
+
+	_post_process_buffer(mono_out, left_start, right_start, stereo_mode, p_length);
+}
 
+void SiOPMChannelFM::_post_process_buffer(SinglyLinkedList<int>::Element *p_mono_out, SinglyLinkedList<int>::Element *p_left_start, SinglyLinkedList<int>::Element *p_right_start, bool p_stereo_mode, int p_length) {
 	if (_ring_pipe) {
-		if (stereo_mode) {
+		if (p_stereo_mode) {
 			// Both stereo sides must use the same ring-mod source block; only advance the
 			// shared pipe cursor once after processing the pair.
 			SinglyLinkedList<int>::Element *ring_start = _ring_pipe->get();
-			_apply_ring_modulation(left_start, p_length);
+			_apply_ring_modulation(p_left_start, p_length);
 			_ring_pipe->set(ring_start);
-			_apply_ring_modulation(right_start, p_length);
+			_apply_ring_modulation(p_right_start, p_length);
 		} else {
-			_apply_ring_modulation(mono_out, p_length);
+			_apply_ring_modulation(p_mono_out, p_length);
 		}
 	}
 	if (_filter_on) {
-		if (stereo_mode) {
-			_apply_sv_filter(left_start, p_length, _filter_variables);
-			_apply_sv_filter(right_start, p_length, _filter_variables2);
+		if (p_stereo_mode) {
+			_apply_sv_filter(p_left_start, p_length, _filter_variables);
+			_apply_sv_filter(p_right_start, p_length, _filter_variables2);
 		} else {
-			_apply_sv_filter(mono_out, p_length, _filter_variables);
+			_apply_sv_filter(p_mono_out, p_length, _filter_variables);
 		}
 	}
 	if (_kill_fade_remaining_samples > 0) {
-		if (stereo_mode) {
-			_apply_kill_fade_stereo(left_start, right_start, p_length);
+		if (p_stereo_mode) {
+			_apply_kill_fade_stereo(p_left_start, p_right_start, p_length);
 		} else {
-			_apply_kill_fade(mono_out, p_length);
+			_apply_kill_fade(p_mono_out, p_length);
 		}
 	}
+	if (p_stereo_mode) {
+		_report_idle_peak_stereo(p_left_start, p_right_start, p_length);
+	} else {
+		_report_idle_peak(p_mono_out, p_length);
+	}
 
 	if (_output_mode == OutputMode::OUTPUT_STANDARD && !_mute) {
 		const bool is_redirected_main_stream = (_streams[0] != nullptr && _streams[0] != _sound_chip->get_output_stream());
-		if (stereo_mode) {
+		if (p_stereo_mode) {
 			// Stereo super mode: write left/right channels separately.
 			if (_has_effect_send) {
 				for (int i = 0; i < SiOPMSoundChip::STREAM_SEND_SIZE; i++) {
@@ -1692,7 +1804,7 @@ void SiOPMChannelFM::buffer(int p_length) {
 						if (stream) {
 							const double volume = (i == 0 && is_redirected_main_stream) ? _instrument_gain : (_volumes[i] * _instrument_gain);
 							const int pan = (i == 0 && is_redirected_main_stream) ? SiOPMStream::PAN_NONE : _pan;
-							stream->write_stereo(left_start, right_start, _buffer_index, p_length, volume, pan);
+							stream->write_stereo(p_left_start, p_right_start, _buffer_index, p_length, volume, pan);
 						}
 					}
 				}
@@ -1700,7 +1812,7 @@ void SiOPMChannelFM::buffer(int p_length) {
 				SiOPMStream *stream = _streams[0] ? _streams[0] : _sound_chip->get_output_stream();
 				const double volume = is_redirected_main_stream ? _instrument_gain : (_volumes[0] * _instrument_gain);
 				const int pan = is_redirected_main_stream ? SiOPMStream::PAN_NONE : _pan;
-				stream->write_stereo(left_start, right_start, _buffer_index, p_length, volume, pan);
+				stream->write_stereo(p_left_start, p_right_start, _buffer_index, p_length, volume, pan);
 			}
 		} else {
 			// Standard mono mode.
@@ -1711,7 +1823,7 @@ void SiOPMChannelFM::buffer(int p_length) {
 						if (stream) {
 							const double volume = (i == 0 && is_redirected_main_stream) ? _instrument_gain : (_volumes[i] * _instrument_gain);
 							const int pan = (i == 0 && is_redirected_main_stream) ? SiOPMStream::PAN_NONE : _pan;
-							stream->write(mono_out, _buffer_index, p_length, volume, pan);
+							stream->write(p_mono_out, _buffer_index, p_length, volume, pan);
 						}
 					}
 				}
@@ -1719,17 +1831,17 @@ void SiOPMChannelFM::buffer(int p_length) {
 				SiOPMStream *stream = _streams[0] ? _streams[0] : _sound_chip->get_output_stream();
 				const double volume = is_redirected_main_stream ? _instrument_gain : (_volumes[0] * _instrument_gain);
 				const int pan = is_redirected_main_stream ? SiOPMStream::PAN_NONE : _pan;
-				stream->write(mono_out, _buffer_index, p_length, volume, pan);
+				stream->write(p_mono_out, _buffer_index, p_length, volume, pan);
 			}
 		}
 	}
 
 	// Copy to meter ring (use mono mix for metering in stereo mode).
-	if (stereo_mode) {
+	if (p_stereo_mode) {
 		// For stereo mode, mix down to mono for metering.
-		SinglyLinkedList<int>::Element *left_elem = left_start;
-		SinglyLinkedList<int>::Element *right_elem = right_start;
-		SinglyLinkedList<int>::Element *mono_elem = mono_out;
+		SinglyLinkedList<int>::Element *left_elem = p_left_start;
+		SinglyLinkedList<int>::Element *right_elem = p_right_start;
+		SinglyLinkedList<int>::Element *mono_elem = p_mono_out;
 		for (int i = 0; i < p_length && left_elem && right_elem && mono_elem; i++) {
 			mono_elem->value = (left_elem->value + right_elem->value) >> 1;
 			left_elem = left_elem->next();
@@ -1739,11 +1851,11 @@ void SiOPMChannelFM::buffer(int p_length) {
 	}
 	// // Debug: inspect edge discontinuities at buffer boundaries to diagnose
 	// // clicky artefacts when new voices start (e.g. during voice stealing).
-	// if (mono_out) {
+	// if (p_mono_out) {
 	// 	// Read first and last sample in this block.
-	// 	int first_sample = mono_out->value;
+	// 	int first_sample = p_mono_out->value;
 	// 	int last_sample = first_sample;
-	// 	SinglyLinkedList<int>::Element *cursor = mono_out;
+	// 	SinglyLinkedList<int>::Element *cursor = p_mono_out;
 	// 	for (int i = 1; i < p_length && cursor; i++) {
 	// 		cursor = cursor->next();
 	// 		if (!cursor) {
@@ -1771,7 +1883,7 @@ void SiOPMChannelFM::buffer(int p_length) {
 	// 	}
 	
 	// 	// Scan for intra-buffer discontinuities
-	// 	cursor = mono_out;
+	// 	cursor = p_mono_out;
 	// 	int prev_sample = cursor->value;
 		
 	// 	for (int i = 1; i < p_length && cursor; i++) {
@@ -1795,9 +1907,9 @@ void SiOPMChannelFM::buffer(int p_length) {
 	// 		prev_sample = curr_sample;
 	// 	}
 
-	// 	int prev = mono_out->value;
+	// 	int prev = p_mono_out->value;
 	// 	int prev_delta = 0;
-	// 	cursor = mono_out->next();
+	// 	cursor = p_mono_out->next();
 
 	// 	for (int i = 1; i < p_length && cursor; i++) {
 	// 		int curr = cursor->value;
@@ -1865,6 +1977,7 @@ void SiOPMChannelFM::reset() {
 
 	_is_note_on = false;
 	_is_idling = true;
+	_reset_idle_detector();
 }
 
 String SiOPMChannelFM::_to_string() const {
@@ -14,6 +14,7 @@
 
 using namespace godot;
 
+struct SiOPMChannelProgram;
 class SiOPMOperator;
 
 // FM sound channel.
@@ -36,7 +37,10 @@ class SiOPMOperator;
 class SiOPMChannelFM : public SiOPMChannelBase {
 	GDCLASS(SiOPMChannelFM, SiOPMChannelBase)
 
+	friend class SiOPMChannelFMBatch;
+
 	static const int IDLING_THRESHOLD = 5120; // = 256(resolution)*10(2^10=1024)*2(p/n) = volume<1/1024
+	static const int CONTROL_RAMP_BITS = 12; // Fraction bits of control-rate ramps.
 
 	static List<SiOPMOperator *> _operator_pool;
 
@@ -100,6 +104,9 @@ class SiOPMChannelFM : public SiOPMChannelBase {
 	// Processing.
 
 	void _update_lfo(int p_op_count);
+	// Control rate: advance the LFO by p_length samples at once.
+	void _update_lfo_block(int p_op_count, int p_length);
+	void _update_lfo_output(int p_op_count);
 
 	void _process_operator1_lfo_off(int p_length);
 	void _process_operator1_lfo_on(int p_length);
@@ -111,12 +118,18 @@ class SiOPMChannelFM : public SiOPMChannelBase {
 	void _process_analog_like(int p_length);
 	void _process_ring(int p_length);
 	void _process_sync(int p_length);
+	// Operator 1-4 processing with LFO and EG updated once per control block.
+	void _process_control_rate(int p_length, int p_block_size);
+
+	// Everything buffer() does once the output pipes are filled: ring modulation, filter,
+	// kill fade, stream writes, and advancing the buffer index.
+	void _post_process_buffer(SinglyLinkedList<int>::Element *p_mono_out, SinglyLinkedList<int>::Element *p_left_start, SinglyLinkedList<int>::Element *p_right_start, bool p_stereo_mode, int p_length);
 
 protected:
 	static void _bind_methods();
 
 	String _to_string() const;
-	void _apply_common_channel_params(const Ref<SiOPMChannelParams> &p_params, bool p_with_volume, bool p_with_modulation);
+	void _apply_common_channel_params(const SiOPMChannelProgram &p_program, bool p_with_volume, bool p_with_modulation);
 
 	Vector<SiOPMOperator *> _operators;
 	SiOPMOperator *_active_operator = nullptr;
@@ -135,9 +148,12 @@ public:
 
 	virtual void get_channel_params(const Ref<SiOPMChannelParams> &p_params) const override;
 	virtual void set_channel_params(const Ref<SiOPMChannelParams> &p_params, bool p_with_volume, bool p_with_modulation = true) override;
+	// Apply a compiled voice program, see SiOPMChannelParams::get_program().
+	void set_channel_program(const SiOPMChannelProgram &p_program, bool p_with_volume, bool p_with_modulation = true);
 	void set_params_by_value(int p_ar, int p_dr, int p_sr, int p_rr, int p_sl, int p_tl, int p_ksr, int p_ksl, int p_mul, int p_dt1, int p_dt2, int p_ams, int p_phase, int p_fix_note);
 
 	virtual void set_wave_data(const Ref<SiOPMWaveBase> &p_wave_data) override;
+	virtual void set_ref_stencil(const SiOPMRefStencil *p_stencil) override;
 	virtual void set_channel_number(int p_value) override;
 	virtual void set_register(int p_address, int p_data) override;
 
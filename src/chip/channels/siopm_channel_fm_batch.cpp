@@ -0,0 +1,380 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#include "siopm_channel_fm_batch.h"
+
+#include "chip/channels/siopm_channel_fm.h"
+#include "chip/channels/siopm_channel_manager.h"
+#include "chip/channels/siopm_operator.h"
+#include "chip/siopm_ref_table.h"
+#include "chip/siopm_sound_chip.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SION_FM_BATCH_SSE 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SION_FM_BATCH_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr int LANES = SiOPMChannelFMBatch::MAX_LANES;
+constexpr int LOG_INDEX_MAX = SiOPMRefTable::LOG_TABLE_SIZE * 3 - 1;
+
+static_assert(LANES % 4 == 0, "Lanes are processed four at a time.");
+
+// Advance the phases of one operator in every lane and turn them into wave table indices,
+// the same way SiOPMOperator::get_super_output() does for a single voice.
+void _advance_phases(int *r_phases, const int *p_steps, const int *p_inputs, int p_input_shift, int p_fixed_bits, int *r_indices) {
+#if defined(SION_FM_BATCH_SSE)
+	const __m128i filter = _mm_set1_epi32(SiOPMRefTable::PHASE_FILTER);
+	const __m128i input_shift = _mm_cvtsi32_si128(p_input_shift);
+	const __m128i fixed_bits = _mm_cvtsi32_si128(p_fixed_bits);
+	for (int l = 0; l < LANES; l += 4) {
+		__m128i phase = _mm_add_epi32(_mm_load_si128((const __m128i *)(r_phases + l)), _mm_load_si128((const __m128i *)(p_steps + l)));
+		_mm_store_si128((__m128i *)(r_phases + l), phase);
+
+		__m128i modulated = _mm_add_epi32(phase, _mm_sll_epi32(_mm_load_si128((const __m128i *)(p_inputs + l)), input_shift));
+		_mm_store_si128((__m128i *)(r_indices + l), _mm_srl_epi32(_mm_and_si128(modulated, filter), fixed_bits));
+	}
+#elif defined(SION_FM_BATCH_NEON)
+	const int32x4_t filter = vdupq_n_s32(SiOPMRefTable::PHASE_FILTER);
+	const int32x4_t input_shift = vdupq_n_s32(p_input_shift);
+	const int32x4_t fixed_bits = vdupq_n_s32(-p_fixed_bits);
+	for (int l = 0; l < LANES; l += 4) {
+		int32x4_t phase = vaddq_s32(vld1q_s32(r_phases + l), vld1q_s32(p_steps + l));
+		vst1q_s32(r_phases + l, phase);
+
+		int32x4_t modulated = vaddq_s32(phase, vshlq_s32(vld1q_s32(p_inputs + l), input_shift));
+		vst1q_s32(r_indices + l, vshlq_s32(vandq_s32(modulated, filter), fixed_bits));
+	}
+#else
+	for (int l = 0; l < LANES; l++) {
+		r_phases[l] += p_steps[l];
+		r_indices[l] = ((r_phases[l] + (p_inputs[l] << p_input_shift)) & SiOPMRefTable::PHASE_FILTER) >> p_fixed_bits;
+	}
+#endif
+}
+
+// Add the envelope output and amplitude modulation to wave values and clamp the sums to
+// the log table.
+void _add_levels(int *r_values, const int *p_eg_outputs, const int *p_am_levels) {
+#if defined(SION_FM_BATCH_SSE)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i index_max = _mm_set1_epi32(LOG_INDEX_MAX);
+	for (int l = 0; l < LANES; l += 4) {
+		__m128i value = _mm_load_si128((const __m128i *)(r_values + l));
+		value = _mm_add_epi32(value, _mm_load_si128((const __m128i *)(p_eg_outputs + l)));
+		value = _mm_add_epi32(value, _mm_load_si128((const __m128i *)(p_am_levels + l)));
+
+		// SSE2 has no 32-bit min/max, so clamp through comparison masks.
+		value = _mm_and_si128(value, _mm_cmpgt_epi32(value, zero));
+		__m128i over = _mm_cmpgt_epi32(value, index_max);
+		value = _mm_or_si128(_mm_and_si128(over, index_max), _mm_andnot_si128(over, value));
+		_mm_store_si128((__m128i *)(r_values + l), value);
+	}
+#elif defined(SION_FM_BATCH_NEON)
+	const int32x4_t zero = vdupq_n_s32(0);
+	const int32x4_t index_max = vdupq_n_s32(LOG_INDEX_MAX);
+	for (int l = 0; l < LANES; l += 4) {
+		int32x4_t value = vaddq_s32(vld1q_s32(r_values + l), vld1q_s32(p_eg_outputs + l));
+		value = vaddq_s32(value, vld1q_s32(p_am_levels + l));
+		vst1q_s32(r_values + l, vminq_s32(vmaxq_s32(value, zero), index_max));
+	}
+#else
+	for (int l = 0; l < LANES; l++) {
+		int value = r_values[l] + p_eg_outputs[l] + p_am_levels[l];
+		r_values[l] = value < 0 ? 0 : (value > LOG_INDEX_MAX ? LOG_INDEX_MAX : value);
+	}
+#endif
+}
+
+// r_out = p_a + p_b, lane by lane. r_out may alias either input.
+void _add_lanes(const int *p_a, const int *p_b, int *r_out) {
+#if defined(SION_FM_BATCH_SSE)
+	for (int l = 0; l < LANES; l += 4) {
+		__m128i sum = _mm_add_epi32(_mm_load_si128((const __m128i *)(p_a + l)), _mm_load_si128((const __m128i *)(p_b + l)));
+		_mm_store_si128((__m128i *)(r_out + l), sum);
+	}
+#elif defined(SION_FM_BATCH_NEON)
+	for (int l = 0; l < LANES; l += 4) {
+		vst1q_s32(r_out + l, vaddq_s32(vld1q_s32(p_a + l), vld1q_s32(p_b + l)));
+	}
+#else
+	for (int l = 0; l < LANES; l++) {
+		r_out[l] = p_a[l] + p_b[l];
+	}
+#endif
+}
+
+} // namespace
+
+bool SiOPMChannelFMBatch::Layout::operator==(const Layout &p_other) const {
+	if (length != p_other.length || operator_count != p_other.operator_count || input_level != p_other.input_level || feedback_operator != p_other.feedback_operator) {
+		return false;
+	}
+
+	for (int i = 0; i < operator_count; i++) {
+		if (in_slot[i] != p_other.in_slot[i] || out_slot[i] != p_other.out_slot[i] || base_slot[i] != p_other.base_slot[i]) {
+			return false;
+		}
+		if (fm_shift[i] != p_other.fm_shift[i] || fixed_bits[i] != p_other.fixed_bits[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int SiOPMChannelFMBatch::_get_pipe_slot(SiOPMChannelFM *p_channel, SinglyLinkedList<int> *p_pipe) {
+	if (p_pipe == p_channel->_sound_chip->get_zero_buffer()) {
+		return SLOT_ZERO;
+	}
+	if (p_pipe == p_channel->_pipe0) {
+		return SLOT_PIPE0;
+	}
+	if (p_pipe == p_channel->_pipe1) {
+		return SLOT_PIPE1;
+	}
+	return -1;
+}
+
+bool SiOPMChannelFMBatch::_read_layout(SiOPMChannelFM *p_channel, int p_length, Layout &r_layout) {
+	if (p_channel->_process_function_type > SiOPMChannelFM::PROCESS_OP4 || p_channel->_operator_count > MAX_OPERATORS) {
+		return false;
+	}
+	// With the LFO off and its timer settled, modulation levels stay put for the whole block.
+	// A non-zero step still advances the LFO phase in the scalar path, even with the LFO off.
+	if (p_channel->_lfo_on || p_channel->_lfo_timer < 0 || p_channel->_lfo_timer_step != 0) {
+		return false;
+	}
+	// Control-rate channels ramp their envelopes; they keep their own process.
+	if (p_channel->_get_control_block_size() > 0) {
+		return false;
+	}
+	// Ring modulation reads a pipe another channel may still have to write this segment.
+	if (p_channel->_ring_pipe || p_channel->_output_mode != SiOPMChannelBase::OutputMode::OUTPUT_STANDARD) {
+		return false;
+	}
+
+	r_layout.length = p_length;
+	r_layout.operator_count = p_channel->_operator_count;
+	r_layout.input_level = p_channel->_input_level;
+	r_layout.feedback_operator = -1;
+
+	if (p_channel->_input_mode == SiOPMChannelBase::InputMode::INPUT_FEEDBACK) {
+		for (int i = 0; i < r_layout.operator_count; i++) {
+			if (p_channel->_operators[i]->_feed_pipe == p_channel->_in_pipe) {
+				r_layout.feedback_operator = i;
+				break;
+			}
+		}
+		if (r_layout.feedback_operator < 0) {
+			return false;
+		}
+	} else if (p_channel->_in_pipe != p_channel->_sound_chip->get_zero_buffer()) {
+		return false;
+	}
+
+	for (int i = 0; i < r_layout.operator_count; i++) {
+		const SiOPMOperator *op = p_channel->_operators[i];
+		if (op == nullptr || op->_super_count > 1 || op->_deferred_attack_target != SiOPMOperator::EG_OFF) {
+			return false;
+		}
+		if (op->_wave_table_ptr == nullptr || !op->_wave_table_is_pow2) {
+			return false;
+		}
+
+		r_layout.fm_shift[i] = op->_fm_shift;
+		r_layout.fixed_bits[i] = op->_wave_fixed_bits;
+
+		// A single operator writes straight to the channel output; its pipes are never read.
+		if (r_layout.operator_count == 1) {
+			continue;
+		}
+
+		r_layout.in_slot[i] = _get_pipe_slot(p_channel, op->_in_pipe);
+		r_layout.out_slot[i] = _get_pipe_slot(p_channel, op->_out_pipe);
+		r_layout.base_slot[i] = _get_pipe_slot(p_channel, op->_base_pipe);
+		if (r_layout.in_slot[i] < 0 || r_layout.base_slot[i] < 0 || r_layout.out_slot[i] <= SLOT_ZERO) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void SiOPMChannelFMBatch::_render_group(SiOPMChannelFM **p_channels, int p_lane_count, const Layout &p_layout) {
+	const int length = p_layout.length;
+	const int operator_count = p_layout.operator_count;
+	const int *log_table = p_channels[0]->_table->log_table;
+
+	if ((int)_output.size() < length * LANES) {
+		_output.resize(length * LANES);
+	}
+
+	// Per-lane state. Unused lanes keep zeroes and are never read back.
+	alignas(16) int phases[MAX_OPERATORS][LANES] = {};
+	alignas(16) int steps[MAX_OPERATORS][LANES] = {};
+	alignas(16) int am_levels[MAX_OPERATORS][LANES] = {};
+	alignas(16) int eg_outputs[MAX_OPERATORS][LANES] = {};
+	alignas(16) int feeds[MAX_OPERATORS][LANES] = {};
+	alignas(16) int pipes[SLOT_MAX][LANES] = {};
+	alignas(16) int indices[LANES] = {};
+	SiOPMOperator *operators[MAX_OPERATORS][LANES] = {};
+	const int *waves[MAX_OPERATORS][LANES] = {};
+	int wave_masks[MAX_OPERATORS][LANES] = {};
+	int eg_timer_initials[LANES] = {};
+
+	for (int l = 0; l < p_lane_count; l++) {
+		SiOPMChannelFM *channel = p_channels[l];
+		eg_timer_initials[l] = channel->_eg_timer_initial;
+
+		for (int i = 0; i < operator_count; i++) {
+			SiOPMOperator *op = channel->_operators[i];
+			operators[i][l] = op;
+			phases[i][l] = op->_phase;
+			steps[i][l] = op->_phase_step;
+			waves[i][l] = op->_wave_table_ptr;
+			wave_masks[i][l] = op->_wave_table_mask;
+			feeds[i][l] = op->_feed_pipe->get()->value;
+			// The single operator process ignores amplitude modulation when the LFO is off.
+			am_levels[i][l] = (operator_count == 1) ? 0 : (channel->_amplitude_modulation_output_level >> op->get_amplitude_modulation_shift());
+		}
+	}
+
+	const int *first_input = (p_layout.feedback_operator >= 0) ? feeds[p_layout.feedback_operator] : pipes[SLOT_ZERO];
+	const int *result = (operator_count == 1) ? feeds[0] : pipes[SLOT_PIPE0];
+
+	for (int s = 0; s < length; s++) {
+		// Clear pipes.
+		if (operator_count > 1) {
+			for (int l = 0; l < LANES; l++) {
+				pipes[SLOT_PIPE0][l] = 0;
+				pipes[SLOT_PIPE1][l] = 0;
+			}
+		}
+
+		for (int i = 0; i < operator_count; i++) {
+			// Update EG.
+			for (int l = 0; l < p_lane_count; l++) {
+				SiOPMOperator *op = operators[i][l];
+				op->tick_eg(eg_timer_initials[l]);
+				eg_outputs[i][l] = op->_eg_output;
+			}
+
+			// Update PG.
+			if (i == 0) {
+				_advance_phases(phases[i], steps[i], first_input, p_layout.input_level, p_layout.fixed_bits[i], indices);
+			} else {
+				_advance_phases(phases[i], steps[i], pipes[p_layout.in_slot[i]], p_layout.fm_shift[i], p_layout.fixed_bits[i], indices);
+			}
+			for (int l = 0; l < p_lane_count; l++) {
+				indices[l] = waves[i][l][indices[l] & wave_masks[i][l]];
+			}
+			_add_levels(indices, eg_outputs[i], am_levels[i]);
+			for (int l = 0; l < p_lane_count; l++) {
+				feeds[i][l] = log_table[indices[l]];
+			}
+
+			if (operator_count > 1) {
+				_add_lanes(feeds[i], pipes[p_layout.base_slot[i]], pipes[p_layout.out_slot[i]]);
+			}
+		}
+
+		for (int l = 0; l < p_lane_count; l++) {
+			_output[l * length + s] = result[l];
+		}
+	}
+
+	// Write the state back and finish each channel as buffer() would.
+	for (int l = 0; l < p_lane_count; l++) {
+		SiOPMChannelFM *channel = p_channels[l];
+		for (int i = 0; i < operator_count; i++) {
+			operators[i][l]->_phase = phases[i][l];
+			operators[i][l]->_feed_pipe->get()->value = feeds[i][l];
+		}
+		channel->_pipe0->get()->value = pipes[SLOT_PIPE0][l];
+		channel->_pipe1->get()->value = pipes[SLOT_PIPE1][l];
+
+		_finish_lane(channel, _output.data() + l * length, length);
+	}
+}
+
+void SiOPMChannelFMBatch::_finish_lane(SiOPMChannelFM *p_channel, const int *p_samples, int p_length) {
+	SinglyLinkedList<int>::Element *in_pipe   = p_channel->_in_pipe->get();
+	SinglyLinkedList<int>::Element *base_pipe = p_channel->_base_pipe->get();
+	SinglyLinkedList<int>::Element *out_pipe  = p_channel->_out_pipe->get();
+	SinglyLinkedList<int>::Element *mono_out  = out_pipe;
+
+	// Standard output has the zero buffer as its base, so samples go out as rendered.
+	for (int i = 0; i < p_length; i++) {
+		out_pipe->value = p_samples[i];
+		in_pipe = in_pipe->next();
+		base_pipe = base_pipe->next();
+		out_pipe = out_pipe->next();
+	}
+
+	p_channel->_in_pipe->set(in_pipe);
+	p_channel->_base_pipe->set(base_pipe);
+	p_channel->_out_pipe->set(out_pipe);
+
+	p_channel->_post_process_buffer(mono_out, nullptr, nullptr, false, p_length);
+}
+
+bool SiOPMChannelFMBatch::defer(SiOPMChannelBase *p_channel, int p_length) {
+	// Channels derived from FM, like KS, render differently and keep their own path.
+	if (p_channel == nullptr || p_length <= 0 || p_channel->get_channel_type() != SiOPMChannelManager::CHANNEL_FM) {
+		return false;
+	}
+
+	SiOPMChannelFM *channel = static_cast<SiOPMChannelFM *>(p_channel);
+	// An idle channel only moves its buffer index; there is nothing to share.
+	if (channel->_is_idling) {
+		return false;
+	}
+
+	Entry entry;
+	entry.channel = channel;
+	if (!_read_layout(channel, p_length, entry.layout)) {
+		return false;
+	}
+
+	_entries.push_back(entry);
+	return true;
+}
+
+void SiOPMChannelFMBatch::flush() {
+	const int entry_count = _entries.size();
+
+	for (int i = 0; i < entry_count; i++) {
+		if (_entries[i].rendered) {
+			continue;
+		}
+
+		SiOPMChannelFM *lanes[MAX_LANES];
+		int lane_count = 0;
+		const Layout &layout = _entries[i].layout;
+
+		for (int j = i; j < entry_count && lane_count < MAX_LANES; j++) {
+			Entry &entry = _entries[j];
+			if (!entry.rendered && entry.layout == layout) {
+				lanes[lane_count++] = entry.channel;
+				entry.rendered = true;
+			}
+		}
+
+		if (lane_count == 1) {
+			// Nothing to share the pass with.
+			lanes[0]->buffer(layout.length);
+		} else {
+			_render_group(lanes, lane_count, layout);
+		}
+	}
+
+	// Keeps the capacity, so a steady song stops allocating after the first buffers.
+	_entries.clear();
+}
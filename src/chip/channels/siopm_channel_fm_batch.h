@@ -0,0 +1,86 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SIOPM_CHANNEL_FM_BATCH_H
+#define SIOPM_CHANNEL_FM_BATCH_H
+
+#include <vector>
+#include "templates/singly_linked_list.h"
+
+class SiOPMChannelBase;
+class SiOPMChannelFM;
+
+// Renders FM channels that share an operator layout side by side, one SIMD lane per channel.
+//
+// The sequencer hands over the last block of a segment for each track whose channel only
+// needs a plain render; nothing else touches those channels until the segment ends, so
+// the work can wait until every track has been visited. flush() then groups channels with
+// the same algorithm and operator count and advances up to MAX_LANES of them per pass,
+// with operator phases, steps and routing pipes held as per-lane arrays. Phase and
+// wave-index math, the envelope/level sum and its clamp run on 4-wide vectors; the wave
+// and log table reads stay scalar. Envelopes are ticked per operator as before, so a
+// batched channel sounds exactly like one rendered on its own.
+//
+// Only the common case is accepted: standard output, no LFO, ring modulation or super
+// voices, and zero or feedback input. Anything else is rendered by the track right away.
+class SiOPMChannelFMBatch {
+public:
+	static const int MAX_LANES = 8;
+	static const int MAX_OPERATORS = 4;
+
+private:
+	enum PipeSlot {
+		SLOT_ZERO = 0,
+		SLOT_PIPE0 = 1,
+		SLOT_PIPE1 = 2,
+
+		SLOT_MAX
+	};
+
+	// Everything lanes of one pass must agree on.
+	struct Layout {
+		int length = 0;
+		int operator_count = 0;
+		int input_level = 0;
+		int feedback_operator = -1; // -1 when the input is the zero buffer.
+		int in_slot[MAX_OPERATORS] = {};
+		int out_slot[MAX_OPERATORS] = {};
+		int base_slot[MAX_OPERATORS] = {};
+		int fm_shift[MAX_OPERATORS] = {};
+		int fixed_bits[MAX_OPERATORS] = {};
+
+		bool operator==(const Layout &p_other) const;
+	};
+
+	struct Entry {
+		SiOPMChannelFM *channel = nullptr;
+		Layout layout;
+		bool rendered = false;
+	};
+
+	std::vector<Entry> _entries;
+	// Rendered samples, one run of the pass length per lane.
+	std::vector<int> _output;
+
+	static int _get_pipe_slot(SiOPMChannelFM *p_channel, SinglyLinkedList<int> *p_pipe);
+	static bool _read_layout(SiOPMChannelFM *p_channel, int p_length, Layout &r_layout);
+
+	void _render_group(SiOPMChannelFM **p_channels, int p_lane_count, const Layout &p_layout);
+	void _finish_lane(SiOPMChannelFM *p_channel, const int *p_samples, int p_length);
+
+public:
+	// Take over a render of p_length samples. Returns false if the channel can't be
+	// batched; the caller must then render it itself.
+	bool defer(SiOPMChannelBase *p_channel, int p_length);
+	// Render every deferred channel. Must be called before the channels are touched again.
+	void flush();
+	bool is_empty() const { return _entries.empty(); }
+
+	SiOPMChannelFMBatch() {}
+	~SiOPMChannelFMBatch() {}
+};
+
+#endif // SIOPM_CHANNEL_FM_BATCH_H
@@ -64,13 +64,10 @@ void SiOPMChannelGuitar6::GuitarString::init(int p_index, double p_sample_rate)
 
 	char_noise_step = REFERENCE_SAMPLE_RATE / p_sample_rate;
 
-	static constexpr double DC_REJECT_CUTOFF_HZ = 1.0;
-	dc_reject_coef = 1.0 - 2.0 * Math_PI * DC_REJECT_CUTOFF_HZ / p_sample_rate;
-
 	string_noise_gen.seed = 4095;
 	damp_noise_gen.seed = 65535;
 
-	reset_state();
+	pending_pluck_count = 0;
 }
 
 void SiOPMChannelGuitar6::GuitarString::add_pluck(int p_tab_index, double p_velocity, int p_target_sample) {
@@ -92,59 +89,79 @@ void SiOPMChannelGuitar6::GuitarString::add_pluck(int p_tab_index, double p_velo
 	pending_pluck_count++;
 }
 
-void SiOPMChannelGuitar6::GuitarString::process(double *p_left, double *p_right, int p_block_start, int p_num_samples,
-		const double *p_char_noise, int p_char_noise_len,
-		double p_character_variation, double p_string_damp, double p_string_damp_variation,
-		double p_plug_damp_param, double p_plug_damp_variation, double p_string_tension,
-		double p_stereo_spread, double p_sample_rate) {
-	int sample_index = 0;
+void SiOPMChannelGuitar6::GuitarString::pop_pluck() {
+	for (int j = 0; j < pending_pluck_count - 1; j++) {
+		pending_plucks[j] = pending_plucks[j + 1];
+	}
+	pending_pluck_count--;
+}
 
-	while (sample_index < p_num_samples) {
-		while (pending_pluck_count > 0) {
-			PluckEvent &pluck = pending_plucks[0];
-			int pluck_offset = pluck.target_sample - p_block_start;
-
-			if (pluck_offset <= sample_index) {
-				execute_pluck(pluck, p_char_noise, p_char_noise_len,
-						p_character_variation, p_string_damp, p_string_damp_variation,
-						p_plug_damp_param, p_plug_damp_variation, p_string_tension,
-						p_stereo_spread, p_sample_rate);
-				for (int j = 0; j < pending_pluck_count - 1; j++) {
-					pending_plucks[j] = pending_plucks[j + 1];
-				}
-				pending_pluck_count--;
-			} else if (pluck_offset < p_num_samples) {
-				int to_process = pluck_offset - sample_index;
-				process_add(p_left, p_right, sample_index, to_process);
-				sample_index += to_process;
-			} else {
-				break;
-			}
-		}
+// --- String bank ---
 
-		if (sample_index < p_num_samples) {
-			process_add(p_left, p_right, sample_index, p_num_samples - sample_index);
-			sample_index = p_num_samples;
-		}
+void SiOPMChannelGuitar6::_init_string_bank(double p_sample_rate) {
+	// Plucks never go below the open lowest string, so that is the longest period we need.
+	double lowest_freq = 27.5 * pow(2.0, (double)STRING_SEMITONES[0] / 12.0);
+	int capacity = (int)ceil(p_sample_rate / lowest_freq) + 1;
+
+	if (capacity != _delay_capacity) {
+		_delay_capacity = capacity;
+		_delay_memory.resize_zeroed(NUM_STRINGS * _delay_capacity);
+	}
+	_delay_memory.fill(0.0);
+
+	static constexpr double DC_REJECT_CUTOFF_HZ = 1.0;
+	_bank.dc_reject_coef = 1.0 - 2.0 * Math_PI * DC_REJECT_CUTOFF_HZ / p_sample_rate;
+
+	double *memory = _delay_memory.ptrw();
+	for (int lane = 0; lane < LANE_COUNT; lane++) {
+		_bank.delay[lane] = (lane < NUM_STRINGS) ? memory + lane * _delay_capacity : _silent_delay;
+		// Memory is already cleared, and it may have been resized under the old periods.
+		_bank.active[lane] = false;
+		_silence_lane(lane);
 	}
 }
 
-void SiOPMChannelGuitar6::GuitarString::execute_pluck(const PluckEvent &p_pluck,
-		const double *p_char_noise, int p_char_noise_len,
-		double p_character_variation, double p_string_damp, double p_string_damp_variation,
-		double p_plug_damp_param, double p_plug_damp_variation, double p_string_tension,
-		double p_stereo_spread, double p_sample_rate) {
-	int note = semitone + p_pluck.tab_index;
+void SiOPMChannelGuitar6::_silence_lane(int p_lane) {
+	if (_bank.active[p_lane]) {
+		memset(_bank.delay[p_lane], 0, sizeof(double) * _bank.period[p_lane]);
+	}
+
+	// An inactive lane reads and writes zeros over a minimal period, so it can
+	// share a lane group with ringing strings without affecting them.
+	_bank.active[p_lane] = false;
+	_bank.period[p_lane] = 2;
+	_bank.write_index[p_lane] = 0;
+	_bank.read_int[p_lane] = 0;
+	_bank.read_frac[p_lane] = 0;
+	_bank.df[p_lane] = 0;
+	_bank.dc_x1[p_lane] = 0;
+	_bank.dc_y1[p_lane] = 0;
+	_bank.dc[p_lane] = 0;
+	_bank.loop_gain[p_lane] = 0;
+	_bank.gain_l[p_lane] = 0;
+	_bank.gain_r[p_lane] = 0;
+	_bank.peak[p_lane] = 0;
+}
+
+void SiOPMChannelGuitar6::_execute_pluck(int p_string_index, const PluckEvent &p_pluck, double p_sample_rate) {
+	GuitarString &guitar_string = _strings[p_string_index];
+	const int lane = p_string_index;
+
+	if (_bank.active[lane]) {
+		memset(_bank.delay[lane], 0, sizeof(double) * _bank.period[lane]);
+	}
+
+	int note = guitar_string.semitone + p_pluck.tab_index;
 	double freq = 27.5 * pow(2.0, (double)note / 12.0);
-	period_n = (int)ceil(p_sample_rate / freq);
-	if (period_n > MAX_DELAY_SAMPLES) {
-		period_n = MAX_DELAY_SAMPLES;
+	int period_n = (int)ceil(p_sample_rate / freq);
+	if (period_n > _delay_capacity) {
+		period_n = _delay_capacity;
 	}
 	if (period_n < 2) {
 		period_n = 2;
 	}
 
-	velocity = p_pluck.velocity * 0.25;
+	guitar_string.velocity = p_pluck.velocity * 0.25;
 
 	double normalized_tone = (double)(note - 19) / 44.0;
 	if (normalized_tone < 0.0) {
@@ -157,8 +174,8 @@ void SiOPMChannelGuitar6::GuitarString::execute_pluck(const PluckEvent &p_pluck,
 	double sr_scale = REFERENCE_SAMPLE_RATE / p_sample_rate;
 	double adjusted_scale = sr_scale + (1.0 - sr_scale) * 0.1;
 
-	double damp_random = damp_noise_gen.bipolar() * p_string_damp_variation * 0.5;
-	double damp_amount = CLAMP(p_string_damp + damp_random, 0.0, 1.0);
+	double damp_random = guitar_string.damp_noise_gen.bipolar() * _string_damp_variation * 0.5;
+	double damp_amount = CLAMP(_string_damp + damp_random, 0.0, 1.0);
 
 	// Map Damp to a true release-time control (T60), independent of pitch.
 	static constexpr double MIN_T60_SECONDS = 0.2;
@@ -171,28 +188,27 @@ void SiOPMChannelGuitar6::GuitarString::execute_pluck(const PluckEvent &p_pluck,
 		decay_t60 = MIN_T60_SECONDS;
 	}
 	double cycles_to_t60 = MAX(freq * decay_t60, 1.0);
-	loop_gain = pow(0.001, 1.0 / cycles_to_t60);
+	double loop_gain = pow(0.001, 1.0 / cycles_to_t60);
 	loop_gain = CLAMP(loop_gain, 0.6, 0.99995);
 
 	// Keep damp coupled to tone darkening in the loop.
 	double base_dc = 0.12 + (1.0 - damp_amount) * 0.86;
-	dc = 1.0 - pow(1.0 - base_dc, adjusted_scale);
+	double dc = 1.0 - pow(1.0 - base_dc, adjusted_scale);
 	dc = CLAMP(dc, 0.02, 1.0);
 
 	double min_damp = 0.1;
 	double max_damp = 0.9;
-	double v0 = p_plug_damp_param - (p_plug_damp_param - min_damp) * p_plug_damp_variation;
-	double v1 = p_plug_damp_param + (max_damp - p_plug_damp_param) * p_plug_damp_variation;
-	double base_plug_damp = v0 + damp_noise_gen.norm() * (v1 - v0);
+	double v0 = _plug_damp - (_plug_damp - min_damp) * _plug_damp_variation;
+	double v1 = _plug_damp + (max_damp - _plug_damp) * _plug_damp_variation;
+	double base_plug_damp = v0 + guitar_string.damp_noise_gen.norm() * (v1 - v0);
 	double plug_damp = 1.0 - pow(1.0 - base_plug_damp, adjusted_scale);
 
-	read_offset = p_string_tension * (period_n - 1);
+	double read_offset = _string_tension * (period_n - 1);
 
-	double pan = p_stereo_spread * pre_pan;
-	gain_l = (1.0 - pan) * 0.5;
-	gain_r = (pan + 1.0) * 0.5;
+	double pan = _stereo_spread * guitar_string.pre_pan;
 
 	// Fill delay buffer with shaped excitation (one-shot).
+	double *delay = _bank.delay[lane];
 	double noise_lp0 = 0.0;
 	double noise_lp1 = 0.0;
 	double char_noise_pos = 0.0;
@@ -201,16 +217,16 @@ void SiOPMChannelGuitar6::GuitarString::execute_pluck(const PluckEvent &p_pluck,
 	for (int i = 0; i < period_n; i++) {
 		int char_idx = (int)floor(char_noise_pos);
 		double char_frac = char_noise_pos - (double)char_idx;
-		int idx0 = char_idx % p_char_noise_len;
-		int idx1 = (char_idx + 1) % p_char_noise_len;
-		double char_sample = p_char_noise[idx0] + (p_char_noise[idx1] - p_char_noise[idx0]) * char_frac;
-		char_noise_pos += char_noise_step;
+		int idx0 = char_idx % CHAR_NOISE_LENGTH;
+		int idx1 = (char_idx + 1) % CHAR_NOISE_LENGTH;
+		double char_sample = _char_noise[idx0] + (_char_noise[idx1] - _char_noise[idx0]) * char_frac;
+		char_noise_pos += guitar_string.char_noise_step;
 
-		double raw_noise = (char_sample * (1.0 - p_character_variation) +
-				string_noise_gen.bipolar() * p_character_variation) * velocity * noise_gain_compensation;
+		double raw_noise = (char_sample * (1.0 - _character_variation) +
+				guitar_string.string_noise_gen.bipolar() * _character_variation) * guitar_string.velocity * guitar_string.noise_gain_compensation;
 
-		noise_lp0 += (raw_noise - noise_lp0) * noise_lp_coef;
-		noise_lp1 += (noise_lp0 - noise_lp1) * noise_lp_coef;
+		noise_lp0 += (raw_noise - noise_lp0) * guitar_string.noise_lp_coef;
+		noise_lp1 += (noise_lp0 - noise_lp1) * guitar_string.noise_lp_coef;
 
 		pluck_state += (noise_lp1 - pluck_state) * plug_damp;
 		delay[i] = pluck_state;
@@ -222,69 +238,114 @@ void SiOPMChannelGuitar6::GuitarString::execute_pluck(const PluckEvent &p_pluck,
 		mean += delay[i];
 	}
 	mean /= (double)period_n;
+
+	double peak = 0.0;
 	for (int i = 0; i < period_n; i++) {
 		delay[i] -= mean;
+		peak = MAX(peak, fabs(delay[i]));
 	}
 
+	_bank.active[lane] = true;
+	_bank.period[lane] = period_n;
+	_bank.write_index[lane] = 0;
+	_bank.read_int[lane] = (int)floor(read_offset);
+	_bank.read_frac[lane] = read_offset - (double)_bank.read_int[lane];
+	_bank.dc[lane] = dc;
+	_bank.loop_gain[lane] = loop_gain;
+	_bank.gain_l[lane] = (1.0 - pan) * 0.5;
+	_bank.gain_r[lane] = (pan + 1.0) * 0.5;
+	// The excitation itself counts towards this block's peak, so a string plucked
+	// at the very end of a block is not mistaken for a decayed one.
+	_bank.peak[lane] = MAX(_bank.peak[lane], peak);
+
 	// Reset loop filter state for a clean feedback path.
-	df = 0.0;
-	dc_x1 = 0.0;
-	dc_y1 = 0.0;
-	write_index = 0;
+	_bank.df[lane] = 0.0;
+	_bank.dc_x1[lane] = 0.0;
+	_bank.dc_y1[lane] = 0.0;
 }
 
-void SiOPMChannelGuitar6::GuitarString::process_add(double *p_left, double *p_right, int p_start, int p_count) {
-	if (period_n == -1) {
-		return;
+bool SiOPMChannelGuitar6::_is_lane_group_active(int p_group) const {
+	const int base = p_group * LANE_GROUP_SIZE;
+	for (int l = 0; l < LANE_GROUP_SIZE; l++) {
+		if (_bank.active[base + l]) {
+			return true;
+		}
 	}
+	return false;
+}
+
+void SiOPMChannelGuitar6::_process_lane_group(int p_group, int p_start, int p_count) {
+	StringBank &bank = _bank;
+	const int base = p_group * LANE_GROUP_SIZE;
+	const double dc_reject_coef = bank.dc_reject_coef;
+
+	double x[LANE_GROUP_SIZE];
+	double y[LANE_GROUP_SIZE];
 
 	for (int i = 0; i < p_count; i++) {
-		double r_num = write_index + read_offset;
-		if (r_num >= period_n) {
-			r_num -= period_n;
-		}
+		// Gather the fractional delay taps of every lane.
+		for (int l = 0; l < LANE_GROUP_SIZE; l++) {
+			const int lane = base + l;
+			const int period = bank.period[lane];
+
+			int r_int0 = bank.write_index[lane] + bank.read_int[lane];
+			if (r_int0 >= period) {
+				r_int0 -= period;
+			}
+			int r_int1 = r_int0 + 1;
+			if (r_int1 >= period) {
+				r_int1 = 0;
+			}
 
-		int r_int0 = (int)floor(r_num);
-		int r_int1 = r_int0 + 1;
-		if (r_int1 >= period_n) {
-			r_int1 = 0;
+			const double r_alp = bank.read_frac[lane];
+			const double *delay = bank.delay[lane];
+			x[l] = delay[r_int0] * (1.0 - r_alp) + delay[r_int1] * r_alp;
 		}
 
-		double r_alp = r_num - (double)r_int0;
-		double x = delay[r_int0] * (1.0 - r_alp) + delay[r_int1] * r_alp;
+		// Loop filters are identical for every lane and run in lockstep.
+		for (int l = 0; l < LANE_GROUP_SIZE; l++) {
+			const int lane = base + l;
 
-		// Loop low-pass filter (string damping).
-		df += (x - df) * dc;
+			// Loop low-pass filter (string damping).
+			bank.df[lane] += (x[l] - bank.df[lane]) * bank.dc[lane];
 
-		// DC rejection in the feedback loop — prevents DC/subsonic modes
-		// from being valid resonances of the synthetic string.
-		double dc_out = df - dc_x1 + dc_reject_coef * dc_y1;
-		dc_x1 = df;
-		dc_y1 = dc_out;
+			// DC rejection in the feedback loop — prevents DC/subsonic modes
+			// from being valid resonances of the synthetic string.
+			double dc_out = bank.df[lane] - bank.dc_x1[lane] + dc_reject_coef * bank.dc_y1[lane];
+			bank.dc_x1[lane] = bank.df[lane];
+			bank.dc_y1[lane] = dc_out;
 
-		double y = dc_out * loop_gain;
+			y[l] = dc_out * bank.loop_gain[lane];
+			bank.peak[lane] = MAX(bank.peak[lane], fabs(y[l]));
+		}
 
-		delay[write_index] = y;
+		double left = 0.0;
+		double right = 0.0;
+		for (int l = 0; l < LANE_GROUP_SIZE; l++) {
+			const int lane = base + l;
 
-		int idx = p_start + i;
-		p_left[idx] += y * gain_l;
-		p_right[idx] += y * gain_r;
+			left += y[l] * bank.gain_l[lane];
+			right += y[l] * bank.gain_r[lane];
 
-		write_index++;
-		if (write_index >= period_n) {
-			write_index = 0;
+			bank.delay[lane][bank.write_index[lane]] = y[l];
+			bank.write_index[lane]++;
+			if (bank.write_index[lane] >= bank.period[lane]) {
+				bank.write_index[lane] = 0;
+			}
 		}
+
+		_scratch_left[p_start + i] += left;
+		_scratch_right[p_start + i] += right;
 	}
 }
 
-void SiOPMChannelGuitar6::GuitarString::reset_state() {
-	memset(delay, 0, sizeof(delay));
-	write_index = 0;
-	period_n = -1;
-	df = 0;
-	dc_x1 = dc_y1 = 0;
-	loop_gain = 0.9992;
-	pending_pluck_count = 0;
+void SiOPMChannelGuitar6::_update_lane_idling() {
+	for (int lane = 0; lane < NUM_STRINGS; lane++) {
+		if (_bank.active[lane] && _bank.peak[lane] < IDLE_PEAK_THRESHOLD) {
+			_silence_lane(lane);
+		}
+		_bank.peak[lane] = 0;
+	}
 }
 
 // --- SiOPMChannelGuitar6 ---
@@ -335,6 +396,7 @@ void SiOPMChannelGuitar6::offset_volume(int p_expression, int p_velocity) {
 void SiOPMChannelGuitar6::note_on() {
 	_is_note_on = true;
 	_is_idling = false;
+	_reset_idle_detector();
 
 	int tab_index = 0;
 	double vel = 1.0;
@@ -371,23 +433,18 @@ void SiOPMChannelGuitar6::reset_channel_buffer_status() {
 	_buffer_index = 0;
 	_is_idling = true;
 
-	static constexpr double IDLE_RMS_THRESHOLD = 0.0001;
+	// Individual strings are dropped from the bank at the end of each block, but the
+	// mix of several quiet strings and the body can still sit below the channel threshold.
+	const bool is_decayed = _update_idle_detector();
 
 	for (int s = 0; s < NUM_STRINGS; s++) {
 		if (_strings[s].pending_pluck_count > 0) {
 			_is_idling = false;
 			return;
 		}
-		if (_strings[s].period_n != -1) {
-			double sum_sq = 0.0;
-			for (int j = 0; j < _strings[s].period_n; j++) {
-				sum_sq += _strings[s].delay[j] * _strings[s].delay[j];
-			}
-			double rms = sqrt(sum_sq / (double)_strings[s].period_n);
-			if (rms > IDLE_RMS_THRESHOLD) {
-				_is_idling = false;
-				return;
-			}
+		if (_bank.active[s] && !is_decayed) {
+			_is_idling = false;
+			return;
 		}
 	}
 }
@@ -412,32 +469,63 @@ void SiOPMChannelGuitar6::buffer(int p_length) {
 	memset(_scratch_left, 0, sizeof(double) * p_length);
 	memset(_scratch_right, 0, sizeof(double) * p_length);
 
-	for (int s = 0; s < NUM_STRINGS; s++) {
-		_strings[s].process(_scratch_left, _scratch_right, _buffer_index, p_length,
-				_char_noise, CHAR_NOISE_LENGTH,
-				_character_variation, _string_damp, _string_damp_variation,
-				_plug_damp, _plug_damp_variation, _string_tension,
-				_stereo_spread, sample_rate);
+	int sample_index = 0;
+	while (sample_index < p_length) {
+		// Start plucks that are due and split the block at the next scheduled one.
+		int segment_end = p_length;
+		for (int s = 0; s < NUM_STRINGS; s++) {
+			GuitarString &guitar_string = _strings[s];
+			while (guitar_string.pending_pluck_count > 0) {
+				int pluck_offset = guitar_string.pending_plucks[0].target_sample - _buffer_index;
+				if (pluck_offset > sample_index) {
+					segment_end = MIN(segment_end, pluck_offset);
+					break;
+				}
+
+				_execute_pluck(s, guitar_string.pending_plucks[0], sample_rate);
+				guitar_string.pop_pluck();
+			}
+		}
+
+		for (int g = 0; g < LANE_GROUP_COUNT; g++) {
+			if (_is_lane_group_active(g)) {
+				_process_lane_group(g, sample_index, segment_end - sample_index);
+			}
+		}
+		sample_index = segment_end;
 	}
 
+	_update_lane_idling();
+
 	if (!_body_bypass) {
 		for (int r = 0; r < 3; r++) {
 			_body_resonators[r].process(_scratch_left, _scratch_right, p_length);
 		}
 	}
 
+	// Guitar6 excites one string per note and is naturally lower than
+	// int-pipe FM/KS channels; apply fixed make-up gain for parity.
+	static constexpr double OUTPUT_MAKEUP_GAIN = 3.0;
+
+	double block_peak = 0.0;
+	for (int i = 0; i < p_length; i++) {
+		block_peak = MAX(block_peak, MAX(fabs(_scratch_left[i]), fabs(_scratch_right[i])));
+	}
+	_report_idle_peak_normalized(block_peak * OUTPUT_MAKEUP_GAIN, p_length);
+
 	if (_output_mode == OutputMode::OUTPUT_STANDARD && !_mute) {
 		SiOPMStream *stream = _streams[0] ? _streams[0] : _sound_chip->get_output_stream();
 		if (stream) {
-			// Guitar6 excites one string per note and is naturally lower than
-			// int-pipe FM/KS channels; apply fixed make-up gain for parity.
-			static constexpr double OUTPUT_MAKEUP_GAIN = 3.0;
 			const double volume_coef = _expression * _instrument_gain * OUTPUT_MAKEUP_GAIN;
 			const bool is_redirected = (_streams[0] != nullptr && _streams[0] != _sound_chip->get_output_stream());
 
 			Vector<double> *buf_ptr = stream->get_buffer_ptr();
-			double *buf = buf_ptr->ptrw();
 			int buf_size = buf_ptr->size();
+			// Strings are panned individually, so a mono-packed effect stream needs both sides first.
+			if (stream->is_left_only()) {
+				stream->unpack_mono(0, buf_size >> 1);
+			}
+			double *buf = buf_ptr->ptrw();
 
 			double vol = is_redirected ? volume_coef : (_volumes[0] * volume_coef);
 			int offset = _buffer_index * 2;
@@ -457,8 +545,11 @@ void SiOPMChannelGuitar6::buffer(int p_length) {
 						if (send_stream) {
 							double send_vol = _volumes[send] * volume_coef;
 							Vector<double> *send_buf_ptr = send_stream->get_buffer_ptr();
-							double *send_buf = send_buf_ptr->ptrw();
 							int send_buf_size = send_buf_ptr->size();
+							if (send_stream->is_left_only()) {
+								send_stream->unpack_mono(0, send_buf_size >> 1);
+							}
+							double *send_buf = send_buf_ptr->ptrw();
 							int send_offset = _buffer_index * 2;
 							for (int i = 0; i < p_length; i++) {
 								int sidx = send_offset + i * 2;
@@ -500,13 +591,17 @@ void SiOPMChannelGuitar6::initialize(SiOPMChannelBase *p_prev, int p_buffer_inde
 	for (int s = 0; s < NUM_STRINGS; s++) {
 		_strings[s].init(s, sample_rate);
 	}
+	_init_string_bank(sample_rate);
 
 	_is_idling = true;
 }
 
 void SiOPMChannelGuitar6::reset() {
 	for (int s = 0; s < NUM_STRINGS; s++) {
-		_strings[s].reset_state();
+		_strings[s].pending_pluck_count = 0;
+	}
+	for (int lane = 0; lane < LANE_COUNT; lane++) {
+		_silence_lane(lane);
 	}
 
 	SiOPMChannelBase::reset();
@@ -525,4 +620,5 @@ String SiOPMChannelGuitar6::_to_string() const {
 
 SiOPMChannelGuitar6::SiOPMChannelGuitar6(SiOPMSoundChip *p_chip) : SiOPMChannelBase(p_chip) {
 	_randomize_character_noise(65535);
+	_init_string_bank(_table ? (double)_table->sampling_rate : REFERENCE_SAMPLE_RATE);
 }
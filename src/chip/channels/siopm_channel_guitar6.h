@@ -12,11 +12,18 @@ class SiOPMChannelGuitar6 : public SiOPMChannelBase {
 	GDCLASS(SiOPMChannelGuitar6, SiOPMChannelBase)
 
 	static constexpr int NUM_STRINGS = 6;
-	static constexpr int MAX_DELAY_SAMPLES = 5400;
 	static constexpr int CHAR_NOISE_LENGTH = 5400;
 	static constexpr int MAX_PENDING_PLUCKS = 64;
 	static constexpr double REFERENCE_SAMPLE_RATE = 48000.0;
 
+	// Strings are rendered lane-parallel in fixed-size groups, the bank is padded
+	// with silent lanes up to a whole number of groups.
+	static constexpr int LANE_GROUP_SIZE = 4;
+	static constexpr int LANE_COUNT = ((NUM_STRINGS + LANE_GROUP_SIZE - 1) / LANE_GROUP_SIZE) * LANE_GROUP_SIZE;
+	static constexpr int LANE_GROUP_COUNT = LANE_COUNT / LANE_GROUP_SIZE;
+	// A string whose output peak stays below this for a whole block is considered decayed.
+	static constexpr double IDLE_PEAK_THRESHOLD = 0.0001;
+
 	// Standard guitar open-string semitone offsets (E2..E4).
 	static constexpr int STRING_SEMITONES[NUM_STRINGS] = { 19, 24, 29, 34, 38, 43 };
 
@@ -52,26 +59,13 @@ class SiOPMChannelGuitar6 : public SiOPMChannelBase {
 
 	// --- Per-string state ---
 
+	// Excitation and scheduling state, only touched when a string is plucked.
 	struct GuitarString {
-		double delay[MAX_DELAY_SAMPLES] = {};
-
 		NoiseGen string_noise_gen;
 		NoiseGen damp_noise_gen;
 
-		double df = 0;
-		double dc_x1 = 0;
-		double dc_y1 = 0;
-		double dc_reject_coef = 0.9999;
-
 		double velocity = 0;
-		int write_index = 0;
 		double pre_pan = 0;
-		double read_offset = 0;
-		int period_n = -1;
-		double dc = 0;
-		double loop_gain = 0.9992;
-		double gain_l = 0;
-		double gain_r = 0;
 		int semitone = 0;
 
 		double noise_lp_coef = 0;
@@ -83,19 +77,30 @@ class SiOPMChannelGuitar6 : public SiOPMChannelBase {
 
 		void init(int p_index, double p_sample_rate);
 		void add_pluck(int p_tab_index, double p_velocity, int p_target_sample);
-		void process(double *p_left, double *p_right, int p_block_start, int p_num_samples,
-				const double *p_char_noise, int p_char_noise_len,
-				double p_character_variation, double p_string_damp, double p_string_damp_variation,
-				double p_plug_damp_param, double p_plug_damp_variation, double p_string_tension,
-				double p_stereo_spread, double p_sample_rate);
-		void reset_state();
-
-	private:
-		void execute_pluck(const PluckEvent &p_pluck, const double *p_char_noise, int p_char_noise_len,
-				double p_character_variation, double p_string_damp, double p_string_damp_variation,
-				double p_plug_damp_param, double p_plug_damp_variation, double p_string_tension,
-				double p_stereo_spread, double p_sample_rate);
-		void process_add(double *p_left, double *p_right, int p_start, int p_count);
+		void pop_pluck();
+	};
+
+	// Loop state of all strings, laid out structure-of-arrays so one lane group
+	// is advanced by the same instructions.
+	struct StringBank {
+		double *delay[LANE_COUNT] = {};
+		int period[LANE_COUNT] = {};
+		int write_index[LANE_COUNT] = {};
+		int read_int[LANE_COUNT] = {};
+		double read_frac[LANE_COUNT] = {};
+
+		double df[LANE_COUNT] = {};
+		double dc_x1[LANE_COUNT] = {};
+		double dc_y1[LANE_COUNT] = {};
+		double dc[LANE_COUNT] = {};
+		double loop_gain[LANE_COUNT] = {};
+		double gain_l[LANE_COUNT] = {};
+		double gain_r[LANE_COUNT] = {};
+
+		double peak[LANE_COUNT] = {};
+		bool active[LANE_COUNT] = {};
+
+		double dc_reject_coef = 0.9999;
 	};
 
 	// --- Body resonator ---
@@ -114,6 +119,13 @@ class SiOPMChannelGuitar6 : public SiOPMChannelBase {
 	NoiseGen _char_noise_gen;
 	double _char_noise[CHAR_NOISE_LENGTH] = {};
 	GuitarString _strings[NUM_STRINGS];
+	StringBank _bank;
+
+	// Delay lines of all strings, each sized for the lowest open string at the current sample rate.
+	Vector<double> _delay_memory;
+	int _delay_capacity = 0;
+	// Backing storage for padding lanes, which never carry any signal.
+	double _silent_delay[2] = {};
 	Resonator _body_resonators[3];
 	bool _body_bypass = false;
 
@@ -136,6 +148,13 @@ class SiOPMChannelGuitar6 : public SiOPMChannelBase {
 
 	void _randomize_character_noise(uint32_t p_seed);
 	void _init_body_resonators(double p_sample_rate);
+	void _init_string_bank(double p_sample_rate);
+
+	void _execute_pluck(int p_string_index, const PluckEvent &p_pluck, double p_sample_rate);
+	void _silence_lane(int p_lane);
+	bool _is_lane_group_active(int p_group) const;
+	void _process_lane_group(int p_group, int p_start, int p_count);
+	void _update_lane_idling();
 
 	void _no_process_guitar(int p_length);
 
@@ -622,7 +622,7 @@ void SiOPMChannelKS::set_karplus_strong_params(int p_attack_rate, int p_decay_ra
 	set_params_by_value(p_attack_rate, p_decay_rate, 0, 63, 15, p_total_level, 0, 0, 1, 0, 0, 0, 0, p_fixed_pitch);
 
 	_active_operator->set_pulse_generator_type(wave_shape);
-	Ref<SiOPMWaveTable> wave_table = _table->get_wave_table(_active_operator->get_pulse_generator_type());
+	Ref<SiOPMWaveTable> wave_table = _table->get_wave_table(_active_operator->get_pulse_generator_type(), _ref_stencil);
 	_active_operator->set_pitch_table_type(wave_table->get_default_pitch_table_type());
 
 	set_all_release_rate(p_tension);
@@ -637,7 +637,7 @@ void SiOPMChannelKS::apply_ks_runtime_params(int p_attack_rate, int p_decay_rate
 	_active_operator->set_fixed_pitch_index(p_fixed_pitch << 6);
 	_active_operator->set_pulse_generator_type(wave_shape);
 	{
-		Ref<SiOPMWaveTable> wave_table = _table->get_wave_table(_active_operator->get_pulse_generator_type());
+		Ref<SiOPMWaveTable> wave_table = _table->get_wave_table(_active_operator->get_pulse_generator_type(), _ref_stencil);
 		_active_operator->set_pitch_table_type(wave_table->get_default_pitch_table_type());
 	}
 	set_all_release_rate(p_tension);
@@ -661,7 +661,7 @@ void SiOPMChannelKS::set_channel_params(const Ref<SiOPMChannelParams> &p_params,
 		return;
 	}
 
-	_apply_common_channel_params(p_params, p_with_volume, p_with_modulation);
+	_apply_common_channel_params(p_params->get_program(), p_with_volume, p_with_modulation);
 
 	Ref<SiOPMOperatorParams> op = p_params->get_operator_params(0);
 	apply_ks_runtime_params(
@@ -681,7 +681,7 @@ void SiOPMChannelKS::set_parameters(Vector<int> p_params) {
 		case KS_SEED_FM: {
 			ERR_FAIL_INDEX(_ks_seed_index, SiMMLRefTable::VOICE_MAX);
 
-			Ref<SiMMLVoice> voice = SiMMLRefTable::get_instance()->get_voice(_ks_seed_index);
+			Ref<SiMMLVoice> voice = SiMMLRefTable::get_instance()->get_voice(_ks_seed_index, _ref_stencil);
 			if (voice.is_valid()) {
 				set_channel_params(voice->get_channel_params(), false);
 			}
@@ -690,7 +690,7 @@ void SiOPMChannelKS::set_parameters(Vector<int> p_params) {
 		case KS_SEED_PCM: {
 			ERR_FAIL_INDEX(_ks_seed_index, SiOPMRefTable::PCM_DATA_MAX);
 
-			Ref<SiOPMWavePCMTable> pcm_table = _table->get_pcm_data(_ks_seed_index);
+			Ref<SiOPMWavePCMTable> pcm_table = _table->get_pcm_data(_ks_seed_index, _ref_stencil);
 			if (pcm_table.is_valid()) {
 				set_wave_data(pcm_table);
 			}
@@ -701,7 +701,7 @@ void SiOPMChannelKS::set_parameters(Vector<int> p_params) {
 			set_params_by_value(p_params[1], p_params[2], 0, 63, 15, p_params[3], 0, 0, 1, 0, 0, 0, 0, p_params[4]);
 
 			_active_operator->set_pulse_generator_type(p_params[5] == INT32_MIN ? SiONPulseGeneratorType::PULSE_NOISE_PINK : p_params[5]);
-			Ref<SiOPMWaveTable> wave_table = _table->get_wave_table(_active_operator->get_pulse_generator_type());
+			Ref<SiOPMWaveTable> wave_table = _table->get_wave_table(_active_operator->get_pulse_generator_type(), _ref_stencil);
 			_active_operator->set_pitch_table_type(wave_table->get_default_pitch_table_type());
 		} break;
 	}
@@ -932,7 +932,8 @@ void SiOPMChannelKS::note_off() {
 
 void SiOPMChannelKS::reset_channel_buffer_status() {
 	SiOPMChannelFM::reset_channel_buffer_status();
-	if (!_is_idling) {
+	if (!_is_idling || _is_decayed) {
+		// A decayed voice idles even if the loop still holds sub-threshold residue.
 		return;
 	}
 
@@ -1108,6 +1109,7 @@ void SiOPMChannelKS::buffer(int p_length) {
 	if (_kill_fade_remaining_samples > 0) {
 		_apply_kill_fade(mono_out, p_length);
 	}
+	_report_idle_peak(mono_out, p_length);
 
 	if (_output_mode == OutputMode::OUTPUT_STANDARD && !_mute) {
 		const bool is_redirected_main_stream = (_streams[0] != nullptr && _streams[0] != _sound_chip->get_output_stream());
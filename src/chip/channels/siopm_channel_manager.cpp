@@ -20,82 +20,44 @@
 
 using namespace godot;
 
-SiOPMSoundChip *SiOPMChannelManager::_sound_chip = nullptr;
-HashMap<SiOPMChannelManager::ChannelType, SiOPMChannelManager *> SiOPMChannelManager::_channel_managers;
-
-void SiOPMChannelManager::initialize(SiOPMSoundChip *p_chip) {
-	_sound_chip = p_chip;
-
-	_channel_managers[CHANNEL_FM]      = memnew(SiOPMChannelManager(CHANNEL_FM));
-	_channel_managers[CHANNEL_PCM]     = memnew(SiOPMChannelManager(CHANNEL_PCM));
-	_channel_managers[CHANNEL_SAMPLER] = memnew(SiOPMChannelManager(CHANNEL_SAMPLER));
-	_channel_managers[CHANNEL_KS]      = memnew(SiOPMChannelManager(CHANNEL_KS));
-	_channel_managers[CHANNEL_STREAM]  = memnew(SiOPMChannelManager(CHANNEL_STREAM));
-	_channel_managers[CHANNEL_GUITAR6] = memnew(SiOPMChannelManager(CHANNEL_GUITAR6));
-	_channel_managers[CHANNEL_STRATA]    = memnew(SiOPMChannelManager(CHANNEL_STRATA));
-	_channel_managers[CHANNEL_MONOLITH] = memnew(SiOPMChannelManager(CHANNEL_MONOLITH));
-}
-
-void SiOPMChannelManager::finalize() {
-	_sound_chip = nullptr;
-
-	memdelete(_channel_managers[CHANNEL_FM]);
-	memdelete(_channel_managers[CHANNEL_PCM]);
-	memdelete(_channel_managers[CHANNEL_SAMPLER]);
-	memdelete(_channel_managers[CHANNEL_KS]);
-	memdelete(_channel_managers[CHANNEL_STREAM]);
-	memdelete(_channel_managers[CHANNEL_GUITAR6]);
-	memdelete(_channel_managers[CHANNEL_STRATA]);
-	memdelete(_channel_managers[CHANNEL_MONOLITH]);
-	_channel_managers.clear();
-}
-
 void SiOPMChannelManager::initialize_all_channels() {
-	for (const KeyValue<ChannelType, SiOPMChannelManager *> &kv : _channel_managers) {
-		kv.value->_initialize_all();
+	for (int i = 0; i < CHANNEL_MAX; i++) {
+		ChannelPool &pool = _pools[i];
+		pool.active_count = 0;
+		for (SiOPMChannelBase *channel = pool.terminator->_next; channel != pool.terminator; channel = channel->_next) {
+			channel->_is_free = true;
+			channel->initialize(nullptr, 0);
+		}
 	}
 }
 
 void SiOPMChannelManager::reset_all_channels() {
-	for (const KeyValue<ChannelType, SiOPMChannelManager *> &kv : _channel_managers) {
-		kv.value->_reset_all();
+	for (int i = 0; i < CHANNEL_MAX; i++) {
+		ChannelPool &pool = _pools[i];
+		pool.active_count = 0;
+		for (SiOPMChannelBase *channel = pool.terminator->_next; channel != pool.terminator; channel = channel->_next) {
+			channel->_is_free = true;
+			channel->reset();
+		}
 	}
 }
 
-SiOPMChannelBase *SiOPMChannelManager::create_channel(ChannelType p_type, SiOPMChannelBase *p_prev, int p_buffer_index) {
-	return _channel_managers[p_type]->_create_channel(p_prev, p_buffer_index);
-}
-
-void SiOPMChannelManager::delete_channel(SiOPMChannelBase *p_channel) {
-	_channel_managers[(ChannelType)p_channel->_channel_type]->_delete_channel(p_channel);
-}
-
-
-SiOPMChannelBase *SiOPMChannelManager::_create_channel(SiOPMChannelBase *p_prev, int p_buffer_index) {
+SiOPMChannelBase *SiOPMChannelManager::_allocate_channel(ChannelType p_type) {
 	SiOPMChannelBase *new_channel = nullptr;
 
-	if (_terminator->_next->_is_free) {
-		// The head channel is free -> The head will be a new channel.
-		new_channel = _terminator->_next;
-		new_channel->_prev->_next = new_channel->_next;
-		new_channel->_next->_prev = new_channel->_prev;
-	} else {
-		// The head channel is active -> channel overflow.
-		// Create new channel.
-
-		switch (_channel_type) {
-			case CHANNEL_FM: {
-				new_channel = memnew(SiOPMChannelFM(_sound_chip));
-			} break;
-			case CHANNEL_PCM: {
-				new_channel = memnew(SiOPMChannelPCM(_sound_chip));
-			} break;
-			case CHANNEL_SAMPLER: {
-				new_channel = memnew(SiOPMChannelSampler(_sound_chip));
-			} break;
-			case CHANNEL_KS: {
-				new_channel = memnew(SiOPMChannelKS(_sound_chip));
-			} break;
+	switch (p_type) {
+		case CHANNEL_FM: {
+			new_channel = memnew(SiOPMChannelFM(_sound_chip));
+		} break;
+		case CHANNEL_PCM: {
+			new_channel = memnew(SiOPMChannelPCM(_sound_chip));
+		} break;
+		case CHANNEL_SAMPLER: {
+			new_channel = memnew(SiOPMChannelSampler(_sound_chip));
+		} break;
+		case CHANNEL_KS: {
+			new_channel = memnew(SiOPMChannelKS(_sound_chip));
+		} break;
 		case CHANNEL_STREAM: {
 			new_channel = memnew(SiOPMChannelStream(_sound_chip));
 		} break;
@@ -110,67 +72,112 @@ SiOPMChannelBase *SiOPMChannelManager::_create_channel(SiOPMChannelBase *p_prev,
 		} break;
 
 		default: break; // Silences enum warnings.
-		}
+	}
+
+	ERR_FAIL_NULL_V(new_channel, nullptr);
+	new_channel->_channel_type = p_type;
+	_pools[p_type].length++;
+	return new_channel;
+}
+
+SiOPMChannelBase *SiOPMChannelManager::create_channel(ChannelType p_type, SiOPMChannelBase *p_prev, int p_buffer_index) {
+	ERR_FAIL_INDEX_V(p_type, CHANNEL_MAX, nullptr);
+	ChannelPool &pool = _pools[p_type];
+	SiOPMChannelBase *new_channel = nullptr;
 
+	if (pool.terminator->_next->_is_free) {
+		// The head channel is free -> The head will be a new channel.
+		new_channel = pool.terminator->_next;
+		new_channel->_prev->_next = new_channel->_next;
+		new_channel->_next->_prev = new_channel->_prev;
+	} else {
+		// The head channel is active -> channel overflow.
+		// Create new channel.
+		new_channel = _allocate_channel(p_type);
 		ERR_FAIL_NULL_V(new_channel, nullptr);
-		new_channel->_channel_type = _channel_type;
-		_length++;
 	}
 
 	// Set new channel to the tail and activate.
 	new_channel->_is_free = false;
-	new_channel->_prev = _terminator->_prev;
-	new_channel->_next = _terminator;
+	new_channel->_prev = pool.terminator->_prev;
+	new_channel->_next = pool.terminator;
 	new_channel->_prev->_next = new_channel;
 	new_channel->_next->_prev = new_channel;
 
+	pool.active_count++;
+
 	// initialize
 	new_channel->initialize(p_prev, p_buffer_index);
 
 	return new_channel;
 }
 
-void SiOPMChannelManager::_delete_channel(SiOPMChannelBase *p_channel) {
+void SiOPMChannelManager::delete_channel(SiOPMChannelBase *p_channel) {
+	ERR_FAIL_COND_MSG(p_channel->_sound_chip != _sound_chip, "SiOPMChannelManager: Channel belongs to another sound chip.");
+	ChannelPool &pool = _pools[p_channel->_channel_type];
+
+	if (!p_channel->_is_free) {
+		pool.active_count--;
+	}
 	p_channel->_is_free = true;
 	p_channel->_prev->_next = p_channel->_next;
 	p_channel->_next->_prev = p_channel->_prev;
-	p_channel->_prev = _terminator;
-	p_channel->_next = _terminator->_next;
+	p_channel->_prev = pool.terminator;
+	p_channel->_next = pool.terminator->_next;
 	p_channel->_prev->_next = p_channel;
 	p_channel->_next->_prev = p_channel;
 }
 
-void SiOPMChannelManager::_initialize_all() {
-	for (SiOPMChannelBase *channel = _terminator->_next; channel != _terminator; channel = channel->_next) {
+void SiOPMChannelManager::reserve_channels(ChannelType p_type, int p_count) {
+	ERR_FAIL_INDEX(p_type, CHANNEL_MAX);
+	ChannelPool &pool = _pools[p_type];
+
+	while (pool.length < p_count) {
+		SiOPMChannelBase *channel = _allocate_channel(p_type);
+		ERR_FAIL_NULL(channel);
+
+		// Free channels are kept at the head of the list.
 		channel->_is_free = true;
 		channel->initialize(nullptr, 0);
+		channel->_prev = pool.terminator;
+		channel->_next = pool.terminator->_next;
+		channel->_prev->_next = channel;
+		channel->_next->_prev = channel;
 	}
 }
 
-void SiOPMChannelManager::_reset_all() {
-	for (SiOPMChannelBase *channel = _terminator->_next; channel != _terminator; channel = channel->_next) {
-		channel->_is_free = true;
-		channel->reset();
-	}
+int SiOPMChannelManager::get_channel_count(ChannelType p_type) const {
+	ERR_FAIL_INDEX_V(p_type, CHANNEL_MAX, 0);
+	return _pools[p_type].length;
 }
 
-SiOPMChannelManager::SiOPMChannelManager(ChannelType p_channel_type) {
-	_channel_type = p_channel_type;
+int SiOPMChannelManager::get_active_channel_count(ChannelType p_type) const {
+	ERR_FAIL_INDEX_V(p_type, CHANNEL_MAX, 0);
+	return _pools[p_type].active_count;
+}
+
+SiOPMChannelManager::SiOPMChannelManager(SiOPMSoundChip *p_chip) {
+	_sound_chip = p_chip;
 
-	_terminator = memnew(SiOPMChannelBase(_sound_chip));
-	_terminator->_is_free = false;
-	_terminator->_next = _terminator;
-	_terminator->_prev = _terminator;
-	_length = 0;
+	for (int i = 0; i < CHANNEL_MAX; i++) {
+		ChannelPool &pool = _pools[i];
+		pool.terminator = memnew(SiOPMChannelBase(_sound_chip));
+		pool.terminator->_is_free = false;
+		pool.terminator->_next = pool.terminator;
+		pool.terminator->_prev = pool.terminator;
+	}
 }
 
 SiOPMChannelManager::~SiOPMChannelManager() {
-	SiOPMChannelBase *channel = _terminator->_next;
-	while (channel && channel != _terminator) {
-		SiOPMChannelBase *next_channel = channel->_next;
-		memdelete(channel);
-		channel = next_channel;
-	}
+	for (int i = 0; i < CHANNEL_MAX; i++) {
+		ChannelPool &pool = _pools[i];
+		SiOPMChannelBase *channel = pool.terminator->_next;
+		while (channel && channel != pool.terminator) {
+			SiOPMChannelBase *next_channel = channel->_next;
+			memdelete(channel);
+			channel = next_channel;
+		}
 
-	memdelete(_terminator);
+		memdelete(pool.terminator);
+	}
 }
@@ -7,10 +7,6 @@
 #ifndef SIOPM_CHANNEL_MANAGER_H
 #define SIOPM_CHANNEL_MANAGER_H
 
-#include <godot_cpp/templates/hash_map.hpp>
-
-using namespace godot;
-
 class SiOPMChannelBase;
 class SiOPMSoundChip;
 
@@ -30,32 +26,33 @@ public:
 	};
 
 private:
-	static SiOPMSoundChip *_sound_chip;
-	static HashMap<ChannelType, SiOPMChannelManager *> _channel_managers;
+	// Channels of one type, free ones at the head of the list and active ones at the tail.
+	struct ChannelPool {
+		SiOPMChannelBase *terminator = nullptr;
+		int length = 0;
+		int active_count = 0;
+	};
 
-	ChannelType _channel_type = ChannelType::CHANNEL_MAX;
-	SiOPMChannelBase *_terminator;
-	int _length = 0;
+	SiOPMSoundChip *_sound_chip = nullptr;
+	ChannelPool _pools[CHANNEL_MAX];
 
-	// Returns null when the channel count is overflown.
-	SiOPMChannelBase *_create_channel(SiOPMChannelBase *p_prev, int p_buffer_index);
-	void _delete_channel(SiOPMChannelBase *p_channel);
-	void _initialize_all();
-	void _reset_all();
+	SiOPMChannelBase *_allocate_channel(ChannelType p_type);
 
 public:
-	static void initialize(SiOPMSoundChip *p_chip);
-	static void finalize();
-
-	static void initialize_all_channels();
-	static void reset_all_channels();
+	void initialize_all_channels();
+	void reset_all_channels();
 
-	static SiOPMChannelBase *create_channel(ChannelType p_type, SiOPMChannelBase *p_prev, int p_buffer_index);
-	static void delete_channel(SiOPMChannelBase *p_channel);
+	// Returns null when the channel count is overflown.
+	SiOPMChannelBase *create_channel(ChannelType p_type, SiOPMChannelBase *p_prev, int p_buffer_index);
+	void delete_channel(SiOPMChannelBase *p_channel);
 
-	int get_length() const { return _length; }
+	// Pre-create free channels so that up to p_count of this type are handed out without
+	// allocating on the audio thread.
+	void reserve_channels(ChannelType p_type, int p_count);
+	int get_channel_count(ChannelType p_type) const;
+	int get_active_channel_count(ChannelType p_type) const;
 
-	SiOPMChannelManager(ChannelType p_channel_type);
+	SiOPMChannelManager(SiOPMSoundChip *p_chip);
 	~SiOPMChannelManager();
 };
 
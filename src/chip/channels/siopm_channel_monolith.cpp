@@ -12,10 +12,12 @@
 static constexpr double TWO_PI = 6.283185307179586;
 static constexpr double PI = 3.141592653589793;
 static constexpr double HALF_PI = 1.5707963267948966;
-static constexpr double PHASE_TO_RAD = TWO_PI / 4294967296.0;
 static constexpr double PHASE_TO_NORM = 1.0 / 4294967296.0;
 static constexpr double PIPE_PEAK = 8192.0;
 
+// The 2x drive stage is skipped when the engine already runs at this rate or above.
+static constexpr double DRIVE_OVERSAMPLING_MAX_RATE = 88200.0;
+
 // Motion filter / resonance tuning (internal main-layer SVF).
 static constexpr double MOTION_FILTER_BASE_HZ = 1200.0; // sweep center
 static constexpr double MOTION_FILTER_OCT = 3.0;        // +/- octaves at full motion
@@ -35,8 +37,91 @@ static inline double fast_tanh(double x) {
 	return x * (27.0 + x2) / (27.0 + 9.0 * x2);
 }
 
+// Fast sine: 2048-point table with linear interpolation, addressed by the top
+// bits of a 32-bit phase. Error is around 1e-6, far below the pipe resolution.
+static constexpr int SINE_TABLE_BITS = 11;
+static constexpr int SINE_TABLE_SIZE = 1 << SINE_TABLE_BITS;
+static constexpr int SINE_TABLE_SHIFT = 32 - SINE_TABLE_BITS;
+static constexpr uint32_t SINE_TABLE_FRAC_MASK = (1u << SINE_TABLE_SHIFT) - 1;
+static constexpr double SINE_TABLE_FRAC_SCALE = 1.0 / (double)(1u << SINE_TABLE_SHIFT);
+static constexpr double RAD_TO_PHASE = 4294967296.0 / TWO_PI;
+
+static const struct MonolithSineTable {
+	double values[SINE_TABLE_SIZE + 1];
+
+	MonolithSineTable() {
+		for (int i = 0; i <= SINE_TABLE_SIZE; i++) {
+			values[i] = std::sin(TWO_PI * (double)i / (double)SINE_TABLE_SIZE);
+		}
+	}
+} sine_table;
+
+static inline double fast_sin_phase(uint32_t p_phase) {
+	const uint32_t index = p_phase >> SINE_TABLE_SHIFT;
+	const double frac = (double)(p_phase & SINE_TABLE_FRAC_MASK) * SINE_TABLE_FRAC_SCALE;
+	const double a = sine_table.values[index];
+	return a + (sine_table.values[index + 1] - a) * frac;
+}
+
+static inline uint32_t rad_to_phase(double p_radians) {
+	// Go through int64 so negative angles wrap instead of saturating.
+	return (uint32_t)(int64_t)(p_radians * RAD_TO_PHASE);
+}
+
+static inline double fast_sin(double p_radians) {
+	return fast_sin_phase(rad_to_phase(p_radians));
+}
+
+// Fast 2^x (split exponent, 6th-order polynomial on the fraction, ~1e-5 relative error).
+static inline double fast_exp2(double x) {
+	if (x < -1022.0) {
+		return 0.0;
+	}
+	const double whole = std::floor(x);
+	const double f = x - whole;
+	const double p = 1.0 + f * (0.6931471805599453 + f * (0.2402265069591007 + f * (0.0555041086648216 + f * (0.0096181291076285 + f * (0.0013333558146428 + f * 0.0001540353039338)))));
+
+	const uint64_t exponent_bits = (uint64_t)((int64_t)whole + 1023) << 52;
+	double scale;
+	std::memcpy(&scale, &exponent_bits, sizeof(scale));
+	return p * scale;
+}
+
+// Fast log2(x) for x > 0 (atanh series on the mantissa, ~1e-7 absolute error).
+static inline double fast_log2(double x) {
+	uint64_t bits;
+	std::memcpy(&bits, &x, sizeof(bits));
+	const int exponent = (int)((bits >> 52) & 0x7ff) - 1023;
+	bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+	double m;
+	std::memcpy(&m, &bits, sizeof(m));
+
+	// Center the mantissa on 1 so the series converges quickly.
+	double e = (double)exponent;
+	if (m > 1.4142135623730951) {
+		m *= 0.5;
+		e += 1.0;
+	}
+	const double y = (m - 1.0) / (m + 1.0);
+	const double y2 = y * y;
+	return e + 2.8853900817779268 * y * (1.0 + y2 * (0.3333333333333333 + y2 * (0.2 + y2 * 0.1428571428571429)));
+}
+
+static inline double fast_exp(double x) {
+	return fast_exp2(x * 1.4426950408889634);
+}
+
+// t^e for t in [0, 1].
+static inline double fast_pow_unit(double p_t, double p_exponent) {
+	if (p_t <= 0.0) {
+		return 0.0;
+	}
+	return fast_exp2(p_exponent * fast_log2(p_t));
+}
+
 // PolyBLEP residual for anti-aliased discontinuities.
 // p_t: normalized phase [0,1), p_dt: normalized frequency (phase_inc / 2^32).
+// Scaled for a step of height 2 (a full -1..1 jump).
 static inline double poly_blep(double p_t, double p_dt) {
 	if (p_dt <= 0.0) {
 		return 0.0;
@@ -51,6 +136,46 @@ static inline double poly_blep(double p_t, double p_dt) {
 	return 0.0;
 }
 
+// PolyBLAMP residual (integrated polyBLEP) for slope discontinuities.
+// Multiply by slope_change * dt / 2 to correct a corner.
+static inline double poly_blamp(double p_t, double p_dt) {
+	if (p_dt <= 0.0) {
+		return 0.0;
+	}
+	if (p_t < p_dt) {
+		double n = 1.0 - p_t / p_dt;
+		return n * n * n * (1.0 / 3.0);
+	} else if (p_t > 1.0 - p_dt) {
+		double n = 1.0 + (p_t - 1.0) / p_dt;
+		return n * n * n * (1.0 / 3.0);
+	}
+	return 0.0;
+}
+
+// Triangle with its peak at p_peak, corners rounded with polyBLAMP.
+static inline double blamp_triangle(double p_t, double p_peak, double p_dt) {
+	double sample;
+	if (p_t < p_peak) {
+		sample = 2.0 * p_t / p_peak - 1.0;
+	} else {
+		sample = 1.0 - 2.0 * (p_t - p_peak) / (1.0 - p_peak);
+	}
+
+	double t_peak = p_t - p_peak;
+	if (t_peak < 0.0) {
+		t_peak += 1.0;
+	}
+	const double slope_change = 2.0 / p_peak + 2.0 / (1.0 - p_peak);
+	sample += slope_change * p_dt * 0.5 * (poly_blamp(p_t, p_dt) - poly_blamp(t_peak, p_dt));
+	return sample;
+}
+
+// Halfband FIR used to decimate the 2x drive stage (6-point Lagrange design,
+// 11 taps). Only the odd taps are non-zero; the center tap is 0.5.
+static constexpr double HALFBAND_TAP1 = 150.0 / 512.0;
+static constexpr double HALFBAND_TAP3 = -25.0 / 512.0;
+static constexpr double HALFBAND_TAP5 = 3.0 / 512.0;
+
 // ---------------------------------------------------------------------------
 // Phase / frequency helpers
 // ---------------------------------------------------------------------------
@@ -64,10 +189,19 @@ uint32_t SiOPMChannelMonolith::_freq_to_phase_inc(double p_freq) {
 
 uint32_t SiOPMChannelMonolith::_pitch_to_phase_inc(double p_pitch_units) {
 	// SiON pitch: 64 units per semitone, note 69 = 4416 = 440 Hz.
-	double freq = 440.0 * std::pow(2.0, (p_pitch_units - 4416.0) / 768.0);
+	double freq = 440.0 * std::exp2((p_pitch_units - 4416.0) / 768.0);
 	return _freq_to_phase_inc(freq);
 }
 
+uint32_t SiOPMChannelMonolith::_cached_pitch_to_phase_inc(double p_pitch_units, PitchCache &r_cache) {
+	// Pitch only moves during glide, pitch drop and drift; skip the exp2 otherwise.
+	if (p_pitch_units != r_cache.pitch) {
+		r_cache.pitch = p_pitch_units;
+		r_cache.phase_inc = _pitch_to_phase_inc(p_pitch_units);
+	}
+	return r_cache.phase_inc;
+}
+
 void SiOPMChannelMonolith::_update_phase_increments(double p_motion_mod) {
 	double pitch = (double)_current_pitch;
 
@@ -87,13 +221,14 @@ void SiOPMChannelMonolith::_update_phase_increments(double p_motion_mod) {
 	if (_pitch_env_level > 0.001) {
 		sub_pitch += _pitch_env_level * ((double)_pitch_drop / 127.0) * PITCH_DROP_MAX_UNITS;
 	}
-	_sub_phase_inc = _pitch_to_phase_inc(sub_pitch);
+	_sub_phase_inc = _cached_pitch_to_phase_inc(sub_pitch, _sub_pitch_cache);
+	_sub_dt = (double)_sub_phase_inc * PHASE_TO_NORM;
 
 	// Main oscillators with mass-based detune. Mass drift adds a slow detune
 	// wobble to osc2 only (never the sub) for analog-like movement.
 	double osc2_detune = _mass_detune_pitch * 0.5 + _mass_drift_value * 3.84; // +/-6 cents at full drift
-	_osc1_phase_inc = _pitch_to_phase_inc(pitch - _mass_detune_pitch * 0.5);
-	_osc2_phase_inc = _pitch_to_phase_inc(pitch + osc2_detune);
+	_osc1_phase_inc = _cached_pitch_to_phase_inc(pitch - _mass_detune_pitch * 0.5, _osc1_pitch_cache);
+	_osc2_phase_inc = _cached_pitch_to_phase_inc(pitch + osc2_detune, _osc2_pitch_cache);
 
 	// Precompute normalized frequency for polyBLEP.
 	_osc1_dt = (double)_osc1_phase_inc * PHASE_TO_NORM;
@@ -133,45 +268,44 @@ double SiOPMChannelMonolith::_generate_sub_sample() {
 
 	switch (_sub_shape) {
 		case SUB_SINE:
-			sample = std::sin((double)_sub_phase * PHASE_TO_RAD);
+			sample = fast_sin_phase(_sub_phase);
 			break;
 
 		case SUB_TRIANGLE: {
-			sample = (t < 0.5) ? (4.0 * t - 1.0) : (3.0 - 4.0 * t);
+			sample = blamp_triangle(t, 0.5, _sub_dt);
 		} break;
 
 		case SUB_ROUNDED_SQUARE: {
 			// Sine driven through saturation for rounded square edges.
-			double s = std::sin((double)_sub_phase * PHASE_TO_RAD);
+			double s = fast_sin_phase(_sub_phase);
 			sample = fast_tanh(s * 3.0);
 		} break;
 
 		case SUB_SATURATED_SINE: {
-			double s = std::sin((double)_sub_phase * PHASE_TO_RAD);
+			double s = fast_sin_phase(_sub_phase);
 			sample = fast_tanh(s * 2.0);
 		} break;
 
 		case SUB_OCTAVE_STACK: {
-			double fund = std::sin((double)_sub_phase * PHASE_TO_RAD);
-			double oct_below = std::sin((double)_sub_oct_phase * PHASE_TO_RAD);
+			double fund = fast_sin_phase(_sub_phase);
+			double oct_below = fast_sin_phase(_sub_oct_phase);
 			sample = fund * 0.6 + oct_below * 0.4;
 		} break;
 
 		case SUB_DUAL_HARMONIC: {
 			double harmonic_mix = 0.22 + ((double)_shape_warp / 127.0) * 0.23;
-			double fund = std::sin((double)_sub_phase * PHASE_TO_RAD);
-			double second = std::sin((double)_sub_phase * PHASE_TO_RAD * 2.0);
+			double fund = fast_sin_phase(_sub_phase);
+			double second = fast_sin_phase(_sub_phase << 1);
 			sample = fund * (1.0 - harmonic_mix) + second * harmonic_mix;
 		} break;
 
 		case SUB_PHASE_WARP: {
 			double warp = 0.75 + ((double)_shape_warp / 127.0) * 1.25;
-			double phase = (double)_sub_phase * PHASE_TO_RAD;
-			sample = std::sin(phase + std::sin(phase) * warp);
+			sample = fast_sin_phase(_sub_phase + rad_to_phase(fast_sin_phase(_sub_phase) * warp));
 		} break;
 
 		default:
-			sample = std::sin((double)_sub_phase * PHASE_TO_RAD);
+			sample = fast_sin_phase(_sub_phase);
 			break;
 	}
 
@@ -179,7 +313,7 @@ double SiOPMChannelMonolith::_generate_sub_sample() {
 }
 
 // ---------------------------------------------------------------------------
-// Main oscillator (per voice) with polyBLEP anti-aliasing
+// Main oscillator (per voice) with polyBLEP/polyBLAMP anti-aliasing
 // ---------------------------------------------------------------------------
 
 double SiOPMChannelMonolith::_generate_osc_sample(uint32_t p_phase, int p_shape, double p_warp, double p_dt) {
@@ -191,7 +325,7 @@ double SiOPMChannelMonolith::_generate_osc_sample(uint32_t p_phase, int p_shape,
 			// Sawtooth with optional warp (bends the ramp).
 			double warped_t = t;
 			if (p_warp > 0.01) {
-				warped_t = std::pow(t, 1.0 + p_warp * 2.0);
+				warped_t = fast_pow_unit(t, 1.0 + p_warp * 2.0);
 			}
 			sample = 2.0 * warped_t - 1.0;
 			// PolyBLEP correction at the wrap discontinuity.
@@ -212,52 +346,54 @@ double SiOPMChannelMonolith::_generate_osc_sample(uint32_t p_phase, int p_shape,
 		} break;
 
 		case OSC_TRIANGLE: {
-			double warped_t = t;
-			if (p_warp > 0.01) {
-				// Warp skews the triangle peak position.
-				double peak = 0.5 - p_warp * 0.35;
-				if (warped_t < peak) {
-					sample = 2.0 * warped_t / peak - 1.0;
-				} else {
-					sample = 1.0 - 2.0 * (warped_t - peak) / (1.0 - peak);
-				}
-			} else {
-				sample = (t < 0.5) ? (4.0 * t - 1.0) : (3.0 - 4.0 * t);
-			}
-			// Triangle is continuous so no BLEP needed.
+			// Warp skews the triangle peak position. The triangle is continuous,
+			// so its corners only need polyBLAMP.
+			double peak = (p_warp > 0.01) ? (0.5 - p_warp * 0.35) : 0.5;
+			sample = blamp_triangle(t, peak, p_dt);
 		} break;
 
 		case OSC_SINE_FOLD: {
 			// Sine through wavefolder. Warp controls fold intensity.
-			double s = std::sin((double)p_phase * PHASE_TO_RAD);
+			double s = fast_sin_phase(p_phase);
 			double fold = 1.0 + p_warp * 6.0;
-			sample = std::sin(s * fold * HALF_PI);
+			sample = fast_sin(s * fold * HALF_PI);
 		} break;
 
 		case OSC_FORMANT: {
 			// Harmonic coloration via pitch-tracking ratio (not
 			// frequency-stable formant synthesis). Warp sweeps the
 			// harmonic ratio for growl and tonal color.
-			double carrier = std::sin((double)p_phase * PHASE_TO_RAD);
+			double carrier = fast_sin_phase(p_phase);
 			double formant_ratio = 2.0 + p_warp * 6.0;
-			double formant = std::sin((double)p_phase * PHASE_TO_RAD * formant_ratio);
-			double window = 0.5 + 0.5 * std::cos((double)p_phase * PHASE_TO_RAD);
+			double formant = fast_sin_phase((uint32_t)(uint64_t)((double)p_phase * formant_ratio));
+			double window = 0.5 + 0.5 * fast_sin_phase(p_phase + 0x40000000u);
 			sample = carrier * 0.5 + formant * window * 0.5;
 		} break;
 
 		case OSC_SYNC: {
 			// Hard sync emulation. Warp controls sync ratio.
 			double sync_ratio = 1.0 + p_warp * 4.0;
-			double sync_phase = std::fmod(t * sync_ratio, 1.0);
+			double sync_t = t * sync_ratio;
+			double sync_cycle = std::floor(sync_t);
+			double sync_phase = sync_t - sync_cycle;
 			sample = 2.0 * sync_phase - 1.0;
-			// PolyBLEP at sync reset points.
+
+			// PolyBLEP at the slave resets inside the master cycle. A reset that
+			// lands on the master wrap is handled below with the right height.
 			double sync_dt = p_dt * sync_ratio;
-			sample -= poly_blep(sync_phase, sync_dt);
+			if ((sync_phase < sync_dt && sync_cycle >= 1.0) || (sync_phase > 1.0 - sync_dt && sync_cycle + 1.0 < sync_ratio)) {
+				sample -= poly_blep(sync_phase, sync_dt);
+			}
+
+			// The master wrap cuts the slave ramp wherever it is.
+			double end_phase = sync_ratio - std::ceil(sync_ratio) + 1.0;
+			sample -= end_phase * poly_blep(t, p_dt);
 		} break;
 
 		case OSC_DIGITAL: {
 			// Quantized waveform (8-bit style). Warp controls bit depth.
-			double s = std::sin((double)p_phase * PHASE_TO_RAD);
+			// Aliasing is part of the character here, so it is left unfiltered.
+			double s = fast_sin_phase(p_phase);
 			double levels = 4.0 + (1.0 - p_warp) * 252.0;
 			sample = std::round(s * levels) / levels;
 		} break;
@@ -267,7 +403,7 @@ double SiOPMChannelMonolith::_generate_osc_sample(uint32_t p_phase, int p_shape,
 		} break;
 
 		default:
-			sample = std::sin((double)p_phase * PHASE_TO_RAD);
+			sample = fast_sin_phase(p_phase);
 			break;
 	}
 
@@ -280,7 +416,7 @@ double SiOPMChannelMonolith::_generate_osc_sample(uint32_t p_phase, int p_shape,
 
 double SiOPMChannelMonolith::_wavefold(double p_sample, double p_amount) {
 	double x = p_sample * (1.0 + p_amount * 4.0);
-	return std::sin(x * HALF_PI);
+	return fast_sin(x * HALF_PI);
 }
 
 // ---------------------------------------------------------------------------
@@ -312,7 +448,7 @@ double SiOPMChannelMonolith::_apply_drive(double p_sample, int p_mode, double p_
 			// Asymmetric soft clip: positive half clips harder.
 			double x = out * drive;
 			if (x > 0.0) {
-				out = 1.0 - std::exp(-x);
+				out = 1.0 - fast_exp(-x);
 			} else {
 				out = fast_tanh(x);
 			}
@@ -323,8 +459,8 @@ double SiOPMChannelMonolith::_apply_drive(double p_sample, int p_mode, double p_
 			double x = out * drive;
 			double x_abs = std::fabs(x);
 			out = (x > 0.0)
-					? (1.0 - std::exp(-x_abs)) * 1.05
-					: -(1.0 - std::exp(-x_abs * 0.9));
+					? (1.0 - fast_exp(-x_abs)) * 1.05
+					: -(1.0 - fast_exp(-x_abs * 0.9));
 		} break;
 
 		case DRIVE_DIGITAL: {
@@ -342,6 +478,41 @@ double SiOPMChannelMonolith::_apply_drive(double p_sample, int p_mode, double p_
 	return out;
 }
 
+double SiOPMChannelMonolith::_apply_drive_oversampled(double p_sample, int p_mode, double p_amount) {
+	// Upsample by linear interpolation, run the shaper at both points, then
+	// decimate with the halfband. Bass content sits far below the interpolation
+	// rolloff, and the shaper's harmonics up to 1.5x Nyquist are now rejected
+	// instead of folding back.
+	const double midpoint = 0.5 * (_drive_os_prev_input + p_sample);
+	_drive_os_prev_input = p_sample;
+
+	for (int i = DRIVE_OS_ODD_TAPS - 1; i > 0; i--) {
+		_drive_os_odd[i] = _drive_os_odd[i - 1];
+	}
+	_drive_os_odd[0] = _apply_drive(midpoint, p_mode, p_amount);
+
+	for (int i = DRIVE_OS_EVEN_TAPS - 1; i > 0; i--) {
+		_drive_os_even[i] = _drive_os_even[i - 1];
+	}
+	_drive_os_even[0] = _apply_drive(p_sample, p_mode, p_amount);
+
+	// Centered on _drive_os_even[3]; the odd taps straddle it symmetrically.
+	return 0.5 * _drive_os_even[3]
+			+ HALFBAND_TAP1 * (_drive_os_odd[2] + _drive_os_odd[3])
+			+ HALFBAND_TAP3 * (_drive_os_odd[1] + _drive_os_odd[4])
+			+ HALFBAND_TAP5 * (_drive_os_odd[0] + _drive_os_odd[5]);
+}
+
+void SiOPMChannelMonolith::_reset_drive_oversampler() {
+	_drive_os_prev_input = 0.0;
+	for (int i = 0; i < DRIVE_OS_ODD_TAPS; i++) {
+		_drive_os_odd[i] = 0.0;
+	}
+	for (int i = 0; i < DRIVE_OS_EVEN_TAPS; i++) {
+		_drive_os_even[i] = 0.0;
+	}
+}
+
 // ---------------------------------------------------------------------------
 // Amplitude envelope
 // ---------------------------------------------------------------------------
@@ -773,7 +944,7 @@ void SiOPMChannelMonolith::note_off() {
 
 void SiOPMChannelMonolith::reset_channel_buffer_status() {
 	SiOPMChannelBase::reset_channel_buffer_status();
-	_is_idling = !_is_note_on && _amp_stage == AMP_STAGE_IDLE && _declick_level <= 0.0;
+	_is_idling = _is_decayed || (!_is_note_on && _amp_stage == AMP_STAGE_IDLE && _declick_level <= 0.0);
 }
 
 // ---------------------------------------------------------------------------
@@ -797,6 +968,8 @@ void SiOPMChannelMonolith::_process_monolith(int p_length) {
 	double width_n = (double)_width / 127.0;
 
 	const double gain = _expression * PIPE_PEAK;
+	// Bit-crushing is meant to alias, and at high rates the shaper's harmonics already fit.
+	const bool drive_oversampled = _drive_oversampling && _drive_mode != DRIVE_DIGITAL && _sample_rate < DRIVE_OVERSAMPLING_MAX_RATE;
 
 	for (int i = 0; i < p_length; i++) {
 		// Declick ramp (secondary safety on top of amp envelope).
@@ -816,7 +989,7 @@ void SiOPMChannelMonolith::_process_monolith(int p_length) {
 		_motion_phase += _motion_phase_inc;
 		double motion_mod = 0.0;
 		if (_motion_target_param != MOTION_OFF && motion_n > 0.001) {
-			motion_mod = std::sin((double)_motion_phase * PHASE_TO_RAD) * motion_n;
+			motion_mod = fast_sin_phase(_motion_phase) * motion_n;
 		}
 
 		// Mass drift: slow bipolar movement source for the main layer (never the
@@ -825,7 +998,7 @@ void SiOPMChannelMonolith::_process_monolith(int p_length) {
 		if (_mass_drift_phase >= 1.0) {
 			_mass_drift_phase -= 1.0;
 		}
-		_mass_drift_value = std::sin(_mass_drift_phase * TWO_PI) * _mass_drift_depth;
+		_mass_drift_value = fast_sin_phase((uint32_t)(_mass_drift_phase * 4294967296.0)) * _mass_drift_depth;
 
 		// Update phase increments (glide + pitch-drop + mass drift happen here).
 		_update_phase_increments(motion_mod);
@@ -914,7 +1087,8 @@ void SiOPMChannelMonolith::_process_monolith(int p_length) {
 
 		if (grind_n > 0.001) {
 			double drive_input = (main_mix + sub_dirty) * _drive_input_trim * _mass_drive_compensation;
-			main_mix = _apply_drive(drive_input, _drive_mode, grind_n) * _drive_output_makeup;
+			double driven = drive_oversampled ? _apply_drive_oversampled(drive_input, _drive_mode, grind_n) : _apply_drive(drive_input, _drive_mode, grind_n);
+			main_mix = driven * _drive_output_makeup;
 		} else {
 			main_mix = main_mix + sub_dirty;
 		}
@@ -926,7 +1100,7 @@ void SiOPMChannelMonolith::_process_monolith(int p_length) {
 		if ((_motion_target_param == MOTION_FILTER || _motion_target_param == MOTION_RESONANCE) && motion_n > 0.001) {
 			double fc, q;
 			if (_motion_target_param == MOTION_FILTER) {
-				fc = MOTION_FILTER_BASE_HZ * std::pow(2.0, motion_mod * MOTION_FILTER_OCT);
+				fc = MOTION_FILTER_BASE_HZ * fast_exp2(motion_mod * MOTION_FILTER_OCT);
 				q = 1.0;
 			} else {
 				fc = MOTION_RES_BASE_HZ;
@@ -1040,6 +1214,10 @@ void SiOPMChannelMonolith::initialize(SiOPMChannelBase *p_prev, int p_buffer_ind
 	_osc2_phase_inc = 0;
 	_osc1_dt = 0.0;
 	_osc2_dt = 0.0;
+	_sub_dt = 0.0;
+	_sub_pitch_cache = PitchCache();
+	_osc1_pitch_cache = PitchCache();
+	_osc2_pitch_cache = PitchCache();
 	_pitch_env_level = 0.0;
 	_motion_phase = 0;
 	_motion_phase_inc = 0;
@@ -1070,6 +1248,7 @@ void SiOPMChannelMonolith::initialize(SiOPMChannelBase *p_prev, int p_buffer_ind
 	_motion_filter_ic2 = 0.0;
 	_drive_tone_lp_z1 = 0.0;
 	_drive_tone_lp_coeff = 1.0 - std::exp(-TWO_PI * 700.0 / _sample_rate);
+	_reset_drive_oversampler();
 
 	_main_level = 0.7;
 	_drive_input_trim = 1.0;
@@ -1101,6 +1280,7 @@ void SiOPMChannelMonolith::reset() {
 	_motion_filter_ic1 = 0.0;
 	_motion_filter_ic2 = 0.0;
 	_drive_tone_lp_z1 = 0.0;
+	_reset_drive_oversampler();
 
 	_lens_lp_z1 = 0.0;
 	_lens_harm_hp_z1 = 0.0;
@@ -1131,6 +1311,9 @@ String SiOPMChannelMonolith::_to_string() const {
 
 void SiOPMChannelMonolith::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_process_monolith", "length"), &SiOPMChannelMonolith::_process_monolith);
+
+	ClassDB::bind_method(D_METHOD("is_drive_oversampling"), &SiOPMChannelMonolith::is_drive_oversampling);
+	ClassDB::bind_method(D_METHOD("set_drive_oversampling", "enabled"), &SiOPMChannelMonolith::set_drive_oversampling);
 }
 
 SiOPMChannelMonolith::SiOPMChannelMonolith(SiOPMSoundChip *p_chip) :
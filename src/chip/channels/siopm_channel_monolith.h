@@ -108,6 +108,16 @@ private:
 	// Normalized frequency for polyBLEP (phase_inc * PHASE_TO_NORM).
 	double _osc1_dt = 0.0;
 	double _osc2_dt = 0.0;
+	double _sub_dt = 0.0;
+
+	// Last pitch -> phase increment conversion per oscillator.
+	struct PitchCache {
+		double pitch = -1.0;
+		uint32_t phase_inc = 0;
+	};
+	PitchCache _sub_pitch_cache;
+	PitchCache _osc1_pitch_cache;
+	PitchCache _osc2_pitch_cache;
 
 	// Pitch-drop envelope.
 	double _pitch_env_level = 0.0;
@@ -180,6 +190,14 @@ private:
 	double _lens_lp_coeff = 0.0;
 	double _lens_harm_hp_coeff = 0.0;
 
+	// 2x oversampled drive: linear-interpolated upsampling, halfband decimation.
+	static constexpr int DRIVE_OS_ODD_TAPS = 6;
+	static constexpr int DRIVE_OS_EVEN_TAPS = 4;
+	bool _drive_oversampling = true;
+	double _drive_os_prev_input = 0.0;
+	double _drive_os_odd[DRIVE_OS_ODD_TAPS] = {};
+	double _drive_os_even[DRIVE_OS_EVEN_TAPS] = {};
+
 	// Cached sample rate.
 	double _sample_rate = 44100.0;
 
@@ -188,10 +206,13 @@ private:
 	double _generate_sub_sample();
 	double _generate_osc_sample(uint32_t p_phase, int p_shape, double p_warp, double p_dt);
 	double _apply_drive(double p_sample, int p_mode, double p_amount);
+	double _apply_drive_oversampled(double p_sample, int p_mode, double p_amount);
+	void _reset_drive_oversampler();
 	double _wavefold(double p_sample, double p_amount);
 	double _generate_noise();
 
 	uint32_t _pitch_to_phase_inc(double p_pitch_units);
+	uint32_t _cached_pitch_to_phase_inc(double p_pitch_units, PitchCache &r_cache);
 	uint32_t _freq_to_phase_inc(double p_freq);
 
 	// Amplitude envelope helpers.
@@ -240,6 +261,9 @@ public:
 	int get_monolith_lens() const { return _lens; }
 	int get_monolith_glide() const { return _glide_time; }
 
+	bool is_drive_oversampling() const { return _drive_oversampling; }
+	void set_drive_oversampling(bool p_enabled) { _drive_oversampling = p_enabled; }
+
 	virtual int get_pitch() const override { return _current_pitch; }
 	virtual void set_pitch(int p_value) override;
 
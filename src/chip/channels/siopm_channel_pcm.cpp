@@ -153,6 +153,11 @@ void SiOPMChannelPCM::set_wave_data(const Ref<SiOPMWaveBase> &p_wave_data) {
 	_operator->set_pcm_data(pcm_data);
 }
 
+void SiOPMChannelPCM::set_ref_stencil(const SiOPMRefStencil *p_stencil) {
+	SiOPMChannelBase::set_ref_stencil(p_stencil);
+	_operator->set_ref_stencil(p_stencil);
+}
+
 void SiOPMChannelPCM::set_parameters(Vector<int> p_params) {
 	set_params_by_value(
 			p_params[1],  p_params[2],  p_params[3],  p_params[4],  p_params[5],
@@ -162,7 +167,7 @@ void SiOPMChannelPCM::set_parameters(Vector<int> p_params) {
 }
 
 void SiOPMChannelPCM::set_types(int p_pg_type, SiONPitchTableType p_pt_type) {
-	Ref<SiOPMWavePCMTable> pcm_table = _table->get_pcm_data(p_pg_type);
+	Ref<SiOPMWavePCMTable> pcm_table = _table->get_pcm_data(p_pg_type, _ref_stencil);
 	if (pcm_table.is_valid()) {
 		set_wave_data(pcm_table);
 	} else {
@@ -555,6 +560,9 @@ void SiOPMChannelPCM::note_off() {
 void SiOPMChannelPCM::reset_channel_buffer_status() {
 	_buffer_index = 0;
 	_is_idling = (_operator->get_eg_output() > IDLING_THRESHOLD && _operator->get_eg_state() != SiOPMOperator::EG_ATTACK);
+	if (_update_idle_detector()) {
+		_is_idling = true;
+	}
 }
 
 void SiOPMChannelPCM::buffer(int p_length) {
@@ -572,6 +580,7 @@ void SiOPMChannelPCM::buffer(int p_length) {
 		if (_filter_on) {
 			_apply_sv_filter(mono_out, p_length, _filter_variables);
 		}
+		_report_idle_peak(mono_out, p_length);
 
 		if (!_mute) {
 			_write_stream_mono(mono_out, p_length);
@@ -588,6 +597,7 @@ void SiOPMChannelPCM::buffer(int p_length) {
 			_apply_sv_filter(left_out, p_length, _filter_variables);
 			_apply_sv_filter(right_out, p_length, _filter_variables2);
 		}
+		_report_idle_peak_stereo(left_out, right_out, p_length);
 
 		if (!_mute) {
 			_write_stream_stereo(left_out, right_out, p_length);
@@ -623,6 +633,7 @@ void SiOPMChannelPCM::reset() {
 	_operator->reset();
 	_is_note_on = false;
 	_is_idling = true;
+	_reset_idle_detector();
 }
 
 String SiOPMChannelPCM::_to_string() const {
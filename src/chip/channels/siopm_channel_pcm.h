@@ -64,6 +64,7 @@ public:
 	void set_params_by_value(int p_ar, int p_dr, int p_sr, int p_rr, int p_sl, int p_tl, int p_ksr, int p_ksl, int p_mul, int p_dt1, int p_dt2, int p_ams, int p_phase, int p_fix_note);
 
 	virtual void set_wave_data(const Ref<SiOPMWaveBase> &p_wave_data) override;
+	virtual void set_ref_stencil(const SiOPMRefStencil *p_stencil) override;
 
 	virtual void set_parameters(Vector<int> p_params) override;
 	virtual void set_types(int p_pg_type, SiONPitchTableType p_pt_type) override;
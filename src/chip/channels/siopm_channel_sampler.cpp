@@ -23,6 +23,10 @@ static _FORCE_INLINE_ double _am_gain_from_log_delta(int p_delta) {
 	return std::pow(2.0, -(double)p_delta / 512.0);
 }
 
+static _FORCE_INLINE_ double _pm_factor_from_level(int p_level) {
+	return std::pow(2.0, p_level / (64.0 * 12.0));
+}
+
 static _FORCE_INLINE_ double _get_sampler_boundary_gain(double p_sample_index, int p_start_point, int p_end_point, int p_fade_samples) {
 	if (p_fade_samples <= 0 || p_end_point <= p_start_point) {
 		return 1.0;
@@ -91,6 +95,7 @@ void SiOPMChannelSampler::get_channel_params(const Ref<SiOPMChannelParams> &p_pa
 	}
 	p_params->set_instrument_gain_db(get_instrument_gain_db());
 	p_params->set_pan(_pan);
+	p_params->set_audio_rate_modulation(_audio_rate_modulation);
 }
 
 void SiOPMChannelSampler::set_channel_params(const Ref<SiOPMChannelParams> &p_params, bool p_with_volume, bool p_with_modulation) {
@@ -117,6 +122,7 @@ void SiOPMChannelSampler::set_channel_params(const Ref<SiOPMChannelParams> &p_pa
 
 		set_amplitude_modulation(p_params->get_amplitude_modulation_depth());
 		set_pitch_modulation(p_params->get_pitch_modulation_depth());
+		set_audio_rate_modulation(p_params->is_audio_rate_modulation());
 	}
 
 	if (p_with_volume) {
@@ -171,7 +177,7 @@ Ref<SiOPMWaveSamplerData> SiOPMChannelSampler::resolve_sampler_data_for_note(int
 	if (p_note < 0 || p_note >= SiOPMRefTable::SAMPLER_DATA_MAX) {
 		return Ref<SiOPMWaveSamplerData>();
 	}
-	return _sampler_table->get_sample(p_note);
+	return _sampler_table->get_sample(p_note, _table->get_sampler_table_stencil(_sampler_table, _ref_stencil));
 }
 
 void SiOPMChannelSampler::set_types(int p_pg_type, SiONPitchTableType p_pt_type) {
@@ -219,6 +225,7 @@ void SiOPMChannelSampler::initialize_lfo(int p_waveform, Vector<int> p_custom_wa
 	_amplitude_modulation_output_level = 0;
 	_pitch_modulation_output_level = 0;
 	_amplitude_modulation_gain = 1.0;
+	_pitch_modulation_factor = 1.0;
 }
 
 void SiOPMChannelSampler::set_amplitude_modulation(int p_depth) {
@@ -233,6 +240,7 @@ void SiOPMChannelSampler::set_amplitude_modulation(int p_depth) {
 void SiOPMChannelSampler::set_pitch_modulation(int p_depth) {
 	_pitch_modulation_depth = p_depth;
 	_pitch_modulation_output_level = (((_lfo_wave_table[_lfo_phase] << 1) - 255) * _pitch_modulation_depth) >> 8;
+	_pitch_modulation_factor = _pm_factor_from_level(_pitch_modulation_output_level);
 
 	_set_lfo_state(_pitch_modulation_depth != 0 || _amplitude_modulation_depth != 0);
 }
@@ -258,14 +266,35 @@ void SiOPMChannelSampler::_update_lfo() {
 	}
 
 	_lfo_phase = (_lfo_phase + 1) & 255;
+	_lfo_timer += _lfo_timer_initial;
+	_update_lfo_output();
+}
+
+void SiOPMChannelSampler::_update_lfo_block(int p_length) {
+	if (_lfo_on == 0) {
+		return;
+	}
+	_lfo_timer -= _lfo_timer_step * p_length;
+	if (_lfo_timer >= 0) {
+		return;
+	}
 
+	// Same number of steps as p_length calls to _update_lfo(), at most one per sample.
+	for (int i = 0; i < p_length && _lfo_timer < 0; i++) {
+		_lfo_phase = (_lfo_phase + 1) & 255;
+		_lfo_timer += _lfo_timer_initial;
+	}
+	_update_lfo_output();
+}
+
+void SiOPMChannelSampler::_update_lfo_output() {
 	int value_base = _lfo_wave_table[_lfo_phase];
 	_amplitude_modulation_output_level = (value_base * _amplitude_modulation_depth) >> 7 << 3;
 	_pitch_modulation_output_level = (((value_base << 1) - 255) * _pitch_modulation_depth) >> 8;
 
-	_lfo_timer += _lfo_timer_initial;
-	// Update cached linear AM gain from log delta.
+	// Update cached linear AM gain and PM rate from the new levels.
 	_amplitude_modulation_gain = _am_gain_from_log_delta(_amplitude_modulation_output_level);
+	_pitch_modulation_factor = _pm_factor_from_level(_pitch_modulation_output_level);
 }
 
 // Processing.
@@ -304,7 +333,7 @@ void SiOPMChannelSampler::_execute_note_on_immediate() {
 	_reset_amp_envelope();
 
 	if (_sampler_table.is_valid()) {
-		_sample_data = _sampler_table->get_sample(_wave_number & 127);
+		_sample_data = _sampler_table->get_sample(_wave_number & 127, _table->get_sampler_table_stencil(_sampler_table, _ref_stencil));
 	}
 	if (_sample_data.is_valid() && _sample_start_phase != 255) {
 		_sample_index = _sample_data->get_initial_sample_index(_sample_start_phase * 0.00390625); // 1/256
@@ -361,6 +390,8 @@ void SiOPMChannelSampler::buffer(int p_length) {
 	int boundary_fade_samples = playback_window.boundary_fade_samples;
 	double sample_gain = _sample_data->get_gain_linear();
 	const double live_tuning_ratio = _get_live_sample_tuning_ratio();
+	// Nearest-sample reads when the driver has lowered the render quality.
+	const bool interpolate = _sound_chip->is_sampler_interpolation();
 
 	// Preserve the start of output pipes.
 	SinglyLinkedList<int>::Element *left_start = _out_pipe->get();
@@ -375,6 +406,12 @@ void SiOPMChannelSampler::buffer(int p_length) {
 		right_write = right_start;
 	}
 
+	// At control rate the LFO is stepped once per block and the AM gain ramps across it.
+	const int control_block_size = _get_control_block_size();
+	int control_samples_left = 0;
+	double am_gain = _amplitude_modulation_gain;
+	double am_gain_step = 0.0;
+
 	// Generate into integer pipes.
 	for (int i = 0; i < p_length; i++) {
 		// End/loop handling.
@@ -400,7 +437,19 @@ void SiOPMChannelSampler::buffer(int p_length) {
 		}
 
 		// LFO and ADSR updates.
-		_update_lfo();
+		if (control_block_size > 0) {
+			if (control_samples_left == 0) {
+				control_samples_left = MIN(control_block_size, p_length - i);
+				am_gain = _amplitude_modulation_gain;
+				_update_lfo_block(control_samples_left);
+				am_gain_step = (_amplitude_modulation_gain - am_gain) / control_samples_left;
+			}
+			control_samples_left--;
+			am_gain += am_gain_step;
+		} else {
+			_update_lfo();
+			am_gain = _amplitude_modulation_gain;
+		}
 		_update_amp_envelope();
 		if (_amp_stage == AMP_STAGE_IDLE) {
 			if (!_click_guard_active) {
@@ -429,21 +478,23 @@ void SiOPMChannelSampler::buffer(int p_length) {
 		double frac = _sample_index_fp - base_index;
 
 		// Gather samples and interpolate.
-		double sL1 = wave_data[(base_index * channels) + 0];
-		double sL2 = (base_index + 1 < end_point) ? wave_data[((base_index + 1) * channels) + 0] : sL1;
-		double sampleL = sL1 + (sL2 - sL1) * frac;
-		double sampleR = sampleL;
-		if (channels == 2) {
-			double sR1 = wave_data[(base_index * channels) + 1];
-			double sR2 = (base_index + 1 < end_point) ? wave_data[((base_index + 1) * channels) + 1] : sR1;
-			sampleR = sR1 + (sR2 - sR1) * frac;
+		double sampleL = wave_data[(base_index * channels) + 0];
+		double sampleR = (channels == 2) ? wave_data[(base_index * channels) + 1] : sampleL;
+		if (interpolate) {
+			double sL2 = (base_index + 1 < end_point) ? wave_data[((base_index + 1) * channels) + 0] : sampleL;
+			double sR2 = sL2;
+			if (channels == 2) {
+				sR2 = (base_index + 1 < end_point) ? wave_data[((base_index + 1) * channels) + 1] : sampleR;
+			}
+			sampleL += (sL2 - sampleL) * frac;
+			sampleR = (channels == 2) ? sampleR + (sR2 - sampleR) * frac : sampleL;
 		}
 
 		// Apply channel ADSR + AM depth.
 		double env = _envelope_level;
 		double boundary_gain = _get_sampler_boundary_gain(_sample_index_fp, start_point, end_point, boundary_fade_samples);
-		double outL = sampleL * env * _amplitude_modulation_gain * sample_gain * boundary_gain;
-		double outR = sampleR * env * _amplitude_modulation_gain * sample_gain * boundary_gain;
+		double outL = sampleL * env * am_gain * sample_gain * boundary_gain;
+		double outR = sampleR * env * am_gain * sample_gain * boundary_gain;
 
 		// Convert to engine int domain and write.
 		int vL = CLAMP((int)(outL * 8192.0), -8192, 8191);
@@ -456,9 +507,7 @@ void SiOPMChannelSampler::buffer(int p_length) {
 		}
 
 		// Advance sample position with pitch modulation (vibrato).
-		double pm_semitones = _pitch_modulation_output_level * (1.0 / 64.0);
-		double pitch_factor = std::pow(2.0, pm_semitones / 12.0);
-		double step = (_pitch_step * live_tuning_ratio) * pitch_factor;
+		double step = (_pitch_step * live_tuning_ratio) * _pitch_modulation_factor;
 		_sample_index_fp += step;
 	}
 
@@ -469,6 +518,11 @@ void SiOPMChannelSampler::buffer(int p_length) {
 			_apply_sv_filter(right_start, p_length, _filter_variables2);
 		}
 	}
+	if (channels == 2 && right_start) {
+		_report_idle_peak_stereo(left_start, right_start, p_length);
+	} else {
+		_report_idle_peak(left_start, p_length);
+	}
 
 	// Write to streams.
 	if (!_mute) {
@@ -554,6 +608,7 @@ void SiOPMChannelSampler::initialize(SiOPMChannelBase *p_prev, int p_buffer_inde
 void SiOPMChannelSampler::reset() {
 	_is_note_on = false;
 	_is_idling = true;
+	_reset_idle_detector();
 
 	_bank_number = 0;
 	_wave_number = -1;
@@ -77,6 +77,8 @@ class SiOPMChannelSampler : public SiOPMChannelBase {
 	int _lfo_timer_initial = 0; // LFO_TIMER_INITIAL * freq_ratio
 	// AM linear gain derived from log domain (parity with FM).
 	double _amplitude_modulation_gain = 1.0;
+	// Playback rate multiplier derived from the PM output level, refreshed with it.
+	double _pitch_modulation_factor = 1.0;
 
 	// Second output pipe and filter variables for stereo processing.
 	SinglyLinkedList<int> *_out_pipe2 = nullptr;
@@ -86,6 +88,8 @@ class SiOPMChannelSampler : public SiOPMChannelBase {
 	void _set_lfo_state(bool p_enabled);
 	void _set_lfo_timer(int p_value);
 	void _update_lfo();
+	void _update_lfo_block(int p_length);
+	void _update_lfo_output();
 
 	// Amplitude envelope helpers.
 	void _reset_amp_envelope();
@@ -9,18 +9,34 @@
 #include "chip/siopm_stream.h"
 #include "templates/singly_linked_list.h"
 
+// Halfband FIR for the 2x render (6-point Lagrange design, 11 taps).
+// Only the odd taps are non-zero; the center tap is 0.5.
+static constexpr double HALFBAND_TAP1 = 150.0 / 512.0;
+static constexpr double HALFBAND_TAP3 = -25.0 / 512.0;
+static constexpr double HALFBAND_TAP5 = 3.0 / 512.0;
+
 void SiOPMChannelStrata::_recompute_pitch_correction(double p_sample_rate) {
 	if (p_sample_rate <= 0) {
 		_pitch_correction = 0;
 		return;
 	}
 	// Braids assumes 96 kHz internally. To make a given MIDI note number sound
-	// the same at our host rate, raise the pitch fed to Braids by
-	//   log2(REFERENCE_SAMPLE_RATE / host_sr) * 12 semitones * 128 units/semi.
-	double semitones = std::log2(REFERENCE_SAMPLE_RATE / p_sample_rate) * 12.0;
+	// the same at our render rate, raise the pitch fed to Braids by
+	//   log2(REFERENCE_SAMPLE_RATE / render_sr) * 12 semitones * 128 units/semi.
+	double render_rate = _oversampling ? p_sample_rate * OVERSAMPLING_FACTOR : p_sample_rate;
+	double semitones = std::log2(REFERENCE_SAMPLE_RATE / render_rate) * 12.0;
 	_pitch_correction = (int)std::round(semitones * 128.0);
 }
 
+void SiOPMChannelStrata::set_strata_oversampling(bool p_enabled) {
+	if (_oversampling == p_enabled) {
+		return;
+	}
+	_oversampling = p_enabled;
+	_recompute_pitch_correction(_sample_rate);
+	_reset_render_state();
+}
+
 void SiOPMChannelStrata::_set_strata_pitch() {
 	// SiON pitch is 64 units / semitone -> Braids is 128 units / semitone.
 	int braids_pitch = (_current_pitch << 1) + _pitch_correction;
@@ -137,6 +153,10 @@ void SiOPMChannelStrata::offset_volume(int p_expression, int p_velocity) {
 }
 
 void SiOPMChannelStrata::note_on() {
+	if (_declick_level <= 0.0) {
+		// Nothing audible is left, so drop the carried-over tail and start on time.
+		_block_read = BRAIDS_BLOCK_SIZE;
+	}
 	_osc.Strike();
 	_is_note_on = true;
 	_is_idling = false;
@@ -152,7 +172,100 @@ void SiOPMChannelStrata::note_off() {
 
 void SiOPMChannelStrata::reset_channel_buffer_status() {
 	SiOPMChannelBase::reset_channel_buffer_status();
-	_is_idling = !_is_note_on && _declick_level <= 0.0;
+	_is_idling = _is_decayed || (!_is_note_on && _declick_level <= 0.0);
+}
+
+void SiOPMChannelStrata::_render_braids(int16_t *r_buffer, int p_count) {
+	int written = 0;
+	while (written < p_count) {
+		if (_block_read >= BRAIDS_BLOCK_SIZE) {
+			// Whole blocks go straight to the output. Always rendering full blocks
+			// keeps parameter interpolation on Braids' own grid and avoids the odd
+			// sizes its drum shapes cannot handle.
+			if (p_count - written >= BRAIDS_BLOCK_SIZE) {
+				_osc.Render(_sync_buffer, r_buffer + written, BRAIDS_BLOCK_SIZE);
+				written += BRAIDS_BLOCK_SIZE;
+				continue;
+			}
+
+			_osc.Render(_sync_buffer, _block_buffer, BRAIDS_BLOCK_SIZE);
+			_block_read = 0;
+		}
+
+		const int count = MIN(BRAIDS_BLOCK_SIZE - _block_read, p_count - written);
+		memcpy(r_buffer + written, _block_buffer + _block_read, sizeof(int16_t) * count);
+		_block_read += count;
+		written += count;
+	}
+}
+
+void SiOPMChannelStrata::_render_span(int p_length) {
+	if (!_oversampling) {
+		_render_braids(_render_buffer, p_length);
+		for (int i = 0; i < p_length; i++) {
+			_span_buffer[i] = (double)_render_buffer[i];
+		}
+		return;
+	}
+
+	_render_braids(_render_buffer, p_length * OVERSAMPLING_FACTOR);
+
+	double *even = _decimator_even + DECIMATOR_EVEN_HISTORY;
+	double *odd = _decimator_odd + DECIMATOR_ODD_HISTORY;
+	for (int i = 0; i < p_length; i++) {
+		even[i] = (double)_render_buffer[i * 2];
+		odd[i] = (double)_render_buffer[i * 2 + 1];
+	}
+
+	// Each output is centered on an even sample two host samples back; the odd
+	// lane provides the symmetric taps around it.
+	for (int i = 0; i < p_length; i++) {
+		_span_buffer[i] = 0.5 * _decimator_even[i]
+				+ HALFBAND_TAP1 * (_decimator_odd[i + 2] + _decimator_odd[i + 3])
+				+ HALFBAND_TAP3 * (_decimator_odd[i + 1] + _decimator_odd[i + 4])
+				+ HALFBAND_TAP5 * (_decimator_odd[i] + _decimator_odd[i + 5]);
+	}
+
+	memmove(_decimator_even, _decimator_even + p_length, sizeof(double) * DECIMATOR_EVEN_HISTORY);
+	memmove(_decimator_odd, _decimator_odd + p_length, sizeof(double) * DECIMATOR_ODD_HISTORY);
+}
+
+void SiOPMChannelStrata::_apply_gain_and_declick(int p_length) {
+	// Braids int16 peak = 32768, SiON pipe peak = 1 << LOG_VOLUME_BITS = 8192.
+	// Scale factor = 8192/32768 = 0.25, combined with per-note expression.
+	const double gain = _expression * 0.25;
+	const double start_level = _declick_level;
+	const double target_level = _declick_target;
+
+	// The declick ramp is linear, so each sample's level is a closed form of its
+	// index and the loops carry no state from one sample to the next.
+	if (start_level < target_level) {
+		for (int i = 0; i < p_length; i++) {
+			const double level = MIN(start_level + DECLICK_INCREMENT * (i + 1), target_level);
+			_span_output[i] = (int)(_span_buffer[i] * gain * level);
+		}
+		_declick_level = MIN(start_level + DECLICK_INCREMENT * p_length, target_level);
+	} else if (start_level > target_level) {
+		for (int i = 0; i < p_length; i++) {
+			const double level = MAX(start_level - DECLICK_INCREMENT * (i + 1), target_level);
+			_span_output[i] = (int)(_span_buffer[i] * gain * level);
+		}
+		_declick_level = MAX(start_level - DECLICK_INCREMENT * p_length, target_level);
+		if (_declick_level <= 0.0) {
+			_is_idling = true;
+		}
+	} else {
+		const double level_gain = gain * start_level;
+		for (int i = 0; i < p_length; i++) {
+			_span_output[i] = (int)(_span_buffer[i] * level_gain);
+		}
+	}
+}
+
+void SiOPMChannelStrata::_reset_render_state() {
+	_block_read = BRAIDS_BLOCK_SIZE;
+	memset(_decimator_even, 0, sizeof(_decimator_even));
+	memset(_decimator_odd, 0, sizeof(_decimator_odd));
 }
 
 void SiOPMChannelStrata::_process_strata(int p_length) {
@@ -164,41 +277,21 @@ void SiOPMChannelStrata::_process_strata(int p_length) {
 	_osc.set_shape((braids::MacroOscillatorShape)_shape);
 	_osc.set_parameters((int16_t)_timbre, (int16_t)_color);
 
-	// Braids int16 peak = 32768, SiON pipe peak = 1 << LOG_VOLUME_BITS = 8192.
-	// Scale factor = 8192/32768 = 0.25, combined with per-note expression.
-	const double gain = _expression * 0.25;
-
 	int written = 0;
 	while (written < p_length) {
-		int chunk = p_length - written;
-		if (chunk > BRAIDS_BLOCK_SIZE) {
-			chunk = BRAIDS_BLOCK_SIZE;
-		}
-		// Braids drum shapes decrement size by 2 per iteration; an odd size
-		// causes unsigned underflow in size_t. Round up to the next even number
-		// for Render, but only read `chunk` samples from the output.
-		int render_size = (chunk + 1) & ~1;
-		memset(_sync_buffer, 0, sizeof(_sync_buffer));
-		_osc.Render(_sync_buffer, _render_buffer, (size_t)render_size);
-
-		for (int i = 0; i < chunk; i++) {
-			if (_declick_level < _declick_target) {
-				_declick_level = MIN(_declick_level + DECLICK_INCREMENT, _declick_target);
-			} else if (_declick_level > _declick_target) {
-				_declick_level = MAX(_declick_level - DECLICK_INCREMENT, 0.0);
-				if (_declick_level <= 0.0) {
-					_is_idling = true;
-				}
-			}
+		const int span = MIN(p_length - written, SPAN_SIZE);
 
-			int sample = (int)((double)_render_buffer[i] * gain * _declick_level);
-			out_pipe->value = sample + base_pipe->value;
+		_render_span(span);
+		_apply_gain_and_declick(span);
+
+		for (int i = 0; i < span; i++) {
+			out_pipe->value = _span_output[i] + base_pipe->value;
 
 			in_pipe   = in_pipe->next();
 			base_pipe = base_pipe->next();
 			out_pipe  = out_pipe->next();
 		}
-		written += chunk;
+		written += span;
 	}
 
 	_in_pipe->set(in_pipe);
@@ -209,8 +302,8 @@ void SiOPMChannelStrata::_process_strata(int p_length) {
 void SiOPMChannelStrata::initialize(SiOPMChannelBase *p_prev, int p_buffer_index) {
 	SiOPMChannelBase::initialize(p_prev, p_buffer_index);
 
-	double sample_rate = _table ? (double)_table->sampling_rate : REFERENCE_SAMPLE_RATE;
-	_recompute_pitch_correction(sample_rate);
+	_sample_rate = _table ? (double)_table->sampling_rate : REFERENCE_SAMPLE_RATE;
+	_recompute_pitch_correction(_sample_rate);
 
 	_shape = (int)braids::MACRO_OSC_SHAPE_CSAW;
 	_timbre = 0;
@@ -223,6 +316,7 @@ void SiOPMChannelStrata::initialize(SiOPMChannelBase *p_prev, int p_buffer_index
 	_osc.Init();
 	_osc.set_shape((braids::MacroOscillatorShape)_shape);
 	_osc.set_parameters((int16_t)_timbre, (int16_t)_color);
+	_reset_render_state();
 
 	_process_function = Callable(this, "_process_strata");
 }
@@ -233,6 +327,7 @@ void SiOPMChannelStrata::reset() {
 	_osc.set_parameters((int16_t)_timbre, (int16_t)_color);
 	_declick_level = 0.0;
 	_declick_target = 0.0;
+	_reset_render_state();
 
 	SiOPMChannelBase::reset();
 }
@@ -250,6 +345,9 @@ String SiOPMChannelStrata::_to_string() const {
 
 void SiOPMChannelStrata::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_process_strata", "length"), &SiOPMChannelStrata::_process_strata);
+
+	ClassDB::bind_method(D_METHOD("is_strata_oversampling"), &SiOPMChannelStrata::is_strata_oversampling);
+	ClassDB::bind_method(D_METHOD("set_strata_oversampling", "enabled"), &SiOPMChannelStrata::set_strata_oversampling);
 }
 
 SiOPMChannelStrata::SiOPMChannelStrata(SiOPMSoundChip *p_chip) : SiOPMChannelBase(p_chip) {
@@ -16,14 +16,22 @@ class SiOPMSoundChip;
 // stream routing for free — matching the path used by FM and PCM channels.
 //
 // Braids' DSP runs at a hardcoded 96 kHz internal sample rate and processes
-// 24-sample blocks. We render in 24-sample sub-blocks at the host rate,
-// applying a sample-rate pitch correction so MIDI note numbers translate
-// to the same audible pitch regardless of host rate.
+// 24-sample blocks. We render whole host spans through full 24-sample Braids
+// blocks (carrying leftovers to the next call), applying a sample-rate pitch
+// correction so MIDI note numbers translate to the same audible pitch
+// regardless of host rate. Optionally Braids runs at twice the host rate and
+// is decimated back with a halfband filter, which keeps its shapes closer to
+// the 96 kHz they were designed for.
 class SiOPMChannelStrata : public SiOPMChannelBase {
 	GDCLASS(SiOPMChannelStrata, SiOPMChannelBase)
 
 	static constexpr int BRAIDS_BLOCK_SIZE = 24;
 	static constexpr double REFERENCE_SAMPLE_RATE = 96000.0;
+	// Host samples processed per span; longer buffer() calls are split.
+	static constexpr int SPAN_SIZE = 240;
+	static constexpr int OVERSAMPLING_FACTOR = 2;
+	static constexpr int DECIMATOR_EVEN_HISTORY = 2;
+	static constexpr int DECIMATOR_ODD_HISTORY = 5;
 
 	braids::MacroOscillator _osc;
 
@@ -34,6 +42,8 @@ class SiOPMChannelStrata : public SiOPMChannelBase {
 	int _current_pitch = 0;          // SiON pitch (64 units / semitone).
 	int _pitch_correction = 0;       // Added to braids pitch to compensate for sample rate.
 	double _expression = 1.0;
+	double _sample_rate = REFERENCE_SAMPLE_RATE;
+	bool _oversampling = false;
 
 	// Per-sample linear declick ramp to avoid clicks on note-on/note-off.
 	// _declick_level moves toward _declick_target at DECLICK_INCREMENT per sample.
@@ -42,12 +52,30 @@ class SiOPMChannelStrata : public SiOPMChannelBase {
 	double _declick_level = 0.0;
 	double _declick_target = 0.0;
 
-	int16_t _render_buffer[BRAIDS_BLOCK_SIZE] = {};
+	// Braids only reads the sync buffer and Strata never hard-syncs, so it
+	// stays zeroed for the lifetime of the channel.
 	uint8_t _sync_buffer[BRAIDS_BLOCK_SIZE] = {};
 
+	// Tail of the last Braids block that the previous span did not consume.
+	int16_t _block_buffer[BRAIDS_BLOCK_SIZE] = {};
+	int _block_read = BRAIDS_BLOCK_SIZE;
+
+	int16_t _render_buffer[SPAN_SIZE * OVERSAMPLING_FACTOR] = {};
+	double _span_buffer[SPAN_SIZE] = {};
+	int _span_output[SPAN_SIZE] = {};
+
+	// Halfband decimator lanes (internal even/odd samples) with history in front.
+	double _decimator_even[DECIMATOR_EVEN_HISTORY + SPAN_SIZE] = {};
+	double _decimator_odd[DECIMATOR_ODD_HISTORY + SPAN_SIZE] = {};
+
 	void _recompute_pitch_correction(double p_sample_rate);
 	void _set_strata_pitch();
 
+	void _render_braids(int16_t *r_buffer, int p_count);
+	void _render_span(int p_length);
+	void _apply_gain_and_declick(int p_length);
+	void _reset_render_state();
+
 	// Pipe-based process function called by the base class buffer().
 	// Renders Braids output scaled to the SiON integer pipe domain.
 	void _process_strata(int p_length);
@@ -64,6 +92,9 @@ public:
 	int get_strata_timbre() const { return _timbre; }
 	int get_strata_color() const { return _color; }
 
+	bool is_strata_oversampling() const { return _oversampling; }
+	void set_strata_oversampling(bool p_enabled);
+
 	virtual int get_pitch() const override { return _current_pitch; }
 	virtual void set_pitch(int p_value) override { _current_pitch = p_value; }
 
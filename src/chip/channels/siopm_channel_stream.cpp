@@ -79,6 +79,7 @@ void SiOPMChannelStream::set_channel_params(const Ref<SiOPMChannelParams> &p_par
 // ---------------------------------------------------------------------------
 
 void SiOPMChannelStream::set_wave_data(const Ref<SiOPMWaveBase> &p_wave_data) {
+	_release_preroll();
 	_stream_data = p_wave_data;
 	_recalc_pitch_step();
 }
@@ -130,6 +131,65 @@ bool SiOPMChannelStream::_is_live_stream() const {
 	return _stream_data.is_valid() && _stream_data->is_live_stream();
 }
 
+// ---------------------------------------------------------------------------
+// Source: pre-roll + ring buffer
+// ---------------------------------------------------------------------------
+
+void SiOPMChannelStream::_seek_source(int64_t p_position_sample) {
+	_release_preroll();
+
+	int64_t start = MAX(p_position_sample, (int64_t)0);
+	if (!_is_live_stream()) {
+		// The pre-roll must not run past the point where the loader would wrap or stop.
+		int64_t end = (_out_sample > 0) ? _out_sample : _stream_data->get_total_frames();
+		if (_looping && _loop_end_sample > 0) {
+			end = MIN(end, _loop_end_sample);
+		}
+
+		int frame_count = 0;
+		_preroll_frames = _stream_data->acquire_preroll(start, end, frame_count);
+		_preroll_remaining = _preroll_frames ? frame_count : 0;
+	}
+
+	_stream_data->seek(start + _preroll_remaining);
+}
+
+void SiOPMChannelStream::_release_preroll() {
+	if (_preroll_frames && _stream_data.is_valid()) {
+		_stream_data->release_preroll();
+	}
+	_preroll_frames = nullptr;
+	_preroll_remaining = 0;
+}
+
+int SiOPMChannelStream::_source_available() const {
+	return _preroll_remaining + _stream_data->ring_available();
+}
+
+double SiOPMChannelStream::_read_source_sample(int p_offset, int p_channel) const {
+	if (p_offset < _preroll_remaining) {
+		int channels = _stream_data->get_channel_count();
+		int channel = (channels > 1) ? CLAMP(p_channel, 0, channels - 1) : 0;
+		return _preroll_frames[p_offset * channels + channel];
+	}
+	return _stream_data->ring_read_sample(p_offset - _preroll_remaining, p_channel);
+}
+
+void SiOPMChannelStream::_advance_source(int p_frames) {
+	int from_preroll = MIN(p_frames, _preroll_remaining);
+	if (from_preroll > 0) {
+		_preroll_frames += from_preroll * _stream_data->get_channel_count();
+		_preroll_remaining -= from_preroll;
+		if (_preroll_remaining == 0) {
+			_release_preroll();
+		}
+	}
+
+	if (p_frames > from_preroll) {
+		_stream_data->ring_advance_read(p_frames - from_preroll);
+	}
+}
+
 // ---------------------------------------------------------------------------
 // Effective clip length helper
 // ---------------------------------------------------------------------------
@@ -290,9 +350,10 @@ void SiOPMChannelStream::_start_playback_at(int64_t p_start_sample) {
 	// refilled correctly. seek() is lock-free (atomics + Treiber-stack
 	// enqueue) so it is safe to call from the audio thread. The loader
 	// thread picks up the refill request and fills the ring buffer
-	// asynchronously; buffer() handles any brief underrun with silence
-	// until data arrives.
-	_stream_data->seek(p_start_sample);
+	// asynchronously. If the position is in the pre-roll cache, playback
+	// starts from it right away; otherwise buffer() handles the brief
+	// underrun with silence until data arrives.
+	_seek_source(p_start_sample);
 
 	// Activate the stream (registers with loader if not already).
 	_stream_data->activate();
@@ -390,6 +451,8 @@ void SiOPMChannelStream::buffer(int p_length) {
 	// Branch: granular modes (TONES=3, TEXTURE=4) vs standard playback.
 	bool granular_mode = (_warp_mode == 3 || _warp_mode == 4);
 	const double clip_step_advance = _get_clip_steps_per_output_sample();
+	// Source frames consumed per output sample, reported to the loader pool for refill ordering.
+	double consumed_per_sample = _pitch_step;
 
 	if (granular_mode) {
 		// Granular overlap-add engine (delegated to SiOPMWarpProcessor).
@@ -403,10 +466,11 @@ void SiOPMChannelStream::buffer(int p_length) {
 			double driver_bpm = _sound_chip ? _sound_chip->get_bpm() : 120.0;
 			source_advance *= driver_bpm / _clip_bpm;
 		}
+		consumed_per_sample = source_advance;
 
 		// Lambda: read from the ring buffer at an offset.
 		auto ring_reader = [&](int off, int ch) -> double {
-			return _stream_data->ring_read_sample(off, ch);
+			return _read_source_sample(off, ch);
 		};
 
 		for (int i = 0; i < p_length; i++) {
@@ -448,7 +512,7 @@ void SiOPMChannelStream::buffer(int p_length) {
 			_warp.schedule_grain_if_needed(_warp.get_source_pos(), _pitch_step, _warp_mode);
 
 			// Read granular output.
-			int avail = _stream_data->ring_available();
+			int avail = _source_available();
 			double sampleL = _warp.read_granular(ring_reader, avail, 0, channels, _pitch_step);
 			double sampleR = (channels == 2)
 				? _warp.read_granular(ring_reader, avail, 1, channels, _pitch_step)
@@ -507,10 +571,10 @@ void SiOPMChannelStream::buffer(int p_length) {
 					safe_advance = 0;
 				}
 
-				int available = _stream_data->ring_available();
+				int available = _source_available();
 				int to_consume = MIN(safe_advance, available - 2);
 				if (to_consume > 0) {
-					_stream_data->ring_advance_read(to_consume);
+					_advance_source(to_consume);
 					_warp.adjust_positions(to_consume);
 				}
 			}
@@ -518,6 +582,7 @@ void SiOPMChannelStream::buffer(int p_length) {
 	} else {
 		// Standard (non-granular) playback path.
 		int ring_frames_consumed = 0;
+		int underrun_frames = 0;
 
 		for (int i = 0; i < p_length; i++) {
 		// End/loop check — mirrors sampler's pattern: check BEFORE interpolation.
@@ -555,7 +620,7 @@ void SiOPMChannelStream::buffer(int p_length) {
 			}
 
 			// Check ring buffer availability (need 2 frames for interpolation).
-			int available = _stream_data->ring_available();
+			int available = _source_available();
 			int needed = (int)_playback_pos + 2;
 
 			if (available < needed) {
@@ -566,6 +631,7 @@ void SiOPMChannelStream::buffer(int p_length) {
 				// audio data arrives from the loader). Advancing
 				// _playback_pos makes the underrun permanent (needed >
 				// available even after the ring refills).
+				underrun_frames++;
 				left_write->value = 0;
 				left_write = left_write->next();
 				if (channels == 2 && right_write) {
@@ -579,15 +645,15 @@ void SiOPMChannelStream::buffer(int p_length) {
 			int base_idx = (int)_playback_pos;
 			double frac = _playback_pos - base_idx;
 
-			double sampleL = _stream_data->ring_read_sample(base_idx, 0)
-				+ (_stream_data->ring_read_sample(base_idx + 1, 0)
-					- _stream_data->ring_read_sample(base_idx, 0)) * frac;
+			double sampleL = _read_source_sample(base_idx, 0)
+				+ (_read_source_sample(base_idx + 1, 0)
+					- _read_source_sample(base_idx, 0)) * frac;
 
 			double sampleR = sampleL;
 			if (channels == 2) {
-				sampleR = _stream_data->ring_read_sample(base_idx, 1)
-					+ (_stream_data->ring_read_sample(base_idx + 1, 1)
-						- _stream_data->ring_read_sample(base_idx, 1)) * frac;
+				sampleR = _read_source_sample(base_idx, 1)
+					+ (_read_source_sample(base_idx + 1, 1)
+						- _read_source_sample(base_idx, 1)) * frac;
 			}
 
 			// Apply native gain, technical envelope, clip envelope, and declick-in ramp.
@@ -623,11 +689,16 @@ void SiOPMChannelStream::buffer(int p_length) {
 			int new_base = (int)_playback_pos;
 			if (new_base > ring_frames_consumed) {
 				int to_consume = new_base - ring_frames_consumed;
-				_stream_data->ring_advance_read(to_consume);
+				_advance_source(to_consume);
 				_playback_pos -= to_consume;
 				ring_frames_consumed = 0; // Reset since we adjusted _playback_pos.
 			}
 		}
+
+		// Live streams are fed by the caller, so an empty ring there is not a loader underrun.
+		if (underrun_frames > 0 && !_is_live_stream()) {
+			_stream_data->report_underrun(underrun_frames);
+		}
 	}
 
 	// Request refill if ring buffer is running low.
@@ -635,7 +706,8 @@ void SiOPMChannelStream::buffer(int p_length) {
 		int available = _stream_data->ring_available();
 		// Use half the default ring capacity as threshold.
 		if (available < SiOPMWaveStreamData::DEFAULT_RING_CAPACITY / 2) {
-			_stream_data->request_refill();
+			const int sr = (_table ? _table->sampling_rate : 0);
+			_stream_data->request_refill(consumed_per_sample * sr);
 		}
 	}
 
@@ -723,6 +795,7 @@ void SiOPMChannelStream::initialize(SiOPMChannelBase *p_prev, int p_buffer_index
 }
 
 void SiOPMChannelStream::reset() {
+	_release_preroll();
 	_is_note_on = false;
 	_is_idling = true;
 	_playing = false;
@@ -934,7 +1007,7 @@ void SiOPMChannelStream::seek_to(int64_t p_position_sample) {
 		return;
 	}
 
-	_stream_data->seek(p_position_sample);
+	_seek_source(p_position_sample);
 	_playback_pos = 0.0;
 
 	// Compute source frames elapsed relative to in_sample.
@@ -961,3 +1034,8 @@ String SiOPMChannelStream::_to_string() const {
 SiOPMChannelStream::SiOPMChannelStream(SiOPMSoundChip *p_chip) : SiOPMChannelBase(p_chip) {
 	// Empty.
 }
+
+SiOPMChannelStream::~SiOPMChannelStream() {
+	// A held pre-roll keeps the stream data's retired cache alive until it is released.
+	_release_preroll();
+}
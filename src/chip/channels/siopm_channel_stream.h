@@ -44,6 +44,12 @@ class SiOPMChannelStream : public SiOPMChannelBase {
 	std::atomic<int64_t> _reported_source_sample_abs{0}; // Main-thread readable cursor in absolute source frames.
 	std::atomic<double> _reported_clip_time_steps{0.0}; // Main-thread readable clip-time cursor in steps.
 
+	// ---- Pre-roll (audio thread only) ----
+	// Source frames from the stream's pre-roll cache that play before the ring buffer.
+	// The loader fills the ring from where the pre-roll ends, so the two join seamlessly.
+	const float *_preroll_frames = nullptr;
+	int _preroll_remaining = 0;
+
 	// ---- Clip params (set via mailbox, read in buffer()) ----
 
 	int _gain_db = 0;               // Gain in dB (-36..+36), matches sampler.
@@ -100,6 +106,15 @@ class SiOPMChannelStream : public SiOPMChannelBase {
 	double _get_clip_steps_per_output_sample() const;
 	double _evaluate_clip_envelope(double p_clip_time_steps) const;
 
+	// Point the source at p_position_sample: pre-roll first if the stream has it cached,
+	// then the ring, which the loader is asked to refill from the end of the pre-roll.
+	void _seek_source(int64_t p_position_sample);
+	void _release_preroll();
+	// Source reads spanning the pre-roll and the ring buffer.
+	int _source_available() const;
+	double _read_source_sample(int p_offset, int p_channel) const;
+	void _advance_source(int p_frames);
+
 	// Shared note_on implementation: resets playback state and starts from p_start_sample.
 	void _start_playback_at(int64_t p_start_sample);
 
@@ -206,6 +221,7 @@ public:
 	void seek_to(int64_t p_position_sample);
 
 	SiOPMChannelStream(SiOPMSoundChip *p_chip = nullptr);
+	~SiOPMChannelStream();
 };
 
 #endif // SIOPM_CHANNEL_STREAM_H
@@ -7,13 +7,18 @@
 #include "siopm_operator.h"
 
 #include <cmath>
-#include <godot_cpp/classes/random_number_generator.hpp>
 #include "chip/siopm_operator_params.h"
 #include "chip/siopm_ref_table.h"
 #include "chip/siopm_sound_chip.h"
 #include "chip/wave/siopm_wave_pcm_data.h"
 #include "chip/wave/siopm_wave_table.h"
-#include "utils/godot_util.h"
+
+namespace {
+
+constexpr int EG_INCREMENT_TABLE_SIZE = 8;
+constexpr int EG_LEVEL_TABLE_SIZE = 1 << SiOPMRefTable::ENV_BITS;
+
+} // namespace
 
 const int SiOPMOperator::_eg_next_state_table[2][EG_MAX] = {
 	// EG_ATTACK,  EG_DECAY,   EG_SUSTAIN, EG_RELEASE, EG_OFF
@@ -222,23 +227,26 @@ void SiOPMOperator::_update_wave_table_cache() {
 void SiOPMOperator::set_pulse_generator_type(int p_type) {
 	_pg_type = p_type & SiOPMRefTable::PG_FILTER;
 
-	Ref<SiOPMWaveTable> wave_table = _table->get_wave_table(_pg_type);
+	Ref<SiOPMWaveTable> wave_table = _table->get_wave_table(_pg_type, _ref_stencil);
 	_wave_table = wave_table->get_wavelet();
 	_wave_fixed_bits = wave_table->get_fixed_bits();
 	_update_wave_table_cache();
+	_wave_table_from_type = true;
+	_wave_table_generation = _table->wave_table_generation;
 }
 
 void SiOPMOperator::set_pitch_table_type(SiONPitchTableType p_type) {
 	_pt_type = p_type;
 
 	_wave_phase_step_shift = (SiOPMRefTable::PHASE_BITS - _wave_fixed_bits) & _table->phase_step_shift_filter[p_type];
-	_pitch_table = _table->pitch_table[p_type];
-	_pitch_table_filter = _pitch_table.size() - 1;
+	const Vector<int> &pitch_table = _table->pitch_table[p_type];
+	_pitch_table = pitch_table.ptr();
+	_pitch_table_filter = pitch_table.size() - 1;
 }
 
 int SiOPMOperator::get_wave_value(int p_index) const {
-	ERR_FAIL_INDEX_V(p_index, _wave_table.size(), -1);
-	return _wave_table[p_index];
+	ERR_FAIL_INDEX_V(p_index, _wave_table_size, -1);
+	return _wave_table_ptr[p_index];
 }
 
 void SiOPMOperator::set_fixed_pitch_index(int p_value) {
@@ -329,7 +337,21 @@ void SiOPMOperator::set_fnumber(int p_value) {
 void SiOPMOperator::set_super_wave(int p_count, int p_spread) {
 	_super_count = (p_count < 1) ? 1 : ((p_count > MAX_SUPER_VOICES) ? MAX_SUPER_VOICES : p_count);
 	_super_spread = (p_spread < 0) ? 0 : ((p_spread > 1000) ? 1000 : p_spread);
-	_super_norm_inv = (_super_count > 1) ? (1.0 / sqrt((double)_super_count)) : 1.0;
+	_update_super_active_count();
+}
+
+void SiOPMOperator::set_super_voice_limit(int p_limit) {
+	if (p_limit == _super_voice_limit) {
+		return;
+	}
+	_super_voice_limit = p_limit;
+	_update_super_active_count();
+}
+
+void SiOPMOperator::_update_super_active_count() {
+	_super_active_count = (_super_voice_limit > 0) ? MIN(_super_count, _super_voice_limit) : _super_count;
+	_super_norm_inv = (_super_active_count > 1) ? (1.0 / sqrt((double)_super_active_count)) : 1.0;
+	// Spread the remaining voices over the full detune and stereo range.
 	_update_super_phase_steps();
 	_update_super_pan_values();
 }
@@ -343,7 +365,7 @@ void SiOPMOperator::_update_super_pan_values() {
 	// Pan values range from 0 (full left) to 128 (full right), 64 = center.
 	// Spread voices across the stereo field based on _super_stereo_spread.
 	// At spread=0, all voices are centered. At spread=100, voices span full L-R.
-	if (_super_count <= 1 || _super_stereo_spread == 0) {
+	if (_super_active_count <= 1 || _super_stereo_spread == 0) {
 		for (int i = 0; i < MAX_SUPER_VOICES; i++) {
 			_super_pan_values[i] = 64; // Center
 		}
@@ -353,9 +375,9 @@ void SiOPMOperator::_update_super_pan_values() {
 	// Calculate pan positions: distribute voices symmetrically around center.
 	// Voice 0 is leftmost, voice (count-1) is rightmost when spread is 100.
 	float half_spread = (_super_stereo_spread / 100.0f) * 64.0f; // Max offset from center
-	for (int i = 0; i < _super_count; i++) {
+	for (int i = 0; i < _super_active_count; i++) {
 		// Normalized position: -1 (leftmost) to +1 (rightmost)
-		float pos = (float)(i - (_super_count - 1) * 0.5f) / ((_super_count - 1) * 0.5f);
+		float pos = (float)(i - (_super_active_count - 1) * 0.5f) / ((_super_active_count - 1) * 0.5f);
 		// Convert to pan range [0-128] with center at 64
 		int pan = 64 + (int)(pos * half_spread);
 		_super_pan_values[i] = CLAMP(pan, 0, 128);
@@ -363,15 +385,15 @@ void SiOPMOperator::_update_super_pan_values() {
 }
 
 void SiOPMOperator::_update_super_phase_steps() {
-	if (_super_count <= 1) {
+	if (_super_active_count <= 1) {
 		return;
 	}
 
-	for (int i = 0; i < _super_count; i++) {
-		if (_super_count == 1) {
+	for (int i = 0; i < _super_active_count; i++) {
+		if (_super_active_count == 1) {
 			_super_phase_steps[i] = _phase_step;
 		} else {
-			float spread_factor = (float)(i - (_super_count - 1) * 0.5f) / ((_super_count - 1) * 0.5f);
+			float spread_factor = (float)(i - (_super_active_count - 1) * 0.5f) / ((_super_active_count - 1) * 0.5f);
 			int detune = (int)(_phase_step * spread_factor * _super_spread / 1000.0f);
 			_super_phase_steps[i] = _phase_step + detune;
 		}
@@ -379,7 +401,7 @@ void SiOPMOperator::_update_super_phase_steps() {
 }
 
 int SiOPMOperator::get_super_output(int p_fm_input, int p_input_level, int p_am_level) {
-	if (_super_count <= 1) {
+	if (_super_active_count <= 1) {
 		int t = ((_phase + (p_fm_input << p_input_level)) & SiOPMRefTable::PHASE_FILTER) >> _wave_fixed_bits;
 		int log_idx = _get_wave_value_fast(t) + _eg_output + p_am_level;
 		if (log_idx < 0) {
@@ -391,7 +413,7 @@ int SiOPMOperator::get_super_output(int p_fm_input, int p_input_level, int p_am_
 	}
 
 	int sum = 0;
-	for (int i = 0; i < _super_count; i++) {
+	for (int i = 0; i < _super_active_count; i++) {
 		int t = ((_super_phases[i] + (p_fm_input << p_input_level)) & SiOPMRefTable::PHASE_FILTER) >> _wave_fixed_bits;
 		int log_idx = _get_wave_value_fast(t) + _eg_output + p_am_level;
 		if (log_idx < 0) {
@@ -409,18 +431,18 @@ int SiOPMOperator::get_super_output(int p_fm_input, int p_input_level, int p_am_
 
 bool SiOPMOperator::get_super_output_stereo(int p_fm_input, int p_input_level, int p_am_level, int &r_left, int &r_right) {
 	// If stereo spread is disabled or single voice, fall back to mono.
-	if (_super_stereo_spread == 0 || _super_count <= 1) {
+	if (_super_stereo_spread == 0 || _super_active_count <= 1) {
 		r_left = r_right = get_super_output(p_fm_input, p_input_level, p_am_level);
 		return false; // Not stereo
 	}
 
 	// Pan table reference for converting pan position to L/R gains.
-	double (&pan_table)[129] = _table->pan_table;
+	const double (&pan_table)[129] = _table->pan_table;
 
 	double sum_left = 0.0;
 	double sum_right = 0.0;
 
-	for (int i = 0; i < _super_count; i++) {
+	for (int i = 0; i < _super_active_count; i++) {
 		int t = ((_super_phases[i] + (p_fm_input << p_input_level)) & SiOPMRefTable::PHASE_FILTER) >> _wave_fixed_bits;
 		int log_idx = _get_wave_value_fast(t) + _eg_output + p_am_level;
 		if (log_idx < 0) {
@@ -446,8 +468,8 @@ bool SiOPMOperator::get_super_output_stereo(int p_fm_input, int p_input_level, i
 void SiOPMOperator::tick_pulse_generator(int p_extra) {
 	_phase += _phase_step + p_extra;
 
-	if (_super_count > 1) {
-		for (int i = 0; i < _super_count; i++) {
+	if (_super_active_count > 1) {
+		for (int i = 0; i < _super_active_count; i++) {
 			_super_phases[i] += _super_phase_steps[i] + p_extra;
 		}
 	}
@@ -468,10 +490,10 @@ void SiOPMOperator::_shift_eg_state(EGState p_state) {
 					_eg_level = SiOPMRefTable::ENV_BOTTOM;
 				}
 				_eg_state = EG_ATTACK;
-			_eg_level_table = make_vector<int>(_table->eg_level_tables[0]);
+			_eg_level_table = _table->eg_level_tables[0];
 
 			const int index = _eg_rate_to_index(_attack_rate);
-			_eg_increment_table = make_vector<int>(_table->eg_increment_tables_attack[_table->eg_table_selector[index]]);
+			_eg_increment_table = _table->eg_increment_tables_attack[_table->eg_table_selector[index]];
 			_eg_timer_step = _table->eg_timer_steps[index];
 				break;
 			}
@@ -492,15 +514,15 @@ void SiOPMOperator::_shift_eg_state(EGState p_state) {
 
 					const int normalized_ssg_type = _ssg_type - SiOPMOperatorParams::SSG_REPEAT_TO_ZERO;
 					const int level_index = _table->eg_ssg_table_index[normalized_ssg_type][_eg_ssgec_attack_rate][_eg_ssgec_state];
-					_eg_level_table = make_vector<int>(_table->eg_level_tables[level_index]);
+					_eg_level_table = _table->eg_level_tables[level_index];
 				} else {
 					_eg_level = 0;
 					_eg_state_shift_level = _eg_sustain_level;
-			_eg_level_table = make_vector<int>(_table->eg_level_tables[0]);
+			_eg_level_table = _table->eg_level_tables[0];
 		}
 
 		int index = _eg_rate_to_index(_decay_rate);
-		_eg_increment_table = make_vector<int>(_table->eg_increment_tables[_table->eg_table_selector[index]]);
+		_eg_increment_table = _table->eg_increment_tables[_table->eg_table_selector[index]];
 		_eg_timer_step = _table->eg_timer_steps[index];
 				break;
 			}
@@ -516,15 +538,15 @@ void SiOPMOperator::_shift_eg_state(EGState p_state) {
 
 				const int normalized_ssg_type = _ssg_type - SiOPMOperatorParams::SSG_REPEAT_TO_ZERO;
 				const int level_index = _table->eg_ssg_table_index[normalized_ssg_type][_eg_ssgec_attack_rate][_eg_ssgec_state];
-				_eg_level_table = make_vector<int>(_table->eg_level_tables[level_index]);
+				_eg_level_table = _table->eg_level_tables[level_index];
 			} else {
 				_eg_level = _eg_sustain_level;
 				_eg_state_shift_level = SiOPMRefTable::ENV_BOTTOM;
-		_eg_level_table = make_vector<int>(_table->eg_level_tables[0]);
+		_eg_level_table = _table->eg_level_tables[0];
 	}
 
 	const int index = _eg_rate_to_index(_sustain_rate);
-	_eg_increment_table = make_vector<int>(_table->eg_increment_tables[_table->eg_table_selector[index]]);
+	_eg_increment_table = _table->eg_increment_tables[_table->eg_table_selector[index]];
 	_eg_timer_step = _table->eg_timer_steps[index];
 		} break;
 
@@ -534,9 +556,9 @@ void SiOPMOperator::_shift_eg_state(EGState p_state) {
 				_eg_state_shift_level = SiOPMRefTable::ENV_BOTTOM;
 
 				if (_ssg_type >= SiOPMOperatorParams::SSG_REPEAT_TO_ZERO) {
-					_eg_level_table = make_vector<int>(_table->eg_level_tables[1]);
+					_eg_level_table = _table->eg_level_tables[1];
 				} else {
-					_eg_level_table = make_vector<int>(_table->eg_level_tables[0]);
+					_eg_level_table = _table->eg_level_tables[0];
 				}
 
 				// Voice stealing: use the absolute fastest release (~2-3ms) to quickly
@@ -545,11 +567,11 @@ void SiOPMOperator::_shift_eg_state(EGState p_state) {
 				// Fast release is implicit when _deferred_attack_target != EG_OFF.
 				if (_deferred_attack_target != EG_OFF) {
 					// Table 16 = fastest (increment by 8 per cycle), with fastest timer.
-				_eg_increment_table = make_vector<int>(_table->eg_increment_tables[16]);
+				_eg_increment_table = _table->eg_increment_tables[16];
 				_eg_timer_step = _table->eg_timer_steps[63]; // Maximum timer step
 			} else {
 				const int index = _eg_rate_to_index(_release_rate);
-				_eg_increment_table = make_vector<int>(_table->eg_increment_tables[_table->eg_table_selector[index]]);
+				_eg_increment_table = _table->eg_increment_tables[_table->eg_table_selector[index]];
 				_eg_timer_step = _table->eg_timer_steps[index];
 			}
 				break;
@@ -562,32 +584,37 @@ void SiOPMOperator::_shift_eg_state(EGState p_state) {
 			_eg_state = EG_OFF;
 			_eg_level = SiOPMRefTable::ENV_BOTTOM;
 			_eg_state_shift_level = SiOPMRefTable::ENV_BOTTOM + 1;
-			_eg_level_table = make_vector<int>(_table->eg_level_tables[0]);
+			_eg_level_table = _table->eg_level_tables[0];
 
-			_eg_increment_table = make_vector<int>(_table->eg_increment_tables[17]); // 17 = all zero
+			_eg_increment_table = _table->eg_increment_tables[17]; // 17 = all zero
 			_eg_timer_step = _table->eg_timer_steps[96]; // 96 = all zero
 		} break;
 	}
 }
 
+int SiOPMOperator::_get_random_phase() {
+	// xorshift32; cheap enough for key-on and never allocates.
+	uint32_t x = _phase_rng_state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	_phase_rng_state = x;
+	return int(x & SiOPMRefTable::PHASE_FILTER);
+}
+
 void SiOPMOperator::_reset_note_phases() {
 	if (_key_on_phase >= 0) {
 		_phase = _key_on_phase;
 	} else if (_key_on_phase == -1) {
-		Ref<RandomNumberGenerator> rng;
-		rng.instantiate();
-		_phase = int(rng->randi_range(0, SiOPMRefTable::PHASE_MAX));
+		_phase = _get_random_phase();
 	}
 
 	if (_super_count > 1) {
 		// Each super voice gets a random starting phase for instant chorus/thickness.
 		// This is essential for the characteristic supersaw sound - without it,
 		// all voices start in phase and only gradually drift apart.
-		Ref<RandomNumberGenerator> rng;
-		rng.instantiate();
-
 		for (int i = 0; i < _super_count; i++) {
-			_super_phases[i] = int(rng->randi_range(0, SiOPMRefTable::PHASE_MAX));
+			_super_phases[i] = _get_random_phase();
 		}
 	}
 }
@@ -601,23 +628,31 @@ void SiOPMOperator::tick_eg(int p_timer_initial) {
 		return;
 	}
 
-	// Snapshot increment table to avoid torn reads and guard indexing.
-	Vector<int> inc = _eg_increment_table;
-	int inc_size = inc.size();
-	int step = 0;
-	if (likely(inc_size > 0)) {
-		int inc_idx = (_eg_counter & 7);
-		if (unlikely(inc_idx >= inc_size)) {
-			// Wrap just in case a non-standard table size slips through.
-			if ((inc_size & (inc_size - 1)) == 0) {
-				inc_idx &= (inc_size - 1);
-			} else {
-				inc_idx %= inc_size;
-			}
-		}
-		step = inc[inc_idx];
+	_step_eg();
+	_eg_timer += p_timer_initial;
+}
+
+void SiOPMOperator::tick_eg_block(int p_timer_initial, int p_length) {
+	const int start_output = _eg_output;
+
+	// Same number of steps as p_length calls to tick_eg(), at most one per sample.
+	_eg_timer -= _eg_timer_step * p_length;
+	for (int i = 0; i < p_length && _eg_timer < 0; i++) {
+		_step_eg();
+		_eg_timer += p_timer_initial;
 	}
 
+	_eg_ramp_target = _eg_output;
+	_eg_ramp_value = start_output << EG_RAMP_BITS;
+	// The delta can be negative, so scale by multiplying rather than shifting.
+	_eg_ramp_step = (_eg_ramp_target - start_output) * (1 << EG_RAMP_BITS) / p_length;
+	_eg_output = start_output;
+}
+
+void SiOPMOperator::_step_eg() {
+	// Every increment table has EG_INCREMENT_TABLE_SIZE entries, and the counter wraps at 8.
+	int step = _eg_increment_table[_eg_counter & (EG_INCREMENT_TABLE_SIZE - 1)];
+
 	if (_eg_state == SiOPMOperator::EG_ATTACK) {
 		int offset = step;
 		if (offset > 0) {
@@ -652,51 +687,33 @@ void SiOPMOperator::tick_eg(int p_timer_initial) {
 
 	update_eg_output();
 	_eg_counter = (_eg_counter + 1) & 7;
-
-	_eg_timer += p_timer_initial;
 }
 
 void SiOPMOperator::update_eg_output() {
-	// Snapshot the level table because another thread can swap it while the audio
-	// thread is in-flight, leaving the internal pointer dangling between the size
-	// check and the indexed read.
-	Vector<int> level_table = _eg_level_table;
-
-	// Guard against the envelope level table being unexpectedly empty. This can
-	// happen if initialization failed or a malformed SSG envelope was selected.
-	int table_size = level_table.size();
-	if (unlikely(table_size == 0)) {
-		// A zero-length table makes no sense; output silence and keep the internal
-		// level within a safe range to avoid undefined behaviour.
-		_eg_level = 0;
-		_eg_output = _eg_total_level << 3;
-		return;
-	}
+	// The level table pointer can be swapped by another thread while the audio thread
+	// is in-flight, but every table it can point to is immutable and has the same size,
+	// so reading it once is enough.
+	const int *level_table = _eg_level_table;
+
 	// Guard against envelope generator level going out of the table bounds which
-	// can happen under extreme modulation/voice-overflow situations. Using
-	// CLAMP keeps the original behaviour for valid ranges while preventing a
-	// fatal CRASH_BAD_INDEX when the synth is overloaded.
+	// can happen under extreme modulation/voice-overflow situations. Clamping
+	// keeps the original behaviour for valid ranges while preventing an
+	// out-of-bounds read when the synth is overloaded.
 	int safe_index = _eg_level;
 	if (unlikely(safe_index < 0)) {
 		safe_index = 0;
-	} else if (unlikely(safe_index >= table_size)) {
-		safe_index = table_size - 1;
+	} else if (unlikely(safe_index >= EG_LEVEL_TABLE_SIZE)) {
+		safe_index = EG_LEVEL_TABLE_SIZE - 1;
 	}
 	_eg_level = safe_index; // keep internal state consistent
 	_eg_output = (level_table[safe_index] + _eg_total_level) << 3;
 }
 
 void SiOPMOperator::update_eg_output_from(SiOPMOperator *p_other) {
-	// Safely read other's EG level table to avoid out-of-bounds in debug.
-	Vector<int> other_tbl = p_other->_eg_level_table;
-	int size = other_tbl.size();
+	const int *other_tbl = p_other->_eg_level_table;
 	int idx = p_other->_eg_level;
-	if (unlikely(size == 0)) {
-		_eg_output = _eg_total_level << 3;
-		return;
-	}
 	if (unlikely(idx < 0)) idx = 0;
-	else if (unlikely(idx >= size)) idx = size - 1;
+	else if (unlikely(idx >= EG_LEVEL_TABLE_SIZE)) idx = EG_LEVEL_TABLE_SIZE - 1;
 	_eg_output = (other_tbl[idx] + _eg_total_level) << 3;
 }
 
@@ -732,9 +749,9 @@ void SiOPMOperator::update_active_eg_timer() {
 	const int index = _eg_rate_to_index(rate);
 	
 	if (_eg_state == EG_ATTACK) {
-		_eg_increment_table = make_vector<int>(_table->eg_increment_tables_attack[_table->eg_table_selector[index]]);
+		_eg_increment_table = _table->eg_increment_tables_attack[_table->eg_table_selector[index]];
 	} else {
-		_eg_increment_table = make_vector<int>(_table->eg_increment_tables[_table->eg_table_selector[index]]);
+		_eg_increment_table = _table->eg_increment_tables[_table->eg_table_selector[index]];
 	}
 	
 	_eg_timer_step = _table->eg_timer_steps[index];
@@ -754,40 +771,53 @@ void SiOPMOperator::set_pipes(SinglyLinkedList<int> *p_out_pipe, SinglyLinkedLis
 //
 
 void SiOPMOperator::set_operator_params(const Ref<SiOPMOperatorParams> &p_params) {
-	// Some code here is duplicated from respective setters to avoid calling them
-	// and triggering side effects. Modify with care.
-
 	// Defensive check: ensure params reference is valid.
 	if (unlikely(p_params.is_null())) {
 		ERR_FAIL_MSG("SiOPMOperator::set_operator_params() called with null params. This indicates a lifecycle or initialization bug.");
 	}
 
-	set_pulse_generator_type(p_params->get_pulse_generator_type());
-	set_pitch_table_type(p_params->get_pitch_table_type());
+	SiOPMOperatorProgram program;
+	p_params->compile_program(program);
+	set_operator_program(program);
+}
+
+void SiOPMOperator::set_operator_program(const SiOPMOperatorProgram &p_program) {
+	// Some code here is duplicated from respective setters to avoid calling them
+	// and triggering side effects. Modify with care.
 
-	set_key_on_phase(p_params->get_initial_phase());
+	// Drum tracks switch between the same few voices on every hit, so skip the wave and
+	// pitch table lookups when they would resolve to what's already there. Registering a
+	// wave table at runtime bumps the generation and forces a new lookup.
+	const int pg_type = p_program.pulse_generator_type & SiOPMRefTable::PG_FILTER;
+	const SiONPitchTableType pt_type = (SiONPitchTableType)p_program.pitch_table_type;
+	if (!_wave_table_from_type || pg_type != _pg_type || pt_type != _pt_type || _wave_table_generation != _table->wave_table_generation) {
+		set_pulse_generator_type(pg_type);
+		set_pitch_table_type(pt_type);
+	}
 
-	set_attack_rate(p_params->get_attack_rate());
-	set_decay_rate(p_params->get_decay_rate());
-	set_sustain_rate(p_params->get_sustain_rate());
-	set_release_rate(p_params->get_release_rate());
+	set_key_on_phase(p_program.initial_phase);
 
-	set_key_scaling_rate(p_params->get_key_scaling_rate());
-	set_key_scaling_level(p_params->get_key_scaling_level(), true);
+	set_attack_rate(p_program.attack_rate);
+	set_decay_rate(p_program.decay_rate);
+	set_sustain_rate(p_program.sustain_rate);
+	set_release_rate(p_program.release_rate);
 
-	set_amplitude_modulation_shift(p_params->get_amplitude_modulation_shift());
+	set_key_scaling_rate(p_program.key_scaling_rate);
+	set_key_scaling_level(p_program.key_scaling_level, true);
 
-	_fine_multiple = p_params->get_fine_multiple();
-	_fm_shift = (p_params->get_frequency_modulation_level() & 7) + 10;
-	_detune1 = p_params->get_detune1() & 7;
-	_pitch_index_shift = p_params->get_detune2();
+	set_amplitude_modulation_shift(p_program.amplitude_modulation_shift);
 
-	_mute = p_params->get_mute() ? SiOPMRefTable::ENV_BOTTOM : 0;
-	set_ssg_type(p_params->get_ssg_envelope_control());
-	_envelope_reset_on_attack = p_params->get_envelope_reset_on_attack();
+	_fine_multiple = p_program.fine_multiple;
+	_fm_shift = (p_program.frequency_modulation_level & 7) + 10;
+	_detune1 = p_program.detune1 & 7;
+	_pitch_index_shift = p_program.detune2;
 
-	if (p_params->get_fixed_pitch() > 0) {
-		_pitch_index = p_params->get_fixed_pitch();
+	_mute = p_program.mute ? SiOPMRefTable::ENV_BOTTOM : 0;
+	set_ssg_type(p_program.ssg_envelope_control);
+	_envelope_reset_on_attack = p_program.envelope_reset_on_attack;
+
+	if (p_program.fixed_pitch > 0) {
+		_pitch_index = p_program.fixed_pitch;
 
 		_update_key_code(_table->note_number_to_key_code[(_pitch_index >> 6) & 127]);
 		_pitch_fixed = true;
@@ -795,11 +825,14 @@ void SiOPMOperator::set_operator_params(const Ref<SiOPMOperatorParams> &p_params
 		_pitch_fixed = false;
 	}
 
-	set_sustain_level(p_params->get_sustain_level() & 15);
-	set_total_level(p_params->get_total_level());
+	set_sustain_level(p_program.sustain_level & 15);
+	set_total_level(p_program.total_level);
 
-	set_super_wave(p_params->get_super_count(), p_params->get_super_spread());
-	set_super_stereo_spread(p_params->get_super_stereo_spread());
+	// Same clamps as set_super_wave() and set_super_stereo_spread(), with a single refresh.
+	_super_count = CLAMP(p_program.super_count, 1, MAX_SUPER_VOICES);
+	_super_spread = CLAMP(p_program.super_spread, 0, 1000);
+	_super_stereo_spread = CLAMP(p_program.super_stereo_spread, 0, 100);
+	_update_super_active_count();
 
 	_update_pitch();
 }
@@ -835,6 +868,7 @@ void SiOPMOperator::get_operator_params(const Ref<SiOPMOperatorParams> &r_params
 
 void SiOPMOperator::set_wave_table(const Ref<SiOPMWaveTable> &p_wave_table) {
 	_pg_type = SiONPulseGeneratorType::PULSE_USER_CUSTOM;
+	_wave_table_from_type = false;
 
 	_wave_table = p_wave_table->get_wavelet();
 	_wave_fixed_bits = p_wave_table->get_fixed_bits();
@@ -849,6 +883,7 @@ void SiOPMOperator::set_wave_table(const Ref<SiOPMWaveTable> &p_wave_table) {
 void SiOPMOperator::set_pcm_data(const Ref<SiOPMWavePCMData> &p_pcm_data) {
 	if (p_pcm_data.is_valid() && !p_pcm_data->get_wavelet().is_empty()) {
 		_pg_type = SiONPulseGeneratorType::PULSE_USER_PCM;
+		_wave_table_from_type = false;
 		_pt_type = SiONPitchTableType::PITCH_TABLE_PCM;
 
 		_wave_table = p_pcm_data->get_wavelet();
@@ -870,14 +905,17 @@ void SiOPMOperator::set_pcm_data(const Ref<SiOPMWavePCMData> &p_pcm_data) {
 
 void SiOPMOperator::update_sound_chip(SiOPMSoundChip *p_chip) {
 	_sound_chip = p_chip;
-	_table = SiOPMRefTable::get_instance();
+	_table = p_chip ? p_chip->get_ref_table() : SiOPMRefTable::get_instance();
 
 	// Pooled operators can outlive a driver/sample-rate change. Refresh the
-	// EG tables that are sourced directly from the global ref table so the next
-	// initialize()/set_operator_params() call rebuilds against the current rate.
+	// views into the ref table so the next initialize()/set_operator_params()
+	// call rebuilds against the current rate; the old pitch table goes away
+	// with the old ref table.
+	_wave_table_from_type = false;
 	if (_table) {
-		_eg_increment_table = make_vector<int>(_table->eg_increment_tables[17]);
-		_eg_level_table = make_vector<int>(_table->eg_level_tables[0]);
+		_eg_increment_table = _table->eg_increment_tables[17];
+		_eg_level_table = _table->eg_level_tables[0];
+		set_pitch_table_type(_pt_type);
 	}
 }
 
@@ -977,7 +1015,7 @@ void SiOPMOperator::initialize() {
 	// set_operator_params() already restored the configured super-wave state.
 	for (int i = 0; i < MAX_SUPER_VOICES; i++) {
 		_super_phases[i] = 0;
-		if (i >= _super_count) {
+		if (i >= _super_active_count) {
 			_super_phase_steps[i] = 0;
 			_super_pan_values[i] = 64; // Center
 		}
@@ -1046,10 +1084,17 @@ String SiOPMOperator::_to_string() const {
 }
 
 SiOPMOperator::SiOPMOperator(SiOPMSoundChip *p_chip) {
-	_table = SiOPMRefTable::get_instance();
+	_table = p_chip ? p_chip->get_ref_table() : SiOPMRefTable::get_instance();
 	_sound_chip = p_chip;
 
 	_feed_pipe = memnew(SinglyLinkedList<int>(1, 0, true));
-	_eg_increment_table = make_vector<int>(_table->eg_increment_tables[17]);
-	_eg_level_table = make_vector<int>(_table->eg_level_tables[0]);
+	_eg_increment_table = _table->eg_increment_tables[17];
+	_eg_level_table = _table->eg_level_tables[0];
+	set_pitch_table_type(_pt_type);
+
+	// Decorrelate random phases between operators; xorshift32 must not start at zero.
+	_phase_rng_state = (uint32_t)((uintptr_t)this >> 4) * 2654435761u;
+	if (_phase_rng_state == 0) {
+		_phase_rng_state = 1;
+	}
 }
@@ -14,8 +14,10 @@
 
 using namespace godot;
 
+struct SiOPMOperatorProgram;
 class SiOPMOperatorParams;
 class SiOPMRefTable;
+struct SiOPMRefStencil;
 class SiOPMSoundChip;
 class SiOPMWavePCMData;
 class SiOPMWaveTable;
@@ -30,6 +32,8 @@ class SiOPMWaveTable;
 class SiOPMOperator : public Object {
 	GDCLASS(SiOPMOperator, Object)
 
+	friend class SiOPMChannelFMBatch;
+
 public:
 	enum EGState {
 		EG_ATTACK  = 0,
@@ -46,6 +50,8 @@ private:
 
 	SiOPMRefTable *_table = nullptr;
 	SiOPMSoundChip *_sound_chip = nullptr;
+	// Set by the owning channel; custom wave tables are resolved through it.
+	const SiOPMRefStencil *_ref_stencil = nullptr;
 
 	// FM module parameters.
 
@@ -116,11 +122,18 @@ private:
 	int _wave_table_size = 0;
 	int _wave_table_mask = 0;
 	bool _wave_table_is_pow2 = false;
+	// The wave table is the ref table's one for _pg_type and the current stencil, so
+	// applying the same pulse generator type again can skip the lookup.
+	bool _wave_table_from_type = false;
+	// Ref table wave generation at the time of that lookup.
+	uint32_t _wave_table_generation = 0;
 	// Phase shift.
 	int _wave_fixed_bits = 0;
 	// Phase step shift.
 	int _wave_phase_step_shift = 0;
-	Vector<int> _pitch_table;
+	// View into the ref table's pitch table for _pt_type; the ref table owns it and
+	// never resizes it after construction.
+	const int *_pitch_table = nullptr;
 	int _pitch_table_filter = 0;
 
 	int _phase = 0;
@@ -128,6 +141,10 @@ private:
 	// -1 means no phase reset.
 	int _key_on_phase = 0;
 	bool _pitch_fixed = false;
+	// xorshift32 state for random key-on phases; seeded per operator.
+	uint32_t _phase_rng_state = 1;
+
+	int _get_random_phase();
 
 	// Pitch index = note * 64 + key fraction.
 	int _pitch_index = 0;
@@ -168,10 +185,13 @@ private:
 	// SSG envelope control state.
 	int _eg_ssgec_state = 0;
 
-	Vector<int> _eg_increment_table;
+	// EG tables are views into the immutable tables shared by every SiOPMRefTable, so
+	// state transitions only swap pointers and never allocate. An increment table has
+	// 8 entries, a level table 1 << SiOPMRefTable::ENV_BITS.
+	const int *_eg_increment_table = nullptr;
 	int _eg_state_shift_level = 0;
 	int _eg_state_table_index = 0;
-	Vector<int> _eg_level_table;
+	const int *_eg_level_table = nullptr;
 
 	// Voice-stealing state: when != EG_OFF, we're deferring transition to this
 	// state until the envelope reaches near-silence. This avoids discontinuities
@@ -188,9 +208,17 @@ private:
 	// operator's own EG state, which can be reset by initialize().
 	bool _is_voice_steal_hint = false;
 
+	// Control-rate envelope ramp, in fixed point with EG_RAMP_BITS of fraction.
+	static const int EG_RAMP_BITS = 12;
+	int _eg_ramp_value = 0;
+	int _eg_ramp_step = 0;
+	int _eg_ramp_target = 0;
+
 	void _reset_note_phases();
 
 	void _shift_eg_state(EGState p_state);
+	// One envelope update, when the EG timer runs out.
+	void _step_eg();
 
 	inline int _eg_rate_to_index(int p_rate) const {
 		return (p_rate != 0) ? (p_rate + _eg_key_scale_rate) : 96;
@@ -210,6 +238,9 @@ private:
 	int _super_phase_steps[MAX_SUPER_VOICES] = {};
 	int _super_count = 1;
 	int _super_spread = 0;
+	// Voices rendered, _super_count capped by the quality limit (0 for none).
+	int _super_active_count = 1;
+	int _super_voice_limit = 0;
 	// Cached normalization factor for super voices (1 / sqrt(count)).
 	double _super_norm_inv = 1.0;
 	// Stereo spread [0-100]. 0 = mono, 100 = full stereo spread across voices.
@@ -217,6 +248,7 @@ private:
 	// Precomputed per-voice pan values [0-128] for stereo spread. 64 = center.
 	int _super_pan_values[MAX_SUPER_VOICES] = {};
 
+	void _update_super_active_count();
 	void _update_super_phase_steps();
 	void _update_super_pan_values();
 
@@ -298,6 +330,10 @@ public:
 
 	int get_pulse_generator_type() const { return _pg_type; }
 	void set_pulse_generator_type(int p_type);
+	void set_ref_stencil(const SiOPMRefStencil *p_stencil) {
+		_ref_stencil = p_stencil;
+		_wave_table_from_type = false;
+	}
 	SiONPitchTableType get_pitch_table_type() const { return _pt_type; }
 	void set_pitch_table_type(SiONPitchTableType p_type);
 
@@ -348,6 +384,8 @@ public:
 	int get_super_spread() const { return _super_spread; }
 	int get_super_stereo_spread() const { return _super_stereo_spread; }
 	void set_super_wave(int p_count, int p_spread);
+	// Render at most p_limit of the super voices, 0 for all of them.
+	void set_super_voice_limit(int p_limit);
 	void set_super_stereo_spread(int p_value);
 	int get_super_output(int p_fm_input, int p_input_level, int p_am_level);
 	// Returns true if stereo spread is active and outputs left/right separately.
@@ -360,6 +398,15 @@ public:
 
 	int get_eg_output() const { return _eg_output; }
 	void tick_eg(int p_timer_initial);
+	// Control rate: advance the envelope by p_length samples at once, then call
+	// tick_eg_ramp() once per sample to move the output there linearly, and
+	// end_eg_ramp() after the block.
+	void tick_eg_block(int p_timer_initial, int p_length);
+	_FORCE_INLINE_ void tick_eg_ramp() {
+		_eg_ramp_value += _eg_ramp_step;
+		_eg_output = _eg_ramp_value >> EG_RAMP_BITS;
+	}
+	void end_eg_ramp() { _eg_output = _eg_ramp_target; }
 	void update_eg_output();
 	void update_eg_output_from(SiOPMOperator *p_other);
 	void update_active_eg_timer();
@@ -386,6 +433,7 @@ public:
 	//
 
 	void set_operator_params(const Ref<SiOPMOperatorParams> &p_params);
+	void set_operator_program(const SiOPMOperatorProgram &p_program);
 	void get_operator_params(const Ref<SiOPMOperatorParams> &r_params);
 	void set_wave_table(const Ref<SiOPMWaveTable> &p_wave_table);
 	void set_pcm_data(const Ref<SiOPMWavePCMData> &p_pcm_data);
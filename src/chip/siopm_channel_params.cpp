@@ -26,11 +26,13 @@ void SiOPMChannelParams::set_operator_count(int p_value) {
 
 	operator_count = p_value;
 	_update_carrier_mask();
+	revision++;
 }
 
 void SiOPMChannelParams::set_algorithm(int p_value) {
 	algorithm = p_value;
 	_update_carrier_mask();
+	revision++;
 }
 
 void SiOPMChannelParams::_update_carrier_mask() {
@@ -135,6 +137,7 @@ void SiOPMChannelParams::set_master_volume(int p_index, double p_value) {
 	ERR_FAIL_INDEX(p_index, master_volumes.size());
 
 	master_volumes.write[p_index] = p_value;
+	revision++;
 }
 
 bool SiOPMChannelParams::has_filter() const {
@@ -151,6 +154,7 @@ int SiOPMChannelParams::get_lfo_frame() const {
 
 void SiOPMChannelParams::set_lfo_frame(int p_fps) {
 	lfo_frequency_step = (int)(SiOPMRefTable::LFO_TIMER_INITIAL/(p_fps * 2.882352941176471));
+	revision++;
 }
 
 void SiOPMChannelParams::set_lfo_time_mode(int p_value) {
@@ -163,6 +167,7 @@ void SiOPMChannelParams::set_lfo_time_mode(int p_value) {
 		case 1:  lfo_frequency_step = lfo_time_value; break;
 		default: lfo_frequency_step = lfo_beat_division; break;
 	}
+	revision++;
 }
 
 void SiOPMChannelParams::set_lfo_rate_value(int p_value) {
@@ -170,6 +175,7 @@ void SiOPMChannelParams::set_lfo_rate_value(int p_value) {
 	if (lfo_time_mode == 0) {
 		lfo_frequency_step = p_value;
 	}
+	revision++;
 }
 
 void SiOPMChannelParams::set_lfo_time_value(int p_value) {
@@ -177,6 +183,7 @@ void SiOPMChannelParams::set_lfo_time_value(int p_value) {
 	if (lfo_time_mode == 1) {
 		lfo_frequency_step = p_value;
 	}
+	revision++;
 }
 
 void SiOPMChannelParams::set_lfo_beat_value(int p_value) {
@@ -184,9 +191,12 @@ void SiOPMChannelParams::set_lfo_beat_value(int p_value) {
 	if (lfo_time_mode >= 2) {
 		lfo_frequency_step = p_value;
 	}
+	revision++;
 }
 
-void SiOPMChannelParams::set_by_opm_register(int p_channel, int p_address, int p_data) {
+void SiOPMChannelParams::set_by_opm_register(int p_channel, int p_address, int p_data, const SiOPMRefTable *p_table) {
+	revision++;
+
 	if (p_address < 0x20) { // Module parameter
 		switch (p_address) {
 			case 15: { // NOIZE:7 FREQ:4-0 for channel#7
@@ -198,7 +208,8 @@ void SiOPMChannelParams::set_by_opm_register(int p_channel, int p_address, int p
 			} break;
 
 			case 24: { // LFO FREQ:7-0 for all 8 channels
-				lfo_frequency_step = SiOPMRefTable::get_instance()->lfo_timer_steps[p_data];
+				const SiOPMRefTable *table = p_table ? p_table : SiOPMRefTable::get_instance();
+				lfo_frequency_step = table->lfo_timer_steps[p_data];
 			} break;
 
 			case 25: { // A(0)/P(1):7 DEPTH:6-0 for all 8 channels
@@ -280,6 +291,7 @@ void SiOPMChannelParams::initialize() {
 
 	amplitude_modulation_depth = 0;
 	pitch_modulation_depth = 0;
+	audio_rate_modulation = false;
 	envelope_frequency_ratio = 100;
 
 	for (int i = 1; i < SiOPMSoundChip::STREAM_SEND_SIZE; i++) {
@@ -313,6 +325,7 @@ void SiOPMChannelParams::initialize() {
 	}
 
 	init_sequence->clear();
+	revision++;
 }
 
 void SiOPMChannelParams::copy_from(const Ref<SiOPMChannelParams> &p_params) {
@@ -336,6 +349,7 @@ void SiOPMChannelParams::copy_from(const Ref<SiOPMChannelParams> &p_params) {
 
 	amplitude_modulation_depth = p_params->amplitude_modulation_depth;
 	pitch_modulation_depth = p_params->pitch_modulation_depth;
+	audio_rate_modulation = p_params->audio_rate_modulation;
 	envelope_frequency_ratio = p_params->envelope_frequency_ratio;
 
 	for (int i = 1; i < SiOPMSoundChip::STREAM_SEND_SIZE; i++) {
@@ -368,6 +382,83 @@ void SiOPMChannelParams::copy_from(const Ref<SiOPMChannelParams> &p_params) {
 	}
 
 	init_sequence->clear();
+	revision++;
+}
+
+// Voice program.
+
+static_assert(SiOPMChannelProgram::MAX_OPERATORS == SiOPMChannelParams::MAX_OPERATORS, "Program and params must agree on the operator count.");
+static_assert(SiOPMChannelProgram::MAX_STREAM_SENDS == SiOPMSoundChip::STREAM_SEND_SIZE, "Program and sound chip must agree on the stream send count.");
+
+bool SiOPMChannelParams::_is_program_current() const {
+	if (program_revision != revision) {
+		return false;
+	}
+
+	// Operator params are exposed on their own and can be edited without touching this object.
+	for (int i = 0; i < MAX_OPERATORS; i++) {
+		if (program_operator_revisions[i] != operator_params[i]->get_revision()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void SiOPMChannelParams::compile_program() {
+	program.operator_count = operator_count;
+	program.analog_like = analog_like;
+	program.algorithm = algorithm;
+	program.feedback = feedback;
+	program.feedback_connection = feedback_connection;
+	program.envelope_frequency_ratio = envelope_frequency_ratio;
+
+	program.lfo_wave_shape = lfo_wave_shape;
+	program.lfo_time_mode = lfo_time_mode;
+	switch (lfo_time_mode) {
+		case 0:  program.lfo_frequency_step = lfo_rate_value; break;
+		case 1:  program.lfo_frequency_step = lfo_time_value; break;
+		default: program.lfo_frequency_step = lfo_beat_division; break;
+	}
+	program.amplitude_modulation_depth = amplitude_modulation_depth;
+	program.pitch_modulation_depth = pitch_modulation_depth;
+	program.audio_rate_modulation = audio_rate_modulation;
+
+	program.has_effect_send = false;
+	for (int i = 0; i < SiOPMSoundChip::STREAM_SEND_SIZE; i++) {
+		program.master_volumes[i] = master_volumes[i];
+		if (i > 0 && master_volumes[i] > 0) {
+			program.has_effect_send = true;
+		}
+	}
+	program.pan = pan;
+	program.instrument_gain_db = instrument_gain_db;
+
+	program.filter_type = filter_type;
+	program.filter_cutoff = filter_cutoff;
+	program.filter_resonance = filter_resonance;
+	program.filter_attack_rate = filter_attack_rate;
+	program.filter_decay_rate1 = filter_decay_rate1;
+	program.filter_decay_rate2 = filter_decay_rate2;
+	program.filter_release_rate = filter_release_rate;
+	program.filter_decay_offset1 = filter_decay_offset1;
+	program.filter_decay_offset2 = filter_decay_offset2;
+	program.filter_sustain_offset = filter_sustain_offset;
+	program.filter_release_offset = filter_release_offset;
+
+	for (int i = 0; i < MAX_OPERATORS; i++) {
+		const SiOPMOperatorParams *op_params = operator_params[i].ptr();
+		op_params->compile_program(program.operators[i]);
+		program_operator_revisions[i] = op_params->get_revision();
+	}
+
+	program_revision = revision;
+}
+
+const SiOPMChannelProgram &SiOPMChannelParams::get_program() {
+	if (!_is_program_current()) {
+		compile_program();
+	}
+	return program;
 }
 
 String SiOPMChannelParams::_to_string() const {
@@ -430,6 +521,8 @@ void SiOPMChannelParams::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_amplitude_modulation_depth", "value"), &SiOPMChannelParams::set_amplitude_modulation_depth);
 	ClassDB::bind_method(D_METHOD("get_pitch_modulation_depth"), &SiOPMChannelParams::get_pitch_modulation_depth);
 	ClassDB::bind_method(D_METHOD("set_pitch_modulation_depth", "value"), &SiOPMChannelParams::set_pitch_modulation_depth);
+	ClassDB::bind_method(D_METHOD("is_audio_rate_modulation"), &SiOPMChannelParams::is_audio_rate_modulation);
+	ClassDB::bind_method(D_METHOD("set_audio_rate_modulation", "enabled"), &SiOPMChannelParams::set_audio_rate_modulation);
 
 	ClassDB::bind_method(D_METHOD("get_master_volume", "index"), &SiOPMChannelParams::get_master_volume);
 	ClassDB::bind_method(D_METHOD("set_master_volume", "index", "value"), &SiOPMChannelParams::set_master_volume);
@@ -481,6 +574,7 @@ void SiOPMChannelParams::_bind_methods() {
 
 	ClassDB::add_property("SiOPMChannelParams", PropertyInfo(Variant::INT, "amplitude_modulation_depth"), "set_amplitude_modulation_depth", "get_amplitude_modulation_depth");
 	ClassDB::add_property("SiOPMChannelParams", PropertyInfo(Variant::INT, "pitch_modulation_depth"), "set_pitch_modulation_depth", "get_pitch_modulation_depth");
+	ClassDB::add_property("SiOPMChannelParams", PropertyInfo(Variant::BOOL, "audio_rate_modulation"), "set_audio_rate_modulation", "is_audio_rate_modulation");
 
 	ClassDB::add_property("SiOPMChannelParams", PropertyInfo(Variant::INT, "instrument_gain_db"), "set_instrument_gain_db", "get_instrument_gain_db");
 	ClassDB::add_property("SiOPMChannelParams", PropertyInfo(Variant::INT, "pan"), "set_pan", "get_pan");
@@ -11,11 +11,13 @@
 #include <godot_cpp/templates/vector.hpp>
 #include <godot_cpp/variant/string.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
+#include "chip/siopm_voice_program.h"
 
 using namespace godot;
 
 class MMLSequence;
 class SiOPMOperatorParams;
+class SiOPMRefTable;
 
 // Channel parameters for SiONVoice.
 class SiOPMChannelParams : public RefCounted {
@@ -58,6 +60,8 @@ private:
 
 	int amplitude_modulation_depth = 0;
 	int pitch_modulation_depth = 0;
+	// Keep LFO and envelopes at audio rate even when the chip runs them at control rate.
+	bool audio_rate_modulation = false;
 	Vector<double> master_volumes;
 	int instrument_gain_db = 0;
 	int pan = 0;
@@ -81,6 +85,14 @@ private:
 	int amplitude_sustain_level = 128;
 	int amplitude_release_rate = 0;
 
+	// Bumped by every change, so the compiled program can tell when it's stale.
+	uint32_t revision = 1;
+	SiOPMChannelProgram program;
+	uint32_t program_revision = 0;
+	uint32_t program_operator_revisions[MAX_OPERATORS] = {};
+
+	bool _is_program_current() const;
+
 protected:
 	static void _bind_methods();
 
@@ -93,21 +105,21 @@ public:
 	int get_operator_count() const { return operator_count; }
 	void set_operator_count(int p_value);
 	bool is_analog_like() const { return analog_like; }
-	void set_analog_like(bool p_value) { analog_like = p_value; }
+	void set_analog_like(bool p_value) { analog_like = p_value; revision++; }
 
 	int get_algorithm() const { return algorithm; }
 	void set_algorithm(int p_value);
 	int get_feedback() const { return feedback; }
-	void set_feedback(int p_value) { feedback = p_value; }
+	void set_feedback(int p_value) { feedback = p_value; revision++; }
 	int get_feedback_connection() const { return feedback_connection; }
-	void set_feedback_connection(int p_value) { feedback_connection = p_value; }
+	void set_feedback_connection(int p_value) { feedback_connection = p_value; revision++; }
 	int get_envelope_frequency_ratio() const { return envelope_frequency_ratio; }
-	void set_envelope_frequency_ratio(int p_value) { envelope_frequency_ratio = p_value; }
+	void set_envelope_frequency_ratio(int p_value) { envelope_frequency_ratio = p_value; revision++; }
 
 	int get_lfo_wave_shape() const { return lfo_wave_shape; }
-	void set_lfo_wave_shape(int p_value) { lfo_wave_shape = p_value; }
+	void set_lfo_wave_shape(int p_value) { lfo_wave_shape = p_value; revision++; }
 	int get_lfo_frequency_step() const { return lfo_frequency_step; }
-	void set_lfo_frequency_step(int p_value) { lfo_frequency_step = p_value; }
+	void set_lfo_frequency_step(int p_value) { lfo_frequency_step = p_value; revision++; }
 	int get_lfo_time_mode() const { return lfo_time_mode; }
 	void set_lfo_time_mode(int p_value);
 
@@ -122,55 +134,57 @@ public:
 	void set_lfo_beat_value(int p_value);
 
 	int get_amplitude_modulation_depth() const { return amplitude_modulation_depth; }
-	void set_amplitude_modulation_depth(int p_value) { amplitude_modulation_depth = p_value; }
+	void set_amplitude_modulation_depth(int p_value) { amplitude_modulation_depth = p_value; revision++; }
 	bool has_amplitude_modulation() const;
 	int get_pitch_modulation_depth() const { return pitch_modulation_depth; }
-	void set_pitch_modulation_depth(int p_value) { pitch_modulation_depth = p_value; }
+	void set_pitch_modulation_depth(int p_value) { pitch_modulation_depth = p_value; revision++; }
 	bool has_pitch_modulation() const;
+	bool is_audio_rate_modulation() const { return audio_rate_modulation; }
+	void set_audio_rate_modulation(bool p_enabled) { audio_rate_modulation = p_enabled; revision++; }
 
 	double get_master_volume(int p_index) const;
 	void set_master_volume(int p_index, double p_value);
 	int get_instrument_gain_db() const { return instrument_gain_db; }
-	void set_instrument_gain_db(int p_value) { instrument_gain_db = p_value; }
+	void set_instrument_gain_db(int p_value) { instrument_gain_db = p_value; revision++; }
 
 	int get_pan() const { return pan; }
-	void set_pan(int p_value) { pan = p_value; }
+	void set_pan(int p_value) { pan = p_value; revision++; }
 
 	// Carriers vs modulators mask accessor
 	PackedInt32Array get_carrier_mask() const { return carrier_mask; }
 	void set_carrier_mask(const PackedInt32Array &p_mask) { carrier_mask = p_mask; }
 
 	int get_filter_type() const { return filter_type; }
-	void set_filter_type(int p_value) { filter_type = p_value; }
+	void set_filter_type(int p_value) { filter_type = p_value; revision++; }
 	int get_filter_cutoff() const { return filter_cutoff; }
-	void set_filter_cutoff(int p_value) { filter_cutoff = p_value; }
+	void set_filter_cutoff(int p_value) { filter_cutoff = p_value; revision++; }
 	int get_filter_resonance() const { return filter_resonance; }
-	void set_filter_resonance(int p_value) { filter_resonance = p_value; }
+	void set_filter_resonance(int p_value) { filter_resonance = p_value; revision++; }
 	int get_filter_attack_rate() const { return filter_attack_rate; }
-	void set_filter_attack_rate(int p_value) { filter_attack_rate = p_value; }
+	void set_filter_attack_rate(int p_value) { filter_attack_rate = p_value; revision++; }
 	int get_filter_decay_rate1() const { return filter_decay_rate1; }
-	void set_filter_decay_rate1(int p_value) { filter_decay_rate1 = p_value; }
+	void set_filter_decay_rate1(int p_value) { filter_decay_rate1 = p_value; revision++; }
 	int get_filter_decay_rate2() const { return filter_decay_rate2; }
-	void set_filter_decay_rate2(int p_value) { filter_decay_rate2 = p_value; }
+	void set_filter_decay_rate2(int p_value) { filter_decay_rate2 = p_value; revision++; }
 	int get_filter_release_rate() const { return filter_release_rate; }
-	void set_filter_release_rate(int p_value) { filter_release_rate = p_value; }
+	void set_filter_release_rate(int p_value) { filter_release_rate = p_value; revision++; }
 	int get_filter_decay_offset1() const { return filter_decay_offset1; }
-	void set_filter_decay_offset1(int p_value) { filter_decay_offset1 = p_value; }
+	void set_filter_decay_offset1(int p_value) { filter_decay_offset1 = p_value; revision++; }
 	int get_filter_decay_offset2() const { return filter_decay_offset2; }
-	void set_filter_decay_offset2(int p_value) { filter_decay_offset2 = p_value; }
+	void set_filter_decay_offset2(int p_value) { filter_decay_offset2 = p_value; revision++; }
 	int get_filter_sustain_offset() const { return filter_sustain_offset; }
-	void set_filter_sustain_offset(int p_value) { filter_sustain_offset = p_value; }
+	void set_filter_sustain_offset(int p_value) { filter_sustain_offset = p_value; revision++; }
 	int get_filter_release_offset() const { return filter_release_offset; }
-	void set_filter_release_offset(int p_value) { filter_release_offset = p_value; }
+	void set_filter_release_offset(int p_value) { filter_release_offset = p_value; revision++; }
 
 	int get_amplitude_attack_rate() const { return amplitude_attack_rate; }
-	void set_amplitude_attack_rate(int p_value) { amplitude_attack_rate = p_value; }
+	void set_amplitude_attack_rate(int p_value) { amplitude_attack_rate = p_value; revision++; }
 	int get_amplitude_decay_rate() const { return amplitude_decay_rate; }
-	void set_amplitude_decay_rate(int p_value) { amplitude_decay_rate = p_value; }
+	void set_amplitude_decay_rate(int p_value) { amplitude_decay_rate = p_value; revision++; }
 	int get_amplitude_sustain_level() const { return amplitude_sustain_level; }
-	void set_amplitude_sustain_level(int p_value) { amplitude_sustain_level = p_value; }
+	void set_amplitude_sustain_level(int p_value) { amplitude_sustain_level = p_value; revision++; }
 	int get_amplitude_release_rate() const { return amplitude_release_rate; }
-	void set_amplitude_release_rate(int p_value) { amplitude_release_rate = p_value; }
+	void set_amplitude_release_rate(int p_value) { amplitude_release_rate = p_value; revision++; }
 
 	bool has_filter() const;
 	bool has_filter_advanced() const;
@@ -178,11 +192,21 @@ public:
 	int get_lfo_frame() const;
 	void set_lfo_frame(int p_fps);
 
-	void set_by_opm_register(int p_channel, int p_address, int p_data);
+	// p_table is the ref table of the driver that plays these params, the LFO rate depends on it.
+	void set_by_opm_register(int p_channel, int p_address, int p_data, const SiOPMRefTable *p_table = nullptr);
 
 	void initialize();
 	void copy_from(const Ref<SiOPMChannelParams> &p_params);
 
+	// Call after writing fields directly instead of through setters.
+	void mark_changed() { revision++; }
+
+	// Rebuild the flat program from the current values. Meant for the main thread, when
+	// the voice is set up, so the audio thread finds it ready.
+	void compile_program();
+	// The program for the current values, compiled first if anything changed since.
+	const SiOPMChannelProgram &get_program();
+
 	SiOPMChannelParams();
 	~SiOPMChannelParams();
 };
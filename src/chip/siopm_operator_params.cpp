@@ -12,6 +12,7 @@
 void SiOPMOperatorParams::set_pulse_generator_type(int p_type) {
 	pulse_generator_type = p_type & 511;
 	pitch_table_type = SiOPMRefTable::get_instance()->get_wave_table(pulse_generator_type)->get_default_pitch_table_type();
+	revision++;
 }
 
 int SiOPMOperatorParams::get_multiple() const {
@@ -20,6 +21,7 @@ int SiOPMOperatorParams::get_multiple() const {
 
 void SiOPMOperatorParams::set_multiple(int p_value) {
 	fine_multiple = (p_value == 0 ? 64 : (p_value << 7));
+	revision++;
 }
 
 void SiOPMOperatorParams::set_ssg_envelope_control(int p_value) {
@@ -30,6 +32,7 @@ void SiOPMOperatorParams::set_ssg_envelope_control(int p_value) {
 	} else {
 		ssg_envelope_control = p_value;
 	}
+	revision++;
 }
 
 void SiOPMOperatorParams::initialize() {
@@ -62,6 +65,8 @@ void SiOPMOperatorParams::initialize() {
 	super_count = 1;
 	super_spread = 40;
 	super_stereo_spread = 50;
+
+	revision++;
 }
 
 void SiOPMOperatorParams::copy_from(const Ref<SiOPMOperatorParams> &p_params) {
@@ -94,6 +99,39 @@ void SiOPMOperatorParams::copy_from(const Ref<SiOPMOperatorParams> &p_params) {
 	super_count  = p_params->super_count;
 	super_spread = p_params->super_spread;
 	super_stereo_spread = p_params->super_stereo_spread;
+
+	revision++;
+}
+
+void SiOPMOperatorParams::compile_program(SiOPMOperatorProgram &r_program) const {
+	r_program.pulse_generator_type = pulse_generator_type;
+	r_program.pitch_table_type     = pitch_table_type;
+
+	r_program.attack_rate   = attack_rate;
+	r_program.decay_rate    = decay_rate;
+	r_program.sustain_rate  = sustain_rate;
+	r_program.release_rate  = release_rate;
+	r_program.sustain_level = sustain_level;
+	r_program.total_level   = total_level;
+
+	r_program.key_scaling_rate  = key_scaling_rate;
+	r_program.key_scaling_level = key_scaling_level;
+	r_program.fine_multiple     = fine_multiple;
+	r_program.detune1           = detune1;
+	r_program.detune2           = detune2;
+
+	r_program.amplitude_modulation_shift = amplitude_modulation_shift;
+	r_program.initial_phase              = initial_phase;
+	r_program.fixed_pitch                = fixed_pitch;
+
+	r_program.mute                       = mute;
+	r_program.ssg_envelope_control       = ssg_envelope_control;
+	r_program.frequency_modulation_level = frequency_modulation_level;
+	r_program.envelope_reset_on_attack   = envelope_reset_on_attack;
+
+	r_program.super_count         = super_count;
+	r_program.super_spread        = super_spread;
+	r_program.super_stereo_spread = super_stereo_spread;
 }
 
 String SiOPMOperatorParams::_to_string() const {
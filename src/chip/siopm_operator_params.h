@@ -9,6 +9,7 @@
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/string.hpp>
+#include "chip/siopm_voice_program.h"
 #include "sion_enums.h"
 
 using namespace godot;
@@ -96,6 +97,9 @@ private:
 	// Stereo spread amount [0-100]. 0 = mono, 100 = full stereo spread.
 	int super_stereo_spread = 50;
 
+	// Bumped by every change, see SiOPMChannelParams::get_program().
+	uint32_t revision = 1;
+
 protected:
 	static void _bind_methods();
 
@@ -105,62 +109,68 @@ public:
 	int get_pulse_generator_type() const { return pulse_generator_type; }
 	void set_pulse_generator_type(int p_type);
 	SiONPitchTableType get_pitch_table_type() const { return pitch_table_type; }
-	void set_pitch_table_type(SiONPitchTableType p_type) { pitch_table_type = p_type; }
+	void set_pitch_table_type(SiONPitchTableType p_type) { pitch_table_type = p_type; revision++; }
 
 	int get_attack_rate() const { return attack_rate; }
-	void set_attack_rate(int p_value) { attack_rate = p_value; }
+	void set_attack_rate(int p_value) { attack_rate = p_value; revision++; }
 	int get_decay_rate() const { return decay_rate; }
-	void set_decay_rate(int p_value) { decay_rate = p_value; }
+	void set_decay_rate(int p_value) { decay_rate = p_value; revision++; }
 	int get_sustain_rate() const { return sustain_rate; }
-	void set_sustain_rate(int p_value) { sustain_rate = p_value; }
+	void set_sustain_rate(int p_value) { sustain_rate = p_value; revision++; }
 	int get_release_rate() const { return release_rate; }
-	void set_release_rate(int p_value) { release_rate = p_value; }
+	void set_release_rate(int p_value) { release_rate = p_value; revision++; }
 	int get_sustain_level() const { return sustain_level; }
-	void set_sustain_level(int p_value) { sustain_level = p_value; }
+	void set_sustain_level(int p_value) { sustain_level = p_value; revision++; }
 	int get_total_level() const { return total_level; }
-	void set_total_level(int p_value) { total_level = p_value; }
+	void set_total_level(int p_value) { total_level = p_value; revision++; }
 
 	int get_key_scaling_rate() const { return key_scaling_rate; }
-	void set_key_scaling_rate(int p_value) { key_scaling_rate = p_value; }
+	void set_key_scaling_rate(int p_value) { key_scaling_rate = p_value; revision++; }
 	int get_key_scaling_level() const { return key_scaling_level; }
-	void set_key_scaling_level(int p_value) { key_scaling_level = p_value; }
+	void set_key_scaling_level(int p_value) { key_scaling_level = p_value; revision++; }
 
 	int get_fine_multiple() const { return fine_multiple; }
-	void set_fine_multiple(int p_value) { fine_multiple = p_value; }
+	void set_fine_multiple(int p_value) { fine_multiple = p_value; revision++; }
 	// Multiple [0,15]
 	int get_multiple() const;
 	void set_multiple(int p_value);
 	int get_detune1() const { return detune1; }
-	void set_detune1(int p_value) { detune1 = p_value; }
+	void set_detune1(int p_value) { detune1 = p_value; revision++; }
 	int get_detune2() const { return detune2; }
-	void set_detune2(int p_value) { detune2 = p_value; }
+	void set_detune2(int p_value) { detune2 = p_value; revision++; }
 
 	int get_amplitude_modulation_shift() const { return amplitude_modulation_shift; }
-	void set_amplitude_modulation_shift(int p_value) { amplitude_modulation_shift = p_value; }
+	void set_amplitude_modulation_shift(int p_value) { amplitude_modulation_shift = p_value; revision++; }
 	int get_initial_phase() const { return initial_phase; }
-	void set_initial_phase(int p_value) { initial_phase = p_value; }
+	void set_initial_phase(int p_value) { initial_phase = p_value; revision++; }
 	int get_fixed_pitch() const { return fixed_pitch; }
-	void set_fixed_pitch(int p_value) { fixed_pitch = p_value; }
+	void set_fixed_pitch(int p_value) { fixed_pitch = p_value; revision++; }
 
 	bool get_mute() const { return mute; }
-	void set_mute(bool p_mute) { mute = p_mute; }
+	void set_mute(bool p_mute) { mute = p_mute; revision++; }
 	int get_ssg_envelope_control() const { return ssg_envelope_control; }
 	void set_ssg_envelope_control(int p_value);
 	int get_frequency_modulation_level() const { return frequency_modulation_level; }
-	void set_frequency_modulation_level(int p_value) { frequency_modulation_level = p_value; }
+	void set_frequency_modulation_level(int p_value) { frequency_modulation_level = p_value; revision++; }
 	bool get_envelope_reset_on_attack() const { return envelope_reset_on_attack; }
-	void set_envelope_reset_on_attack(bool p_reset) { envelope_reset_on_attack = p_reset; }
+	void set_envelope_reset_on_attack(bool p_reset) { envelope_reset_on_attack = p_reset; revision++; }
 
 	int get_super_count() const { return super_count; }
-	void set_super_count(int p_value) { super_count = (p_value < 1) ? 1 : ((p_value > 16) ? 16 : p_value); }
+	void set_super_count(int p_value) { super_count = (p_value < 1) ? 1 : ((p_value > 16) ? 16 : p_value); revision++; }
 	int get_super_spread() const { return super_spread; }
-	void set_super_spread(int p_value) { super_spread = (p_value < 0) ? 0 : ((p_value > 1000) ? 1000 : p_value); }
+	void set_super_spread(int p_value) { super_spread = (p_value < 0) ? 0 : ((p_value > 1000) ? 1000 : p_value); revision++; }
 	int get_super_stereo_spread() const { return super_stereo_spread; }
-	void set_super_stereo_spread(int p_value) { super_stereo_spread = (p_value < 0) ? 0 : ((p_value > 100) ? 100 : p_value); }
+	void set_super_stereo_spread(int p_value) { super_stereo_spread = (p_value < 0) ? 0 : ((p_value > 100) ? 100 : p_value); revision++; }
 
 	void initialize();
 	void copy_from(const Ref<SiOPMOperatorParams> &p_params);
 
+	// Call after writing fields directly instead of through setters.
+	void mark_changed() { revision++; }
+	uint32_t get_revision() const { return revision; }
+
+	void compile_program(SiOPMOperatorProgram &r_program) const;
+
 	SiOPMOperatorParams();
 	~SiOPMOperatorParams() {}
 };
@@ -0,0 +1,37 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SIOPM_REF_STENCIL_H
+#define SIOPM_REF_STENCIL_H
+
+#include <godot_cpp/templates/vector.hpp>
+
+using namespace godot;
+
+class SiMMLEnvelopeTable;
+class SiMMLVoice;
+class SiOPMWaveSamplerTable;
+class SiOPMWaveTable;
+
+// Lookup context with the tables defined by a piece of sequence data (SiMMLData).
+// Entries set here take precedence over the global ones in SiOPMRefTable and
+// SiMMLRefTable. Tracks hand the stencil of their data down to their channel, and
+// lookups made on their behalf pass it along, so playing several pieces of data at
+// once never changes global state.
+//
+// The pointers refer to vectors owned by the data, which are allocated to their full
+// size once and never resized, so they stay valid for as long as the data lives.
+// Any of them can be null.
+struct SiOPMRefStencil {
+	const Vector<Ref<SiOPMWaveTable>> *custom_wave_tables = nullptr;
+	const Vector<Ref<SiMMLVoice>> *pcm_voices = nullptr;
+	const Vector<Ref<SiOPMWaveSamplerTable>> *sampler_tables = nullptr;
+
+	const Vector<Ref<SiMMLEnvelopeTable>> *envelope_tables = nullptr;
+	const Vector<Ref<SiMMLVoice>> *voices = nullptr;
+};
+
+#endif // SIOPM_REF_STENCIL_H
@@ -17,6 +17,8 @@
 using namespace godot;
 
 SiOPMRefTable *SiOPMRefTable::_instance = nullptr;
+SiOPMRefTable::CoreTables *SiOPMRefTable::_core_tables = nullptr;
+SiOPMRefTable::SoundBank *SiOPMRefTable::_sound_bank = nullptr;
 
 const double SiOPMRefTable::NOISE_WAVE_OUTPUT  = 1;
 const double SiOPMRefTable::SQUARE_WAVE_OUTPUT = 1;
@@ -24,7 +26,7 @@ const double SiOPMRefTable::OUTPUT_MAX         = 1.0;
 
 static int _resolve_initial_sampling_rate() {
     const int rate = SiONDriver::get_backend_sample_rate();
-    return rate > 0 ? rate : 48000; // AudioServer not ready yet, driver rebuild fixes later
+    return rate > 0 ? rate : 48000; // AudioServer not ready yet, drivers at another rate build their own tables
 }
 
 
@@ -40,10 +42,42 @@ void SiOPMRefTable::initialize() {
 }
 
 void SiOPMRefTable::finalize() {
+	// Instances owned by drivers must be released before this point, as they
+	// reference the shared tables.
 	if (_instance) {
 		memdelete(_instance);
 		_instance = nullptr;
 	}
+
+	if (_sound_bank) {
+		memdelete(_sound_bank);
+		_sound_bank = nullptr;
+	}
+	if (_core_tables) {
+		memdelete(_core_tables);
+		_core_tables = nullptr;
+	}
+}
+
+SiOPMRefTable::CoreTables *SiOPMRefTable::_get_core_tables() {
+	if (!_core_tables) {
+		_core_tables = memnew(CoreTables);
+		_core_tables->create_eg_tables();
+		_core_tables->create_pg_tables();
+		_core_tables->create_lfo_tables();
+		_core_tables->create_filter_tables();
+	}
+
+	return _core_tables;
+}
+
+SiOPMRefTable::SoundBank *SiOPMRefTable::_get_sound_bank() {
+	if (!_sound_bank) {
+		// Filled by the first instance, since wave samples are generated from the log table.
+		_sound_bank = memnew(SoundBank);
+	}
+
+	return _sound_bank;
 }
 
 //
@@ -68,6 +102,7 @@ void SiOPMRefTable::reset_all_user_tables() {
 	for (int i = 0; i < WAVE_TABLE_MAX; i++) {
 		_custom_wave_tables.write[i] = Ref<SiOPMWaveTable>();
 	}
+	_get_sound_bank()->wave_table_generation++;
 
 	for (int i = 0; i < PCM_DATA_MAX; i++) {
 		if (_pcm_voices[i].is_valid()) {
@@ -78,9 +113,6 @@ void SiOPMRefTable::reset_all_user_tables() {
 			_pcm_voices.write[i] = Ref<SiMMLVoice>();
 		}
 	}
-
-	_stencil_custom_wave_tables.clear();
-	_stencil_pcm_voices.clear();
 }
 
 void SiOPMRefTable::register_wave_table(int p_index, const Ref<SiOPMWaveTable> &p_table) {
@@ -93,21 +125,23 @@ void SiOPMRefTable::register_wave_table(int p_index, const Ref<SiOPMWaveTable> &
 		// User defined waves are at offsets 15,23,31.
 		wave_tables.write[SiONPulseGeneratorType::PULSE_MA3_SINE + 15 + index * 8] = p_table;
 	}
+	_get_sound_bank()->wave_table_generation++;
 }
 
 void SiOPMRefTable::register_scc_wave_table(int p_index, const Ref<SiOPMWaveTable> &p_table) {
 	int index = p_index & (WAVE_TABLE_MAX - 1);
 
 	// Persist in _custom_wave_tables so get_wave_table(PULSE_CUSTOM + index)
-	// works at runtime. The stencil is overwritten/cleared every audio buffer
-	// by SiMMLData (register_ref_stencils / clear_ref_stencils), so it cannot
-	// be relied upon for persistent engine wave tables. _custom_wave_tables is
+	// works at runtime. Stencils only apply to tracks playing the SiMMLData that
+	// defines them, so they cannot be relied upon for persistent engine wave
+	// tables. _custom_wave_tables is
 	// only cleared by reset_all_user_tables() which is not part of the normal
 	// playback lifecycle.
 	//
 	// NOTE: We write to _custom_wave_tables directly (not via register_wave_table)
 	// to avoid the MA-3 user-defined wave slot side effect in register_wave_table.
 	_custom_wave_tables.write[index] = p_table;
+	_get_sound_bank()->wave_table_generation++;
 }
 
 Ref<SiOPMWaveSamplerData> SiOPMRefTable::register_sampler_data(int p_index, const Variant &p_data, bool p_ignore_note_off, int p_pan, int p_src_channel_count, int p_channel_count) {
@@ -119,7 +153,7 @@ Ref<SiOPMWaveSamplerData> SiOPMRefTable::register_sampler_data(int p_index, cons
 	return sampler_data;
 }
 
-Ref<SiOPMWaveTable> SiOPMRefTable::get_wave_table(int p_index) {
+Ref<SiOPMWaveTable> SiOPMRefTable::get_wave_table(int p_index, const SiOPMRefStencil *p_stencil) {
 	if (p_index < SiONPulseGeneratorType::PULSE_CUSTOM) {
 		ERR_FAIL_INDEX_V(p_index, wave_tables.size(), no_wave_table);
 		return wave_tables[p_index];
@@ -127,8 +161,11 @@ Ref<SiOPMWaveTable> SiOPMRefTable::get_wave_table(int p_index) {
 	if (p_index < SiONPulseGeneratorType::PULSE_PCM) {
 		int table_index = p_index - SiONPulseGeneratorType::PULSE_CUSTOM;
 
-		if (table_index < _stencil_custom_wave_tables.size() && _stencil_custom_wave_tables[table_index].is_valid()) {
-			return _stencil_custom_wave_tables[table_index];
+		if (p_stencil && p_stencil->custom_wave_tables) {
+			const Vector<Ref<SiOPMWaveTable>> &stencil_tables = *p_stencil->custom_wave_tables;
+			if (table_index < stencil_tables.size() && stencil_tables[table_index].is_valid()) {
+				return stencil_tables[table_index];
+			}
 		}
 
 		if (table_index < _custom_wave_tables.size() && _custom_wave_tables[table_index].is_valid()) {
@@ -141,11 +178,14 @@ Ref<SiOPMWaveTable> SiOPMRefTable::get_wave_table(int p_index) {
 	return no_wave_table;
 }
 
-Ref<SiOPMWavePCMTable> SiOPMRefTable::get_pcm_data(int p_index) {
+Ref<SiOPMWavePCMTable> SiOPMRefTable::get_pcm_data(int p_index, const SiOPMRefStencil *p_stencil) {
 	int table_index = p_index & (PCM_DATA_MAX - 1);
 
-	if (table_index < _stencil_pcm_voices.size() && _stencil_pcm_voices[table_index].is_valid()) {
-		return _stencil_pcm_voices[table_index]->get_wave_data();
+	if (p_stencil && p_stencil->pcm_voices) {
+		const Vector<Ref<SiMMLVoice>> &stencil_voices = *p_stencil->pcm_voices;
+		if (table_index < stencil_voices.size() && stencil_voices[table_index].is_valid()) {
+			return stencil_voices[table_index]->get_wave_data();
+		}
 	}
 
 	if (table_index < _pcm_voices.size() && _pcm_voices[table_index].is_valid()) {
@@ -176,16 +216,20 @@ Ref<SiMMLVoice> SiOPMRefTable::set_global_pcm_voice(int p_index, const Ref<SiMML
 	return _pcm_voices[index];
 }
 
-void SiOPMRefTable::set_sampler_table_stencil(int p_index, const Ref<SiOPMWaveSamplerTable> &p_table) {
-	ERR_FAIL_INDEX(p_index, sampler_tables.size());
-
-	sampler_tables[p_index]->set_stencil(p_table);
-}
+const SiOPMWaveSamplerTable *SiOPMRefTable::get_sampler_table_stencil(const Ref<SiOPMWaveSamplerTable> &p_table, const SiOPMRefStencil *p_stencil) const {
+	if (!p_stencil || !p_stencil->sampler_tables || p_table.is_null()) {
+		return nullptr;
+	}
 
-void SiOPMRefTable::clear_sampler_table_stencil(int p_index) {
-	ERR_FAIL_INDEX(p_index, sampler_tables.size());
+	const Vector<Ref<SiOPMWaveSamplerTable>> &stencil_tables = *p_stencil->sampler_tables;
+	int bank_count = MIN(sampler_tables.size(), stencil_tables.size());
+	for (int i = 0; i < bank_count; i++) {
+		if (sampler_tables[i] == p_table) {
+			return stencil_tables[i].ptr();
+		}
+	}
 
-	sampler_tables[p_index]->set_stencil(nullptr);
+	return nullptr;
 }
 
 //
@@ -200,27 +244,35 @@ void SiOPMRefTable::_set_constants(int p_fm_clock, double p_psg_clock, int p_sam
 }
 
 void SiOPMRefTable::_create_eg_tables() {
-	// Table selector & timer steps for rates.
+	// Timer steps for rates.
 	{
 		int i = 0;
 		for (; i < 44; i++) { // rate = 0-43
-			eg_timer_steps   [i] = int((1<<(i>>2)) * clock_ratio);
-			eg_table_selector[i] = (i & 3);
+			eg_timer_steps[i] = int((1<<(i>>2)) * clock_ratio);
 		}
-		for (; i < 48; i++) { // rate = 44-47
-			eg_timer_steps   [i] = int(2047 * clock_ratio);
+		for (; i < 96; i++) { // rate = 44-95
+			eg_timer_steps[i] = int(2047 * clock_ratio);
+		}
+		for (; i < 128; i++) { // rate = 96-127 (dummies for ar,dr,sr=0)
+			eg_timer_steps[i] = 0;
+		}
+	}
+}
+
+void SiOPMRefTable::CoreTables::create_eg_tables() {
+	// Table selector for rates.
+	{
+		int i = 0;
+		for (; i < 48; i++) { // rate = 0-47
 			eg_table_selector[i] = (i & 3);
 		}
 		for (; i < 60; i++) { // rate = 48-59
-			eg_timer_steps   [i] = int(2047 * clock_ratio);
 			eg_table_selector[i] = i - 44;
 		}
 		for (; i < 96; i++) { // rate = 60-95 (rate=60-95 are same as rate=63(maximum))
-			eg_timer_steps   [i] = int(2047 * clock_ratio);
 			eg_table_selector[i] = 16;
 		}
 		for (; i < 128; i++) { // rate = 96-127 (dummies for ar,dr,sr=0)
-			eg_timer_steps   [i] = 0;
 			eg_table_selector[i] = 17;
 		}
 	}
@@ -305,17 +357,6 @@ void SiOPMRefTable::_create_eg_tables() {
 }
 
 void SiOPMRefTable::_create_pg_tables() {
-	// MIDI Note Number -> Key Code table
-	for (int i = 0, j = 0; j < NOTE_TABLE_SIZE; i++, j = i - (i >> 2)) {
-		if (i < 16) {
-			note_number_to_key_code[j] = i;
-		} else if (i < KEY_CODE_TABLE_SIZE) {
-			note_number_to_key_code[j] = i - 16;
-		} else {
-			note_number_to_key_code[j] = KEY_CODE_TABLE_SIZE - 1;
-		}
-	}
-
 	pitch_table.resize_zeroed(SiONPitchTableType::PITCH_TABLE_MAX);
 
 	// Pitch table.
@@ -538,6 +579,19 @@ void SiOPMRefTable::_create_pg_tables() {
 			}
 		}
 	}
+}
+
+void SiOPMRefTable::CoreTables::create_pg_tables() {
+	// MIDI Note Number -> Key Code table
+	for (int i = 0, j = 0; j < NOTE_TABLE_SIZE; i++, j = i - (i >> 2)) {
+		if (i < 16) {
+			note_number_to_key_code[j] = i;
+		} else if (i < KEY_CODE_TABLE_SIZE) {
+			note_number_to_key_code[j] = i - 16;
+		} else {
+			note_number_to_key_code[j] = KEY_CODE_TABLE_SIZE - 1;
+		}
+	}
 
 	// Log table.
 	{
@@ -1220,7 +1274,9 @@ void SiOPMRefTable::_create_lfo_tables() {
 		int s = 15 - (i >> 4);  // log-scale shift for 4HSBs
 		lfo_timer_steps[i] = ((t << (LFO_FIXED_BITS - 4)) * clock_ratio / (8 << s)) >> CLOCK_RATIO_BITS; // 4 from fmgen, 8 from x68sound.
 	}
+}
 
+void SiOPMRefTable::CoreTables::create_lfo_tables() {
 	// Wave tables.
 	{
 		// Saw wave.
@@ -1287,7 +1343,7 @@ void SiOPMRefTable::_create_lfo_tables() {
 	}
 }
 
-void SiOPMRefTable::_create_filter_tables() {
+void SiOPMRefTable::CoreTables::create_filter_tables() {
 	for (int i = 0; i < 128; i++) {
 		filter_cutoff_table[i] = i * i * 0.00006103515625; // 0.00006103515625 = 1/(128*128)
 		filter_feedback_table[i] = 1.0 + 1.0 / (1.0 - filter_cutoff_table[i]); // ???
@@ -1306,7 +1362,32 @@ void SiOPMRefTable::_create_filter_tables() {
 	}
 }
 
-SiOPMRefTable::SiOPMRefTable(int p_fm_clock, double p_psg_clock, int p_sampling_rate) {
+SiOPMRefTable::SiOPMRefTable(int p_fm_clock, double p_psg_clock, int p_sampling_rate) :
+		_custom_wave_tables(_get_sound_bank()->custom_wave_tables),
+		_pcm_voices(_get_sound_bank()->pcm_voices),
+		eg_increment_tables(_get_core_tables()->eg_increment_tables),
+		eg_increment_tables_attack(_get_core_tables()->eg_increment_tables_attack),
+		eg_table_selector(_get_core_tables()->eg_table_selector),
+		eg_level_tables(_get_core_tables()->eg_level_tables),
+		eg_ssg_table_index(_get_core_tables()->eg_ssg_table_index),
+		eg_sustain_level_table(_get_core_tables()->eg_sustain_level_table),
+		eg_total_level_tables(_get_core_tables()->eg_total_level_tables),
+		eg_linear_to_total_level_table(_get_core_tables()->eg_linear_to_total_level_table),
+		pan_table(_get_core_tables()->pan_table),
+		lfo_wave_tables(_get_core_tables()->lfo_wave_tables),
+		lfo_chorus_tables(_get_core_tables()->lfo_chorus_tables),
+		filter_cutoff_table(_get_core_tables()->filter_cutoff_table),
+		filter_feedback_table(_get_core_tables()->filter_feedback_table),
+		filter_eg_rate(_get_core_tables()->filter_eg_rate),
+		note_number_to_key_code(_get_core_tables()->note_number_to_key_code),
+		sound_reference(_get_sound_bank()->sound_reference),
+		dt2_table(_get_core_tables()->dt2_table),
+		log_table(_get_core_tables()->log_table),
+		wave_tables(_get_sound_bank()->wave_tables),
+		no_wave_table(_get_sound_bank()->no_wave_table),
+		no_wave_table_opm(_get_sound_bank()->no_wave_table_opm),
+		sampler_tables(_get_sound_bank()->sampler_tables),
+		wave_table_generation(_get_sound_bank()->wave_table_generation) {
 	if (!_instance) {
 		_instance = this; // Do this early so it can be self-referenced.
 	}
@@ -1315,17 +1396,15 @@ SiOPMRefTable::SiOPMRefTable(int p_fm_clock, double p_psg_clock, int p_sampling_
 
 	_create_eg_tables();
 	_create_pg_tables();
-	_create_wave_samples();
 	_create_lfo_tables();
-	_create_filter_tables();
+
+	if (!_sound_bank->is_ready) {
+		_create_wave_samples();
+		_sound_bank->is_ready = true;
+	}
 }
 
 SiOPMRefTable::~SiOPMRefTable() {
-	wave_tables.clear();
-	sampler_tables.clear();
-	_custom_wave_tables.clear();
-	_stencil_custom_wave_tables.clear();
-
-	_pcm_voices.clear();
-	_stencil_pcm_voices.clear();
+	// Shared tables are released in finalize().
+	pitch_table.clear();
 }
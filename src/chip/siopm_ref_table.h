@@ -12,6 +12,7 @@
 #include <godot_cpp/templates/vector.hpp>
 #include <godot_cpp/variant/variant.hpp>
 #include "sion_enums.h"
+#include "chip/siopm_ref_stencil.h"
 #include "chip/wave/siopm_wave_pcm_table.h"
 #include "chip/wave/siopm_wave_sampler_data.h"
 #include "chip/wave/siopm_wave_sampler_table.h"
@@ -28,13 +29,9 @@ class SiOPMRefTable {
 	// Wave samples.
 
 	// Custom wave tables.
-	Vector<Ref<SiOPMWaveTable>> _custom_wave_tables;
-	// Overriding custom wave tables.
-	Vector<Ref<SiOPMWaveTable>> _stencil_custom_wave_tables;
+	Vector<Ref<SiOPMWaveTable>> &_custom_wave_tables;
 	// PCM voices.
-	Vector<Ref<SiMMLVoice>> _pcm_voices;
-	// Overriding PCM voices.
-	Vector<Ref<SiMMLVoice>> _stencil_pcm_voices;
+	Vector<Ref<SiMMLVoice>> &_pcm_voices;
 
 	//
 
@@ -45,7 +42,6 @@ class SiOPMRefTable {
 	void _create_wave_samples();
 	void _create_ma3_waveset(int p_index, const Ref<SiOPMWaveTable> &p_table);
 	void _create_lfo_tables();
-	void _create_filter_tables();
 
 public:
 	static SiOPMRefTable *get_instance() { return _instance; }
@@ -132,8 +128,144 @@ public:
 		LFO_WAVE_MAX             = 12 // Total count of LFO wave shapes (0-11)
 	};
 
+	// Rate-independent tables. They are built once on first use and shared read-only
+	// by every instance, so a table for another sampling rate only has to build the
+	// pitch, timer and detune tables below.
+	struct CoreTables {
+		// Envelope generator.
+
+		// EG increment table. This table is based on MAME's opm emulation.
+		int eg_increment_tables[18][8] = {
+			/*cycle:      0 1  2 3  4 5  6 7  */
+			/* 0*/      { 0,1, 0,1, 0,1, 0,1 },  /* rates 00..11 0 (increment by 0 or 1) */
+			/* 1*/      { 0,1, 0,1, 1,1, 0,1 },  /* rates 00..11 1 */
+			/* 2*/      { 0,1, 1,1, 0,1, 1,1 },  /* rates 00..11 2 */
+			/* 3*/      { 0,1, 1,1, 1,1, 1,1 },  /* rates 00..11 3 */
+			/* 4*/      { 1,1, 1,1, 1,1, 1,1 },  /* rate 12 0 (increment by 1) */
+			/* 5*/      { 1,1, 1,2, 1,1, 1,2 },  /* rate 12 1 */
+			/* 6*/      { 1,2, 1,2, 1,2, 1,2 },  /* rate 12 2 */
+			/* 7*/      { 1,2, 2,2, 1,2, 2,2 },  /* rate 12 3 */
+			/* 8*/      { 2,2, 2,2, 2,2, 2,2 },  /* rate 13 0 (increment by 2) */
+			/* 9*/      { 2,2, 2,4, 2,2, 2,4 },  /* rate 13 1 */
+			/*10*/      { 2,4, 2,4, 2,4, 2,4 },  /* rate 13 2 */
+			/*11*/      { 2,4, 4,4, 2,4, 4,4 },  /* rate 13 3 */
+			/*12*/      { 4,4, 4,4, 4,4, 4,4 },  /* rate 14 0 (increment by 4) */
+			/*13*/      { 4,4, 4,8, 4,4, 4,8 },  /* rate 14 1 */
+			/*14*/      { 4,8, 4,8, 4,8, 4,8 },  /* rate 14 2 */
+			/*15*/      { 4,8, 8,8, 4,8, 8,8 },  /* rate 14 3 */
+			/*16*/      { 8,8, 8,8, 8,8, 8,8 },  /* rates 15 0, 15 1, 15 2, 15 3 (increment by 8) */
+			/*17*/      { 0,0, 0,0, 0,0, 0,0 }   /* infinity rates for attack and decay(s) */
+		};
+		// EG increment table for attack. This table is based on fmgen (shift=0 means x0).
+		int eg_increment_tables_attack[18][8] = {
+			/*cycle:      0 1  2 3  4 5  6 7  */
+			/* 0*/      { 0,4, 0,4, 0,4, 0,4 },  /* rates 00..11 0 (increment by 0 or 1) */
+			/* 1*/      { 0,4, 0,4, 4,4, 0,4 },  /* rates 00..11 1 */
+			/* 2*/      { 0,4, 4,4, 0,4, 4,4 },  /* rates 00..11 2 */
+			/* 3*/      { 0,4, 4,4, 4,4, 4,4 },  /* rates 00..11 3 */
+			/* 4*/      { 4,4, 4,4, 4,4, 4,4 },  /* rate 12 0 (increment by 1) */
+			/* 5*/      { 4,4, 4,3, 4,4, 4,3 },  /* rate 12 1 */
+			/* 6*/      { 4,3, 4,3, 4,3, 4,3 },  /* rate 12 2 */
+			/* 7*/      { 4,3, 3,3, 4,3, 3,3 },  /* rate 12 3 */
+			/* 8*/      { 3,3, 3,3, 3,3, 3,3 },  /* rate 13 0 (increment by 2) */
+			/* 9*/      { 3,3, 3,2, 3,3, 3,2 },  /* rate 13 1 */
+			/*10*/      { 3,2, 3,2, 3,2, 3,2 },  /* rate 13 2 */
+			/*11*/      { 3,2, 2,2, 3,2, 2,2 },  /* rate 13 3 */
+			/*12*/      { 2,2, 2,2, 2,2, 2,2 },  /* rate 14 0 (increment by 4) */
+			/*13*/      { 2,2, 2,1, 2,2, 2,1 },  /* rate 14 1 */
+			/*14*/      { 2,8, 2,1, 2,1, 2,1 },  /* rate 14 2 */
+			/*15*/      { 2,1, 1,1, 2,1, 1,1 },  /* rate 14 3 */
+			/*16*/      { 1,1, 1,1, 1,1, 1,1 },  /* rates 15 0, 15 1, 15 2, 15 3 (increment by 8) */
+			/*17*/      { 0,0, 0,0, 0,0, 0,0 }   /* infinity rates for attack and decay(s) */
+		};
+		// EG table selector. 128 = 64 rates + 32 ks-rates + 32 dummies for dr,sr=0
+		int eg_table_selector[128];
+		// EG table to calculate EG level tables.
+		int eg_level_tables[7][1 << ENV_BITS];
+		// EG table for SSG-type to EG level tables index. 10 = 8 standard + 2 extra.
+		int eg_ssg_table_index[10][2][3] = {
+			// [w/ ar], [w/o ar]
+			{  {3,3,3}, {1,3,3}  },   // ssgec=8
+			{  {1,6,6}, {1,6,6}  },   // ssgec=9
+			{  {2,1,2}, {1,2,1}  },   // ssgec=10
+			{  {2,5,5}, {1,5,5}  },   // ssgec=11
+			{  {4,4,4}, {2,4,4}  },   // ssgec=12
+			{  {2,5,5}, {2,5,5}  },   // ssgec=13
+			{  {1,2,1}, {2,1,2}  },   // ssgec=14
+			{  {1,6,6}, {2,6,6}  },   // ssgec=15
+
+			{  {1,1,1}, {1,1,1}  },   // ssgec=16
+			{  {2,2,2}, {2,2,2}  }    // ssgec=17
+		};
+		// EG sustain level table from 15 to 1024.
+		int eg_sustain_level_table[16];
+		// EG total level table from volume to tl.
+		int eg_total_level_tables[VM_MAX][TL_TABLE_SIZE];
+		// EG conversion table from linear volume to total level.
+		int eg_linear_to_total_level_table[129];
+
+		// Panning volume table.
+		double pan_table[129];
+
+		// Low frequency oscillator.
+
+		// LFO modulation table.
+		int lfo_wave_tables[LFO_WAVE_MAX][LFO_TABLE_SIZE];
+		// LFO modulation table for chorus.
+		int lfo_chorus_tables[LFO_TABLE_SIZE];
+
+		// Filter.
+
+		// FILTER cutoff.
+		double filter_cutoff_table[129];
+		// FILTER resonance.
+		double filter_feedback_table[129];
+		// FILTER envlope rate.
+		int filter_eg_rate[64];
+
+		// Pulse generator.
+
+		// PG MIDI note number to FM key code.
+		int note_number_to_key_code[NOTE_TABLE_SIZE];
+		// Table for dt2 (from MAME's opm source).
+		int dt2_table[4] = { 0, 384, 500, 608 };
+		// PG log table.
+		int log_table[LOG_TABLE_SIZE * 3]; // 2 extra units of size for zero-filling; 16*256*2*3 = 24576
+
+		void create_eg_tables();
+		void create_pg_tables();
+		void create_lfo_tables();
+		void create_filter_tables();
+	};
+
+	// Wave samples and user registered sound data. Shared by every instance, so data
+	// registered through one driver resolves the same way on all of them.
+	struct SoundBank {
+		bool is_ready = false;
+
+		Vector<Ref<SiOPMWaveTable>> wave_tables;
+		Ref<SiOPMWaveTable> no_wave_table;
+		Ref<SiOPMWaveTable> no_wave_table_opm;
+		Vector<Ref<SiOPMWaveSamplerTable>> sampler_tables;
+		HashMap<String, Variant> sound_reference;
+
+		Vector<Ref<SiOPMWaveTable>> custom_wave_tables;
+		Vector<Ref<SiMMLVoice>> pcm_voices;
+		// Bumped whenever a registered wave table changes.
+		uint32_t wave_table_generation = 0;
+	};
+
+private:
+	static CoreTables *_core_tables;
+	static SoundBank *_sound_bank;
+
+	static CoreTables *_get_core_tables();
+	static SoundBank *_get_sound_bank();
+
+public:
 	// All reference properties are made public to simplify code.
-	// These are not expected to be written to externally. But that might happen.
+	// Shared tables are exposed as const references, only the rate-dependent
+	// tables are owned by the instance.
 
 	int sampling_rate = 0;
 	int fm_clock = 0;
@@ -146,103 +278,35 @@ public:
 
 	// Envelope generator.
 
-	// EG increment table. This table is based on MAME's opm emulation.
-	int eg_increment_tables[18][8] = {
-		/*cycle:      0 1  2 3  4 5  6 7  */
-		/* 0*/      { 0,1, 0,1, 0,1, 0,1 },  /* rates 00..11 0 (increment by 0 or 1) */
-		/* 1*/      { 0,1, 0,1, 1,1, 0,1 },  /* rates 00..11 1 */
-		/* 2*/      { 0,1, 1,1, 0,1, 1,1 },  /* rates 00..11 2 */
-		/* 3*/      { 0,1, 1,1, 1,1, 1,1 },  /* rates 00..11 3 */
-		/* 4*/      { 1,1, 1,1, 1,1, 1,1 },  /* rate 12 0 (increment by 1) */
-		/* 5*/      { 1,1, 1,2, 1,1, 1,2 },  /* rate 12 1 */
-		/* 6*/      { 1,2, 1,2, 1,2, 1,2 },  /* rate 12 2 */
-		/* 7*/      { 1,2, 2,2, 1,2, 2,2 },  /* rate 12 3 */
-		/* 8*/      { 2,2, 2,2, 2,2, 2,2 },  /* rate 13 0 (increment by 2) */
-		/* 9*/      { 2,2, 2,4, 2,2, 2,4 },  /* rate 13 1 */
-		/*10*/      { 2,4, 2,4, 2,4, 2,4 },  /* rate 13 2 */
-		/*11*/      { 2,4, 4,4, 2,4, 4,4 },  /* rate 13 3 */
-		/*12*/      { 4,4, 4,4, 4,4, 4,4 },  /* rate 14 0 (increment by 4) */
-		/*13*/      { 4,4, 4,8, 4,4, 4,8 },  /* rate 14 1 */
-		/*14*/      { 4,8, 4,8, 4,8, 4,8 },  /* rate 14 2 */
-		/*15*/      { 4,8, 8,8, 4,8, 8,8 },  /* rate 14 3 */
-		/*16*/      { 8,8, 8,8, 8,8, 8,8 },  /* rates 15 0, 15 1, 15 2, 15 3 (increment by 8) */
-		/*17*/      { 0,0, 0,0, 0,0, 0,0 }   /* infinity rates for attack and decay(s) */
-	};
-	// EG increment table for attack. This table is based on fmgen (shift=0 means x0).
-	int eg_increment_tables_attack[18][8] = {
-		/*cycle:      0 1  2 3  4 5  6 7  */
-		/* 0*/      { 0,4, 0,4, 0,4, 0,4 },  /* rates 00..11 0 (increment by 0 or 1) */
-		/* 1*/      { 0,4, 0,4, 4,4, 0,4 },  /* rates 00..11 1 */
-		/* 2*/      { 0,4, 4,4, 0,4, 4,4 },  /* rates 00..11 2 */
-		/* 3*/      { 0,4, 4,4, 4,4, 4,4 },  /* rates 00..11 3 */
-		/* 4*/      { 4,4, 4,4, 4,4, 4,4 },  /* rate 12 0 (increment by 1) */
-		/* 5*/      { 4,4, 4,3, 4,4, 4,3 },  /* rate 12 1 */
-		/* 6*/      { 4,3, 4,3, 4,3, 4,3 },  /* rate 12 2 */
-		/* 7*/      { 4,3, 3,3, 4,3, 3,3 },  /* rate 12 3 */
-		/* 8*/      { 3,3, 3,3, 3,3, 3,3 },  /* rate 13 0 (increment by 2) */
-		/* 9*/      { 3,3, 3,2, 3,3, 3,2 },  /* rate 13 1 */
-		/*10*/      { 3,2, 3,2, 3,2, 3,2 },  /* rate 13 2 */
-		/*11*/      { 3,2, 2,2, 3,2, 2,2 },  /* rate 13 3 */
-		/*12*/      { 2,2, 2,2, 2,2, 2,2 },  /* rate 14 0 (increment by 4) */
-		/*13*/      { 2,2, 2,1, 2,2, 2,1 },  /* rate 14 1 */
-		/*14*/      { 2,8, 2,1, 2,1, 2,1 },  /* rate 14 2 */
-		/*15*/      { 2,1, 1,1, 2,1, 1,1 },  /* rate 14 3 */
-		/*16*/      { 1,1, 1,1, 1,1, 1,1 },  /* rates 15 0, 15 1, 15 2, 15 3 (increment by 8) */
-		/*17*/      { 0,0, 0,0, 0,0, 0,0 }   /* infinity rates for attack and decay(s) */
-	};
-	// EG table selector. 128 = 64 rates + 32 ks-rates + 32 dummies for dr,sr=0
-	int eg_table_selector[128];
+	const int (&eg_increment_tables)[18][8];
+	const int (&eg_increment_tables_attack)[18][8];
+	const int (&eg_table_selector)[128];
 	// EG timer step. 128 = 64 rates + 32 ks-rates + 32 dummies for dr,sr=0
 	int eg_timer_steps[128];
-	// EG table to calculate EG level tables.
-	int eg_level_tables[7][1 << ENV_BITS];
-	// EG table for SSG-type to EG level tables index. 10 = 8 standard + 2 extra.
-	int eg_ssg_table_index[10][2][3] = {
-		// [w/ ar], [w/o ar]
-		{  {3,3,3}, {1,3,3}  },   // ssgec=8
-		{  {1,6,6}, {1,6,6}  },   // ssgec=9
-		{  {2,1,2}, {1,2,1}  },   // ssgec=10
-		{  {2,5,5}, {1,5,5}  },   // ssgec=11
-		{  {4,4,4}, {2,4,4}  },   // ssgec=12
-		{  {2,5,5}, {2,5,5}  },   // ssgec=13
-		{  {1,2,1}, {2,1,2}  },   // ssgec=14
-		{  {1,6,6}, {2,6,6}  },   // ssgec=15
-
-		{  {1,1,1}, {1,1,1}  },   // ssgec=16
-		{  {2,2,2}, {2,2,2}  }    // ssgec=17
-	};
-	// EG sustain level table from 15 to 1024.
-	int eg_sustain_level_table[16];
-	// EG total level table from volume to tl.
-	int eg_total_level_tables[VM_MAX][TL_TABLE_SIZE];
-	// EG conversion table from linear volume to total level.
-	int eg_linear_to_total_level_table[129];
+	const int (&eg_level_tables)[7][1 << ENV_BITS];
+	const int (&eg_ssg_table_index)[10][2][3];
+	const int (&eg_sustain_level_table)[16];
+	const int (&eg_total_level_tables)[VM_MAX][TL_TABLE_SIZE];
+	const int (&eg_linear_to_total_level_table)[129];
 
-	// Panning volume table.
-	double pan_table[129];
+	const double (&pan_table)[129];
 
 	// Low frequency oscillator.
 
 	// LFO timer step.
 	int lfo_timer_steps[LFO_TABLE_SIZE];
-	// LFO modulation table.
-	int lfo_wave_tables[LFO_WAVE_MAX][LFO_TABLE_SIZE];
-	// LFO modulation table for chorus.
-	int lfo_chorus_tables[LFO_TABLE_SIZE];
+	const int (&lfo_wave_tables)[LFO_WAVE_MAX][LFO_TABLE_SIZE];
+	const int (&lfo_chorus_tables)[LFO_TABLE_SIZE];
 
 	// Filter.
 
-	// FILTER cutoff.
-	double filter_cutoff_table[129];
-	// FILTER resonance.
-	double filter_feedback_table[129];
-	// FILTER envlope rate.
-	int filter_eg_rate[64];
+	const double (&filter_cutoff_table)[129];
+	const double (&filter_feedback_table)[129];
+	const int (&filter_eg_rate)[64];
 
 	// Pulse generator.
 
-	// PG MIDI note number to FM key code.
-	int note_number_to_key_code[NOTE_TABLE_SIZE];
+	const int (&note_number_to_key_code)[NOTE_TABLE_SIZE];
 
 	// PG pitch table.
 	Vector<Vector<int>> pitch_table;
@@ -251,47 +315,45 @@ public:
 	// PG phase step shift filter.
 	int phase_step_shift_filter[SiONPitchTableType::PITCH_TABLE_MAX];
 	// PG sound reference table.
-	HashMap<String, Variant> sound_reference;
+	HashMap<String, Variant> &sound_reference;
 
 	// Table for dt1 (from fmgen.cpp).
 	int dt1_table[8][KEY_CODE_TABLE_SIZE];
-	// Table for dt2 (from MAME's opm source).
-	int dt2_table[4] = { 0, 384, 500, 608 };
-	// PG log table.
-	int log_table[LOG_TABLE_SIZE * 3]; // 2 extra units of size for zero-filling; 16*256*2*3 = 24576
+	const int (&dt2_table)[4];
+	const int (&log_table)[LOG_TABLE_SIZE * 3];
 
 	// Wave samples.
 
 	// PG wave tables.
-	Vector<Ref<SiOPMWaveTable>> wave_tables;
+	Vector<Ref<SiOPMWaveTable>> &wave_tables;
 	// PG wave tables without any waves.
-	Ref<SiOPMWaveTable> no_wave_table;
-	Ref<SiOPMWaveTable> no_wave_table_opm;
+	Ref<SiOPMWaveTable> &no_wave_table;
+	Ref<SiOPMWaveTable> &no_wave_table_opm;
 	// PG sampler table.
-	Vector<Ref<SiOPMWaveSamplerTable>> sampler_tables;
+	Vector<Ref<SiOPMWaveSamplerTable>> &sampler_tables;
+	// Changes whenever wave tables are registered or reset, so users holding on to a
+	// looked up wavelet can tell it may be stale.
+	const uint32_t &wave_table_generation;
 
 	void reset_all_user_tables();
 	void register_wave_table(int p_index, const Ref<SiOPMWaveTable> &p_table);
 	void register_scc_wave_table(int p_index, const Ref<SiOPMWaveTable> &p_table);
 	Ref<SiOPMWaveSamplerData> register_sampler_data(int p_index, const Variant &p_data, bool p_ignore_note_off, int p_pan, int p_src_channel_count, int p_channel_count);
 
-	Ref<SiOPMWaveTable> get_wave_table(int p_index);
-	Ref<SiOPMWavePCMTable> get_pcm_data(int p_index);
+	// Entries of p_stencil, if given, take precedence over the global tables.
+	Ref<SiOPMWaveTable> get_wave_table(int p_index, const SiOPMRefStencil *p_stencil = nullptr);
+	Ref<SiOPMWavePCMTable> get_pcm_data(int p_index, const SiOPMRefStencil *p_stencil = nullptr);
+	// Returns the table that overrides p_table in p_stencil, if p_table is one of the global sampler tables.
+	const SiOPMWaveSamplerTable *get_sampler_table_stencil(const Ref<SiOPMWaveSamplerTable> &p_table, const SiOPMRefStencil *p_stencil) const;
 
 	Ref<SiMMLVoice> get_global_pcm_voice(int p_index);
 	Ref<SiMMLVoice> set_global_pcm_voice(int p_index, const Ref<SiMMLVoice> &p_from_voice);
 
-	void set_sampler_table_stencil(int p_index, const Ref<SiOPMWaveSamplerTable> &p_table);
-	void clear_sampler_table_stencil(int p_index);
-
-	void set_stencil_custom_wave_tables(Vector<Ref<SiOPMWaveTable>> p_tables) { _stencil_custom_wave_tables = p_tables; }
-	void clear_stencil_custom_wave_tables() { _stencil_custom_wave_tables = Vector<Ref<SiOPMWaveTable>>(); }
-	void set_stencil_pcm_voices(Vector<Ref<SiMMLVoice>> p_tables) { _stencil_pcm_voices = p_tables; }
-	void clear_stencil_pcm_voices() { _stencil_pcm_voices = Vector<Ref<SiMMLVoice>>(); }
-
 	//
 
 	// TODO: Define parameters as constants?
+	// The first instance becomes the global one. Further instances only build the
+	// tables that depend on the sampling rate and can be owned by a driver.
 	SiOPMRefTable(int p_fm_clock, double p_psg_clock, int p_sampling_rate);
 	~SiOPMRefTable();
 };
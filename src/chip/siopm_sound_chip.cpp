@@ -9,6 +9,7 @@
 #include <godot_cpp/core/class_db.hpp>
 #include "chip/channels/siopm_channel_manager.h"
 #include "chip/siopm_operator_params.h"
+#include "chip/siopm_ref_table.h"
 #include "chip/siopm_stream.h"
 #include "sequencer/simml_sequencer.h"
 
@@ -78,11 +79,14 @@ void SiOPMSoundChip::initialize(int p_channel_count, int p_bitrate, int p_buffer
 	pcm_volume = 4;
 	sampler_volume = 2;
 
-	SiOPMChannelManager::initialize_all_channels();
+	for (int i = 0; i < SiOPMChannelManager::CHANNEL_MAX; i++) {
+		_channel_manager->reserve_channels((SiOPMChannelManager::ChannelType)i, _channel_pool_sizes[i]);
+	}
+	_channel_manager->initialize_all_channels();
 }
 
 void SiOPMSoundChip::reset() {
-	SiOPMChannelManager::reset_all_channels();
+	_channel_manager->reset_all_channels();
 }
 
 double SiOPMSoundChip::get_bpm() const {
@@ -93,8 +97,38 @@ void SiOPMSoundChip::set_sequencer(SiMMLSequencer *p_sequencer) {
 	_sequencer = p_sequencer;
 }
 
+SiOPMRefTable *SiOPMSoundChip::get_ref_table() const {
+	return _ref_table ? _ref_table : SiOPMRefTable::get_instance();
+}
+
+void SiOPMSoundChip::set_control_block_size(int p_size) {
+	// A block of one sample is audio rate anyway.
+	_control_block_size = (p_size > 1) ? MIN(p_size, MAX_CONTROL_BLOCK_SIZE) : 0;
+}
+
+int SiOPMSoundChip::get_channel_pool_size(int p_channel_type) const {
+	ERR_FAIL_INDEX_V(p_channel_type, SiOPMChannelManager::CHANNEL_MAX, 0);
+	return _channel_pool_sizes[p_channel_type];
+}
+
+void SiOPMSoundChip::set_channel_pool_size(int p_channel_type, int p_count) {
+	ERR_FAIL_INDEX(p_channel_type, SiOPMChannelManager::CHANNEL_MAX);
+	ERR_FAIL_COND_MSG(p_count < 0, "SiOPMSoundChip: Channel pool size cannot be negative.");
+
+	// Takes effect on the next initialize(), when no channel is being processed.
+	_channel_pool_sizes[p_channel_type] = p_count;
+}
+
 void SiOPMSoundChip::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_control_block_size"), &SiOPMSoundChip::get_control_block_size);
+	ClassDB::bind_method(D_METHOD("set_control_block_size", "size"), &SiOPMSoundChip::set_control_block_size);
+	ClassDB::bind_method(D_METHOD("get_channel_pool_size", "channel_type"), &SiOPMSoundChip::get_channel_pool_size);
+	ClassDB::bind_method(D_METHOD("set_channel_pool_size", "channel_type", "count"), &SiOPMSoundChip::set_channel_pool_size);
+
+	ClassDB::add_property("SiOPMSoundChip", PropertyInfo(Variant::INT, "control_block_size"), "set_control_block_size", "get_control_block_size");
+
 	BIND_CONSTANT(STREAM_SEND_SIZE);
+	BIND_CONSTANT(MAX_CONTROL_BLOCK_SIZE);
 }
 
 SiOPMSoundChip::SiOPMSoundChip() {
@@ -108,10 +142,11 @@ SiOPMSoundChip::SiOPMSoundChip() {
 	zero_buffer = memnew(SinglyLinkedList<int>(1, 0, true));
 	_pipe_buffers.resize_zeroed(PIPE_SIZE);
 
-	SiOPMChannelManager::initialize(this);
+	_channel_manager = memnew(SiOPMChannelManager(this));
 }
 
 SiOPMSoundChip::~SiOPMSoundChip() {
+	memdelete(_channel_manager);
 	memdelete(output_stream);
 
 	memdelete(zero_buffer);
@@ -120,6 +155,4 @@ SiOPMSoundChip::~SiOPMSoundChip() {
 			memdelete(_pipe_buffers[i]);
 		}
 	}
-
-	SiOPMChannelManager::finalize();
 }
@@ -10,11 +10,13 @@
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/templates/list.hpp>
 #include <godot_cpp/templates/vector.hpp>
+#include "chip/channels/siopm_channel_manager.h"
 #include "chip/siopm_operator_params.h"
 #include "templates/singly_linked_list.h"
 
 using namespace godot;
 
+class SiOPMRefTable;
 class SiOPMStream;
 class SiMMLSequencer;
 
@@ -30,9 +32,22 @@ class SiOPMSoundChip : public Object {
 	double pcm_volume = 4;
 	double sampler_volume = 2;
 	SiMMLSequencer *_sequencer = nullptr;
+	// Reference tables at the rate of the owning driver. Not owned.
+	SiOPMRefTable *_ref_table = nullptr;
+	// Channels are pooled per chip, so that each one stays bound to this chip's tables.
+	SiOPMChannelManager *_channel_manager = nullptr;
 
 	int _buffer_length = 0;
 	int _bitrate = 0;
+	// Samples per LFO/envelope update for channels that support control rate; 0 runs them
+	// every sample.
+	int _control_block_size = 0;
+	// Channels of each type created up front by initialize(), so that voices up to these
+	// counts never allocate while streaming.
+	int _channel_pool_sizes[SiOPMChannelManager::CHANNEL_MAX] = {};
+	// Cheaper rendering modes, switched by the driver when blocks run over budget.
+	int _super_voice_limit = 0; // 0 renders every super voice.
+	bool _sampler_interpolation = true;
 
 	// Expected to be of PIPE_SIZE size.
 	Vector<SinglyLinkedList<int> *> _pipe_buffers;
@@ -43,6 +58,7 @@ protected:
 public:
 	static const int STREAM_SEND_SIZE = 8;
 	static const int PIPE_SIZE = 5;
+	static const int MAX_CONTROL_BLOCK_SIZE = 64;
 
 	Ref<SiOPMOperatorParams> get_init_operator_params() const { return init_operator_params; }
 	SinglyLinkedList<int> *get_zero_buffer() const { return zero_buffer; }
@@ -59,8 +75,20 @@ public:
 
 	int get_buffer_length() const { return _buffer_length; }
 	int get_bitrate() const { return _bitrate; }
+	int get_control_block_size() const { return _control_block_size; }
+	void set_control_block_size(int p_size);
+	int get_super_voice_limit() const { return _super_voice_limit; }
+	void set_super_voice_limit(int p_limit) { _super_voice_limit = MAX(p_limit, 0); }
+	bool is_sampler_interpolation() const { return _sampler_interpolation; }
+	void set_sampler_interpolation(bool p_enabled) { _sampler_interpolation = p_enabled; }
+	int get_channel_pool_size(int p_channel_type) const;
+	void set_channel_pool_size(int p_channel_type, int p_count);
 	double get_bpm() const;
 	void set_sequencer(SiMMLSequencer *p_sequencer);
+	// Falls back to the global table when no driver has assigned one.
+	SiOPMRefTable *get_ref_table() const;
+	void set_ref_table(SiOPMRefTable *p_table) { _ref_table = p_table; }
+	SiOPMChannelManager *get_channel_manager() const { return _channel_manager; }
 
 	SinglyLinkedList<int> *get_pipe(int p_pipe_num, int p_index = 0);
 
@@ -28,6 +28,25 @@ void SiOPMStream::clear() {
 	for (int i = 0; i < buffer.size(); i++) {
 		dst[i] = 0;
 	}
+	left_only = mono_packing;
+}
+
+void SiOPMStream::set_mono_packing(bool p_enabled) {
+	if (!p_enabled && left_only) {
+		unpack_mono(0, buffer.size() >> 1);
+	}
+	mono_packing = p_enabled;
+}
+
+void SiOPMStream::unpack_mono(int p_offset, int p_length) {
+	const int start_index = MAX(p_offset, 0) << 1;
+	const int end_index = MIN((p_offset + p_length) << 1, (int)buffer.size());
+
+	double *dst = buffer.ptrw();
+	for (int i = start_index; i < end_index; i += 2) {
+		dst[i + 1] = dst[i];
+	}
+	left_only = false;
 }
 
 //unused :(
@@ -65,10 +84,8 @@ void SiOPMStream::write(SinglyLinkedList<int>::Element *p_data_start, int p_offs
 		return;
 	}
 
-	double *dst = buffer.ptrw();
-
 	if (channels == 2) { // stereo
-		double (&pan_table)[129] = SiOPMRefTable::get_instance()->pan_table;
+		const double (&pan_table)[129] = SiOPMRefTable::get_instance()->pan_table;
 		double volume_left = volume;
 		double volume_right = volume;
 		if (p_pan != PAN_NONE) {
@@ -77,7 +94,20 @@ void SiOPMStream::write(SinglyLinkedList<int>::Element *p_data_start, int p_offs
 			volume_right = pan_table[pan] * volume;
 		}
 
+		if (left_only && volume_left != volume_right) {
+			unpack_mono(0, buffer.size() >> 1);
+		}
+
+		double *dst = buffer.ptrw();
 		SinglyLinkedList<int>::Element *current = p_data_start;
+		if (left_only) {
+			for (int i = start_index; i < buffer_size; i += 2) {
+				dst[i] += current->value * volume_left;
+				current = current->next();
+			}
+			return;
+		}
+
 		for (int i = start_index; i < buffer_size;) {
 			const double sample = current->value;
 			dst[i++] += sample * volume_left;
@@ -86,7 +116,16 @@ void SiOPMStream::write(SinglyLinkedList<int>::Element *p_data_start, int p_offs
 			current = current->next();
 		}
 	} else if (channels == 1) { // mono
+		double *dst = buffer.ptrw();
 		SinglyLinkedList<int>::Element *current = p_data_start;
+		if (left_only) {
+			for (int i = start_index; i < buffer_size; i += 2) {
+				dst[i] += current->value * volume;
+				current = current->next();
+			}
+			return;
+		}
+
 		for (int i = start_index; i < buffer_size;) {
 			const double sample = current->value * volume;
 			dst[i++] += sample;
@@ -114,10 +153,12 @@ void SiOPMStream::write_stereo(SinglyLinkedList<int>::Element *p_left_start, Sin
 		return;
 	}
 
-	double *dst = buffer.ptrw();
-
 	if (channels == 2) { // stereo
-		double (&pan_table)[129] = SiOPMRefTable::get_instance()->pan_table;
+		if (left_only) {
+			unpack_mono(0, buffer.size() >> 1);
+		}
+
+		const double (&pan_table)[129] = SiOPMRefTable::get_instance()->pan_table;
 		double volume_left = volume;
 		double volume_right = volume;
 		if (p_pan != PAN_NONE) {
@@ -126,6 +167,7 @@ void SiOPMStream::write_stereo(SinglyLinkedList<int>::Element *p_left_start, Sin
 			volume_right = pan_table[pan] * volume;
 		}
 
+		double *dst = buffer.ptrw();
 		SinglyLinkedList<int>::Element *current_left = p_left_start;
 		SinglyLinkedList<int>::Element *current_right = p_right_start;
 
@@ -139,8 +181,18 @@ void SiOPMStream::write_stereo(SinglyLinkedList<int>::Element *p_left_start, Sin
 	} else if (channels == 1) { // mono
 		volume *= 0.5;
 
+		double *dst = buffer.ptrw();
 		SinglyLinkedList<int>::Element *current_left = p_left_start;
 		SinglyLinkedList<int>::Element *current_right = p_right_start;
+		if (left_only) {
+			for (int i = start_index; i < buffer_size; i += 2) {
+				dst[i] += (current_left->value + current_right->value) * volume;
+
+				current_left = current_left->next();
+				current_right = current_right->next();
+			}
+			return;
+		}
 
 		for (int i = start_index; i < buffer_size;) {
 			const double sample = (current_left->value + current_right->value) * volume;
@@ -187,11 +239,15 @@ void SiOPMStream::write_from_vector(Vector<double> *p_data, int p_start_data, in
 	double volume = p_volume;
 	const int pan = (p_pan == PAN_NONE) ? 64 : CLAMP(p_pan, 0, 128);
 	const double *src = p_data->ptr();
+	if (left_only) {
+		// Effect stream outputs are stereo in practice, so there is no packed path here.
+		unpack_mono(0, max_frames_in_buffer);
+	}
 	double *dst = buffer.ptrw();
 
 	int channels = this->channels;
 	if (channels == 2) {
-		double (&pan_table)[129] = SiOPMRefTable::get_instance()->pan_table;
+		const double (&pan_table)[129] = SiOPMRefTable::get_instance()->pan_table;
 
 		if (p_sample_channel_count == 2) { // stereo data to stereo buffer
 			double volume_left = pan_table[128 - pan] * volume;
@@ -17,6 +17,12 @@ class SiOPMStream {
 	int channels = 2;
 	Vector<double> buffer;
 
+	// With mono packing, a cleared buffer only takes writes into the left channel for as
+	// long as everything written has identical sides. The right channel is filled in by
+	// unpack_mono(), at the latest when something stereo is written.
+	bool mono_packing = false;
+	bool left_only = false;
+
 public:
 	static constexpr int PAN_NONE = -1;
 
@@ -27,6 +33,12 @@ public:
 	Vector<double> *get_buffer_ptr() { return &buffer; }
 	void set_buffer(Vector<double> p_buffer) { buffer = p_buffer; }
 
+	void set_mono_packing(bool p_enabled);
+	// True if only the left channel of the buffer holds data.
+	bool is_left_only() const { return left_only; }
+	// Copy the left channel into the right one over the given range of frames.
+	void unpack_mono(int p_offset, int p_length);
+
 	void resize(int p_length);
 	void clear();
 	void limit();
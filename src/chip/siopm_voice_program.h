@@ -0,0 +1,87 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SIOPM_VOICE_PROGRAM_H
+#define SIOPM_VOICE_PROGRAM_H
+
+// Flat, plain-data copies of voice parameters, ready to be applied by the audio thread.
+//
+// SiOPMChannelParams and SiOPMOperatorParams are reference-counted objects built for
+// editing and scripting. Applying them means a Ref copy and a getter per field, and
+// resolving derived values (LFO step for the time mode, effect send flag) every time.
+// A program holds the same data already resolved, so switching a channel to a voice
+// is a copy of a few hundred bytes and a pass of plain assignments.
+
+struct SiOPMOperatorProgram {
+	int pulse_generator_type = 0;
+	int pitch_table_type = 0;
+
+	int attack_rate = 0;
+	int decay_rate = 0;
+	int sustain_rate = 0;
+	int release_rate = 0;
+	int sustain_level = 0;
+	int total_level = 0;
+
+	int key_scaling_rate = 0;
+	int key_scaling_level = 0;
+	int fine_multiple = 128;
+	int detune1 = 0;
+	int detune2 = 0;
+	int amplitude_modulation_shift = 0;
+
+	int initial_phase = 0;
+	int fixed_pitch = 0;
+	bool mute = false;
+	int ssg_envelope_control = 0;
+	int frequency_modulation_level = 5;
+	bool envelope_reset_on_attack = false;
+
+	int super_count = 1;
+	int super_spread = 0;
+	int super_stereo_spread = 0;
+};
+
+struct SiOPMChannelProgram {
+	static const int MAX_OPERATORS = 4;
+	static const int MAX_STREAM_SENDS = 8;
+
+	int operator_count = 0;
+	bool analog_like = false;
+	int algorithm = 0;
+	int feedback = 0;
+	int feedback_connection = 0;
+	int envelope_frequency_ratio = 100;
+
+	int lfo_wave_shape = 0;
+	int lfo_time_mode = 0;
+	// Already picked from the rate, time, or beat value according to the time mode.
+	int lfo_frequency_step = 0;
+	int amplitude_modulation_depth = 0;
+	int pitch_modulation_depth = 0;
+	bool audio_rate_modulation = false;
+
+	double master_volumes[MAX_STREAM_SENDS] = {};
+	bool has_effect_send = false;
+	int pan = 64;
+	int instrument_gain_db = 0;
+
+	int filter_type = 0;
+	int filter_cutoff = 128;
+	int filter_resonance = 0;
+	int filter_attack_rate = 0;
+	int filter_decay_rate1 = 0;
+	int filter_decay_rate2 = 0;
+	int filter_release_rate = 0;
+	int filter_decay_offset1 = 128;
+	int filter_decay_offset2 = 64;
+	int filter_sustain_offset = 32;
+	int filter_release_offset = 128;
+
+	SiOPMOperatorProgram operators[MAX_OPERATORS];
+};
+
+#endif // SIOPM_VOICE_PROGRAM_H
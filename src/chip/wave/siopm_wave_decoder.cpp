@@ -0,0 +1,303 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#include "siopm_wave_decoder.h"
+
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <cstring>
+
+#include "chip/wave/siopm_wave_decoder_flac.h"
+#include "chip/wave/siopm_wave_decoder_qoa.h"
+#include "chip/wave/siopm_wave_decoder_wav.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace godot;
+
+Vector<SiOPMWaveDecoder::DecoderFormat> SiOPMWaveDecoder::_formats;
+
+// ---------------------------------------------------------------------------
+// Format registry
+// ---------------------------------------------------------------------------
+
+void SiOPMWaveDecoder::_register_builtin_formats() {
+	if (!_formats.is_empty()) {
+		return;
+	}
+
+	// Register directly rather than through register_format(), which would recurse here.
+	DecoderFormat wav;
+	wav.name = "WAV";
+	wav.probe = &SiOPMWaveDecoderWAV::probe;
+	wav.create = &SiOPMWaveDecoderWAV::create;
+	_formats.push_back(wav);
+
+	DecoderFormat flac;
+	flac.name = "FLAC";
+	flac.probe = &SiOPMWaveDecoderFLAC::probe;
+	flac.create = &SiOPMWaveDecoderFLAC::create;
+	_formats.push_back(flac);
+
+	DecoderFormat qoa;
+	qoa.name = "QOA";
+	qoa.probe = &SiOPMWaveDecoderQOA::probe;
+	qoa.create = &SiOPMWaveDecoderQOA::create;
+	_formats.push_back(qoa);
+}
+
+void SiOPMWaveDecoder::register_format(const String &p_name, ProbeFunc p_probe, CreateFunc p_create) {
+	ERR_FAIL_COND_MSG(!p_probe || !p_create, "SiOPMWaveDecoder: Cannot register format '" + p_name + "' without probe and create functions.");
+	_register_builtin_formats();
+
+	DecoderFormat format;
+	format.name = p_name;
+	format.probe = p_probe;
+	format.create = p_create;
+	_formats.push_back(format);
+}
+
+SiOPMWaveDecoder *SiOPMWaveDecoder::create_for_file(const String &p_path) {
+	_register_builtin_formats();
+
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+	if (file.is_null()) {
+		return nullptr;
+	}
+	PackedByteArray header = file->get_buffer(PROBE_LENGTH);
+	file = Ref<FileAccess>();
+
+	for (int i = 0; i < _formats.size(); i++) {
+		const DecoderFormat &format = _formats[i];
+		if (!format.probe(header.ptr(), (int)header.size())) {
+			continue;
+		}
+
+		SiOPMWaveDecoder *decoder = format.create();
+		if (decoder->open(p_path)) {
+			return decoder;
+		}
+		memdelete(decoder);
+	}
+
+	return nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Memory mapping
+// ---------------------------------------------------------------------------
+
+bool SiOPMWaveDecoder::_map_file(const String &p_path) {
+	// res:// and user:// paths resolve to real files in the editor and for user data.
+	// Inside an exported pack there is no such file, and opening it simply fails.
+	String os_path = p_path;
+	ProjectSettings *project_settings = ProjectSettings::get_singleton();
+	if (project_settings) {
+		os_path = project_settings->globalize_path(p_path);
+	}
+	if (os_path.is_empty() || os_path.begins_with("res://") || os_path.begins_with("user://")) {
+		return false;
+	}
+
+#ifdef _WIN32
+	HANDLE file_handle = CreateFileW((LPCWSTR)os_path.utf16().get_data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file_handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart <= 0 || (uint64_t)file_size.QuadPart > (uint64_t)SIZE_MAX) {
+		CloseHandle(file_handle);
+		return false;
+	}
+
+	HANDLE mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping_handle) {
+		CloseHandle(file_handle);
+		return false;
+	}
+
+	void *address = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+	if (!address) {
+		CloseHandle(mapping_handle);
+		CloseHandle(file_handle);
+		return false;
+	}
+
+	_map_file_handle = file_handle;
+	_map_mapping_handle = mapping_handle;
+	_map_address = address;
+	_map_length = (size_t)file_size.QuadPart;
+#else
+	int fd = ::open(os_path.utf8().get_data(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0 || (uint64_t)file_stat.st_size > (uint64_t)SIZE_MAX) {
+		::close(fd);
+		return false;
+	}
+
+	void *address = mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps its own reference to the file.
+	::close(fd);
+	if (address == MAP_FAILED) {
+		return false;
+	}
+
+	// Reads are mostly forward, in large chunks; let the kernel read ahead.
+	madvise(address, (size_t)file_stat.st_size, MADV_SEQUENTIAL);
+
+	_map_address = address;
+	_map_length = (size_t)file_stat.st_size;
+#endif
+
+	return true;
+}
+
+void SiOPMWaveDecoder::_unmap_file() {
+#ifdef _WIN32
+	if (_map_address) {
+		UnmapViewOfFile(_map_address);
+	}
+	if (_map_mapping_handle) {
+		CloseHandle((HANDLE)_map_mapping_handle);
+	}
+	if (_map_file_handle) {
+		CloseHandle((HANDLE)_map_file_handle);
+	}
+	_map_file_handle = nullptr;
+	_map_mapping_handle = nullptr;
+#else
+	if (_map_address) {
+		munmap(_map_address, _map_length);
+	}
+#endif
+
+	_map_address = nullptr;
+	_map_length = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Byte source
+// ---------------------------------------------------------------------------
+
+const uint8_t *SiOPMWaveDecoder::_get_bytes(int64_t p_offset, int64_t p_length, int64_t &r_length) {
+	r_length = 0;
+	if (p_offset < 0 || p_offset >= _file_length || p_length <= 0) {
+		return nullptr;
+	}
+
+	int64_t length = MIN(p_length, _file_length - p_offset);
+	if (_map_address) {
+		r_length = length;
+		return (const uint8_t *)_map_address + p_offset;
+	}
+
+	ERR_FAIL_COND_V(_file.is_null(), nullptr);
+
+	int64_t window_end = _window_offset + (int64_t)_window.size();
+	if (p_offset < _window_offset || p_offset + length > window_end) {
+		_file->seek(p_offset);
+		_window = _file->get_buffer(MAX(length, FALLBACK_WINDOW_SIZE));
+		_window_offset = p_offset;
+	}
+
+	r_length = MIN(length, _window_offset + (int64_t)_window.size() - p_offset);
+	if (r_length <= 0) {
+		r_length = 0;
+		return nullptr;
+	}
+	return _window.ptr() + (p_offset - _window_offset);
+}
+
+// ---------------------------------------------------------------------------
+// Open / close
+// ---------------------------------------------------------------------------
+
+bool SiOPMWaveDecoder::open(const String &p_path) {
+	close();
+
+	if (_map_file(p_path)) {
+		_file_length = (int64_t)_map_length;
+	} else {
+		_file = FileAccess::open(p_path, FileAccess::READ);
+		if (_file.is_null()) {
+			return false;
+		}
+		_file_length = (int64_t)_file->get_length();
+	}
+
+	if (!_open_stream() || _info.frame_count <= 0 || _info.channel_count < 1 || _info.channel_count > 2) {
+		close();
+		return false;
+	}
+
+	_open = true;
+	return true;
+}
+
+void SiOPMWaveDecoder::close() {
+	_close_stream();
+	_unmap_file();
+	_file = Ref<FileAccess>();
+	_window = PackedByteArray();
+	_window_offset = 0;
+	_file_length = 0;
+	_info = Info();
+	_open = false;
+}
+
+SiOPMWaveDecoder::~SiOPMWaveDecoder() {
+	// Subclasses release their own stream state in their destructors; _close_stream()
+	// can't be dispatched to them from here.
+	_unmap_file();
+}
+
+// ---------------------------------------------------------------------------
+// Reading
+// ---------------------------------------------------------------------------
+
+int SiOPMWaveDecoder::read_frames(int64_t p_start_frame, int p_frame_count, double *r_out) {
+	if (!_open || p_start_frame < 0 || p_start_frame >= _info.frame_count || p_frame_count <= 0) {
+		return 0;
+	}
+
+	int frames = (int)MIN((int64_t)p_frame_count, _info.frame_count - p_start_frame);
+	return _decode_frames(p_start_frame, frames, r_out);
+}
+
+int SiOPMWaveDecoder::read_frames(int64_t p_start_frame, int p_frame_count, float *r_out) {
+	if (!_open || p_start_frame < 0 || p_start_frame >= _info.frame_count || p_frame_count <= 0) {
+		return 0;
+	}
+
+	int frames = (int)MIN((int64_t)p_frame_count, _info.frame_count - p_start_frame);
+	size_t sample_count = (size_t)frames * (size_t)_info.channel_count;
+	if (_conversion_buffer.size() < sample_count) {
+		_conversion_buffer.resize(sample_count);
+	}
+
+	frames = _decode_frames(p_start_frame, frames, _conversion_buffer.data());
+	const double *source = _conversion_buffer.data();
+	for (int i = 0; i < frames * _info.channel_count; i++) {
+		r_out[i] = (float)source[i];
+	}
+	return frames;
+}
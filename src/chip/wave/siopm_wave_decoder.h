@@ -0,0 +1,129 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SIOPM_WAVE_DECODER_H
+#define SIOPM_WAVE_DECODER_H
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/templates/vector.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+// Random-access audio file decoder, shared by the streaming loader and the waveform
+// overview builder. Each supported container/codec is a subclass; create_for_file()
+// sniffs the first bytes of a file and picks the matching one.
+//
+// The base class owns the byte source. When the file lives on the real filesystem
+// the whole file is memory-mapped and decoders read straight from the mapped pages;
+// paths the OS can't see (resources inside an exported pack, for example) fall back
+// to a window of FileAccess reads.
+//
+// Decoders produce interleaved frames normalized to [-1, 1], mono or stereo. Reads
+// may start anywhere: compressed formats seek internally, so a loop wrap back to an
+// earlier frame is just another read_frames() call. A decoder is not thread-safe;
+// it is owned by one thread at a time.
+class SiOPMWaveDecoder {
+public:
+	struct Info {
+		int channel_count = 0;
+		int sample_rate = 0;
+		int bits_per_sample = 0; // Of the source, for information; output is always normalized.
+		int64_t frame_count = 0;
+	};
+
+	// Returns true if the leading bytes of a file look like this format.
+	typedef bool (*ProbeFunc)(const uint8_t *p_header, int p_length);
+	typedef SiOPMWaveDecoder *(*CreateFunc)();
+
+	// Number of leading bytes handed to probe functions.
+	static constexpr int PROBE_LENGTH = 16;
+
+private:
+	struct DecoderFormat {
+		String name;
+		ProbeFunc probe = nullptr;
+		CreateFunc create = nullptr;
+	};
+
+	static Vector<DecoderFormat> _formats;
+	static void _register_builtin_formats();
+
+	// Memory-mapped view of the whole file, if mapping succeeded.
+	void *_map_address = nullptr;
+	size_t _map_length = 0;
+#ifdef _WIN32
+	void *_map_file_handle = nullptr;
+	void *_map_mapping_handle = nullptr;
+#endif
+
+	// FileAccess fallback: a window of the file kept in memory.
+	Ref<FileAccess> _file;
+	PackedByteArray _window;
+	int64_t _window_offset = 0;
+
+	int64_t _file_length = 0;
+	bool _open = false;
+
+	bool _map_file(const String &p_path);
+	void _unmap_file();
+
+	std::vector<double> _conversion_buffer;
+
+protected:
+	Info _info;
+
+	// Minimum size of a FileAccess fallback read, so small requests don't turn into
+	// one call per frame.
+	static constexpr int64_t FALLBACK_WINDOW_SIZE = 262144;
+
+	int64_t _get_file_length() const { return _file_length; }
+	// Return a pointer to file bytes [p_offset, p_offset + p_length). r_length receives
+	// how many of them are available, which is less than asked for at the end of the
+	// file. The pointer is valid until the next call.
+	const uint8_t *_get_bytes(int64_t p_offset, int64_t p_length, int64_t &r_length);
+
+	// Parse headers once the byte source is ready and fill _info. Returns false if the
+	// file isn't a supported stream of this format.
+	virtual bool _open_stream() = 0;
+	virtual void _close_stream() {}
+	// Decode up to p_frame_count frames starting at p_start_frame, which is within range.
+	virtual int _decode_frames(int64_t p_start_frame, int p_frame_count, double *r_out) = 0;
+
+public:
+	// Register an additional format. Formats are probed in registration order, after
+	// the built-in ones.
+	static void register_format(const String &p_name, ProbeFunc p_probe, CreateFunc p_create);
+	// Open p_path with the first decoder whose probe accepts it. Returns nullptr if the
+	// file can't be read or no decoder supports it. The caller owns the result (memdelete).
+	static SiOPMWaveDecoder *create_for_file(const String &p_path);
+
+	virtual String get_format_name() const = 0;
+
+	// Open a file of this decoder's format. Returns false if the file can't be opened
+	// or isn't supported.
+	bool open(const String &p_path);
+	void close();
+
+	bool is_open() const { return _open; }
+	// True when reads are served from a memory mapping rather than FileAccess.
+	bool is_mapped() const { return _map_address != nullptr; }
+	const Info &get_info() const { return _info; }
+
+	// Decode up to p_frame_count interleaved frames starting at p_start_frame.
+	// Returns the number of frames written, which is less than requested at the end of data.
+	int read_frames(int64_t p_start_frame, int p_frame_count, double *r_out);
+	int read_frames(int64_t p_start_frame, int p_frame_count, float *r_out);
+
+	SiOPMWaveDecoder() {}
+	virtual ~SiOPMWaveDecoder();
+};
+
+#endif // SIOPM_WAVE_DECODER_H
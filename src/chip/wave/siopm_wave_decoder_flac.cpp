@@ -0,0 +1,670 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#include "siopm_wave_decoder_flac.h"
+
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <algorithm>
+
+using namespace godot;
+
+static constexpr uint32_t FLAC_MAGIC = 0x664c6143; // "fLaC"
+
+static constexpr int FLAC_BLOCK_STREAMINFO = 0;
+static constexpr int FLAC_BLOCK_SEEKTABLE = 3;
+static constexpr int FLAC_STREAMINFO_SIZE = 34;
+static constexpr int FLAC_SEEKPOINT_SIZE = 18;
+static constexpr uint64_t FLAC_PLACEHOLDER_SEEKPOINT = 0xFFFFFFFFFFFFFFFFULL;
+
+static constexpr int FLAC_FRAME_SYNC = 0x3FFE;
+
+// Stereo decorrelation modes of the frame header channel assignment field.
+static constexpr int FLAC_CHANNELS_LEFT_SIDE = 8;
+static constexpr int FLAC_CHANNELS_SIDE_RIGHT = 9;
+static constexpr int FLAC_CHANNELS_MID_SIDE = 10;
+
+static constexpr int FLAC_MAX_LPC_ORDER = 32;
+
+static inline uint32_t _read_be24(const uint8_t *p_bytes) {
+	return ((uint32_t)p_bytes[0] << 16) | ((uint32_t)p_bytes[1] << 8) | (uint32_t)p_bytes[2];
+}
+
+static inline uint64_t _read_be64(const uint8_t *p_bytes) {
+	uint64_t value = 0;
+	for (int i = 0; i < 8; i++) {
+		value = (value << 8) | p_bytes[i];
+	}
+	return value;
+}
+
+// ---------------------------------------------------------------------------
+// Bit reader
+// ---------------------------------------------------------------------------
+
+// MSB-first reader over a byte range. Reading past the end yields zeros and sets
+// the overrun flag, which the frame decoder checks once at the end.
+class FLACBitReader {
+	const uint8_t *_data = nullptr;
+	int64_t _size_bits = 0;
+	int64_t _position = 0;
+	bool _overrun = false;
+
+public:
+	bool has_overrun() const { return _overrun; }
+	int64_t get_byte_position() const { return (_position + 7) >> 3; }
+
+	void align_to_byte() {
+		_position = (_position + 7) & ~(int64_t)7;
+	}
+
+	uint32_t read(int p_bits) {
+		if (p_bits <= 0) {
+			return 0;
+		}
+		if (_position + p_bits > _size_bits) {
+			_overrun = true;
+			_position = _size_bits;
+			return 0;
+		}
+
+		// At most 32 bits starting anywhere within a byte span 5 bytes.
+		int64_t byte_index = _position >> 3;
+		int bit_offset = (int)(_position & 7);
+		int span_bits = bit_offset + p_bits;
+		int span_bytes = (span_bits + 7) >> 3;
+
+		uint64_t value = 0;
+		for (int i = 0; i < span_bytes; i++) {
+			value = (value << 8) | _data[byte_index + i];
+		}
+		value >>= (span_bytes * 8 - span_bits);
+		value &= (p_bits == 32) ? 0xFFFFFFFFULL : ((1ULL << p_bits) - 1);
+
+		_position += p_bits;
+		return (uint32_t)value;
+	}
+
+	int32_t read_signed(int p_bits) {
+		if (p_bits <= 0) {
+			return 0;
+		}
+		uint32_t value = read(p_bits);
+		int shift = 32 - p_bits;
+		return (int32_t)(value << shift) >> shift;
+	}
+
+	// Count zero bits up to and including the terminating one bit.
+	uint32_t read_unary() {
+		uint32_t count = 0;
+		while (true) {
+			if (_position >= _size_bits) {
+				_overrun = true;
+				return count;
+			}
+
+			int bit_offset = (int)(_position & 7);
+			uint8_t byte = (uint8_t)(_data[_position >> 3] << bit_offset);
+			if (byte == 0) {
+				count += 8 - bit_offset;
+				_position += 8 - bit_offset;
+				continue;
+			}
+
+			int zeros = 0;
+			while (!(byte & 0x80)) {
+				byte <<= 1;
+				zeros++;
+			}
+			count += zeros;
+			_position += zeros + 1;
+			return count;
+		}
+	}
+
+	int32_t read_rice(int p_parameter) {
+		uint32_t quotient = read_unary();
+		uint32_t value = (quotient << p_parameter) | read(p_parameter);
+		// Zigzag: even values are positive, odd are negative.
+		return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+	}
+
+	// The frame/sample number in the frame header uses UTF-8-style variable-length coding.
+	bool read_coded_number(uint64_t &r_value) {
+		uint32_t first = read(8);
+		int extra_bytes = 0;
+		uint64_t value = 0;
+		if (!(first & 0x80)) {
+			value = first;
+		} else if ((first & 0xE0) == 0xC0) {
+			extra_bytes = 1;
+			value = first & 0x1F;
+		} else if ((first & 0xF0) == 0xE0) {
+			extra_bytes = 2;
+			value = first & 0x0F;
+		} else if ((first & 0xF8) == 0xF0) {
+			extra_bytes = 3;
+			value = first & 0x07;
+		} else if ((first & 0xFC) == 0xF8) {
+			extra_bytes = 4;
+			value = first & 0x03;
+		} else if ((first & 0xFE) == 0xFC) {
+			extra_bytes = 5;
+			value = first & 0x01;
+		} else if (first == 0xFE) {
+			extra_bytes = 6;
+		} else {
+			return false;
+		}
+
+		for (int i = 0; i < extra_bytes; i++) {
+			uint32_t byte = read(8);
+			if ((byte & 0xC0) != 0x80) {
+				return false;
+			}
+			value = (value << 6) | (byte & 0x3F);
+		}
+
+		r_value = value;
+		return !_overrun;
+	}
+
+	FLACBitReader(const uint8_t *p_data, int64_t p_size) :
+			_data(p_data),
+			_size_bits(p_size * 8) {}
+};
+
+// ---------------------------------------------------------------------------
+// Registration
+// ---------------------------------------------------------------------------
+
+bool SiOPMWaveDecoderFLAC::probe(const uint8_t *p_header, int p_length) {
+	return p_length >= 4 && (((uint32_t)p_header[0] << 24) | ((uint32_t)p_header[1] << 16) | ((uint32_t)p_header[2] << 8) | (uint32_t)p_header[3]) == FLAC_MAGIC;
+}
+
+SiOPMWaveDecoder *SiOPMWaveDecoderFLAC::create() {
+	return memnew(SiOPMWaveDecoderFLAC);
+}
+
+// ---------------------------------------------------------------------------
+// Metadata parsing
+// ---------------------------------------------------------------------------
+
+bool SiOPMWaveDecoderFLAC::_parse_stream_info(const uint8_t *p_bytes) {
+	_min_block_size = (p_bytes[0] << 8) | p_bytes[1];
+	_max_block_size = (p_bytes[2] << 8) | p_bytes[3];
+	int64_t max_frame_size = _read_be24(p_bytes + 7);
+
+	// Sample rate (20 bits), channels - 1 (3), bits per sample - 1 (5), total samples (36).
+	uint64_t packed = _read_be64(p_bytes + 10);
+	_info.sample_rate = (int)(packed >> 44);
+	_info.channel_count = (int)((packed >> 41) & 0x07) + 1;
+	_info.bits_per_sample = (int)((packed >> 36) & 0x1F) + 1;
+	_info.frame_count = (int64_t)(packed & 0xFFFFFFFFFULL);
+
+	if (_info.sample_rate <= 0 || _info.channel_count > 2 || _info.bits_per_sample < 4 || _info.bits_per_sample > 24) {
+		return false;
+	}
+	if (_min_block_size < 16 || _max_block_size < _min_block_size) {
+		return false;
+	}
+	if (_info.frame_count <= 0) {
+		return false; // Unknown length, as written by some live encoders.
+	}
+
+	// A verbatim frame is the largest a frame can get; the side channel carries one extra bit.
+	int64_t verbatim_size = 32 + (int64_t)_info.channel_count * (((int64_t)_max_block_size * (_info.bits_per_sample + 1) + 7) / 8 + 8);
+	_frame_read_size = MAX(verbatim_size, max_frame_size);
+	return true;
+}
+
+bool SiOPMWaveDecoderFLAC::_open_stream() {
+	int64_t available = 0;
+	const uint8_t *bytes = _get_bytes(0, 4, available);
+	if (!bytes || available < 4 || !probe(bytes, (int)available)) {
+		return false;
+	}
+
+	int64_t file_length = _get_file_length();
+	int64_t position = 4;
+	bool found_stream_info = false;
+	bool last_block = false;
+	std::vector<SeekPoint> table_points;
+
+	while (!last_block) {
+		bytes = _get_bytes(position, 4, available);
+		if (!bytes || available < 4) {
+			return false;
+		}
+		last_block = (bytes[0] & 0x80) != 0;
+		int block_type = bytes[0] & 0x7F;
+		int64_t block_length = _read_be24(bytes + 1);
+		position += 4;
+
+		if (block_type == FLAC_BLOCK_STREAMINFO) {
+			bytes = _get_bytes(position, FLAC_STREAMINFO_SIZE, available);
+			if (!bytes || available < FLAC_STREAMINFO_SIZE || !_parse_stream_info(bytes)) {
+				return false;
+			}
+			found_stream_info = true;
+
+		} else if (block_type == FLAC_BLOCK_SEEKTABLE) {
+			int point_count = (int)(block_length / FLAC_SEEKPOINT_SIZE);
+			bytes = _get_bytes(position, (int64_t)point_count * FLAC_SEEKPOINT_SIZE, available);
+			point_count = bytes ? (int)(available / FLAC_SEEKPOINT_SIZE) : 0;
+
+			for (int i = 0; i < point_count; i++) {
+				const uint8_t *entry = bytes + i * FLAC_SEEKPOINT_SIZE;
+				uint64_t sample = _read_be64(entry);
+				if (sample == FLAC_PLACEHOLDER_SEEKPOINT) {
+					continue;
+				}
+				SeekPoint point;
+				point.sample = (int64_t)sample;
+				point.offset = (int64_t)_read_be64(entry + 8); // Relative to the first frame for now.
+				table_points.push_back(point);
+			}
+		}
+
+		position += block_length;
+		if (position >= file_length) {
+			return false;
+		}
+	}
+
+	if (!found_stream_info) {
+		return false;
+	}
+
+	_first_frame_offset = position;
+	_seek_point_spacing = MAX((int64_t)_max_block_size, (int64_t)(_info.sample_rate / 4));
+
+	_seek_points.clear();
+	SeekPoint first_point;
+	first_point.sample = 0;
+	first_point.offset = _first_frame_offset;
+	_seek_points.push_back(first_point);
+
+	for (SeekPoint &point : table_points) {
+		point.offset += _first_frame_offset;
+		if (point.sample > 0 && point.sample < _info.frame_count && point.offset < file_length) {
+			_seek_points.push_back(point);
+		}
+	}
+	std::sort(_seek_points.begin(), _seek_points.end(), [](const SeekPoint &a, const SeekPoint &b) { return a.sample < b.sample; });
+
+	_block_samples.resize((size_t)_max_block_size * _info.channel_count);
+	_block_start = -1;
+	_block_length = 0;
+	_cursor_offset = _first_frame_offset;
+	_cursor_sample = 0;
+	return true;
+}
+
+void SiOPMWaveDecoderFLAC::_close_stream() {
+	_seek_points.clear();
+	_block_samples.clear();
+	_block_start = -1;
+	_block_length = 0;
+	_cursor_offset = 0;
+	_cursor_sample = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Seeking
+// ---------------------------------------------------------------------------
+
+void SiOPMWaveDecoderFLAC::_seek_cursor(int64_t p_sample) {
+	auto next = std::upper_bound(_seek_points.begin(), _seek_points.end(), p_sample, [](int64_t sample, const SeekPoint &point) { return sample < point.sample; });
+	const SeekPoint &point = *(next - 1); // The first point is at sample 0, so there is always one.
+
+	if (p_sample >= _cursor_sample && point.sample <= _cursor_sample) {
+		return; // Already on the way.
+	}
+
+	_cursor_sample = point.sample;
+	_cursor_offset = point.offset;
+}
+
+void SiOPMWaveDecoderFLAC::_record_seek_point(int64_t p_sample, int64_t p_offset) {
+	auto next = std::upper_bound(_seek_points.begin(), _seek_points.end(), p_sample, [](int64_t sample, const SeekPoint &point) { return sample < point.sample; });
+	if (p_sample - (next - 1)->sample < _seek_point_spacing) {
+		return;
+	}
+
+	SeekPoint point;
+	point.sample = p_sample;
+	point.offset = p_offset;
+	_seek_points.insert(next, point);
+}
+
+// ---------------------------------------------------------------------------
+// Frame decoding
+// ---------------------------------------------------------------------------
+
+bool SiOPMWaveDecoderFLAC::_decode_residual(FLACBitReader &p_reader, int p_predictor_order, int p_block_size, int32_t *r_out) const {
+	int method = (int)p_reader.read(2);
+	if (method > 1) {
+		return false;
+	}
+	int parameter_bits = (method == 0) ? 4 : 5;
+	uint32_t escape_code = (method == 0) ? 15 : 31;
+
+	int partition_order = (int)p_reader.read(4);
+	int partition_count = 1 << partition_order;
+	int partition_size = p_block_size >> partition_order;
+	if ((partition_size << partition_order) != p_block_size || partition_size < p_predictor_order) {
+		return false;
+	}
+
+	int sample_index = p_predictor_order;
+	for (int partition = 0; partition < partition_count; partition++) {
+		int count = (partition == 0) ? partition_size - p_predictor_order : partition_size;
+		uint32_t parameter = p_reader.read(parameter_bits);
+
+		if (parameter == escape_code) {
+			// Unencoded partition: fixed-width signed samples.
+			int bits = (int)p_reader.read(5);
+			for (int i = 0; i < count; i++) {
+				r_out[sample_index++] = p_reader.read_signed(bits);
+			}
+		} else {
+			for (int i = 0; i < count; i++) {
+				r_out[sample_index++] = p_reader.read_rice((int)parameter);
+			}
+		}
+
+		if (p_reader.has_overrun()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool SiOPMWaveDecoderFLAC::_decode_subframe(FLACBitReader &p_reader, int p_bits_per_sample, int p_block_size, int32_t *r_out) const {
+	if (p_reader.read(1) != 0) {
+		return false; // Zero padding bit.
+	}
+	int type = (int)p_reader.read(6);
+
+	int wasted_bits = 0;
+	if (p_reader.read(1)) {
+		wasted_bits = (int)p_reader.read_unary() + 1;
+	}
+	int bits = p_bits_per_sample - wasted_bits;
+	if (bits <= 0) {
+		return false;
+	}
+
+	if (type == 0) {
+		// CONSTANT
+		int32_t value = p_reader.read_signed(bits);
+		for (int i = 0; i < p_block_size; i++) {
+			r_out[i] = value;
+		}
+
+	} else if (type == 1) {
+		// VERBATIM
+		for (int i = 0; i < p_block_size; i++) {
+			r_out[i] = p_reader.read_signed(bits);
+		}
+
+	} else if (type >= 8 && type <= 12) {
+		// FIXED: polynomial predictors of order 0 to 4.
+		int order = type - 8;
+		if (order > p_block_size) {
+			return false;
+		}
+		for (int i = 0; i < order; i++) {
+			r_out[i] = p_reader.read_signed(bits);
+		}
+		if (!_decode_residual(p_reader, order, p_block_size, r_out)) {
+			return false;
+		}
+
+		switch (order) {
+			case 1:
+				for (int i = 1; i < p_block_size; i++) {
+					r_out[i] += r_out[i - 1];
+				}
+				break;
+			case 2:
+				for (int i = 2; i < p_block_size; i++) {
+					r_out[i] += (int32_t)(2 * (int64_t)r_out[i - 1] - r_out[i - 2]);
+				}
+				break;
+			case 3:
+				for (int i = 3; i < p_block_size; i++) {
+					r_out[i] += (int32_t)(3 * ((int64_t)r_out[i - 1] - r_out[i - 2]) + r_out[i - 3]);
+				}
+				break;
+			case 4:
+				for (int i = 4; i < p_block_size; i++) {
+					r_out[i] += (int32_t)(4 * ((int64_t)r_out[i - 1] + r_out[i - 3]) - 6 * (int64_t)r_out[i - 2] - r_out[i - 4]);
+				}
+				break;
+			default:
+				break;
+		}
+
+	} else if (type >= 32) {
+		// LPC
+		int order = (type & 0x1F) + 1;
+		if (order > p_block_size) {
+			return false;
+		}
+		for (int i = 0; i < order; i++) {
+			r_out[i] = p_reader.read_signed(bits);
+		}
+
+		int precision = (int)p_reader.read(4) + 1;
+		if (precision == 16) {
+			return false; // Reserved.
+		}
+		int shift = p_reader.read_signed(5);
+		if (shift < 0) {
+			return false;
+		}
+
+		int32_t coefficients[FLAC_MAX_LPC_ORDER];
+		for (int i = 0; i < order; i++) {
+			coefficients[i] = p_reader.read_signed(precision);
+		}
+		if (!_decode_residual(p_reader, order, p_block_size, r_out)) {
+			return false;
+		}
+
+		for (int i = order; i < p_block_size; i++) {
+			int64_t prediction = 0;
+			const int32_t *history = r_out + i;
+			for (int j = 0; j < order; j++) {
+				prediction += (int64_t)coefficients[j] * history[-1 - j];
+			}
+			r_out[i] += (int32_t)(prediction >> shift);
+		}
+
+	} else {
+		return false; // Reserved subframe type.
+	}
+
+	if (wasted_bits > 0) {
+		for (int i = 0; i < p_block_size; i++) {
+			r_out[i] = (int32_t)((uint32_t)r_out[i] << wasted_bits);
+		}
+	}
+
+	return !p_reader.has_overrun();
+}
+
+bool SiOPMWaveDecoderFLAC::_decode_next_frame() {
+	if (_cursor_sample >= _info.frame_count) {
+		return false;
+	}
+
+	int64_t available = 0;
+	const uint8_t *bytes = _get_bytes(_cursor_offset, _frame_read_size, available);
+	if (!bytes) {
+		return false;
+	}
+	FLACBitReader reader(bytes, available);
+
+	// Frame header.
+	if ((int)reader.read(14) != FLAC_FRAME_SYNC) {
+		return false;
+	}
+	reader.read(1); // Reserved.
+	bool variable_blocking = reader.read(1) != 0;
+	int block_size_code = (int)reader.read(4);
+	int sample_rate_code = (int)reader.read(4);
+	int channel_assignment = (int)reader.read(4);
+	int sample_size_code = (int)reader.read(3);
+	reader.read(1); // Reserved.
+
+	uint64_t coded_number = 0;
+	if (!reader.read_coded_number(coded_number)) {
+		return false;
+	}
+
+	int block_size = 0;
+	if (block_size_code == 0) {
+		return false; // Reserved.
+	} else if (block_size_code == 1) {
+		block_size = 192;
+	} else if (block_size_code <= 5) {
+		block_size = 576 << (block_size_code - 2);
+	} else if (block_size_code == 6) {
+		block_size = (int)reader.read(8) + 1;
+	} else if (block_size_code == 7) {
+		block_size = (int)reader.read(16) + 1;
+	} else {
+		block_size = 256 << (block_size_code - 8);
+	}
+
+	// The stream's sample rate from STREAMINFO applies; skip any per-frame override.
+	if (sample_rate_code == 12) {
+		reader.read(8);
+	} else if (sample_rate_code == 13 || sample_rate_code == 14) {
+		reader.read(16);
+	} else if (sample_rate_code == 15) {
+		return false;
+	}
+	reader.read(8); // CRC-8.
+
+	int bits_per_sample = 0;
+	switch (sample_size_code) {
+		case 0: bits_per_sample = _info.bits_per_sample; break;
+		case 1: bits_per_sample = 8; break;
+		case 2: bits_per_sample = 12; break;
+		case 4: bits_per_sample = 16; break;
+		case 5: bits_per_sample = 20; break;
+		case 6: bits_per_sample = 24; break;
+		default: return false; // Reserved, or 32-bit which isn't supported.
+	}
+
+	int channel_count = (channel_assignment < 8) ? channel_assignment + 1 : 2;
+	if (channel_assignment > FLAC_CHANNELS_MID_SIDE || channel_count != _info.channel_count) {
+		return false;
+	}
+	if (block_size > _max_block_size || reader.has_overrun()) {
+		return false;
+	}
+
+	int64_t frame_sample = variable_blocking ? (int64_t)coded_number : (int64_t)coded_number * _max_block_size;
+
+	// Subframes.
+	int32_t *left = _block_samples.data();
+	int32_t *right = left + _max_block_size;
+	for (int channel = 0; channel < channel_count; channel++) {
+		// The side channel needs one more bit than the others.
+		bool is_side = (channel_assignment == FLAC_CHANNELS_LEFT_SIDE && channel == 1)
+				|| (channel_assignment == FLAC_CHANNELS_SIDE_RIGHT && channel == 0)
+				|| (channel_assignment == FLAC_CHANNELS_MID_SIDE && channel == 1);
+		int32_t *out = (channel == 0) ? left : right;
+		if (!_decode_subframe(reader, bits_per_sample + (is_side ? 1 : 0), block_size, out)) {
+			return false;
+		}
+	}
+
+	// Stereo decorrelation.
+	switch (channel_assignment) {
+		case FLAC_CHANNELS_LEFT_SIDE:
+			for (int i = 0; i < block_size; i++) {
+				right[i] = left[i] - right[i];
+			}
+			break;
+		case FLAC_CHANNELS_SIDE_RIGHT:
+			for (int i = 0; i < block_size; i++) {
+				left[i] += right[i];
+			}
+			break;
+		case FLAC_CHANNELS_MID_SIDE:
+			for (int i = 0; i < block_size; i++) {
+				int32_t side = right[i];
+				int32_t mid = (int32_t)(((uint32_t)left[i] << 1) | (uint32_t)(side & 1));
+				left[i] = (mid + side) >> 1;
+				right[i] = (mid - side) >> 1;
+			}
+			break;
+		default:
+			break;
+	}
+
+	// Frame footer.
+	reader.align_to_byte();
+	reader.read(16); // CRC-16.
+	if (reader.has_overrun()) {
+		return false;
+	}
+
+	_record_seek_point(frame_sample, _cursor_offset);
+
+	_block_start = frame_sample;
+	_block_length = (int)MIN((int64_t)block_size, _info.frame_count - frame_sample);
+	_cursor_offset += reader.get_byte_position();
+	_cursor_sample = frame_sample + block_size;
+	return _block_length > 0;
+}
+
+int SiOPMWaveDecoderFLAC::_decode_frames(int64_t p_start_frame, int p_frame_count, double *r_out) {
+	const double scale = 1.0 / (double)(1 << (_info.bits_per_sample - 1));
+	const int channel_count = _info.channel_count;
+
+	int produced = 0;
+	while (produced < p_frame_count) {
+		int64_t position = p_start_frame + produced;
+
+		if (position < _block_start || position >= _block_start + _block_length) {
+			_seek_cursor(position);
+			if (!_decode_next_frame() || position < _block_start) {
+				// Corrupt data, or a frame numbered past where it should be; give up
+				// rather than loop forever.
+				break;
+			}
+			continue;
+		}
+
+		int offset = (int)(position - _block_start);
+		int count = MIN(p_frame_count - produced, _block_length - offset);
+		const int32_t *left = _block_samples.data() + offset;
+		double *dest = r_out + produced * channel_count;
+
+		if (channel_count == 2) {
+			const int32_t *right = left + _max_block_size;
+			for (int i = 0; i < count; i++) {
+				dest[i * 2] = left[i] * scale;
+				dest[i * 2 + 1] = right[i] * scale;
+			}
+		} else {
+			for (int i = 0; i < count; i++) {
+				dest[i] = left[i] * scale;
+			}
+		}
+		produced += count;
+	}
+
+	return produced;
+}
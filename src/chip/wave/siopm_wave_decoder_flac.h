@@ -0,0 +1,72 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SIOPM_WAVE_DECODER_FLAC_H
+#define SIOPM_WAVE_DECODER_FLAC_H
+
+#include "chip/wave/siopm_wave_decoder.h"
+
+#include <vector>
+
+using namespace godot;
+
+class FLACBitReader;
+
+// Decoder for native FLAC files (not Ogg FLAC): mono and stereo, 4 to 24 bits per sample.
+//
+// Frames are decoded one at a time, on demand, into a single block buffer. Seeking
+// starts from the closest known frame boundary: the file's SEEKTABLE if it has one,
+// plus the boundaries the decoder records itself as it goes, at least a quarter of a
+// second apart. A loop wrapping back to its start therefore lands near a recorded
+// boundary and only decodes a few frames to get there. CRCs are not verified.
+class SiOPMWaveDecoderFLAC : public SiOPMWaveDecoder {
+	struct SeekPoint {
+		int64_t sample = 0;
+		int64_t offset = 0; // Absolute byte offset of the frame starting at this sample.
+	};
+
+	int _min_block_size = 0;
+	int _max_block_size = 0;
+	int64_t _frame_read_size = 0; // Bytes requested per frame; never less than the largest possible frame.
+	int64_t _first_frame_offset = 0;
+	int64_t _seek_point_spacing = 0;
+	std::vector<SeekPoint> _seek_points; // Sorted by sample; always starts with the first frame.
+
+	// The next frame to decode.
+	int64_t _cursor_offset = 0;
+	int64_t _cursor_sample = 0;
+
+	// The most recently decoded frame, one run of _max_block_size samples per channel.
+	std::vector<int32_t> _block_samples;
+	int64_t _block_start = -1;
+	int _block_length = 0;
+
+	bool _parse_stream_info(const uint8_t *p_bytes);
+	bool _decode_next_frame();
+	bool _decode_subframe(FLACBitReader &p_reader, int p_bits_per_sample, int p_block_size, int32_t *r_out) const;
+	bool _decode_residual(FLACBitReader &p_reader, int p_predictor_order, int p_block_size, int32_t *r_out) const;
+
+	// Move the cursor to the closest known frame boundary at or before p_sample,
+	// unless decoding on from the current cursor gets there sooner.
+	void _seek_cursor(int64_t p_sample);
+	void _record_seek_point(int64_t p_sample, int64_t p_offset);
+
+protected:
+	virtual bool _open_stream() override;
+	virtual void _close_stream() override;
+	virtual int _decode_frames(int64_t p_start_frame, int p_frame_count, double *r_out) override;
+
+public:
+	static bool probe(const uint8_t *p_header, int p_length);
+	static SiOPMWaveDecoder *create();
+
+	virtual String get_format_name() const override { return "FLAC"; }
+
+	SiOPMWaveDecoderFLAC() {}
+	~SiOPMWaveDecoderFLAC() { close(); }
+};
+
+#endif // SIOPM_WAVE_DECODER_FLAC_H
@@ -0,0 +1,213 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#include "siopm_wave_decoder_qoa.h"
+
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <cmath>
+
+using namespace godot;
+
+static constexpr uint32_t QOA_MAGIC = 0x716f6166; // "qoaf"
+
+// Quantization step for each of the 16 scale factors: round((sf + 1) ^ 2.75).
+static const int _qoa_scalefactor_table[16] = { 1, 7, 21, 45, 84, 138, 211, 304, 421, 562, 731, 928, 1157, 1419, 1715, 2048 };
+
+struct QOADequantTable {
+	int values[16][8];
+
+	QOADequantTable() {
+		// Residual codes map to these multiples of the step, alternating in sign.
+		static const double dequant_steps[8] = { 0.75, -0.75, 2.5, -2.5, 4.5, -4.5, 7, -7 };
+		for (int i = 0; i < 16; i++) {
+			for (int j = 0; j < 8; j++) {
+				values[i][j] = (int)std::round(_qoa_scalefactor_table[i] * dequant_steps[j]);
+			}
+		}
+	}
+};
+
+static const QOADequantTable &_get_dequant_table() {
+	static const QOADequantTable table;
+	return table;
+}
+
+static inline uint64_t _read_be64(const uint8_t *p_bytes) {
+	uint64_t value = 0;
+	for (int i = 0; i < 8; i++) {
+		value = (value << 8) | p_bytes[i];
+	}
+	return value;
+}
+
+bool SiOPMWaveDecoderQOA::probe(const uint8_t *p_header, int p_length) {
+	return p_length >= 4 && ((uint32_t)p_header[0] << 24 | (uint32_t)p_header[1] << 16 | (uint32_t)p_header[2] << 8 | (uint32_t)p_header[3]) == QOA_MAGIC;
+}
+
+SiOPMWaveDecoder *SiOPMWaveDecoderQOA::create() {
+	return memnew(SiOPMWaveDecoderQOA);
+}
+
+// ---------------------------------------------------------------------------
+// Header parsing
+// ---------------------------------------------------------------------------
+
+bool SiOPMWaveDecoderQOA::_open_stream() {
+	int64_t available = 0;
+	const uint8_t *bytes = _get_bytes(0, FILE_HEADER_SIZE + FRAME_HEADER_SIZE, available);
+	if (!bytes || available < FILE_HEADER_SIZE + FRAME_HEADER_SIZE) {
+		return false;
+	}
+
+	uint64_t file_header = _read_be64(bytes);
+	if ((uint32_t)(file_header >> 32) != QOA_MAGIC) {
+		return false;
+	}
+	int64_t total_samples = (int64_t)(file_header & 0xffffffff);
+	if (total_samples == 0) {
+		return false; // Streaming mode; the length is unknown.
+	}
+
+	// Channel count and sample rate are constant across a static file; take them from the first frame.
+	uint64_t frame_header = _read_be64(bytes + FILE_HEADER_SIZE);
+	int channel_count = (int)((frame_header >> 56) & 0xff);
+	int sample_rate = (int)((frame_header >> 32) & 0xffffff);
+	if (channel_count < 1 || channel_count > 2 || sample_rate <= 0) {
+		return false;
+	}
+
+	_info.channel_count = channel_count;
+	_info.sample_rate = sample_rate;
+	_info.bits_per_sample = 16;
+	_info.frame_count = total_samples;
+
+	_frame_size = FRAME_HEADER_SIZE + channel_count * LMS_LENGTH * 4 + (int64_t)SLICES_PER_FRAME * 8 * channel_count;
+	_frame_samples.resize((size_t)FRAME_LENGTH * channel_count);
+	_frame_index = -1;
+	_frame_length = 0;
+	return true;
+}
+
+void SiOPMWaveDecoderQOA::_close_stream() {
+	_frame_samples.clear();
+	_frame_index = -1;
+	_frame_length = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Decoding
+// ---------------------------------------------------------------------------
+
+bool SiOPMWaveDecoderQOA::_decode_frame(int64_t p_frame_index) {
+	int64_t available = 0;
+	const uint8_t *bytes = _get_bytes(FILE_HEADER_SIZE + p_frame_index * _frame_size, _frame_size, available);
+	if (!bytes || available < FRAME_HEADER_SIZE) {
+		return false;
+	}
+
+	uint64_t frame_header = _read_be64(bytes);
+	int channel_count = (int)((frame_header >> 56) & 0xff);
+	int sample_count = (int)((frame_header >> 16) & 0xffff);
+	int frame_size = (int)(frame_header & 0xffff);
+
+	int lms_size = channel_count * LMS_LENGTH * 4;
+	int slice_count = (frame_size - FRAME_HEADER_SIZE - lms_size) / 8;
+	if (channel_count != _info.channel_count || frame_size > available || sample_count <= 0 || sample_count > FRAME_LENGTH
+			|| slice_count * SLICE_LENGTH < sample_count * channel_count) {
+		return false;
+	}
+
+	const uint8_t *read = bytes + FRAME_HEADER_SIZE;
+
+	LMSState lms[2];
+	for (int c = 0; c < channel_count; c++) {
+		uint64_t history = _read_be64(read);
+		uint64_t weights = _read_be64(read + 8);
+		read += 16;
+		for (int i = 0; i < LMS_LENGTH; i++) {
+			lms[c].history[i] = (int16_t)(history >> 48);
+			lms[c].weights[i] = (int16_t)(weights >> 48);
+			history <<= 16;
+			weights <<= 16;
+		}
+	}
+
+	const QOADequantTable &dequant = _get_dequant_table();
+	int16_t *out = _frame_samples.data();
+
+	// Slices are interleaved by channel, 20 samples each.
+	for (int sample_index = 0; sample_index < sample_count; sample_index += SLICE_LENGTH) {
+		int slice_end = MIN(sample_index + SLICE_LENGTH, sample_count);
+
+		for (int c = 0; c < channel_count; c++) {
+			uint64_t slice = _read_be64(read);
+			read += 8;
+
+			int scalefactor = (int)((slice >> 60) & 0xf);
+			slice <<= 4;
+			LMSState &state = lms[c];
+
+			for (int i = sample_index; i < slice_end; i++) {
+				int predicted = 0;
+				for (int k = 0; k < LMS_LENGTH; k++) {
+					predicted += state.weights[k] * state.history[k];
+				}
+				predicted >>= 13;
+
+				int quantized = (int)((slice >> 61) & 0x7);
+				int dequantized = dequant.values[scalefactor][quantized];
+				int reconstructed = CLAMP(predicted + dequantized, -32768, 32767);
+				slice <<= 3;
+
+				out[i * channel_count + c] = (int16_t)reconstructed;
+
+				// Sign-sign LMS update.
+				int delta = dequantized >> 4;
+				for (int k = 0; k < LMS_LENGTH; k++) {
+					state.weights[k] += state.history[k] < 0 ? -delta : delta;
+				}
+				for (int k = 0; k < LMS_LENGTH - 1; k++) {
+					state.history[k] = state.history[k + 1];
+				}
+				state.history[LMS_LENGTH - 1] = reconstructed;
+			}
+		}
+	}
+
+	_frame_index = p_frame_index;
+	_frame_length = sample_count;
+	return true;
+}
+
+int SiOPMWaveDecoderQOA::_decode_frames(int64_t p_start_frame, int p_frame_count, double *r_out) {
+	const double scale = 1.0 / 32768.0;
+	const int channel_count = _info.channel_count;
+
+	int produced = 0;
+	while (produced < p_frame_count) {
+		int64_t position = p_start_frame + produced;
+		int64_t frame_index = position / FRAME_LENGTH;
+		if (frame_index != _frame_index && !_decode_frame(frame_index)) {
+			break;
+		}
+
+		int offset = (int)(position - frame_index * FRAME_LENGTH);
+		int count = MIN(p_frame_count - produced, _frame_length - offset);
+		if (count <= 0) {
+			break;
+		}
+
+		const int16_t *source = _frame_samples.data() + offset * channel_count;
+		double *dest = r_out + produced * channel_count;
+		for (int i = 0; i < count * channel_count; i++) {
+			dest[i] = source[i] * scale;
+		}
+		produced += count;
+	}
+
+	return produced;
+}
@@ -0,0 +1,60 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SIOPM_WAVE_DECODER_QOA_H
+#define SIOPM_WAVE_DECODER_QOA_H
+
+#include "chip/wave/siopm_wave_decoder.h"
+
+#include <vector>
+
+using namespace godot;
+
+// Decoder for QOA ("Quite OK Audio") files, a lossy 16-bit codec at a fixed
+// 3.2 bits per sample that costs next to nothing to decode.
+//
+// A QOA file is a sequence of independent frames of 5120 samples per channel, each
+// carrying its own predictor state. Every frame but the last has the same size, so
+// seeking is a multiplication, and only the frame containing the read position is
+// ever decoded. Files written in streaming mode (no total sample count) aren't supported.
+class SiOPMWaveDecoderQOA : public SiOPMWaveDecoder {
+	static constexpr int SLICE_LENGTH = 20;
+	static constexpr int SLICES_PER_FRAME = 256;
+	static constexpr int FRAME_LENGTH = SLICE_LENGTH * SLICES_PER_FRAME;
+	static constexpr int FILE_HEADER_SIZE = 8;
+	static constexpr int FRAME_HEADER_SIZE = 8;
+	static constexpr int LMS_LENGTH = 4;
+
+	struct LMSState {
+		int history[LMS_LENGTH] = {};
+		int weights[LMS_LENGTH] = {};
+	};
+
+	int64_t _frame_size = 0; // Byte size of every frame but the last.
+
+	// The most recently decoded frame, interleaved.
+	std::vector<int16_t> _frame_samples;
+	int64_t _frame_index = -1;
+	int _frame_length = 0;
+
+	bool _decode_frame(int64_t p_frame_index);
+
+protected:
+	virtual bool _open_stream() override;
+	virtual void _close_stream() override;
+	virtual int _decode_frames(int64_t p_start_frame, int p_frame_count, double *r_out) override;
+
+public:
+	static bool probe(const uint8_t *p_header, int p_length);
+	static SiOPMWaveDecoder *create();
+
+	virtual String get_format_name() const override { return "QOA"; }
+
+	SiOPMWaveDecoderQOA() {}
+	~SiOPMWaveDecoderQOA() { close(); }
+};
+
+#endif // SIOPM_WAVE_DECODER_QOA_H
@@ -0,0 +1,193 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#include "siopm_wave_decoder_wav.h"
+
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <cstring>
+
+using namespace godot;
+
+// WAV chunk IDs (little-endian uint32).
+static constexpr uint32_t WAV_RIFF = 0x46464952; // "RIFF"
+static constexpr uint32_t WAV_WAVE = 0x45564157; // "WAVE"
+static constexpr uint32_t WAV_FMT  = 0x20746D66; // "fmt "
+static constexpr uint32_t WAV_DATA = 0x61746164; // "data"
+
+// WAV format codes.
+static constexpr int WAV_FORMAT_PCM   = 1;
+static constexpr int WAV_FORMAT_FLOAT = 3;
+
+static inline uint16_t _read_le16(const uint8_t *p_bytes) {
+	return (uint16_t)p_bytes[0] | ((uint16_t)p_bytes[1] << 8);
+}
+
+static inline uint32_t _read_le32(const uint8_t *p_bytes) {
+	return (uint32_t)p_bytes[0] | ((uint32_t)p_bytes[1] << 8) | ((uint32_t)p_bytes[2] << 16) | ((uint32_t)p_bytes[3] << 24);
+}
+
+bool SiOPMWaveDecoderWAV::probe(const uint8_t *p_header, int p_length) {
+	return p_length >= 12 && _read_le32(p_header) == WAV_RIFF && _read_le32(p_header + 8) == WAV_WAVE;
+}
+
+SiOPMWaveDecoder *SiOPMWaveDecoderWAV::create() {
+	return memnew(SiOPMWaveDecoderWAV);
+}
+
+// ---------------------------------------------------------------------------
+// Header parsing
+// ---------------------------------------------------------------------------
+
+bool SiOPMWaveDecoderWAV::_open_stream() {
+	int64_t available = 0;
+	const uint8_t *bytes = _get_bytes(0, 12, available);
+	if (!bytes || available < 12 || !probe(bytes, (int)available)) {
+		return false;
+	}
+
+	bool found_fmt = false;
+	bool found_data = false;
+	int64_t file_length = _get_file_length();
+	int64_t position = 12;
+
+	while (position < file_length - 8) {
+		bytes = _get_bytes(position, 8, available);
+		if (!bytes || available < 8) {
+			break;
+		}
+		uint32_t chunk_id = _read_le32(bytes);
+		uint32_t chunk_size = _read_le32(bytes + 4);
+		int64_t chunk_start = position + 8;
+
+		if (chunk_id == WAV_FMT) {
+			if (chunk_size < 16) {
+				return false;
+			}
+			bytes = _get_bytes(chunk_start, 16, available);
+			if (!bytes || available < 16) {
+				return false;
+			}
+
+			_audio_format = _read_le16(bytes);
+			_info.channel_count = _read_le16(bytes + 2);
+			_info.sample_rate = (int)_read_le32(bytes + 4);
+			// Skipping byte_rate and block_align.
+			_info.bits_per_sample = _read_le16(bytes + 14);
+
+			if (_audio_format != WAV_FORMAT_PCM && _audio_format != WAV_FORMAT_FLOAT) {
+				return false;
+			}
+			if (_info.channel_count < 1 || _info.channel_count > 2) {
+				return false;
+			}
+			if (_info.bits_per_sample != 8 && _info.bits_per_sample != 16 && _info.bits_per_sample != 24 && _info.bits_per_sample != 32) {
+				return false;
+			}
+			if (_audio_format == WAV_FORMAT_FLOAT && _info.bits_per_sample != 32) {
+				return false;
+			}
+
+			_bytes_per_frame = _info.channel_count * (_info.bits_per_sample / 8);
+			found_fmt = true;
+
+		} else if (chunk_id == WAV_DATA) {
+			_data_offset = chunk_start;
+			// Truncated files are common (interrupted recordings); trust the file length over the header.
+			_data_size = MIN((int64_t)chunk_size, file_length - chunk_start);
+			found_data = true;
+		}
+
+		// Advance to next chunk (chunks are word-aligned).
+		position = chunk_start + chunk_size;
+		if (chunk_size & 1) {
+			position++; // Padding byte.
+		}
+
+		if (found_fmt && found_data) {
+			break;
+		}
+	}
+
+	if (!found_fmt || !found_data || _bytes_per_frame <= 0) {
+		return false;
+	}
+
+	_info.frame_count = _data_size / _bytes_per_frame;
+	return _info.frame_count > 0;
+}
+
+// ---------------------------------------------------------------------------
+// Decoding
+// ---------------------------------------------------------------------------
+
+// Each format gets its own tight loop with no per-sample branching, so the compiler
+// can vectorize the conversion. Samples are assembled byte by byte, which keeps the
+// code endian-independent and free of unaligned loads; compilers fold the pattern
+// into a single load on little-endian targets.
+void SiOPMWaveDecoderWAV::_decode_samples(const uint8_t *p_raw, int p_sample_count, double *r_out) const {
+	if (_audio_format == WAV_FORMAT_FLOAT) {
+		for (int i = 0; i < p_sample_count; i++) {
+			float sample;
+			memcpy(&sample, p_raw + i * 4, sizeof(float));
+			r_out[i] = (double)sample;
+		}
+		return;
+	}
+
+	switch (_info.bits_per_sample) {
+		case 8: {
+			// 8-bit PCM WAV is unsigned: 0..255 with 128 representing zero.
+			const double scale = (1.0 / 128.0);
+			for (int i = 0; i < p_sample_count; i++) {
+				r_out[i] = ((int)p_raw[i] - 128) * scale;
+			}
+		} break;
+
+		case 16: {
+			const double scale = (1.0 / 32768.0);
+			for (int i = 0; i < p_sample_count; i++) {
+				int16_t sample = (int16_t)((uint16_t)p_raw[i * 2] | ((uint16_t)p_raw[i * 2 + 1] << 8));
+				r_out[i] = (double)sample * scale;
+			}
+		} break;
+
+		case 24: {
+			const double scale = (1.0 / 8388608.0);
+			for (int i = 0; i < p_sample_count; i++) {
+				const uint8_t *bytes = p_raw + i * 3;
+				// Assemble in the top three bytes, then shift down to sign-extend.
+				int32_t sample = (int32_t)(((uint32_t)bytes[0] << 8) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 24)) >> 8;
+				r_out[i] = (double)sample * scale;
+			}
+		} break;
+
+		case 32: {
+			const double scale = (1.0 / 2147483648.0);
+			for (int i = 0; i < p_sample_count; i++) {
+				const uint8_t *bytes = p_raw + i * 4;
+				int32_t sample = (int32_t)((uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24));
+				r_out[i] = (double)sample * scale;
+			}
+		} break;
+	}
+}
+
+int SiOPMWaveDecoderWAV::_decode_frames(int64_t p_start_frame, int p_frame_count, double *r_out) {
+	int64_t byte_offset = _data_offset + p_start_frame * _bytes_per_frame;
+	int64_t byte_count = (int64_t)p_frame_count * _bytes_per_frame;
+
+	// With a mapped file this reads the pages directly.
+	int64_t available = 0;
+	const uint8_t *raw = _get_bytes(byte_offset, byte_count, available);
+	int frames = (int)(available / _bytes_per_frame);
+	if (!raw || frames <= 0) {
+		return 0;
+	}
+
+	_decode_samples(raw, frames * _info.channel_count, r_out);
+	return frames;
+}
@@ -0,0 +1,39 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SIOPM_WAVE_DECODER_WAV_H
+#define SIOPM_WAVE_DECODER_WAV_H
+
+#include "chip/wave/siopm_wave_decoder.h"
+
+using namespace godot;
+
+// Decoder for RIFF WAV files: mono and stereo, 8/16/24/32-bit integer PCM or 32-bit float.
+// Frames are converted straight from the mapped pages into the caller's buffer.
+class SiOPMWaveDecoderWAV : public SiOPMWaveDecoder {
+	int _audio_format = 0; // 1 = PCM integer, 3 = IEEE float.
+	int _bytes_per_frame = 0;
+	int64_t _data_offset = 0; // Byte offset of the audio data chunk in the file.
+	int64_t _data_size = 0;   // Byte size of the audio data chunk.
+
+	// Convert raw little-endian samples to normalized values in [-1, 1].
+	void _decode_samples(const uint8_t *p_raw, int p_sample_count, double *r_out) const;
+
+protected:
+	virtual bool _open_stream() override;
+	virtual int _decode_frames(int64_t p_start_frame, int p_frame_count, double *r_out) override;
+
+public:
+	static bool probe(const uint8_t *p_header, int p_length);
+	static SiOPMWaveDecoder *create();
+
+	virtual String get_format_name() const override { return "WAV"; }
+
+	SiOPMWaveDecoderWAV() {}
+	~SiOPMWaveDecoderWAV() { close(); }
+};
+
+#endif // SIOPM_WAVE_DECODER_WAV_H
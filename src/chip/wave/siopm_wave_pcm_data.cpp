@@ -182,7 +182,7 @@ void SiOPMWavePCMData::loop_tail_samples(int p_sample_count, int p_tail_margin,
 
 		int offset = _loop_point << (_channel_count - 1);
 		int envelope_top = (-SiOPMRefTable::ENV_TOP) << 3;
-		int (&log_table)[SiOPMRefTable::LOG_TABLE_SIZE * 3] = SiOPMRefTable::get_instance()->log_table;
+		const int (&log_table)[SiOPMRefTable::LOG_TABLE_SIZE * 3] = SiOPMRefTable::get_instance()->log_table;
 		double i2n = 1.0 / (1 << SiOPMRefTable::LOG_VOLUME_BITS);
 
 		for (int i = 0; i < max_idx; i++) {
@@ -9,9 +9,9 @@
 #include "sion_enums.h"
 #include "chip/siopm_ref_table.h"
 
-Ref<SiOPMWaveSamplerData> SiOPMWaveSamplerTable::get_sample(int p_sample_number) const {
-	if (_stencil.is_valid() && _stencil->_table[p_sample_number].is_valid()) {
-		return _stencil->_table[p_sample_number];
+Ref<SiOPMWaveSamplerData> SiOPMWaveSamplerTable::get_sample(int p_sample_number, const SiOPMWaveSamplerTable *p_stencil) const {
+	if (p_stencil && p_stencil->_table[p_sample_number].is_valid()) {
+		return p_stencil->_table[p_sample_number];
 	}
 
 	return _table[p_sample_number];
@@ -16,18 +16,14 @@ using namespace godot;
 class SiOPMWaveSamplerTable : public SiOPMWaveBase {
 	GDCLASS(SiOPMWaveSamplerTable, SiOPMWaveBase)
 
-	// Stencil table; search sample in stencil table before seaching in this instance's own table.
-	Ref<SiOPMWaveSamplerTable> _stencil;
 	Vector<Ref<SiOPMWaveSamplerData>> _table;
 
 protected:
 	static void _bind_methods();
 
 public:
-	Ref<SiOPMWaveSamplerTable> get_stencil() const { return _stencil; }
-	void set_stencil(const Ref<SiOPMWaveSamplerTable> &p_table) { _stencil = p_table; }
-
-	Ref<SiOPMWaveSamplerData> get_sample(int p_sample_number) const;
+	// Samples of p_stencil, if given, take precedence over this instance's own table.
+	Ref<SiOPMWaveSamplerData> get_sample(int p_sample_number, const SiOPMWaveSamplerTable *p_stencil = nullptr) const;
 	void set_sample(const Ref<SiOPMWaveSamplerData> &p_sample, int p_key_range_from = 0, int p_key_range_to = -1);
 
 	void clear();
@@ -8,30 +8,34 @@
 
 #include <godot_cpp/core/error_macros.hpp>
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <chrono>
+#include <limits>
 
 using namespace godot;
 
-// WAV chunk IDs (little-endian uint32).
-static constexpr uint32_t WAV_RIFF = 0x46464952; // "RIFF"
-static constexpr uint32_t WAV_WAVE = 0x45564157; // "WAVE"
-static constexpr uint32_t WAV_FMT  = 0x20746D66; // "fmt "
-static constexpr uint32_t WAV_DATA = 0x61746164; // "data"
-
-// WAV format codes.
-static constexpr int WAV_FORMAT_PCM   = 1;
-static constexpr int WAV_FORMAT_FLOAT = 3;
+// Upper bound on how long an idle loader sleeps without a wakeup. Producers on the
+// audio thread notify without taking the wake mutex, so a notification can slip in
+// between a loader checking the queue and going to sleep; this bounds that case.
+static constexpr int LOADER_WAKE_TIMEOUT_MS = 5;
 
 // ---------------------------------------------------------------------------
-// Static loader thread state
+// Static loader pool state
 // ---------------------------------------------------------------------------
 
-std::thread SiOPMWaveStreamData::_s_loader_thread;
+std::vector<std::thread> SiOPMWaveStreamData::_s_loader_threads;
 std::atomic<bool> SiOPMWaveStreamData::_s_loader_running{false};
+int SiOPMWaveStreamData::_s_loader_thread_count = SiOPMWaveStreamData::DEFAULT_LOADER_THREAD_COUNT;
+std::mutex SiOPMWaveStreamData::_s_wake_mutex;
+std::condition_variable SiOPMWaveStreamData::_s_wake_cv;
 std::atomic<SiOPMWaveStreamData *> SiOPMWaveStreamData::_s_queue_head{nullptr};
 
+int64_t SiOPMWaveStreamData::_s_preroll_budget = SiOPMWaveStreamData::DEFAULT_PREROLL_BUDGET;
+std::atomic<int64_t> SiOPMWaveStreamData::_s_preroll_memory_used{0};
+
 // ---------------------------------------------------------------------------
 // Utility: next power of 2
 // ---------------------------------------------------------------------------
@@ -54,7 +58,9 @@ static int _next_power_of_2(int p_value) {
 // ---------------------------------------------------------------------------
 
 void SiOPMWaveStreamData::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("load_file", "file_path", "ring_capacity"), &SiOPMWaveStreamData::load_file, DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("load_wav", "file_path", "ring_capacity"), &SiOPMWaveStreamData::load_wav, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("get_format_name"), &SiOPMWaveStreamData::get_format_name);
 	ClassDB::bind_method(D_METHOD("configure_live", "source_sample_rate", "channel_count", "ring_capacity"), &SiOPMWaveStreamData::configure_live, DEFVAL(2), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("is_valid"), &SiOPMWaveStreamData::is_valid);
 	ClassDB::bind_method(D_METHOD("is_live_stream"), &SiOPMWaveStreamData::is_live_stream);
@@ -66,6 +72,9 @@ void SiOPMWaveStreamData::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_live_dropped_frames"), &SiOPMWaveStreamData::get_live_dropped_frames);
 	ClassDB::bind_method(D_METHOD("get_ring_capacity"), &SiOPMWaveStreamData::get_ring_capacity);
 	ClassDB::bind_method(D_METHOD("get_ring_available"), &SiOPMWaveStreamData::get_ring_available);
+	ClassDB::bind_method(D_METHOD("get_underrun_count"), &SiOPMWaveStreamData::get_underrun_count);
+	ClassDB::bind_method(D_METHOD("get_underrun_frames"), &SiOPMWaveStreamData::get_underrun_frames);
+	ClassDB::bind_method(D_METHOD("reset_underrun_counters"), &SiOPMWaveStreamData::reset_underrun_counters);
 	ClassDB::bind_method(D_METHOD("set_in_sample", "sample"), &SiOPMWaveStreamData::set_in_sample);
 	ClassDB::bind_method(D_METHOD("get_in_sample"), &SiOPMWaveStreamData::get_in_sample);
 	ClassDB::bind_method(D_METHOD("set_out_sample", "sample"), &SiOPMWaveStreamData::set_out_sample);
@@ -75,10 +84,24 @@ void SiOPMWaveStreamData::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_loop_region", "start_sample", "end_sample"), &SiOPMWaveStreamData::set_loop_region);
 	ClassDB::bind_method(D_METHOD("get_loop_start_sample"), &SiOPMWaveStreamData::get_loop_start_sample);
 	ClassDB::bind_method(D_METHOD("get_loop_end_sample"), &SiOPMWaveStreamData::get_loop_end_sample);
+	ClassDB::bind_method(D_METHOD("set_preroll_length", "seconds"), &SiOPMWaveStreamData::set_preroll_length);
+	ClassDB::bind_method(D_METHOD("get_preroll_length"), &SiOPMWaveStreamData::get_preroll_length);
+	ClassDB::bind_method(D_METHOD("add_cue_point", "sample"), &SiOPMWaveStreamData::add_cue_point);
+	ClassDB::bind_method(D_METHOD("remove_cue_point", "sample"), &SiOPMWaveStreamData::remove_cue_point);
+	ClassDB::bind_method(D_METHOD("clear_cue_points"), &SiOPMWaveStreamData::clear_cue_points);
+	ClassDB::bind_method(D_METHOD("get_cue_points"), &SiOPMWaveStreamData::get_cue_points);
+	ClassDB::bind_method(D_METHOD("rebuild_preroll"), &SiOPMWaveStreamData::rebuild_preroll);
+	ClassDB::bind_method(D_METHOD("get_preroll_frames"), &SiOPMWaveStreamData::get_preroll_frames);
 	ClassDB::bind_method(D_METHOD("activate"), &SiOPMWaveStreamData::activate);
 	ClassDB::bind_method(D_METHOD("deactivate"), &SiOPMWaveStreamData::deactivate);
 	ClassDB::bind_method(D_METHOD("seek", "position_sample"), &SiOPMWaveStreamData::seek);
 	ClassDB::bind_method(D_METHOD("prefill_sync"), &SiOPMWaveStreamData::prefill_sync);
+
+	ClassDB::bind_static_method("SiOPMWaveStreamData", D_METHOD("get_loader_thread_count"), &SiOPMWaveStreamData::get_loader_thread_count);
+	ClassDB::bind_static_method("SiOPMWaveStreamData", D_METHOD("set_loader_thread_count", "count"), &SiOPMWaveStreamData::set_loader_thread_count);
+	ClassDB::bind_static_method("SiOPMWaveStreamData", D_METHOD("get_preroll_budget"), &SiOPMWaveStreamData::get_preroll_budget);
+	ClassDB::bind_static_method("SiOPMWaveStreamData", D_METHOD("set_preroll_budget", "bytes"), &SiOPMWaveStreamData::set_preroll_budget);
+	ClassDB::bind_static_method("SiOPMWaveStreamData", D_METHOD("get_preroll_memory_usage"), &SiOPMWaveStreamData::get_preroll_memory_usage);
 }
 
 // ---------------------------------------------------------------------------
@@ -88,35 +111,59 @@ void SiOPMWaveStreamData::_bind_methods() {
 SiOPMWaveStreamData::SiOPMWaveStreamData(const String &p_file_path, int p_ring_capacity) :
 		SiOPMWaveBase(SiONModuleType::MODULE_STREAM) {
 	if (!p_file_path.is_empty()) {
-		load_wav(p_file_path, p_ring_capacity);
+		load_file(p_file_path, p_ring_capacity);
 	}
 }
 
 SiOPMWaveStreamData::~SiOPMWaveStreamData() {
 	_active.store(false, std::memory_order_release);
 	_s_wait_until_idle(this);
-	_loader_file = Ref<FileAccess>();
+	_close_decoder();
+	// Channels hold a reference to this stream while they use its pre-roll, so there
+	// are no readers left and everything is freed here.
+	_swap_preroll_cache(nullptr);
+}
+
+void SiOPMWaveStreamData::_close_decoder() {
+	if (_decoder) {
+		memdelete(_decoder);
+		_decoder = nullptr;
+	}
+}
+
+String SiOPMWaveStreamData::get_format_name() const {
+	return _decoder ? _decoder->get_format_name() : String();
 }
 
 // ---------------------------------------------------------------------------
-// load_wav
+// load_file
 // ---------------------------------------------------------------------------
 
-bool SiOPMWaveStreamData::load_wav(const String &p_file_path, int p_ring_capacity) {
+bool SiOPMWaveStreamData::load_file(const String &p_file_path, int p_ring_capacity) {
 	// Clean up any existing state.
 	deactivate();
 	_s_wait_until_idle(this);
-	_loader_file = Ref<FileAccess>();
+	_close_decoder();
+	_swap_preroll_cache(nullptr);
+	_cue_points.clear(); // Positions belong to the previous file.
 	_valid = false;
 	_live_mode = false;
 	_file_path = p_file_path;
 	_live_dropped_frames.store(0, std::memory_order_relaxed);
+	_consumption_rate.store(0, std::memory_order_relaxed);
+	reset_underrun_counters();
 
-	if (!_parse_wav_header()) {
-		ERR_PRINT("SiOPMWaveStreamData: Failed to parse WAV header: " + p_file_path);
+	_decoder = SiOPMWaveDecoder::create_for_file(p_file_path);
+	if (!_decoder) {
+		ERR_PRINT("SiOPMWaveStreamData: Failed to open audio file, or its format is not supported: " + p_file_path);
 		return false;
 	}
 
+	const SiOPMWaveDecoder::Info &info = _decoder->get_info();
+	_source_sample_rate = info.sample_rate;
+	_channel_count = info.channel_count;
+	_total_source_frames = (int)MIN(info.frame_count, (int64_t)INT32_MAX);
+
 	// Allocate ring buffer (power of 2).
 	int capacity = (p_ring_capacity > 0) ? p_ring_capacity : DEFAULT_RING_CAPACITY;
 	_ring_capacity = _next_power_of_2(capacity);
@@ -126,15 +173,13 @@ bool SiOPMWaveStreamData::load_wav(const String &p_file_path, int p_ring_capacit
 	_ring_write_pos.store(0, std::memory_order_relaxed);
 
 	// Reset loader state.
-	_file_read_pos_frames = 0;
 	_decode_pos_frames = 0;
-	_decode_buf_valid = 0;
-	_loader_file = Ref<FileAccess>();
 
 	_valid = true;
 
 	// Synchronous prefill so data is immediately available for playback.
 	prefill_sync();
+	rebuild_preroll();
 
 	return true;
 }
@@ -142,7 +187,9 @@ bool SiOPMWaveStreamData::load_wav(const String &p_file_path, int p_ring_capacit
 bool SiOPMWaveStreamData::configure_live(int p_source_sample_rate, int p_channel_count, int p_ring_capacity) {
 	deactivate();
 	_s_wait_until_idle(this);
-	_loader_file = Ref<FileAccess>();
+	_close_decoder();
+	_swap_preroll_cache(nullptr);
+	_cue_points.clear();
 
 	ERR_FAIL_COND_V_MSG(p_source_sample_rate <= 0, false, "SiOPMWaveStreamData: Live stream requires a positive source sample rate.");
 	ERR_FAIL_COND_V_MSG(p_channel_count < 1 || p_channel_count > 2, false, "SiOPMWaveStreamData: Live stream supports mono or stereo PCM.");
@@ -150,16 +197,8 @@ bool SiOPMWaveStreamData::configure_live(int p_source_sample_rate, int p_channel
 	_file_path = String();
 	_source_sample_rate = p_source_sample_rate;
 	_channel_count = p_channel_count;
-	_bits_per_sample = 32;
-	_audio_format = WAV_FORMAT_FLOAT;
-	_data_offset = 0;
-	_data_size = 0;
-	_bytes_per_frame = _channel_count * (int)sizeof(float);
 	_total_source_frames = 0;
-	_decode_buf_valid = 0;
-	_file_read_pos_frames = 0;
 	_decode_pos_frames = 0;
-	_decode_buffer.resize(0);
 
 	int capacity = (p_ring_capacity > 0) ? p_ring_capacity : DEFAULT_RING_CAPACITY;
 	_ring_capacity = _next_power_of_2(capacity);
@@ -168,6 +207,8 @@ bool SiOPMWaveStreamData::configure_live(int p_source_sample_rate, int p_channel
 	_ring_read_pos.store(0, std::memory_order_relaxed);
 	_ring_write_pos.store(0, std::memory_order_relaxed);
 	_live_dropped_frames.store(0, std::memory_order_relaxed);
+	_consumption_rate.store(0, std::memory_order_relaxed);
+	reset_underrun_counters();
 	_seek_requested.store(false, std::memory_order_relaxed);
 	_seek_target.store(0, std::memory_order_relaxed);
 	_in_sample.store(0, std::memory_order_relaxed);
@@ -181,99 +222,6 @@ bool SiOPMWaveStreamData::configure_live(int p_source_sample_rate, int p_channel
 	return true;
 }
 
-// ---------------------------------------------------------------------------
-// WAV header parsing
-// ---------------------------------------------------------------------------
-
-bool SiOPMWaveStreamData::_parse_wav_header() {
-	Ref<FileAccess> file = FileAccess::open(_file_path, FileAccess::READ);
-	if (file.is_null()) {
-		return false;
-	}
-
-	// RIFF header.
-	uint32_t riff_id = file->get_32();
-	file->get_32(); // file size
-	uint32_t wave_id = file->get_32();
-
-	if (riff_id != WAV_RIFF || wave_id != WAV_WAVE) {
-		ERR_PRINT("SiOPMWaveStreamData: Not a valid WAV file.");
-		return false;
-	}
-
-	bool found_fmt = false;
-	bool found_data = false;
-
-	while (file->get_position() < file->get_length() - 8) {
-		uint32_t chunk_id = file->get_32();
-		uint32_t chunk_size = file->get_32();
-		int64_t chunk_start = file->get_position();
-
-		if (chunk_id == WAV_FMT) {
-			if (chunk_size < 16) {
-				ERR_PRINT("SiOPMWaveStreamData: fmt chunk too small.");
-				return false;
-			}
-
-			_audio_format = file->get_16();
-			_channel_count = file->get_16();
-			_source_sample_rate = file->get_32();
-			file->get_32(); // byte_rate
-			file->get_16(); // block_align
-			_bits_per_sample = file->get_16();
-
-			if (_audio_format != WAV_FORMAT_PCM && _audio_format != WAV_FORMAT_FLOAT) {
-				ERR_PRINT("SiOPMWaveStreamData: Unsupported WAV format code: " + itos(_audio_format));
-				return false;
-			}
-			if (_channel_count < 1 || _channel_count > 2) {
-				ERR_PRINT("SiOPMWaveStreamData: Unsupported channel count: " + itos(_channel_count));
-				return false;
-			}
-			if (_bits_per_sample != 8 && _bits_per_sample != 16 && _bits_per_sample != 24 && _bits_per_sample != 32) {
-				ERR_PRINT("SiOPMWaveStreamData: Unsupported bits per sample: " + itos(_bits_per_sample));
-				return false;
-			}
-			if (_audio_format == WAV_FORMAT_FLOAT && _bits_per_sample != 32) {
-				ERR_PRINT("SiOPMWaveStreamData: Float format requires 32-bit samples.");
-				return false;
-			}
-
-			_bytes_per_frame = _channel_count * (_bits_per_sample / 8);
-			found_fmt = true;
-
-		} else if (chunk_id == WAV_DATA) {
-			_data_offset = file->get_position();
-			_data_size = chunk_size;
-			_total_source_frames = (int)(_data_size / _bytes_per_frame);
-			found_data = true;
-		}
-
-		// Advance to next chunk (chunks are word-aligned).
-		int64_t next_pos = chunk_start + chunk_size;
-		if (chunk_size & 1) {
-			next_pos++; // Padding byte.
-		}
-		file->seek(next_pos);
-
-		if (found_fmt && found_data) {
-			break;
-		}
-	}
-
-	if (!found_fmt || !found_data) {
-		ERR_PRINT("SiOPMWaveStreamData: Missing fmt or data chunk.");
-		return false;
-	}
-
-	if (_total_source_frames <= 0) {
-		ERR_PRINT("SiOPMWaveStreamData: Empty audio data.");
-		return false;
-	}
-
-	return true;
-}
-
 // ---------------------------------------------------------------------------
 // Trim setters
 // ---------------------------------------------------------------------------
@@ -321,13 +269,27 @@ void SiOPMWaveStreamData::ring_advance_read(int p_frames) {
 	_ring_read_pos.store(rp + p_frames, std::memory_order_release);
 }
 
-void SiOPMWaveStreamData::request_refill() {
+void SiOPMWaveStreamData::request_refill(double p_consumption_rate) {
 	if (_live_mode) {
 		return;
 	}
+	_consumption_rate.store(p_consumption_rate, std::memory_order_relaxed);
 	_s_enqueue(this);
 }
 
+void SiOPMWaveStreamData::report_underrun(int p_frames) {
+	if (p_frames <= 0) {
+		return;
+	}
+	_underrun_count.fetch_add(1, std::memory_order_relaxed);
+	_underrun_frames.fetch_add(p_frames, std::memory_order_relaxed);
+}
+
+void SiOPMWaveStreamData::reset_underrun_counters() {
+	_underrun_count.store(0, std::memory_order_relaxed);
+	_underrun_frames.store(0, std::memory_order_relaxed);
+}
+
 int SiOPMWaveStreamData::push_interleaved_pcm(const PackedFloat32Array &p_pcm, int p_frame_count) {
 	if (!_valid || !_live_mode || _channel_count <= 0 || _ring_capacity <= 0) {
 		return 0;
@@ -375,6 +337,236 @@ void SiOPMWaveStreamData::clear_live_buffer() {
 	_live_dropped_frames.store(0, std::memory_order_relaxed);
 }
 
+// ---------------------------------------------------------------------------
+// Pre-roll cache
+// ---------------------------------------------------------------------------
+
+void SiOPMWaveStreamData::_free_preroll_cache(PrerollCache *p_cache) {
+	if (!p_cache) {
+		return;
+	}
+	_s_preroll_memory_used.fetch_sub(p_cache->byte_size, std::memory_order_relaxed);
+	memdelete(p_cache);
+}
+
+void SiOPMWaveStreamData::_swap_preroll_cache(PrerollCache *p_cache) {
+	PrerollCache *previous = _preroll_cache.exchange(p_cache, std::memory_order_seq_cst);
+	if (previous) {
+		_retired_preroll_caches.push_back(previous);
+	}
+	_free_retired_preroll_caches();
+}
+
+void SiOPMWaveStreamData::_free_retired_preroll_caches() {
+	if (_retired_preroll_caches.empty()) {
+		return;
+	}
+	// Readers register before loading the cache pointer. Seeing no readers after a
+	// cache was retired means nobody can still be holding it.
+	if (_preroll_readers.load(std::memory_order_seq_cst) != 0) {
+		return;
+	}
+
+	for (PrerollCache *cache : _retired_preroll_caches) {
+		_free_preroll_cache(cache);
+	}
+	_retired_preroll_caches.clear();
+}
+
+const float *SiOPMWaveStreamData::acquire_preroll(int64_t p_start_sample, int64_t p_end_sample, int &r_frame_count) {
+	r_frame_count = 0;
+
+	_preroll_readers.fetch_add(1, std::memory_order_seq_cst);
+	const PrerollCache *cache = _preroll_cache.load(std::memory_order_seq_cst);
+	if (cache) {
+		// Find the last region starting at or before the position.
+		auto next = std::upper_bound(cache->regions.begin(), cache->regions.end(), p_start_sample, [](int64_t sample, const PrerollRegion &region) { return sample < region.start_sample; });
+		if (next != cache->regions.begin()) {
+			const PrerollRegion &region = *(next - 1);
+			int64_t region_end = region.start_sample + region.frame_count;
+			int64_t available = MIN(region_end, p_end_sample) - p_start_sample;
+			if (available > 0) {
+				r_frame_count = (int)available;
+				return region.frames.data() + (p_start_sample - region.start_sample) * _channel_count;
+			}
+		}
+	}
+
+	_preroll_readers.fetch_sub(1, std::memory_order_seq_cst);
+	return nullptr;
+}
+
+void SiOPMWaveStreamData::release_preroll() {
+	_preroll_readers.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void SiOPMWaveStreamData::set_preroll_length(double p_seconds) {
+	_preroll_length = MAX(p_seconds, 0.0);
+	rebuild_preroll();
+}
+
+void SiOPMWaveStreamData::add_cue_point(int64_t p_sample) {
+	if (std::find(_cue_points.begin(), _cue_points.end(), p_sample) != _cue_points.end()) {
+		return;
+	}
+	_cue_points.push_back(p_sample);
+	rebuild_preroll();
+}
+
+void SiOPMWaveStreamData::remove_cue_point(int64_t p_sample) {
+	auto it = std::find(_cue_points.begin(), _cue_points.end(), p_sample);
+	if (it == _cue_points.end()) {
+		return;
+	}
+	_cue_points.erase(it);
+	rebuild_preroll();
+}
+
+void SiOPMWaveStreamData::clear_cue_points() {
+	_cue_points.clear();
+	rebuild_preroll();
+}
+
+PackedInt64Array SiOPMWaveStreamData::get_cue_points() const {
+	PackedInt64Array points;
+	for (int64_t point : _cue_points) {
+		points.push_back(point);
+	}
+	return points;
+}
+
+int64_t SiOPMWaveStreamData::get_preroll_frames() const {
+	const PrerollCache *cache = _preroll_cache.load(std::memory_order_relaxed);
+	if (!cache) {
+		return 0;
+	}
+
+	int64_t frames = 0;
+	for (const PrerollRegion &region : cache->regions) {
+		frames += region.frame_count;
+	}
+	return frames;
+}
+
+void SiOPMWaveStreamData::set_preroll_budget(int64_t p_bytes) {
+	// Existing caches are kept; the budget applies from the next rebuild.
+	_s_preroll_budget = MAX(p_bytes, (int64_t)0);
+}
+
+void SiOPMWaveStreamData::rebuild_preroll() {
+	int region_length = (int)MIN((int64_t)(_preroll_length * _source_sample_rate), (int64_t)_total_source_frames);
+	if (!_valid || _live_mode || region_length <= 0) {
+		_swap_preroll_cache(nullptr);
+		return;
+	}
+
+	// Start points in priority order.
+	std::vector<int64_t> starts;
+	starts.push_back(_in_sample.load(std::memory_order_relaxed));
+	int64_t loop_start = _loop_start_sample.load(std::memory_order_relaxed);
+	if (loop_start > 0) {
+		starts.push_back(loop_start);
+	}
+	starts.insert(starts.end(), _cue_points.begin(), _cue_points.end());
+
+	// This stream may use whatever the other streams leave of the budget.
+	const PrerollCache *current = _preroll_cache.load(std::memory_order_relaxed);
+	int64_t used_by_others = _s_preroll_memory_used.load(std::memory_order_relaxed) - (current ? current->byte_size : 0);
+	int64_t frames_allowed = (_s_preroll_budget - used_by_others) / (int64_t)(sizeof(float) * _channel_count);
+
+	// Accept regions until the budget runs out, merging overlapping ones.
+	std::vector<std::pair<int64_t, int64_t>> ranges;
+	bool over_budget = false;
+	for (int64_t start : starts) {
+		start = CLAMP(start, (int64_t)0, (int64_t)_total_source_frames);
+		int64_t end = MIN(start + region_length, (int64_t)_total_source_frames);
+		if (end <= start) {
+			continue;
+		}
+
+		std::vector<std::pair<int64_t, int64_t>> merged = ranges;
+		merged.push_back({ start, end });
+		std::sort(merged.begin(), merged.end());
+		int write_index = 0;
+		for (int i = 1; i < (int)merged.size(); i++) {
+			if (merged[i].first <= merged[write_index].second) {
+				merged[write_index].second = MAX(merged[write_index].second, merged[i].second);
+			} else {
+				merged[++write_index] = merged[i];
+			}
+		}
+		merged.resize(write_index + 1);
+
+		int64_t total_frames = 0;
+		for (const std::pair<int64_t, int64_t> &range : merged) {
+			total_frames += range.second - range.first;
+		}
+		if (total_frames > frames_allowed) {
+			over_budget = true;
+			continue;
+		}
+		ranges.swap(merged);
+	}
+
+	PrerollCache *cache = memnew(PrerollCache);
+	SiOPMWaveDecoder *decoder = nullptr;
+
+	for (const std::pair<int64_t, int64_t> &range : ranges) {
+		PrerollRegion region;
+		region.start_sample = range.first;
+		region.frame_count = (int)(range.second - range.first);
+
+		// Regions that didn't change are copied from the current cache rather than decoded again.
+		const PrerollRegion *cached_region = nullptr;
+		if (current) {
+			for (const PrerollRegion &existing : current->regions) {
+				if (existing.start_sample == region.start_sample && existing.frame_count == region.frame_count) {
+					cached_region = &existing;
+					break;
+				}
+			}
+		}
+
+		if (cached_region) {
+			region.frames = cached_region->frames;
+		} else {
+			// The loader owns _decoder; the main thread decodes with its own instance.
+			if (!decoder) {
+				decoder = SiOPMWaveDecoder::create_for_file(_file_path);
+				if (!decoder) {
+					break;
+				}
+			}
+
+			region.frames.resize((size_t)region.frame_count * _channel_count);
+			int decoded = decoder->read_frames(region.start_sample, region.frame_count, region.frames.data());
+			region.frame_count = MAX(decoded, 0);
+			region.frames.resize((size_t)region.frame_count * _channel_count);
+		}
+
+		if (region.frame_count > 0) {
+			cache->byte_size += (int64_t)(region.frames.size() * sizeof(float));
+			cache->regions.push_back(std::move(region));
+		}
+	}
+
+	if (decoder) {
+		memdelete(decoder);
+	}
+
+	if (cache->regions.empty()) {
+		memdelete(cache);
+		cache = nullptr;
+	} else {
+		_s_preroll_memory_used.fetch_add(cache->byte_size, std::memory_order_relaxed);
+	}
+	_swap_preroll_cache(cache);
+
+	if (over_budget) {
+		WARN_PRINT("SiOPMWaveStreamData: Pre-roll memory budget exceeded, some start points of '" + _file_path + "' are not cached.");
+	}
+}
+
 // ---------------------------------------------------------------------------
 // Lifecycle
 // ---------------------------------------------------------------------------
@@ -397,8 +589,8 @@ void SiOPMWaveStreamData::deactivate() {
 	}
 	_active.store(false, std::memory_order_release);
 	// The loader thread will see _active == false and skip any pending or
-	// future refill for this instance. _loader_file is cleaned up later by
-	// the destructor or load_wav() after _s_wait_until_idle().
+	// future refill for this instance. The decoder is closed later by
+	// the destructor or load_file() after _s_wait_until_idle().
 }
 
 void SiOPMWaveStreamData::seek(int64_t p_position_sample) {
@@ -431,10 +623,8 @@ void SiOPMWaveStreamData::prefill_sync() {
 	_ring_read_pos.store(0, std::memory_order_relaxed);
 	_ring_write_pos.store(0, std::memory_order_relaxed);
 
-	// Open the file for reading.
-	_loader_file = FileAccess::open(_file_path, FileAccess::READ);
-	if (_loader_file.is_null()) {
-		ERR_PRINT("SiOPMWaveStreamData: Failed to open file for prefill: " + _file_path);
+	if (!_decoder) {
+		ERR_PRINT("SiOPMWaveStreamData: No decoder for prefill: " + _file_path);
 		return;
 	}
 
@@ -442,83 +632,6 @@ void SiOPMWaveStreamData::prefill_sync() {
 	_fill_ring_buffer_impl();
 }
 
-// ---------------------------------------------------------------------------
-// Decode: raw WAV bytes → interleaved doubles
-// ---------------------------------------------------------------------------
-
-void SiOPMWaveStreamData::_decode_raw_to_doubles(const PackedByteArray &p_raw, int p_frame_count) {
-	int total_samples = p_frame_count * _channel_count;
-	_decode_buffer.resize(total_samples);
-
-	const uint8_t *raw = p_raw.ptr();
-
-	if (_audio_format == WAV_FORMAT_PCM && _bits_per_sample == 8) {
-		// 8-bit PCM WAV is unsigned: 0..255 with 128 representing zero.
-		for (int i = 0; i < total_samples; i++) {
-			int sample = (int)raw[i] - 128;
-			_decode_buffer.write[i] = (double)sample / 128.0;
-		}
-	} else if (_audio_format == WAV_FORMAT_PCM && _bits_per_sample == 16) {
-		for (int i = 0; i < total_samples; i++) {
-			int16_t sample = (int16_t)((uint16_t)raw[i * 2] | ((uint16_t)raw[i * 2 + 1] << 8));
-			_decode_buffer.write[i] = (double)sample / 32768.0;
-		}
-	} else if (_audio_format == WAV_FORMAT_PCM && _bits_per_sample == 24) {
-		for (int i = 0; i < total_samples; i++) {
-			int32_t sample = (int32_t)raw[i * 3]
-				| ((int32_t)raw[i * 3 + 1] << 8)
-				| ((int32_t)(int8_t)raw[i * 3 + 2] << 16);
-			_decode_buffer.write[i] = (double)sample / 8388608.0;
-		}
-	} else if (_audio_format == WAV_FORMAT_FLOAT && _bits_per_sample == 32) {
-		for (int i = 0; i < total_samples; i++) {
-			float f;
-			memcpy(&f, &raw[i * 4], sizeof(float));
-			_decode_buffer.write[i] = (double)f;
-		}
-	}
-
-	_decode_buf_valid = p_frame_count;
-}
-
-// ---------------------------------------------------------------------------
-// Loader: read chunk from WAV file
-// ---------------------------------------------------------------------------
-
-bool SiOPMWaveStreamData::_refill_decode_buffer() {
-	if (_loader_file.is_null()) {
-		return false;
-	}
-
-	if (_file_read_pos_frames >= _total_source_frames) {
-		_decode_buf_valid = 0;
-		return false;
-	}
-
-	int frames_to_read = DECODE_CHUNK_FRAMES;
-	if (_file_read_pos_frames + frames_to_read > _total_source_frames) {
-		frames_to_read = _total_source_frames - (int)_file_read_pos_frames;
-	}
-	if (frames_to_read <= 0) {
-		_decode_buf_valid = 0;
-		return false;
-	}
-
-	int64_t byte_offset = _data_offset + _file_read_pos_frames * _bytes_per_frame;
-	_loader_file->seek(byte_offset);
-	PackedByteArray raw = _loader_file->get_buffer(frames_to_read * _bytes_per_frame);
-
-	int actual_frames = raw.size() / _bytes_per_frame;
-	if (actual_frames <= 0) {
-		_decode_buf_valid = 0;
-		return false;
-	}
-
-	_decode_raw_to_doubles(raw, actual_frames);
-	_file_read_pos_frames += actual_frames;
-	return true;
-}
-
 // ---------------------------------------------------------------------------
 // Loader: produce source frames
 // ---------------------------------------------------------------------------
@@ -542,75 +655,46 @@ int SiOPMWaveStreamData::_produce_frames(double *r_out, int p_max_frames) {
 	effective_loop_end = CLAMP(effective_loop_end, effective_loop_start, effective_end);
 
 	int frames_produced = 0;
+	// Only wrap again once something was decoded since the last wrap. A loop region that
+	// can't be decoded (corrupt frames, loop start at or past EOF) would spin otherwise.
+	bool decoded_since_wrap = true;
 
 	while (frames_produced < p_max_frames) {
 		// Check for loop wrap or end-of-stream.
 		if (_decode_pos_frames >= effective_loop_end) {
-			if (looping && effective_loop_end > effective_loop_start) {
+			if (looping && effective_loop_end > effective_loop_start && decoded_since_wrap) {
 				_reset_decode_to_sample(effective_loop_start);
+				decoded_since_wrap = false;
 				continue;
 			} else {
 				break;
 			}
 		}
 
-		// Ensure decode buffer has data.
-		if (_decode_buf_valid <= 0) {
-			if (!_refill_decode_buffer()) {
-				if (looping && effective_loop_end > effective_loop_start) {
-					// Hit EOF before loop_end — wrap back to loop start.
-					_reset_decode_to_sample(effective_loop_start);
-					continue;
-				}
-				break;
-			}
-		}
+		int end_remaining = (int)MIN(effective_loop_end - _decode_pos_frames, (int64_t)INT32_MAX);
+		int to_decode = MIN(p_max_frames - frames_produced, end_remaining);
 
-		int end_remaining = (int)(effective_loop_end - _decode_pos_frames);
-		int to_copy = p_max_frames - frames_produced;
-		if (to_copy > _decode_buf_valid) {
-			to_copy = _decode_buf_valid;
-		}
-		if (to_copy > end_remaining) {
-			to_copy = end_remaining;
-		}
-		if (to_copy <= 0) {
+		// Decode straight into the output. A jump back to the loop start is just a read
+		// at an earlier position; compressed decoders seek to it internally.
+		int decoded = _decoder->read_frames(_decode_pos_frames, to_decode, r_out + frames_produced * _channel_count);
+		if (decoded <= 0) {
+			if (looping && effective_loop_end > effective_loop_start && decoded_since_wrap) {
+				// Hit EOF before loop_end — wrap back to loop start.
+				_reset_decode_to_sample(effective_loop_start);
+				decoded_since_wrap = false;
+				continue;
+			}
 			break;
 		}
 
-		// Copy from the front of the decode buffer.
-		int buf_offset = (_decode_buffer.size() / _channel_count) - _decode_buf_valid;
-		for (int i = 0; i < to_copy * _channel_count; i++) {
-			r_out[frames_produced * _channel_count + i] =
-				_decode_buffer[buf_offset * _channel_count + i];
-		}
-
-		frames_produced += to_copy;
-		_decode_pos_frames += to_copy;
-		_decode_buf_valid -= to_copy;
+		frames_produced += decoded;
+		_decode_pos_frames += decoded;
+		decoded_since_wrap = true;
 	}
 
 	return frames_produced;
 }
 
-// ---------------------------------------------------------------------------
-// Loader: write frames to ring buffer
-// ---------------------------------------------------------------------------
-
-void SiOPMWaveStreamData::_ring_write_frames(const double *p_data, int p_frame_count) {
-	uint32_t wp = _ring_write_pos.load(std::memory_order_relaxed);
-
-	for (int i = 0; i < p_frame_count; i++) {
-		int idx = ((wp + i) & _ring_mask) * _channel_count;
-		for (int ch = 0; ch < _channel_count; ch++) {
-			_ring_data[idx + ch] = p_data[i * _channel_count + ch];
-		}
-	}
-
-	// Single release-store makes all frame writes visible to the audio thread.
-	_ring_write_pos.store(wp + p_frame_count, std::memory_order_release);
-}
-
 // ---------------------------------------------------------------------------
 // Loader: fill ring buffer implementation
 // ---------------------------------------------------------------------------
@@ -636,37 +720,39 @@ void SiOPMWaveStreamData::_fill_ring_buffer_impl() {
 
 	int frames_to_fill = (space < FILL_CHUNK_SIZE) ? space : FILL_CHUNK_SIZE;
 
-	// Open file if not already open (first fill on loader thread).
-	if (_loader_file.is_null()) {
-		_loader_file = FileAccess::open(_file_path, FileAccess::READ);
-		if (_loader_file.is_null()) {
-			_active.store(false, std::memory_order_release);
-			return;
-		}
+	if (!_decoder) {
+		_active.store(false, std::memory_order_release);
+		return;
 	}
 
-	// Temporary buffer for decoded source-frame output.
-	std::vector<double> temp(frames_to_fill * _channel_count);
-	int produced = _produce_frames(temp.data(), frames_to_fill);
+	// Decode directly into the ring, one contiguous span at a time (two at most,
+	// when the fill wraps around the end). Frames past the write position are
+	// invisible to the audio thread until the release-store below.
+	int produced = 0;
+	while (produced < frames_to_fill) {
+		int ring_index = (int)((wp + produced) & _ring_mask);
+		int span = MIN(frames_to_fill - produced, _ring_capacity - ring_index);
+
+		int span_produced = _produce_frames(&_ring_data[ring_index * _channel_count], span);
+		produced += span_produced;
+		if (span_produced < span) {
+			break;
+		}
+	}
 
 	if (produced > 0) {
-		_ring_write_frames(temp.data(), produced);
+		// Single release-store makes all frame writes visible to the audio thread.
+		_ring_write_pos.store(wp + produced, std::memory_order_release);
 	}
 }
 
-// ---------------------------------------------------------------------------
-// Loader: handle seek
-// ---------------------------------------------------------------------------
-
 // ---------------------------------------------------------------------------
 // Loader: reset decode state to a source-frame position
 // ---------------------------------------------------------------------------
 
 void SiOPMWaveStreamData::_reset_decode_to_sample(int64_t p_pos_sample) {
 	p_pos_sample = CLAMP(p_pos_sample, (int64_t)0, (int64_t)_total_source_frames);
-	_file_read_pos_frames = p_pos_sample;
 	_decode_pos_frames = p_pos_sample;
-	_decode_buf_valid = 0;
 }
 
 void SiOPMWaveStreamData::_handle_seek() {
@@ -689,24 +775,96 @@ void SiOPMWaveStreamData::_handle_seek() {
 }
 
 // ---------------------------------------------------------------------------
-// Lock-free MPSC work queue (Treiber stack)
+// Loader: urgency
+// ---------------------------------------------------------------------------
+
+double SiOPMWaveStreamData::_get_time_to_underrun() const {
+	// Deactivated instances and pending seeks are cheap to service (a skip or a
+	// flush), and a seek leaves the ring empty anyway; get them out of the way first.
+	if (!_active.load(std::memory_order_relaxed) || _seek_requested.load(std::memory_order_relaxed)) {
+		return 0.0;
+	}
+
+	double rate = _consumption_rate.load(std::memory_order_relaxed);
+	if (rate <= 0.0) {
+		rate = _source_sample_rate;
+	}
+	if (rate <= 0.0) {
+		return std::numeric_limits<double>::max();
+	}
+
+	return (double)ring_available() / rate;
+}
+
+// ---------------------------------------------------------------------------
+// Lock-free MPMC work queue (Treiber stack)
 // ---------------------------------------------------------------------------
 
 void SiOPMWaveStreamData::_s_enqueue(SiOPMWaveStreamData *p_instance) {
-	// Deduplicate: if this instance is already in the queue, skip.
+	// Deduplicate: if this instance is already in the queue (or being filled), skip.
 	// exchange() is atomic — exactly one caller wins and pushes.
 	if (p_instance->_enqueued.exchange(true, std::memory_order_acq_rel)) {
 		return;
 	}
 
+	_s_push_list(p_instance, p_instance);
+
+	// notify_one() doesn't require the mutex, so this never blocks the audio thread.
+	_s_wake_cv.notify_one();
+}
+
+void SiOPMWaveStreamData::_s_push_list(SiOPMWaveStreamData *p_head, SiOPMWaveStreamData *p_tail) {
 	// Push onto the Treiber stack via CAS.
 	SiOPMWaveStreamData *old_head = _s_queue_head.load(std::memory_order_relaxed);
 	do {
-		p_instance->_next_in_queue.store(old_head, std::memory_order_relaxed);
-	} while (!_s_queue_head.compare_exchange_weak(old_head, p_instance,
+		p_tail->_next_in_queue.store(old_head, std::memory_order_relaxed);
+	} while (!_s_queue_head.compare_exchange_weak(old_head, p_head,
 			std::memory_order_release, std::memory_order_relaxed));
 }
 
+SiOPMWaveStreamData *SiOPMWaveStreamData::_s_dequeue_most_urgent() {
+	// Atomically steal the entire queue.
+	SiOPMWaveStreamData *batch = _s_queue_head.exchange(nullptr, std::memory_order_acquire);
+	if (!batch) {
+		return nullptr;
+	}
+
+	// Find the instance closest to running dry. The queue holds at most one entry
+	// per stream, so a linear scan is cheap.
+	SiOPMWaveStreamData *best = nullptr;
+	SiOPMWaveStreamData *best_prev = nullptr;
+	double best_time = std::numeric_limits<double>::max();
+
+	SiOPMWaveStreamData *prev = nullptr;
+	for (SiOPMWaveStreamData *item = batch; item; item = item->_next_in_queue.load(std::memory_order_relaxed)) {
+		double time = item->_get_time_to_underrun();
+		if (!best || time < best_time) {
+			best = item;
+			best_prev = prev;
+			best_time = time;
+		}
+		prev = item;
+	}
+
+	// Unlink it from the stolen list.
+	SiOPMWaveStreamData *best_next = best->_next_in_queue.load(std::memory_order_relaxed);
+	best->_next_in_queue.store(nullptr, std::memory_order_relaxed);
+	SiOPMWaveStreamData *tail = (prev == best) ? best_prev : prev;
+	if (best_prev) {
+		best_prev->_next_in_queue.store(best_next, std::memory_order_relaxed);
+	} else {
+		batch = best_next;
+	}
+
+	// Hand the rest back, still marked as enqueued, so idle peers can pick them up.
+	if (batch) {
+		_s_push_list(batch, tail);
+		_s_wake_cv.notify_one();
+	}
+
+	return best;
+}
+
 void SiOPMWaveStreamData::_s_wait_until_idle(SiOPMWaveStreamData *p_instance) {
 	while (p_instance->_enqueued.load(std::memory_order_acquire) ||
 			p_instance->_processing.load(std::memory_order_acquire)) {
@@ -715,59 +873,85 @@ void SiOPMWaveStreamData::_s_wait_until_idle(SiOPMWaveStreamData *p_instance) {
 }
 
 // ---------------------------------------------------------------------------
-// Static loader thread
+// Static loader pool
 // ---------------------------------------------------------------------------
 
 void SiOPMWaveStreamData::_s_loader_thread_func() {
 	while (_s_loader_running.load(std::memory_order_relaxed)) {
-		// Atomically steal the entire queue.
-		SiOPMWaveStreamData *batch = _s_queue_head.exchange(nullptr, std::memory_order_acquire);
+		SiOPMWaveStreamData *item = _s_dequeue_most_urgent();
 
-		if (!batch) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		if (!item) {
+			std::unique_lock<std::mutex> lock(_s_wake_mutex);
+			_s_wake_cv.wait_for(lock, std::chrono::milliseconds(LOADER_WAKE_TIMEOUT_MS), [] {
+				return !_s_loader_running.load(std::memory_order_relaxed) || _s_queue_head.load(std::memory_order_acquire) != nullptr;
+			});
 			continue;
 		}
 
-		// Process each item in the stolen batch. No mutex is held during
-		// _fill_ring_buffer_impl(), so activate()/deactivate() on any other
-		// instance proceed without blocking.
-		while (batch) {
-			// Save the next pointer before we allow re-enqueue.
-			SiOPMWaveStreamData *next = batch->_next_in_queue.load(std::memory_order_relaxed);
-			batch->_next_in_queue.store(nullptr, std::memory_order_relaxed);
-
-			// Mark as processing BEFORE clearing enqueued. This ensures
-			// _s_wait_until_idle() always sees _processing == true if the
-			// loader is between clearing _enqueued and finishing the fill.
-			batch->_processing.store(true, std::memory_order_release);
-			batch->_enqueued.store(false, std::memory_order_release);
-
-			if (batch->_active.load(std::memory_order_acquire)) {
-				batch->_fill_ring_buffer_impl();
-			}
+		// No mutex is held during _fill_ring_buffer_impl(), so activate()/deactivate()
+		// on any other instance proceed without blocking. _enqueued stays set until
+		// the fill is done, so a refill request arriving meanwhile can't hand this
+		// instance to a second loader; the audio thread simply asks again next block.
+		item->_processing.store(true, std::memory_order_release);
 
-			batch->_processing.store(false, std::memory_order_release);
-			batch = next;
+		if (item->_active.load(std::memory_order_acquire)) {
+			item->_fill_ring_buffer_impl();
 		}
+
+		// Release _enqueued before _processing, so _s_wait_until_idle() always sees
+		// at least one of the two flags set until the instance is fully released.
+		item->_enqueued.store(false, std::memory_order_release);
+		item->_processing.store(false, std::memory_order_release);
 	}
 }
 
 void SiOPMWaveStreamData::_s_ensure_loader_running() {
-	// CAS ensures only one thread creates the loader thread.
+	// CAS ensures only one thread creates the loader pool.
 	bool expected = false;
 	if (_s_loader_running.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
-		_s_loader_thread = std::thread(_s_loader_thread_func);
+		for (int i = 0; i < _s_loader_thread_count; i++) {
+			_s_loader_threads.push_back(std::thread(_s_loader_thread_func));
+		}
 	}
 }
 
-void SiOPMWaveStreamData::shutdown_loader() {
+void SiOPMWaveStreamData::_s_stop_loader_threads() {
+	_s_loader_running.store(false, std::memory_order_release);
+	{
+		// Taking the mutex orders the flag change against loaders about to sleep.
+		std::lock_guard<std::mutex> lock(_s_wake_mutex);
+	}
+	_s_wake_cv.notify_all();
+
+	for (std::thread &thread : _s_loader_threads) {
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+	_s_loader_threads.clear();
+}
+
+void SiOPMWaveStreamData::set_loader_thread_count(int p_count) {
+	ERR_FAIL_COND_MSG(p_count < 1 || p_count > MAX_LOADER_THREAD_COUNT, vformat("SiOPMWaveStreamData: Loader thread count must be between 1 and %d.", MAX_LOADER_THREAD_COUNT));
+	if (p_count == _s_loader_thread_count) {
+		return;
+	}
+
+	_s_loader_thread_count = p_count;
 	if (!_s_loader_running.load(std::memory_order_relaxed)) {
 		return;
 	}
-	_s_loader_running.store(false, std::memory_order_release);
-	if (_s_loader_thread.joinable()) {
-		_s_loader_thread.join();
+
+	// Restart the pool. Queued instances stay queued and are picked up by the new loaders.
+	_s_stop_loader_threads();
+	_s_ensure_loader_running();
+}
+
+void SiOPMWaveStreamData::shutdown_loader() {
+	if (!_s_loader_running.load(std::memory_order_relaxed)) {
+		return;
 	}
+	_s_stop_loader_threads();
 
 	// Drain any remaining queue entries (clear enqueued/processing flags).
 	SiOPMWaveStreamData *batch = _s_queue_head.exchange(nullptr, std::memory_order_acquire);
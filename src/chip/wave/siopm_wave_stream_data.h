@@ -7,13 +7,15 @@
 #ifndef SIOPM_WAVE_STREAM_DATA_H
 #define SIOPM_WAVE_STREAM_DATA_H
 
-#include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
 #include <godot_cpp/variant/string.hpp>
-#include <godot_cpp/templates/vector.hpp>
 #include "chip/wave/siopm_wave_base.h"
+#include "chip/wave/siopm_wave_decoder.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -22,13 +24,15 @@ using namespace godot;
 // Streaming wave data for audio clip playback.
 //
 // Provides a lock-free SPSC ring buffer of decoded source frames that the
-// audio thread reads and a single shared background loader thread writes.
-// Supports mono and stereo WAV files with 16-bit PCM, 24-bit PCM, or 32-bit float formats.
+// audio thread reads and a shared pool of background loader threads writes.
+// Any format with a SiOPMWaveDecoder can be streamed (WAV, FLAC and QOA built in);
+// frames are decoded incrementally, straight into the ring buffer.
 //
 // Thread ownership:
 //   - Immutable fields (file info, capacity) are safe to read from any thread after construction.
 //   - Ring buffer: audio thread reads, loader thread writes. Atomic positions enforce ordering.
-//   - Loader state (decode buffer, file handle, decode position): loader thread only.
+//   - Loader state (decoder, decode position): owned by whichever loader
+//     thread dequeued the instance. An instance is never held by two loaders at once.
 //   - Shared flags (_active, _seek_requested, _enqueued, _processing): atomic.
 class SiOPMWaveStreamData : public SiOPMWaveBase {
 	GDCLASS(SiOPMWaveStreamData, SiOPMWaveBase)
@@ -38,20 +42,20 @@ public:
 	static constexpr int DEFAULT_RING_CAPACITY = 16384;
 	// Number of source frames to produce per loader fill cycle.
 	static constexpr int FILL_CHUNK_SIZE = 4096;
-	// Decode buffer size in source frames per read.
-	static constexpr int DECODE_CHUNK_FRAMES = 4096;
+	// Default number of loader threads in the shared pool.
+	static constexpr int DEFAULT_LOADER_THREAD_COUNT = 2;
+	static constexpr int MAX_LOADER_THREAD_COUNT = 16;
+	// Default length of each pre-roll region, in seconds.
+	static constexpr double DEFAULT_PREROLL_LENGTH = 0.25;
+	// Default memory budget shared by the pre-roll caches of all streams, in bytes.
+	static constexpr int64_t DEFAULT_PREROLL_BUDGET = 32 * 1024 * 1024;
 
 private:
-	// ---- Immutable after load_wav()/configure_live() (safe from any thread) ----
+	// ---- Immutable after load_file()/configure_live() (safe from any thread) ----
 
 	String _file_path;
 	int _source_sample_rate = 0;
 	int _channel_count = 0;
-	int _bits_per_sample = 0;
-	int _audio_format = 0;        // 1 = PCM integer, 3 = IEEE float.
-	int64_t _data_offset = 0;     // Byte offset of audio data chunk in the file.
-	int64_t _data_size = 0;       // Byte size of the audio data chunk.
-	int _bytes_per_frame = 0;     // = channel_count * (bits_per_sample / 8).
 	int _total_source_frames = 0; // Total frames in the source file.
 	bool _valid = false;
 	bool _live_mode = false;
@@ -71,17 +75,27 @@ private:
 	std::atomic<int64_t> _seek_target{0};
 	std::atomic<int64_t> _live_dropped_frames{0};
 
-	// ---- Lock-free MPSC queue (intrusive Treiber stack) ----
+	// Rate at which the reader consumes source frames, in frames per second. Published
+	// by the audio thread with each refill request, so loaders can rank streams by how
+	// soon they run dry. 0 means "assume the source sample rate".
+	std::atomic<double> _consumption_rate{0};
+
+	// Underrun statistics (written by the audio thread, read by scripts).
+	std::atomic<int64_t> _underrun_count{0};  // Render blocks that hit an empty ring.
+	std::atomic<int64_t> _underrun_frames{0}; // Output frames rendered as silence because of it.
+
+	// ---- Lock-free MPMC queue (intrusive Treiber stack) ----
 	//
 	// Producers (audio thread via request_refill, main thread via activate/seek)
-	// push this instance onto a shared stack using CAS on _s_queue_head.
-	// The loader thread atomically steals the entire stack and processes items
-	// without holding any mutex. This keeps activate()/deactivate() non-blocking
-	// regardless of I/O happening on other instances.
+	// push this instance onto a shared stack using CAS on _s_queue_head and wake
+	// a loader. A loader atomically steals the entire stack, keeps the most urgent
+	// instance and pushes the rest back for its peers, then fills without holding
+	// any mutex. This keeps activate()/deactivate() non-blocking regardless of I/O
+	// happening on other instances.
 
 	std::atomic<SiOPMWaveStreamData *> _next_in_queue{nullptr};
-	std::atomic<bool> _enqueued{false};   // Deduplication: prevents double-enqueue.
-	std::atomic<bool> _processing{false}; // True while the loader thread is in _fill_ring_buffer_impl().
+	std::atomic<bool> _enqueued{false};   // Deduplication: prevents double-enqueue. Stays set until the fill is done.
+	std::atomic<bool> _processing{false}; // True while a loader thread is in _fill_ring_buffer_impl().
 
 	// Trim params (atomic for real-time updates via mailbox).
 	std::atomic<int64_t> _in_sample{0};
@@ -95,27 +109,55 @@ private:
 	std::atomic<int64_t> _loop_end_sample{0};    // 0 = use _out_sample or EOF.
 	std::atomic<bool> _looping{false};
 
-	// ---- Loader-thread-only state ----
-
-	Ref<FileAccess> _loader_file;
-	Vector<double> _decode_buffer;       // Decoded source frames (interleaved doubles).
-	int _decode_buf_valid = 0;           // Valid frames in _decode_buffer.
-	int64_t _file_read_pos_frames = 0;   // Next source frame to read from file.
-	int64_t _decode_pos_frames = 0;      // Source frames produced into the ring buffer so far.
+	// ---- Pre-roll cache ----
+	//
+	// Decoded frames resident in memory for the places playback is likely to start:
+	// the trim start, the loop start and registered cue points. A channel starting
+	// inside a region plays from it immediately, while the loader fills the ring from
+	// the end of the region, so there is no silent gap after a note-on or a seek.
+	//
+	// The cache is immutable once published. The main thread swaps in a new one on
+	// rebuild; the audio thread brackets its use with acquire/release_preroll(), which
+	// bump _preroll_readers. A replaced cache is freed only once no reader is active,
+	// so the audio thread never frees memory and never waits.
+
+	struct PrerollRegion {
+		int64_t start_sample = 0;
+		int frame_count = 0;
+		std::vector<float> frames; // Interleaved, frame_count * channel_count.
+	};
+
+	struct PrerollCache {
+		std::vector<PrerollRegion> regions; // Sorted by start_sample, non-overlapping.
+		int64_t byte_size = 0;
+	};
+
+	double _preroll_length = DEFAULT_PREROLL_LENGTH;
+	std::vector<int64_t> _cue_points; // Main thread.
+	std::atomic<PrerollCache *> _preroll_cache{nullptr};
+	std::atomic<int> _preroll_readers{0};
+	std::vector<PrerollCache *> _retired_preroll_caches; // Main thread.
+
+	static int64_t _s_preroll_budget;
+	static std::atomic<int64_t> _s_preroll_memory_used;
+
+	// Publish p_cache (may be null) and retire the previous one.
+	void _swap_preroll_cache(PrerollCache *p_cache);
+	// Free retired caches if no reader is active. Main thread.
+	void _free_retired_preroll_caches();
+	static void _free_preroll_cache(PrerollCache *p_cache);
 
-	// WAV header parsing (called from main thread in load_wav).
-	bool _parse_wav_header();
+	// ---- Loader-thread-only state ----
 
-	// Decode raw WAV bytes to interleaved doubles in [-1, 1].
-	void _decode_raw_to_doubles(const PackedByteArray &p_raw, int p_frame_count);
+	// Opened (and the header parsed) on the main thread by load_file(); read by the loader.
+	SiOPMWaveDecoder *_decoder = nullptr;
+	void _close_decoder();
+	int64_t _decode_pos_frames = 0; // Next source frame to decode into the ring buffer.
 
 	// Loader-thread fill implementation.
 	void _fill_ring_buffer_impl();
 
-	// Read a chunk of source frames from the WAV file and decode to doubles.
-	bool _refill_decode_buffer();
-
-	// Produce source frames from the decode buffer into ring_out.
+	// Decode source frames from the file into r_out, handling trim and loop wrap.
 	// Returns the number of frames produced.
 	int _produce_frames(double *r_out, int p_max_frames);
 
@@ -126,27 +168,37 @@ private:
 	// Used by _handle_seek() and the loop wrap in _produce_frames().
 	void _reset_decode_to_sample(int64_t p_pos_sample);
 
-	// Write frames to the ring buffer (loader thread).
-	void _ring_write_frames(const double *p_data, int p_frame_count);
+	// Seconds of audio left in the ring at the current consumption rate. Lower is more urgent.
+	double _get_time_to_underrun() const;
 
-	// ---- Static loader thread management ----
+	// ---- Static loader pool management ----
 
-	static std::thread _s_loader_thread;
+	static std::vector<std::thread> _s_loader_threads;
 	static std::atomic<bool> _s_loader_running;
+	static int _s_loader_thread_count;
+
+	// Idle loaders sleep on this until a producer enqueues work.
+	static std::mutex _s_wake_mutex;
+	static std::condition_variable _s_wake_cv;
 
-	// Global MPSC queue head. Producers push via CAS; the loader thread
-	// atomically steals the entire list with exchange(nullptr).
+	// Global queue head. Producers push via CAS; loaders atomically steal
+	// the entire list with exchange(nullptr).
 	static std::atomic<SiOPMWaveStreamData *> _s_queue_head;
 
 	static void _s_loader_thread_func();
 	static void _s_ensure_loader_running();
+	static void _s_stop_loader_threads();
 
-	// Push an instance onto the MPSC work queue (lock-free, safe from any thread).
+	// Push an instance onto the work queue and wake a loader (lock-free, safe from any thread).
 	static void _s_enqueue(SiOPMWaveStreamData *p_instance);
+	// Push an already-linked list of enqueued instances back onto the work queue.
+	static void _s_push_list(SiOPMWaveStreamData *p_head, SiOPMWaveStreamData *p_tail);
+	// Steal the queue, detach its most urgent instance and return the rest. Returns nullptr when empty.
+	static SiOPMWaveStreamData *_s_dequeue_most_urgent();
 
 	// Spin-wait until the loader thread is no longer processing this instance
 	// and it has been drained from the queue. Used by the destructor and
-	// load_wav() to establish exclusive access before touching loader-thread state.
+	// load_file() to establish exclusive access before touching loader-thread state.
 	static void _s_wait_until_idle(SiOPMWaveStreamData *p_instance);
 
 protected:
@@ -155,8 +207,13 @@ protected:
 public:
 	// ---- Construction / setup ----
 
-	// Load a WAV file and prepare the ring buffer. Returns true on success.
-	bool load_wav(const String &p_file_path, int p_ring_capacity = 0);
+	// Load an audio file in any supported format and prepare the ring buffer. Returns true on success.
+	bool load_file(const String &p_file_path, int p_ring_capacity = 0);
+	// Same as load_file(); kept for scripts written when only WAV was supported.
+	bool load_wav(const String &p_file_path, int p_ring_capacity = 0) { return load_file(p_file_path, p_ring_capacity); }
+
+	// Name of the decoder serving this stream ("WAV", "FLAC", ...), or empty.
+	String get_format_name() const;
 
 	// Configure this stream as a live-fed PCM source. Returns true on success.
 	bool configure_live(int p_source_sample_rate, int p_channel_count = 2, int p_ring_capacity = 0);
@@ -196,9 +253,24 @@ public:
 	// Advance the read position by p_frames.
 	void ring_advance_read(int p_frames);
 
-	// Enqueue a refill request into the MPSC work queue (lock-free).
+	// Enqueue a refill request into the work queue (lock-free).
 	// Called by the audio thread when the ring buffer drops below the low-water mark.
-	void request_refill();
+	// p_consumption_rate is how many source frames per second the reader currently
+	// consumes (pitch and resampling included); 0 assumes the source sample rate.
+	void request_refill(double p_consumption_rate = 0);
+
+	// Record an underrun of p_frames output frames in the current render block (audio thread).
+	void report_underrun(int p_frames);
+	int64_t get_underrun_count() const { return _underrun_count.load(std::memory_order_relaxed); }
+	int64_t get_underrun_frames() const { return _underrun_frames.load(std::memory_order_relaxed); }
+	void reset_underrun_counters();
+
+	// Look up the pre-roll frames for a start at p_start_sample, up to p_end_sample
+	// (exclusive). Returns interleaved frames and sets r_frame_count, or returns nullptr
+	// if the position isn't cached. A non-null result stays valid until the matching
+	// release_preroll(). Audio thread; lock-free.
+	const float *acquire_preroll(int64_t p_start_sample, int64_t p_end_sample, int &r_frame_count);
+	void release_preroll();
 
 	// Main-thread live push API. Returns the number of source frames accepted.
 	int push_interleaved_pcm(const PackedFloat32Array &p_pcm, int p_frame_count = 0);
@@ -223,9 +295,41 @@ public:
 	// Used after construction or seek to ensure data is immediately available.
 	void prefill_sync();
 
-	// ---- Static cleanup ----
-
-	// Stop the loader thread. Called during driver shutdown.
+	// ---- Pre-roll cache (main thread) ----
+
+	// Length of each pre-roll region in seconds. 0 disables the cache for this stream.
+	double get_preroll_length() const { return _preroll_length; }
+	void set_preroll_length(double p_seconds);
+
+	// Register a source-frame position where playback may start, such as a cue of an
+	// adaptive music system. Each cue gets its own pre-roll region.
+	void add_cue_point(int64_t p_sample);
+	void remove_cue_point(int64_t p_sample);
+	void clear_cue_points();
+	PackedInt64Array get_cue_points() const;
+
+	// Decode the pre-roll regions for the current trim start, loop start and cue points.
+	// Called on load and by the cue point methods; call it again after changing the trim
+	// or the loop region from the main thread. Regions already cached are reused.
+	void rebuild_preroll();
+	// Frames covered by the current pre-roll cache.
+	int64_t get_preroll_frames() const;
+
+	// Memory shared by the pre-roll caches of all streams. Regions that would exceed
+	// the budget aren't cached: trim start first, then loop start, then cue points in
+	// registration order.
+	static int64_t get_preroll_budget() { return _s_preroll_budget; }
+	static void set_preroll_budget(int64_t p_bytes);
+	static int64_t get_preroll_memory_usage() { return _s_preroll_memory_used.load(std::memory_order_relaxed); }
+
+	// ---- Static loader pool ----
+
+	// Number of loader threads serving all streams. Takes effect immediately if the
+	// pool is running, otherwise on the next activation.
+	static int get_loader_thread_count() { return _s_loader_thread_count; }
+	static void set_loader_thread_count(int p_count);
+
+	// Stop the loader threads. Called during driver shutdown.
 	static void shutdown_loader();
 
 	//
@@ -150,4 +150,24 @@ static inline BiquadCoeffs compute_biquad_coefficients(int p_type, double p_freq
 	return c;
 }
 
+// Compute one Butterworth low-pass and high-pass stage at the same cutoff. Two of each
+// in series make a 4th order Linkwitz-Riley crossover whose outputs sum to an all-pass.
+static inline void compute_linkwitz_riley_coefficients(double p_freq_hz, double p_sample_rate, BiquadCoeffs &r_low, BiquadCoeffs &r_high) {
+	const double sqrt2 = 1.41421356237309504880;
+	double warp = 1.0 / ::tan(M_PI * p_freq_hz / p_sample_rate);
+	double warp2 = warp * warp;
+	double mult = 1.0 / (1.0 + sqrt2 * warp + warp2);
+
+	r_low.b0 = mult;
+	r_low.b1 = 2.0 * mult;
+	r_low.b2 = mult;
+	r_low.a1 = 2.0 * (1.0 - warp2) * mult;
+	r_low.a2 = (1.0 - sqrt2 * warp + warp2) * mult;
+
+	r_high = r_low;
+	r_high.b0 = warp2 * mult;
+	r_high.b1 = -2.0 * r_high.b0;
+	r_high.b2 = r_high.b0;
+}
+
 #endif // BIQUAD_COEFFICIENTS_H
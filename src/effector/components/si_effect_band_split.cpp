@@ -0,0 +1,80 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#include "si_effect_band_split.h"
+
+#include <godot_cpp/core/error_macros.hpp>
+
+bool SiEffectBandSplit::matches(double p_low_mid_hz, double p_mid_high_hz, double p_sampling_rate) const {
+	return _low_mid_hz == p_low_mid_hz && _mid_high_hz == p_mid_high_hz && _sampling_rate == p_sampling_rate;
+}
+
+void SiEffectBandSplit::set_frequencies(double p_low_mid_hz, double p_mid_high_hz, double p_sampling_rate) {
+	if (matches(p_low_mid_hz, p_mid_high_hz, p_sampling_rate)) {
+		return;
+	}
+	_low_mid_hz = p_low_mid_hz;
+	_mid_high_hz = p_mid_high_hz;
+	_sampling_rate = p_sampling_rate;
+
+	BiquadCoeffs low;
+	BiquadCoeffs high;
+	compute_linkwitz_riley_coefficients(_low_mid_hz, _sampling_rate, low, high);
+	for (int i = 0; i < 2; i++) {
+		_low_mid_low.set_coefficients(i, low);
+		_low_mid_high.set_coefficients(i, high);
+	}
+
+	compute_linkwitz_riley_coefficients(_mid_high_hz, _sampling_rate, low, high);
+	for (int i = 0; i < 2; i++) {
+		_mid_high_low.set_coefficients(i, low);
+		_mid_high_high.set_coefficients(i, high);
+	}
+}
+
+void SiEffectBandSplit::split(int p_channels, const double *p_input, int p_length) {
+	const int required_size = p_length << 1;
+	for (int i = 0; i < BAND_MAX; i++) {
+		if (_bands[i].size() < required_size) {
+			_bands[i].resize(required_size);
+		}
+	}
+
+	double *low = _bands[BAND_LOW].ptrw();
+	double *mid = _bands[BAND_MID].ptrw();
+	double *high = _bands[BAND_HIGH].ptrw();
+
+	_low_mid_low.process(p_channels, p_input, low, p_length);
+	_low_mid_high.process(p_channels, p_input, mid, p_length);
+	// The upper half is stereo from here on. The mid band is split in place, high first.
+	_mid_high_high.process(2, mid, high, p_length);
+	_mid_high_low.process(2, mid, mid, p_length);
+
+	_length = p_length;
+	_split = true;
+}
+
+void SiEffectBandSplit::recombine(double *r_output) {
+	ERR_FAIL_COND(!_split);
+
+	const double *low = _bands[BAND_LOW].ptr();
+	const double *mid = _bands[BAND_MID].ptr();
+	const double *high = _bands[BAND_HIGH].ptr();
+	const int length = _length << 1;
+	for (int i = 0; i < length; i++) {
+		r_output[i] = low[i] + mid[i] + high[i];
+	}
+
+	_split = false;
+}
+
+void SiEffectBandSplit::clear() {
+	_low_mid_low.clear();
+	_low_mid_high.clear();
+	_mid_high_low.clear();
+	_mid_high_high.clear();
+	_split = false;
+}
@@ -0,0 +1,69 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SI_EFFECT_BAND_SPLIT_H
+#define SI_EFFECT_BAND_SPLIT_H
+
+#include <godot_cpp/templates/vector.hpp>
+#include "effector/components/si_effect_biquad_cascade.h"
+
+using namespace godot;
+
+// Splits an interleaved stereo block into low, mid, and high bands, and sums them back.
+// This is a building block class, not a standalone effect.
+//
+// The signal is split with a Linkwitz-Riley crossover at the low/mid frequency, and the
+// upper half again at the mid/high frequency, so the three bands add up to an all-pass
+// version of the input. Effect streams keep one split per run of band-aware effects, so
+// effects that agree on the crossover read and modify the same band buffers instead of
+// each filtering the signal on its own.
+class SiEffectBandSplit {
+public:
+	enum Band {
+		BAND_LOW = 0,
+		BAND_MID,
+		BAND_HIGH,
+
+		BAND_MAX
+	};
+
+private:
+	double _low_mid_hz = 0.0;
+	double _mid_high_hz = 0.0;
+	double _sampling_rate = 0.0;
+
+	SiEffectBiquadCascade _low_mid_low = SiEffectBiquadCascade(2);
+	SiEffectBiquadCascade _low_mid_high = SiEffectBiquadCascade(2);
+	SiEffectBiquadCascade _mid_high_low = SiEffectBiquadCascade(2);
+	SiEffectBiquadCascade _mid_high_high = SiEffectBiquadCascade(2);
+
+	Vector<double> _bands[BAND_MAX];
+	int _length = 0;
+	bool _split = false;
+
+public:
+	bool matches(double p_low_mid_hz, double p_mid_high_hz, double p_sampling_rate) const;
+	// Takes effect on the next split. Filter history is kept, so moving a crossover doesn't click.
+	void set_frequencies(double p_low_mid_hz, double p_mid_high_hz, double p_sampling_rate);
+	double get_low_mid_frequency() const { return _low_mid_hz; }
+	double get_mid_high_frequency() const { return _mid_high_hz; }
+
+	// Split p_length frames of p_input. Each band is then an interleaved stereo block of the
+	// same length, even for mono input.
+	void split(int p_channels, const double *p_input, int p_length);
+	bool is_split() const { return _split; }
+	int get_length() const { return _length; }
+	double *get_band(Band p_band) { return _bands[p_band].ptrw(); }
+
+	// Write the sum of the bands to r_output, which may be the buffer they were split from.
+	void recombine(double *r_output);
+	void clear();
+
+	SiEffectBandSplit() {}
+	~SiEffectBandSplit() {}
+};
+
+#endif // SI_EFFECT_BAND_SPLIT_H
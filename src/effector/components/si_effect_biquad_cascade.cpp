@@ -0,0 +1,332 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#include "si_effect_biquad_cascade.h"
+
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/core/math.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SION_BIQUAD_SSE 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SION_BIQUAD_NEON 1
+#include <arm_neon.h>
+#endif
+
+const double SiEffectBiquadCascade::DENORMAL_THRESHOLD = 1e-15;
+const double SiEffectBiquadCascade::CLAMP_THRESHOLD = 0.0000152587890625;
+
+namespace {
+
+// Run one stage with fixed coefficients over frames [p_from, p_to) of both channels.
+void _run_biquad(const BiquadCoeffs &p_coeffs, double *r_s1, double *r_s2, const double *p_input, double *r_output, int p_from, int p_to, bool p_mono_input) {
+#if defined(SION_BIQUAD_SSE)
+	const __m128d b0 = _mm_set1_pd(p_coeffs.b0);
+	const __m128d b1 = _mm_set1_pd(p_coeffs.b1);
+	const __m128d b2 = _mm_set1_pd(p_coeffs.b2);
+	const __m128d a1 = _mm_set1_pd(p_coeffs.a1);
+	const __m128d a2 = _mm_set1_pd(p_coeffs.a2);
+	__m128d s1 = _mm_load_pd(r_s1);
+	__m128d s2 = _mm_load_pd(r_s2);
+
+	for (int i = p_from; i < p_to; i++) {
+		__m128d x = p_mono_input ? _mm_set1_pd(p_input[i << 1]) : _mm_loadu_pd(p_input + (i << 1));
+		__m128d y = _mm_add_pd(_mm_mul_pd(b0, x), s1);
+		s1 = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(b1, x), _mm_mul_pd(a1, y)), s2);
+		s2 = _mm_sub_pd(_mm_mul_pd(b2, x), _mm_mul_pd(a2, y));
+		_mm_storeu_pd(r_output + (i << 1), y);
+	}
+
+	_mm_store_pd(r_s1, s1);
+	_mm_store_pd(r_s2, s2);
+#elif defined(SION_BIQUAD_NEON)
+	const float64x2_t b0 = vdupq_n_f64(p_coeffs.b0);
+	const float64x2_t b1 = vdupq_n_f64(p_coeffs.b1);
+	const float64x2_t b2 = vdupq_n_f64(p_coeffs.b2);
+	const float64x2_t a1 = vdupq_n_f64(p_coeffs.a1);
+	const float64x2_t a2 = vdupq_n_f64(p_coeffs.a2);
+	float64x2_t s1 = vld1q_f64(r_s1);
+	float64x2_t s2 = vld1q_f64(r_s2);
+
+	for (int i = p_from; i < p_to; i++) {
+		float64x2_t x = p_mono_input ? vdupq_n_f64(p_input[i << 1]) : vld1q_f64(p_input + (i << 1));
+		float64x2_t y = vfmaq_f64(s1, b0, x);
+		s1 = vfmsq_f64(vfmaq_f64(s2, b1, x), a1, y);
+		s2 = vfmsq_f64(vmulq_f64(b2, x), a2, y);
+		vst1q_f64(r_output + (i << 1), y);
+	}
+
+	vst1q_f64(r_s1, s1);
+	vst1q_f64(r_s2, s2);
+#else
+	for (int i = p_from; i < p_to; i++) {
+		const int index = i << 1;
+		double x_left = p_input[index];
+		double x_right = p_mono_input ? x_left : p_input[index + 1];
+
+		double y_left = p_coeffs.b0 * x_left + r_s1[0];
+		double y_right = p_coeffs.b0 * x_right + r_s1[1];
+		r_s1[0] = p_coeffs.b1 * x_left - p_coeffs.a1 * y_left + r_s2[0];
+		r_s1[1] = p_coeffs.b1 * x_right - p_coeffs.a1 * y_right + r_s2[1];
+		r_s2[0] = p_coeffs.b2 * x_left - p_coeffs.a2 * y_left;
+		r_s2[1] = p_coeffs.b2 * x_right - p_coeffs.a2 * y_right;
+
+		r_output[index] = y_left;
+		r_output[index + 1] = y_right;
+	}
+#endif
+}
+
+// Run one clamped feedback stage over frames [p_from, p_to) of both channels. The sums are
+// taken in the same order as the scalar direct form I they replace.
+void _run_biquad_clamped(const BiquadCoeffs &p_coeffs, double *r_x1, double *r_x2, double *r_y1, double *r_y2, const double *p_input, double *r_output, int p_from, int p_to, bool p_mono_input) {
+#if defined(SION_BIQUAD_SSE)
+	const __m128d b0 = _mm_set1_pd(p_coeffs.b0);
+	const __m128d b1 = _mm_set1_pd(p_coeffs.b1);
+	const __m128d b2 = _mm_set1_pd(p_coeffs.b2);
+	const __m128d a1 = _mm_set1_pd(p_coeffs.a1);
+	const __m128d a2 = _mm_set1_pd(p_coeffs.a2);
+	const __m128d lower = _mm_set1_pd(-1.0);
+	const __m128d upper = _mm_set1_pd(1.0);
+	__m128d x1 = _mm_load_pd(r_x1);
+	__m128d x2 = _mm_load_pd(r_x2);
+	__m128d y1 = _mm_load_pd(r_y1);
+	__m128d y2 = _mm_load_pd(r_y2);
+
+	for (int i = p_from; i < p_to; i++) {
+		__m128d x = p_mono_input ? _mm_set1_pd(p_input[i << 1]) : _mm_loadu_pd(p_input + (i << 1));
+		__m128d y = _mm_add_pd(_mm_add_pd(_mm_mul_pd(b0, x), _mm_mul_pd(b1, x1)), _mm_mul_pd(b2, x2));
+		y = _mm_sub_pd(_mm_sub_pd(y, _mm_mul_pd(a1, y1)), _mm_mul_pd(a2, y2));
+		y = _mm_min_pd(_mm_max_pd(y, lower), upper);
+
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = y;
+		_mm_storeu_pd(r_output + (i << 1), y);
+	}
+
+	_mm_store_pd(r_x1, x1);
+	_mm_store_pd(r_x2, x2);
+	_mm_store_pd(r_y1, y1);
+	_mm_store_pd(r_y2, y2);
+#elif defined(SION_BIQUAD_NEON)
+	const float64x2_t b0 = vdupq_n_f64(p_coeffs.b0);
+	const float64x2_t b1 = vdupq_n_f64(p_coeffs.b1);
+	const float64x2_t b2 = vdupq_n_f64(p_coeffs.b2);
+	const float64x2_t a1 = vdupq_n_f64(p_coeffs.a1);
+	const float64x2_t a2 = vdupq_n_f64(p_coeffs.a2);
+	const float64x2_t lower = vdupq_n_f64(-1.0);
+	const float64x2_t upper = vdupq_n_f64(1.0);
+	float64x2_t x1 = vld1q_f64(r_x1);
+	float64x2_t x2 = vld1q_f64(r_x2);
+	float64x2_t y1 = vld1q_f64(r_y1);
+	float64x2_t y2 = vld1q_f64(r_y2);
+
+	for (int i = p_from; i < p_to; i++) {
+		float64x2_t x = p_mono_input ? vdupq_n_f64(p_input[i << 1]) : vld1q_f64(p_input + (i << 1));
+		float64x2_t y = vaddq_f64(vaddq_f64(vmulq_f64(b0, x), vmulq_f64(b1, x1)), vmulq_f64(b2, x2));
+		y = vsubq_f64(vsubq_f64(y, vmulq_f64(a1, y1)), vmulq_f64(a2, y2));
+		y = vminq_f64(vmaxq_f64(y, lower), upper);
+
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = y;
+		vst1q_f64(r_output + (i << 1), y);
+	}
+
+	vst1q_f64(r_x1, x1);
+	vst1q_f64(r_x2, x2);
+	vst1q_f64(r_y1, y1);
+	vst1q_f64(r_y2, y2);
+#else
+	for (int i = p_from; i < p_to; i++) {
+		const int index = i << 1;
+		double x[2] = { p_input[index], p_mono_input ? p_input[index] : p_input[index + 1] };
+
+		for (int c = 0; c < 2; c++) {
+			double y = p_coeffs.b0 * x[c] + p_coeffs.b1 * r_x1[c] + p_coeffs.b2 * r_x2[c] - p_coeffs.a1 * r_y1[c] - p_coeffs.a2 * r_y2[c];
+			y = CLAMP(y, -1.0, 1.0);
+
+			r_x2[c] = r_x1[c];
+			r_x1[c] = x[c];
+			r_y2[c] = r_y1[c];
+			r_y1[c] = y;
+			r_output[index + c] = y;
+		}
+	}
+#endif
+}
+
+} // namespace
+
+void SiEffectBiquadCascade::Stage::clear_history() {
+	s1[0] = s1[1] = 0.0;
+	s2[0] = s2[1] = 0.0;
+	x1[0] = x1[1] = 0.0;
+	x2[0] = x2[1] = 0.0;
+}
+
+bool SiEffectBiquadCascade::_is_identity(const BiquadCoeffs &p_coeffs) {
+	return p_coeffs.b0 == 1.0 && p_coeffs.b1 == 0.0 && p_coeffs.b2 == 0.0 && p_coeffs.a1 == 0.0 && p_coeffs.a2 == 0.0;
+}
+
+void SiEffectBiquadCascade::_update_active(Stage &r_stage) {
+	// Clamped stages limit the signal even at unity gain.
+	r_stage.active = r_stage.mode == STAGE_CLAMPED_FEEDBACK || r_stage.ramping || !_is_identity(r_stage.current);
+	if (!r_stage.active) {
+		// Bypassed stages keep no history, so they start clean when they come back.
+		r_stage.clear_history();
+	}
+}
+
+void SiEffectBiquadCascade::set_stage_count(int p_count) {
+	int count = CLAMP(p_count, 0, MAX_STAGES);
+	for (int i = _stage_count; i < count; i++) {
+		_stages[i] = Stage();
+	}
+	_stage_count = count;
+}
+
+void SiEffectBiquadCascade::set_stage_mode(int p_stage, StageMode p_mode) {
+	ERR_FAIL_INDEX(p_stage, _stage_count);
+	Stage &stage = _stages[p_stage];
+	if (stage.mode == p_mode) {
+		return;
+	}
+
+	// The two modes keep different history.
+	stage.mode = p_mode;
+	stage.clear_history();
+	_update_active(stage);
+}
+
+void SiEffectBiquadCascade::set_coefficients(int p_stage, const BiquadCoeffs &p_coeffs, bool p_ramp) {
+	ERR_FAIL_INDEX(p_stage, _stage_count);
+	Stage &stage = _stages[p_stage];
+
+	stage.target = p_coeffs;
+	if (!p_ramp || p_coeffs.approx_equal(stage.current)) {
+		stage.current = p_coeffs;
+		stage.ramping = false;
+	} else {
+		stage.ramping = true;
+	}
+	_update_active(stage);
+}
+
+bool SiEffectBiquadCascade::is_ramping() const {
+	for (int i = 0; i < _stage_count; i++) {
+		if (_stages[i].ramping) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void SiEffectBiquadCascade::_process_stage(Stage &r_stage, const double *p_input, double *r_output, int p_length, bool p_mono_input) {
+	const bool clamped = (r_stage.mode == STAGE_CLAMPED_FEEDBACK);
+	if (clamped) {
+		for (int i = 0; i < 2; i++) {
+			if (r_stage.s1[i] < CLAMP_THRESHOLD) {
+				r_stage.s1[i] = 0.0;
+				r_stage.s2[i] = 0.0;
+			}
+		}
+	}
+
+	if (!r_stage.ramping) {
+		if (clamped) {
+			_run_biquad_clamped(r_stage.current, r_stage.x1, r_stage.x2, r_stage.s1, r_stage.s2, p_input, r_output, 0, p_length, p_mono_input);
+		} else {
+			_run_biquad(r_stage.current, r_stage.s1, r_stage.s2, p_input, r_output, 0, p_length, p_mono_input);
+		}
+	} else {
+		// Step through the ramp in short runs of constant coefficients.
+		const double inv_length = 1.0 / (double)p_length;
+		BiquadCoeffs step;
+		step.b0 = (r_stage.target.b0 - r_stage.current.b0) * inv_length;
+		step.b1 = (r_stage.target.b1 - r_stage.current.b1) * inv_length;
+		step.b2 = (r_stage.target.b2 - r_stage.current.b2) * inv_length;
+		step.a1 = (r_stage.target.a1 - r_stage.current.a1) * inv_length;
+		step.a2 = (r_stage.target.a2 - r_stage.current.a2) * inv_length;
+
+		BiquadCoeffs coeffs = r_stage.current;
+		for (int from = 0; from < p_length; from += RAMP_INTERVAL) {
+			int to = MIN(from + RAMP_INTERVAL, p_length);
+			if (clamped) {
+				_run_biquad_clamped(coeffs, r_stage.x1, r_stage.x2, r_stage.s1, r_stage.s2, p_input, r_output, from, to, p_mono_input);
+			} else {
+				_run_biquad(coeffs, r_stage.s1, r_stage.s2, p_input, r_output, from, to, p_mono_input);
+			}
+
+			double frames = (double)(to - from);
+			coeffs.b0 += step.b0 * frames;
+			coeffs.b1 += step.b1 * frames;
+			coeffs.b2 += step.b2 * frames;
+			coeffs.a1 += step.a1 * frames;
+			coeffs.a2 += step.a2 * frames;
+		}
+
+		r_stage.current = r_stage.target;
+		r_stage.ramping = false;
+		_update_active(r_stage);
+	}
+
+	if (clamped) {
+		// The threshold reset above takes care of decaying output.
+		return;
+	}
+	for (int i = 0; i < 2; i++) {
+		if (Math::abs(r_stage.s1[i]) < DENORMAL_THRESHOLD && Math::abs(r_stage.s2[i]) < DENORMAL_THRESHOLD) {
+			r_stage.s1[i] = 0.0;
+			r_stage.s2[i] = 0.0;
+		}
+	}
+}
+
+void SiEffectBiquadCascade::process(int p_channels, const double *p_input, double *r_output, int p_length) {
+	if (p_length <= 0) {
+		return;
+	}
+
+	const bool mono_input = (p_channels == 1);
+	const double *input = p_input;
+	bool mono = mono_input;
+
+	for (int i = 0; i < _stage_count; i++) {
+		Stage &stage = _stages[i];
+		if (!stage.active) {
+			continue;
+		}
+
+		// After the first stage both channels of the output are filled in.
+		_process_stage(stage, input, r_output, p_length, mono);
+		input = r_output;
+		mono = false;
+	}
+
+	if (input != r_output || mono) {
+		// Every stage is bypassed.
+		for (int i = 0; i < p_length; i++) {
+			double left = input[i << 1];
+			r_output[i << 1] = left;
+			r_output[(i << 1) + 1] = mono ? left : input[(i << 1) + 1];
+		}
+	}
+}
+
+void SiEffectBiquadCascade::clear() {
+	for (int i = 0; i < _stage_count; i++) {
+		_stages[i].clear_history();
+	}
+}
+
+SiEffectBiquadCascade::SiEffectBiquadCascade(int p_stage_count) {
+	set_stage_count(p_stage_count);
+}
@@ -0,0 +1,88 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SI_EFFECT_BIQUAD_CASCADE_H
+#define SI_EFFECT_BIQUAD_CASCADE_H
+
+#include "effector/components/biquad_coefficients.h"
+
+using namespace godot;
+
+// A chain of biquad stages applied to an interleaved stereo signal.
+// This is a building block class, not a standalone effect.
+//
+// Stages run in transposed direct form II, one stage at a time over the whole block, with
+// the left and right channels held in one SIMD register where SSE2 or NEON is available.
+// Since the effect buffers are interleaved, each frame is a single load and store.
+//
+// New coefficients can either be applied right away or ramped toward across the next
+// processed block. Ramps advance every RAMP_INTERVAL frames rather than every frame, and
+// finish exactly on the target. Stages left at unity gain are skipped, and filter state
+// that has decayed to denormal range is flushed after every block.
+class SiEffectBiquadCascade {
+public:
+	static const int MAX_STAGES = 8;
+	static const int RAMP_INTERVAL = 16;
+
+	enum StageMode {
+		STAGE_LINEAR,
+		// Direct form I with the output clamped to [-1, 1] before it is fed back into the
+		// recursion. At the start of every block, a channel whose last output is under
+		// CLAMP_THRESHOLD has its output history reset. Such stages are never bypassed.
+		STAGE_CLAMPED_FEEDBACK,
+	};
+
+private:
+	static const double DENORMAL_THRESHOLD;
+	static const double CLAMP_THRESHOLD;
+
+	struct Stage {
+		BiquadCoeffs current;
+		BiquadCoeffs target;
+		StageMode mode = STAGE_LINEAR;
+		bool ramping = false;
+		bool active = false;
+
+		// Left and right. In clamped feedback mode s1 and s2 hold the last two outputs, and
+		// x1 and x2 the last two inputs.
+		alignas(16) double s1[2] = {};
+		alignas(16) double s2[2] = {};
+		alignas(16) double x1[2] = {};
+		alignas(16) double x2[2] = {};
+
+		void clear_history();
+	};
+
+	Stage _stages[MAX_STAGES];
+	int _stage_count = 0;
+
+	static bool _is_identity(const BiquadCoeffs &p_coeffs);
+	void _update_active(Stage &r_stage);
+	void _process_stage(Stage &r_stage, const double *p_input, double *r_output, int p_length, bool p_mono_input);
+
+public:
+	int get_stage_count() const { return _stage_count; }
+	void set_stage_count(int p_count);
+
+	StageMode get_stage_mode(int p_stage) const { return _stages[p_stage].mode; }
+	void set_stage_mode(int p_stage, StageMode p_mode);
+
+	const BiquadCoeffs &get_coefficients(int p_stage) const { return _stages[p_stage].target; }
+	// With p_ramp, the stage moves to the new coefficients over the next processed block.
+	void set_coefficients(int p_stage, const BiquadCoeffs &p_coeffs, bool p_ramp = false);
+	bool is_ramping() const;
+
+	// Filter p_length interleaved stereo frames. With one channel, only the left sample of
+	// each input frame is read and the result is written to both. The output may be the
+	// same buffer as the input.
+	void process(int p_channels, const double *p_input, double *r_output, int p_length);
+	void clear();
+
+	SiEffectBiquadCascade(int p_stage_count = 1);
+	~SiEffectBiquadCascade() {}
+};
+
+#endif // SI_EFFECT_BIQUAD_CASCADE_H
@@ -0,0 +1,278 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#include "si_effect_fdn_core.h"
+
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/core/math.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SION_FDN_SSE 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SION_FDN_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr double FEEDBACK_LIMIT = 3.0;
+
+static_assert(SiEffectFDNCore::MAX_LINES % 2 == 0, "Lines are processed two at a time.");
+
+double _get_one_pole_alpha(double p_hz, double p_sample_rate) {
+	double clamped = CLAMP(p_hz, 10.0, p_sample_rate * 0.45);
+	return Math::exp(-2.0 * Math_PI * clamped / p_sample_rate);
+}
+
+// Linear interpolation between the two frames around each read position.
+void _interpolate_lines(int p_count, const double *p_a, const double *p_b, const double *p_fractions, double *r_out) {
+#if defined(SION_FDN_SSE)
+	for (int l = 0; l < p_count; l += 2) {
+		__m128d a = _mm_load_pd(p_a + l);
+		__m128d b = _mm_load_pd(p_b + l);
+		__m128d value = _mm_add_pd(a, _mm_mul_pd(_mm_sub_pd(b, a), _mm_load_pd(p_fractions + l)));
+		_mm_store_pd(r_out + l, value);
+	}
+#elif defined(SION_FDN_NEON)
+	for (int l = 0; l < p_count; l += 2) {
+		float64x2_t a = vld1q_f64(p_a + l);
+		float64x2_t b = vld1q_f64(p_b + l);
+		vst1q_f64(r_out + l, vfmaq_f64(a, vsubq_f64(b, a), vld1q_f64(p_fractions + l)));
+	}
+#else
+	for (int l = 0; l < p_count; l++) {
+		r_out[l] = p_a[l] + (p_b[l] - p_a[l]) * p_fractions[l];
+	}
+#endif
+}
+
+// One-pole high-pass into one-pole low-pass, per line. Same response as the scalar
+// filters the reverbs used before.
+void _damp_lines(int p_count, const double *p_input, const double *p_hp_alphas, double *r_hp_x1, double *r_hp_y1, const double *p_lp_alphas, double *r_lp_z, double *r_out) {
+#if defined(SION_FDN_SSE)
+	for (int l = 0; l < p_count; l += 2) {
+		__m128d input = _mm_load_pd(p_input + l);
+		__m128d x1 = _mm_load_pd(r_hp_x1 + l);
+		__m128d y1 = _mm_load_pd(r_hp_y1 + l);
+		__m128d high = _mm_mul_pd(_mm_load_pd(p_hp_alphas + l), _mm_sub_pd(_mm_add_pd(y1, input), x1));
+		_mm_store_pd(r_hp_x1 + l, input);
+		_mm_store_pd(r_hp_y1 + l, high);
+
+		__m128d z = _mm_load_pd(r_lp_z + l);
+		z = _mm_add_pd(high, _mm_mul_pd(_mm_load_pd(p_lp_alphas + l), _mm_sub_pd(z, high)));
+		_mm_store_pd(r_lp_z + l, z);
+		_mm_store_pd(r_out + l, z);
+	}
+#elif defined(SION_FDN_NEON)
+	for (int l = 0; l < p_count; l += 2) {
+		float64x2_t input = vld1q_f64(p_input + l);
+		float64x2_t x1 = vld1q_f64(r_hp_x1 + l);
+		float64x2_t y1 = vld1q_f64(r_hp_y1 + l);
+		float64x2_t high = vmulq_f64(vld1q_f64(p_hp_alphas + l), vsubq_f64(vaddq_f64(y1, input), x1));
+		vst1q_f64(r_hp_x1 + l, input);
+		vst1q_f64(r_hp_y1 + l, high);
+
+		float64x2_t z = vld1q_f64(r_lp_z + l);
+		z = vfmaq_f64(high, vld1q_f64(p_lp_alphas + l), vsubq_f64(z, high));
+		vst1q_f64(r_lp_z + l, z);
+		vst1q_f64(r_out + l, z);
+	}
+#else
+	for (int l = 0; l < p_count; l++) {
+		double high = p_hp_alphas[l] * (r_hp_y1[l] + p_input[l] - r_hp_x1[l]);
+		r_hp_x1[l] = p_input[l];
+		r_hp_y1[l] = high;
+		r_lp_z[l] = high + p_lp_alphas[l] * (r_lp_z[l] - high);
+		r_out[l] = r_lp_z[l];
+	}
+#endif
+}
+
+// Normalized Hadamard mix. With four lines, the pairs are summed and differenced
+// against each other first, then within each result.
+void _mix_lines(int p_count, const double *p_input, double *r_out) {
+	if (p_count == 4) {
+#if defined(SION_FDN_SSE)
+		__m128d low = _mm_load_pd(p_input);
+		__m128d high = _mm_load_pd(p_input + 2);
+		__m128d sums = _mm_add_pd(low, high);
+		__m128d diffs = _mm_sub_pd(low, high);
+		__m128d firsts = _mm_unpacklo_pd(sums, diffs);
+		__m128d seconds = _mm_unpackhi_pd(sums, diffs);
+		__m128d even = _mm_add_pd(firsts, seconds); // Lines 0 and 2.
+		__m128d odd = _mm_sub_pd(firsts, seconds);  // Lines 1 and 3.
+		__m128d scale = _mm_set1_pd(0.5);
+		_mm_store_pd(r_out, _mm_mul_pd(_mm_unpacklo_pd(even, odd), scale));
+		_mm_store_pd(r_out + 2, _mm_mul_pd(_mm_unpackhi_pd(even, odd), scale));
+#elif defined(SION_FDN_NEON)
+		float64x2_t low = vld1q_f64(p_input);
+		float64x2_t high = vld1q_f64(p_input + 2);
+		float64x2_t sums = vaddq_f64(low, high);
+		float64x2_t diffs = vsubq_f64(low, high);
+		float64x2_t firsts = vzip1q_f64(sums, diffs);
+		float64x2_t seconds = vzip2q_f64(sums, diffs);
+		float64x2_t even = vaddq_f64(firsts, seconds); // Lines 0 and 2.
+		float64x2_t odd = vsubq_f64(firsts, seconds);  // Lines 1 and 3.
+		vst1q_f64(r_out, vmulq_n_f64(vzip1q_f64(even, odd), 0.5));
+		vst1q_f64(r_out + 2, vmulq_n_f64(vzip2q_f64(even, odd), 0.5));
+#else
+		double sum_a = p_input[0] + p_input[2];
+		double sum_b = p_input[1] + p_input[3];
+		double diff_a = p_input[0] - p_input[2];
+		double diff_b = p_input[1] - p_input[3];
+		r_out[0] = (sum_a + sum_b) * 0.5;
+		r_out[1] = (sum_a - sum_b) * 0.5;
+		r_out[2] = (diff_a + diff_b) * 0.5;
+		r_out[3] = (diff_a - diff_b) * 0.5;
+#endif
+		return;
+	}
+
+	double first = p_input[0];
+	double second = p_input[1];
+	r_out[0] = (first + second) * Math_SQRT12;
+	r_out[1] = (first - second) * Math_SQRT12;
+}
+
+// Add the inputs to the mixed feedback and store the clamped result as the new frame.
+void _feed_lines(int p_count, const double *p_inputs, const double *p_mixed, const double *p_gains, double *r_frame) {
+#if defined(SION_FDN_SSE)
+	const __m128d upper = _mm_set1_pd(FEEDBACK_LIMIT);
+	const __m128d lower = _mm_set1_pd(-FEEDBACK_LIMIT);
+	for (int l = 0; l < p_count; l += 2) {
+		__m128d value = _mm_add_pd(_mm_loadu_pd(p_inputs + l), _mm_mul_pd(_mm_load_pd(p_mixed + l), _mm_load_pd(p_gains + l)));
+		value = _mm_max_pd(_mm_min_pd(value, upper), lower);
+		_mm_storeu_pd(r_frame + l, value);
+	}
+#elif defined(SION_FDN_NEON)
+	const float64x2_t upper = vdupq_n_f64(FEEDBACK_LIMIT);
+	const float64x2_t lower = vdupq_n_f64(-FEEDBACK_LIMIT);
+	for (int l = 0; l < p_count; l += 2) {
+		float64x2_t value = vfmaq_f64(vld1q_f64(p_inputs + l), vld1q_f64(p_mixed + l), vld1q_f64(p_gains + l));
+		value = vmaxq_f64(vminq_f64(value, upper), lower);
+		vst1q_f64(r_frame + l, value);
+	}
+#else
+	for (int l = 0; l < p_count; l++) {
+		r_frame[l] = CLAMP(p_inputs[l] + p_mixed[l] * p_gains[l], -FEEDBACK_LIMIT, FEEDBACK_LIMIT);
+	}
+#endif
+}
+
+} // namespace
+
+void SiEffectFDNCore::resize(int p_max_delay) {
+	int length = 2;
+	while (length < p_max_delay) {
+		length <<= 1;
+	}
+
+	_frame_mask = length - 1;
+	_memory.resize(length * _line_count);
+	reset();
+}
+
+void SiEffectFDNCore::reset() {
+	if (!_memory.is_empty()) {
+		_memory.fill(0.0);
+	}
+	_write_frame = 0;
+
+	for (int i = 0; i < MAX_LINES; i++) {
+		_delays[i] = 0.0;
+		_delay_steps[i] = 0.0;
+		_high_pass_x1[i] = 0.0;
+		_high_pass_y1[i] = 0.0;
+		_low_pass_z[i] = 0.0;
+	}
+	_delays_primed = false;
+}
+
+void SiEffectFDNCore::write_frame(const double *p_values) {
+	double *frame = _memory.ptrw() + _write_frame * _line_count;
+	for (int i = 0; i < _line_count; i++) {
+		frame[i] = p_values[i];
+	}
+	_write_frame = (_write_frame + 1) & _frame_mask;
+}
+
+void SiEffectFDNCore::set_delays(const double *p_delays, int p_length) {
+	// Fractional reads need the frame after the one they start from.
+	const double max_delay = (double)(_frame_mask - 1);
+
+	if (!_delays_primed) {
+		for (int i = 0; i < _line_count; i++) {
+			_delays[i] = CLAMP(p_delays[i], 1.0, max_delay);
+			_delay_steps[i] = 0.0;
+		}
+		_delays_primed = true;
+		return;
+	}
+
+	const int length = MAX(p_length, 1);
+	for (int i = 0; i < _line_count; i++) {
+		_delay_steps[i] = (CLAMP(p_delays[i], 1.0, max_delay) - _delays[i]) / length;
+	}
+}
+
+void SiEffectFDNCore::set_feedback_gains(const double *p_gains) {
+	for (int i = 0; i < _line_count; i++) {
+		_feedback_gains[i] = p_gains[i];
+	}
+}
+
+void SiEffectFDNCore::set_damping(double p_low_cut_hz, double p_high_cut_hz, double p_sample_rate) {
+	double high_pass_alpha = _get_one_pole_alpha(p_low_cut_hz, p_sample_rate);
+	double low_pass_alpha = _get_one_pole_alpha(p_high_cut_hz, p_sample_rate);
+	for (int i = 0; i < _line_count; i++) {
+		_high_pass_alphas[i] = high_pass_alpha;
+		_low_pass_alphas[i] = low_pass_alpha;
+	}
+}
+
+void SiEffectFDNCore::_read_lines(const double *p_memory, double *r_reads) const {
+	alignas(16) double before[MAX_LINES];
+	alignas(16) double after[MAX_LINES];
+	alignas(16) double fractions[MAX_LINES];
+
+	for (int i = 0; i < _line_count; i++) {
+		double position = (double)_write_frame - _delays[i];
+		int frame = (int)Math::floor(position);
+		fractions[i] = position - (double)frame;
+		before[i] = p_memory[(frame & _frame_mask) * _line_count + i];
+		after[i] = p_memory[((frame + 1) & _frame_mask) * _line_count + i];
+	}
+
+	_interpolate_lines(_line_count, before, after, fractions, r_reads);
+}
+
+void SiEffectFDNCore::process_frame(const double *p_inputs, double *r_outputs) {
+	ERR_FAIL_COND(_memory.is_empty());
+
+	double *memory = _memory.ptrw();
+	alignas(16) double reads[MAX_LINES];
+	alignas(16) double damped[MAX_LINES];
+	alignas(16) double mixed[MAX_LINES];
+
+	_read_lines(memory, reads);
+	for (int i = 0; i < _line_count; i++) {
+		_delays[i] += _delay_steps[i];
+	}
+
+	_damp_lines(_line_count, reads, _high_pass_alphas, _high_pass_x1, _high_pass_y1, _low_pass_alphas, _low_pass_z, damped);
+	_mix_lines(_line_count, damped, mixed);
+	_feed_lines(_line_count, p_inputs, mixed, _feedback_gains, memory + _write_frame * _line_count);
+	_write_frame = (_write_frame + 1) & _frame_mask;
+
+	for (int i = 0; i < _line_count; i++) {
+		r_outputs[i] = damped[i];
+	}
+}
+
+SiEffectFDNCore::SiEffectFDNCore(int p_line_count) {
+	_line_count = (p_line_count <= 2 ? 2 : MAX_LINES);
+}
@@ -0,0 +1,77 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SI_EFFECT_FDN_CORE_H
+#define SI_EFFECT_FDN_CORE_H
+
+#include <godot_cpp/templates/vector.hpp>
+
+using namespace godot;
+
+// A bank of delay lines sharing one block of memory, with an optional feedback network.
+// This is a building block class, not a standalone effect.
+//
+// Lines are interleaved frame by frame in a power-of-two ring, so writing every line at
+// once is a single contiguous store and wrapping is a mask. Reverbs can use the bank as
+// plain multi-tap delay memory (read_frame(), write_frame()), or run it as a feedback
+// delay network: process_frame() reads each line at its own modulated length, damps the
+// reads with a one-pole high-pass and low-pass, mixes them through a Hadamard matrix and
+// writes them back with the per-line feedback gain. Line state is processed two lines per
+// SIMD operation where SSE2 or NEON is available.
+//
+// Line lengths are set once per block by the caller and ramped linearly across it, so the
+// modulation source only has to be evaluated at block boundaries.
+class SiEffectFDNCore {
+public:
+	static const int MAX_LINES = 4;
+
+private:
+	int _line_count = MAX_LINES;
+	int _frame_mask = 0;
+	int _write_frame = 0;
+	Vector<double> _memory;
+
+	alignas(16) double _delays[MAX_LINES] = {};
+	alignas(16) double _delay_steps[MAX_LINES] = {};
+	alignas(16) double _feedback_gains[MAX_LINES] = {};
+	alignas(16) double _high_pass_alphas[MAX_LINES] = {};
+	alignas(16) double _low_pass_alphas[MAX_LINES] = {};
+	alignas(16) double _high_pass_x1[MAX_LINES] = {};
+	alignas(16) double _high_pass_y1[MAX_LINES] = {};
+	alignas(16) double _low_pass_z[MAX_LINES] = {};
+	bool _delays_primed = false;
+
+	void _read_lines(const double *p_memory, double *r_reads) const;
+
+public:
+	int get_line_count() const { return _line_count; }
+	// Length of each line in frames; always a power of two.
+	int get_length() const { return _frame_mask + 1; }
+
+	// Make room for delays of up to p_max_delay frames. Clears the memory.
+	void resize(int p_max_delay);
+	void reset();
+
+	// Plain delay memory access. A delay of 1 reads the last frame written.
+	const double *read_frame(int p_delay) const { return _memory.ptr() + (((_write_frame - p_delay) & _frame_mask) * _line_count); }
+	void write_frame(const double *p_values);
+
+	// Line lengths to reach at the end of the next p_length frames, in fractional frames.
+	// The first call after a reset jumps to them right away.
+	void set_delays(const double *p_delays, int p_length);
+	void set_feedback_gains(const double *p_gains);
+	// Cutoffs of the damping filters inside the loop, shared by every line.
+	void set_damping(double p_low_cut_hz, double p_high_cut_hz, double p_sample_rate);
+
+	// Run the network for one frame. p_inputs are added to each line after the mix;
+	// r_outputs receive the damped line reads before the mix.
+	void process_frame(const double *p_inputs, double *r_outputs);
+
+	SiEffectFDNCore(int p_line_count = MAX_LINES);
+	~SiEffectFDNCore() {}
+};
+
+#endif // SI_EFFECT_FDN_CORE_H
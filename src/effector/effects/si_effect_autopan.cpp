@@ -7,6 +7,9 @@
 #include "si_effect_autopan.h"
 
 void SiEffectAutopan::set_params(double p_frequency, double p_stereo_width) {
+	_frequency = p_frequency;
+	_stereo_width = p_stereo_width;
+
 	_lfo_step = (int)((_get_sampling_rate() / 256.0) / (p_frequency * 0.5));
 	if (_lfo_step <= 4) {
 		_lfo_step = 4;
@@ -35,6 +38,10 @@ void SiEffectAutopan::set_params(double p_frequency, double p_stereo_width) {
 	}
 }
 
+void SiEffectAutopan::_on_sampling_rate_changed() {
+	set_params(_frequency, _stereo_width);
+}
+
 int SiEffectAutopan::prepare_process() {
 	return _stereo ? 2 : 1;
 }
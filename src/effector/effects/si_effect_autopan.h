@@ -16,6 +16,8 @@ class SiEffectAutopan : public SiEffectBase {
 	static const int BUFFER_SIZE = 256;
 
 	bool _stereo = false;
+	double _frequency = 0;
+	double _stereo_width = 0;
 	int _lfo_step = 0;
 	int _lfo_residue_step = 0;
 	SinglyLinkedList<double> *_p_left;
@@ -27,6 +29,8 @@ class SiEffectAutopan : public SiEffectBase {
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override;
+
 public:
 	void set_params(double p_frequency = 1, double p_stereo_width = 1);
 
@@ -34,6 +38,7 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual bool can_process_mono() const override { return !_stereo; }
 
 	virtual void set_by_mml(Vector<double> p_args) override;
 	virtual void reset() override;
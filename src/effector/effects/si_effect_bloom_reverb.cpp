@@ -200,10 +200,7 @@ void SiEffectBloomReverb::_ensure_delay_buffers() {
 		_diffusers_left[i].delay.resize_samples((int)Math::ceil(sample_rate * 0.03) + 4);
 		_diffusers_right[i].delay.resize_samples((int)Math::ceil(sample_rate * 0.03) + 4);
 	}
-	for (int i = 0; i < TANK_LINE_COUNT; i++) {
-		_tank[i].delay.resize_samples((int)Math::ceil(sample_rate * 0.18) + 8);
-		_tank[i].mod.reset(TANK_PHASE_OFFSETS[i]);
-	}
+	_tank.resize((int)Math::ceil(sample_rate * 0.18) + 8);
 	for (int i = 0; i < AIR_DELAY_COUNT; i++) {
 		_air_left.delays[i].resize_samples((int)Math::ceil(sample_rate * 0.04) + 4);
 		_air_right.delays[i].resize_samples((int)Math::ceil(sample_rate * 0.04) + 4);
@@ -227,11 +224,9 @@ void SiEffectBloomReverb::_reset_signal_state() {
 		_diffusers_left[i].reset();
 		_diffusers_right[i].reset();
 	}
+	_tank.reset();
 	for (int i = 0; i < TANK_LINE_COUNT; i++) {
-		_tank[i].delay.reset();
-		_tank[i].hp.reset();
-		_tank[i].lp.reset();
-		_tank[i].mod.reset(TANK_PHASE_OFFSETS[i]);
+		_tank_mods[i].reset(TANK_PHASE_OFFSETS[i]);
 	}
 	_air_left.reset();
 	_air_right.reset();
@@ -448,10 +443,21 @@ int SiEffectBloomReverb::process(int p_channels, Vector<double> *r_buffer, int p
 		_bloom_envelope_left.set_attack_ms(params.bloom_attack_ms, _get_sampling_rate());
 		_bloom_envelope_right.set_attack_ms(params.bloom_attack_ms, _get_sampling_rate());
 
+		_tank.set_damping(params.feedback_low_cut_hz, params.high_damp_hz, _get_sampling_rate());
+
+		// Modulated line lengths for the end of this segment; the core ramps toward them.
+		double tank_delays[TANK_LINE_COUNT] = {};
+		double tank_gains[TANK_LINE_COUNT] = {};
 		for (int line = 0; line < TANK_LINE_COUNT; line++) {
-			_tank[line].hp.set_cutoff(params.feedback_low_cut_hz, _get_sampling_rate());
-			_tank[line].lp.set_cutoff(params.high_damp_hz, _get_sampling_rate());
+			double mod = _tank_mods[line].process(
+					params.tank_mod_rates[line] * segment_length,
+					params.mod_depth_samples * TANK_MOD_DEPTH_SCALE[line],
+					_get_sampling_rate());
+			tank_delays[line] = params.tank_delay_samples[line] + mod;
+			tank_gains[line] = Math::lerp(params.tank_feedback_gain[line], 0.9995, params.freeze);
 		}
+		_tank.set_delays(tank_delays, segment_length);
+		_tank.set_feedback_gains(tank_gains);
 
 		for (int sample = 0; sample < segment_length; sample++) {
 			int frame_index = processed + sample;
@@ -496,24 +502,6 @@ int SiEffectBloomReverb::process(int p_channels, Vector<double> *r_buffer, int p
 				diffused_r = _diffusers_right[stage].process(diffused_r, params.diffuser_right_samples[stage], params.diffusion_feedback);
 			}
 
-			double tank_reads[TANK_LINE_COUNT] = {};
-			double tank_filtered[TANK_LINE_COUNT] = {};
-			for (int line = 0; line < TANK_LINE_COUNT; line++) {
-				double mod = _tank[line].mod.process(
-						params.tank_mod_rates[line],
-						params.mod_depth_samples * TANK_MOD_DEPTH_SCALE[line],
-						_get_sampling_rate());
-				tank_reads[line] = _tank[line].delay.read_samples(params.tank_delay_samples[line] + mod);
-				double filtered = _tank[line].hp.process(tank_reads[line]);
-				tank_filtered[line] = _tank[line].lp.process(filtered);
-			}
-
-			double mix0 = (tank_filtered[0] + tank_filtered[1] + tank_filtered[2] + tank_filtered[3]) * 0.5;
-			double mix1 = (tank_filtered[0] - tank_filtered[1] + tank_filtered[2] - tank_filtered[3]) * 0.5;
-			double mix2 = (tank_filtered[0] + tank_filtered[1] - tank_filtered[2] - tank_filtered[3]) * 0.5;
-			double mix3 = (tank_filtered[0] - tank_filtered[1] - tank_filtered[2] + tank_filtered[3]) * 0.5;
-			double matrix[TANK_LINE_COUNT] = { mix0, mix1, mix2, mix3 };
-
 			double injected[TANK_LINE_COUNT] = {
 				diffused_l + 0.25 * diffused_r,
 				diffused_r + 0.25 * diffused_l,
@@ -521,12 +509,8 @@ int SiEffectBloomReverb::process(int p_channels, Vector<double> *r_buffer, int p
 				0.60 * diffused_r - 0.30 * diffused_l,
 			};
 
-			for (int line = 0; line < TANK_LINE_COUNT; line++) {
-				double feedback_gain = Math::lerp(params.tank_feedback_gain[line], 0.9995, params.freeze);
-				double write_value = injected[line] + matrix[line] * feedback_gain;
-				write_value = CLAMP(write_value, -3.0, 3.0);
-				_tank[line].delay.write(write_value);
-			}
+			double tank_filtered[TANK_LINE_COUNT] = {};
+			_tank.process_frame(injected, tank_filtered);
 
 			double wet_l =
 					0.70 * tank_filtered[0] +
@@ -570,6 +554,20 @@ int SiEffectBloomReverb::process(int p_channels, Vector<double> *r_buffer, int p
 	return 2;
 }
 
+int SiEffectBloomReverb::get_tail_length() const {
+	// Longest quiet stretch a sound can spend travelling through the delay stages in series.
+	int tail_length = _predelay_left.buffer.size() + _early_left.buffer.size() + _tank.get_length();
+	for (int i = 0; i < INPUT_DIFFUSER_COUNT; i++) {
+		tail_length += _diffusers_left[i].delay.buffer.size();
+	}
+	for (int i = 0; i < AIR_DELAY_COUNT; i++) {
+		tail_length += _air_left.delays[i].buffer.size();
+	}
+	tail_length += _air_left.diffuser_a.delay.buffer.size() + _air_left.diffuser_b.delay.buffer.size();
+
+	return tail_length;
+}
+
 void SiEffectBloomReverb::set_by_mml(Vector<double> p_args) {
 	BloomParams parsed = _target_params;
 	for (int i = 0; i < ARG_COUNT; i++) {
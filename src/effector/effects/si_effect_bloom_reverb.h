@@ -9,6 +9,7 @@
 
 #include <godot_cpp/templates/vector.hpp>
 #include "effector/si_effect_base.h"
+#include "effector/components/si_effect_fdn_core.h"
 
 using namespace godot;
 
@@ -113,13 +114,6 @@ private:
 		void reset();
 	};
 
-	struct TankLine {
-		FractionalDelay delay;
-		OnePoleHighPass hp;
-		OnePoleLowPass lp;
-		Lfo mod;
-	};
-
 	struct AirSide {
 		FractionalDelay delays[AIR_DELAY_COUNT];
 		Lfo mods[AIR_DELAY_COUNT];
@@ -179,7 +173,10 @@ private:
 
 	AllpassStage _diffusers_left[INPUT_DIFFUSER_COUNT];
 	AllpassStage _diffusers_right[INPUT_DIFFUSER_COUNT];
-	TankLine _tank[TANK_LINE_COUNT];
+	// Delay lines, damping and Hadamard feedback of the tank run in one vectorized core;
+	// the modulation is evaluated here once per parameter update and ramped by the core.
+	SiEffectFDNCore _tank = SiEffectFDNCore(TANK_LINE_COUNT);
+	Lfo _tank_mods[TANK_LINE_COUNT];
 	AirSide _air_left;
 	AirSide _air_right;
 
@@ -219,6 +216,7 @@ protected:
 public:
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual int get_tail_length() const override;
 
 	virtual void set_by_mml(Vector<double> p_args) override;
 	virtual bool set_arg(int p_arg_index, double p_value) override;
@@ -70,10 +70,12 @@ int SiEffectCompressor::process(int p_channels, Vector<double> *r_buffer, int p_
 
 	int start_index = p_start_index << 1;
 	int length = p_length << 1;
+	// For mono input the detector sees the same signal on both sides, so only the left one is read.
+	const bool mono = (p_channels == 1);
 
 	for (int i = start_index; i < (start_index + length); i += 2) {
 		double l = (*r_buffer)[i];
-		double r = (*r_buffer)[i + 1];
+		double r = mono ? l : (*r_buffer)[i + 1];
 		double dry_l = l;
 		double dry_r = r;
 
@@ -98,10 +100,12 @@ int SiEffectCompressor::process(int p_channels, Vector<double> *r_buffer, int p_
 
 		// Apply gain and mix.
 		double wet_l = l * gain;
-		double wet_r = r * gain;
-
 		r_buffer->write[i] = Math::lerp(dry_l, wet_l, mix);
-		r_buffer->write[i + 1] = Math::lerp(dry_r, wet_r, mix);
+
+		if (!mono) {
+			double wet_r = r * gain;
+			r_buffer->write[i + 1] = Math::lerp(dry_r, wet_r, mix);
+		}
 	}
 
 	// Publish metering (positive value for UI).
@@ -110,6 +114,12 @@ int SiEffectCompressor::process(int p_channels, Vector<double> *r_buffer, int p_
 	return p_channels;
 }
 
+int SiEffectCompressor::get_tail_length() const {
+	// Let the gain reduction release fully, so the next hit doesn't start squashed.
+	const double release_ms = MAX((double)_params.release_ms.load(std::memory_order_relaxed), MIN_RELEASE_MS);
+	return (int)(release_ms * 5.0 * _get_samples_per_ms());
+}
+
 void SiEffectCompressor::set_by_mml(Vector<double> p_args) {
 	double threshold_db   = _get_mml_arg(p_args, 0, -18.0);
 	double ratio          = _get_mml_arg(p_args, 1, 4.0);
@@ -94,6 +94,8 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual bool can_process_mono() const override { return true; }
+	virtual int get_tail_length() const override;
 	virtual bool set_arg(int p_arg_index, double p_value) override;
 
 	virtual void set_by_mml(Vector<double> p_args) override;
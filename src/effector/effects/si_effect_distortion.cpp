@@ -9,6 +9,11 @@
 const double SiEffectDistortion::THRESHOLD = 0.0000152587890625;
 
 void SiEffectDistortion::set_params(double p_pre_gain, double p_post_gain, double p_lpf_frequency, double p_lpf_slope) {
+	_pre_gain = p_pre_gain;
+	_post_gain = p_post_gain;
+	_lpf_frequency = p_lpf_frequency;
+	_lpf_slope = p_lpf_slope;
+
 	_limit = Math::pow(2, -p_post_gain / 6.0);
 	_pre_scale = Math::pow(2, -p_pre_gain / 6.0) * _limit;
 	_filter_enabled = p_lpf_frequency > 0;
@@ -32,6 +37,10 @@ void SiEffectDistortion::set_params(double p_pre_gain, double p_post_gain, doubl
 	}
 }
 
+void SiEffectDistortion::_on_sampling_rate_changed() {
+	set_params(_pre_gain, _post_gain, _lpf_frequency, _lpf_slope);
+}
+
 int SiEffectDistortion::prepare_process() {
 	return 1;
 }
@@ -14,6 +14,11 @@ class SiEffectDistortion : public SiEffectBase {
 
 	static const double THRESHOLD;
 
+	double _pre_gain = 0;
+	double _post_gain = 0;
+	double _lpf_frequency = 0;
+	double _lpf_slope = 0;
+
 	bool _filter_enabled = false;
 	double _pre_scale = 0;
 	double _limit = 0;
@@ -32,6 +37,8 @@ class SiEffectDistortion : public SiEffectBase {
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override;
+
 public:
 	void set_params(double p_pre_gain = -60, double p_post_gain = 18, double p_lpf_frequency = 2400, double p_lpf_slope = 1);
 
@@ -39,6 +46,7 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual bool can_process_mono() const override { return true; }
 
 	virtual void set_by_mml(Vector<double> p_args) override;
 	virtual void reset() override;
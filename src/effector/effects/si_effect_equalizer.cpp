@@ -11,69 +11,74 @@ void SiEffectEqualizer::set_params(double p_low_gain, double p_mid_gain, double
 	_mid_gain = p_mid_gain * p_gain_scale;
 	_high_gain = p_high_gain * p_gain_scale;
 
-	double low_omega = _get_angular_frequency(p_low_frequency) * 0.5;
-	double high_omega = _get_angular_frequency(p_high_frequency) * 0.5;
-
-	_low_frequency = 2.0 * Math::sin(low_omega);
-	_high_frequency = 2.0 * Math::sin(high_omega);
+	_low_cutoff = p_low_frequency;
+	_high_cutoff = p_high_frequency;
+	_update_frequencies();
 }
 
-int SiEffectEqualizer::prepare_process() {
-	_left.clear();
-	_right.clear();
+void SiEffectEqualizer::_update_frequencies() {
+	double low_omega = _get_angular_frequency(_low_cutoff) * 0.5;
+	double high_omega = _get_angular_frequency(_high_cutoff) * 0.5;
 
-	return 2;
-}
+	double low_frequency = 2.0 * Math::sin(low_omega);
+	double high_frequency = 2.0 * Math::sin(high_omega);
 
-double SiEffectEqualizer::_process_channel(PipeChannel *p_channel, double p_value) {
-		p_channel->f1p0 += (_low_frequency * (p_value         - p_channel->f1p0)) + 2.3283064370807974e-10;
-		p_channel->f1p1 += (_low_frequency * (p_channel->f1p0 - p_channel->f1p1));
-		p_channel->f1p2 += (_low_frequency * (p_channel->f1p1 - p_channel->f1p2));
-		p_channel->f1p3 += (_low_frequency * (p_channel->f1p2 - p_channel->f1p3));
+	// Two one-poles y += f * (x - y) in series make one stage.
+	BiquadCoeffs low_coeffs;
+	low_coeffs.b0 = low_frequency * low_frequency;
+	low_coeffs.a1 = -2.0 * (1.0 - low_frequency);
+	low_coeffs.a2 = (1.0 - low_frequency) * (1.0 - low_frequency);
 
-		p_channel->f2p0 += (_high_frequency * (p_value         - p_channel->f2p0)) + 2.3283064370807974e-10;
-		p_channel->f2p1 += (_high_frequency * (p_channel->f2p0 - p_channel->f2p1));
-		p_channel->f2p2 += (_high_frequency * (p_channel->f2p1 - p_channel->f2p2));
-		p_channel->f2p3 += (_high_frequency * (p_channel->f2p2 - p_channel->f2p3));
+	BiquadCoeffs high_coeffs;
+	high_coeffs.b0 = high_frequency * high_frequency;
+	high_coeffs.a1 = -2.0 * (1.0 - high_frequency);
+	high_coeffs.a2 = (1.0 - high_frequency) * (1.0 - high_frequency);
 
-		double value_low  = p_channel->f1p3;
-		double value_high = p_channel->sdm3 - p_channel->f2p3;
-		double value_mid  = p_channel->sdm3 - (value_high + value_low);
+	for (int i = 0; i < 2; i++) {
+		_low_cascade.set_coefficients(i, low_coeffs);
+		_high_cascade.set_coefficients(i, high_coeffs);
+	}
+}
 
-		p_channel->sdm3 = p_channel->sdm2;
-		p_channel->sdm2 = p_channel->sdm1;
-		p_channel->sdm1 = p_value;
+int SiEffectEqualizer::prepare_process() {
+	_low_cascade.clear();
+	_high_cascade.clear();
+	for (int i = 0; i < 2; i++) {
+		_history[i][0] = _history[i][1] = _history[i][2] = 0;
+	}
 
-		return value_low * _low_gain + value_mid * _mid_gain + value_high * _high_gain;
+	return 2;
 }
 
-void SiEffectEqualizer::_process_mono(Vector<double> *r_buffer, int p_start_index, int p_length) {
-	for (int i = p_start_index; i < (p_start_index + p_length); i += 2) {
-		double value = _process_channel(&_left, (*r_buffer)[i]);
-
-		r_buffer->write[i] = value;
-		r_buffer->write[i + 1] = value;
+int SiEffectEqualizer::process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
+	const int length = p_length << 1;
+	if (_low_buffer.size() < length) {
+		_low_buffer.resize(length);
+		_high_buffer.resize(length);
 	}
-}
 
-void SiEffectEqualizer::_process_stereo(Vector<double> *r_buffer, int p_start_index, int p_length) {
-	for (int i = p_start_index; i < (p_start_index + p_length); i += 2) {
-		double value_left = _process_channel(&_left, (*r_buffer)[i]);
-		r_buffer->write[i] = value_left;
+	double *buffer = r_buffer->ptrw() + (p_start_index << 1);
+	double *low = _low_buffer.ptrw();
+	double *high = _high_buffer.ptrw();
+	_low_cascade.process(p_channels, buffer, low, p_length);
+	_high_cascade.process(p_channels, buffer, high, p_length);
 
-		double value_right = _process_channel(&_right, (*r_buffer)[i + 1]);
-		r_buffer->write[i + 1] = value_right;
-	}
-}
+	const int channels = (p_channels == 1 ? 1 : 2);
+	for (int i = 0; i < length; i += 2) {
+		for (int c = 0; c < channels; c++) {
+			double *history = _history[c];
+			const double value = buffer[i + c];
 
-int SiEffectEqualizer::process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
-	int start_index = p_start_index << 1;
-	int length = p_length << 1;
+			double value_low  = low[i + c];
+			double value_high = history[2] - high[i + c];
+			double value_mid  = history[2] - (value_high + value_low);
+
+			history[2] = history[1];
+			history[1] = history[0];
+			history[0] = value;
 
-	if (p_channels == 1) {
-		_process_mono(r_buffer, start_index, length);
-	} else {
-		_process_stereo(r_buffer, start_index, length);
+			buffer[i + c] = value_low * _low_gain + value_mid * _mid_gain + value_high * _high_gain;
+		}
 	}
 
 	return p_channels;
@@ -7,62 +7,35 @@
 #ifndef SI_EFFECT_EQUALIZER_H
 #define SI_EFFECT_EQUALIZER_H
 
+#include "effector/components/si_effect_biquad_cascade.h"
 #include "effector/si_effect_base.h"
 
 class SiEffectEqualizer : public SiEffectBase {
 	GDCLASS(SiEffectEqualizer, SiEffectBase)
 
-	// Filter pipes.
-
-	struct PipeChannel {
-		double f1p0 = 0;
-		double f1p1 = 0;
-		double f1p2 = 0;
-		double f1p3 = 0;
-
-		double f2p0 = 0;
-		double f2p1 = 0;
-		double f2p2 = 0;
-		double f2p3 = 0;
-
-		double sdm1 = 0;
-		double sdm2 = 0;
-		double sdm3 = 0;
-
-		void clear() {
-			f1p0 = 0;
-			f1p1 = 0;
-			f1p2 = 0;
-			f1p3 = 0;
-
-			f2p0 = 0;
-			f2p1 = 0;
-			f2p2 = 0;
-			f2p3 = 0;
-
-			sdm1 = 0;
-			sdm2 = 0;
-			sdm3 = 0;
-		}
-	};
-
-	PipeChannel _left;
-	PipeChannel _right;
+	// Each band edge is four one-pole lowpasses in series, run as two biquad stages.
+	SiEffectBiquadCascade _low_cascade = SiEffectBiquadCascade(2);
+	SiEffectBiquadCascade _high_cascade = SiEffectBiquadCascade(2);
+	Vector<double> _low_buffer;
+	Vector<double> _high_buffer;
+	// The last three input samples of each channel, newest first. The high band is taken
+	// against the input three samples back.
+	double _history[2][3] = {};
 
 	// Controls.
-	double _low_frequency = 0;
-	double _high_frequency = 0;
+	double _low_cutoff = 0;
+	double _high_cutoff = 0;
 	double _low_gain = 0;
 	double _mid_gain = 0;
 	double _high_gain = 0;
 
-	double _process_channel(PipeChannel *p_channel, double p_value);
-	void _process_mono(Vector<double> *r_buffer, int p_start_index, int p_length);
-	void _process_stereo(Vector<double> *r_buffer, int p_start_index, int p_length);
+	void _update_frequencies();
 
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override { _update_frequencies(); }
+
 public:
 	void set_params(double p_low_gain = 1, double p_mid_gain = 1, double p_high_gain = 1, double p_low_frequency = 880, double p_high_frequency = 5000, double p_gain_scale = 1);
 
@@ -70,6 +43,7 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual bool can_process_mono() const override { return true; }
 
 	virtual void set_by_mml(Vector<double> p_args) override;
 	virtual void reset() override;
@@ -6,8 +6,6 @@
 
 #include "si_effect_graphic_equalizer_8.h"
 
-const double SiEffectGraphicEqualizer8::DENORMAL_THRESHOLD = 1e-15;
-
 const double SiEffectGraphicEqualizer8::DEFAULT_FREQS[NUM_BANDS] = {
 	32.0, 64.0, 125.0, 250.0, 500.0, 1000.0, 4000.0, 8000.0
 };
@@ -27,18 +25,8 @@ void SiEffectGraphicEqualizer8::_recompute_band(int p_band) {
 	} else {
 		new_target = compute_biquad_coefficients(b.type, b.freq_hz, b.q, b.gain_db, _get_sampling_rate());
 	}
-	if (!_initialized) {
-		b.target = new_target;
-		b.current = new_target;
-		b.dirty = false;
-	} else {
-		if (new_target.approx_equal(b.current)) {
-			b.target = new_target;
-			return;
-		}
-		b.target = new_target;
-		b.dirty = true;
-	}
+	// Once running, changes are ramped across the next block.
+	_cascade.set_coefficients(p_band, new_target, _initialized);
 }
 
 void SiEffectGraphicEqualizer8::_apply_band_params(int p_band, int p_type, bool p_enabled, double p_freq_hz, double p_gain_db, double p_q) {
@@ -66,26 +54,19 @@ void SiEffectGraphicEqualizer8::_apply_band_params(int p_band, int p_type, bool
 
 void SiEffectGraphicEqualizer8::_snap_all() {
 	for (int i = 0; i < NUM_BANDS; i++) {
-		Band &b = _bands[i];
-		b.current = b.target;
-		b.dirty = false;
-		b.step = BiquadCoeffs{ 0, 0, 0, 0, 0 };
+		_cascade.set_coefficients(i, _cascade.get_coefficients(i));
 	}
 	_output_gain = _target_output_gain;
 	_output_gain_dirty = false;
 	_output_gain_step = 0.0;
 }
 
-double SiEffectGraphicEqualizer8::_process_biquad(BandChannelState *p_state, const BiquadCoeffs &p_coeffs, double p_input) const {
-	double output = p_coeffs.b0 * p_input + p_coeffs.b1 * p_state->in1 + p_coeffs.b2 * p_state->in2
-			- p_coeffs.a1 * p_state->out1 - p_coeffs.a2 * p_state->out2;
-
-	p_state->in2 = p_state->in1;
-	p_state->in1 = p_input;
-	p_state->out2 = p_state->out1;
-	p_state->out1 = output;
-
-	return output;
+void SiEffectGraphicEqualizer8::_on_sampling_rate_changed() {
+	// Coefficients for the old rate are meaningless at the new one, so don't ramp from them.
+	for (int i = 0; i < NUM_BANDS; i++) {
+		_recompute_band(i);
+	}
+	_snap_all();
 }
 
 // --- Public API ---
@@ -114,10 +95,7 @@ void SiEffectGraphicEqualizer8::set_output_gain_db(double p_gain_db) {
 // --- SiEffectBase overrides ---
 
 int SiEffectGraphicEqualizer8::prepare_process() {
-	for (int i = 0; i < NUM_BANDS; i++) {
-		_bands[i].left.clear();
-		_bands[i].right.clear();
-	}
+	_cascade.clear();
 	return 2;
 }
 
@@ -129,79 +107,27 @@ int SiEffectGraphicEqualizer8::process(int p_channels, Vector<double> *r_buffer,
 		return p_channels;
 	}
 
-	int block_samples = p_length;
-
-	// Prepare interpolation steps for dirty bands.
-	double inv_block = 1.0 / (double)block_samples;
-	for (int b = 0; b < NUM_BANDS; b++) {
-		Band &band = _bands[b];
-		if (band.dirty) {
-			band.step.b0 = (band.target.b0 - band.current.b0) * inv_block;
-			band.step.b1 = (band.target.b1 - band.current.b1) * inv_block;
-			band.step.b2 = (band.target.b2 - band.current.b2) * inv_block;
-			band.step.a1 = (band.target.a1 - band.current.a1) * inv_block;
-			band.step.a2 = (band.target.a2 - band.current.a2) * inv_block;
-		}
-	}
+	double *buffer = r_buffer->ptrw() + start_index;
+	_cascade.process(p_channels, buffer, buffer, p_length);
 
 	if (_output_gain_dirty) {
-		_output_gain_step = (_target_output_gain - _output_gain) * inv_block;
-	}
-
-	// Process samples.
-	bool stereo = (p_channels == 2);
-
-	for (int i = start_index; i < start_index + length; i += 2) {
-		double left = (*r_buffer)[i];
-		double right = stereo ? (*r_buffer)[i + 1] : left;
-
-		for (int b = 0; b < NUM_BANDS; b++) {
-			Band &band = _bands[b];
-			if (!band.enabled) {
-				continue;
-			}
-
-			left = _process_biquad(&band.left, band.current, left);
-			right = _process_biquad(&band.right, band.current, right);
-
-			if (band.dirty) {
-				band.current.b0 += band.step.b0;
-				band.current.b1 += band.step.b1;
-				band.current.b2 += band.step.b2;
-				band.current.a1 += band.step.a1;
-				band.current.a2 += band.step.a2;
-			}
-		}
-
-		double gain = _output_gain;
-		if (_output_gain_dirty) {
+		_output_gain_step = (_target_output_gain - _output_gain) / (double)p_length;
+		for (int i = 0; i < length; i += 2) {
 			_output_gain += _output_gain_step;
-			gain = _output_gain;
+			buffer[i] *= _output_gain;
+			buffer[i + 1] *= _output_gain;
 		}
 
-		r_buffer->write[i] = left * gain;
-		r_buffer->write[i + 1] = right * gain;
-	}
-
-	// Snap all interpolating bands to target and flush denormals.
-	for (int b = 0; b < NUM_BANDS; b++) {
-		Band &band = _bands[b];
-		if (band.dirty) {
-			band.current = band.target;
-			band.dirty = false;
-			band.step = BiquadCoeffs{ 0, 0, 0, 0, 0 };
-		}
-		band.left.flush_denormals();
-		band.right.flush_denormals();
-	}
-
-	if (_output_gain_dirty) {
 		_output_gain = _target_output_gain;
 		_output_gain_dirty = false;
 		_output_gain_step = 0.0;
+	} else if (_output_gain != 1.0) {
+		for (int i = 0; i < length; i++) {
+			buffer[i] *= _output_gain;
+		}
 	}
 
-	return 2;
+	return p_channels;
 }
 
 bool SiEffectGraphicEqualizer8::set_arg(int p_arg_index, double p_value) {
@@ -289,6 +215,7 @@ void SiEffectGraphicEqualizer8::reset() {
 	_output_gain_step = 0.0;
 	_output_gain_dirty = false;
 
+	_cascade.clear();
 	for (int i = 0; i < NUM_BANDS; i++) {
 		Band &b = _bands[i];
 		b.type = FILTER_PEAK;
@@ -296,9 +223,7 @@ void SiEffectGraphicEqualizer8::reset() {
 		b.freq_hz = DEFAULT_FREQS[i];
 		b.gain_db = 0.0;
 		b.q = 1.0;
-		b.current = BiquadCoeffs{ 1.0, 0.0, 0.0, 0.0, 0.0 };
-		b.target = b.current;
-		b.clear_state();
+		_cascade.set_coefficients(i, BiquadCoeffs());
 	}
 }
 
@@ -9,6 +9,7 @@
 
 #include "effector/si_effect_base.h"
 #include "effector/components/biquad_coefficients.h"
+#include "effector/components/si_effect_biquad_cascade.h"
 
 class SiEffectGraphicEqualizer8 : public SiEffectBase {
 	GDCLASS(SiEffectGraphicEqualizer8, SiEffectBase)
@@ -30,47 +31,19 @@ public:
 	};
 
 private:
-	static const double DENORMAL_THRESHOLD;
 	static const double DEFAULT_FREQS[NUM_BANDS];
 
-	struct BandChannelState {
-		double in1 = 0.0, in2 = 0.0;
-		double out1 = 0.0, out2 = 0.0;
-
-		_FORCE_INLINE_ void clear() {
-			in1 = in2 = out1 = out2 = 0.0;
-		}
-		_FORCE_INLINE_ void flush_denormals() {
-			if (::fabs(out1) < DENORMAL_THRESHOLD) {
-				clear();
-			}
-		}
-	};
-
 	struct Band {
 		int type = FILTER_PEAK;
 		bool enabled = true;
 		double freq_hz = 1000.0;
 		double gain_db = 0.0;
 		double q = 1.0;
-
-		BiquadCoeffs current;
-		BiquadCoeffs target;
-		BiquadCoeffs step;
-		bool dirty = false;
-
-		BandChannelState left;
-		BandChannelState right;
-
-		void clear_state() {
-			left.clear();
-			right.clear();
-			dirty = false;
-			step = BiquadCoeffs{ 0, 0, 0, 0, 0 };
-		}
 	};
 
 	Band _bands[NUM_BANDS];
+	// One stage per band, in band order.
+	SiEffectBiquadCascade _cascade = SiEffectBiquadCascade(NUM_BANDS);
 	double _output_gain = 1.0;
 	double _target_output_gain = 1.0;
 	double _output_gain_step = 0.0;
@@ -80,17 +53,19 @@ private:
 	void _recompute_band(int p_band);
 	void _apply_band_params(int p_band, int p_type, bool p_enabled, double p_freq_hz, double p_gain_db, double p_q);
 	void _snap_all();
-	_FORCE_INLINE_ double _process_biquad(BandChannelState *p_state, const BiquadCoeffs &p_coeffs, double p_input) const;
 
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override;
+
 public:
 	void set_band_params(int p_band, int p_type, bool p_enabled, double p_freq_hz, double p_gain_db, double p_q);
 	void set_output_gain_db(double p_gain_db);
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual bool can_process_mono() const override { return true; }
 
 	virtual void set_by_mml(Vector<double> p_args) override;
 	virtual bool set_arg(int p_arg_index, double p_value) override;
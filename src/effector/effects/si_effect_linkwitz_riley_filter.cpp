@@ -16,11 +16,9 @@
 
 #include "si_effect_linkwitz_riley_filter.h"
 
-const double SiEffectLinkwitzRileyFilter::SQRT2 = 1.41421356237309504880;
-
 void SiEffectLinkwitzRileyFilter::set_params(double p_cutoff_frequency, int p_output_mode) {
 	_cutoff = CLAMP(p_cutoff_frequency, 20.0, 20000.0);
-	_output_mode = (p_output_mode == 0 || p_output_mode == 1) ? p_output_mode : 0;
+	set_output_mode(p_output_mode);
 	_compute_coefficients(_cutoff);
 }
 
@@ -30,25 +28,23 @@ void SiEffectLinkwitzRileyFilter::set_cutoff_frequency(double p_value) {
 }
 
 void SiEffectLinkwitzRileyFilter::set_output_mode(int p_value) {
-	_output_mode = (p_value == 0 || p_value == 1) ? p_value : 0;
+	int output_mode = (p_value == 0 || p_value == 1) ? p_value : 0;
+	if (output_mode != _output_mode) {
+		// Only the selected band runs in process(), so the other one has stale history.
+		(output_mode == 0 ? _low_cascade : _high_cascade).clear();
+	}
+	_output_mode = output_mode;
 }
 
 void SiEffectLinkwitzRileyFilter::_compute_coefficients(double p_frequency) {
-	double warp = 1.0 / Math::tan(_get_angular_frequency(p_frequency) * 0.5);
-	double warp2 = warp * warp;
-	double mult = 1.0 / (1.0 + SQRT2 * warp + warp2);
+	BiquadCoeffs low;
+	BiquadCoeffs high;
+	compute_linkwitz_riley_coefficients(p_frequency, _get_sampling_rate(), low, high);
 
-	_low_in_0 = mult;
-	_low_in_1 = 2.0 * mult;
-	_low_in_2 = mult;
-	_low_out_1 = -2.0 * (1.0 - warp2) * mult;
-	_low_out_2 = -(1.0 - SQRT2 * warp + warp2) * mult;
-
-	_high_in_0 = warp2 * mult;
-	_high_in_1 = -2.0 * _high_in_0;
-	_high_in_2 = _high_in_0;
-	_high_out_1 = _low_out_1;
-	_high_out_2 = _low_out_2;
+	for (int i = 0; i < 2; i++) {
+		_low_cascade.set_coefficients(i, low);
+		_high_cascade.set_coefficients(i, high);
+	}
 }
 
 int SiEffectLinkwitzRileyFilter::prepare_process() {
@@ -56,329 +52,25 @@ int SiEffectLinkwitzRileyFilter::prepare_process() {
 }
 
 int SiEffectLinkwitzRileyFilter::process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
-	int start_index = p_start_index << 1;
-	int length = p_length << 1;
-	double *buffer = r_buffer->ptrw() + start_index;
-	const bool output_low = _output_mode == 0;
-
-	if (p_channels == 1) {
-		// Mono processing - same signal in both channels
-		for (int i = 0; i < length; i += 2) {
-			double audio = buffer[i];
-
-			// Process low band - first stage
-			double low_in01 = audio * _low_in_0 + _past_in_1a_low_left * _low_in_1;
-			double low_in = low_in01 + _past_in_2a_low_left * _low_in_2;
-			double low_in_out1 = low_in + _past_out_1a_low_left * _low_out_1;
-			double low = low_in_out1 + _past_out_2a_low_left * _low_out_2;
-
-			_past_in_2a_low_left = _past_in_1a_low_left;
-			_past_in_1a_low_left = audio;
-			_past_out_2a_low_left = _past_out_1a_low_left;
-			_past_out_1a_low_left = low;
-
-			// Process low band - second stage
-			double low_in01_b = low * _low_in_0 + _past_in_1b_low_left * _low_in_1;
-			double low_in_b = low_in01_b + _past_in_2b_low_left * _low_in_2;
-			double low_in_out1_b = low_in_b + _past_out_1b_low_left * _low_out_1;
-			double low_final = low_in_out1_b + _past_out_2b_low_left * _low_out_2;
+	double *buffer = r_buffer->ptrw() + (p_start_index << 1);
 
-			_past_in_2b_low_left = _past_in_1b_low_left;
-			_past_in_1b_low_left = low;
-			_past_out_2b_low_left = _past_out_1b_low_left;
-			_past_out_1b_low_left = low_final;
-
-			// Process high band - first stage
-			double high_in01 = audio * _high_in_0 + _past_in_1a_high_left * _high_in_1;
-			double high_in = high_in01 + _past_in_2a_high_left * _high_in_2;
-			double high_in_out1 = high_in + _past_out_1a_high_left * _high_out_1;
-			double high = high_in_out1 + _past_out_2a_high_left * _high_out_2;
-
-			_past_in_2a_high_left = _past_in_1a_high_left;
-			_past_in_1a_high_left = audio;
-			_past_out_2a_high_left = _past_out_1a_high_left;
-			_past_out_1a_high_left = high;
-
-			// Process high band - second stage
-			double high_in01_b = high * _high_in_0 + _past_in_1b_high_left * _high_in_1;
-			double high_in_b = high_in01_b + _past_in_2b_high_left * _high_in_2;
-			double high_in_out1_b = high_in_b + _past_out_1b_high_left * _high_out_1;
-			double high_final = high_in_out1_b + _past_out_2b_high_left * _high_out_2;
-
-			_past_in_2b_high_left = _past_in_1b_high_left;
-			_past_in_1b_high_left = high;
-			_past_out_2b_high_left = _past_out_1b_high_left;
-			_past_out_1b_high_left = high_final;
-
-			// Output based on mode
-			double output_value = output_low ? low_final : high_final;
-			buffer[i] = output_value;
-			buffer[i + 1] = output_value;
-		}
+	if (_output_mode == 0) {
+		_low_cascade.process(p_channels, buffer, buffer, p_length);
 	} else {
-		// Stereo processing - separate left and right channels
-		for (int i = 0; i < length; i += 2) {
-			double audio_left = buffer[i];
-			double audio_right = buffer[i + 1];
-
-			// Process low band for left channel - first stage
-			double low_in01_left = audio_left * _low_in_0 + _past_in_1a_low_left * _low_in_1;
-			double low_in_left = low_in01_left + _past_in_2a_low_left * _low_in_2;
-			double low_in_out1_left = low_in_left + _past_out_1a_low_left * _low_out_1;
-			double low_left = low_in_out1_left + _past_out_2a_low_left * _low_out_2;
-
-			_past_in_2a_low_left = _past_in_1a_low_left;
-			_past_in_1a_low_left = audio_left;
-			_past_out_2a_low_left = _past_out_1a_low_left;
-			_past_out_1a_low_left = low_left;
-
-			// Process low band for left channel - second stage
-			double low_in01_b_left = low_left * _low_in_0 + _past_in_1b_low_left * _low_in_1;
-			double low_in_b_left = low_in01_b_left + _past_in_2b_low_left * _low_in_2;
-			double low_in_out1_b_left = low_in_b_left + _past_out_1b_low_left * _low_out_1;
-			double low_final_left = low_in_out1_b_left + _past_out_2b_low_left * _low_out_2;
-
-			_past_in_2b_low_left = _past_in_1b_low_left;
-			_past_in_1b_low_left = low_left;
-			_past_out_2b_low_left = _past_out_1b_low_left;
-			_past_out_1b_low_left = low_final_left;
-
-			// Process low band for right channel - first stage
-			double low_in01_right = audio_right * _low_in_0 + _past_in_1a_low_right * _low_in_1;
-			double low_in_right = low_in01_right + _past_in_2a_low_right * _low_in_2;
-			double low_in_out1_right = low_in_right + _past_out_1a_low_right * _low_out_1;
-			double low_right = low_in_out1_right + _past_out_2a_low_right * _low_out_2;
-
-			_past_in_2a_low_right = _past_in_1a_low_right;
-			_past_in_1a_low_right = audio_right;
-			_past_out_2a_low_right = _past_out_1a_low_right;
-			_past_out_1a_low_right = low_right;
-
-			// Process low band for right channel - second stage
-			double low_in01_b_right = low_right * _low_in_0 + _past_in_1b_low_right * _low_in_1;
-			double low_in_b_right = low_in01_b_right + _past_in_2b_low_right * _low_in_2;
-			double low_in_out1_b_right = low_in_b_right + _past_out_1b_low_right * _low_out_1;
-			double low_final_right = low_in_out1_b_right + _past_out_2b_low_right * _low_out_2;
-
-			_past_in_2b_low_right = _past_in_1b_low_right;
-			_past_in_1b_low_right = low_right;
-			_past_out_2b_low_right = _past_out_1b_low_right;
-			_past_out_1b_low_right = low_final_right;
-
-			// Process high band for left channel - first stage
-			double high_in01_left = audio_left * _high_in_0 + _past_in_1a_high_left * _high_in_1;
-			double high_in_left = high_in01_left + _past_in_2a_high_left * _high_in_2;
-			double high_in_out1_left = high_in_left + _past_out_1a_high_left * _high_out_1;
-			double high_left = high_in_out1_left + _past_out_2a_high_left * _high_out_2;
-
-			_past_in_2a_high_left = _past_in_1a_high_left;
-			_past_in_1a_high_left = audio_left;
-			_past_out_2a_high_left = _past_out_1a_high_left;
-			_past_out_1a_high_left = high_left;
-
-			// Process high band for left channel - second stage
-			double high_in01_b_left = high_left * _high_in_0 + _past_in_1b_high_left * _high_in_1;
-			double high_in_b_left = high_in01_b_left + _past_in_2b_high_left * _high_in_2;
-			double high_in_out1_b_left = high_in_b_left + _past_out_1b_high_left * _high_out_1;
-			double high_final_left = high_in_out1_b_left + _past_out_2b_high_left * _high_out_2;
-
-			_past_in_2b_high_left = _past_in_1b_high_left;
-			_past_in_1b_high_left = high_left;
-			_past_out_2b_high_left = _past_out_1b_high_left;
-			_past_out_1b_high_left = high_final_left;
-
-			// Process high band for right channel - first stage
-			double high_in01_right = audio_right * _high_in_0 + _past_in_1a_high_right * _high_in_1;
-			double high_in_right = high_in01_right + _past_in_2a_high_right * _high_in_2;
-			double high_in_out1_right = high_in_right + _past_out_1a_high_right * _high_out_1;
-			double high_right = high_in_out1_right + _past_out_2a_high_right * _high_out_2;
-
-			_past_in_2a_high_right = _past_in_1a_high_right;
-			_past_in_1a_high_right = audio_right;
-			_past_out_2a_high_right = _past_out_1a_high_right;
-			_past_out_1a_high_right = high_right;
-
-			// Process high band for right channel - second stage
-			double high_in01_b_right = high_right * _high_in_0 + _past_in_1b_high_right * _high_in_1;
-			double high_in_b_right = high_in01_b_right + _past_in_2b_high_right * _high_in_2;
-			double high_in_out1_b_right = high_in_b_right + _past_out_1b_high_right * _high_out_1;
-			double high_final_right = high_in_out1_b_right + _past_out_2b_high_right * _high_out_2;
-
-			_past_in_2b_high_right = _past_in_1b_high_right;
-			_past_in_1b_high_right = high_right;
-			_past_out_2b_high_right = _past_out_1b_high_right;
-			_past_out_1b_high_right = high_final_right;
-
-			// Output based on mode
-			if (output_low) {
-				buffer[i] = low_final_left;
-				buffer[i + 1] = low_final_right;
-			} else {
-				buffer[i] = high_final_left;
-				buffer[i + 1] = high_final_right;
-			}
-		}
+		_high_cascade.process(p_channels, buffer, buffer, p_length);
 	}
 
 	return p_channels;
 }
 
 void SiEffectLinkwitzRileyFilter::process_split(int p_channels, const double *p_input, double *p_low_output, double *p_high_output, int p_length) {
-	int length = p_length << 1;
-
-	if (p_channels == 1) {
-		// Mono processing - same signal in both channels
-		for (int i = 0; i < length; i += 2) {
-			double audio = p_input[i];
-
-			// Process low band - first stage
-			double low_in01 = audio * _low_in_0 + _past_in_1a_low_left * _low_in_1;
-			double low_in = low_in01 + _past_in_2a_low_left * _low_in_2;
-			double low_in_out1 = low_in + _past_out_1a_low_left * _low_out_1;
-			double low = low_in_out1 + _past_out_2a_low_left * _low_out_2;
-
-			_past_in_2a_low_left = _past_in_1a_low_left;
-			_past_in_1a_low_left = audio;
-			_past_out_2a_low_left = _past_out_1a_low_left;
-			_past_out_1a_low_left = low;
-
-			// Process low band - second stage
-			double low_in01_b = low * _low_in_0 + _past_in_1b_low_left * _low_in_1;
-			double low_in_b = low_in01_b + _past_in_2b_low_left * _low_in_2;
-			double low_in_out1_b = low_in_b + _past_out_1b_low_left * _low_out_1;
-			double low_final = low_in_out1_b + _past_out_2b_low_left * _low_out_2;
-
-			_past_in_2b_low_left = _past_in_1b_low_left;
-			_past_in_1b_low_left = low;
-			_past_out_2b_low_left = _past_out_1b_low_left;
-			_past_out_1b_low_left = low_final;
-
-			// Process high band - first stage
-			double high_in01 = audio * _high_in_0 + _past_in_1a_high_left * _high_in_1;
-			double high_in = high_in01 + _past_in_2a_high_left * _high_in_2;
-			double high_in_out1 = high_in + _past_out_1a_high_left * _high_out_1;
-			double high = high_in_out1 + _past_out_2a_high_left * _high_out_2;
-
-			_past_in_2a_high_left = _past_in_1a_high_left;
-			_past_in_1a_high_left = audio;
-			_past_out_2a_high_left = _past_out_1a_high_left;
-			_past_out_1a_high_left = high;
-
-			// Process high band - second stage
-			double high_in01_b = high * _high_in_0 + _past_in_1b_high_left * _high_in_1;
-			double high_in_b = high_in01_b + _past_in_2b_high_left * _high_in_2;
-			double high_in_out1_b = high_in_b + _past_out_1b_high_left * _high_out_1;
-			double high_final = high_in_out1_b + _past_out_2b_high_left * _high_out_2;
-
-			_past_in_2b_high_left = _past_in_1b_high_left;
-			_past_in_1b_high_left = high;
-			_past_out_2b_high_left = _past_out_1b_high_left;
-			_past_out_1b_high_left = high_final;
-
-			p_low_output[i] = low_final;
-			p_low_output[i + 1] = low_final;
-			p_high_output[i] = high_final;
-			p_high_output[i + 1] = high_final;
-		}
+	// Either output may share the input buffer, so that band is filtered last.
+	if (p_low_output == p_input) {
+		_high_cascade.process(p_channels, p_input, p_high_output, p_length);
+		_low_cascade.process(p_channels, p_input, p_low_output, p_length);
 	} else {
-		// Stereo processing - separate left and right channels
-		for (int i = 0; i < length; i += 2) {
-			double audio_left = p_input[i];
-			double audio_right = p_input[i + 1];
-
-			// Process low band for left channel - first stage
-			double low_in01_left = audio_left * _low_in_0 + _past_in_1a_low_left * _low_in_1;
-			double low_in_left = low_in01_left + _past_in_2a_low_left * _low_in_2;
-			double low_in_out1_left = low_in_left + _past_out_1a_low_left * _low_out_1;
-			double low_left = low_in_out1_left + _past_out_2a_low_left * _low_out_2;
-
-			_past_in_2a_low_left = _past_in_1a_low_left;
-			_past_in_1a_low_left = audio_left;
-			_past_out_2a_low_left = _past_out_1a_low_left;
-			_past_out_1a_low_left = low_left;
-
-			// Process low band for left channel - second stage
-			double low_in01_b_left = low_left * _low_in_0 + _past_in_1b_low_left * _low_in_1;
-			double low_in_b_left = low_in01_b_left + _past_in_2b_low_left * _low_in_2;
-			double low_in_out1_b_left = low_in_b_left + _past_out_1b_low_left * _low_out_1;
-			double low_final_left = low_in_out1_b_left + _past_out_2b_low_left * _low_out_2;
-
-			_past_in_2b_low_left = _past_in_1b_low_left;
-			_past_in_1b_low_left = low_left;
-			_past_out_2b_low_left = _past_out_1b_low_left;
-			_past_out_1b_low_left = low_final_left;
-
-			// Process low band for right channel - first stage
-			double low_in01_right = audio_right * _low_in_0 + _past_in_1a_low_right * _low_in_1;
-			double low_in_right = low_in01_right + _past_in_2a_low_right * _low_in_2;
-			double low_in_out1_right = low_in_right + _past_out_1a_low_right * _low_out_1;
-			double low_right = low_in_out1_right + _past_out_2a_low_right * _low_out_2;
-
-			_past_in_2a_low_right = _past_in_1a_low_right;
-			_past_in_1a_low_right = audio_right;
-			_past_out_2a_low_right = _past_out_1a_low_right;
-			_past_out_1a_low_right = low_right;
-
-			// Process low band for right channel - second stage
-			double low_in01_b_right = low_right * _low_in_0 + _past_in_1b_low_right * _low_in_1;
-			double low_in_b_right = low_in01_b_right + _past_in_2b_low_right * _low_in_2;
-			double low_in_out1_b_right = low_in_b_right + _past_out_1b_low_right * _low_out_1;
-			double low_final_right = low_in_out1_b_right + _past_out_2b_low_right * _low_out_2;
-
-			_past_in_2b_low_right = _past_in_1b_low_right;
-			_past_in_1b_low_right = low_right;
-			_past_out_2b_low_right = _past_out_1b_low_right;
-			_past_out_1b_low_right = low_final_right;
-
-			// Process high band for left channel - first stage
-			double high_in01_left = audio_left * _high_in_0 + _past_in_1a_high_left * _high_in_1;
-			double high_in_left = high_in01_left + _past_in_2a_high_left * _high_in_2;
-			double high_in_out1_left = high_in_left + _past_out_1a_high_left * _high_out_1;
-			double high_left = high_in_out1_left + _past_out_2a_high_left * _high_out_2;
-
-			_past_in_2a_high_left = _past_in_1a_high_left;
-			_past_in_1a_high_left = audio_left;
-			_past_out_2a_high_left = _past_out_1a_high_left;
-			_past_out_1a_high_left = high_left;
-
-			// Process high band for left channel - second stage
-			double high_in01_b_left = high_left * _high_in_0 + _past_in_1b_high_left * _high_in_1;
-			double high_in_b_left = high_in01_b_left + _past_in_2b_high_left * _high_in_2;
-			double high_in_out1_b_left = high_in_b_left + _past_out_1b_high_left * _high_out_1;
-			double high_final_left = high_in_out1_b_left + _past_out_2b_high_left * _high_out_2;
-
-			_past_in_2b_high_left = _past_in_1b_high_left;
-			_past_in_1b_high_left = high_left;
-			_past_out_2b_high_left = _past_out_1b_high_left;
-			_past_out_1b_high_left = high_final_left;
-
-			// Process high band for right channel - first stage
-			double high_in01_right = audio_right * _high_in_0 + _past_in_1a_high_right * _high_in_1;
-			double high_in_right = high_in01_right + _past_in_2a_high_right * _high_in_2;
-			double high_in_out1_right = high_in_right + _past_out_1a_high_right * _high_out_1;
-			double high_right = high_in_out1_right + _past_out_2a_high_right * _high_out_2;
-
-			_past_in_2a_high_right = _past_in_1a_high_right;
-			_past_in_1a_high_right = audio_right;
-			_past_out_2a_high_right = _past_out_1a_high_right;
-			_past_out_1a_high_right = high_right;
-
-			// Process high band for right channel - second stage
-			double high_in01_b_right = high_right * _high_in_0 + _past_in_1b_high_right * _high_in_1;
-			double high_in_b_right = high_in01_b_right + _past_in_2b_high_right * _high_in_2;
-			double high_in_out1_b_right = high_in_b_right + _past_out_1b_high_right * _high_out_1;
-			double high_final_right = high_in_out1_b_right + _past_out_2b_high_right * _high_out_2;
-
-			_past_in_2b_high_right = _past_in_1b_high_right;
-			_past_in_1b_high_right = high_right;
-			_past_out_2b_high_right = _past_out_1b_high_right;
-			_past_out_1b_high_right = high_final_right;
-
-			p_low_output[i] = low_final_left;
-			p_low_output[i + 1] = low_final_right;
-			p_high_output[i] = high_final_left;
-			p_high_output[i + 1] = high_final_right;
-		}
+		_low_cascade.process(p_channels, p_input, p_low_output, p_length);
+		_high_cascade.process(p_channels, p_input, p_high_output, p_length);
 	}
 }
 
@@ -393,42 +85,8 @@ void SiEffectLinkwitzRileyFilter::set_by_mml(Vector<double> p_args) {
 }
 
 void SiEffectLinkwitzRileyFilter::reset() {
-	// Reset all past values
-	_past_in_1a_low_left = 0.0;
-	_past_in_2a_low_left = 0.0;
-	_past_out_1a_low_left = 0.0;
-	_past_out_2a_low_left = 0.0;
-	_past_in_1b_low_left = 0.0;
-	_past_in_2b_low_left = 0.0;
-	_past_out_1b_low_left = 0.0;
-	_past_out_2b_low_left = 0.0;
-
-	_past_in_1a_high_left = 0.0;
-	_past_in_2a_high_left = 0.0;
-	_past_out_1a_high_left = 0.0;
-	_past_out_2a_high_left = 0.0;
-	_past_in_1b_high_left = 0.0;
-	_past_in_2b_high_left = 0.0;
-	_past_out_1b_high_left = 0.0;
-	_past_out_2b_high_left = 0.0;
-
-	_past_in_1a_low_right = 0.0;
-	_past_in_2a_low_right = 0.0;
-	_past_out_1a_low_right = 0.0;
-	_past_out_2a_low_right = 0.0;
-	_past_in_1b_low_right = 0.0;
-	_past_in_2b_low_right = 0.0;
-	_past_out_1b_low_right = 0.0;
-	_past_out_2b_low_right = 0.0;
-
-	_past_in_1a_high_right = 0.0;
-	_past_in_2a_high_right = 0.0;
-	_past_out_1a_high_right = 0.0;
-	_past_out_2a_high_right = 0.0;
-	_past_in_1b_high_right = 0.0;
-	_past_in_2b_high_right = 0.0;
-	_past_out_1b_high_right = 0.0;
-	_past_out_2b_high_right = 0.0;
+	_low_cascade.clear();
+	_high_cascade.clear();
 
 	set_params(_cutoff, _output_mode);
 }
@@ -18,6 +18,7 @@
 #define SI_EFFECT_LINKWITZ_RILEY_FILTER_H
 
 #include "effector/si_effect_base.h"
+#include "effector/components/si_effect_biquad_cascade.h"
 #include <godot_cpp/templates/vector.hpp>
 
 using namespace godot;
@@ -25,59 +26,11 @@ using namespace godot;
 class SiEffectLinkwitzRileyFilter : public SiEffectBase {
 	GDCLASS(SiEffectLinkwitzRileyFilter, SiEffectBase)
 
-	static const double SQRT2;
-
 	double _cutoff = 1000.0;
 
-	// Coefficients.
-	double _low_in_0 = 0.0;
-	double _low_in_1 = 0.0;
-	double _low_in_2 = 0.0;
-	double _low_out_1 = 0.0;
-	double _low_out_2 = 0.0;
-	double _high_in_0 = 0.0;
-	double _high_in_1 = 0.0;
-	double _high_in_2 = 0.0;
-	double _high_out_1 = 0.0;
-	double _high_out_2 = 0.0;
-
-	// Past input and output values for left channel (low and high bands).
-	double _past_in_1a_low_left = 0.0;
-	double _past_in_2a_low_left = 0.0;
-	double _past_out_1a_low_left = 0.0;
-	double _past_out_2a_low_left = 0.0;
-	double _past_in_1b_low_left = 0.0;
-	double _past_in_2b_low_left = 0.0;
-	double _past_out_1b_low_left = 0.0;
-	double _past_out_2b_low_left = 0.0;
-
-	double _past_in_1a_high_left = 0.0;
-	double _past_in_2a_high_left = 0.0;
-	double _past_out_1a_high_left = 0.0;
-	double _past_out_2a_high_left = 0.0;
-	double _past_in_1b_high_left = 0.0;
-	double _past_in_2b_high_left = 0.0;
-	double _past_out_1b_high_left = 0.0;
-	double _past_out_2b_high_left = 0.0;
-
-	// Past input and output values for right channel (low and high bands).
-	double _past_in_1a_low_right = 0.0;
-	double _past_in_2a_low_right = 0.0;
-	double _past_out_1a_low_right = 0.0;
-	double _past_out_2a_low_right = 0.0;
-	double _past_in_1b_low_right = 0.0;
-	double _past_in_2b_low_right = 0.0;
-	double _past_out_1b_low_right = 0.0;
-	double _past_out_2b_low_right = 0.0;
-
-	double _past_in_1a_high_right = 0.0;
-	double _past_in_2a_high_right = 0.0;
-	double _past_out_1a_high_right = 0.0;
-	double _past_out_2a_high_right = 0.0;
-	double _past_in_1b_high_right = 0.0;
-	double _past_in_2b_high_right = 0.0;
-	double _past_out_1b_high_right = 0.0;
-	double _past_out_2b_high_right = 0.0;
+	// Each band is two identical Butterworth stages in series.
+	SiEffectBiquadCascade _low_cascade = SiEffectBiquadCascade(2);
+	SiEffectBiquadCascade _high_cascade = SiEffectBiquadCascade(2);
 
 	// Output mode: 0 = low band, 1 = high band
 	int _output_mode = 0;
@@ -87,6 +40,8 @@ class SiEffectLinkwitzRileyFilter : public SiEffectBase {
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override { _compute_coefficients(_cutoff); }
+
 public:
 	void set_params(double p_cutoff_frequency, int p_output_mode = 0);
 
@@ -100,6 +55,7 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual bool can_process_mono() const override { return true; }
 	void process_split(int p_channels, const double *p_input, double *p_low_output, double *p_high_output, int p_length);
 
 	virtual void set_by_mml(Vector<double> p_args) override;
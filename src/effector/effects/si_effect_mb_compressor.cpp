@@ -72,14 +72,13 @@
 															double p_upper_threshold_db, double p_lower_threshold_db,
 															double p_upper_ratio, double p_lower_ratio,
 															double p_output_gain_db, double p_attack, double p_release,
-															double p_mix, int p_sample_rate) {
-	 SiOPMRefTable *ref_table = SiOPMRefTable::get_instance();
-	 if (!ref_table || ref_table->sampling_rate <= 0) {
+															double p_mix, int p_sample_rate, double *r_gains) {
+	 if (p_sample_rate <= 0) {
 		 return;
 	 }
  
 	 // 1. Calculate Envelope Coefficients
-	 double samples_per_ms = ref_table->sampling_rate / 1000.0;
+	 double samples_per_ms = p_sample_rate / 1000.0;
 	 double attack_mult_first = _base_attack_ms_first * samples_per_ms;
 	 double release_mult_first = _base_release_ms_first * samples_per_ms;
 	 double attack_mult_second = _base_attack_ms_second * samples_per_ms;
@@ -174,6 +173,9 @@
 		 // Mix dry and wet
 		 p_audio_left[i] = lerp(dry_left, wet_left, _mix);
 		 p_audio_right[i] = lerp(dry_right, wet_right, _mix);
+		 if (r_gains) {
+			 r_gains[i] = lerp(1.0, gain_compression * _output_mult, _mix);
+		 }
 	 }
  
 	 // Save State
@@ -269,77 +271,45 @@
  void SiEffectMultibandCompressor::_ensure_buffer_size(int p_frames) {
 	 int required_size = p_frames * 2; // Stereo
 	 if (_temp_buffer.size() < required_size) _temp_buffer.resize(required_size);
-	 if (_low_buffer.size() < required_size) _low_buffer.resize(required_size);
-	 if (_band_buffer.size() < required_size) _band_buffer.resize(required_size);
-	 if (_high_buffer.size() < required_size) _high_buffer.resize(required_size);
 	 
 	 if (_left_vec.size() < p_frames) _left_vec.resize(p_frames);
 	 if (_right_vec.size() < p_frames) _right_vec.resize(p_frames);
+	 if (_gain_vec.size() < p_frames) _gain_vec.resize(p_frames);
  }
  
- void SiEffectMultibandCompressor::_process_multiband(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
-	 SiOPMRefTable *ref_table = SiOPMRefTable::get_instance();
-	 if (!ref_table || ref_table->sampling_rate <= 0) return;
+ void SiEffectMultibandCompressor::_compress_bands(SiEffectBandSplit *r_bands, int p_length) {
+	 const int sample_rate = (int)_get_sampling_rate();
+	 if (sample_rate <= 0) return;
  
 	 _ensure_buffer_size(p_length);
  
-	 int start_idx = p_start_index << 1;
-	 int length = p_length << 1;
- 
-	 const double *input_ptr = r_buffer->ptr() + start_idx;
- 
-	 // --- Crossover Network ---
-	 // Filters should already have correct parameters set via set_params()
-	 // No need to call set_params during audio processing
-	 
-	 // 1. Split Input at LM Frequency in one pass.
-	 double *low_ptr = _low_buffer.ptrw();
-	 double *band_ptr = _band_buffer.ptrw();
-	 if (_lm_filter.is_valid()) {
-		 _lm_filter->process_split(p_channels, input_ptr, low_ptr, band_ptr, p_length);
-	 } else {
-		 for (int i = 0; i < length; ++i) {
-			 low_ptr[i] = input_ptr[i];
-			 band_ptr[i] = 0.0;
-		 }
-	 }
-
-	 // 2. Split the high intermediate at MH Frequency in one pass.
-	 double *high_ptr = _high_buffer.ptrw();
-	 if (_mh_filter.is_valid()) {
-		 // Reuse _band_buffer in place for the mid band; the splitter reads each frame before overwriting it.
-		 _mh_filter->process_split(p_channels, band_ptr, band_ptr, high_ptr, p_length);
-	 } else {
-		 for (int i = 0; i < length; ++i) {
-			 high_ptr[i] = 0.0;
-		 }
-	 }
- 
-	 // --- Band Processing ---
-	 
-	 // Combine Low + Mid for the "Low Band Compressor" (Intentional 2-band structure)
-	 for (int i = 0; i < length; ++i) {
-		 low_ptr[i] += band_ptr[i];
-	 }
+	 double *low_ptr = r_bands->get_band(SiEffectBandSplit::BAND_LOW);
+	 double *mid_ptr = r_bands->get_band(SiEffectBandSplit::BAND_MID);
+	 double *high_ptr = r_bands->get_band(SiEffectBandSplit::BAND_HIGH);
  
 	 // Prepare vectors for compressor (Interleaved -> Planar)
 	 double *l_vec = _left_vec.ptrw();
 	 double *r_vec = _right_vec.ptrw();
+	 double *gains = _gain_vec.ptrw();
  
-	 // Process Low Band (Low + Mid)
+	 // Process Low Band (Low + Mid, intentional 2-band structure)
+	 // The gain is applied to both bands rather than their sum, so they stay apart for whatever
+	 // reads the split after this.
 	 for (int i = 0; i < p_length; ++i) {
-		 l_vec[i] = low_ptr[i * 2];
-		 r_vec[i] = low_ptr[i * 2 + 1];
+		 l_vec[i] = low_ptr[i * 2] + mid_ptr[i * 2];
+		 r_vec[i] = low_ptr[i * 2 + 1] + mid_ptr[i * 2 + 1];
 	 }
 	 
 	 _low_band_compressor.process_band(l_vec, r_vec, p_length,
 									   _band_upper_threshold, _band_lower_threshold,
 									   _band_upper_ratio, _band_lower_ratio,
-									   _band_output_gain, _attack, _release, _mix, ref_table->sampling_rate);
+									   _band_output_gain, _attack, _release, _mix, sample_rate, gains);
  
 	 for (int i = 0; i < p_length; ++i) {
-		 low_ptr[i * 2] = l_vec[i];
-		 low_ptr[i * 2 + 1] = r_vec[i];
+		 low_ptr[i * 2] *= gains[i];
+		 low_ptr[i * 2 + 1] *= gains[i];
+		 mid_ptr[i * 2] *= gains[i];
+		 mid_ptr[i * 2 + 1] *= gains[i];
 	 }
  
 	 // Process High Band
@@ -351,23 +321,31 @@
 	 _band_high_compressor.process_band(l_vec, r_vec, p_length,
 										_high_upper_threshold, _high_lower_threshold,
 										_high_upper_ratio, _high_lower_ratio,
-										_high_output_gain, _attack, _release, _mix, ref_table->sampling_rate);
+										_high_output_gain, _attack, _release, _mix, sample_rate);
  
 	 for (int i = 0; i < p_length; ++i) {
 		 high_ptr[i * 2] = l_vec[i];
 		 high_ptr[i * 2 + 1] = r_vec[i];
 	 }
+ }
+ 
+ void SiEffectMultibandCompressor::_process_multiband(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
+	 int start_idx = p_start_index << 1;
+ 
+	 // --- Crossover Network ---
+	 _bands.set_frequencies(_lm_frequency, _mh_frequency, _get_sampling_rate());
+	 _bands.split(p_channels, r_buffer->ptr() + start_idx, p_length);
+ 
+	 // --- Band Processing ---
+	 _compress_bands(&_bands, p_length);
  
 	 // Sum bands back to output buffer
-	 double *out_ptr = r_buffer->ptrw() + start_idx;
-	 for (int i = 0; i < length; ++i) {
-		 out_ptr[i] = low_ptr[i] + high_ptr[i];
-	 }
+	 _bands.recombine(r_buffer->ptrw() + start_idx);
  }
  
 void SiEffectMultibandCompressor::_process_low_band(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
-	SiOPMRefTable *ref_table = SiOPMRefTable::get_instance();
-	if (!ref_table || ref_table->sampling_rate <= 0) return;
+	const int sample_rate = (int)_get_sampling_rate();
+	if (sample_rate <= 0) return;
 
 	_ensure_buffer_size(p_length);
 	int start_idx = p_start_index << 1;
@@ -390,7 +368,7 @@ void SiEffectMultibandCompressor::_process_low_band(int p_channels, Vector<doubl
 	_low_band_compressor.process_band(l_vec, r_vec, p_length,
 									  _low_upper_threshold, _low_lower_threshold,
 									  _low_upper_ratio, _low_lower_ratio,
-									  _low_output_gain, _attack, _release, _mix, ref_table->sampling_rate);
+									  _low_output_gain, _attack, _release, _mix, sample_rate);
 
 	// Interleave back
 	for (int i = 0; i < p_length; ++i) {
@@ -400,8 +378,8 @@ void SiEffectMultibandCompressor::_process_low_band(int p_channels, Vector<doubl
 }
  
 void SiEffectMultibandCompressor::_process_high_band(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
-	SiOPMRefTable *ref_table = SiOPMRefTable::get_instance();
-	if (!ref_table || ref_table->sampling_rate <= 0) return;
+	const int sample_rate = (int)_get_sampling_rate();
+	if (sample_rate <= 0) return;
 
 	_ensure_buffer_size(p_length);
 	int start_idx = p_start_index << 1;
@@ -423,7 +401,7 @@ void SiEffectMultibandCompressor::_process_high_band(int p_channels, Vector<doub
 	_band_high_compressor.process_band(l_vec, r_vec, p_length,
 										_high_upper_threshold, _high_lower_threshold,
 										_high_upper_ratio, _high_lower_ratio,
-										_high_output_gain, _attack, _release, _mix, ref_table->sampling_rate);
+										_high_output_gain, _attack, _release, _mix, sample_rate);
 
 	for (int i = 0; i < p_length; ++i) {
 		out_ptr[i * 2] = l_vec[i];
@@ -432,8 +410,8 @@ void SiEffectMultibandCompressor::_process_high_band(int p_channels, Vector<doub
 }
  
  void SiEffectMultibandCompressor::_process_single_band(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
-	 SiOPMRefTable *ref_table = SiOPMRefTable::get_instance();
-	 if (!ref_table || ref_table->sampling_rate <= 0) return;
+	 const int sample_rate = (int)_get_sampling_rate();
+	 if (sample_rate <= 0) return;
 	 
 	 _ensure_buffer_size(p_length);
 	 int start_idx = p_start_index << 1;
@@ -450,7 +428,7 @@ void SiEffectMultibandCompressor::_process_high_band(int p_channels, Vector<doub
 	 _band_high_compressor.process_band(l_vec, r_vec, p_length,
 										 _band_upper_threshold, _band_lower_threshold,
 										 _band_upper_ratio, _band_lower_ratio,
-										 _band_output_gain, _attack, _release, _mix, ref_table->sampling_rate);
+										 _band_output_gain, _attack, _release, _mix, sample_rate);
  
 	 for (int i = 0; i < p_length; ++i) {
 		 audio_in[i * 2] = l_vec[i];
@@ -458,9 +436,7 @@ void SiEffectMultibandCompressor::_process_high_band(int p_channels, Vector<doub
 	 }
  }
  
- int SiEffectMultibandCompressor::process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
-	 std::lock_guard<std::mutex> guard(_state_mutex);
- 
+ void SiEffectMultibandCompressor::_update_enabled_bands() {
 	 bool low_enabled = _enabled_bands == BAND_MULTIBAND || _enabled_bands == BAND_LOW;
 	 bool high_enabled = _enabled_bands == BAND_MULTIBAND || _enabled_bands == BAND_HIGH;
  
@@ -470,10 +446,19 @@ void SiEffectMultibandCompressor::_process_high_band(int p_channels, Vector<doub
 		 
 		 if (_lm_filter.is_valid()) _lm_filter->reset();
 		 if (_mh_filter.is_valid()) _mh_filter->reset();
+		 _bands.clear();
  
 		 _was_low_enabled = low_enabled;
 		 _was_high_enabled = high_enabled;
 	 }
+ }
+ 
+ int SiEffectMultibandCompressor::process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
+	 std::lock_guard<std::mutex> guard(_state_mutex);
+ 
+	 _update_enabled_bands();
+	 bool low_enabled = _was_low_enabled;
+	 bool high_enabled = _was_high_enabled;
  
 	 if (low_enabled && high_enabled) {
 		 _process_multiband(p_channels, r_buffer, p_start_index, p_length);
@@ -488,6 +473,36 @@ void SiEffectMultibandCompressor::_process_high_band(int p_channels, Vector<doub
 	 return p_channels;
  }
  
+ bool SiEffectMultibandCompressor::get_band_split_frequencies(double &r_low_mid_hz, double &r_mid_high_hz) const {
+	 std::lock_guard<std::mutex> guard(_state_mutex);
+ 
+	 // The other modes filter the signal down to part of the spectrum, which a shared split can't express.
+	 if (_enabled_bands != BAND_MULTIBAND) {
+		 return false;
+	 }
+ 
+	 r_low_mid_hz = _lm_frequency;
+	 r_mid_high_hz = _mh_frequency;
+	 return true;
+ }
+ 
+ int SiEffectMultibandCompressor::process_bands(int p_channels, SiEffectBandSplit *r_bands, int p_length) {
+	 std::lock_guard<std::mutex> guard(_state_mutex);
+ 
+	 _update_enabled_bands();
+	 _compress_bands(r_bands, p_length);
+ 
+	 return 2;
+ }
+ 
+ int SiEffectMultibandCompressor::get_tail_length() const {
+	 // Same release curve as Compressor::process_band(), for the slowest band, with a few
+	 // time constants on top so the envelopes settle.
+	 double release_exponent = CLAMP(_release, 0.0, 1.0) * 8.0 - 4.0;
+	 double release_samples = Math::exp(release_exponent) * LOW_RELEASE_MS * _get_samples_per_ms();
+	 return (int)(MAX(release_samples, MIN_SAMPLE_ENVELOPE) * 5.0);
+ }
+ 
  void SiEffectMultibandCompressor::set_by_mml(Vector<double> p_args) {
 	 int enabled_bands = (int)_get_mml_arg(p_args, 0, BAND_MULTIBAND);
 	 double low_upper_threshold = _get_mml_arg(p_args, 1, -12.0);
@@ -521,14 +536,32 @@ void SiEffectMultibandCompressor::_process_high_band(int p_channels, Vector<doub
 				lm_frequency, mh_frequency);
  }
  
+ void SiEffectMultibandCompressor::_on_sampling_rate_changed() {
+	 std::lock_guard<std::mutex> guard(_state_mutex);
+
+	 // The crossovers follow the rate assigned to this effect.
+	 if (_lm_filter.is_valid()) {
+		 _lm_filter->refresh_sampling_rate(_get_sampling_rate());
+	 }
+	 if (_mh_filter.is_valid()) {
+		 _mh_filter->refresh_sampling_rate(_get_sampling_rate());
+	 }
+ }
+ 
  void SiEffectMultibandCompressor::reset() {
 	 std::lock_guard<std::mutex> guard(_state_mutex);
  
 	 _low_band_compressor.reset();
 	 _band_high_compressor.reset();
 	 
-	 if (_lm_filter.is_valid()) _lm_filter->reset();
-	 if (_mh_filter.is_valid()) _mh_filter->reset();
+	 if (_lm_filter.is_valid()) {
+		 _lm_filter->set_params(_lm_frequency, 0);
+		 _lm_filter->reset();
+	 }
+	 if (_mh_filter.is_valid()) {
+		 _mh_filter->set_params(_mh_frequency, 1);
+		 _mh_filter->reset();
+	 }
  
 	 _was_low_enabled = false;
 	 _was_high_enabled = false;
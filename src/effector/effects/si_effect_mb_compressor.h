@@ -11,6 +11,7 @@
  #define SI_EFFECT_MB_COMPRESSOR_H
  
  #include "effector/si_effect_base.h"
+ #include "effector/components/si_effect_band_split.h"
  #include "si_effect_linkwitz_riley_filter.h"
  #include <godot_cpp/templates/vector.hpp>
  #include <mutex>
@@ -30,7 +31,7 @@
 						  double p_upper_threshold_db, double p_lower_threshold_db,
 						  double p_upper_ratio, double p_lower_ratio,
 						  double p_output_gain_db, double p_attack, double p_release,
-						  double p_mix, int p_sample_rate);
+						  double p_mix, int p_sample_rate, double *r_gains = nullptr);
  
 		 double get_input_mean_squared() const { return _input_mean_squared; }
 		 double get_output_mean_squared() const { return _output_mean_squared; }
@@ -84,9 +85,11 @@
 	 bool _was_low_enabled = false;
 	 bool _was_high_enabled = false;
  
-	 // One Linkwitz-Riley splitter per crossover point.
+	 // One Linkwitz-Riley splitter per crossover point, for the single-band modes.
 	 Ref<SiEffectLinkwitzRileyFilter> _lm_filter;
 	 Ref<SiEffectLinkwitzRileyFilter> _mh_filter;
+	 // Three-band split for the multiband mode, when the stream doesn't provide a shared one.
+	 SiEffectBandSplit _bands;
  
 	 // Compressor instances
 	 Compressor _low_band_compressor;
@@ -116,17 +119,18 @@
  
 	 // Temporary buffers for processing
 	 Vector<double> _temp_buffer;
-	 Vector<double> _low_buffer;
-	 Vector<double> _band_buffer;
-	 Vector<double> _high_buffer;
 	 
 	 // Updated: Planar scratch buffers for compressor processing
 	 Vector<double> _left_vec;
 	 Vector<double> _right_vec;
+	 // Per-sample gain of the low compressor, applied to the low and mid bands separately.
+	 Vector<double> _gain_vec;
  
 	 // Updated: Helper to prevent re-allocation on audio thread
 	 void _ensure_buffer_size(int p_frames);
  
+	 void _update_enabled_bands();
+	 void _compress_bands(SiEffectBandSplit *r_bands, int p_length);
 	 void _process_multiband(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length);
 	 void _process_low_band(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length);
 	 void _process_high_band(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length);
@@ -134,6 +138,8 @@
  
  protected:
 	 static void _bind_methods();
+
+	 virtual void _on_sampling_rate_changed() override;
  
  public:
 	 void set_params(int p_enabled_bands = BAND_MULTIBAND,
@@ -147,6 +153,10 @@
  
 	 virtual int prepare_process() override;
 	 virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	 virtual int get_tail_length() const override;
+ 
+	 virtual bool get_band_split_frequencies(double &r_low_mid_hz, double &r_mid_high_hz) const override;
+	 virtual int process_bands(int p_channels, SiEffectBandSplit *r_bands, int p_length) override;
  
 	 virtual void set_by_mml(Vector<double> p_args) override;
 	 virtual void reset() override;
@@ -34,6 +34,10 @@ int SiEffectSpeakerSimulator::process(int p_channels, Vector<double> *r_buffer,
 		_previous_left = (*r_buffer)[i];
 		r_buffer->write[i] = _diaphragm_pos_left;
 
+		if (p_channels == 1) {
+			continue;
+		}
+
 		double value_right = (*r_buffer)[i + 1] - _previous_right;
 		_diaphragm_pos_right *= _spring_coef;
 		_diaphragm_pos_right += value_right;
@@ -29,6 +29,7 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual bool can_process_mono() const override { return true; }
 
 	virtual void set_by_mml(Vector<double> p_args) override;
 	virtual void reset() override;
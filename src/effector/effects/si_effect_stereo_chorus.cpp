@@ -13,6 +13,10 @@ void SiEffectStereoChorus::set_params(double p_delay_time, double p_feedback, do
 
 	double sampling_rate = _get_sampling_rate();
 
+	_delay_time = p_delay_time;
+	_frequency = p_frequency;
+	_depth_param = p_depth;
+
 	int offset = (int)(p_delay_time * _get_samples_per_ms());
 	if (offset > DELAY_BUFFER_FILTER) {
 		offset = DELAY_BUFFER_FILTER;
@@ -59,6 +63,10 @@ void SiEffectStereoChorus::set_params(double p_delay_time, double p_feedback, do
 	_calculate_constant_power_gains(_wet, _dry_gain, _wet_gain);
 }
 
+void SiEffectStereoChorus::_on_sampling_rate_changed() {
+	set_params(_delay_time, _feedback, _frequency, _depth_param, _wet, _phase_invert < 0);
+}
+
 int SiEffectStereoChorus::prepare_process() {
 	_lfo_phase = 0;
 	_lfo_residue_step = 0;
@@ -117,6 +125,10 @@ int SiEffectStereoChorus::process(int p_channels, Vector<double> *r_buffer, int
 	return p_channels;
 }
 
+int SiEffectStereoChorus::get_tail_length() const {
+	return DELAY_BUFFER_FILTER + 1;
+}
+
 void SiEffectStereoChorus::set_by_mml(Vector<double> p_args) {
 	double delay_time = _get_mml_arg(p_args, 0, 20);
 	double feedback   = _get_mml_arg(p_args, 1, 20) / 100.0;
@@ -23,6 +23,9 @@ class SiEffectStereoChorus : public SiEffectBase {
 
 	int _pointer_read = 0;
 	int _pointer_write = 0;
+	double _delay_time = 20;
+	double _frequency = 4;
+	double _depth_param = 20;
 	double _feedback = 0;
 	double _depth = 0;
 	double _wet = 0;
@@ -41,6 +44,8 @@ class SiEffectStereoChorus : public SiEffectBase {
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override;
+
 public:
 	void set_params(double p_delay_time = 20, double p_feedback = 0.2, double p_frequency = 4, double p_depth = 20, double p_wet = 0.5, bool p_invert_phase = true);
 
@@ -48,6 +53,7 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual int get_tail_length() const override;
 
 	virtual void set_by_mml(Vector<double> p_args) override;
 	virtual void reset() override;
@@ -10,6 +10,7 @@ void SiEffectStereoDelay::set_params(double p_delay_time, double p_feedback, boo
 	double sampling_rate = _get_sampling_rate();
 	double samples_per_ms = _get_samples_per_ms();
 
+	_delay_time = p_delay_time;
 	int offset = (int)(p_delay_time * samples_per_ms);
 	if (offset > DELAY_BUFFER_FILTER) {
 		offset = DELAY_BUFFER_FILTER;
@@ -44,6 +45,10 @@ void SiEffectStereoDelay::set_params(double p_delay_time, double p_feedback, boo
 	_calculate_constant_power_gains(_wet, _dry_gain, _wet_gain);
 }
 
+void SiEffectStereoDelay::_on_sampling_rate_changed() {
+	set_params(_delay_time, _feedback, _cross, _wet, _time_mode);
+}
+
 int SiEffectStereoDelay::prepare_process() {
 	_delay_buffer_left.fill(0);
 	_delay_buffer_right.fill(0);
@@ -107,6 +112,16 @@ int SiEffectStereoDelay::process(int p_channels, Vector<double> *r_buffer, int p
 	return p_channels;
 }
 
+int SiEffectStereoDelay::get_tail_length() const {
+	// Echoes are one delay apart, counting the old read position while it fades out.
+	int tail_length = (_pointer_write - _pointer_read) & DELAY_BUFFER_FILTER;
+	tail_length = MAX(tail_length, (_pointer_write - _pointer_read_target) & DELAY_BUFFER_FILTER);
+	if (_crossfade_position < 1.0) {
+		tail_length = MAX(tail_length, (_pointer_write - _pointer_read_old) & DELAY_BUFFER_FILTER);
+	}
+	return tail_length;
+}
+
 void SiEffectStereoDelay::set_by_mml(Vector<double> p_args) {
 	double delay_time = _get_mml_arg(p_args, 0, 250);
 	double feedback   = _get_mml_arg(p_args, 1, 25) / 100.0;
@@ -33,6 +33,7 @@ private:
 	int _pointer_read_target = 0;
 	int _pointer_read_old = 0;
 	double _pointer_read_fractional = 0.0;
+	double _delay_time = 250;
 	double _feedback = 0;
 	double _wet = 0;
 	double _dry_gain = 1.0;
@@ -48,6 +49,8 @@ private:
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override;
+
 public:
 	void set_params(double p_delay_time = 250, double p_feedback = 0.25, bool p_cross = false, double p_wet = 0.25, int p_time_mode = DELAY_TIME_MODE_FADE);
 
@@ -55,6 +58,7 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual int get_tail_length() const override;
 
 	virtual void set_by_mml(Vector<double> p_args) override;
 	virtual void reset() override;
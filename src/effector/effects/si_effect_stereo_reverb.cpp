@@ -10,9 +10,10 @@ void SiEffectStereoReverb::set_params(double p_delay1, double p_delay2, double p
 	double delay1 = CLAMP(p_delay1, 0.01, 0.99);
 	double delay2 = CLAMP(p_delay2, 0.01, 0.99);
 
-	_pointer_write = (_pointer_read0 + DELAY_BUFFER_FILTER) & DELAY_BUFFER_FILTER;
-	_pointer_read1 = (int)(_pointer_read0 + DELAY_BUFFER_FILTER * (1 - delay1)) & DELAY_BUFFER_FILTER;
-	_pointer_read2 = (int)(_pointer_read0 + DELAY_BUFFER_FILTER * (1 - delay2)) & DELAY_BUFFER_FILTER;
+	// The first tap reads the oldest frame, the other two are placed relative to it.
+	_tap_delay0 = DELAY_BUFFER_FILTER;
+	_tap_delay1 = (DELAY_BUFFER_FILTER - (int)(DELAY_BUFFER_FILTER * (1 - delay1))) & DELAY_BUFFER_FILTER;
+	_tap_delay2 = (DELAY_BUFFER_FILTER - (int)(DELAY_BUFFER_FILTER * (1 - delay2))) & DELAY_BUFFER_FILTER;
 
 	_feedback = CLAMP(p_feedback, -0.99, 0.99);
 
@@ -26,42 +27,41 @@ void SiEffectStereoReverb::set_params(double p_delay1, double p_delay2, double p
 }
 
 int SiEffectStereoReverb::prepare_process() {
-	_delay_buffer_left.fill(0);
-	_delay_buffer_right.fill(0);
+	_delay.reset();
 
 	return 2;
 }
 
-void SiEffectStereoReverb::_process_channel(Vector<double> *r_buffer, int p_buffer_index, Vector<double> *r_delay_buffer) {
-	double tap0 = (*r_delay_buffer)[_pointer_read0];
-	double tap1 = (*r_delay_buffer)[_pointer_read1];
-	double tap2 = (*r_delay_buffer)[_pointer_read2];
-
-	double wet_value = tap0 * _tap_weight0 + tap1 * _tap_weight1 + tap2 * _tap_weight2;
-	double feedback_value = wet_value * _feedback;
-
-	r_delay_buffer->write[_pointer_write] = (*r_buffer)[p_buffer_index] - feedback_value;
-
-	r_buffer->write[p_buffer_index] = (*r_buffer)[p_buffer_index] * _dry_gain + wet_value * _wet_gain;
-}
-
 int SiEffectStereoReverb::process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) {
 	int start_index = p_start_index << 1;
 	int length = p_length << 1;
+	double *buffer = r_buffer->ptrw();
 
 	for (int i = start_index; i < (start_index + length); i += 2) {
-		_process_channel(r_buffer, i, &_delay_buffer_left);
-		_process_channel(r_buffer, i + 1, &_delay_buffer_right);
+		const double *tap0 = _delay.read_frame(_tap_delay0);
+		const double *tap1 = _delay.read_frame(_tap_delay1);
+		const double *tap2 = _delay.read_frame(_tap_delay2);
 
-		_pointer_write = (_pointer_write + 1) & DELAY_BUFFER_FILTER;
-		_pointer_read0 = (_pointer_read0 + 1) & DELAY_BUFFER_FILTER;
-		_pointer_read1 = (_pointer_read1 + 1) & DELAY_BUFFER_FILTER;
-		_pointer_read2 = (_pointer_read2 + 1) & DELAY_BUFFER_FILTER;
+		double frame[2];
+		for (int channel = 0; channel < 2; channel++) {
+			double wet_value = tap0[channel] * _tap_weight0 + tap1[channel] * _tap_weight1 + tap2[channel] * _tap_weight2;
+			double feedback_value = wet_value * _feedback;
+
+			frame[channel] = buffer[i + channel] - feedback_value;
+			buffer[i + channel] = buffer[i + channel] * _dry_gain + wet_value * _wet_gain;
+		}
+
+		_delay.write_frame(frame);
 	}
 
 	return p_channels;
 }
 
+int SiEffectStereoReverb::get_tail_length() const {
+	// The first tap reads the oldest frame in the delay memory.
+	return _delay.get_length();
+}
+
 void SiEffectStereoReverb::set_by_mml(Vector<double> p_args) {
 	double delay1   = _get_mml_arg(p_args, 0, 70) / 100.0;
 	double delay2   = _get_mml_arg(p_args, 1, 40) / 100.0;
@@ -81,8 +81,7 @@ void SiEffectStereoReverb::_bind_methods() {
 
 SiEffectStereoReverb::SiEffectStereoReverb(double p_delay1, double p_delay2, double p_feedback, double p_wet) :
 		SiEffectBase() {
-	_delay_buffer_left.resize_zeroed(1 << DELAY_BUFFER_BITS);
-	_delay_buffer_right.resize_zeroed(1 << DELAY_BUFFER_BITS);
+	_delay.resize(1 << DELAY_BUFFER_BITS);
 
 	set_params(p_delay1, p_delay2, p_feedback, p_wet);
 }
@@ -9,6 +9,7 @@
 
 #include <godot_cpp/templates/vector.hpp>
 #include "effector/si_effect_base.h"
+#include "effector/components/si_effect_fdn_core.h"
 
 using namespace godot;
 
@@ -18,13 +19,12 @@ class SiEffectStereoReverb : public SiEffectBase {
 	static const int DELAY_BUFFER_BITS = 16;
 	static const int DELAY_BUFFER_FILTER = (1 << DELAY_BUFFER_BITS) - 1;
 
-	Vector<double> _delay_buffer_left;
-	Vector<double> _delay_buffer_right;
+	// Both channels share one interleaved delay memory, so every tap is a single frame read.
+	SiEffectFDNCore _delay = SiEffectFDNCore(2);
 
-	int _pointer_read0 = 0;
-	int _pointer_read1 = 0;
-	int _pointer_read2 = 0;
-	int _pointer_write = 0;
+	int _tap_delay0 = 0;
+	int _tap_delay1 = 0;
+	int _tap_delay2 = 0;
 	double _feedback = 0;
 	double _tap_weight0 = 0;
 	double _tap_weight1 = 0;
@@ -33,8 +33,6 @@ class SiEffectStereoReverb : public SiEffectBase {
 	double _dry_gain = 1.0;
 	double _wet_gain = 0.0;
 
-	void _process_channel(Vector<double> *r_buffer, int p_buffer_index, Vector<double> *r_delay_buffer);
-
 protected:
 	static void _bind_methods();
 
@@ -45,6 +43,7 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual int get_tail_length() const override;
 
 	virtual void set_by_mml(Vector<double> p_args) override;
 	virtual void reset() override;
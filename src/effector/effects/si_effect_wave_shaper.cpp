@@ -39,8 +39,6 @@ int SiEffectWaveShaper::process(int p_channels, Vector<double> *r_buffer, int p_
 			value = coef * value / (1 + _coefficient * ABS(value));
 
 			r_buffer->write[i] = value;
-			r_buffer->write[i + 1] = value;
-
 		}
 	}
 
@@ -10,27 +10,32 @@
 #include "sequencer/simml_ref_table.h"
 
 void SiControllableFilterBase::set_params(int p_cutoff, int p_resonance, double p_fps) {
-	_cutoff_ptr = nullptr;
+	_cutoff_cursor = SiMMLEnvelopeTable::Cursor();
 	if (p_cutoff >= 0 && p_cutoff < 255) {
 		Ref<SiMMLEnvelopeTable> table = SiMMLRefTable::get_instance()->get_envelope_table(p_cutoff);
 		if (table.is_valid()) {
-			_cutoff_ptr = table->get_head();
+			_cutoff_cursor = table->get_cursor();
 		}
 	}
 
-	_resonance_ptr = nullptr;
+	_resonance_cursor = SiMMLEnvelopeTable::Cursor();
 	if (p_resonance >= 0 && p_resonance < 255) {
 		Ref<SiMMLEnvelopeTable> table = SiMMLRefTable::get_instance()->get_envelope_table(p_resonance);
 		if (table.is_valid()) {
-			_resonance_ptr = table->get_head();
+			_resonance_cursor = table->get_cursor();
 		}
 	}
 
-	_cutoff_index = (_cutoff_ptr ? _cutoff_ptr->value : 128);
-	_resonance = (_resonance_ptr ? _resonance_ptr->value * 0.007751937984496124 : 0); // 0.007751937984496124 = 1/129
+	_cutoff_index = (_cutoff_cursor.is_active() ? _cutoff_cursor.get_value() : 128);
+	_resonance = (_resonance_cursor.is_active() ? _resonance_cursor.get_value() * 0.007751937984496124 : 0); // 0.007751937984496124 = 1/129
 
+	_fps = p_fps;
+	_update_lfo_step();
+}
+
+void SiControllableFilterBase::_update_lfo_step() {
 	double sampling_rate = _get_sampling_rate();
-	_lfo_step = (int)(sampling_rate / p_fps);
+	_lfo_step = (int)(sampling_rate / _fps);
 	int min_step = MAX(1, (int)_get_samples_per_ms());
 	if (_lfo_step <= min_step) {
 		_lfo_step = min_step;
@@ -39,7 +44,14 @@ void SiControllableFilterBase::set_params(int p_cutoff, int p_resonance, double
 	_lfo_residue_step = _lfo_step << 1;
 }
 
+void SiControllableFilterBase::_on_sampling_rate_changed() {
+	if (_fps > 0) {
+		_update_lfo_step();
+	}
+}
+
 void SiControllableFilterBase::set_params_manually(double p_cutoff, double p_resonance) {
+	_fps = 0;
 	_lfo_step = 2048;
 	_lfo_residue_step = 4096;
 
@@ -81,14 +93,14 @@ int SiControllableFilterBase::process(int p_channels, Vector<double> *r_buffer,
 	while (i < (max - step)) {
 		_process_lfo(r_buffer, i, step);
 
-		if (_cutoff_ptr) {
-			_cutoff_ptr = _cutoff_ptr->next();
-			_cutoff_index = (_cutoff_ptr ? _cutoff_ptr->value : 128);
+		if (_cutoff_cursor.is_active()) {
+			_cutoff_cursor.advance();
+			_cutoff_index = (_cutoff_cursor.is_active() ? _cutoff_cursor.get_value() : 128);
 		}
 
-		if (_resonance_ptr) {
-			_resonance_ptr = _resonance_ptr->next();
-			_resonance = (_resonance_ptr ? _resonance_ptr->value * 0.007751937984496124 : 0);
+		if (_resonance_cursor.is_active()) {
+			_resonance_cursor.advance();
+			_resonance = (_resonance_cursor.is_active() ? _resonance_cursor.get_value() * 0.007751937984496124 : 0);
 		}
 
 		i += step;
@@ -9,24 +9,29 @@
 
 #include <godot_cpp/templates/vector.hpp>
 #include "effector/si_effect_base.h"
-#include "templates/singly_linked_list.h"
+#include "sequencer/simml_envelope_table.h"
 
 class SiControllableFilterBase : public SiEffectBase {
 	GDCLASS(SiControllableFilterBase, SiEffectBase)
 
-	// These are referencing external data, and we don't want to mess the internal cursor
-	// in that data. So we keep our own pointers.
-	SinglyLinkedList<int>::Element *_cutoff_ptr = nullptr;
-	SinglyLinkedList<int>::Element *_resonance_ptr = nullptr;
+	// These are referencing external data, so we keep our own positions in it.
+	SiMMLEnvelopeTable::Cursor _cutoff_cursor;
+	SiMMLEnvelopeTable::Cursor _resonance_cursor;
 
+	// Envelope update rate, or 0 when the parameters are set manually.
+	double _fps = 0;
 	int _lfo_step = 0;
 	int _lfo_residue_step = 0;
 
+	void _update_lfo_step();
+
 	virtual void _process_lfo(Vector<double> *r_buffer, int p_start_index, int p_length) {}
 
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override;
+
 	double _p0_right = 0;
 	double _p1_right = 0;
 	double _p0_left = 0;
@@ -7,6 +7,9 @@
 #include "si_filter_all_pass.h"
 
 void SiFilterAllPass::set_params(double p_frequency, double p_band) {
+	_frequency = p_frequency;
+	_band = p_band;
+
 	// TODO: Pick better names for these variables.
 
 	double omg = _get_angular_frequency(p_frequency);
@@ -22,6 +25,8 @@ void SiFilterAllPass::set_params(double p_frequency, double p_band) {
 	_a2 = (1 - alp) * ia0;
 	_b0 = _a2;
 	_b2 = 1;
+
+	_update_coefficients();
 }
 
 void SiFilterAllPass::set_by_mml(Vector<double> p_args) {
@@ -7,6 +7,9 @@
 #include "si_filter_band_pass.h"
 
 void SiFilterBandPass::set_params(double p_frequency, double p_band) {
+	_frequency = p_frequency;
+	_band = p_band;
+
 	// TODO: Pick better names for these variables.
 
 	double omg = _get_angular_frequency(p_frequency);
@@ -22,6 +25,8 @@ void SiFilterBandPass::set_params(double p_frequency, double p_band) {
 	_b1 = 0;
 	_b0 = alp * ia0;
 	_b2 = -_b0;
+
+	_update_coefficients();
 }
 
 void SiFilterBandPass::set_by_mml(Vector<double> p_args) {
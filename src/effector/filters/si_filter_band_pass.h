@@ -12,9 +12,14 @@
 class SiFilterBandPass : public SiFilterBase {
 	GDCLASS(SiFilterBandPass, SiFilterBase)
 
+	double _frequency = 3000;
+	double _band = 1;
+
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override { set_params(_frequency, _band); }
+
 public:
 	void set_params(double p_frequency = 3000, double p_band = 1);
 
@@ -7,38 +7,15 @@
 #ifndef SI_FILTER_BASE_H
 #define SI_FILTER_BASE_H
 
+#include "effector/components/si_effect_biquad_cascade.h"
 #include "effector/si_effect_base.h"
 
 class SiFilterBase : public SiEffectBase {
 	GDCLASS(SiFilterBase, SiEffectBase)
 
-	static const double THRESHOLD;
-
-	struct ChannelValues {
-		double in1 = 0;
-		double in2 = 0;
-		double out1 = 0;
-		double out2 = 0;
-
-		void check_threshold() {
-			if (out1 < THRESHOLD) {
-				out1 = 0;
-				out2 = 0;
-			}
-		}
-
-		void clear() {
-			in1 = 0;
-			in2 = 0;
-			out1 = 0;
-			out2 = 0;
-		}
-	};
-
-	ChannelValues _left;
-	ChannelValues _right;
-
-	double _process_channel(ChannelValues *p_channel, double p_input);
+	// One stage with its output clamped before it is fed back. Hot peak and boost settings
+	// rely on that clamp for their sound.
+	SiEffectBiquadCascade _cascade = SiEffectBiquadCascade(1);
 
 protected:
 	static void _bind_methods() {}
@@ -49,11 +26,15 @@ protected:
 	double _b1 = 0;
 	double _b2 = 0;
 
+	// Extending classes call this after setting the coefficients above.
+	void _update_coefficients();
+
 public:
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual bool can_process_mono() const override { return true; }
 
-	SiFilterBase() : SiEffectBase() {}
+	SiFilterBase();
 	~SiFilterBase() {}
 };
 
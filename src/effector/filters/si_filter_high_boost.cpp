@@ -7,6 +7,10 @@
 #include "si_filter_high_boost.h"
 
 void SiFilterHighBoost::set_params(double p_frequency, double p_slope, double p_gain) {
+	_frequency = p_frequency;
+	_slope = p_slope;
+	_gain = p_gain;
+
 	// TODO: Pick better names for these variables.
 	double slope = MAX(p_slope, 1);
 
@@ -24,6 +28,8 @@ void SiFilterHighBoost::set_params(double p_frequency, double p_slope, double p_
 	_b0 =      ((A + 1) + (A - 1) * cos + alpsA2) * A * ia0;
 	_b1 = -2 * ((A - 1) + (A + 1) * cos)          * A * ia0;
 	_b2 =      ((A + 1) + (A - 1) * cos - alpsA2) * A * ia0;
+
+	_update_coefficients();
 }
 
 void SiFilterHighBoost::set_by_mml(Vector<double> p_args) {
@@ -12,9 +12,15 @@
 class SiFilterHighBoost : public SiFilterBase {
 	GDCLASS(SiFilterHighBoost, SiFilterBase)
 
+	double _frequency = 5500;
+	double _slope = 1;
+	double _gain = 6;
+
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override { set_params(_frequency, _slope, _gain); }
+
 public:
 	void set_params(double p_frequency = 5500, double p_slope = 1, double p_gain = 6);
 
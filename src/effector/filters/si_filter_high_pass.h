@@ -12,9 +12,14 @@
 class SiFilterHighPass : public SiFilterBase {
 	GDCLASS(SiFilterHighPass, SiFilterBase)
 
+	double _frequency = 5500;
+	double _band = 1;
+
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override { set_params(_frequency, _band); }
+
 public:
 	void set_params(double p_frequency = 5500, double p_band = 1);
 
@@ -7,6 +7,10 @@
 #include "si_filter_low_boost.h"
 
 void SiFilterLowBoost::set_params(double p_frequency, double p_slope, double p_gain) {
+	_frequency = p_frequency;
+	_slope = p_slope;
+	_gain = p_gain;
+
 	// TODO: Pick better names for these variables.
 
 	double slope = MAX(p_slope, 1);
@@ -25,6 +29,8 @@ void SiFilterLowBoost::set_params(double p_frequency, double p_slope, double p_g
 	_b0 =      ((A + 1) - (A - 1) * cos + alpsA2) * A * ia0;
 	_b1 =  2 * ((A - 1) - (A + 1) * cos)          * A * ia0;
 	_b2 =      ((A + 1) - (A - 1) * cos - alpsA2) * A * ia0;
+
+	_update_coefficients();
 }
 
 void SiFilterLowBoost::set_by_mml(Vector<double> p_args) {
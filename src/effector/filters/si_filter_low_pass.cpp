@@ -7,6 +7,9 @@
 #include "si_filter_low_pass.h"
 
 void SiFilterLowPass::set_params(double p_frequency, double p_band) {
+	_frequency = p_frequency;
+	_band = p_band;
+
 	// TODO: Pick better names for these variables.
 
 	double omg = _get_angular_frequency(p_frequency);
@@ -22,6 +25,8 @@ void SiFilterLowPass::set_params(double p_frequency, double p_band) {
 	_b1 = (1 - cos) * ia0;
 	_b2 = _b1 * 0.5;
 	_b0 = _b1 * 0.5;
+
+	_update_coefficients();
 }
 
 void SiFilterLowPass::set_by_mml(Vector<double> p_args) {
@@ -7,6 +7,10 @@
 #include "si_filter_peak.h"
 
 void SiFilterPeak::set_params(double p_frequency, double p_band, double p_gain) {
+	_frequency = p_frequency;
+	_band = p_band;
+	_gain = p_gain;
+
 	// TODO: Pick better names for these variables.
 
 	double A   = Math::pow(10, p_gain * 0.025);
@@ -25,6 +29,8 @@ void SiFilterPeak::set_params(double p_frequency, double p_band, double p_gain)
 	_a2 = (1 - alpiA) * ia0;
 	_b0 = (1 + alpA) * ia0;
 	_b2 = (1 - alpA) * ia0;
+
+	_update_coefficients();
 }
 
 void SiFilterPeak::set_by_mml(Vector<double> p_args) {
@@ -12,9 +12,15 @@
 class SiFilterPeak : public SiFilterBase {
 	GDCLASS(SiFilterPeak, SiFilterBase)
 
+	double _frequency = 3000;
+	double _band = 1;
+	double _gain = 6;
+
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override { set_params(_frequency, _band, _gain); }
+
 public:
 	void set_params(double p_frequency = 3000, double p_band = 1, double p_gain = 6);
 
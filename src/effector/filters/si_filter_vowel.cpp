@@ -9,48 +9,14 @@
 // Formants.
 
 bool SiFilterVowel::Formant::_initialized = false;
-int SiFilterVowel::Formant::_table_sample_rate = 0;
-double SiFilterVowel::Formant::_alpha_table[BAND_TABLE_MAX][FREQ_TABLE_MAX];
-double SiFilterVowel::Formant::_cos_table[FREQ_TABLE_MAX];
 double SiFilterVowel::Formant::_gain_table[GAIN_TABLE_MAX];
 double SiFilterVowel::Formant::_band_list[BAND_TABLE_MAX] = { 0.25, 0.5, 0.75, 1, 1.5, 2, 3, 4 };
 
-void SiFilterVowel::Formant::initialize(int p_sample_rate) {
-	int sampling_rate = MAX(p_sample_rate, 1);
-	if (_initialized && _table_sample_rate == sampling_rate) {
+void SiFilterVowel::Formant::initialize() {
+	if (_initialized) {
 		return;
 	}
 	_initialized = true;
-	_table_sample_rate = sampling_rate;
-
-	double omega_scale = (2.0 * M_PI) / sampling_rate;
-
-	// Generate alpha table.
-	for (int i = 0; i < BAND_TABLE_MAX; i++) {
-		double band = _band_list[i];
-		double frequency = 50.0;
-		for (int j = 0; j < FREQ_TABLE_MAX; j++) {
-			// TODO: Pick better names for these variables, maybe?
-
-			double omg  = frequency * omega_scale;
-			double sin  = Math::sin(omg);
-			double ang = 0.34657359027997264 * band * omg / sin; // log(2)*0.5
-
-			_alpha_table[i][j] = sin * Math::sinh(ang);
-
-			frequency *= 1.0218971486541166; // 2^(1/32)
-		}
-	}
-
-	// Generate cos table.
-	{
-		double frequency = 50.0;
-		for (int j = 0; j < FREQ_TABLE_MAX; j++) {
-			_cos_table[j] = Math::cos(frequency * omega_scale);
-
-			frequency *= 1.0218971486541166; // 2^(1/32)
-		}
-	}
 
 	// Generate gain table.
 	for (int i = 0; i < GAIN_TABLE_MAX; i++) {
@@ -63,16 +29,27 @@ int SiFilterVowel::Formant::calculate_freq_index(double p_frequency) {
 	return CLAMP(freq_index, 0, 1023);
 }
 
-void SiFilterVowel::Formant::update(int p_freq_index, int p_gain, int p_band_index) {
+void SiFilterVowel::Formant::update(int p_freq_index, int p_gain, int p_band_index, double p_sampling_rate) {
+	last_freq_index = p_freq_index;
+	last_gain = p_gain;
+	last_band_index = p_band_index;
+
+	// Filter instances run at their driver's rate, so the angle isn't shared through a table.
+	// TODO: Pick better names for these variables, maybe?
+	double frequency = 50.0 * Math::pow(2.0, p_freq_index / 32.0);
+	double omg = (2.0 * M_PI) * frequency / p_sampling_rate;
+	double sin = Math::sin(omg);
+	double ang = 0.34657359027997264 * _band_list[p_band_index] * omg / sin; // log(2)*0.5
+
 	int gain_index = CLAMP(p_gain + 32, 0, 127);
-	double alpha = _alpha_table[p_band_index][p_freq_index];
+	double alpha = sin * Math::sinh(ang);
 	double gain = _gain_table[gain_index];
 
 	double alpA  = alpha * gain;
 	double alpiA = alpha / gain;
 	double ia0   = 1.0 / (1.0 + alpiA);
 
-	ab1 = -2 * _cos_table[p_freq_index] * ia0;
+	ab1 = -2 * Math::cos(omg) * ia0;
 	a2 = (1 - alpiA) * ia0;
 	b0 = (1 + alpA) * ia0;
 	b2 = (1 - alpA) * ia0;
@@ -90,7 +67,14 @@ void SiFilterVowel::_set_formant_band(int p_index, double p_frequency,  int p_ga
 	ERR_FAIL_INDEX(p_index, _formants.size());
 
 	int freq_index = Formant::calculate_freq_index(p_frequency);
-	_formants.write[p_index].update(freq_index, p_gain, p_band_index);
+	_formants.write[p_index].update(freq_index, p_gain, p_band_index, _get_sampling_rate());
+}
+
+void SiFilterVowel::_on_sampling_rate_changed() {
+	for (int i = 0; i < _formants.size(); i++) {
+		const Formant &formant = _formants[i];
+		_formants.write[i].update(formant.last_freq_index, formant.last_gain, formant.last_band_index, _get_sampling_rate());
+	}
 }
 
 // Event chain.
@@ -145,8 +129,8 @@ SiFilterVowel::FormantEvent::FormantEvent(int p_time, double p_output_level, int
 
 int SiFilterVowel::_update_event(int p_time) {
 	while (_event_queue && _event_queue->time == 0) {
-		_formants.write[0].update(_event_queue->freq_index1, _event_queue->gain1, 3);
-		_formants.write[1].update(_event_queue->freq_index2, _event_queue->gain2, 2);
+		_formants.write[0].update(_event_queue->freq_index1, _event_queue->gain1, 3, _get_sampling_rate());
+		_formants.write[1].update(_event_queue->freq_index2, _event_queue->gain2, 2, _get_sampling_rate());
 
 		_output_level = _event_queue->output_level;
 
@@ -262,7 +246,7 @@ void SiFilterVowel::_bind_methods() {
 
 SiFilterVowel::SiFilterVowel() :
 		SiEffectBase() {
-	Formant::initialize((int)_get_sampling_rate());
+	Formant::initialize();
 
 	_formants.resize_zeroed(FORMANT_COUNT);
 	for (int i = 0; i < _formants.size(); i++) {
@@ -26,21 +26,23 @@ class SiFilterVowel : public SiEffectBase {
 
 	struct Formant {
 		static bool _initialized;
-		static int _table_sample_rate;
-		static double _alpha_table[BAND_TABLE_MAX][FREQ_TABLE_MAX];
-		static double _cos_table[FREQ_TABLE_MAX];
 		static double _gain_table[GAIN_TABLE_MAX];
 		static double _band_list[BAND_TABLE_MAX];
 
+		// Last settings, kept to recalculate the coefficients at a new sampling rate.
+		int last_freq_index = 0;
+		int last_gain = 0;
+		int last_band_index = 0;
+
 		double ab1 = 0;
 		double a2 = 0;
 		double b0 = 1;
 		double b2 = 0;
 
-		static void initialize(int p_sample_rate);
+		static void initialize();
 		static int calculate_freq_index(double p_frequency);
 
-		void update(int p_freq_index, int p_gain, int p_band_index);
+		void update(int p_freq_index, int p_gain, int p_band_index, double p_sampling_rate);
 	};
 
 	Vector<Formant> _formants;
@@ -100,6 +102,8 @@ class SiFilterVowel : public SiEffectBase {
 protected:
 	static void _bind_methods();
 
+	virtual void _on_sampling_rate_changed() override;
+
 public:
 	// Formants.
 
@@ -115,6 +119,7 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual bool can_process_mono() const override { return true; }
 
 	virtual void set_by_mml(Vector<double> p_args) override;
 
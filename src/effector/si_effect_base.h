@@ -18,6 +18,8 @@
 
 using namespace godot;
 
+class SiEffectBandSplit;
+
 // Base class for all effects. Doesn't implement any behavior by default.
 // Extending classes must be used instead.
 class SiEffectBase : public RefCounted {
@@ -29,14 +31,17 @@ class SiEffectBase : public RefCounted {
 protected:
 	static void _bind_methods() {}
 
-	_FORCE_INLINE_ void _refresh_sampling_rate_cache() {
-		_sampling_rate = 48000.0;
-
-		SiOPMRefTable *ref_table = SiOPMRefTable::get_instance();
-		if (ref_table && ref_table->sampling_rate > 0) {
-			_sampling_rate = ref_table->sampling_rate;
+	_FORCE_INLINE_ void _refresh_sampling_rate_cache(double p_sampling_rate) {
+		// Effect instances are pooled across drivers, so the owner passes its own rate. Until
+		// then the effect assumes the default driver rate.
+		if (p_sampling_rate > 0 && p_sampling_rate != _sampling_rate) {
+			_sampling_rate = p_sampling_rate;
+			_on_sampling_rate_changed();
 		}
 	}
+	// Effects that derive values from the rate in set_params() re-run it here with the
+	// arguments they were last given.
+	virtual void _on_sampling_rate_changed() {}
 
 	// Helper for set_by_mml implementations.
 	_FORCE_INLINE_ double _get_mml_arg(Vector<double> p_args, int p_index, double p_default) const {
@@ -62,7 +67,8 @@ protected:
 public:
 	bool is_free() const { return _is_free; }
 	void set_free(bool p_free) { _is_free = p_free; }
-	void refresh_sampling_rate() { _refresh_sampling_rate_cache(); }
+	void refresh_sampling_rate(double p_sampling_rate) { _refresh_sampling_rate_cache(p_sampling_rate); }
+	double get_sampling_rate() const { return _sampling_rate; }
 
 	// Returns the requested channel count.
 	virtual int prepare_process() { return 1; }
@@ -73,6 +79,24 @@ public:
 	// Start index and length must be adjusted internally to account for the stereo nature of the buffer.
 	// Returns the output channel count.
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) { return p_channels; }
+	// Effects that can return true here are called as mono with only buffer[i*2] filled in while
+	// the stream signal is mono; the right samples are undefined and need not be written. Effects
+	// that turn the signal into stereo must write both channels and return 2. Everything else gets
+	// the right channel filled in first.
+	virtual bool can_process_mono() const { return false; }
+	// How long, in samples, the effect can stay quiet after its input falls silent and still
+	// produce output or keep settling its state (delay lines, envelope release). Effect streams
+	// put the chain to sleep once input and output have been silent for longer than that.
+	virtual int get_tail_length() const { return 0; }
+
+	// Band-aware effects can work on a three-band split owned by the effect stream, shared with
+	// the band-aware effects next to them, instead of splitting the signal on their own. Returns
+	// true with the crossover frequencies if the effect can currently work that way, in which
+	// case the stream calls process_bands() in place of process().
+	virtual bool get_band_split_frequencies(double &r_low_mid_hz, double &r_mid_high_hz) const { return false; }
+	// Process the split bands in place. The stream sums them back after the last band-aware
+	// effect in a row.
+	virtual int process_bands(int p_channels, SiEffectBandSplit *r_bands, int p_length) { return p_channels; }
 
 	virtual void set_by_mml(Vector<double> p_args) {}
 	// Sparse single-arg update. Returns true if the effect handled it, false to
@@ -80,7 +104,7 @@ public:
 	virtual bool set_arg(int p_arg_index, double p_value) { return false; }
 	virtual void reset() {}
 
-	SiEffectBase() { _refresh_sampling_rate_cache(); }
+	SiEffectBase() {}
 };
 
 #endif // SI_EFFECT_BASE_H
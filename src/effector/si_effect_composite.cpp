@@ -32,6 +32,8 @@ void SiEffectComposite::set_slot_levels(int p_slot, double p_send_level, double
 int SiEffectComposite::prepare_process() {
 	for (int i = 0; i < SLOTS_MAX; i++) {
 		for (Ref<SiEffectBase> effect : _slots[i].effects) {
+			// Nested effects run at the rate the owning stream gave this one.
+			effect->refresh_sampling_rate(_get_sampling_rate());
 			effect->prepare_process();
 		}
 	}
@@ -90,6 +92,16 @@ int SiEffectComposite::process(int p_channels, Vector<double> *r_buffer, int p_s
 	return out_channels;
 }
 
+int SiEffectComposite::get_tail_length() const {
+	int tail_length = 0;
+	for (int i = 0; i < SLOTS_MAX; i++) {
+		for (const Ref<SiEffectBase> &effect : _slots[i].effects) {
+			tail_length = MAX(tail_length, effect->get_tail_length());
+		}
+	}
+	return tail_length;
+}
+
 void SiEffectComposite::reset() {
 	for (int i = 0; i < SLOTS_MAX; i++) {
 		_slots[i].effects.clear();
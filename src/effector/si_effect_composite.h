@@ -37,6 +37,7 @@ public:
 
 	virtual int prepare_process() override;
 	virtual int process(int p_channels, Vector<double> *r_buffer, int p_start_index, int p_length) override;
+	virtual int get_tail_length() const override;
 
 	virtual void reset() override;
 
@@ -8,6 +8,7 @@
 
 #include <godot_cpp/classes/reg_ex.hpp>
 #include <godot_cpp/classes/reg_ex_match.hpp>
+#include <godot_cpp/core/math.hpp>
 #include <algorithm>
 #include "chip/siopm_sound_chip.h"
 #include "chip/siopm_stream.h"
@@ -147,24 +148,155 @@ int SiEffectStream::prepare_process() {
 		return 0;
 	}
 
+	// Effects built outside of the pool only learn the rate of the driver they play in here.
+	const double sampling_rate = _sound_chip->get_ref_table()->sampling_rate;
+	for (int i = 0; i < _chain.size(); i++) {
+		_chain[i]->refresh_sampling_rate(sampling_rate);
+	}
+
 	_stream->set_channel_count(_chain[0]->prepare_process());
 	for (int i = 1; i < _chain.size(); i++) {
 		_chain[i]->prepare_process();
 	}
+	for (int i = 0; i < _band_splits.size(); i++) {
+		_band_splits.write[i].clear();
+	}
 
 	return _stream->get_channel_count();
 }
 
-int SiEffectStream::process(int p_start_idx, int p_length, bool p_write_in_stream) {
-	Vector<double> *buffer = _stream->get_buffer_ptr();
-	int channel_count = _stream->get_channel_count();
+void SiEffectStream::clear_buffer() {
+	if (_buffer_zeroed) {
+		return;
+	}
 
+	_stream->clear();
+	_buffer_zeroed = true;
+}
+
+int SiEffectStream::get_tail_length() const {
+	int tail_length = 0;
 	for (int i = 0; i < _chain.size(); i++) {
 		if (i < _bypassed.size() && _bypassed[i]) {
 			continue;
 		}
-		channel_count = _chain[i]->process(channel_count, buffer, p_start_idx, p_length);
+		tail_length = MAX(tail_length, _chain[i]->get_tail_length());
+	}
+
+	return tail_length;
+}
+
+double SiEffectStream::_get_buffer_peak(int p_start_idx, int p_length) const {
+	const double *src = _stream->get_buffer_ptr()->ptr();
+	const int end = (p_start_idx + p_length) << 1;
+
+	double peak = 0.0;
+	for (int i = p_start_idx << 1; i < end; i++) {
+		peak = MAX(peak, Math::abs(src[i]));
+	}
+
+	return peak;
+}
+
+void SiEffectStream::_recombine_bands(SiEffectBandSplit *r_split, Vector<double> *r_buffer, int p_start_idx) {
+	if (r_split && r_split->is_split()) {
+		r_split->recombine(r_buffer->ptrw() + (p_start_idx << 1));
 	}
+}
+
+void SiEffectStream::_update_sleep(double p_input_peak, double p_output_peak, int p_length) {
+	if (p_input_peak >= SILENCE_THRESHOLD || p_output_peak >= SILENCE_THRESHOLD) {
+		_silent_length = 0;
+		return;
+	}
+
+	// Delays can be quiet between echoes, so one silent block is not enough on its own.
+	_silent_length += p_length;
+	if (_silent_length > get_tail_length()) {
+		_sleeping = true;
+	}
+}
+
+int SiEffectStream::process(int p_start_idx, int p_length, bool p_write_in_stream) {
+	Vector<double> *buffer = _stream->get_buffer_ptr();
+	int channel_count = _stream->get_channel_count();
+	// Mono signals only need the left channel, up to the first effect that needs or makes stereo.
+	// Packed streams are written that way to begin with.
+	bool left_only = _stream->is_left_only() || channel_count == 1;
+
+	if (!_chain_bypassed && !_chain.is_empty()) {
+		const double input_peak = _get_buffer_peak(p_start_idx, p_length);
+
+		if (_sleeping) {
+			if (input_peak < SILENCE_THRESHOLD) {
+				// Nothing audible in or out; leave the effects as they are and skip the output too.
+				_buffer_zeroed = (input_peak == 0.0);
+				return channel_count;
+			}
+
+			_sleeping = false;
+			_silent_length = 0;
+		}
+
+		SiEffectBandSplit *band_split = nullptr;
+		int band_split_count = 0;
+
+		for (int i = 0; i < _chain.size(); i++) {
+			if (i < _bypassed.size() && _bypassed[i]) {
+				continue;
+			}
+
+			const Ref<SiEffectBase> &effect = _chain[i];
+			double low_mid_hz = 0;
+			double mid_high_hz = 0;
+			if (!effect->get_band_split_frequencies(low_mid_hz, mid_high_hz)) {
+				_recombine_bands(band_split, buffer, p_start_idx);
+				band_split = nullptr;
+
+				if (left_only && effect->can_process_mono()) {
+					if (effect->process(1, buffer, p_start_idx, p_length) != 1) {
+						left_only = false;
+						channel_count = 2;
+					}
+					continue;
+				}
+
+				if (left_only) {
+					_stream->unpack_mono(p_start_idx, p_length);
+				}
+				channel_count = effect->process(channel_count, buffer, p_start_idx, p_length);
+				// Mono output has both channels written, but the next effects may skip the right one.
+				left_only = (channel_count == 1);
+				continue;
+			}
+
+			// Neighbouring band-aware effects with the same crossover share the split bands.
+			if (!band_split || !band_split->matches(low_mid_hz, mid_high_hz, effect->get_sampling_rate())) {
+				_recombine_bands(band_split, buffer, p_start_idx);
+
+				// Each run has its own split, so filter history carries over between blocks.
+				if (_band_splits.size() <= band_split_count) {
+					_band_splits.resize(band_split_count + 1);
+				}
+				band_split = _band_splits.ptrw() + band_split_count;
+				band_split_count++;
+
+				band_split->set_frequencies(low_mid_hz, mid_high_hz, effect->get_sampling_rate());
+				band_split->split(left_only ? 1 : channel_count, buffer->ptr() + (p_start_idx << 1), p_length);
+				left_only = false;
+				channel_count = 2;
+			}
+
+			channel_count = effect->process_bands(channel_count, band_split, p_length);
+		}
+		_recombine_bands(band_split, buffer, p_start_idx);
+
+		_update_sleep(input_peak, _get_buffer_peak(p_start_idx, p_length), p_length);
+	}
+	if (left_only) {
+		_stream->unpack_mono(p_start_idx, p_length);
+	}
+	_buffer_zeroed = false;
 
 	// Only write to output if not muted
 	if (p_write_in_stream && !_mute) {
@@ -197,7 +329,7 @@ int SiEffectStream::process(int p_start_idx, int p_length, bool p_write_in_strea
 void SiEffectStream::_add_effect(String p_cmd, Vector<double> p_args, int p_argc) {
 	ERR_FAIL_COND_MSG(p_cmd.is_empty(), "SiEffectStream: Trying to add an effect with no name.");
 
-	Ref<SiEffectBase> effect = SiEffector::get_effect_instance(p_cmd);
+	Ref<SiEffectBase> effect = SiEffector::get_effect_instance(p_cmd, _sound_chip->get_ref_table()->sampling_rate);
 	if (effect.is_valid()) {
 		effect->set_by_mml(p_args);
 		_chain.push_back(effect);
@@ -333,6 +465,10 @@ void SiEffectStream::initialize(int p_depth) {
 void SiEffectStream::reset() {
 	_stream->resize(_sound_chip->get_buffer_length() << 1);
 	_stream->clear();
+
+	_buffer_zeroed = true;
+	_sleeping = false;
+	_silent_length = 0;
 }
 
 void SiEffectStream::free() {
@@ -341,6 +477,7 @@ void SiEffectStream::free() {
 	}
 	_chain.clear();
 	_bypassed.clear();
+	_band_splits.clear();
 }
 
 SiEffectStream::SiEffectStream(SiOPMSoundChip *p_chip, SiOPMStream *p_stream) {
@@ -349,6 +486,8 @@ SiEffectStream::SiEffectStream(SiOPMSoundChip *p_chip, SiOPMStream *p_stream) {
 		_stream = p_stream;
 	} else {
 		_stream = memnew(SiOPMStream);
+		// Nothing else reads our own buffer, so it can hold mono signals packed until processed.
+		_stream->set_mono_packing(true);
 	}
 
 	_volumes.resize_zeroed(SiOPMSoundChip::STREAM_SEND_SIZE);
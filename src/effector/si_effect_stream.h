@@ -11,6 +11,7 @@
 #include <godot_cpp/templates/vector.hpp>
 #include <godot_cpp/variant/string.hpp>
 #include "effector/si_effect_base.h"
+#include "effector/components/si_effect_band_split.h"
 
 using namespace godot;
 
@@ -19,6 +20,9 @@ class SiOPMStream;
 
 class SiEffectStream {
 
+	// Peak below which a block counts as silent (about -100dB).
+	static constexpr double SILENCE_THRESHOLD = 1.0e-5;
+
 	SiOPMSoundChip *_sound_chip = nullptr;
 	Vector<Ref<SiEffectBase>> _chain;
 	Vector<bool> _bypassed;
@@ -31,6 +35,19 @@ class SiEffectStream {
 	int _pan = 64;
 	bool _has_effect_send = false;
 	bool _mute = false;
+	// Essential chains keep running when the driver sheds effects under CPU pressure.
+	bool _essential = false;
+	bool _chain_bypassed = false;
+
+	// A chain sleeps once its input and output have stayed silent for longer than the longest
+	// effect tail, and wakes up on the first block with input above the threshold.
+	bool _sleeping = false;
+	int _silent_length = 0;
+	// The buffer holds nothing but zeros, so clearing it can be skipped.
+	bool _buffer_zeroed = false;
+
+	// One split per run of band-aware effects in the chain, in chain order.
+	Vector<SiEffectBandSplit> _band_splits;
 
 	Vector<double> _volumes;
 	Vector<SiOPMStream *> _output_streams;
@@ -38,6 +55,10 @@ class SiEffectStream {
 	void _add_effect(String p_cmd, Vector<double> p_args, int p_argc);
 	void _set_postfix_param(int p_slot, String p_cmd, Vector<double> p_args, int p_argc);
 
+	double _get_buffer_peak(int p_start_idx, int p_length) const;
+	void _update_sleep(double p_input_peak, double p_output_peak, int p_length);
+	void _recombine_bands(SiEffectBandSplit *r_split, Vector<double> *r_buffer, int p_start_idx);
+
 public:
 	Vector<Ref<SiEffectBase>> get_chain() const { return _chain; }
 	void set_chain(const Vector<Ref<SiEffectBase>> &p_effects) { _chain = p_effects; }
@@ -61,8 +82,18 @@ public:
 	bool is_mute() const { return _mute; }
 	void set_mute(bool p_value) { _mute = p_value; }
 
+	bool is_essential() const { return _essential; }
+	void set_essential(bool p_value) { _essential = p_value; }
+	// Skip the whole chain and pass the dry signal through.
+	bool is_chain_bypassed() const { return _chain_bypassed; }
+	void set_chain_bypassed(bool p_value) { _chain_bypassed = p_value; }
+
 	bool is_outputting_directly() const;
 
+	bool is_sleeping() const { return _sleeping; }
+	// Longest tail among the active effects, in samples.
+	int get_tail_length() const;
+
 	void set_all_stream_send_levels(Vector<int> p_param);
 	void set_stream_send(int p_stream_num, double p_volume);
 	double get_stream_send(int p_stream_num);
@@ -71,6 +102,8 @@ public:
 	void set_post_fader_gain(double p_gain);
 	void set_post_pan(int p_pan);
 	int prepare_process();
+	// Clear the input buffer before channels write into it. Skipped when it's still clean.
+	void clear_buffer();
 	int process(int p_start_idx, int p_length, bool p_write_in_stream = true);
 
 	//
@@ -78,7 +78,7 @@ void SiEffector::register_effect(const String &p_name) {
 	_effect_instances[p_name] = Vector<Ref<SiEffectBase>>();
 }
 
-Ref<SiEffectBase> SiEffector::get_effect_instance(const String &p_name) {
+Ref<SiEffectBase> SiEffector::get_effect_instance(const String &p_name, double p_sampling_rate) {
 	ERR_FAIL_COND_V_MSG(!_effect_instances.has(p_name), Ref<SiEffectBase>(), vformat("SiEffector: Effect called '%s' does not exist.", p_name));
 
 	Vector<Ref<SiEffectBase>> instances = _effect_instances[p_name];
@@ -88,7 +88,7 @@ Ref<SiEffectBase> SiEffector::get_effect_instance(const String &p_name) {
 		if (instances[i]->is_free()) {
 			Ref<SiEffectBase> effect = instances[i];
 
-			effect->refresh_sampling_rate();
+			effect->refresh_sampling_rate(p_sampling_rate);
 			effect->set_free(false);
 			effect->reset();
 			return effect;
@@ -98,11 +98,11 @@ Ref<SiEffectBase> SiEffector::get_effect_instance(const String &p_name) {
 	// Failing above we allocate a new one.
 	// TODO: Maybe there is a better way to do it, but templates, the most obvious choice, didn't prove to be helpful.
 
-#define CREATE_EFFECT(m_type, m_name)                                 \
-	if (p_name == m_name) {                                           \
-		Ref<SiEffectBase> effect = create_effect_instance<m_type>();  \
-		instances.push_back(effect);                                  \
-		return effect;                                                \
+#define CREATE_EFFECT(m_type, m_name)                                               \
+	if (p_name == m_name) {                                                         \
+		Ref<SiEffectBase> effect = create_effect_instance<m_type>(p_sampling_rate); \
+		instances.push_back(effect);                                                \
+		return effect;                                                              \
 	}
 
 	// App effect devices: registered under canonical device kinds (see EffectCatalog).
@@ -144,12 +144,21 @@ Ref<SiEffectBase> SiEffector::get_effect_instance(const String &p_name) {
 	return Ref<SiEffectBase>();
 }
 
+PackedStringArray SiEffector::get_effect_names() {
+	PackedStringArray names;
+	for (const KeyValue<String, Vector<Ref<SiEffectBase>>> &kv : _effect_instances) {
+		names.push_back(kv.key);
+	}
+	names.sort();
+	return names;
+}
+
 template <class T>
-Ref<T> SiEffector::create_effect_instance() {
+Ref<T> SiEffector::create_effect_instance(double p_sampling_rate) {
 	Ref<T> effect;
 	effect.instantiate();
 
-	effect->refresh_sampling_rate();
+	effect->refresh_sampling_rate(p_sampling_rate);
 	effect->set_free(false);
 	effect->reset();
 	return effect;
@@ -180,6 +189,7 @@ void SiEffector::add_slot_effect(int p_slot, const Ref<SiEffectBase> &p_effect)
 
 	SiEffectStream *stream = _get_global_stream(p_slot);
 	stream->add_to_chain(p_effect);
+	p_effect->refresh_sampling_rate(_sound_chip->get_ref_table()->sampling_rate);
 	p_effect->prepare_process();
 }
 
@@ -270,12 +280,12 @@ void SiEffector::begin_process() {
 	// Do nothing with the master effect.
 
 	for (SiEffectStream *effect : _local_effects) {
-		effect->get_stream()->clear();
+		effect->clear_buffer();
 	}
 
 	for (int i = 1; i < SiOPMSoundChip::STREAM_SEND_SIZE; i++) {
 		if (_global_effects[i] != nullptr) {
-			_global_effects[i]->get_stream()->clear();
+			_global_effects[i]->clear_buffer();
 		}
 	}
 }
@@ -291,6 +301,9 @@ void SiEffector::end_process() {
 
 			if (effect->is_outputting_directly()) {
 				effect->process(0, _sound_chip->get_buffer_length(), false);
+				if (effect->is_sleeping()) {
+					continue;
+				}
 
 				Vector<double> *buffer = effect->get_stream()->get_buffer_ptr();
 				Vector<double> *output = _sound_chip->get_output_stream()->get_buffer_ptr();
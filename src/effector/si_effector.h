@@ -11,6 +11,7 @@
 #include <godot_cpp/templates/hash_map.hpp>
 #include <godot_cpp/templates/list.hpp>
 #include <godot_cpp/templates/vector.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
 #include "effector/si_effect_base.h"
 
 using namespace godot;
@@ -45,9 +46,10 @@ public:
 
 	template <class T>
 	static void register_effect(const String &p_name);
-	static Ref<SiEffectBase> get_effect_instance(const String &p_name);
+	static Ref<SiEffectBase> get_effect_instance(const String &p_name, double p_sampling_rate = 0);
+	static PackedStringArray get_effect_names();
 	template <class T>
-	static Ref<T> create_effect_instance();
+	static Ref<T> create_effect_instance(double p_sampling_rate = 0);
 
 	// Slots and connections.
 
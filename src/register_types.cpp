@@ -89,6 +89,9 @@
 #include "sequencer/simml_voice.h"
 #include "utils/offline_renderer.h"
 #include "utils/onset_detector.h"
+#ifdef SION_BENCHMARKS
+#include "utils/sion_benchmark.h"
+#endif
 #include "utils/sion_voice_preset_util.h"
 #include "utils/waveform_native_builder.h"
 
@@ -198,6 +201,9 @@ void initialize_sion_module(ModuleInitializationLevel p_level) {
 		ClassDB::register_class<OnsetDetector>();
 		ClassDB::register_class<SiONVoicePresetUtil>();
 		ClassDB::register_class<WaveformNativeBuilder>();
+#ifdef SION_BENCHMARKS
+		ClassDB::register_class<SiONBenchmark>();
+#endif
 
 		// Main SiON API classes.
 
@@ -225,7 +231,6 @@ void initialize_sion_module(ModuleInitializationLevel p_level) {
 	MMLSequencer::initialize();
 	SiOPMRefTable::initialize();
 	SiMMLRefTable::initialize();
-	SiMMLTrack::initialize();
 }
 
 void uninitialize_sion_module(ModuleInitializationLevel p_level) {
@@ -244,7 +249,6 @@ void uninitialize_sion_module(ModuleInitializationLevel p_level) {
 
 	// Finalize singletons and static members after the execution.
 	SiOPMChannelFM::finalize_pool();
-	SiMMLTrack::finalize();
 	SiMMLRefTable::finalize();
 	SiOPMRefTable::finalize();
 	MMLSequencer::finalize();
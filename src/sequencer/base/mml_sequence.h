@@ -92,7 +92,7 @@ public:
 
 	int get_event_length();
 	bool has_repeat_all();
-	Vector<Callable> get_callbacks_for_internal_call() const { return _callbacks_for_internal_call; }
+	const Vector<Callable> &get_callbacks_for_internal_call() const { return _callbacks_for_internal_call; }
 
 	// MML string.
 
@@ -64,17 +64,30 @@ void MMLSequencer::set_bpm(double p_value) {
 
 // Events.
 
+void MMLSequencer::_set_native_event_handler(int p_event_id, EventHandler p_handler, bool p_global) {
+	_native_event_handlers.write[p_event_id] = p_handler;
+	_event_handlers.write[p_event_id] = Callable();
+	_event_global_flags.write[p_event_id] = p_global;
+}
+
 void MMLSequencer::_set_mml_event_listener(int p_event_id, const Callable &p_handler, bool p_global) {
+	_native_event_handlers.write[p_event_id] = nullptr;
 	_event_handlers.write[p_event_id] = p_handler;
 	_event_global_flags.write[p_event_id] = p_global;
 }
 
-int MMLSequencer::_create_mml_event_listener(String p_letter, const Callable &p_handler, bool p_global) {
+int MMLSequencer::_create_user_defined_event(String p_letter) {
 	int event_id = _next_user_defined_event_id;
 	_next_user_defined_event_id++;
 
 	_user_defined_event_map[p_letter] = event_id;
 	_event_command_letter_map[event_id] = p_letter;
+
+	return event_id;
+}
+
+int MMLSequencer::_create_mml_event_listener(String p_letter, const Callable &p_handler, bool p_global) {
+	int event_id = _create_user_defined_event(p_letter);
 	_set_mml_event_listener(event_id, p_handler, p_global);
 
 	return event_id;
@@ -220,12 +233,12 @@ MMLEvent *MMLSequencer::_default_on_internal_wait(MMLEvent *p_event) {
 }
 
 MMLEvent *MMLSequencer::_default_on_internal_call(MMLEvent *p_event) {
-	Vector<Callable> callbacks = _current_executor->get_sequence()->get_callbacks_for_internal_call();
+	const Vector<Callable> &callbacks = _current_executor->get_sequence()->get_callbacks_for_internal_call();
 	int callback_idx = p_event->get_data();
 
 	MMLEvent *next = nullptr;
 	if (callback_idx >= 0 && callback_idx < callbacks.size()) {
-		Callable cb = callbacks[callback_idx];
+		const Callable &cb = callbacks[callback_idx];
 		if (cb.is_valid()) {
 			next = Object::cast_to<MMLEvent>(cb.call(p_event->get_length()));
 		}
@@ -239,6 +252,23 @@ MMLEvent *MMLSequencer::_default_on_internal_call(MMLEvent *p_event) {
 
 // Compilation and processing.
 
+MMLEvent *MMLSequencer::_dispatch_event(MMLEvent *p_event) {
+	const int event_id = p_event->get_id();
+
+	EventHandler handler = _native_event_handlers[event_id];
+	if (handler) {
+		return (this->*handler)(p_event);
+	}
+
+	const Callable &cb = _event_handlers[event_id];
+	if (cb.is_valid()) {
+		return Object::cast_to<MMLEvent>(cb.call(p_event));
+	}
+
+	// This shouldn't happen unless something is very wrong with our handlers.
+	return nullptr;
+}
+
 struct EventComparator {
 	_FORCE_INLINE_ bool operator()(const MMLEvent *e1, const MMLEvent *e2) const {
 		return e1->get_length() < e2->get_length();
@@ -464,14 +494,8 @@ int MMLSequencer::execute_global_sequence() {
 			_global_buffer_sample_count = 0;
 		} else {
 			// Update global execute sample count in some event handlers.
-			Callable cb = _event_handlers[event->get_id()];
-			if (cb.is_valid()) {
-				event = Object::cast_to<MMLEvent>(cb.call(event));
-				_current_executor->set_pointer(event);
-			} else {
-				// This shouldn't happen unless something is very wrong with our callables.
-				event = nullptr;
-			}
+			event = _dispatch_event(event);
+			_current_executor->set_pointer(event);
 		}
 	} while (_global_execute_sample_count == 0);
 
@@ -512,22 +536,13 @@ bool MMLSequencer::process_executor(MMLExecutor *p_executor, int p_buffer_sample
 	_process_buffer_sample_count = p_buffer_sample_count;
 	while (_process_buffer_sample_count > 0) {
 		if (event == nullptr) {
-			Callable cb = _event_handlers[MMLEvent::NO_OP];
-			if (cb.is_valid()) {
-				cb.call(_current_executor->get_nop_event());
-			}
+			_dispatch_event(_current_executor->get_nop_event());
 			return true;
 		}
 
 		// Update process buffer sample count in some event handlers.
-		Callable cb = _event_handlers[event->get_id()];
-		if (cb.is_valid()) {
-			event = Object::cast_to<MMLEvent>(cb.call(event));
-			_current_executor->set_pointer(event);
-		} else {
-			// This shouldn't happen unless something is very wrong with our callables.
-			event = nullptr;
-		}
+		event = _dispatch_event(event);
+		_current_executor->set_pointer(event);
 	}
 
 	return false;
@@ -568,49 +583,30 @@ void MMLSequencer::parse_table_event(MMLEvent *p_prev) {
 
 //
 
-void MMLSequencer::_bind_methods() {
-	// To be used as callables.
-	ClassDB::bind_method(D_METHOD("_no_process", "event"),               &MMLSequencer::_no_process);
-	ClassDB::bind_method(D_METHOD("_dummy_on_process", "event"),         &MMLSequencer::_dummy_on_process);
-	ClassDB::bind_method(D_METHOD("_dummy_on_process_event", "event"),   &MMLSequencer::_dummy_on_process_event);
-
-	ClassDB::bind_method(D_METHOD("_default_on_no_operation", "event"),  &MMLSequencer::_default_on_no_operation);
-	ClassDB::bind_method(D_METHOD("_default_on_process", "event"),       &MMLSequencer::_default_on_process);
-	ClassDB::bind_method(D_METHOD("_default_on_repeat_all", "event"),    &MMLSequencer::_default_on_repeat_all);
-	ClassDB::bind_method(D_METHOD("_default_on_repeat_begin", "event"),  &MMLSequencer::_default_on_repeat_begin);
-	ClassDB::bind_method(D_METHOD("_default_on_repeat_break", "event"),  &MMLSequencer::_default_on_repeat_break);
-	ClassDB::bind_method(D_METHOD("_default_on_repeat_end", "event"),    &MMLSequencer::_default_on_repeat_end);
-	ClassDB::bind_method(D_METHOD("_default_on_sequence_tail", "event"), &MMLSequencer::_default_on_sequence_tail);
-	ClassDB::bind_method(D_METHOD("_default_on_global_wait", "event"),   &MMLSequencer::_default_on_global_wait);
-	ClassDB::bind_method(D_METHOD("_default_on_tempo", "event"),         &MMLSequencer::_default_on_tempo);
-	ClassDB::bind_method(D_METHOD("_default_on_timer", "event"),         &MMLSequencer::_default_on_timer);
-	ClassDB::bind_method(D_METHOD("_default_on_internal_wait", "event"), &MMLSequencer::_default_on_internal_wait);
-	ClassDB::bind_method(D_METHOD("_default_on_internal_call", "event"), &MMLSequencer::_default_on_internal_call);
-}
-
 MMLSequencer::MMLSequencer() {
 	_parser_settings = memnew(MMLParserSettings);
 
+	_native_event_handlers.resize_zeroed(MMLEvent::COMMAND_MAX);
 	_event_handlers.resize_zeroed(MMLEvent::COMMAND_MAX);
 	_event_global_flags.resize_zeroed(MMLEvent::COMMAND_MAX);
 
 	for (int i = 0; i < MMLEvent::COMMAND_MAX; i++) {
-		_event_handlers.write[i] = Callable(this, "_no_process");
-	}
-
-	_set_mml_event_listener(MMLEvent::NO_OP,         Callable(this, "_default_on_no_operation"),  false);
-	_set_mml_event_listener(MMLEvent::PROCESS,       Callable(this, "_default_on_process"),       false);
-	_set_mml_event_listener(MMLEvent::REPEAT_ALL,    Callable(this, "_default_on_repeat_all"),    false);
-	_set_mml_event_listener(MMLEvent::REPEAT_BEGIN,  Callable(this, "_default_on_repeat_begin"),  false);
-	_set_mml_event_listener(MMLEvent::REPEAT_BREAK,  Callable(this, "_default_on_repeat_break"),  false);
-	_set_mml_event_listener(MMLEvent::REPEAT_END,    Callable(this, "_default_on_repeat_end"),    false);
-	_set_mml_event_listener(MMLEvent::SEQUENCE_TAIL, Callable(this, "_default_on_sequence_tail"), false);
-	_set_mml_event_listener(MMLEvent::GLOBAL_WAIT,   Callable(this, "_default_on_global_wait"),   true);
-	_set_mml_event_listener(MMLEvent::TEMPO,         Callable(this, "_default_on_tempo"),         true);
-	_set_mml_event_listener(MMLEvent::TIMER,         Callable(this, "_default_on_timer"),         true);
-	_set_mml_event_listener(MMLEvent::INTERNAL_WAIT, Callable(this, "_default_on_internal_wait"), false);
-	_set_mml_event_listener(MMLEvent::INTERNAL_CALL, Callable(this, "_default_on_internal_call"), false);
-	_set_mml_event_listener(MMLEvent::TABLE_EVENT,   Callable(this, "_no_process"),               true);
+		_native_event_handlers.write[i] = &MMLSequencer::_no_process;
+	}
+
+	_set_mml_event_handler(MMLEvent::NO_OP,         &MMLSequencer::_default_on_no_operation,  false);
+	_set_mml_event_handler(MMLEvent::PROCESS,       &MMLSequencer::_default_on_process,       false);
+	_set_mml_event_handler(MMLEvent::REPEAT_ALL,    &MMLSequencer::_default_on_repeat_all,    false);
+	_set_mml_event_handler(MMLEvent::REPEAT_BEGIN,  &MMLSequencer::_default_on_repeat_begin,  false);
+	_set_mml_event_handler(MMLEvent::REPEAT_BREAK,  &MMLSequencer::_default_on_repeat_break,  false);
+	_set_mml_event_handler(MMLEvent::REPEAT_END,    &MMLSequencer::_default_on_repeat_end,    false);
+	_set_mml_event_handler(MMLEvent::SEQUENCE_TAIL, &MMLSequencer::_default_on_sequence_tail, false);
+	_set_mml_event_handler(MMLEvent::GLOBAL_WAIT,   &MMLSequencer::_default_on_global_wait,   true);
+	_set_mml_event_handler(MMLEvent::TEMPO,         &MMLSequencer::_default_on_tempo,         true);
+	_set_mml_event_handler(MMLEvent::TIMER,         &MMLSequencer::_default_on_timer,         true);
+	_set_mml_event_handler(MMLEvent::INTERNAL_WAIT, &MMLSequencer::_default_on_internal_wait, false);
+	_set_mml_event_handler(MMLEvent::INTERNAL_CALL, &MMLSequencer::_default_on_internal_call, false);
+	_set_mml_event_handler(MMLEvent::TABLE_EVENT,   &MMLSequencer::_no_process,               true);
 
 	Ref<BeatsPerMinute> base_bpm = memnew(BeatsPerMinute(120, 0));
 	_adjustible_bpm = base_bpm;
@@ -22,7 +22,7 @@ class MMLSequenceGroup;
 // MMLSequencer is the base class that bridges MMLEvents, sound modules, and sound systems.
 //
 // You should follow this in your inherited classes:
-// 1) Register MML event listeners by set_mml_event_listener() or new_mml_event_listener().
+// 1) Register MML event handlers by _set_mml_event_handler() or _create_mml_event_handler().
 // 2) Override on...() functions.
 // 3) Override prepare_compile() and compile() if necessary.
 // 4) Override prepare_process() and process() to process audio data.
@@ -34,6 +34,13 @@ class MMLSequenceGroup;
 class MMLSequencer : public Object {
 	GDCLASS(MMLSequencer, Object)
 
+public:
+	// Built-in event handlers are dispatched directly through member function pointers.
+	// Callables are only used for listeners registered from outside of the sequencer,
+	// as they box the event into a Variant on each call.
+	typedef MMLEvent *(MMLSequencer::*EventHandler)(MMLEvent *p_event);
+
+private:
 	static MMLExecutor *_temp_executor;
 
 	// Events.
@@ -42,27 +49,12 @@ class MMLSequencer : public Object {
 	HashMap<String, int> _user_defined_event_map;
 	HashMap<int, String> _event_command_letter_map;
 
+	Vector<EventHandler> _native_event_handlers;
 	Vector<Callable> _event_handlers;
 	Vector<bool> _event_global_flags;
 
-	// Event handlers.
-
-	MMLEvent *_no_process(MMLEvent *p_event);
-	MMLEvent *_dummy_on_process(MMLEvent *p_event);       // MMLEvent::PROCESS
-	MMLEvent *_dummy_on_process_event(MMLEvent *p_event); // Other process events.
-
-	MMLEvent *_default_on_no_operation(MMLEvent *p_event);  // MMLEvent::NO_OP
-	MMLEvent *_default_on_global_wait(MMLEvent *p_event);   // MMLEvent::GLOBAL_WAIT
-	MMLEvent *_default_on_process(MMLEvent *p_event);       // MMLEvent::PROCESS
-	MMLEvent *_default_on_repeat_all(MMLEvent *p_event);    // MMLEvent::REPEAT_ALL
-	MMLEvent *_default_on_repeat_begin(MMLEvent *p_event);  // MMLEvent::REPEAT_BEGIN
-	MMLEvent *_default_on_repeat_break(MMLEvent *p_event);  // MMLEvent::REPEAT_BREAK
-	MMLEvent *_default_on_repeat_end(MMLEvent *p_event);    // MMLEvent::REPEAT_END
-	MMLEvent *_default_on_sequence_tail(MMLEvent *p_event); // MMLEvent::SEQUENCE_TAIL
-	MMLEvent *_default_on_tempo(MMLEvent *p_event);         // MMLEvent::TEMPO
-	MMLEvent *_default_on_timer(MMLEvent *p_event);         // MMLEvent::TIMER
-	MMLEvent *_default_on_internal_wait(MMLEvent *p_event); // MMLEvent::INTERNAL_WAIT
-	MMLEvent *_default_on_internal_call(MMLEvent *p_event); // MMLEvent::INTERNAL_CALL
+	void _set_native_event_handler(int p_event_id, EventHandler p_handler, bool p_global);
+	_FORCE_INLINE_ MMLEvent *_dispatch_event(MMLEvent *p_event);
 
 	// Compilation and processing.
 
@@ -106,14 +98,50 @@ protected:
 	// Filter for the on-beat callback, 0 = 16th beat, 1 = 8th beat, 3 = 4th beat, 7 = 2nd beat, 15 = whole tone.
 	int _on_beat_callback_filter = 3;
 
+	// Event handlers.
+
+	// Samples the current executor has yet to process in this segment. An _on_process()
+	// call of exactly this length is the last one the executor makes before the segment ends.
+	int _get_process_buffer_sample_count() const { return _process_buffer_sample_count; }
+
+	MMLEvent *_no_process(MMLEvent *p_event);
+	MMLEvent *_dummy_on_process(MMLEvent *p_event);       // MMLEvent::PROCESS
+	MMLEvent *_dummy_on_process_event(MMLEvent *p_event); // Other process events.
+
+	MMLEvent *_default_on_no_operation(MMLEvent *p_event);  // MMLEvent::NO_OP
+	MMLEvent *_default_on_global_wait(MMLEvent *p_event);   // MMLEvent::GLOBAL_WAIT
+	MMLEvent *_default_on_process(MMLEvent *p_event);       // MMLEvent::PROCESS
+	MMLEvent *_default_on_repeat_all(MMLEvent *p_event);    // MMLEvent::REPEAT_ALL
+	MMLEvent *_default_on_repeat_begin(MMLEvent *p_event);  // MMLEvent::REPEAT_BEGIN
+	MMLEvent *_default_on_repeat_break(MMLEvent *p_event);  // MMLEvent::REPEAT_BREAK
+	MMLEvent *_default_on_repeat_end(MMLEvent *p_event);    // MMLEvent::REPEAT_END
+	MMLEvent *_default_on_sequence_tail(MMLEvent *p_event); // MMLEvent::SEQUENCE_TAIL
+	MMLEvent *_default_on_tempo(MMLEvent *p_event);         // MMLEvent::TEMPO
+	MMLEvent *_default_on_timer(MMLEvent *p_event);         // MMLEvent::TIMER
+	MMLEvent *_default_on_internal_wait(MMLEvent *p_event); // MMLEvent::INTERNAL_WAIT
+	MMLEvent *_default_on_internal_call(MMLEvent *p_event); // MMLEvent::INTERNAL_CALL
+
 	// Events.
 
+	// Native handlers can be methods of extending classes, they are only ever called on this instance.
+	template <class T>
+	void _set_mml_event_handler(int p_event_id, MMLEvent *(T::*p_handler)(MMLEvent *), bool p_global = false) {
+		_set_native_event_handler(p_event_id, static_cast<EventHandler>(p_handler), p_global);
+	}
+	template <class T>
+	int _create_mml_event_handler(String p_letter, MMLEvent *(T::*p_handler)(MMLEvent *), bool p_global = false) {
+		int event_id = _create_user_defined_event(p_letter);
+		_set_native_event_handler(event_id, static_cast<EventHandler>(p_handler), p_global);
+		return event_id;
+	}
+
+	int _create_user_defined_event(String p_letter);
 	void _set_mml_event_listener(int p_event_id, const Callable &p_handler, bool p_global = false);
 	int _create_mml_event_listener(String p_letter, const Callable &p_handler, bool p_global = false);
 
 	//
 
-	static void _bind_methods();
+	static void _bind_methods() {}
 
 public:
 	static const int FIXED_BITS = 8;
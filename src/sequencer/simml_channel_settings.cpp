@@ -9,6 +9,7 @@
 #include "chip/channels/siopm_channel_base.h"
 #include "chip/siopm_channel_params.h"
 #include "chip/siopm_ref_table.h"
+#include "chip/siopm_sound_chip.h"
 #include "chip/wave/siopm_wave_table.h"
 #include "sequencer/base/mml_sequence.h"
 #include "sequencer/simml_ref_table.h"
@@ -17,19 +18,20 @@
 
 int SiMMLChannelSettings::initialize_tone(SiMMLTrack *p_track, int p_channel_num, int p_buffer_index) {
 	// Prepare the track.
+	SiOPMChannelManager *channel_manager = p_track->get_sound_chip()->get_channel_manager();
 
 	if (!p_track->get_channel()) {
 		// Create a new channel.
-		SiOPMChannelBase *channel = SiOPMChannelManager::create_channel(_channel_type, nullptr, p_buffer_index);
+		SiOPMChannelBase *channel = channel_manager->create_channel(_channel_type, nullptr, p_buffer_index);
 		p_track->set_channel(channel);
 
 	} else if (p_track->get_channel()->get_channel_type() != _channel_type) {
 		// Update the channel type.
 		SiOPMChannelBase *old_channel = p_track->get_channel();
-		SiOPMChannelBase *channel = SiOPMChannelManager::create_channel(_channel_type, old_channel, p_buffer_index);
+		SiOPMChannelBase *channel = channel_manager->create_channel(_channel_type, old_channel, p_buffer_index);
 		p_track->set_channel(channel);
 
-		SiOPMChannelManager::delete_channel(old_channel);
+		channel_manager->delete_channel(old_channel);
 
 	} else {
 		// Just initialize the channel.
@@ -80,7 +82,7 @@ MMLSequence *SiMMLChannelSettings::select_tone(SiMMLTrack *p_track, int p_voice_
 				voice_index = 0;
 			}
 
-			Ref<SiMMLVoice> voice = SiMMLRefTable::get_instance()->get_voice(voice_index);
+			Ref<SiMMLVoice> voice = SiMMLRefTable::get_instance()->get_voice(voice_index, p_track->get_ref_stencil());
 			if (voice.is_null()) {
 				break;
 			}
@@ -16,43 +16,6 @@
 
 using namespace godot;
 
-void SiMMLData::clear_ref_stencils() {
-	// Bank 2 and 3 are not available at this time.
-	SiOPMRefTable::get_instance()->clear_sampler_table_stencil(0);
-	SiOPMRefTable::get_instance()->clear_sampler_table_stencil(1);
-
-	SiOPMRefTable::get_instance()->clear_stencil_custom_wave_tables();
-	SiOPMRefTable::get_instance()->clear_stencil_pcm_voices();
-
-	SiMMLRefTable::get_instance()->clear_stencil_envelopes();
-	SiMMLRefTable::get_instance()->clear_stencil_voices();
-}
-
-void SiMMLData::register_ref_stencils() {
-	// ARCHITECTURAL CONTRACT:
-	// This method can be safely called from the audio thread because:
-	// 1. The constructor allocates all vectors to their *_MAX sizes.
-	// 2. clear() resets the contents but does not change sizes or layout.
-	// 3. The destructor does not mutate vector sizes; normal destruction happens
-	//    only after the audio thread has stopped using this instance.
-	// 4. Callers must ensure SiMMLData is not destroyed while the audio thread
-	//    may access it (e.g. via Ref<> ownership in the driver/sequencer).
-	//
-	// Therefore: if we have a valid Ref<SiMMLData> on the audio thread,
-	// the vectors are guaranteed to exist with the proper sizes, even if
-	// clear() has been called.
-
-	// Bank 2 and 3 are not available at this time.
-	SiOPMRefTable::get_instance()->set_sampler_table_stencil(0, _sampler_tables[0]);
-	SiOPMRefTable::get_instance()->set_sampler_table_stencil(1, _sampler_tables[1]);
-
-	SiOPMRefTable::get_instance()->set_stencil_custom_wave_tables(_wave_tables);
-	SiOPMRefTable::get_instance()->set_stencil_pcm_voices(_pcm_voices);
-
-	SiMMLRefTable::get_instance()->set_stencil_envelopes(_envelope_tables);
-	SiMMLRefTable::get_instance()->set_stencil_voices(_fm_voices);
-}
-
 // Tables.
 
 Ref<SiMMLEnvelopeTable> SiMMLData::get_envelope_table(int p_index) const {
@@ -114,6 +77,7 @@ void SiMMLData::set_voice(int p_index, const Ref<SiMMLVoice> &p_voice) {
 	ERR_FAIL_COND_MSG(!p_voice->is_suitable_for_fm_voice(), "SiMMLData: Cannot set voice data which is not suitable for FM voices.");
 
 	_fm_voices.write[p_index] = p_voice;
+	p_voice->get_channel_params()->compile_program();
 }
 
 Ref<SiMMLVoice> SiMMLData::get_pcm_voice(int p_index) {
@@ -126,6 +90,19 @@ Ref<SiMMLVoice> SiMMLData::get_pcm_voice(int p_index) {
 	return _pcm_voices[index];
 }
 
+void SiMMLData::compile_voice_programs() {
+	for (const Ref<SiMMLVoice> &voice : _fm_voices) {
+		if (voice.is_valid()) {
+			voice->get_channel_params()->compile_program();
+		}
+	}
+	for (const Ref<SiMMLVoice> &voice : _pcm_voices) {
+		if (voice.is_valid()) {
+			voice->get_channel_params()->compile_program();
+		}
+	}
+}
+
 //
 
 void SiMMLData::clear() {
@@ -170,6 +147,23 @@ SiMMLData::SiMMLData() {
 	for (int i = 0; i < SiOPMRefTable::SAMPLER_TABLE_MAX; i++) {
 		_sampler_tables.write[i] = Ref<SiOPMWaveSamplerTable>(memnew(SiOPMWaveSamplerTable));
 	}
+
+	// ARCHITECTURAL CONTRACT:
+	// The stencil is read from the audio thread, which is safe because:
+	// 1. The vectors above are allocated to their *_MAX sizes here, once.
+	// 2. clear() resets the contents but does not change sizes or layout.
+	// 3. The destructor does not mutate vector sizes; normal destruction happens
+	//    only after the audio thread has stopped using this instance.
+	// 4. Callers must ensure SiMMLData is not destroyed while the audio thread
+	//    may access it (e.g. via Ref<> ownership in the track).
+	//
+	// Therefore: as long as a track holds a valid Ref<SiMMLData>, the stencil
+	// points at vectors with the proper sizes, even if clear() has been called.
+	_ref_stencil.custom_wave_tables = &_wave_tables;
+	_ref_stencil.pcm_voices = &_pcm_voices;
+	_ref_stencil.sampler_tables = &_sampler_tables;
+	_ref_stencil.envelope_tables = &_envelope_tables;
+	_ref_stencil.voices = &_fm_voices;
 }
 
 SiMMLData::~SiMMLData() {
@@ -9,6 +9,7 @@
 
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/templates/vector.hpp>
+#include "chip/siopm_ref_stencil.h"
 #include "sequencer/base/mml_data.h"
 
 using namespace godot;
@@ -32,10 +33,12 @@ protected:
 	Vector<Ref<SiMMLVoice>> _fm_voices;
 	Vector<Ref<SiMMLVoice>> _pcm_voices;
 
+	SiOPMRefStencil _ref_stencil;
+
 public:
-	// Static so it can be called when there is no SiMMLData instance available.
-	static void clear_ref_stencils();
-	void register_ref_stencils();
+	// Lookup context that makes tables and voices defined by this data take precedence
+	// over the global ones, for tracks playing it.
+	const SiOPMRefStencil *get_ref_stencil() const { return &_ref_stencil; }
 
 	// Tables.
 
@@ -53,6 +56,9 @@ public:
 	Ref<SiMMLVoice> initialize_voice(int p_index);
 	void set_voice(int p_index, const Ref<SiMMLVoice> &p_voice);
 	Ref<SiMMLVoice> get_pcm_voice(int p_index);
+	// Compile every voice's program up front, so tracks switching voices during
+	// playback don't have to do it on the audio thread.
+	void compile_voice_programs();
 
 	//
 
@@ -11,24 +11,59 @@
 #include <godot_cpp/templates/vector.hpp>
 #include <godot_cpp/variant/packed_int32_array.hpp>
 #include <godot_cpp/variant/string.hpp>
-#include "templates/singly_linked_list.h"
 
 using namespace godot;
 
+// Envelope values stored as a contiguous array. After the last value playback either
+// jumps back to the loop index or, without one, ends.
 class SiMMLEnvelopeTable : public RefCounted {
 	GDCLASS(SiMMLEnvelopeTable, RefCounted)
 
-	SinglyLinkedList<int> *_data = nullptr;
+public:
+	// Playback position in a table. It refers to the table's data without owning it, so
+	// the table must outlive the cursor. Copying one is free, which lets every user keep
+	// its own position in shared tables.
+	struct Cursor {
+		const int *values = nullptr;
+		int length = 0;
+		int loop_index = -1;
+		int position = -1; // -1 when there is no table or the envelope has ended.
+
+		bool is_active() const { return position >= 0; }
+		int get_value() const { return values[position]; }
+		bool refers_to(const int *p_values) const { return values == p_values; }
+
+		void advance() {
+			position++;
+			if (position >= length) {
+				position = loop_index;
+			}
+		}
+
+		Cursor() {}
+		Cursor(const int *p_values, int p_length, int p_loop_index) :
+				values(p_values),
+				length(p_length),
+				loop_index(p_loop_index < p_length ? p_loop_index : -1),
+				position(p_length > 0 ? 0 : -1) {}
+	};
+
+private:
+	Vector<int> _values;
+	int _loop_index = -1;
 
 protected:
 	static void _bind_methods();
 
 public:
-	SinglyLinkedList<int> *get_data() const { return _data; }
-	void set_data(SinglyLinkedList<int> *p_data);
+	bool is_empty() const { return _values.is_empty(); }
+	int get_length() const { return _values.size(); }
+	int get_loop_index() const { return _loop_index; }
+	const Vector<int> &get_values() const { return _values; }
+	void set_values(const Vector<int> &p_values, int p_loop_index = -1);
 
-	SinglyLinkedList<int>::Element *get_head() const;
-	SinglyLinkedList<int>::Element *get_tail() const;
+	// A cursor at the start of the table; inactive if the table is empty.
+	Cursor get_cursor() const { return Cursor(_values.ptr(), _values.size(), _loop_index); }
 
 	//
 
@@ -41,7 +76,7 @@ public:
 	void copy_from(const Ref<SiMMLEnvelopeTable> &p_source);
 
 	SiMMLEnvelopeTable(Vector<int> p_table = Vector<int>(), int p_loop_point = -1);
-	~SiMMLEnvelopeTable();
+	~SiMMLEnvelopeTable() {}
 };
 
 #endif // SIMML_ENVELOPE_TABLE_H
@@ -62,20 +62,26 @@ void SiMMLRefTable::register_master_voice(int p_index, const Ref<SiMMLVoice> &p_
 	_master_voices.write[p_index] = p_voice;
 }
 
-Ref<SiMMLEnvelopeTable> SiMMLRefTable::get_envelope_table(int p_index) {
+Ref<SiMMLEnvelopeTable> SiMMLRefTable::get_envelope_table(int p_index, const SiOPMRefStencil *p_stencil) {
 	ERR_FAIL_INDEX_V(p_index, ENVELOPE_TABLE_MAX, nullptr);
 
-	if (p_index < _stencil_envelopes.size() && _stencil_envelopes[p_index].is_valid()) {
-		return _stencil_envelopes[p_index];
+	if (p_stencil && p_stencil->envelope_tables) {
+		const Vector<Ref<SiMMLEnvelopeTable>> &stencil_envelopes = *p_stencil->envelope_tables;
+		if (p_index < stencil_envelopes.size() && stencil_envelopes[p_index].is_valid()) {
+			return stencil_envelopes[p_index];
+		}
 	}
 	return _master_envelopes[p_index];
 }
 
-Ref<SiMMLVoice> SiMMLRefTable::get_voice(int p_index) {
+Ref<SiMMLVoice> SiMMLRefTable::get_voice(int p_index, const SiOPMRefStencil *p_stencil) {
 	ERR_FAIL_INDEX_V(p_index, VOICE_MAX, nullptr);
 
-	if (p_index < _stencil_voices.size() && _stencil_voices[p_index].is_valid()) {
-		return _stencil_voices[p_index];
+	if (p_stencil && p_stencil->voices) {
+		const Vector<Ref<SiMMLVoice>> &stencil_voices = *p_stencil->voices;
+		if (p_index < stencil_voices.size() && stencil_voices[p_index].is_valid()) {
+			return stencil_voices[p_index];
+		}
 	}
 	return _master_voices[p_index];
 }
@@ -396,8 +402,6 @@ SiMMLRefTable::SiMMLRefTable() {
 SiMMLRefTable::~SiMMLRefTable() {
 	_master_envelopes.clear();
 	_master_voices.clear();
-	_stencil_envelopes.clear();
-	_stencil_voices.clear();
 
 	for (const KeyValue<SiONModuleType, SiMMLChannelSettings *> &kv : channel_settings_map) {
 		memdelete(kv.value);
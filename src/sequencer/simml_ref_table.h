@@ -11,6 +11,7 @@
 #include <godot_cpp/templates/hash_map.hpp>
 #include <godot_cpp/templates/list.hpp>
 #include <godot_cpp/templates/vector.hpp>
+#include "chip/siopm_ref_stencil.h"
 #include "sequencer/simml_envelope_table.h"
 #include "sequencer/simml_voice.h"
 
@@ -26,8 +27,6 @@ class SiMMLRefTable {
 
 	Vector<Ref<SiMMLEnvelopeTable>> _master_envelopes;
 	Vector<Ref<SiMMLVoice>> _master_voices;
-	Vector<Ref<SiMMLEnvelopeTable>> _stencil_envelopes;
-	Vector<Ref<SiMMLVoice>> _stencil_voices;
 
 	void _fill_tss_log_table(String (&r_table)[256], int p_start, int p_step, int p_v0, int p_v255);
 
@@ -121,13 +120,9 @@ public:
 	void register_master_envelope_table(int p_index, const Ref<SiMMLEnvelopeTable> &p_table);
 	void register_master_voice(int p_index, const Ref<SiMMLVoice> &p_voice);
 
-	void set_stencil_envelopes(Vector<Ref<SiMMLEnvelopeTable>> p_tables) { _stencil_envelopes = p_tables; }
-	void clear_stencil_envelopes() { _stencil_envelopes = Vector<Ref<SiMMLEnvelopeTable>>(); }
-	void set_stencil_voices(Vector<Ref<SiMMLVoice>> p_tables) { _stencil_voices = p_tables; }
-	void clear_stencil_voices() { _stencil_voices = Vector<Ref<SiMMLVoice>>(); }
-
-	Ref<SiMMLEnvelopeTable> get_envelope_table(int p_index);
-	Ref<SiMMLVoice> get_voice(int p_index);
+	// Entries of p_stencil, if given, take precedence over the master tables.
+	Ref<SiMMLEnvelopeTable> get_envelope_table(int p_index, const SiOPMRefStencil *p_stencil = nullptr);
+	Ref<SiMMLVoice> get_voice(int p_index, const SiOPMRefStencil *p_stencil = nullptr);
 
 	int get_pulse_generator_type(SiONModuleType p_module_type, int p_channel_num, int p_tone_num = -1);
 	bool is_suitable_for_fm_voice(SiONModuleType p_module_type);
@@ -12,6 +12,7 @@
 #include <godot_cpp/variant/variant.hpp>
 #include "sion_enums.h"
 #include "chip/channels/siopm_channel_base.h"
+#include "chip/channels/siopm_channel_fm_batch.h"
 #include "chip/siopm_channel_params.h"
 #include "chip/siopm_operator_params.h"
 #include "chip/siopm_ref_table.h"
@@ -128,7 +129,7 @@ SiMMLTrack *SiMMLSequencer::create_controllable_track(int p_internal_track_id, b
 			track = _free_tracks.back()->get();
 			_free_tracks.pop_back();
 		} else {
-			track = memnew(SiMMLTrack);
+			track = memnew(SiMMLTrack(_sound_chip));
 		}
 
 		track->set_track_number(_tracks.size());
@@ -312,9 +313,21 @@ void SiMMLSequencer::_on_after_compile(MMLSequenceGroup *p_group) {
 			sequence = sequence->get_next_sequence();
 		}
 	}
+
+	// Voices are final once the data is compiled.
+	Ref<SiMMLData> simml_data = mml_data;
+	if (simml_data.is_valid()) {
+		simml_data->compile_voice_programs();
+	}
 }
 
 void SiMMLSequencer::_on_process(int p_length, MMLEvent *p_event) {
+	// Nothing reaches the track again before the segment ends, so its last block can wait
+	// for the batch flush in process().
+	if (p_length == _get_process_buffer_sample_count() && _current_track->buffer_deferred(p_length, _fm_batch)) {
+		return;
+	}
+
 	_current_track->buffer(p_length);
 }
 
@@ -353,7 +366,7 @@ void SiMMLSequencer::_on_table_parse(MMLEvent *p_prev, String p_table) {
 
 	Ref<SiMMLEnvelopeTable> env_table = memnew(SiMMLEnvelopeTable);
 	env_table->parse_mml(data, postfix);
-	ERR_FAIL_COND_MSG(!env_table->get_data(), vformat("SiMMLSequencer: Invalid table parameter '%s' in the {..} command.", data));
+	ERR_FAIL_COND_MSG(env_table->is_empty(), vformat("SiMMLSequencer: Invalid table parameter '%s' in the {..} command.", data));
 
 	Ref<SiMMLData> simml_data = mml_data;
 	simml_data->set_envelope_table(_internal_table_index, env_table);
@@ -417,7 +430,7 @@ void SiMMLSequencer::prepare_process(const Ref<MMLData> &p_data, int p_sample_ra
 					track = _free_tracks.back()->get();
 					_free_tracks.pop_back();
 				} else {
-					track = memnew(SiMMLTrack);
+					track = memnew(SiMMLTrack(_sound_chip));
 				}
 
 				int internal_track_id = index | SiMMLTrack::MML_TRACK;
@@ -469,6 +482,7 @@ void SiMMLSequencer::process() {
 
 			finished = process_executor(track->get_executor(), length) && finished;
 		}
+		_fm_batch->flush();
 
 		_bpm_change_enabled = true;
 	} while (!check_global_sequence_end());
@@ -824,7 +838,7 @@ bool SiMMLSequencer::_parse_system_command_before(String p_command, String p_par
 
 		Ref<SiMMLEnvelopeTable> env_table = memnew(SiMMLEnvelopeTable);
 		env_table->parse_mml(content, postfix);
-		ERR_FAIL_COND_V_MSG(!env_table->get_data(), true, vformat("SiMMLSequencer: Invalid parameter '%s' for command '%s'.", content, p_command));
+		ERR_FAIL_COND_V_MSG(env_table->is_empty(), true, vformat("SiMMLSequencer: Invalid parameter '%s' for command '%s'.", content, p_command));
 
 		Ref<SiMMLData> simml_data = mml_data;
 		simml_data->set_envelope_table(number, env_table);
@@ -1050,7 +1064,7 @@ MMLEvent *SiMMLSequencer::_on_mml_tone_envelope(MMLEvent *p_event) {
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_tone_envelope(1, env_table, step);
@@ -1068,7 +1082,7 @@ MMLEvent *SiMMLSequencer::_on_mml_amplitude_envelope(MMLEvent *p_event) {
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_amplitude_envelope(1, env_table, step);
@@ -1086,7 +1100,7 @@ MMLEvent *SiMMLSequencer::_on_mml_amplitude_envelope_tsscp(MMLEvent *p_event) {
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_amplitude_envelope(1, env_table, step, true);
@@ -1104,7 +1118,7 @@ MMLEvent *SiMMLSequencer::_on_mml_pitch_envelope(MMLEvent *p_event) {
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_pitch_envelope(1, env_table, step);
@@ -1122,7 +1136,7 @@ MMLEvent *SiMMLSequencer::_on_mml_note_envelope(MMLEvent *p_event) {
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_note_envelope(1, env_table, step);
@@ -1140,7 +1154,7 @@ MMLEvent *SiMMLSequencer::_on_mml_filter_envelope(MMLEvent *p_event) {
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_filter_envelope(1, env_table, step);
@@ -1158,7 +1172,7 @@ MMLEvent *SiMMLSequencer::_on_mml_tone_release_envelope(MMLEvent *p_event) {
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_tone_envelope(0, env_table, step);
@@ -1176,7 +1190,7 @@ MMLEvent *SiMMLSequencer::_on_mml_amplitude_release_envelope(MMLEvent *p_event)
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_amplitude_envelope(0, env_table, step);
@@ -1194,7 +1208,7 @@ MMLEvent *SiMMLSequencer::_on_mml_pitch_release_envelope(MMLEvent *p_event) {
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_pitch_envelope(0, env_table, step);
@@ -1212,7 +1226,7 @@ MMLEvent *SiMMLSequencer::_on_mml_note_release_envelope(MMLEvent *p_event) {
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_note_envelope(0, env_table, step);
@@ -1230,7 +1244,7 @@ MMLEvent *SiMMLSequencer::_on_mml_filter_release_envelope(MMLEvent *p_event) {
 
 	Ref<SiMMLEnvelopeTable> env_table;
 	if (idx >= 0) {
-		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx);
+		env_table = SiMMLRefTable::get_instance()->get_envelope_table(idx, _current_track->get_ref_stencil());
 	}
 
 	_current_track->set_filter_envelope(0, env_table, step);
@@ -1269,7 +1283,7 @@ MMLEvent *SiMMLSequencer::_on_mml_lf_oscillator(MMLEvent *p_event) {
 	cycle_time *= 1000/60; // Convert to ms.
 
 	if (waveform >= SiOPMRefTable::LFO_WAVE_MAX && waveform < 255) { // Custom table.
-		Ref<SiMMLEnvelopeTable> ev_table = SiMMLRefTable::get_instance()->get_envelope_table(ev_params[1]);
+		Ref<SiMMLEnvelopeTable> ev_table = SiMMLRefTable::get_instance()->get_envelope_table(ev_params[1], _current_track->get_ref_stencil());
 		if (ev_table.is_valid()) {
 			Vector<int> table_vector;
 			ev_table->to_vector(256, &table_vector, 0, 255);
@@ -1637,97 +1651,97 @@ MMLEvent *SiMMLSequencer::_on_mml_register_update(MMLEvent *p_event) {
 //
 
 void SiMMLSequencer::_register_process_events() {
-	_set_mml_event_listener(MMLEvent::NO_OP,     Callable((MMLSequencer *)this, "_default_on_no_operation"));
-	_set_mml_event_listener(MMLEvent::PROCESS,   Callable((MMLSequencer *)this, "_default_on_process"));
-	_set_mml_event_listener(MMLEvent::REST,      Callable(this, "_on_mml_rest"));
-	_set_mml_event_listener(MMLEvent::NOTE,      Callable(this, "_on_mml_note"));
-	_set_mml_event_listener(MMLEvent::SLUR,      Callable(this, "_on_mml_slur"));
-	_set_mml_event_listener(MMLEvent::SLUR_WEAK, Callable(this, "_on_mml_slur_weak"));
-	_set_mml_event_listener(MMLEvent::PITCHBEND, Callable(this, "_on_mml_pitch_bend"));
+	_set_mml_event_handler(MMLEvent::NO_OP,     &SiMMLSequencer::_default_on_no_operation);
+	_set_mml_event_handler(MMLEvent::PROCESS,   &SiMMLSequencer::_default_on_process);
+	_set_mml_event_handler(MMLEvent::REST,      &SiMMLSequencer::_on_mml_rest);
+	_set_mml_event_handler(MMLEvent::NOTE,      &SiMMLSequencer::_on_mml_note);
+	_set_mml_event_handler(MMLEvent::SLUR,      &SiMMLSequencer::_on_mml_slur);
+	_set_mml_event_handler(MMLEvent::SLUR_WEAK, &SiMMLSequencer::_on_mml_slur_weak);
+	_set_mml_event_handler(MMLEvent::PITCHBEND, &SiMMLSequencer::_on_mml_pitch_bend);
 }
 
 void SiMMLSequencer::_register_dummy_process_events() {
-	_set_mml_event_listener(MMLEvent::NO_OP,     Callable((MMLSequencer *)this, "_no_process"));
-	_set_mml_event_listener(MMLEvent::PROCESS,   Callable((MMLSequencer *)this, "_dummy_on_process"));
-	_set_mml_event_listener(MMLEvent::REST,      Callable((MMLSequencer *)this, "_dummy_on_process_event"));
-	_set_mml_event_listener(MMLEvent::NOTE,      Callable((MMLSequencer *)this, "_dummy_on_process_event"));
-	_set_mml_event_listener(MMLEvent::SLUR,      Callable((MMLSequencer *)this, "_dummy_on_process_event"));
-	_set_mml_event_listener(MMLEvent::SLUR_WEAK, Callable((MMLSequencer *)this, "_dummy_on_process_event"));
-	_set_mml_event_listener(MMLEvent::PITCHBEND, Callable((MMLSequencer *)this, "_dummy_on_process_event"));
+	_set_mml_event_handler(MMLEvent::NO_OP,     &SiMMLSequencer::_no_process);
+	_set_mml_event_handler(MMLEvent::PROCESS,   &SiMMLSequencer::_dummy_on_process);
+	_set_mml_event_handler(MMLEvent::REST,      &SiMMLSequencer::_dummy_on_process_event);
+	_set_mml_event_handler(MMLEvent::NOTE,      &SiMMLSequencer::_dummy_on_process_event);
+	_set_mml_event_handler(MMLEvent::SLUR,      &SiMMLSequencer::_dummy_on_process_event);
+	_set_mml_event_handler(MMLEvent::SLUR_WEAK, &SiMMLSequencer::_dummy_on_process_event);
+	_set_mml_event_handler(MMLEvent::PITCHBEND, &SiMMLSequencer::_dummy_on_process_event);
 }
 
 void SiMMLSequencer::_register_event_listeners() {
 	// Pitch.
-	_create_mml_event_listener("k",    Callable(this, "_on_mml_detune"));
-	_create_mml_event_listener("kt",   Callable(this, "_on_mml_key_transition"));
-	_create_mml_event_listener("!@kr", Callable(this, "_on_mml_relative_detune"));
+	_create_mml_event_handler("k",    &SiMMLSequencer::_on_mml_detune);
+	_create_mml_event_handler("kt",   &SiMMLSequencer::_on_mml_key_transition);
+	_create_mml_event_handler("!@kr", &SiMMLSequencer::_on_mml_relative_detune);
 
 	// Track settings.
-	_create_mml_event_listener("@mask", Callable(this, "_on_mml_event_mask"));
-	_set_mml_event_listener(MMLEvent::QUANT_RATIO,  Callable(this, "_on_mml_quant_ratio"));
-	_set_mml_event_listener(MMLEvent::QUANT_COUNT,  Callable(this, "_on_mml_quant_count"));
+	_create_mml_event_handler("@mask", &SiMMLSequencer::_on_mml_event_mask);
+	_set_mml_event_handler(MMLEvent::QUANT_RATIO,  &SiMMLSequencer::_on_mml_quant_ratio);
+	_set_mml_event_handler(MMLEvent::QUANT_COUNT,  &SiMMLSequencer::_on_mml_quant_count);
 
 	// Volume.
-	_create_mml_event_listener("p",  Callable(this, "_on_mml_pan"));
-	_create_mml_event_listener("@p", Callable(this, "_on_mml_fine_pan"));
-	_create_mml_event_listener("@f", Callable(this, "_on_mml_filter"));
-	_create_mml_event_listener("x",  Callable(this, "_on_mml_expression"));
-	_set_mml_event_listener(MMLEvent::VOLUME,       Callable(this, "_on_mml_volume"));
-	_set_mml_event_listener(MMLEvent::VOLUME_SHIFT, Callable(this, "_on_mml_volume_shift"));
-	_set_mml_event_listener(MMLEvent::FINE_VOLUME,  Callable(this, "_on_mml_master_volume"));
-	_create_mml_event_listener("%v",  Callable(this, "_on_mml_volume_setting"));
-	_create_mml_event_listener("%x",  Callable(this, "_on_mml_expression_setting"));
-	_create_mml_event_listener("%f",  Callable(this, "_on_mml_filter_mode"));
+	_create_mml_event_handler("p",  &SiMMLSequencer::_on_mml_pan);
+	_create_mml_event_handler("@p", &SiMMLSequencer::_on_mml_fine_pan);
+	_create_mml_event_handler("@f", &SiMMLSequencer::_on_mml_filter);
+	_create_mml_event_handler("x",  &SiMMLSequencer::_on_mml_expression);
+	_set_mml_event_handler(MMLEvent::VOLUME,       &SiMMLSequencer::_on_mml_volume);
+	_set_mml_event_handler(MMLEvent::VOLUME_SHIFT, &SiMMLSequencer::_on_mml_volume_shift);
+	_set_mml_event_handler(MMLEvent::FINE_VOLUME,  &SiMMLSequencer::_on_mml_master_volume);
+	_create_mml_event_handler("%v",  &SiMMLSequencer::_on_mml_volume_setting);
+	_create_mml_event_handler("%x",  &SiMMLSequencer::_on_mml_expression_setting);
+	_create_mml_event_handler("%f",  &SiMMLSequencer::_on_mml_filter_mode);
 
 	// Channel settings.
-	_create_mml_event_listener("@clock", Callable(this, "_on_mml_clock"));
-	_create_mml_event_listener("@al", Callable(this, "_on_mml_algorithm"));
-	_create_mml_event_listener("@fb", Callable(this, "_on_mml_feedback"));
-	_create_mml_event_listener("@r",  Callable(this, "_on_mml_ring_modulation"));
-	_set_mml_event_listener(MMLEvent::MOD_TYPE,    Callable(this, "_on_mml_module_type"));
-	_set_mml_event_listener(MMLEvent::INPUT_PIPE,  Callable(this, "_on_mml_input"));
-	_set_mml_event_listener(MMLEvent::OUTPUT_PIPE, Callable(this, "_on_mml_output"));
-	_create_mml_event_listener("%t",  Callable(this, "_on_mml_event_trigger"));
-	_create_mml_event_listener("%e",  Callable(this, "_on_mml_dispatch_event"));
+	_create_mml_event_handler("@clock", &SiMMLSequencer::_on_mml_clock);
+	_create_mml_event_handler("@al", &SiMMLSequencer::_on_mml_algorithm);
+	_create_mml_event_handler("@fb", &SiMMLSequencer::_on_mml_feedback);
+	_create_mml_event_handler("@r",  &SiMMLSequencer::_on_mml_ring_modulation);
+	_set_mml_event_handler(MMLEvent::MOD_TYPE,    &SiMMLSequencer::_on_mml_module_type);
+	_set_mml_event_handler(MMLEvent::INPUT_PIPE,  &SiMMLSequencer::_on_mml_input);
+	_set_mml_event_handler(MMLEvent::OUTPUT_PIPE, &SiMMLSequencer::_on_mml_output);
+	_create_mml_event_handler("%t",  &SiMMLSequencer::_on_mml_event_trigger);
+	_create_mml_event_handler("%e",  &SiMMLSequencer::_on_mml_dispatch_event);
 
 	// Operator settings.
-	_create_mml_event_listener("i",   Callable(this, "_on_mml_slot_index"));
-	_create_mml_event_listener("@rr", Callable(this, "_on_mml_operator_release_rate"));
-	_create_mml_event_listener("@tl", Callable(this, "_on_mml_operator_total_level"));
-	_create_mml_event_listener("@ml", Callable(this, "_on_mml_operator_multiple"));
-	_create_mml_event_listener("@dt", Callable(this, "_on_mml_operator_detune"));
-	_create_mml_event_listener("@ph", Callable(this, "_on_mml_operator_phase"));
-	_create_mml_event_listener("@fx", Callable(this, "_on_mml_operator_fixed_note"));
-	_create_mml_event_listener("@se", Callable(this, "_on_mml_operator_ssg_envelope"));
-	_create_mml_event_listener("@er", Callable(this, "_on_mml_operator_envelope_reset"));
-	_set_mml_event_listener(MMLEvent::MOD_PARAM, Callable(this, "_on_mml_operator_parameter"));
-	_create_mml_event_listener("s",   Callable(this, "_on_mml_sustain"));
+	_create_mml_event_handler("i",   &SiMMLSequencer::_on_mml_slot_index);
+	_create_mml_event_handler("@rr", &SiMMLSequencer::_on_mml_operator_release_rate);
+	_create_mml_event_handler("@tl", &SiMMLSequencer::_on_mml_operator_total_level);
+	_create_mml_event_handler("@ml", &SiMMLSequencer::_on_mml_operator_multiple);
+	_create_mml_event_handler("@dt", &SiMMLSequencer::_on_mml_operator_detune);
+	_create_mml_event_handler("@ph", &SiMMLSequencer::_on_mml_operator_phase);
+	_create_mml_event_handler("@fx", &SiMMLSequencer::_on_mml_operator_fixed_note);
+	_create_mml_event_handler("@se", &SiMMLSequencer::_on_mml_operator_ssg_envelope);
+	_create_mml_event_handler("@er", &SiMMLSequencer::_on_mml_operator_envelope_reset);
+	_set_mml_event_handler(MMLEvent::MOD_PARAM, &SiMMLSequencer::_on_mml_operator_parameter);
+	_create_mml_event_handler("s",   &SiMMLSequencer::_on_mml_sustain);
 
 	// Modulation.
-	_create_mml_event_listener("@lfo", Callable(this, "_on_mml_lf_oscillator"));
-	_create_mml_event_listener("mp", Callable(this, "_on_mml_pitch_modulation"));
-	_create_mml_event_listener("ma", Callable(this, "_on_mml_amplitude_modulation"));
+	_create_mml_event_handler("@lfo", &SiMMLSequencer::_on_mml_lf_oscillator);
+	_create_mml_event_handler("mp", &SiMMLSequencer::_on_mml_pitch_modulation);
+	_create_mml_event_handler("ma", &SiMMLSequencer::_on_mml_amplitude_modulation);
 
 	// Envelope.
-	_create_mml_event_listener("@fps", Callable(this, "_on_mml_envelope_fps"));
-	_envelope_event_id = _create_mml_event_listener("@@", Callable(this, "_on_mml_tone_envelope"));
-	_create_mml_event_listener("na", Callable(this, "_on_mml_amplitude_envelope"));
-	_create_mml_event_listener("np", Callable(this, "_on_mml_pitch_envelope"));
-	_create_mml_event_listener("nt", Callable(this, "_on_mml_note_envelope"));
-	_create_mml_event_listener("nf", Callable(this, "_on_mml_filter_envelope"));
-	_create_mml_event_listener("_@@", Callable(this, "_on_mml_tone_release_envelope"));
-	_create_mml_event_listener("_na", Callable(this, "_on_mml_amplitude_release_envelope"));
-	_create_mml_event_listener("_np", Callable(this, "_on_mml_pitch_release_envelope"));
-	_create_mml_event_listener("_nt", Callable(this, "_on_mml_note_release_envelope"));
-	_create_mml_event_listener("_nf", Callable(this, "_on_mml_filter_release_envelope"));
-	_create_mml_event_listener("!na", Callable(this, "_on_mml_amplitude_envelope_tsscp"));
-	_create_mml_event_listener("po",  Callable(this, "_on_mml_portament"));
+	_create_mml_event_handler("@fps", &SiMMLSequencer::_on_mml_envelope_fps);
+	_envelope_event_id = _create_mml_event_handler("@@", &SiMMLSequencer::_on_mml_tone_envelope);
+	_create_mml_event_handler("na", &SiMMLSequencer::_on_mml_amplitude_envelope);
+	_create_mml_event_handler("np", &SiMMLSequencer::_on_mml_pitch_envelope);
+	_create_mml_event_handler("nt", &SiMMLSequencer::_on_mml_note_envelope);
+	_create_mml_event_handler("nf", &SiMMLSequencer::_on_mml_filter_envelope);
+	_create_mml_event_handler("_@@", &SiMMLSequencer::_on_mml_tone_release_envelope);
+	_create_mml_event_handler("_na", &SiMMLSequencer::_on_mml_amplitude_release_envelope);
+	_create_mml_event_handler("_np", &SiMMLSequencer::_on_mml_pitch_release_envelope);
+	_create_mml_event_handler("_nt", &SiMMLSequencer::_on_mml_note_release_envelope);
+	_create_mml_event_handler("_nf", &SiMMLSequencer::_on_mml_filter_release_envelope);
+	_create_mml_event_handler("!na", &SiMMLSequencer::_on_mml_amplitude_envelope_tsscp);
+	_create_mml_event_handler("po",  &SiMMLSequencer::_on_mml_portament);
 
 	// These can be swapped for dummy processing.
 	_register_process_events();
 
-	_set_mml_event_listener(MMLEvent::DRIVER_NOTE, Callable(this, "_on_mml_driver_note_on"));
-	_set_mml_event_listener(MMLEvent::REGISTER,    Callable(this, "_on_mml_register_update"));
+	_set_mml_event_handler(MMLEvent::DRIVER_NOTE, &SiMMLSequencer::_on_mml_driver_note_on);
+	_set_mml_event_handler(MMLEvent::REGISTER,    &SiMMLSequencer::_on_mml_register_update);
 }
 
 void SiMMLSequencer::_reset_initial_operator_params() {
@@ -1764,69 +1778,6 @@ void SiMMLSequencer::_reset_parser_settings() {
 }
 
 void SiMMLSequencer::_bind_methods() {
-	// To be used as callables.
-
-	ClassDB::bind_method(D_METHOD("_on_mml_rest", "event"),                       &SiMMLSequencer::_on_mml_rest);
-	ClassDB::bind_method(D_METHOD("_on_mml_note", "event"),                       &SiMMLSequencer::_on_mml_note);
-	ClassDB::bind_method(D_METHOD("_on_mml_slur", "event"),                       &SiMMLSequencer::_on_mml_slur);
-	ClassDB::bind_method(D_METHOD("_on_mml_slur_weak", "event"),                  &SiMMLSequencer::_on_mml_slur_weak);
-	ClassDB::bind_method(D_METHOD("_on_mml_pitch_bend", "event"),                 &SiMMLSequencer::_on_mml_pitch_bend);
-	ClassDB::bind_method(D_METHOD("_on_mml_detune", "event"),                     &SiMMLSequencer::_on_mml_detune);
-	ClassDB::bind_method(D_METHOD("_on_mml_key_transition", "event"),             &SiMMLSequencer::_on_mml_key_transition);
-	ClassDB::bind_method(D_METHOD("_on_mml_relative_detune", "event"),            &SiMMLSequencer::_on_mml_relative_detune);
-	ClassDB::bind_method(D_METHOD("_on_mml_event_mask", "event"),                 &SiMMLSequencer::_on_mml_event_mask);
-	ClassDB::bind_method(D_METHOD("_on_mml_quant_ratio", "event"),                &SiMMLSequencer::_on_mml_quant_ratio);
-	ClassDB::bind_method(D_METHOD("_on_mml_quant_count", "event"),                &SiMMLSequencer::_on_mml_quant_count);
-	ClassDB::bind_method(D_METHOD("_on_mml_pan", "event"),                        &SiMMLSequencer::_on_mml_pan);
-	ClassDB::bind_method(D_METHOD("_on_mml_fine_pan", "event"),                   &SiMMLSequencer::_on_mml_fine_pan);
-	ClassDB::bind_method(D_METHOD("_on_mml_filter", "event"),                     &SiMMLSequencer::_on_mml_filter);
-	ClassDB::bind_method(D_METHOD("_on_mml_expression", "event"),                 &SiMMLSequencer::_on_mml_expression);
-	ClassDB::bind_method(D_METHOD("_on_mml_volume", "event"),                     &SiMMLSequencer::_on_mml_volume);
-	ClassDB::bind_method(D_METHOD("_on_mml_volume_shift", "event"),               &SiMMLSequencer::_on_mml_volume_shift);
-	ClassDB::bind_method(D_METHOD("_on_mml_master_volume", "event"),              &SiMMLSequencer::_on_mml_master_volume);
-	ClassDB::bind_method(D_METHOD("_on_mml_volume_setting", "event"),             &SiMMLSequencer::_on_mml_volume_setting);
-	ClassDB::bind_method(D_METHOD("_on_mml_expression_setting", "event"),         &SiMMLSequencer::_on_mml_expression_setting);
-	ClassDB::bind_method(D_METHOD("_on_mml_filter_mode", "event"),                &SiMMLSequencer::_on_mml_filter_mode);
-	ClassDB::bind_method(D_METHOD("_on_mml_clock", "event"),                      &SiMMLSequencer::_on_mml_clock);
-	ClassDB::bind_method(D_METHOD("_on_mml_algorithm", "event"),                  &SiMMLSequencer::_on_mml_algorithm);
-	ClassDB::bind_method(D_METHOD("_on_mml_feedback", "event"),                   &SiMMLSequencer::_on_mml_feedback);
-	ClassDB::bind_method(D_METHOD("_on_mml_ring_modulation", "event"),            &SiMMLSequencer::_on_mml_ring_modulation);
-	ClassDB::bind_method(D_METHOD("_on_mml_module_type", "event"),                &SiMMLSequencer::_on_mml_module_type);
-	ClassDB::bind_method(D_METHOD("_on_mml_input", "event"),                      &SiMMLSequencer::_on_mml_input);
-	ClassDB::bind_method(D_METHOD("_on_mml_output", "event"),                     &SiMMLSequencer::_on_mml_output);
-	ClassDB::bind_method(D_METHOD("_on_mml_event_trigger", "event"),              &SiMMLSequencer::_on_mml_event_trigger);
-	ClassDB::bind_method(D_METHOD("_on_mml_dispatch_event", "event"),             &SiMMLSequencer::_on_mml_dispatch_event);
-	ClassDB::bind_method(D_METHOD("_on_mml_slot_index", "event"),                 &SiMMLSequencer::_on_mml_slot_index);
-	ClassDB::bind_method(D_METHOD("_on_mml_operator_release_rate", "event"),      &SiMMLSequencer::_on_mml_operator_release_rate);
-	ClassDB::bind_method(D_METHOD("_on_mml_operator_total_level", "event"),       &SiMMLSequencer::_on_mml_operator_total_level);
-	ClassDB::bind_method(D_METHOD("_on_mml_operator_multiple", "event"),          &SiMMLSequencer::_on_mml_operator_multiple);
-	ClassDB::bind_method(D_METHOD("_on_mml_operator_detune", "event"),            &SiMMLSequencer::_on_mml_operator_detune);
-	ClassDB::bind_method(D_METHOD("_on_mml_operator_phase", "event"),             &SiMMLSequencer::_on_mml_operator_phase);
-	ClassDB::bind_method(D_METHOD("_on_mml_operator_fixed_note", "event"),        &SiMMLSequencer::_on_mml_operator_fixed_note);
-	ClassDB::bind_method(D_METHOD("_on_mml_operator_ssg_envelope", "event"),      &SiMMLSequencer::_on_mml_operator_ssg_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_operator_envelope_reset", "event"),    &SiMMLSequencer::_on_mml_operator_envelope_reset);
-	ClassDB::bind_method(D_METHOD("_on_mml_operator_parameter", "event"),         &SiMMLSequencer::_on_mml_operator_parameter);
-	ClassDB::bind_method(D_METHOD("_on_mml_sustain", "event"),                    &SiMMLSequencer::_on_mml_sustain);
-	ClassDB::bind_method(D_METHOD("_on_mml_lf_oscillator", "event"),              &SiMMLSequencer::_on_mml_lf_oscillator);
-	ClassDB::bind_method(D_METHOD("_on_mml_pitch_modulation", "event"),           &SiMMLSequencer::_on_mml_pitch_modulation);
-	ClassDB::bind_method(D_METHOD("_on_mml_amplitude_modulation", "event"),       &SiMMLSequencer::_on_mml_amplitude_modulation);
-	ClassDB::bind_method(D_METHOD("_on_mml_envelope_fps", "event"),               &SiMMLSequencer::_on_mml_envelope_fps);
-	ClassDB::bind_method(D_METHOD("_on_mml_tone_envelope", "event"),              &SiMMLSequencer::_on_mml_tone_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_amplitude_envelope", "event"),         &SiMMLSequencer::_on_mml_amplitude_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_pitch_envelope", "event"),             &SiMMLSequencer::_on_mml_pitch_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_note_envelope", "event"),              &SiMMLSequencer::_on_mml_note_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_filter_envelope", "event"),            &SiMMLSequencer::_on_mml_filter_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_tone_release_envelope", "event"),      &SiMMLSequencer::_on_mml_tone_release_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_amplitude_release_envelope", "event"), &SiMMLSequencer::_on_mml_amplitude_release_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_pitch_release_envelope", "event"),     &SiMMLSequencer::_on_mml_pitch_release_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_note_release_envelope", "event"),      &SiMMLSequencer::_on_mml_note_release_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_filter_release_envelope", "event"),    &SiMMLSequencer::_on_mml_filter_release_envelope);
-	ClassDB::bind_method(D_METHOD("_on_mml_amplitude_envelope_tsscp", "event"),   &SiMMLSequencer::_on_mml_amplitude_envelope_tsscp);
-	ClassDB::bind_method(D_METHOD("_on_mml_portament", "event"),                  &SiMMLSequencer::_on_mml_portament);
-	ClassDB::bind_method(D_METHOD("_on_mml_driver_note_on", "event"),             &SiMMLSequencer::_on_mml_driver_note_on);
-	ClassDB::bind_method(D_METHOD("_on_mml_register_update", "event"),            &SiMMLSequencer::_on_mml_register_update);
-
-	// To be used as callables.
 	ClassDB::bind_method(D_METHOD("get_tracks_array"), &SiMMLSequencer::get_tracks_array);
 }
 
@@ -1834,6 +1785,7 @@ SiMMLSequencer::SiMMLSequencer(SiOPMSoundChip *p_chip) :
 		MMLSequencer() {
 	_sound_chip = p_chip;
 	_connector = memnew(MMLExecutorConnector);
+	_fm_batch = memnew(SiOPMChannelFMBatch);
 
 	_macro_strings.resize_zeroed(MACRO_SIZE);
 
@@ -1846,6 +1798,7 @@ SiMMLSequencer::~SiMMLSequencer() {
 	_sound_chip = nullptr;
 
 	memdelete(_connector);
+	memdelete(_fm_batch);
 
 	_current_track = nullptr;
 
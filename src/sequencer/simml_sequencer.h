@@ -18,6 +18,7 @@ class MMLExecutorConnector;
 class MMLSequenceGroup;
 class SiMMLRefTable;
 class SiMMLTrack;
+class SiOPMChannelFMBatch;
 class SiOPMChannelParams;
 class SiOPMSoundChip;
 
@@ -32,6 +33,8 @@ class SiMMLSequencer : public MMLSequencer {
 
 	SiOPMSoundChip *_sound_chip = nullptr;
 	MMLExecutorConnector *_connector = nullptr;
+	// Collects the last block of each segment from FM tracks and renders them together.
+	SiOPMChannelFMBatch *_fm_batch = nullptr;
 
 	String _title;
 
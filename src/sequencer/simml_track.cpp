@@ -9,9 +9,11 @@
 #include <godot_cpp/core/class_db.hpp>
 #include "sion_enums.h"
 #include "chip/channels/siopm_channel_base.h"
+#include "chip/channels/siopm_channel_fm_batch.h"
 #include "chip/channels/siopm_channel_manager.h"
 #include "chip/channels/siopm_channel_stream.h"
 #include "chip/siopm_ref_table.h"
+#include "chip/siopm_sound_chip.h"
 #include "chip/wave/siopm_wave_sampler_table.h"
 #include "chip/wave/siopm_wave_table.h"
 #include "sequencer/base/mml_executor.h"
@@ -23,17 +25,7 @@
 #include "sequencer/simml_voice.h"
 #include "utils/godot_util.h"
 
-SinglyLinkedList<int> *SiMMLTrack::_envelope_zero_table = nullptr;
-
-void SiMMLTrack::initialize() {
-	_envelope_zero_table = memnew(SinglyLinkedList<int>(1, 0, true));
-}
-
-void SiMMLTrack::finalize() {
-	if (_envelope_zero_table) {
-		memdelete(_envelope_zero_table);
-	}
-}
+const int SiMMLTrack::_envelope_zero_values[1] = { 0 };
 
 // Properties and data.
 
@@ -49,6 +41,20 @@ MMLSequence *SiMMLTrack::set_channel_parameters(Vector<int> p_params) {
 	return sequence;
 }
 
+void SiMMLTrack::set_channel(SiOPMChannelBase *p_channel) {
+	_channel = p_channel;
+	if (_channel) {
+		_channel->set_ref_stencil(get_ref_stencil());
+	}
+}
+
+const SiOPMRefStencil *SiMMLTrack::get_ref_stencil() const {
+	if (_mml_data.is_valid()) {
+		return _mml_data->get_ref_stencil();
+	}
+	return nullptr;
+}
+
 int SiMMLTrack::get_track_id() const {
 	return _internal_track_id & TRACK_ID_FILTER;
 }
@@ -88,16 +94,16 @@ bool SiMMLTrack::is_finished() const {
 void SiMMLTrack::set_velocity_mode(int p_mode) {
 	_velocity_mode = (p_mode >= 0 && p_mode < SiOPMRefTable::VM_MAX) ? p_mode : SiOPMRefTable::VM_LINEAR;
 
-	int (&velocity_table)[SiOPMRefTable::TL_TABLE_SIZE] = SiOPMRefTable::get_instance()->eg_total_level_tables[_velocity_mode];
-	int (&expression_table)[SiOPMRefTable::TL_TABLE_SIZE] = SiOPMRefTable::get_instance()->eg_total_level_tables[_expression_mode];
+	const int (&velocity_table)[SiOPMRefTable::TL_TABLE_SIZE] = _table->eg_total_level_tables[_velocity_mode];
+	const int (&expression_table)[SiOPMRefTable::TL_TABLE_SIZE] = _table->eg_total_level_tables[_expression_mode];
 	_channel->set_volume_tables(velocity_table, expression_table);
 }
 
 void SiMMLTrack::set_expression_mode(int p_mode) {
 	_expression_mode = (p_mode >= 0 && p_mode < SiOPMRefTable::VM_MAX) ? p_mode : SiOPMRefTable::VM_LINEAR;
 
-	int (&velocity_table)[SiOPMRefTable::TL_TABLE_SIZE] = SiOPMRefTable::get_instance()->eg_total_level_tables[_velocity_mode];
-	int (&expression_table)[SiOPMRefTable::TL_TABLE_SIZE] = SiOPMRefTable::get_instance()->eg_total_level_tables[_expression_mode];
+	const int (&velocity_table)[SiOPMRefTable::TL_TABLE_SIZE] = _table->eg_total_level_tables[_velocity_mode];
+	const int (&expression_table)[SiOPMRefTable::TL_TABLE_SIZE] = _table->eg_total_level_tables[_expression_mode];
 	_channel->set_volume_tables(velocity_table, expression_table);
 }
 
@@ -240,15 +246,13 @@ void SiMMLTrack::set_pan(int p_value) {
 
 // Envelopes.
 
-SinglyLinkedList<int> *SiMMLTrack::_make_modulation_table(int p_depth, int p_end_depth, int p_delay, int p_term) {
-	SinglyLinkedList<int> *list = memnew(SinglyLinkedList<int>(p_delay + p_term + 1));
+void SiMMLTrack::_make_modulation_table(std::vector<int> &r_table, int p_depth, int p_end_depth, int p_delay, int p_term) {
+	// Resizing within the reserved capacity doesn't allocate.
+	r_table.resize(p_delay + p_term + 1);
 
-	SinglyLinkedList<int>::Element *element = list->front();
-	if (p_delay != 0) {
-		for (int i = 0; i < p_delay; i++) {
-			element->value = p_depth;
-			element = element->next();
-		}
+	int index = 0;
+	for (int i = 0; i < p_delay; i++) {
+		r_table[index++] = p_depth;
 	}
 
 	if (p_term != 0) {
@@ -256,15 +260,12 @@ SinglyLinkedList<int> *SiMMLTrack::_make_modulation_table(int p_depth, int p_end
 		int step = ((p_end_depth << FIXED_BITS) - depth) / p_term;
 
 		for (int i = 0; i < p_term; i++) {
-			element->value = depth >> FIXED_BITS;
+			r_table[index++] = depth >> FIXED_BITS;
 			depth += step;
-			element = element->next();
 		}
 	}
 
-	element->value = p_end_depth;
-
-	return list;
+	r_table[index] = p_end_depth;
 }
 
 void SiMMLTrack::set_portament(int p_frame) {
@@ -280,7 +281,7 @@ void SiMMLTrack::set_portament(int p_frame) {
 
 void SiMMLTrack::set_envelope_fps(int p_fps) {
 	int fps = MAX(p_fps, 1);
-	_envelope_interval = MAX(1, SiOPMRefTable::get_instance()->sampling_rate / fps);
+	_envelope_interval = MAX(1, _table->sampling_rate / fps);
 }
 
 void SiMMLTrack::set_release_sweep(int p_sweep) {
@@ -296,23 +297,24 @@ void SiMMLTrack::set_release_sweep(int p_sweep) {
 }
 
 void SiMMLTrack::set_modulation_envelope(bool p_is_pitch_mod, int p_depth, int p_end_depth, int p_delay, int p_term) {
-	Vector<SinglyLinkedList<int> *> *table = (p_is_pitch_mod ? &_table_envelope_mod_pitch : &_table_envelope_mod_amp);
+	std::vector<int> &table = (p_is_pitch_mod ? _table_envelope_mod_pitch : _table_envelope_mod_amp);
+	SiMMLEnvelopeTable::Cursor &setting = (p_is_pitch_mod ? _setting_envelope_mod_pitch[1] : _setting_envelope_mod_amp[1]);
+	SiMMLEnvelopeTable::Cursor &active = (p_is_pitch_mod ? _envelope_mod_pitch : _envelope_mod_amp);
 
-	// Free previous table.
-	SinglyLinkedList<int> *old_table = table->get(1);
-	if (old_table) {
-		memdelete(old_table);
-	}
+	// The table is rebuilt in place. A modulation playing from it right now carries on
+	// from the same step of the new one.
+	bool was_playing = active.is_active() && active.refers_to(table.data());
+	int playing_position = active.position;
+	setting = SiMMLEnvelopeTable::Cursor();
 
 	if (p_depth != p_end_depth) {
 		if (p_term > 0) {
 			// Create ramp envelope from depth to end_depth over term steps.
-			table->set(1, _make_modulation_table(p_depth, p_end_depth, p_delay, p_term));
+			_make_modulation_table(table, p_depth, p_end_depth, p_delay, p_term);
+			setting = SiMMLEnvelopeTable::Cursor(table.data(), (int)table.size(), -1);
 			_enable_envelope_mode(1);
 		} else {
 			// term=0 means instant jump to end_depth.
-			table->set(1, nullptr);
-
 			if (p_is_pitch_mod) {
 				_channel->set_pitch_modulation(p_end_depth);
 			} else {
@@ -323,8 +325,6 @@ void SiMMLTrack::set_modulation_envelope(bool p_is_pitch_mod, int p_depth, int p
 		}
 	} else {
 		// depth == end_depth, just set static modulation.
-		table->set(1, nullptr);
-
 		if (p_is_pitch_mod) {
 			_channel->set_pitch_modulation(p_depth);
 		} else {
@@ -333,14 +333,21 @@ void SiMMLTrack::set_modulation_envelope(bool p_is_pitch_mod, int p_depth, int p
 
 		_disable_envelope_mode(1);
 	}
+
+	if (was_playing) {
+		active = setting;
+		if (active.is_active()) {
+			active.position = (playing_position < active.length ? playing_position : -1);
+		}
+	}
 }
 
 void SiMMLTrack::set_tone_envelope(int p_note_on, const Ref<SiMMLEnvelopeTable> &p_table, int p_step) {
 	if (p_table.is_null() || p_step == 0) {
-		_setting_envelope_voice.write[p_note_on] = nullptr;
+		_setting_envelope_voice[p_note_on] = SiMMLEnvelopeTable::Cursor();
 		_disable_envelope_mode(p_note_on);
 	} else {
-		_setting_envelope_voice.write[p_note_on] = p_table->get_head();
+		_setting_envelope_voice[p_note_on] = p_table->get_cursor();
 		_setting_counter_voice[p_note_on] = p_step;
 		_enable_envelope_mode(p_note_on);
 	}
@@ -348,10 +355,10 @@ void SiMMLTrack::set_tone_envelope(int p_note_on, const Ref<SiMMLEnvelopeTable>
 
 void SiMMLTrack::set_amplitude_envelope(int p_note_on, const Ref<SiMMLEnvelopeTable> &p_table, int p_step, bool p_offset) {
 	if (p_table.is_null() || p_step == 0) {
-		_setting_envelope_exp.write[p_note_on] = nullptr;
+		_setting_envelope_exp[p_note_on] = SiMMLEnvelopeTable::Cursor();
 		_disable_envelope_mode(p_note_on);
 	} else {
-		_setting_envelope_exp.write[p_note_on] = p_table->get_head();
+		_setting_envelope_exp[p_note_on] = p_table->get_cursor();
 		_setting_counter_exp[p_note_on] = p_step;
 		_setting_exp_offset[p_note_on] = p_offset;
 		_enable_envelope_mode(p_note_on);
@@ -360,10 +367,10 @@ void SiMMLTrack::set_amplitude_envelope(int p_note_on, const Ref<SiMMLEnvelopeTa
 
 void SiMMLTrack::set_filter_envelope(int p_note_on, const Ref<SiMMLEnvelopeTable> &p_table, int p_step) {
 	if (p_table.is_null() || p_step == 0) {
-		_setting_envelope_filter.write[p_note_on] = nullptr;
+		_setting_envelope_filter[p_note_on] = SiMMLEnvelopeTable::Cursor();
 		_disable_envelope_mode(p_note_on);
 	} else {
-		_setting_envelope_filter.write[p_note_on] = p_table->get_head();
+		_setting_envelope_filter[p_note_on] = p_table->get_cursor();
 		_setting_counter_filter[p_note_on] = p_step;
 		_enable_envelope_mode(p_note_on);
 	}
@@ -371,10 +378,10 @@ void SiMMLTrack::set_filter_envelope(int p_note_on, const Ref<SiMMLEnvelopeTable
 
 void SiMMLTrack::set_pitch_envelope(int p_note_on, const Ref<SiMMLEnvelopeTable> &p_table, int p_step) {
 	if (p_table.is_null() || p_step == 0) {
-		_setting_envelope_pitch.write[p_note_on] = _envelope_zero_table->get_front();
+		_setting_envelope_pitch[p_note_on] = _get_zero_envelope();
 		_disable_envelope_mode(p_note_on);
 	} else {
-		_setting_envelope_pitch.write[p_note_on] = p_table->get_head();
+		_setting_envelope_pitch[p_note_on] = p_table->get_cursor();
 		_setting_counter_pitch[p_note_on] = p_step;
 		_setting_pns_or[p_note_on] = true;
 		_enable_envelope_mode(p_note_on);
@@ -383,10 +390,10 @@ void SiMMLTrack::set_pitch_envelope(int p_note_on, const Ref<SiMMLEnvelopeTable>
 
 void SiMMLTrack::set_note_envelope(int p_note_on, const Ref<SiMMLEnvelopeTable> &p_table, int p_step) {
 	if (p_table.is_null() || p_step == 0) {
-		_setting_envelope_note.write[p_note_on] = _envelope_zero_table->get_front();
+		_setting_envelope_note[p_note_on] = _get_zero_envelope();
 		_disable_envelope_mode(p_note_on);
 	} else {
-		_setting_envelope_note.write[p_note_on] = p_table->get_head();
+		_setting_envelope_note[p_note_on] = p_table->get_cursor();
 		_setting_counter_note[p_note_on] = p_step;
 		_setting_pns_or[p_note_on] = true;
 		_enable_envelope_mode(p_note_on);
@@ -490,7 +497,7 @@ void SiMMLTrack::set_note_envelope_binding(int p_note_on, const StringName &p_si
 	}
 
 	binding->sink = sink;
-	binding->table[phase] = p_table; // Strong ref keeps the list-element data alive.
+	binding->table[phase] = p_table; // Strong ref keeps the table data alive.
 	_set_note_envelope_sink_phase(sink, phase, p_table, p_step);
 }
 
@@ -642,18 +649,18 @@ void SiMMLTrack::_enable_envelope_mode(int p_note_on) {
 void SiMMLTrack::_disable_envelope_mode(int p_note_on) {
 	// Update pitch, note, sweep.
 	if (_setting_sweep_step[p_note_on] == 0 &&
-			_setting_envelope_pitch[p_note_on] == _envelope_zero_table->get_front() &&
-			_setting_envelope_note[p_note_on] == _envelope_zero_table->get_front()) {
+			_is_zero_envelope(_setting_envelope_pitch[p_note_on]) &&
+			_is_zero_envelope(_setting_envelope_note[p_note_on])) {
 		_setting_pns_or[p_note_on] = false;
 	}
 
 	// When all envelopes are off, update the process mode.
 	if (!_setting_pns_or[p_note_on] &&
-			!_table_envelope_mod_amp[p_note_on] &&
-			!_table_envelope_mod_pitch[p_note_on] &&
-			!_setting_envelope_exp[p_note_on] &&
-			!_setting_envelope_filter[p_note_on] &&
-			!_setting_envelope_voice[p_note_on]) {
+			!_setting_envelope_mod_amp[p_note_on].is_active() &&
+			!_setting_envelope_mod_pitch[p_note_on].is_active() &&
+			!_setting_envelope_exp[p_note_on].is_active() &&
+			!_setting_envelope_filter[p_note_on].is_active() &&
+			!_setting_envelope_voice[p_note_on].is_active()) {
 		_setting_process_mode[p_note_on] = ProcessMode::NORMAL;
 	}
 }
@@ -664,12 +671,6 @@ int SiMMLTrack::prepare_buffer(int p_buffer_length) {
 		return 0;
 	}
 	
-	if (_mml_data.is_valid()) {
-		_mml_data->register_ref_stencils();
-	} else {
-		SiMMLData::clear_ref_stencils();
-	}
-
 	// No delay.
 	if (_track_start_delay == 0) {
 		return p_buffer_length;
@@ -709,36 +710,36 @@ void SiMMLTrack::_process_envelope_tick() {
 	}
 
 	// Update expression.
-	if (_envelope_exp && _counter_exp == 0) {
-		int expression = CLAMP(_envelope_exp_offset + _envelope_exp->value, 0, 128);
+	if (_envelope_exp.is_active() && _counter_exp == 0) {
+		int expression = CLAMP(_envelope_exp_offset + _envelope_exp.get_value(), 0, 128);
 		_channel->offset_volume(expression, _velocity);
 
-		_envelope_exp = _envelope_exp->next();
+		_envelope_exp.advance();
 		_counter_exp = _max_counter_exp;
 	}
 
 	// Update pitch/note.
 	if (_envelope_pitch_active) {
-		// Safely read current envelope values; if either pointer is null the envelope has finished.
-		int pitch_env_val = _envelope_pitch ? _envelope_pitch->value : 0;
-		int note_env_val  = _envelope_note  ? _envelope_note->value  : 0;
+		// Safely read current envelope values; if either cursor is inactive the envelope has finished.
+		int pitch_env_val = _envelope_pitch.is_active() ? _envelope_pitch.get_value() : 0;
+		int note_env_val  = _envelope_note.is_active()  ? _envelope_note.get_value()  : 0;
 
 		_channel->set_pitch(pitch_env_val + (note_env_val << 6) + (_sweep_pitch >> FIXED_BITS));
 
 		// Advance pitch envelope.
-		if (_counter_pitch == 0 && _envelope_pitch) {
-			_envelope_pitch = _envelope_pitch->next();
+		if (_counter_pitch == 0 && _envelope_pitch.is_active()) {
+			_envelope_pitch.advance();
 			_counter_pitch = _max_counter_pitch;
 		}
 
 		// Advance note envelope.
-		if (_counter_note == 0 && _envelope_note) {
-			_envelope_note = _envelope_note->next();
+		if (_counter_note == 0 && _envelope_note.is_active()) {
+			_envelope_note.advance();
 			_counter_note = _max_counter_note;
 		}
 
-		// If either envelope reached the end, deactivate pitch-envelope processing to avoid nullptr deref.
-		if (!_envelope_pitch || !_envelope_note) {
+		// If either envelope reached the end, deactivate pitch-envelope processing.
+		if (!_envelope_pitch.is_active() || !_envelope_note.is_active()) {
 			_envelope_pitch_active = false;
 		}
 
@@ -753,33 +754,29 @@ void SiMMLTrack::_process_envelope_tick() {
 	}
 
 	// Update filter.
-	if (_envelope_filter && _counter_filter == 0) {
-		_channel->offset_filter(_envelope_filter->value);
+	if (_envelope_filter.is_active() && _counter_filter == 0) {
+		_channel->offset_filter(_envelope_filter.get_value());
 
-		_envelope_filter = _envelope_filter->next();
+		_envelope_filter.advance();
 		_counter_filter = _max_counter_filter;
 	}
 
 	// Update tone.
-	if (_envelope_voice && _counter_voice == 0) {
-		_channel_settings->select_tone(this, _envelope_voice->value);
+	if (_envelope_voice.is_active() && _counter_voice == 0) {
+		_channel_settings->select_tone(this, _envelope_voice.get_value());
 
-		_envelope_voice = _envelope_voice->next();
+		_envelope_voice.advance();
 		_counter_voice = _max_counter_voice;
 	}
 
 	// Update modulations.
-	if (_envelope_mod_amp && _envelope_mod_amp->get()) {
-		_channel->set_amplitude_modulation(_envelope_mod_amp->get()->value);
-		_envelope_mod_amp->next();
-	} else {
-		_envelope_mod_amp = nullptr;
+	if (_envelope_mod_amp.is_active()) {
+		_channel->set_amplitude_modulation(_envelope_mod_amp.get_value());
+		_envelope_mod_amp.advance();
 	}
-	if (_envelope_mod_pitch && _envelope_mod_pitch->get()) {
-		_channel->set_pitch_modulation(_envelope_mod_pitch->get()->value);
-		_envelope_mod_pitch->next();
-	} else {
-		_envelope_mod_pitch = nullptr;
+	if (_envelope_mod_pitch.is_active()) {
+		_channel->set_pitch_modulation(_envelope_mod_pitch.get_value());
+		_envelope_mod_pitch.advance();
 	}
 
 }
@@ -893,6 +890,27 @@ void SiMMLTrack::buffer(int p_length) {
 	}
 }
 
+bool SiMMLTrack::buffer_deferred(int p_length, SiOPMChannelFMBatch *p_batch) {
+	if (_channel == nullptr || _process_mode != ProcessMode::NORMAL) {
+		return false;
+	}
+	// Key toggles and stops split the block; those go through buffer().
+	if ((_key_on_counter != 0 && _key_on_counter <= p_length) || (_track_stop_delay > 0 && _track_stop_delay <= p_length)) {
+		return false;
+	}
+	if (!p_batch->defer(_channel, p_length)) {
+		return false;
+	}
+
+	if (_key_on_counter != 0) {
+		_key_on_counter -= p_length;
+	}
+	if (_track_stop_delay > 0) {
+		_track_stop_delay -= p_length;
+	}
+	return true;
+}
+
 void SiMMLTrack::_toggle_key() {
 	// The channel can be reclaimed by the voice manager when we run out of
 	// voices. In that case the track stays around but has nothing to render
@@ -1040,15 +1058,8 @@ void SiMMLTrack::_update_process(int p_key_on) {
 	_counter_filter = _max_counter_filter;
 
 	// Set modulation envelopes.
-	// The cursor reset matches the original behavior, but maybe it's unnecessary.
-	_envelope_mod_amp   = _table_envelope_mod_amp[p_key_on];
-	if (_envelope_mod_amp) {
-		_envelope_mod_amp->front();
-	}
-	_envelope_mod_pitch = _table_envelope_mod_pitch[p_key_on];
-	if (_envelope_mod_pitch) {
-		_envelope_mod_pitch->front();
-	}
+	_envelope_mod_amp   = _setting_envelope_mod_amp[p_key_on];
+	_envelope_mod_pitch = _setting_envelope_mod_pitch[p_key_on];
 
 	// Set sweep.
 	_sweep_step = (p_key_on == 1 ? 0 : _setting_sweep_step[p_key_on]);
@@ -1061,7 +1072,7 @@ void SiMMLTrack::_update_process(int p_key_on) {
 
 	// Activate filter.
 	if (!_channel->is_filter_active()) {
-		_channel->activate_filter(_envelope_filter != nullptr);
+		_channel->activate_filter(_envelope_filter.is_active());
 	}
 
 	// Reset index.
@@ -1152,6 +1163,9 @@ void SiMMLTrack::sequence_on(const Ref<SiMMLData> &p_data, MMLSequence *p_sequen
 	ERR_FAIL_NULL(p_sequence);
 
 	_mml_data = p_data;
+	if (_channel) {
+		_channel->set_ref_stencil(get_ref_stencil());
+	}
 	_track_start_delay = p_sample_delay;
 	_track_stop_delay = p_sample_length;
 
@@ -1220,13 +1234,13 @@ void SiMMLTrack::reset(int p_buffer_index) {
 	_note = -1;
 
 	if (_channel) {
-		SiOPMChannelManager::delete_channel(_channel);
+		_sound_chip->get_channel_manager()->delete_channel(_channel);
 		_channel = nullptr;
 	}
 	_voice_index = _channel_settings->initialize_tone(this, INT32_MIN, p_buffer_index); // This sets the channel.
 
-	int (&velocity_table)[SiOPMRefTable::TL_TABLE_SIZE] = SiOPMRefTable::get_instance()->eg_total_level_tables[_velocity_mode];
-	int (&expression_table)[SiOPMRefTable::TL_TABLE_SIZE] = SiOPMRefTable::get_instance()->eg_total_level_tables[_expression_mode];
+	const int (&velocity_table)[SiOPMRefTable::TL_TABLE_SIZE] = _table->eg_total_level_tables[_velocity_mode];
+	const int (&expression_table)[SiOPMRefTable::TL_TABLE_SIZE] = _table->eg_total_level_tables[_expression_mode];
 	_channel->set_volume_tables(velocity_table, expression_table);
 
 	// Initialize parameters.
@@ -1262,23 +1276,23 @@ void SiMMLTrack::reset(int p_buffer_index) {
 
 	_residue = 0;
 
-	_envelope_exp = nullptr;
-	_envelope_voice = nullptr;
-	_envelope_note = _envelope_zero_table->get_front();
-	_envelope_pitch = _envelope_zero_table->get_front();
-	_envelope_filter = nullptr;
-	_envelope_mod_amp = nullptr;
-	_envelope_mod_pitch = nullptr;
+	_envelope_exp = SiMMLEnvelopeTable::Cursor();
+	_envelope_voice = SiMMLEnvelopeTable::Cursor();
+	_envelope_note = _get_zero_envelope();
+	_envelope_pitch = _get_zero_envelope();
+	_envelope_filter = SiMMLEnvelopeTable::Cursor();
+	_envelope_mod_amp = SiMMLEnvelopeTable::Cursor();
+	_envelope_mod_pitch = SiMMLEnvelopeTable::Cursor();
 
 	// Reset envelope tables.
 	for (int i = 0; i < 2; i++) {
 		_setting_process_mode[i] = NORMAL;
 
-		_setting_envelope_exp.write[i]    = nullptr;
-		_setting_envelope_voice.write[i]  = nullptr;
-		_setting_envelope_note.write[i]   = _envelope_zero_table->get_front();
-		_setting_envelope_pitch.write[i]  = _envelope_zero_table->get_front();
-		_setting_envelope_filter.write[i] = nullptr;
+		_setting_envelope_exp[i]    = SiMMLEnvelopeTable::Cursor();
+		_setting_envelope_voice[i]  = SiMMLEnvelopeTable::Cursor();
+		_setting_envelope_note[i]   = _get_zero_envelope();
+		_setting_envelope_pitch[i]  = _get_zero_envelope();
+		_setting_envelope_filter[i] = SiMMLEnvelopeTable::Cursor();
 
 		_setting_pns_or[i]     = false;
 		_setting_exp_offset[i] = false;
@@ -1292,8 +1306,8 @@ void SiMMLTrack::reset(int p_buffer_index) {
 		_setting_sweep_step[i] = 0;
 		_setting_sweep_end[i]  = 0;
 
-		_table_envelope_mod_amp.write[i] = nullptr;
-		_table_envelope_mod_pitch.write[i] = nullptr;
+		_setting_envelope_mod_amp[i] = SiMMLEnvelopeTable::Cursor();
+		_setting_envelope_mod_pitch[i] = SiMMLEnvelopeTable::Cursor();
 	}
 
 	// Clear generic note-envelope bindings. Track reset must release the strong
@@ -1307,6 +1321,9 @@ void SiMMLTrack::reset(int p_buffer_index) {
 
 void SiMMLTrack::initialize(const Ref<SiMMLData> &p_data, MMLSequence *p_sequence, int p_fps, int p_internal_track_id, const Callable &p_event_trigger_on, const Callable &p_event_trigger_off, bool p_disposable) {
 	_mml_data = p_data;
+	if (_channel) {
+		_channel->set_ref_stencil(get_ref_stencil());
+	}
 
 	_default_fps = p_fps;
 	_internal_track_id = p_internal_track_id;
@@ -1377,17 +1394,13 @@ void SiMMLTrack::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_mute", "value"), &SiMMLTrack::set_mute);
 }
 
-SiMMLTrack::SiMMLTrack() {
+SiMMLTrack::SiMMLTrack(SiOPMSoundChip *p_chip) {
+	_sound_chip = p_chip;
+	_table = p_chip ? p_chip->get_ref_table() : SiOPMRefTable::get_instance();
 	_executor = memnew(MMLExecutor);
 
-	_setting_envelope_exp.resize_zeroed(2);
-	_setting_envelope_voice.resize_zeroed(2);
-	_setting_envelope_note.resize_zeroed(2);
-	_setting_envelope_pitch.resize_zeroed(2);
-	_setting_envelope_filter.resize_zeroed(2);
-
-	_table_envelope_mod_amp.resize_zeroed(2);
-	_table_envelope_mod_pitch.resize_zeroed(2);
+	_table_envelope_mod_amp.reserve(MODULATION_TABLE_RESERVE);
+	_table_envelope_mod_pitch.reserve(MODULATION_TABLE_RESERVE);
 }
 
 SiMMLTrack::~SiMMLTrack() {
@@ -12,12 +12,12 @@
 #include <godot_cpp/variant/string_name.hpp>
 #include <godot_cpp/templates/vector.hpp>
 #include <cstdint>
+#include <vector>
 #include "sion_enums.h"
 #include "sequencer/base/beats_per_minute.h"
 #include "sequencer/simml_data.h"
 #include "sequencer/simml_envelope_table.h"
 #include "sequencer/simml_ref_table.h"
-#include "templates/singly_linked_list.h"
 
 using namespace godot;
 
@@ -25,6 +25,9 @@ class MMLExecutor;
 class MMLSequence;
 class SiMMLChannelSettings;
 class SiOPMChannelBase;
+class SiOPMChannelFMBatch;
+class SiOPMRefTable;
+class SiOPMSoundChip;
 
 class SiMMLTrack : public Object {
 	GDCLASS(SiMMLTrack, Object)
@@ -61,10 +64,20 @@ private:
 	static const int FIXED_BITS = 16;
 	static const int SWEEP_MAX = 8192 << FIXED_BITS;
 
-	static SinglyLinkedList<int> *_envelope_zero_table;
+	// Holds the pitch and note envelopes at zero when no table is set.
+	static const int _envelope_zero_values[1];
+	static SiMMLEnvelopeTable::Cursor _get_zero_envelope() { return SiMMLEnvelopeTable::Cursor(_envelope_zero_values, 1, 0); }
+	static bool _is_zero_envelope(const SiMMLEnvelopeTable::Cursor &p_cursor) { return p_cursor.refers_to(_envelope_zero_values); }
+
+	// Capacity reserved for each modulation table up front, so typical delay and term
+	// lengths never allocate when a modulation command runs.
+	static const int MODULATION_TABLE_RESERVE = 256;
 
 	// Properties and data.
 
+	// Sound chip of the driver running this track, and its reference tables.
+	SiOPMSoundChip *_sound_chip = nullptr;
+	SiOPMRefTable *_table = nullptr;
 	// Sound module's channel controlled by this track.
 	SiOPMChannelBase *_channel = nullptr;
 	MMLExecutor *_executor = nullptr;
@@ -115,6 +128,8 @@ private:
 	bool _pending_disposal = false;
 	// Priority number to overwrite when tracks overflow.
 	int _priority = 0;
+	// Order in which the driver handed this track out for a note, for voice stealing.
+	uint64_t _allocation_order = 0;
 	int _default_fps = 0;
 
 	int _velocity_mode = 0;
@@ -137,12 +152,13 @@ private:
 
 	int _setting_process_mode[2] = {};
 
-	// Keeping element pointers because this references external data, so we want to have our own iterators.
-	Vector<SinglyLinkedList<int>::Element *> _setting_envelope_exp;
-	Vector<SinglyLinkedList<int>::Element *> _setting_envelope_voice;
-	Vector<SinglyLinkedList<int>::Element *> _setting_envelope_note;
-	Vector<SinglyLinkedList<int>::Element *> _setting_envelope_pitch;
-	Vector<SinglyLinkedList<int>::Element *> _setting_envelope_filter;
+	// Cursors at the start of each envelope table, for note-off (0) and note-on (1).
+	// The tables are external data; copying a cursor gives us our own position in them.
+	SiMMLEnvelopeTable::Cursor _setting_envelope_exp[2];
+	SiMMLEnvelopeTable::Cursor _setting_envelope_voice[2];
+	SiMMLEnvelopeTable::Cursor _setting_envelope_note[2];
+	SiMMLEnvelopeTable::Cursor _setting_envelope_pitch[2];
+	SiMMLEnvelopeTable::Cursor _setting_envelope_filter[2];
 
 	bool _setting_exp_offset[2] = {};
 	// PNS (pitch, note, sweep)
@@ -154,20 +170,22 @@ private:
 	int _setting_counter_pitch[2] = {};
 	int _setting_counter_filter[2] = {};
 
-	Vector<SinglyLinkedList<int> *> _table_envelope_mod_amp;
-	Vector<SinglyLinkedList<int> *> _table_envelope_mod_pitch;
+	// Modulation tables are owned by the track and rebuilt in place.
+	std::vector<int> _table_envelope_mod_amp;
+	std::vector<int> _table_envelope_mod_pitch;
+	SiMMLEnvelopeTable::Cursor _setting_envelope_mod_amp[2];
+	SiMMLEnvelopeTable::Cursor _setting_envelope_mod_pitch[2];
 	int _setting_sweep_step[2] = {};
 	int _setting_sweep_end[2] = {};
 	int _envelope_interval = 0;
 
 	// Envelopes.
 
-	// Keeping element pointers because this references external data, so we want to have our own iterators.
-	SinglyLinkedList<int>::Element *_envelope_exp = nullptr;
-	SinglyLinkedList<int>::Element *_envelope_voice = nullptr;
-	SinglyLinkedList<int>::Element *_envelope_note = nullptr;
-	SinglyLinkedList<int>::Element *_envelope_pitch = nullptr;
-	SinglyLinkedList<int>::Element *_envelope_filter = nullptr;
+	SiMMLEnvelopeTable::Cursor _envelope_exp;
+	SiMMLEnvelopeTable::Cursor _envelope_voice;
+	SiMMLEnvelopeTable::Cursor _envelope_note;
+	SiMMLEnvelopeTable::Cursor _envelope_pitch;
+	SiMMLEnvelopeTable::Cursor _envelope_filter;
 
 	int _counter_exp = 0;
 	int _max_counter_exp = 0;
@@ -180,8 +198,8 @@ private:
 	int _counter_filter = 0;
 	int _max_counter_filter = 0;
 
-	SinglyLinkedList<int> *_envelope_mod_amp = nullptr;
-	SinglyLinkedList<int> *_envelope_mod_pitch = nullptr;
+	SiMMLEnvelopeTable::Cursor _envelope_mod_amp;
+	SiMMLEnvelopeTable::Cursor _envelope_mod_pitch;
 	int _sweep_step = 0;
 	int _sweep_end = 0;
 	int _sweep_pitch = 0;
@@ -220,7 +238,7 @@ private:
 	void _set_note_envelope_sink_phase(NoteEnvelopeSink p_sink, int p_phase, const Ref<SiMMLEnvelopeTable> &p_table, int p_step);
 	void _clear_note_envelope_sink_phase(NoteEnvelopeSink p_sink, int p_phase);
 
-	SinglyLinkedList<int> *_make_modulation_table(int p_depth, int p_end_depth, int p_delay, int p_term);
+	void _make_modulation_table(std::vector<int> &r_table, int p_depth, int p_end_depth, int p_delay, int p_term);
 
 	// Events.
 
@@ -292,13 +310,11 @@ public:
 		USER_CONTROLLED   = 0x60000, // User controlled tracks
 	};
 
-	static void initialize();
-	static void finalize();
-
 	// Properties and data.
 
+	SiOPMSoundChip *get_sound_chip() const { return _sound_chip; }
 	SiOPMChannelBase *get_channel() const { return _channel; }
-	void set_channel(SiOPMChannelBase *p_channel) { _channel = p_channel; }
+	void set_channel(SiOPMChannelBase *p_channel);
 	MMLExecutor *get_executor() const { return _executor; }
 	MMLSequence *set_channel_parameters(Vector<int> p_params);
 
@@ -311,6 +327,8 @@ public:
 
 	// This value only is available in the track playing an MML sequence.
 	Ref<SiMMLData> get_mml_data() const { return _mml_data; }
+	// Lookup context for tables and voices defined by the played data; null if there is none.
+	const SiOPMRefStencil *get_ref_stencil() const;
 	Ref<BeatsPerMinute> get_bpm_settings() const;
 
 	// Channel number, set by 2nd argument of % command. Usually same as voice index / program number (except for APU).
@@ -334,6 +352,8 @@ public:
 	int get_track_stop_delay() const { return _track_stop_delay; }
 
 	int get_priority() const;
+	uint64_t get_allocation_order() const { return _allocation_order; }
+	void set_allocation_order(uint64_t p_order) { _allocation_order = p_order; }
 
 	// This function always returns true from not-disposable track.
 	bool is_active() const;
@@ -476,6 +496,9 @@ public:
 
 	int prepare_buffer(int p_buffer_length);
 	void buffer(int p_length);
+	// Hand a block that needs no key or stop handling over to p_batch instead of rendering
+	// it now. Returns false, leaving the track untouched, if the block must be buffered.
+	bool buffer_deferred(int p_length, SiOPMChannelFMBatch *p_batch);
 
 	void key_on(int p_note, int p_tick_length = 0, int p_sample_delay = 0);
 	void key_off(int p_sample_delay = 0, bool p_with_reset = false);
@@ -503,7 +526,7 @@ public:
 	void reset(int p_buffer_index);
 	void initialize(const Ref<SiMMLData> &p_data, MMLSequence *p_sequence, int p_fps, int p_internal_track_id, const Callable &p_event_trigger_on, const Callable &p_event_trigger_off, bool p_disposable);
 
-	SiMMLTrack();
+	SiMMLTrack(SiOPMSoundChip *p_chip = nullptr);
 	~SiMMLTrack();
 };
 
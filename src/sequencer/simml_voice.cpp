@@ -95,12 +95,20 @@ void SiMMLVoice::update_track_voice(SiMMLTrack *p_track) {
 
 	switch (module_type) {
 		case SiONModuleType::MODULE_FM: {
-			// Check if already an FM channel
-			SiOPMChannelFM *fm_ch = existing_ch ? dynamic_cast<SiOPMChannelFM *>(existing_ch) : nullptr;
-			if (!fm_ch) {
+			// Check if already an FM channel (KS channels are FM channels too). The channel type
+			// is enough to tell, no need for a dynamic_cast on every note.
+			const SiOPMChannelManager::ChannelType channel_type = existing_ch ? existing_ch->get_channel_type() : SiOPMChannelManager::CHANNEL_MAX;
+			if (channel_type != SiOPMChannelManager::CHANNEL_FM && channel_type != SiOPMChannelManager::CHANNEL_KS) {
 				p_track->set_channel_module_type(SiONModuleType::MODULE_FM, channel_num);
 			}
-			p_track->get_channel()->set_channel_params(channel_params, update_volumes, true);
+
+			SiOPMChannelBase *channel = p_track->get_channel();
+			if (channel->get_channel_type() == SiOPMChannelManager::CHANNEL_FM) {
+				// Plain FM channels take the compiled program directly.
+				static_cast<SiOPMChannelFM *>(channel)->set_channel_program(channel_params->get_program(), update_volumes, true);
+			} else {
+				channel->set_channel_params(channel_params, update_volumes, true);
+			}
 			p_track->reset_volume_offset();
 		} break;
 
@@ -9,6 +9,7 @@
 #include "sion_stream_playback.h"
 #include "utils/denormals.h"
 #include <algorithm>
+#include <chrono>
 
 #include <godot_cpp/classes/time.hpp>
 #include <godot_cpp/classes/engine.hpp>
@@ -42,6 +43,7 @@
 #include "sequencer/base/mml_sequence.h"
 #include "sequencer/base/mml_sequence_group.h"
 #include "sequencer/base/mml_sequencer.h"
+#include "sequencer/simml_channel_settings.h"
 #include "sequencer/simml_envelope_table.h"
 #include "sequencer/simml_ref_table.h"
 #include "sequencer/simml_sequencer.h"
@@ -336,6 +338,28 @@ void SiONDriver::set_max_track_count(int p_value) {
 	sequencer->set_max_track_count(p_value);
 }
 
+void SiONDriver::set_max_polyphony(int p_value) {
+	ERR_FAIL_COND_MSG(p_value < 0, "SiONDriver: Polyphony limit cannot be negative.");
+
+	_max_polyphony = p_value;
+}
+
+int SiONDriver::get_module_polyphony(SiONModuleType p_module_type) const {
+	return _channel_type_polyphony[_get_module_channel_type(p_module_type)];
+}
+
+void SiONDriver::set_module_polyphony(SiONModuleType p_module_type, int p_value) {
+	ERR_FAIL_COND_MSG(p_value < 0, "SiONDriver: Polyphony limit cannot be negative.");
+
+	_channel_type_polyphony[_get_module_channel_type(p_module_type)] = p_value;
+}
+
+void SiONDriver::set_voice_steal_policy(VoiceStealPolicy p_policy) {
+	ERR_FAIL_INDEX(p_policy, STEAL_MAX);
+
+	_voice_steal_policy = p_policy;
+}
+
 void SiONDriver::_update_volume() {
 	if (!_audio_player) {
 		return;
@@ -688,7 +712,123 @@ void SiONDriver::resume() {
 	_is_paused = false;
 }
 
-SiMMLTrack *SiONDriver::_find_or_create_track(int p_track_id, double p_delay, double p_quant, bool p_disposable, int *r_delay_samples) {
+SiOPMChannelManager::ChannelType SiONDriver::_get_module_channel_type(SiONModuleType p_module_type) {
+	const HashMap<SiONModuleType, SiMMLChannelSettings *> &settings_map = SiMMLRefTable::get_instance()->channel_settings_map;
+	if (!settings_map.has(p_module_type)) {
+		return SiOPMChannelManager::CHANNEL_FM;
+	}
+	return settings_map[p_module_type]->get_channel_type();
+}
+
+bool SiONDriver::_is_allocated_voice(SiMMLTrack *p_track) {
+	// Notes handed to a track only key the channel on later, on the audio thread. They hold
+	// their place in the budget until then, or a burst of note-ons in one block would all pass.
+	if (p_track->get_executor()->get_waiting_note() != -1) {
+		return true;
+	}
+
+	// Voices already fading out after a steal or hard stop no longer count.
+	SiOPMChannelBase *channel = p_track->get_channel();
+	return channel && !channel->is_idling() && !channel->is_kill_fading();
+}
+
+double SiONDriver::_get_voice_level(SiMMLTrack *p_track) {
+	SiOPMChannelBase *channel = p_track->get_channel();
+	return channel ? channel->get_output_level() : 0.0;
+}
+
+SiMMLTrack *SiONDriver::_find_voice_to_steal(SiOPMChannelManager::ChannelType p_channel_type, VoiceStealPolicy p_policy) const {
+	SiMMLTrack *victim = nullptr;
+
+	for (SiMMLTrack *track : sequencer->get_tracks_ref()) {
+		// Only driver notes that are allowed to end early are ever stolen.
+		if (!track->is_disposable() || track->is_playing_sequence() || !_is_allocated_voice(track)) {
+			continue;
+		}
+		if (p_channel_type != SiOPMChannelManager::CHANNEL_MAX && (!track->get_channel() || track->get_channel()->get_channel_type() != p_channel_type)) {
+			continue;
+		}
+		if (!victim) {
+			victim = track;
+			continue;
+		}
+
+		// Ties go to the older voice.
+		const bool is_older = track->get_allocation_order() < victim->get_allocation_order();
+		switch (p_policy) {
+			case STEAL_QUIETEST: {
+				// Notes that haven't sounded yet are silent, so they go first.
+				const double level = _get_voice_level(track);
+				const double victim_level = _get_voice_level(victim);
+				if (level < victim_level || (level == victim_level && is_older)) {
+					victim = track;
+				}
+			} break;
+			case STEAL_LOWEST_PRIORITY: {
+				// Higher numbers are lower priorities, see SiMMLTrack::get_priority().
+				if (track->get_priority() > victim->get_priority() || (track->get_priority() == victim->get_priority() && is_older)) {
+					victim = track;
+				}
+			} break;
+
+			default: {
+				if (is_older) {
+					victim = track;
+				}
+			} break;
+		}
+	}
+
+	return victim;
+}
+
+bool SiONDriver::_reserve_voice(SiOPMChannelManager::ChannelType p_channel_type) {
+	const int type_limit = _channel_type_polyphony[p_channel_type];
+	int max_polyphony = _max_polyphony;
+	const int quality_limit = _quality_polyphony_limit.load(std::memory_order_relaxed);
+	if (quality_limit > 0 && (max_polyphony <= 0 || quality_limit < max_polyphony)) {
+		max_polyphony = quality_limit;
+	}
+	if (max_polyphony <= 0 && type_limit <= 0) {
+		return true;
+	}
+
+	int total_count = 0;
+	int type_count = 0;
+	for (SiMMLTrack *track : sequencer->get_tracks_ref()) {
+		if (!_is_allocated_voice(track)) {
+			continue;
+		}
+		total_count++;
+		if (track->get_channel() && track->get_channel()->get_channel_type() == p_channel_type) {
+			type_count++;
+		}
+	}
+
+	// Steal within the type first, since that also frees room in the total.
+	int type_excess = (type_limit > 0) ? (type_count - type_limit + 1) : 0;
+	for (; type_excess > 0; type_excess--) {
+		SiMMLTrack *victim = _find_voice_to_steal(p_channel_type, _voice_steal_policy);
+		if (!victim) {
+			return false;
+		}
+		victim->key_off(0, true);
+		total_count--;
+	}
+
+	int total_excess = (max_polyphony > 0) ? (total_count - max_polyphony + 1) : 0;
+	for (; total_excess > 0; total_excess--) {
+		SiMMLTrack *victim = _find_voice_to_steal(SiOPMChannelManager::CHANNEL_MAX, _voice_steal_policy);
+		if (!victim) {
+			return false;
+		}
+		victim->key_off(0, true);
+	}
+
+	return true;
+}
+
+SiMMLTrack *SiONDriver::_find_or_create_track(int p_track_id, double p_delay, double p_quant, bool p_disposable, SiOPMChannelManager::ChannelType p_channel_type, int *r_delay_samples) {
 	ERR_FAIL_COND_V_MSG(p_delay < 0, nullptr, "SiONDriver: Playback delay cannot be less than zero.");
 
 	int internal_track_id = (p_track_id & SiMMLTrack::TRACK_ID_FILTER) | SiMMLTrack::DRIVER_NOTE;
@@ -719,8 +859,13 @@ SiMMLTrack *SiONDriver::_find_or_create_track(int p_track_id, double p_delay, do
 		return track;
 	}
 
+	if (!_reserve_voice(p_channel_type)) {
+		return nullptr;
+	}
+
 	track = sequencer->create_controllable_track(internal_track_id, p_disposable);
 	ERR_FAIL_NULL_V_MSG(track, nullptr, "SiONDriver: Failed to allocate a track for playback. Pushing the limits?");
+	track->set_allocation_order(++_voice_allocation_count);
 	return track;
 }
 
@@ -729,7 +874,7 @@ SiMMLTrack *SiONDriver::sample_on(int p_sample_number, double p_length, double p
 	ERR_FAIL_COND_V_MSG(p_length < 0, nullptr, "SiONDriver: Sample length cannot be less than zero.");
 
 	int delay_samples = 0;
-	SiMMLTrack *track = _find_or_create_track(p_track_id, p_delay, p_quant, p_disposable, &delay_samples);
+	SiMMLTrack *track = _find_or_create_track(p_track_id, p_delay, p_quant, p_disposable, _get_module_channel_type(SiONModuleType::MODULE_SAMPLE), &delay_samples);
 	if (!track) {
 		return nullptr;
 	}
@@ -745,7 +890,8 @@ SiMMLTrack *SiONDriver::note_on(int p_note, const Ref<SiONVoice> &p_voice, doubl
 	ERR_FAIL_COND_V_MSG(p_length < 0, nullptr, "SiONDriver: Note length cannot be less than zero.");
 
 	int delay_samples = 0;
-	SiMMLTrack *track = _find_or_create_track(p_track_id, p_delay, p_quant, p_disposable, &delay_samples);
+	const SiOPMChannelManager::ChannelType channel_type = p_voice.is_valid() ? _get_module_channel_type(p_voice->get_module_type()) : SiOPMChannelManager::CHANNEL_FM;
+	SiMMLTrack *track = _find_or_create_track(p_track_id, p_delay, p_quant, p_disposable, channel_type, &delay_samples);
 	if (!track) {
 		return nullptr;
 	}
@@ -764,7 +910,8 @@ SiMMLTrack *SiONDriver::note_on_with_bend(int p_note, int p_note_to, double p_be
 	ERR_FAIL_COND_V_MSG(p_bend_length < 0, nullptr, "SiONDriver: Pitch bending length cannot be less than zero.");
 
 	int delay_samples = 0;
-	SiMMLTrack *track = _find_or_create_track(p_track_id, p_delay, p_quant, p_disposable, &delay_samples);
+	const SiOPMChannelManager::ChannelType channel_type = p_voice.is_valid() ? _get_module_channel_type(p_voice->get_module_type()) : SiOPMChannelManager::CHANNEL_FM;
+	SiMMLTrack *track = _find_or_create_track(p_track_id, p_delay, p_quant, p_disposable, channel_type, &delay_samples);
 	if (!track) {
 		return nullptr;
 	}
@@ -1498,6 +1645,7 @@ void SiONDriver::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("track_effects_set_effect_args", "track_id", "index", "args"), &SiONDriver::track_effects_set_effect_args);
 	ClassDB::bind_method(D_METHOD("track_effects_set_bypass", "track_id", "index", "bypassed"), &SiONDriver::track_effects_set_bypass);
 	ClassDB::bind_method(D_METHOD("track_effects_set_mute", "track_id", "mute"), &SiONDriver::track_effects_set_mute);
+	ClassDB::bind_method(D_METHOD("track_effects_set_essential", "track_id", "essential"), &SiONDriver::track_effects_set_essential);
 
 	// Mailbox bindings
 	ClassDB::bind_method(D_METHOD("mailbox_set_track_volume", "track_id", "linear_volume", "entity_scope_id", "slot_scope_id"), &SiONDriver::mailbox_set_track_volume, DEFVAL(-1), DEFVAL(-1));
@@ -1635,6 +1783,16 @@ void SiONDriver::_bind_methods() {
 
 	ClassDB::add_property("SiONDriver", PropertyInfo(Variant::INT, "max_track_count"), "set_max_track_count", "get_max_track_count");
 
+	ClassDB::bind_method(D_METHOD("get_max_polyphony"), &SiONDriver::get_max_polyphony);
+	ClassDB::bind_method(D_METHOD("set_max_polyphony", "value"), &SiONDriver::set_max_polyphony);
+	ClassDB::bind_method(D_METHOD("get_module_polyphony", "module_type"), &SiONDriver::get_module_polyphony);
+	ClassDB::bind_method(D_METHOD("set_module_polyphony", "module_type", "value"), &SiONDriver::set_module_polyphony);
+	ClassDB::bind_method(D_METHOD("get_voice_steal_policy"), &SiONDriver::get_voice_steal_policy);
+	ClassDB::bind_method(D_METHOD("set_voice_steal_policy", "policy"), &SiONDriver::set_voice_steal_policy);
+
+	ClassDB::add_property("SiONDriver", PropertyInfo(Variant::INT, "max_polyphony"), "set_max_polyphony", "get_max_polyphony");
+	ClassDB::add_property("SiONDriver", PropertyInfo(Variant::INT, "voice_steal_policy"), "set_voice_steal_policy", "get_voice_steal_policy");
+
 	ClassDB::bind_method(D_METHOD("get_buffer_length"), &SiONDriver::get_buffer_length);
 	ClassDB::bind_method(D_METHOD("get_channel_num"), &SiONDriver::get_channel_num);
 	ClassDB::bind_method(D_METHOD("get_preferred_sample_rate"), &SiONDriver::get_preferred_sample_rate);
@@ -1667,6 +1825,13 @@ void SiONDriver::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_denormal_flush_enabled", "enabled"), &SiONDriver::set_denormal_flush_enabled);
 	ClassDB::bind_method(D_METHOD("is_denormal_flush_enabled"), &SiONDriver::is_denormal_flush_enabled);
 
+	ClassDB::bind_method(D_METHOD("set_adaptive_quality_enabled", "enabled"), &SiONDriver::set_adaptive_quality_enabled);
+	ClassDB::bind_method(D_METHOD("is_adaptive_quality_enabled"), &SiONDriver::is_adaptive_quality_enabled);
+	ClassDB::bind_method(D_METHOD("get_quality_level"), &SiONDriver::get_quality_level);
+	ClassDB::bind_method(D_METHOD("get_render_load"), &SiONDriver::get_render_load);
+
+	ClassDB::add_property("SiONDriver", PropertyInfo(Variant::BOOL, "adaptive_quality_enabled"), "set_adaptive_quality_enabled", "is_adaptive_quality_enabled");
+
 	ClassDB::bind_method(D_METHOD("set_metering_enabled", "enabled"), &SiONDriver::set_metering_enabled);
 	ClassDB::bind_method(D_METHOD("is_metering_enabled"), &SiONDriver::is_metering_enabled);
 	ClassDB::bind_method(D_METHOD("set_meter_downsample_factor", "factor"), &SiONDriver::set_meter_downsample_factor);
@@ -1754,6 +1919,17 @@ void SiONDriver::_bind_methods() {
 
 	//
 
+	BIND_ENUM_CONSTANT(STEAL_OLDEST);
+	BIND_ENUM_CONSTANT(STEAL_QUIETEST);
+	BIND_ENUM_CONSTANT(STEAL_LOWEST_PRIORITY);
+
+	BIND_ENUM_CONSTANT(QUALITY_FULL);
+	BIND_ENUM_CONSTANT(QUALITY_FEWER_SUPER_VOICES);
+	BIND_ENUM_CONSTANT(QUALITY_ESSENTIAL_EFFECTS);
+	BIND_ENUM_CONSTANT(QUALITY_NEAREST_SAMPLES);
+	BIND_ENUM_CONSTANT(QUALITY_FEWER_VOICES);
+	BIND_CONSTANT(QUALITY_SUPER_VOICE_LIMIT);
+
 	BIND_ENUM_CONSTANT(CHIP_AUTO);
 	BIND_ENUM_CONSTANT(CHIP_SIOPM);
 	BIND_ENUM_CONSTANT(CHIP_OPL);
@@ -1885,17 +2061,27 @@ SiONDriver::SiONDriver(int p_buffer_length, int p_channel_num, int p_sample_rate
 	_channel_num = p_channel_num;
 
 	// Ensure reference tables use the actual backend rate before any chip initialization.
+	// The global table is shared as long as the rates match. Otherwise this driver builds
+	// its own rate-dependent tables, leaving the global table and other drivers untouched.
 	{
 		SiOPMRefTable *ref_table = SiOPMRefTable::get_instance();
-		if (!ref_table || ref_table->sampling_rate != actual_sample_rate) {
-			SiOPMRefTable::finalize();
-			memnew(SiOPMRefTable(3580000, 1789772.5, actual_sample_rate));
+		if (!ref_table) {
+			SiOPMRefTable::initialize();
+			ref_table = SiOPMRefTable::get_instance();
+		}
+
+		if (ref_table->sampling_rate == actual_sample_rate) {
+			_ref_table = ref_table;
+		} else {
+			_ref_table = memnew(SiOPMRefTable(3580000, 1789772.5, actual_sample_rate));
+			_owns_ref_table = true;
 		}
 	}
 	ERR_FAIL_COND_MSG(!_allow_multiple_drivers && _mutex, "SiONDriver: Only one driver instance is allowed.");
 	_mutex = this;
 
 	sound_chip = memnew(SiOPMSoundChip);
+	sound_chip->set_ref_table(_ref_table);
 	effector = memnew(SiEffector(sound_chip));
 	sequencer = memnew(SiMMLSequencer(sound_chip));
 	sound_chip->set_sequencer(sequencer);
@@ -1987,6 +2173,11 @@ SiONDriver::~SiONDriver() {
 		effector = nullptr;
 		sound_chip = nullptr;
 	}
+
+	if (_owns_ref_table) {
+		memdelete(_ref_table);
+	}
+	_ref_table = nullptr;
 }
 
 int SiONDriver::render_interleaved(float *p_output, int p_frames, int p_channels) {
@@ -2013,7 +2204,18 @@ int SiONDriver::render_interleaved(float *p_output, int p_frames, int p_channels
 
 	while (frames_generated < p_frames) {
 		if (_residual_buffer_frame_count == 0) {
-			_process_one_block();
+			if (_adaptive_quality_enabled.load(std::memory_order_relaxed) && !_offline_rendering) {
+				const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				_process_one_block();
+				const std::chrono::duration<double> render_time = std::chrono::steady_clock::now() - start_time;
+				_update_adaptive_quality(render_time.count(), block / _sample_rate);
+			} else {
+				if (_quality_level.load(std::memory_order_relaxed) != QUALITY_FULL) {
+					_adaptive_quality.reset();
+					_apply_quality_level(QUALITY_FULL);
+				}
+				_process_one_block();
+			}
 
 			Vector<double> *out_buf = sound_chip->get_output_buffer_ptr();
 
@@ -2186,7 +2388,7 @@ void SiONDriver::_meter_track_output(int track_id, const Vector<double> *track_b
 	snapshot.timestamp_us = track_meter_counter.fetch_add(1, std::memory_order_relaxed);
 	snapshot.sample_count = frames;
 
-	double (&pan_table)[129] = SiOPMRefTable::get_instance()->pan_table;
+	const double (&pan_table)[129] = SiOPMRefTable::get_instance()->pan_table;
 	const int clamped_pan = CLAMP(p_post_pan, 0, 128);
 	const double post_fader_gain = std::max(p_post_fader_gain, 0.0);
 	const double gain_l = pan_table[128 - clamped_pan] * post_fader_gain;
@@ -2260,6 +2462,67 @@ void SiONDriver::_meter_all_track_outputs(int frames) {
 	}
 }
 
+void SiONDriver::_update_adaptive_quality(double p_render_time, double p_block_time) {
+	const bool changed = _adaptive_quality.update(p_render_time, p_block_time);
+	_render_load.store(_adaptive_quality.get_load(), std::memory_order_relaxed);
+	if (changed) {
+		_apply_quality_level(_adaptive_quality.get_level());
+	}
+}
+
+void SiONDriver::_apply_quality_level(int p_level) {
+	const int previous_level = _quality_level.load(std::memory_order_relaxed);
+	_quality_level.store(p_level, std::memory_order_relaxed);
+
+	sound_chip->set_super_voice_limit(p_level >= QUALITY_FEWER_SUPER_VOICES ? QUALITY_SUPER_VOICE_LIMIT : 0);
+	sound_chip->set_sampler_interpolation(p_level < QUALITY_NEAREST_SAMPLES);
+	// Track effect chains follow the level in _update_track_effect_post_fader().
+
+	if (p_level < QUALITY_FEWER_VOICES) {
+		_quality_polyphony_limit.store(0, std::memory_order_relaxed);
+		return;
+	}
+	if (previous_level >= QUALITY_FEWER_VOICES) {
+		return;
+	}
+
+	// Entering the lowest level: shed a quarter of the sounding voices, quietest first,
+	// and hold polyphony there until the level is raised again.
+	int sounding_count = 0;
+	for (SiMMLTrack *track : sequencer->get_tracks_ref()) {
+		if (_is_allocated_voice(track)) {
+			sounding_count++;
+		}
+	}
+
+	const int voice_limit = MAX(sounding_count - sounding_count / 4, 1);
+	for (int i = voice_limit; i < sounding_count; i++) {
+		SiMMLTrack *victim = _find_voice_to_steal(SiOPMChannelManager::CHANNEL_MAX, STEAL_QUIETEST);
+		if (!victim) {
+			break;
+		}
+		victim->key_off(0, true);
+	}
+	_quality_polyphony_limit.store(voice_limit, std::memory_order_relaxed);
+}
+
+void SiONDriver::set_adaptive_quality_enabled(bool p_enabled) {
+	// Turning it off restores full quality on the next rendered block.
+	_adaptive_quality_enabled.store(p_enabled, std::memory_order_release);
+}
+
+bool SiONDriver::is_adaptive_quality_enabled() const {
+	return _adaptive_quality_enabled.load(std::memory_order_acquire);
+}
+
+int SiONDriver::get_quality_level() const {
+	return _quality_level.load(std::memory_order_relaxed);
+}
+
+double SiONDriver::get_render_load() const {
+	return _render_load.load(std::memory_order_relaxed);
+}
+
 void SiONDriver::set_denormal_flush_enabled(bool p_enabled) {
 	_denormal_flush_enabled.store(p_enabled, std::memory_order_release);
 }
@@ -3419,7 +3682,7 @@ void SiONDriver::_drain_track_mailbox() {
 						if (kind.is_empty()) {
 							continue;
 						}
-						Ref<SiEffectBase> effect = SiEffector::get_effect_instance(kind);
+						Ref<SiEffectBase> effect = SiEffector::get_effect_instance(kind, _sample_rate);
 						if (effect.is_null()) {
 							continue;
 						}
@@ -3441,7 +3704,7 @@ void SiONDriver::_drain_track_mailbox() {
 				} else if (u.fx_op == _TrackUpdate::FX_OP_INSERT) {
 					String kind = String::utf8(u.fx_kind);
 					if (!kind.is_empty()) {
-						Ref<SiEffectBase> effect = SiEffector::get_effect_instance(kind);
+						Ref<SiEffectBase> effect = SiEffector::get_effect_instance(kind, _sample_rate);
 						if (!effect.is_null()) {
 							Vector<double> args;
 							args.resize(u.fx_argc);
@@ -3794,7 +4057,7 @@ void SiONDriver::_drain_track_mailbox() {
                 }
                 if (u.has_al_balance) {
                     int bal = CLAMP(u.al_balance, -64, 64);
-                    int (&level_table)[129] = SiOPMRefTable::get_instance()->eg_linear_to_total_level_table;
+                    const int (&level_table)[129] = SiOPMRefTable::get_instance()->eg_linear_to_total_level_table;
                     // Operator 0 TL = 64 - bal, Operator 1 TL = 64 + bal
                     fm->set_active_operator_index(0);
                     fm->set_total_level(level_table[64 - bal]);
@@ -4002,11 +4265,13 @@ void SiONDriver::_update_track_effect_post_fader() {
 	}
 
 	// Pass 3: apply post-fader/pan using resolved channels.
+	const bool shed_effects = _quality_level.load(std::memory_order_relaxed) >= QUALITY_ESSENTIAL_EFFECTS;
 	for (const KeyValue<int, SiEffectStream *> &entry : _track_effect_streams) {
 		SiEffectStream *stream = entry.value;
 		if (!stream) {
 			continue;
 		}
+		stream->set_chain_bypassed(shed_effects && !stream->is_essential());
 
 		SiOPMChannelBase **channel_ptr = _track_effect_channels.getptr(entry.key);
 		if (!channel_ptr || !*channel_ptr) {
@@ -4072,7 +4337,7 @@ Ref<SiEffectBase> SiONDriver::_build_effect_from_dict(const Dictionary &p_slot)
 	if (kind.is_empty()) {
 		return Ref<SiEffectBase>();
 	}
-	Ref<SiEffectBase> effect = SiEffector::get_effect_instance(kind);
+	Ref<SiEffectBase> effect = SiEffector::get_effect_instance(kind, _sample_rate);
 	if (effect.is_null()) {
 		ERR_PRINT(vformat("SiONDriver: Unknown insert effect '%s'.", kind));
 		return Ref<SiEffectBase>();
@@ -4165,3 +4430,10 @@ void SiONDriver::track_effects_set_mute(int p_track_id, bool p_mute) {
 		stream->set_mute(p_mute);
 	}
 }
+
+void SiONDriver::track_effects_set_essential(int p_track_id, bool p_essential) {
+	SiEffectStream *stream = _get_track_effect_stream(p_track_id);
+	if (stream) {
+		stream->set_essential(p_essential);
+	}
+}
@@ -28,6 +28,7 @@
 
 #include "audio_render_client.h"
 #include "sion_voice.h"
+#include "chip/channels/siopm_channel_manager.h"
 #include "chip/wave/siopm_wave_sampler_data.h"
 #include "events/sion_event.h"
 #include "events/sion_track_event.h"
@@ -35,6 +36,7 @@
 #include "sequencer/base/mml_data.h"
 #include "sequencer/base/mml_system_command.h"
 #include "templates/singly_linked_list.h"
+#include "utils/adaptive_quality_util.h"
 #include "sion_data.h"
 #include "sion_stream.h"
 #include "sion_stream_playback.h"
@@ -52,6 +54,7 @@ class SiMMLSequencer;
 class SiMMLTrack;
 class SiONData;
 class SiONDataConverterSMF;
+class SiOPMRefTable;
 class SiOPMSoundChip;
 class SiOPMWaveTable;
 class SiOPMWavePCMData;
@@ -82,6 +85,27 @@ public:
 		NEM_MAX = 4
 	};
 
+	// Which sounding voice gives way when a polyphony limit is reached.
+	enum VoiceStealPolicy {
+		STEAL_OLDEST = 0,          // The voice that started first (default).
+		STEAL_QUIETEST = 1,        // The voice with the lowest output peak in the last buffer.
+		STEAL_LOWEST_PRIORITY = 2, // The voice with the highest track priority number, i.e. released and oldest.
+		STEAL_MAX = 3
+	};
+
+	// Render quality levels for adaptive quality, from full to the cheapest. Each level keeps
+	// the reductions of the levels before it.
+	enum QualityLevel {
+		QUALITY_FULL = 0,
+		QUALITY_FEWER_SUPER_VOICES = 1, // Super wave operators render at most QUALITY_SUPER_VOICE_LIMIT voices.
+		QUALITY_ESSENTIAL_EFFECTS = 2,  // Track effect chains not marked essential are bypassed.
+		QUALITY_NEAREST_SAMPLES = 3,    // Samplers read the nearest sample instead of interpolating.
+		QUALITY_FEWER_VOICES = 4,       // The quietest voices are stolen and polyphony is capped below what was sounding.
+		QUALITY_MAX = 5
+	};
+
+	static const int QUALITY_SUPER_VOICE_LIMIT = 3;
+
 private:
 	enum FrameProcessingType {
 		NONE = 0,
@@ -153,6 +177,10 @@ private:
 	int _preferred_sample_rate = 0;
 	// Actual backend sample rate resolved during driver initialization.
 	double _sample_rate = 0;
+	// Reference tables at the actual sample rate. Either the global table, or a table
+	// owned by this driver when its rate differs from the global one.
+	SiOPMRefTable *_ref_table = nullptr;
+	bool _owns_ref_table = false;
 	// Output bitrate. Value of 0 means that the wave is represented by a float in [-1,+1].
 	int _bitrate = 0;
 	bool _is_initialized = false;
@@ -242,6 +270,20 @@ private:
 	// comparing across two builds.
 	std::atomic<bool> _denormal_flush_enabled{true};
 
+	// Adaptive quality. The render thread times every block against its playback duration
+	// and lowers or restores the quality level through AdaptiveQualityUtil. Off by default,
+	// and never applied during offline rendering.
+	std::atomic<bool> _adaptive_quality_enabled{false};
+	std::atomic<int> _quality_level{QUALITY_FULL};
+	std::atomic<double> _render_load{0.0};
+	// Polyphony cap while at QUALITY_FEWER_VOICES, 0 otherwise.
+	std::atomic<int> _quality_polyphony_limit{0};
+	AdaptiveQualityUtil _adaptive_quality = AdaptiveQualityUtil(QUALITY_MAX - 1);
+	bool _offline_rendering = false;
+
+	void _update_adaptive_quality(double p_render_time, double p_block_time);
+	void _apply_quality_level(int p_level);
+
 	// Metering settings - DISABLED BY DEFAULT for real-time safety
 	// Time::get_singleton() calls from audio thread can block on main thread!
 	std::atomic<bool> _metering_enabled{false};
@@ -255,10 +297,26 @@ private:
 	void _push_meter_to_ring(const MeterSnapshot &snapshot);
 
 	ExceptionMode _note_on_exception_mode = NEM_IGNORE;
+
+	// Voice budget for driver notes. Limits of 0 are unlimited. When a limit is reached, a
+	// disposable voice picked by the steal policy is stopped with a kill fade before the new
+	// one starts; if none can be stolen, the new note is rejected.
+	int _max_polyphony = 0;
+	int _channel_type_polyphony[SiOPMChannelManager::CHANNEL_MAX] = {};
+	VoiceStealPolicy _voice_steal_policy = STEAL_OLDEST;
+	uint64_t _voice_allocation_count = 0;
+
+	static SiOPMChannelManager::ChannelType _get_module_channel_type(SiONModuleType p_module_type);
+	static bool _is_allocated_voice(SiMMLTrack *p_track);
+	static double _get_voice_level(SiMMLTrack *p_track);
+	SiMMLTrack *_find_voice_to_steal(SiOPMChannelManager::ChannelType p_channel_type, VoiceStealPolicy p_policy) const;
+	// Make room for one more voice of the given type. Returns false if the budget is full
+	// and nothing could be stolen.
+	bool _reserve_voice(SiOPMChannelManager::ChannelType p_channel_type);
 	// Send the CHANGE_BPM event when position changes.
 	bool _notify_change_bpm_on_position_changed = true;
 
-	SiMMLTrack *_find_or_create_track(int p_track_id, double p_delay, double p_quant, bool p_disposable, int *r_delay_samples);
+	SiMMLTrack *_find_or_create_track(int p_track_id, double p_delay, double p_quant, bool p_disposable, SiOPMChannelManager::ChannelType p_channel_type, int *r_delay_samples);
 
 	void _update_volume();
 	void _fade_callback(double p_value);
@@ -779,6 +837,14 @@ public:
 	int get_max_track_count() const;
 	void set_max_track_count(int p_value);
 
+	int get_max_polyphony() const { return _max_polyphony; }
+	void set_max_polyphony(int p_value);
+	// The limit is per channel type, so modules that render on the same type share it.
+	int get_module_polyphony(SiONModuleType p_module_type) const;
+	void set_module_polyphony(SiONModuleType p_module_type, int p_value);
+	VoiceStealPolicy get_voice_steal_policy() const { return _voice_steal_policy; }
+	void set_voice_steal_policy(VoiceStealPolicy p_policy);
+
 	int get_buffer_length() const { return _buffer_length; }
 	int get_channel_num() const { return _channel_num; }
 	int get_preferred_sample_rate() const { return _preferred_sample_rate; }
@@ -869,6 +935,15 @@ public:
 	void set_denormal_flush_enabled(bool p_enabled);
 	bool is_denormal_flush_enabled() const;
 
+	// Adaptive quality: when blocks take too long to render, trade quality for time instead
+	// of dropping out, and restore it once there is headroom again.
+	void set_adaptive_quality_enabled(bool p_enabled);
+	bool is_adaptive_quality_enabled() const;
+	// Current QualityLevel.
+	int get_quality_level() const;
+	// Smoothed ratio of block render time to block duration, measured while adaptive quality is on.
+	double get_render_load() const;
+
 	// Metering API (professional post-effects, post-fader metering).
 	void set_metering_enabled(bool p_enabled);
 	bool is_metering_enabled() const;
@@ -1083,6 +1158,11 @@ public:
 	void track_effects_set_effect_args(int p_track_id, int p_index, const Variant &p_args);
 	void track_effects_set_bypass(int p_track_id, int p_index, bool p_bypassed);
 	void track_effects_set_mute(int p_track_id, bool p_mute);
+	// Essential chains keep running when adaptive quality sheds track effects.
+	void track_effects_set_essential(int p_track_id, bool p_essential);
 };
 
+VARIANT_ENUM_CAST(SiONDriver::VoiceStealPolicy);
+VARIANT_ENUM_CAST(SiONDriver::QualityLevel);
+
 #endif // SION_DRIVER_H
@@ -473,7 +473,7 @@ void SiONVoice::set_analog_like(int p_connection_type, int p_wave_shape1, int p_
 	channel_params->get_operator_params(1)->set_pulse_generator_type(p_wave_shape2);
 
 	int balance = CLAMP(p_balance, -64, 64);
-	int (&level_table)[129] = SiOPMRefTable::get_instance()->eg_linear_to_total_level_table;
+	const int (&level_table)[129] = SiOPMRefTable::get_instance()->eg_linear_to_total_level_table;
 	channel_params->get_operator_params(0)->set_total_level(level_table[64 - balance]);
 	channel_params->get_operator_params(1)->set_total_level(level_table[balance + 64]);
 
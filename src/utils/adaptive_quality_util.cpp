@@ -0,0 +1,74 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#include "adaptive_quality_util.h"
+
+#include <godot_cpp/core/math.hpp>
+
+using namespace godot;
+
+void AdaptiveQualityUtil::set_max_level(int p_level) {
+	_max_level = MAX(p_level, 0);
+	if (_level > _max_level) {
+		_level = _max_level;
+	}
+}
+
+void AdaptiveQualityUtil::set_thresholds(double p_degrade, double p_restore) {
+	_degrade_threshold = MAX(p_degrade, 0.01);
+	_restore_threshold = CLAMP(p_restore, 0.0, _degrade_threshold);
+}
+
+bool AdaptiveQualityUtil::update(double p_render_time, double p_block_time) {
+	if (p_block_time <= 0) {
+		return false;
+	}
+
+	const double ratio = p_render_time / p_block_time;
+	_load += (ratio - _load) * LOAD_SMOOTHING;
+	_settle_time += p_block_time;
+
+	if (ratio >= 1.0 || _load > _degrade_threshold) {
+		_under_time = 0.0;
+		_over_time += p_block_time;
+
+		// An overrun is an audible dropout already, so it doesn't wait for the hold time.
+		const bool overrun = ratio >= 1.0 && _settle_time >= _degrade_hold_time;
+		if (_level < _max_level && (overrun || _over_time >= _degrade_hold_time)) {
+			_level++;
+			_over_time = 0.0;
+			_settle_time = 0.0;
+			return true;
+		}
+	} else if (_load < _restore_threshold) {
+		_over_time = 0.0;
+		_under_time += p_block_time;
+
+		if (_level > 0 && _under_time >= _restore_hold_time) {
+			_level--;
+			_under_time = 0.0;
+			_settle_time = 0.0;
+			return true;
+		}
+	} else {
+		_over_time = 0.0;
+		_under_time = 0.0;
+	}
+
+	return false;
+}
+
+void AdaptiveQualityUtil::reset() {
+	_level = 0;
+	_load = 0.0;
+	_over_time = 0.0;
+	_under_time = 0.0;
+	_settle_time = 0.0;
+}
+
+AdaptiveQualityUtil::AdaptiveQualityUtil(int p_max_level) {
+	_max_level = MAX(p_max_level, 0);
+}
@@ -0,0 +1,56 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SION_ADAPTIVE_QUALITY_UTIL_H
+#define SION_ADAPTIVE_QUALITY_UTIL_H
+
+// Decides how far rendering quality should be lowered to keep blocks within their deadline.
+//
+// Every rendered block reports how long it took against how long it plays for. The ratio is
+// smoothed into a load figure; sustained load above the degrade threshold (or any overrun)
+// steps the quality level down, and load that stays under the restore threshold for a while
+// steps it back up, one level at a time. The gap between the thresholds and the much longer
+// restore hold keep the level from flapping. What each level means is up to the caller.
+class AdaptiveQualityUtil {
+
+	// Weight of the newest block in the smoothed load.
+	static constexpr double LOAD_SMOOTHING = 0.2;
+
+	int _level = 0;
+	int _max_level = 0;
+	double _load = 0.0;
+
+	double _degrade_threshold = 0.85;
+	double _restore_threshold = 0.5;
+	double _degrade_hold_time = 0.05; // In seconds.
+	double _restore_hold_time = 2.0;  // In seconds.
+
+	double _over_time = 0.0;
+	double _under_time = 0.0;
+	// Time since the level last changed, so one slow block can't cascade through every level.
+	double _settle_time = 0.0;
+
+public:
+	int get_level() const { return _level; }
+	int get_max_level() const { return _max_level; }
+	void set_max_level(int p_level);
+	double get_load() const { return _load; }
+
+	double get_degrade_threshold() const { return _degrade_threshold; }
+	double get_restore_threshold() const { return _restore_threshold; }
+	// Both are ratios of render time to block duration. The restore threshold is kept below
+	// the degrade one.
+	void set_thresholds(double p_degrade, double p_restore);
+
+	// Report one block. Returns true if the level changed.
+	bool update(double p_render_time, double p_block_time);
+	void reset();
+
+	AdaptiveQualityUtil(int p_max_level = 0);
+	~AdaptiveQualityUtil() {}
+};
+
+#endif // SION_ADAPTIVE_QUALITY_UTIL_H
@@ -17,7 +17,7 @@ using namespace godot;
 PackedStringArray split_string_by_regex(const String &p_string, const String &p_regex);
 
 template <class T, size_t S>
-Vector<T> make_vector(T (&p_array)[S]) {
+Vector<T> make_vector(const T (&p_array)[S]) {
 	Vector<T> vector;
 	vector.resize_zeroed(S);
 
@@ -38,6 +38,8 @@ bool SiONOfflineRenderer::begin(SiONDriver *p_driver) {
 	// so the export starts from a clean block boundary.
 	_driver->_residual_buffer_frame_count = 0;
 	_driver->_residual_frame_offset = 0;
+	// Exports aren't bound by the audio deadline, so they always render at full quality.
+	_driver->_offline_rendering = true;
 
 	// Pre-size scratch buffer for one block of stereo audio.
 	_scratch.resize(_buffer_length);
@@ -108,6 +110,7 @@ void SiONOfflineRenderer::finish() {
 	}
 
 	_active = false;
+	_driver->_offline_rendering = false;
 	_driver = nullptr;
 	_buffer_length = 0;
 	_total_frames_rendered = 0;
@@ -0,0 +1,389 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifdef SION_BENCHMARKS
+
+#include "sion_benchmark.h"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/core/math.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <chrono>
+#include "effector/si_effect_base.h"
+#include "effector/si_effector.h"
+#include "sion_driver.h"
+#include "sion_enums.h"
+
+using namespace godot;
+
+// A short multi-track song touching the common sequence features: tempo, repeats,
+// octave shifts, ties, volume and voice changes across FM, PSG and noise channels.
+static const char *DEFAULT_BENCHMARK_MML =
+		"t140;\n"
+		"%6@0 v12 q6 l8 o4 [ceg<c>gec4 | r8 f+a<d>af+d4]4 c1&c1;\n"
+		"%6@3 v10 l4 o3 [c c g g a a g2 f f e e d d c2]4;\n"
+		"%0@0 v8 l16 o5 [[c<c>]4 [e<e>]4 [g<g>]4 [c<c>]4]4;\n"
+		"%2@0 v6 l16 [c r c c r c r c]16;\n";
+
+static uint64_t _now_ns() {
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool SiONBenchmark::_ensure_driver() {
+	if (_driver) {
+		return true;
+	}
+
+	_driver = SiONDriver::create_native(_block_frames, 2, SAMPLE_RATE, SAMPLE_RATE, false);
+	ERR_FAIL_NULL_V_MSG(_driver, false, "SiONBenchmark: Failed to create a driver. Only one driver may exist at a time, free any other driver first.");
+
+	_output.resize_zeroed(_block_frames * 2);
+	return true;
+}
+
+void SiONBenchmark::_free_driver() {
+	if (!_driver) {
+		return;
+	}
+
+	_driver->stop();
+	memdelete(_driver);
+	_driver = nullptr;
+}
+
+void SiONBenchmark::_restart_stream() {
+	_driver->stream_without_output(true);
+}
+
+String SiONBenchmark::_get_channel_name(SiOPMChannelManager::ChannelType p_type) {
+	switch (p_type) {
+		case SiOPMChannelManager::CHANNEL_FM:
+			return "fm";
+		case SiOPMChannelManager::CHANNEL_PCM:
+			return "pcm";
+		case SiOPMChannelManager::CHANNEL_SAMPLER:
+			return "sampler";
+		case SiOPMChannelManager::CHANNEL_KS:
+			return "ks";
+		case SiOPMChannelManager::CHANNEL_STREAM:
+			return "stream";
+		case SiOPMChannelManager::CHANNEL_GUITAR6:
+			return "guitar6";
+		case SiOPMChannelManager::CHANNEL_STRATA:
+			return "strata";
+		case SiOPMChannelManager::CHANNEL_MONOLITH:
+			return "monolith";
+		default:
+			return String();
+	}
+}
+
+Ref<SiONVoice> SiONBenchmark::_create_channel_voice(SiOPMChannelManager::ChannelType p_type, const Ref<SiOPMWaveStreamData> &p_stream) const {
+	switch (p_type) {
+		case SiOPMChannelManager::CHANNEL_FM:
+			return SiONVoice::create(MODULE_FM);
+		case SiOPMChannelManager::CHANNEL_PCM: {
+			Ref<SiONVoice> voice = SiONVoice::create(MODULE_PCM);
+			voice->set_pcm_voice(_make_test_tone(SAMPLE_RATE), 69, 2);
+			return voice;
+		}
+		case SiOPMChannelManager::CHANNEL_SAMPLER: {
+			Ref<SiONVoice> voice = SiONVoice::create(MODULE_SAMPLE);
+			voice->set_sampler_voice(_make_test_tone(SAMPLE_RATE), false, 2);
+			return voice;
+		}
+		case SiOPMChannelManager::CHANNEL_KS:
+			return SiONVoice::create(MODULE_KS);
+		case SiOPMChannelManager::CHANNEL_STREAM: {
+			Ref<SiONVoice> voice = SiONVoice::create(MODULE_STREAM);
+			voice->set_wave_data(p_stream);
+			return voice;
+		}
+		case SiOPMChannelManager::CHANNEL_GUITAR6:
+			return SiONVoice::create(MODULE_GUITAR6);
+		case SiOPMChannelManager::CHANNEL_STRATA:
+			return SiONVoice::create(MODULE_STRATA);
+		case SiOPMChannelManager::CHANNEL_MONOLITH:
+			return SiONVoice::create(MODULE_MONOLITH);
+		default:
+			return Ref<SiONVoice>();
+	}
+}
+
+PackedFloat32Array SiONBenchmark::_make_test_tone(int p_frames) const {
+	// A 440Hz sine with a quieter fifth on the right channel, interleaved stereo.
+	PackedFloat32Array data;
+	data.resize(p_frames * 2);
+	float *ptr = data.ptrw();
+
+	for (int i = 0; i < p_frames; i++) {
+		double t = (double)i / SAMPLE_RATE;
+		ptr[i * 2 + 0] = (float)(0.5 * Math::sin(Math_TAU * 440.0 * t));
+		ptr[i * 2 + 1] = (float)(0.4 * Math::sin(Math_TAU * 660.0 * t));
+	}
+
+	return data;
+}
+
+int SiONBenchmark::_get_test_note(int p_voice_index) const {
+	// Stacked fifths folded into three octaves, so every voice sits at a different pitch.
+	return 48 + (p_voice_index * 7) % 36;
+}
+
+uint64_t SiONBenchmark::_time_render(const Ref<SiOPMWaveStreamData> &p_stream) {
+	PackedFloat32Array stream_block;
+	if (p_stream.is_valid()) {
+		stream_block = _make_test_tone(_block_frames);
+	}
+
+	float *output = _output.ptrw();
+	uint64_t elapsed = 0;
+
+	for (int i = 0; i < _warmup_blocks + _blocks; i++) {
+		if (p_stream.is_valid()) {
+			p_stream->push_interleaved_pcm(stream_block, _block_frames);
+		}
+
+		uint64_t start = _now_ns();
+		_driver->render_interleaved(output, _block_frames, 2);
+		uint64_t end = _now_ns();
+
+		if (i >= _warmup_blocks) {
+			elapsed += end - start;
+		}
+	}
+
+	return elapsed;
+}
+
+Dictionary SiONBenchmark::_make_result(uint64_t p_elapsed_ns, int64_t p_frames) const {
+	Dictionary result;
+	result["frames"] = p_frames;
+	result["elapsed_ns"] = (int64_t)p_elapsed_ns;
+	result["ns_per_sample"] = p_frames > 0 ? (double)p_elapsed_ns / p_frames : 0.0;
+
+	double audio_ns = (double)p_frames * 1e9 / SAMPLE_RATE;
+	result["realtime_factor"] = p_elapsed_ns > 0 ? audio_ns / p_elapsed_ns : 0.0;
+	return result;
+}
+
+//
+
+Dictionary SiONBenchmark::run_channels() {
+	Dictionary results;
+	ERR_FAIL_COND_V(!_ensure_driver(), results);
+
+	int64_t timed_frames = (int64_t)_blocks * _block_frames;
+
+	_restart_stream();
+	Dictionary idle = _make_result(_time_render(), timed_frames);
+	idle["voices"] = 0;
+	results["idle"] = idle;
+
+	for (int i = 0; i < SiOPMChannelManager::CHANNEL_MAX; i++) {
+		SiOPMChannelManager::ChannelType type = (SiOPMChannelManager::ChannelType)i;
+
+		// A live stream has a single read head, so stream voices can't share one; measure a single voice instead.
+		Ref<SiOPMWaveStreamData> stream;
+		int voices = _polyphony;
+		if (type == SiOPMChannelManager::CHANNEL_STREAM) {
+			stream.instantiate();
+			stream->configure_live(SAMPLE_RATE, 2);
+			voices = 1;
+		}
+
+		Ref<SiONVoice> voice = _create_channel_voice(type, stream);
+		ERR_CONTINUE(voice.is_null());
+
+		_restart_stream();
+		for (int j = 0; j < voices; j++) {
+			_driver->note_on(_get_test_note(j), voice, 0, 0, 0, j + 1);
+		}
+
+		Dictionary result = _make_result(_time_render(stream), timed_frames);
+		result["voices"] = voices;
+		results[_get_channel_name(type)] = result;
+
+		_driver->stop();
+		if (stream.is_valid()) {
+			stream->deactivate();
+		}
+	}
+
+	return results;
+}
+
+Dictionary SiONBenchmark::run_effects() {
+	Dictionary results;
+	// Effects are registered by the driver's effector, so a driver must exist even though it isn't rendering.
+	ERR_FAIL_COND_V(!_ensure_driver(), results);
+
+	int buffer_size = _block_frames * 2;
+
+	// Deterministic white noise keeps dynamics and filters busy without depending on the RNG.
+	Vector<double> source;
+	source.resize(buffer_size);
+	uint32_t seed = 0x12345678;
+	for (int i = 0; i < buffer_size; i++) {
+		seed = seed * 1664525 + 1013904223;
+		source.write[i] = ((double)(seed >> 8) / (double)(1 << 24)) - 0.5;
+	}
+
+	int64_t timed_frames = (int64_t)_blocks * _block_frames;
+	PackedStringArray names = SiEffector::get_effect_names();
+
+	for (int n = 0; n < names.size(); n++) {
+		String name = names[n];
+		Ref<SiEffectBase> effect = SiEffector::get_effect_instance(name, SAMPLE_RATE);
+		ERR_CONTINUE(effect.is_null());
+
+		effect->set_by_mml(Vector<double>());
+		effect->prepare_process();
+
+		uint64_t elapsed = 0;
+		for (int i = 0; i < _warmup_blocks + _blocks; i++) {
+			// Effects process in place, so restore the input before every block.
+			_effect_buffer = source;
+			_effect_buffer.ptrw(); // Detach the copy outside of the timed region.
+
+			uint64_t start = _now_ns();
+			effect->process(2, &_effect_buffer, 0, _block_frames);
+			uint64_t end = _now_ns();
+
+			if (i >= _warmup_blocks) {
+				elapsed += end - start;
+			}
+		}
+
+		results[name] = _make_result(elapsed, timed_frames);
+		effect->set_free(true);
+	}
+
+	return results;
+}
+
+Dictionary SiONBenchmark::run_mml_compile(const String &p_mml, int p_repeats) {
+	Dictionary result;
+	ERR_FAIL_COND_V_MSG(p_repeats <= 0, result, "SiONBenchmark: Repeat count must be positive.");
+	ERR_FAIL_COND_V(!_ensure_driver(), result);
+
+	String mml = p_mml.is_empty() ? String(DEFAULT_BENCHMARK_MML) : p_mml;
+
+	// Warm up the parser tables and allocator pools once.
+	_driver->compile(mml);
+
+	uint64_t start = _now_ns();
+	for (int i = 0; i < p_repeats; i++) {
+		_driver->compile(mml);
+	}
+	uint64_t elapsed = _now_ns() - start;
+
+	double seconds = (double)elapsed / 1e9;
+	result["repeats"] = p_repeats;
+	result["mml_length"] = mml.length();
+	result["elapsed_ns"] = (int64_t)elapsed;
+	result["ns_per_compile"] = (double)elapsed / p_repeats;
+	result["chars_per_second"] = seconds > 0 ? (double)mml.length() * p_repeats / seconds : 0.0;
+	return result;
+}
+
+Dictionary SiONBenchmark::run_render() {
+	Dictionary result;
+	ERR_FAIL_COND_V(!_ensure_driver(), result);
+
+	_restart_stream();
+
+	SiEffector *effector = _driver->get_effector();
+	effector->add_slot_effect(0, SiEffector::get_effect_instance("reverb", SAMPLE_RATE));
+	effector->add_slot_effect(0, SiEffector::get_effect_instance("compressor", SAMPLE_RATE));
+
+	Ref<SiONVoice> voice = SiONVoice::create(MODULE_FM);
+	for (int i = 0; i < _polyphony; i++) {
+		_driver->note_on(_get_test_note(i), voice, 0, 0, 0, i + 1);
+	}
+
+	result = _make_result(_time_render(), (int64_t)_blocks * _block_frames);
+	result["voices"] = _polyphony;
+
+	_driver->stop();
+	effector->initialize();
+	return result;
+}
+
+Dictionary SiONBenchmark::run_all() {
+	Dictionary config;
+	config["sample_rate"] = SAMPLE_RATE;
+	config["block_frames"] = _block_frames;
+	config["blocks"] = _blocks;
+	config["warmup_blocks"] = _warmup_blocks;
+	config["polyphony"] = _polyphony;
+	config["version"] = SiONDriver::get_version();
+
+	Dictionary result;
+	result["config"] = config;
+	result["channels"] = run_channels();
+	result["effects"] = run_effects();
+	result["mml_compile"] = run_mml_compile();
+	result["render"] = run_render();
+	return result;
+}
+
+//
+
+void SiONBenchmark::set_block_frames(int p_frames) {
+	ERR_FAIL_COND_MSG(p_frames < 32 || p_frames > 8192, "SiONBenchmark: Block size must be between 32 and 8192 frames.");
+	if (_block_frames == p_frames) {
+		return;
+	}
+
+	// The driver's buffer length is fixed at creation, so recreate it lazily.
+	_block_frames = p_frames;
+	_free_driver();
+}
+
+void SiONBenchmark::set_blocks(int p_blocks) {
+	ERR_FAIL_COND_MSG(p_blocks <= 0, "SiONBenchmark: Block count must be positive.");
+	_blocks = p_blocks;
+}
+
+void SiONBenchmark::set_warmup_blocks(int p_blocks) {
+	ERR_FAIL_COND_MSG(p_blocks < 0, "SiONBenchmark: Warmup block count cannot be negative.");
+	_warmup_blocks = p_blocks;
+}
+
+void SiONBenchmark::set_polyphony(int p_polyphony) {
+	ERR_FAIL_COND_MSG(p_polyphony <= 0, "SiONBenchmark: Polyphony must be positive.");
+	_polyphony = p_polyphony;
+}
+
+void SiONBenchmark::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("run_channels"), &SiONBenchmark::run_channels);
+	ClassDB::bind_method(D_METHOD("run_effects"), &SiONBenchmark::run_effects);
+	ClassDB::bind_method(D_METHOD("run_mml_compile", "mml", "repeats"), &SiONBenchmark::run_mml_compile, DEFVAL(String()), DEFVAL(50));
+	ClassDB::bind_method(D_METHOD("run_render"), &SiONBenchmark::run_render);
+	ClassDB::bind_method(D_METHOD("run_all"), &SiONBenchmark::run_all);
+
+	ClassDB::bind_method(D_METHOD("get_block_frames"), &SiONBenchmark::get_block_frames);
+	ClassDB::bind_method(D_METHOD("set_block_frames", "frames"), &SiONBenchmark::set_block_frames);
+	ClassDB::bind_method(D_METHOD("get_blocks"), &SiONBenchmark::get_blocks);
+	ClassDB::bind_method(D_METHOD("set_blocks", "blocks"), &SiONBenchmark::set_blocks);
+	ClassDB::bind_method(D_METHOD("get_warmup_blocks"), &SiONBenchmark::get_warmup_blocks);
+	ClassDB::bind_method(D_METHOD("set_warmup_blocks", "blocks"), &SiONBenchmark::set_warmup_blocks);
+	ClassDB::bind_method(D_METHOD("get_polyphony"), &SiONBenchmark::get_polyphony);
+	ClassDB::bind_method(D_METHOD("set_polyphony", "polyphony"), &SiONBenchmark::set_polyphony);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "block_frames"), "set_block_frames", "get_block_frames");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "blocks"), "set_blocks", "get_blocks");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "warmup_blocks"), "set_warmup_blocks", "get_warmup_blocks");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "polyphony"), "set_polyphony", "get_polyphony");
+}
+
+SiONBenchmark::~SiONBenchmark() {
+	_free_driver();
+}
+
+#endif // SION_BENCHMARKS
@@ -0,0 +1,95 @@
+/***************************************************/
+/* Part of GDSiON software synthesizer             */
+/* Copyright (c) 2024 Yuri Sizov and contributors  */
+/* Provided under MIT                              */
+/***************************************************/
+
+#ifndef SION_BENCHMARK_H
+#define SION_BENCHMARK_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/templates/vector.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "chip/channels/siopm_channel_manager.h"
+#include "chip/wave/siopm_wave_stream_data.h"
+#include "sion_voice.h"
+
+using namespace godot;
+
+class SiONDriver;
+
+// Headless micro-benchmarks for the synthesis engine. Only compiled into builds
+// configured with "benchmarks=yes" (which defines SION_BENCHMARKS).
+//
+// The benchmark owns a private SiONDriver created without Godot audio output, and
+// pulls audio through render_interleaved() — the same entrypoint native backends use —
+// so no audio device or scene tree is needed. Every run_* method returns a Dictionary
+// of plain numbers that serializes directly to JSON:
+//
+//   var bench = SiONBenchmark.new()
+//   bench.set_polyphony(8)
+//   var result = bench.run_all()
+//   print(JSON.stringify(result, "\t"))
+//
+// Timings are wall clock. "ns_per_sample" is nanoseconds per output frame (one
+// stereo sample pair), and "realtime_factor" is rendered audio time divided by
+// the time it took to render it. See tests/bench.gd for the command-line runner.
+class SiONBenchmark : public RefCounted {
+	GDCLASS(SiONBenchmark, RefCounted)
+
+	static const int SAMPLE_RATE = 48000;
+
+	SiONDriver *_driver = nullptr;
+	Vector<float> _output;
+	Vector<double> _effect_buffer;
+
+	int _block_frames = 512;
+	int _blocks = 200;
+	int _warmup_blocks = 16;
+	int _polyphony = 8;
+
+	bool _ensure_driver();
+	void _free_driver();
+	void _restart_stream();
+
+	static String _get_channel_name(SiOPMChannelManager::ChannelType p_type);
+	Ref<SiONVoice> _create_channel_voice(SiOPMChannelManager::ChannelType p_type, const Ref<SiOPMWaveStreamData> &p_stream) const;
+	PackedFloat32Array _make_test_tone(int p_frames) const;
+	int _get_test_note(int p_voice_index) const;
+
+	// Renders warmup then timed blocks, feeding the live stream (if any) outside of the timed region.
+	uint64_t _time_render(const Ref<SiOPMWaveStreamData> &p_stream = Ref<SiOPMWaveStreamData>());
+	Dictionary _make_result(uint64_t p_elapsed_ns, int64_t p_frames) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	// Measures each SiOPMChannelManager::ChannelType at the configured polyphony,
+	// plus an idle baseline with no voices sounding.
+	Dictionary run_channels();
+	// Measures each effect registered with SiEffector in isolation on a stereo noise buffer.
+	Dictionary run_effects();
+	// Measures MML compilation. An empty string uses a built-in multi-track reference song.
+	Dictionary run_mml_compile(const String &p_mml = String(), int p_repeats = 50);
+	// Measures the full render block: FM voices at the configured polyphony through
+	// a master reverb and compressor.
+	Dictionary run_render();
+	// Runs every suite above and returns them together with the configuration used.
+	Dictionary run_all();
+
+	int get_block_frames() const { return _block_frames; }
+	void set_block_frames(int p_frames);
+	int get_blocks() const { return _blocks; }
+	void set_blocks(int p_blocks);
+	int get_warmup_blocks() const { return _warmup_blocks; }
+	void set_warmup_blocks(int p_blocks);
+	int get_polyphony() const { return _polyphony; }
+	void set_polyphony(int p_polyphony);
+
+	SiONBenchmark() {}
+	~SiONBenchmark();
+};
+
+#endif // SION_BENCHMARK_H
@@ -1169,7 +1169,7 @@ void SiONVoicePresetUtil::_register_wave_table(Vector<int> p_wavelet) {
 	// Register in the persistent custom wave table storage so
 	// set_pulse_generator_type(PULSE_CUSTOM + index) can load the correct wave
 	// table at runtime. This allows SCC voices to work without voice-level
-	// wave_data — the operator resolves the wave table from the global stencil
+	// wave_data — the operator resolves the wave table from the global custom tables
 	// via its PG type alone.
 	SiOPMRefTable::get_instance()->register_scc_wave_table(index, table);
 }
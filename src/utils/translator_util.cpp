@@ -136,6 +136,8 @@ void TranslatorUtil::_set_siopm_params_by_array(const Ref<SiOPMChannelParams> &p
 		op_params->initial_phase              = _sanitize_param_loop(p_data[data_index++], -1, 255, "PH");        // 14
 		op_params->fixed_pitch                = (_sanitize_param_loop(p_data[data_index++], 0, 127, "FN")) << 6;  // 15
 	}
+
+	p_params->mark_changed();
 }
 
 void TranslatorUtil::_set_opl_params_by_array(const Ref<SiOPMChannelParams> &p_params, Vector<int> p_data) {
@@ -179,6 +181,8 @@ void TranslatorUtil::_set_opl_params_by_array(const Ref<SiOPMChannelParams> &p_p
 		op_params->set_multiple((i == 11 || i == 13) ? (i - 1) : (i == 14) ? (i + 1) : i);                                    // 10
 		op_params->amplitude_modulation_shift = _sanitize_param_loop(p_data[data_index++], 0, 3,  "AM");                      // 11
 	}
+
+	p_params->mark_changed();
 }
 
 void TranslatorUtil::_set_opm_params_by_array(const Ref<SiOPMChannelParams> &p_params, Vector<int> p_data) {
@@ -216,6 +220,8 @@ void TranslatorUtil::_set_opm_params_by_array(const Ref<SiOPMChannelParams> &p_p
 		op_params->detune2 = SiOPMRefTable::get_instance()->dt2_table[n];                                            // 10
 		op_params->amplitude_modulation_shift = _sanitize_param_loop(p_data[data_index++], 0, 3, "AM");              // 11
 	}
+
+	p_params->mark_changed();
 }
 
 void TranslatorUtil::_set_opn_params_by_array(const Ref<SiOPMChannelParams> &p_params, Vector<int> p_data) {
@@ -251,6 +257,8 @@ void TranslatorUtil::_set_opn_params_by_array(const Ref<SiOPMChannelParams> &p_p
 		op_params->detune1                    = _sanitize_param_loop(p_data[data_index++], 0, 7,   "D1");            // 9
 		op_params->amplitude_modulation_shift = _sanitize_param_loop(p_data[data_index++], 0, 3,   "AM");            // 10
 	}
+
+	p_params->mark_changed();
 }
 
 void TranslatorUtil::_set_opx_params_by_array(const Ref<SiOPMChannelParams> &p_params, Vector<int> p_data) {
@@ -298,6 +306,8 @@ void TranslatorUtil::_set_opx_params_by_array(const Ref<SiOPMChannelParams> &p_p
 		op_params->detune2                    = p_data[data_index++];                                                 // 11
 		op_params->amplitude_modulation_shift = _sanitize_param_loop(p_data[data_index++], 0, 3,   "AM");             // 12
 	}
+
+	p_params->mark_changed();
 }
 
 void TranslatorUtil::_set_ma3_params_by_array(const Ref<SiOPMChannelParams> &p_params, Vector<int> p_data) {
@@ -339,6 +349,8 @@ void TranslatorUtil::_set_ma3_params_by_array(const Ref<SiOPMChannelParams> &p_p
 		op_params->detune1                           = _sanitize_param_loop(p_data[data_index++], 0, 7, "D1");            // 11
 		op_params->amplitude_modulation_shift        = _sanitize_param_loop(p_data[data_index++], 0, 3, "AM");            // 12
 	}
+
+	p_params->mark_changed();
 }
 
 void TranslatorUtil::_set_al_params_by_array(const Ref<SiOPMChannelParams> &p_params, Vector<int> p_data) {
@@ -364,7 +376,7 @@ void TranslatorUtil::_set_al_params_by_array(const Ref<SiOPMChannelParams> &p_pa
 	op_params1->set_pulse_generator_type(_sanitize_param_loop(p_data[2], 0, 511, "W2"));
 
 	int balance = _sanitize_param_clamp(p_data[3], -64, 64, "BL");
-	int (&tl_table)[129] = SiOPMRefTable::get_instance()->eg_linear_to_total_level_table;
+	const int (&tl_table)[129] = SiOPMRefTable::get_instance()->eg_linear_to_total_level_table;
 	op_params0->total_level = tl_table[64 - balance];
 	op_params1->total_level = tl_table[balance + 64];
 
@@ -376,6 +388,8 @@ void TranslatorUtil::_set_al_params_by_array(const Ref<SiOPMChannelParams> &p_pa
 	op_params0->sustain_rate  = 0;
 	op_params0->release_rate  = _sanitize_param_loop(p_data[8], 0, 63, "RR");
 	op_params0->sustain_level = _sanitize_param_loop(p_data[7], 0, 15, "SL");
+
+	p_params->mark_changed();
 }
 
 void TranslatorUtil::parse_siopm_params(const Ref<SiOPMChannelParams> &p_params, const String &p_data_string) {
@@ -451,6 +465,8 @@ void TranslatorUtil::parse_ks_params(const Ref<SiOPMChannelParams> &p_params, co
 	op0->detune2 = 0;
 	op0->initial_phase = 0;
 	op0->fixed_pitch = (r_fixed_pitch << 6);
+
+	p_params->mark_changed();
 }
 
 void TranslatorUtil::set_siopm_params(const Ref<SiOPMChannelParams> &p_params, Vector<int> p_data) {
@@ -549,7 +565,7 @@ int TranslatorUtil::_balance_total_levels(int p_level0, int p_level1) {
 		return 64;
 	}
 
-	int (&tl_table)[129] = SiOPMRefTable::get_instance()->eg_linear_to_total_level_table;
+	const int (&tl_table)[129] = SiOPMRefTable::get_instance()->eg_linear_to_total_level_table;
 	for (int i = 1; i < 128; i++) {
 		if (p_level0 >= tl_table[i]) {
 			return i - 64;
@@ -1604,7 +1620,6 @@ String TranslatorUtil::get_voice_setting_as_mml(const Ref<SiMMLVoice> &p_voice)
 
 TranslatorUtil::MMLTableNumbers TranslatorUtil::parse_table_numbers(String p_table_numbers, String p_postfix, int p_max_index) {
 	MMLTableNumbers parsed_table;
-	parsed_table.data = memnew(SinglyLinkedList<int>);
 
 	// Magnification.
 	Ref<RegEx> re_postfix = RegEx::create_from_string("(\\d+)?(\\*(-?[\\d.]+))?([+-][\\d.]+)?");
@@ -1629,8 +1644,10 @@ TranslatorUtil::MMLTableNumbers TranslatorUtil::parse_table_numbers(String p_tab
 	Ref<RegEx> re_table = RegEx::create_from_string("(\\(\\s*([,\\-\\d\\s]+)\\)[,\\s]*(\\d+))|(-?\\d+)|(\\||\\[|\\](\\d*))");
 	TypedArray<RegExMatch> numbers = re_table->search_all(p_table_numbers);
 
-	SinglyLinkedList<int>::Element *repeat = nullptr;
-	List<SinglyLinkedList<int>::Element *> loop_stack;
+	// Positions are indices into parsed_table.data: the repeat point is where playback
+	// continues after the end, loop starts are where each [...] section begins.
+	int repeat = -1;
+	List<int> loop_stack;
 
 	int index = 0;
 	for (int n = 0; n < numbers.size() && index < p_max_index; n++) {
@@ -1661,7 +1678,7 @@ TranslatorUtil::MMLTableNumbers TranslatorUtil::parse_table_numbers(String p_tab
 					value = (int)(value * postfix_coef + postfix_offset + 0.5);
 
 					for (int j = 0; j < postfix_size; j++) {
-						parsed_table.data->append(value);
+						parsed_table.data.push_back(value);
 					}
 					index += postfix_size;
 
@@ -1672,7 +1689,7 @@ TranslatorUtil::MMLTableNumbers TranslatorUtil::parse_table_numbers(String p_tab
 
 				for (int i = 0; i < inter_size && index < p_max_index; i++) {
 					for (int j = 0; j < postfix_size; j++) {
-						parsed_table.data->append(value);
+						parsed_table.data.push_back(value);
 					}
 					index += postfix_size;
 				}
@@ -1684,7 +1701,7 @@ TranslatorUtil::MMLTableNumbers TranslatorUtil::parse_table_numbers(String p_tab
 			value = (int)(value * postfix_coef + postfix_offset + 0.5);
 
 			for (int j = 0; j < postfix_size; j++) {
-				parsed_table.data->append(value);
+				parsed_table.data.push_back(value);
 			}
 			index++;
 
@@ -1694,20 +1711,22 @@ TranslatorUtil::MMLTableNumbers TranslatorUtil::parse_table_numbers(String p_tab
 
 			// Loop repeat point.
 			if (token == "|") {
-				repeat = parsed_table.data->get();
+				if (!parsed_table.data.is_empty()) {
+					repeat = parsed_table.data.size();
+				}
 
 			// Loop start.
 			} else if (token == "[") {
-				loop_stack.push_back(parsed_table.data->get());
+				loop_stack.push_back(parsed_table.data.size());
 
 			// Loop end.
 			} else {
 				ERR_FAIL_COND_V_MSG(loop_stack.is_empty(), parsed_table, "Translator: Failed to parse provided MML table, loop data is invalid.");
 
-				SinglyLinkedList<int>::Element *loop_tail = parsed_table.data->get();
-				SinglyLinkedList<int>::Element *loop_head = (loop_stack.back()->get())->next();
+				int loop_head = loop_stack.back()->get();
+				int loop_end = parsed_table.data.size();
 				loop_stack.pop_back();
-				ERR_FAIL_COND_V_MSG(!loop_head, parsed_table, "Translator: Failed to parse provided MML table, loop data is invalid.");
+				ERR_FAIL_COND_V_MSG(loop_head >= loop_end, parsed_table, "Translator: Failed to parse provided MML table, loop data is invalid.");
 
 				int loop_count = 2;
 				if (!parsed_number->get_string(6).is_empty()) {
@@ -1715,8 +1734,8 @@ TranslatorUtil::MMLTableNumbers TranslatorUtil::parse_table_numbers(String p_tab
 				}
 
 				for (int j = loop_count; j > 0; j--) {
-					for (SinglyLinkedList<int>::Element *l = loop_head; l != loop_tail->next(); l = l->next()) {
-						parsed_table.data->append(l->value);
+					for (int l = loop_head; l < loop_end; l++) {
+						parsed_table.data.push_back(parsed_table.data[l]);
 					}
 				}
 			}
@@ -1725,12 +1744,13 @@ TranslatorUtil::MMLTableNumbers TranslatorUtil::parse_table_numbers(String p_tab
 		}
 	}
 
-	if (repeat) {
-		parsed_table.data->loop(repeat->next());
+	if (repeat >= 0) {
+		// A repeat point at the very end loops the whole table.
+		parsed_table.loop_index = (repeat < parsed_table.data.size() ? repeat : 0);
 	}
 
 	parsed_table.length = index;
-	parsed_table.repeated = (repeat != nullptr);
+	parsed_table.repeated = (repeat >= 0);
 	return parsed_table;
 }
 
@@ -1744,12 +1764,15 @@ void TranslatorUtil::parse_wav(String p_table_numbers, String p_postfix, Vector<
 	r_data->resize_zeroed(data_length);
 
 	int i = 0;
-	table.data->front();
-	for (; i < data_length && table.data->get(); i++) {
-		double value = (table.data->get()->value + 0.5) * 0.0078125;
+	int position = (table.data.is_empty() ? -1 : 0);
+	for (; i < data_length && position >= 0; i++) {
+		double value = (table.data[position] + 0.5) * 0.0078125;
 		r_data->write[i] = CLAMP(value, -1, 1);
 
-		table.data->next();
+		position++;
+		if (position >= table.data.size()) {
+			position = table.loop_index;
+		}
 	}
 
 	for (; i < data_length; i++) {
@@ -1850,6 +1873,7 @@ bool TranslatorUtil::parse_pcm_voice(const Ref<SiMMLVoice> &p_voice, String p_mm
 	op_params->sustain_rate = sustain_rate;
 	op_params->release_rate = release_rate;
 	op_params->sustain_level = sustain_level;
+	op_params->mark_changed();
 
 	table->set_key_scale_volume(volume_note_number, volume_key_range, volume_range);
 	table->set_key_scale_pan(pan_note_number, pan_key_range, pan_width);
@@ -12,7 +12,6 @@
 #include <godot_cpp/templates/vector.hpp>
 #include <godot_cpp/variant/string.hpp>
 #include "sequencer/base/mml_system_command.h"
-#include "templates/singly_linked_list.h"
 
 using namespace godot;
 
@@ -106,7 +105,8 @@ public:
 	static List<Ref<MMLSystemCommand>> extract_system_command(String p_mml);
 
 	struct MMLTableNumbers {
-		SinglyLinkedList<int> *data = nullptr;
+		Vector<int> data;
+		int loop_index = -1; // Where playback continues after the last value; -1 for none.
 		int length = 0;
 		bool repeated = false;
 	};
@@ -6,35 +6,44 @@
 
 #include "waveform_native_builder.h"
 
+#include <godot_cpp/classes/dir_access.hpp>
 #include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/memory.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include "chip/wave/siopm_wave_decoder.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstring>
 #include <cstdint>
+#include <thread>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SION_PEAKS_SSE 1
+#include <xmmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SION_PEAKS_NEON 1
+#include <arm_neon.h>
+#endif
+
 using namespace godot;
 
 namespace {
 
-static constexpr uint32_t WAV_RIFF = 0x46464952;
-static constexpr uint32_t WAV_WAVE = 0x45564157;
-static constexpr uint32_t WAV_FMT = 0x20746D66;
-static constexpr uint32_t WAV_DATA = 0x61746164;
-static constexpr int WAV_FORMAT_PCM = 1;
-static constexpr int WAV_FORMAT_FLOAT = 3;
-
-struct WavInfo {
-	int audio_format = 0;
-	int channel_count = 0;
-	int sample_rate = 0;
-	int bits_per_sample = 0;
-	int bytes_per_frame = 0;
-	int64_t data_offset = 0;
-	int64_t data_size = 0;
-	int frame_count = 0;
-};
+// Frames decoded per read. Keeps the working set small no matter how long the file is.
+static constexpr int DECODE_CHUNK_FRAMES = 16384;
+// Frames handed to a build thread at a time. Rounded up to whole stage 0 bins, so no
+// two threads ever write the same bin.
+static constexpr int BUILD_CHUNK_FRAMES = 1 << 20;
+// Upper bound on build threads; past this the disk is the bottleneck anyway.
+static constexpr int MAX_BUILD_THREADS = 16;
+
+static constexpr uint32_t PEAK_FILE_MAGIC = 0x4B415053; // "SPAK"
+static const char *PEAK_FILE_EXTENSION = ".sionpeaks";
+static const char *PEAK_FILE_FALLBACK_DIRECTORY = "user://sion_peaks";
 
 struct PeakStageData {
 	int frames_per_bin = 1;
@@ -47,6 +56,7 @@ Dictionary _make_empty_result() {
 	Dictionary result;
 	result["loaded"] = false;
 	result["load_failed"] = false;
+	result["from_cache"] = false;
 	result["sample_rate"] = 0;
 	result["channel_count"] = 0;
 	result["frame_count"] = 0;
@@ -57,113 +67,6 @@ Dictionary _make_empty_result() {
 	return result;
 }
 
-float _decode_wave_sample(const uint8_t *p_raw, int p_byte_index, const WavInfo &p_info) {
-	if (p_info.audio_format == WAV_FORMAT_PCM) {
-		switch (p_info.bits_per_sample) {
-			case 8:
-				return float(int(p_raw[p_byte_index]) - 128) / 128.0f;
-			case 16: {
-				int16_t sample = int16_t(uint16_t(p_raw[p_byte_index]) | (uint16_t(p_raw[p_byte_index + 1]) << 8));
-				return float(sample) / 32768.0f;
-			}
-			case 24: {
-				int32_t sample = int32_t(p_raw[p_byte_index])
-					| (int32_t(p_raw[p_byte_index + 1]) << 8)
-					| (int32_t(int8_t(p_raw[p_byte_index + 2])) << 16);
-				return float(sample) / 8388608.0f;
-			}
-			case 32: {
-				int32_t sample = int32_t(uint32_t(p_raw[p_byte_index])
-					| (uint32_t(p_raw[p_byte_index + 1]) << 8)
-					| (uint32_t(p_raw[p_byte_index + 2]) << 16)
-					| (uint32_t(p_raw[p_byte_index + 3]) << 24));
-				return float(sample) / 2147483648.0f;
-			}
-		}
-	} else if (p_info.audio_format == WAV_FORMAT_FLOAT && p_info.bits_per_sample == 32) {
-		float sample = 0.0f;
-		memcpy(&sample, p_raw + p_byte_index, sizeof(float));
-		return sample;
-	}
-	return 0.0f;
-}
-
-bool _parse_wav_header(const Ref<FileAccess> &p_file, WavInfo &r_info) {
-	if (p_file.is_null()) {
-		return false;
-	}
-
-	p_file->seek(0);
-	uint32_t riff_id = p_file->get_32();
-	p_file->get_32();
-	uint32_t wave_id = p_file->get_32();
-	if (riff_id != WAV_RIFF || wave_id != WAV_WAVE) {
-		return false;
-	}
-
-	bool found_fmt = false;
-	bool found_data = false;
-	int audio_format = 0;
-
-	while (p_file->get_position() < p_file->get_length() - 8) {
-		uint32_t chunk_id = p_file->get_32();
-		uint32_t chunk_size = p_file->get_32();
-		int64_t chunk_start = p_file->get_position();
-
-		if (chunk_id == WAV_FMT) {
-			if (chunk_size < 16) {
-				return false;
-			}
-
-			audio_format = p_file->get_16();
-			r_info.audio_format = audio_format;
-			r_info.channel_count = p_file->get_16();
-			r_info.sample_rate = p_file->get_32();
-			p_file->get_32();
-			p_file->get_16();
-			r_info.bits_per_sample = p_file->get_16();
-
-			if (audio_format != WAV_FORMAT_PCM && audio_format != WAV_FORMAT_FLOAT) {
-				return false;
-			}
-			if (r_info.channel_count < 1 || r_info.channel_count > 2) {
-				return false;
-			}
-			if (audio_format == WAV_FORMAT_PCM) {
-				if (r_info.bits_per_sample != 8 && r_info.bits_per_sample != 16 && r_info.bits_per_sample != 24 && r_info.bits_per_sample != 32) {
-					return false;
-				}
-			} else if (r_info.bits_per_sample != 32) {
-				return false;
-			}
-
-			r_info.bytes_per_frame = r_info.channel_count * (r_info.bits_per_sample / 8);
-			found_fmt = true;
-		} else if (chunk_id == WAV_DATA) {
-			r_info.data_offset = p_file->get_position();
-			r_info.data_size = chunk_size;
-			found_data = true;
-		}
-
-		int64_t next_pos = chunk_start + chunk_size;
-		if (chunk_size & 1) {
-			next_pos++;
-		}
-		p_file->seek(next_pos);
-
-		if (found_fmt && found_data) {
-			break;
-		}
-	}
-
-	if (!found_fmt || !found_data || r_info.bytes_per_frame <= 0) {
-		return false;
-	}
-
-	r_info.frame_count = int(r_info.data_size / r_info.bytes_per_frame);
-	return r_info.frame_count > 0;
-}
-
 std::vector<PeakStageData> _create_stages(int p_frame_count, int p_channel_count, int p_stage0_frames_per_bin, int p_peak_stage_scale) {
 	std::vector<PeakStageData> stages;
 	if (p_frame_count <= 0) {
@@ -240,6 +143,292 @@ Array _serialize_stages(const std::vector<PeakStageData> &p_stages) {
 	return stages;
 }
 
+PackedFloat32Array _to_packed_floats(const std::vector<float> &p_values) {
+	PackedFloat32Array packed;
+	packed.resize((int64_t)p_values.size());
+	if (!p_values.empty()) {
+		memcpy(packed.ptrw(), p_values.data(), p_values.size() * sizeof(float));
+	}
+	return packed;
+}
+
+// Fold interleaved mono or stereo frames into running per-channel minimums and maximums.
+// Four samples are compared at a time; with two channels each vector holds two whole
+// frames, so lane k always carries channel k % channel_count.
+void _reduce_min_max(const float *p_frames, int p_frame_count, int p_channel_count, float *r_mins, float *r_maxs) {
+	const int sample_count = p_frame_count * p_channel_count;
+	int i = 0;
+
+#if defined(SION_PEAKS_SSE) || defined(SION_PEAKS_NEON)
+	if (sample_count >= 8) {
+		float lane_mins[4];
+		float lane_maxs[4];
+		for (int k = 0; k < 4; k++) {
+			lane_mins[k] = r_mins[k % p_channel_count];
+			lane_maxs[k] = r_maxs[k % p_channel_count];
+		}
+
+#if defined(SION_PEAKS_SSE)
+		__m128 min_vector = _mm_loadu_ps(lane_mins);
+		__m128 max_vector = _mm_loadu_ps(lane_maxs);
+		for (; i + 4 <= sample_count; i += 4) {
+			__m128 values = _mm_loadu_ps(p_frames + i);
+			min_vector = _mm_min_ps(min_vector, values);
+			max_vector = _mm_max_ps(max_vector, values);
+		}
+		_mm_storeu_ps(lane_mins, min_vector);
+		_mm_storeu_ps(lane_maxs, max_vector);
+#else
+		float32x4_t min_vector = vld1q_f32(lane_mins);
+		float32x4_t max_vector = vld1q_f32(lane_maxs);
+		for (; i + 4 <= sample_count; i += 4) {
+			float32x4_t values = vld1q_f32(p_frames + i);
+			min_vector = vminq_f32(min_vector, values);
+			max_vector = vmaxq_f32(max_vector, values);
+		}
+		vst1q_f32(lane_mins, min_vector);
+		vst1q_f32(lane_maxs, max_vector);
+#endif
+
+		for (int k = 0; k < 4; k++) {
+			int channel = k % p_channel_count;
+			r_mins[channel] = std::min(r_mins[channel], lane_mins[k]);
+			r_maxs[channel] = std::max(r_maxs[channel], lane_maxs[k]);
+		}
+	}
+#endif
+
+	// i is a multiple of four here, so it still starts on a frame boundary.
+	for (; i < sample_count; i++) {
+		int channel = i % p_channel_count;
+		r_mins[channel] = std::min(r_mins[channel], p_frames[i]);
+		r_maxs[channel] = std::max(r_maxs[channel], p_frames[i]);
+	}
+}
+
+// Shared state of a multi-threaded build. Output pointers come from the main thread,
+// and each chunk writes a disjoint range of them.
+struct PeakBuildJob {
+	String file_path;
+	int frame_count = 0;
+	int channel_count = 1;
+	int stage0_frames_per_bin = 1;
+	int chunk_frames = 1;
+	int chunk_count = 0;
+	int polyline_frame_stride = 1;
+	int polyline_sample_count = 0;
+
+	float *stage0_mins = nullptr;
+	float *stage0_maxs = nullptr;
+	float *polyline = nullptr;
+
+	std::atomic<int> next_chunk = { 0 };
+	std::atomic<bool> failed = { false };
+};
+
+void _build_chunks(PeakBuildJob *p_job, SiOPMWaveDecoder *p_decoder) {
+	const int channel_count = p_job->channel_count;
+	const int frames_per_bin = p_job->stage0_frames_per_bin;
+	const int64_t stride = p_job->polyline_frame_stride;
+	std::vector<float> decoded(size_t(DECODE_CHUNK_FRAMES) * size_t(channel_count));
+
+	while (!p_job->failed.load(std::memory_order_relaxed)) {
+		int chunk_index = p_job->next_chunk.fetch_add(1, std::memory_order_relaxed);
+		if (chunk_index >= p_job->chunk_count) {
+			break;
+		}
+
+		int64_t chunk_start = int64_t(chunk_index) * p_job->chunk_frames;
+		int64_t chunk_end = std::min(chunk_start + p_job->chunk_frames, int64_t(p_job->frame_count));
+
+		float bin_mins[2] = { INFINITY, INFINITY };
+		float bin_maxs[2] = { -INFINITY, -INFINITY };
+		int64_t bin_start = chunk_start;
+
+		for (int64_t read_start = chunk_start; read_start < chunk_end;) {
+			int read_count = int(std::min(int64_t(DECODE_CHUNK_FRAMES), chunk_end - read_start));
+			int decoded_count = p_decoder->read_frames(read_start, read_count, decoded.data());
+			if (decoded_count < read_count) {
+				// The file got shorter since the header was read. Pad with silence so
+				// the stages stay consistent with the frame count reported.
+				std::fill(decoded.begin() + size_t(std::max(0, decoded_count)) * channel_count, decoded.end(), 0.0f);
+			}
+
+			// Stage 0 bins. A bin may continue into the next read, but never into the
+			// next chunk.
+			int offset = 0;
+			while (offset < read_count) {
+				int64_t bin_end = std::min(bin_start + frames_per_bin, chunk_end);
+				int segment = int(std::min(int64_t(read_count - offset), bin_end - (read_start + offset)));
+				_reduce_min_max(decoded.data() + size_t(offset) * channel_count, segment, channel_count, bin_mins, bin_maxs);
+				offset += segment;
+
+				if (read_start + offset == bin_end) {
+					int64_t value_index = (bin_start / frames_per_bin) * channel_count;
+					for (int channel = 0; channel < channel_count; channel++) {
+						p_job->stage0_mins[value_index + channel] = bin_mins[channel];
+						p_job->stage0_maxs[value_index + channel] = bin_maxs[channel];
+						bin_mins[channel] = INFINITY;
+						bin_maxs[channel] = -INFINITY;
+					}
+					bin_start = bin_end;
+				}
+			}
+
+			// Polyline samples are taken from every stride-th frame.
+			int64_t read_end = read_start + read_count;
+			for (int64_t frame_index = ((read_start + stride - 1) / stride) * stride; frame_index < read_end; frame_index += stride) {
+				int64_t polyline_index = frame_index / stride;
+				if (polyline_index >= p_job->polyline_sample_count) {
+					break;
+				}
+				const float *frame = decoded.data() + size_t(frame_index - read_start) * channel_count;
+				p_job->polyline[polyline_index] = (channel_count == 1) ? frame[0] : ((frame[0] + frame[1]) * 0.5f);
+			}
+
+			read_start = read_end;
+		}
+	}
+}
+
+void _build_thread_func(PeakBuildJob *p_job) {
+	// Decoders aren't thread-safe, so each thread opens the file on its own.
+	SiOPMWaveDecoder *decoder = SiOPMWaveDecoder::create_for_file(p_job->file_path);
+	if (!decoder) {
+		p_job->failed.store(true, std::memory_order_relaxed);
+		return;
+	}
+	_build_chunks(p_job, decoder);
+	memdelete(decoder);
+}
+
+// Peak file reading and writing.
+
+bool _read_floats(const Ref<FileAccess> &p_file, int64_t p_count, PackedFloat32Array &r_values) {
+	int64_t byte_count = p_count * int64_t(sizeof(float));
+	// Check against what's left in the file first, so a corrupt count can't trigger a huge allocation.
+	if (p_count < 0 || byte_count > int64_t(p_file->get_length() - p_file->get_position())) {
+		return false;
+	}
+	PackedByteArray bytes = p_file->get_buffer(byte_count);
+	if (bytes.size() != byte_count) {
+		return false;
+	}
+	r_values = bytes.to_float32_array();
+	return true;
+}
+
+bool _read_peak_file(const String &p_peak_path, uint64_t p_source_size, uint64_t p_source_modified_time, int p_stage0_frames_per_bin, int p_peak_stage_scale, int p_max_polyline_cache_samples, Dictionary &r_result) {
+	Ref<FileAccess> file = FileAccess::open(p_peak_path, FileAccess::READ);
+	if (file.is_null()) {
+		return false;
+	}
+
+	if (file->get_32() != PEAK_FILE_MAGIC || file->get_32() != WaveformNativeBuilder::PEAK_FILE_VERSION) {
+		return false;
+	}
+	if (file->get_64() != p_source_size || file->get_64() != p_source_modified_time) {
+		return false;
+	}
+	if (int(file->get_32()) != p_stage0_frames_per_bin || int(file->get_32()) != p_peak_stage_scale || int(file->get_32()) != p_max_polyline_cache_samples) {
+		return false;
+	}
+
+	int sample_rate = int(file->get_32());
+	int channel_count = int(file->get_32());
+	int64_t frame_count = int64_t(file->get_64());
+	int polyline_frame_stride = int(file->get_32());
+	int polyline_sample_count = int(file->get_32());
+	if (sample_rate <= 0 || channel_count < 1 || channel_count > 2 || frame_count <= 0 || frame_count > INT32_MAX || polyline_frame_stride < 1) {
+		return false;
+	}
+
+	PackedFloat32Array polyline_samples;
+	if (!_read_floats(file, polyline_sample_count, polyline_samples)) {
+		return false;
+	}
+
+	int stage_count = int(file->get_32());
+	if (stage_count < 1 || stage_count > 64) {
+		return false;
+	}
+
+	Array stages;
+	for (int i = 0; i < stage_count; i++) {
+		int frames_per_bin = int(file->get_32());
+		int bin_count = int(file->get_32());
+		if (frames_per_bin < 1 || bin_count != int((frame_count + frames_per_bin - 1) / frames_per_bin)) {
+			return false;
+		}
+
+		Dictionary stage_dict;
+		PackedFloat32Array mins;
+		PackedFloat32Array maxs;
+		if (!_read_floats(file, int64_t(bin_count) * channel_count, mins) || !_read_floats(file, int64_t(bin_count) * channel_count, maxs)) {
+			return false;
+		}
+		stage_dict["frames_per_bin"] = frames_per_bin;
+		stage_dict["bin_count"] = bin_count;
+		stage_dict["mins"] = mins;
+		stage_dict["maxs"] = maxs;
+		stages.push_back(stage_dict);
+	}
+
+	// Anything left over means the file isn't what this version wrote.
+	if (file->get_position() != file->get_length()) {
+		return false;
+	}
+
+	r_result = _make_empty_result();
+	r_result["loaded"] = true;
+	r_result["from_cache"] = true;
+	r_result["sample_rate"] = sample_rate;
+	r_result["channel_count"] = channel_count;
+	r_result["frame_count"] = int(frame_count);
+	r_result["duration_sec"] = double(frame_count) / double(sample_rate);
+	r_result["polyline_frame_stride"] = polyline_frame_stride;
+	r_result["polyline_samples"] = polyline_samples;
+	r_result["stages"] = stages;
+	return true;
+}
+
+bool _write_peak_file(const String &p_peak_path, uint64_t p_source_size, uint64_t p_source_modified_time, int p_stage0_frames_per_bin, int p_peak_stage_scale, int p_max_polyline_cache_samples, const Dictionary &p_result) {
+	Ref<FileAccess> file = FileAccess::open(p_peak_path, FileAccess::WRITE);
+	if (file.is_null()) {
+		return false;
+	}
+
+	PackedFloat32Array polyline_samples = p_result["polyline_samples"];
+	Array stages = p_result["stages"];
+
+	file->store_32(PEAK_FILE_MAGIC);
+	file->store_32(WaveformNativeBuilder::PEAK_FILE_VERSION);
+	file->store_64(p_source_size);
+	file->store_64(p_source_modified_time);
+	file->store_32(uint32_t(p_stage0_frames_per_bin));
+	file->store_32(uint32_t(p_peak_stage_scale));
+	file->store_32(uint32_t(p_max_polyline_cache_samples));
+	file->store_32(uint32_t(int(p_result["sample_rate"])));
+	file->store_32(uint32_t(int(p_result["channel_count"])));
+	file->store_64(uint64_t(int64_t(p_result["frame_count"])));
+	file->store_32(uint32_t(int(p_result["polyline_frame_stride"])));
+	file->store_32(uint32_t(polyline_samples.size()));
+	file->store_buffer(polyline_samples.to_byte_array());
+
+	file->store_32(uint32_t(stages.size()));
+	for (int i = 0; i < stages.size(); i++) {
+		Dictionary stage_dict = stages[i];
+		PackedFloat32Array mins = stage_dict["mins"];
+		PackedFloat32Array maxs = stage_dict["maxs"];
+		file->store_32(uint32_t(int(stage_dict["frames_per_bin"])));
+		file->store_32(uint32_t(int(stage_dict["bin_count"])));
+		file->store_buffer(mins.to_byte_array());
+		file->store_buffer(maxs.to_byte_array());
+	}
+
+	return file->get_error() == OK;
+}
+
 } // namespace
 
 void WaveformNativeBuilder::_bind_methods() {
@@ -250,8 +439,90 @@ void WaveformNativeBuilder::_bind_methods() {
 		DEFVAL(262144),
 		DEFVAL(3)
 	);
+
+	ClassDB::bind_method(
+		D_METHOD("begin_incremental", "sample_rate", "channel_count", "stage0_frames_per_bin", "max_polyline_cache_samples", "peak_stage_shift_padding"),
+		&WaveformNativeBuilder::begin_incremental,
+		DEFVAL(64),
+		DEFVAL(262144),
+		DEFVAL(3)
+	);
+	ClassDB::bind_method(D_METHOD("append_frames", "interleaved", "frame_count"), &WaveformNativeBuilder::append_frames, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("get_incremental_result"), &WaveformNativeBuilder::get_incremental_result);
+	ClassDB::bind_method(D_METHOD("save_incremental_peaks", "source_path"), &WaveformNativeBuilder::save_incremental_peaks);
+	ClassDB::bind_method(D_METHOD("get_incremental_frame_count"), &WaveformNativeBuilder::get_incremental_frame_count);
+
+	ClassDB::bind_method(D_METHOD("get_use_peak_cache"), &WaveformNativeBuilder::get_use_peak_cache);
+	ClassDB::bind_method(D_METHOD("set_use_peak_cache", "enabled"), &WaveformNativeBuilder::set_use_peak_cache);
+	ClassDB::bind_method(D_METHOD("get_peak_cache_directory"), &WaveformNativeBuilder::get_peak_cache_directory);
+	ClassDB::bind_method(D_METHOD("set_peak_cache_directory", "path"), &WaveformNativeBuilder::set_peak_cache_directory);
+	ClassDB::bind_method(D_METHOD("get_thread_count"), &WaveformNativeBuilder::get_thread_count);
+	ClassDB::bind_method(D_METHOD("set_thread_count", "count"), &WaveformNativeBuilder::set_thread_count);
+
+	ClassDB::add_property("WaveformNativeBuilder", PropertyInfo(Variant::BOOL, "use_peak_cache"), "set_use_peak_cache", "get_use_peak_cache");
+	ClassDB::add_property("WaveformNativeBuilder", PropertyInfo(Variant::STRING, "peak_cache_directory"), "set_peak_cache_directory", "get_peak_cache_directory");
+	ClassDB::add_property("WaveformNativeBuilder", PropertyInfo(Variant::INT, "thread_count"), "set_thread_count", "get_thread_count");
+}
+
+void WaveformNativeBuilder::set_thread_count(int p_count) {
+	_thread_count = CLAMP(p_count, 0, MAX_BUILD_THREADS);
+}
+
+// ---------------------------------------------------------------------------
+// Peak files
+// ---------------------------------------------------------------------------
+
+bool WaveformNativeBuilder::_get_peak_file_key(const String &p_source_path, PeakFileKey &r_key) const {
+	Ref<FileAccess> file = FileAccess::open(p_source_path, FileAccess::READ);
+	if (file.is_null()) {
+		return false;
+	}
+	r_key.source_size = file->get_length();
+	r_key.source_modified_time = FileAccess::get_modified_time(p_source_path);
+	return true;
 }
 
+String WaveformNativeBuilder::_get_peak_file_path(const String &p_source_path, bool p_fallback) const {
+	if (p_fallback) {
+		return String(PEAK_FILE_FALLBACK_DIRECTORY).path_join(p_source_path.md5_text() + PEAK_FILE_EXTENSION);
+	}
+	if (!_peak_cache_directory.is_empty()) {
+		return _peak_cache_directory.path_join(p_source_path.md5_text() + PEAK_FILE_EXTENSION);
+	}
+	return p_source_path + PEAK_FILE_EXTENSION;
+}
+
+bool WaveformNativeBuilder::_load_peak_file(const String &p_source_path, const PeakFileKey &p_key, Dictionary &r_result) const {
+	for (int i = 0; i < 2; i++) {
+		String peak_path = _get_peak_file_path(p_source_path, i == 1);
+		if (_read_peak_file(peak_path, p_key.source_size, p_key.source_modified_time, p_key.stage0_frames_per_bin, p_key.peak_stage_scale, p_key.max_polyline_cache_samples, r_result)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool WaveformNativeBuilder::_save_peak_file(const String &p_source_path, const PeakFileKey &p_key, const Dictionary &p_result) const {
+	String peak_path = _get_peak_file_path(p_source_path, false);
+	if (!_peak_cache_directory.is_empty() && !DirAccess::dir_exists_absolute(_peak_cache_directory)) {
+		DirAccess::make_dir_recursive_absolute(_peak_cache_directory);
+	}
+	if (_write_peak_file(peak_path, p_key.source_size, p_key.source_modified_time, p_key.stage0_frames_per_bin, p_key.peak_stage_scale, p_key.max_polyline_cache_samples, p_result)) {
+		return true;
+	}
+
+	// Not writable next to the source; keep it with the user data instead.
+	String fallback_path = _get_peak_file_path(p_source_path, true);
+	if (!DirAccess::dir_exists_absolute(PEAK_FILE_FALLBACK_DIRECTORY)) {
+		DirAccess::make_dir_recursive_absolute(PEAK_FILE_FALLBACK_DIRECTORY);
+	}
+	return _write_peak_file(fallback_path, p_key.source_size, p_key.source_modified_time, p_key.stage0_frames_per_bin, p_key.peak_stage_scale, p_key.max_polyline_cache_samples, p_result);
+}
+
+// ---------------------------------------------------------------------------
+// Building from files
+// ---------------------------------------------------------------------------
+
 Dictionary WaveformNativeBuilder::build_from_wav_path(
 	const String &p_file_path,
 	int p_stage0_frames_per_bin,
@@ -264,92 +535,83 @@ Dictionary WaveformNativeBuilder::build_from_wav_path(
 		return result;
 	}
 
-	Ref<FileAccess> file = FileAccess::open(p_file_path, FileAccess::READ);
-	if (file.is_null()) {
-		result["load_failed"] = true;
+	int safe_stage0_frames_per_bin = std::max(1, p_stage0_frames_per_bin);
+	int safe_max_polyline_cache_samples = std::max(1, p_max_polyline_cache_samples);
+	int safe_shift_padding = std::max(1, p_peak_stage_shift_padding);
+	int peak_stage_scale = 1 << std::min(safe_shift_padding, 8);
+
+	PeakFileKey key;
+	key.stage0_frames_per_bin = safe_stage0_frames_per_bin;
+	key.peak_stage_scale = peak_stage_scale;
+	key.max_polyline_cache_samples = safe_max_polyline_cache_samples;
+	bool has_key = _use_peak_cache && _get_peak_file_key(p_file_path, key);
+	if (has_key && _load_peak_file(p_file_path, key, result)) {
 		return result;
 	}
 
-	WavInfo info;
-	if (!_parse_wav_header(file, info)) {
+	// Frames are decoded in chunks straight from the file (memory-mapped when possible),
+	// so even hour-long recordings are never held in memory as a whole. Any format with
+	// a decoder works, despite the method name.
+	SiOPMWaveDecoder *decoder = SiOPMWaveDecoder::create_for_file(p_file_path);
+	if (!decoder) {
 		result["load_failed"] = true;
 		return result;
 	}
 
-	file->seek(info.data_offset);
-	PackedByteArray raw_data = file->get_buffer(info.data_size);
-	int actual_frame_count = int(raw_data.size() / info.bytes_per_frame);
+	const SiOPMWaveDecoder::Info info = decoder->get_info();
+	int actual_frame_count = int(std::min(info.frame_count, int64_t(INT32_MAX)));
 	if (actual_frame_count <= 0) {
+		memdelete(decoder);
 		result["load_failed"] = true;
 		return result;
 	}
 
-	int safe_stage0_frames_per_bin = std::max(1, p_stage0_frames_per_bin);
-	int safe_max_polyline_cache_samples = std::max(1, p_max_polyline_cache_samples);
-	int safe_shift_padding = std::max(1, p_peak_stage_shift_padding);
-	int peak_stage_scale = 1 << std::min(safe_shift_padding, 8);
 	int polyline_frame_stride = std::max(1, int((actual_frame_count + safe_max_polyline_cache_samples - 1) / safe_max_polyline_cache_samples));
 	int polyline_sample_count = int((actual_frame_count + polyline_frame_stride - 1) / polyline_frame_stride);
 
 	PackedFloat32Array polyline_samples;
 	polyline_samples.resize(polyline_sample_count);
-	float *polyline_write = polyline_samples.ptrw();
 
 	std::vector<PeakStageData> stages = _create_stages(actual_frame_count, info.channel_count, safe_stage0_frames_per_bin, peak_stage_scale);
 	if (stages.empty()) {
+		memdelete(decoder);
 		result["load_failed"] = true;
 		return result;
 	}
 
-	PeakStageData &stage0 = stages[0];
-	float *stage0_mins = stage0.mins.ptrw();
-	float *stage0_maxs = stage0.maxs.ptrw();
-
-	const uint8_t *raw = raw_data.ptr();
-	int last_frame_index = actual_frame_count - 1;
-	int base_frames_seen = 0;
-	float base_min_left = INFINITY;
-	float base_max_left = -INFINITY;
-	float base_min_right = INFINITY;
-	float base_max_right = -INFINITY;
-	int stage0_bin_index = 0;
-	int polyline_index = 0;
-
-	for (int frame_index = 0; frame_index < actual_frame_count; ++frame_index) {
-		int byte_index = frame_index * info.bytes_per_frame;
-		float left = _decode_wave_sample(raw, byte_index, info);
-		float right = left;
-		if (info.channel_count > 1) {
-			right = _decode_wave_sample(raw, byte_index + (info.bits_per_sample / 8), info);
-		}
-
-		if ((frame_index % polyline_frame_stride) == 0 && polyline_index < polyline_sample_count) {
-			polyline_write[polyline_index++] = (info.channel_count == 1) ? left : ((left + right) * 0.5f);
-		}
-
-		base_min_left = std::min(base_min_left, left);
-		base_max_left = std::max(base_max_left, left);
-		base_min_right = std::min(base_min_right, right);
-		base_max_right = std::max(base_max_right, right);
-		base_frames_seen++;
+	PeakBuildJob job;
+	job.file_path = p_file_path;
+	job.frame_count = actual_frame_count;
+	job.channel_count = info.channel_count;
+	job.stage0_frames_per_bin = safe_stage0_frames_per_bin;
+	job.chunk_frames = int(std::min(int64_t(INT32_MAX), ((int64_t(BUILD_CHUNK_FRAMES) + safe_stage0_frames_per_bin - 1) / safe_stage0_frames_per_bin) * safe_stage0_frames_per_bin));
+	job.chunk_count = int((int64_t(actual_frame_count) + job.chunk_frames - 1) / job.chunk_frames);
+	job.polyline_frame_stride = polyline_frame_stride;
+	job.polyline_sample_count = polyline_sample_count;
+	job.stage0_mins = stages[0].mins.ptrw();
+	job.stage0_maxs = stages[0].maxs.ptrw();
+	job.polyline = polyline_samples.ptrw();
+
+	int thread_count = _thread_count > 0 ? _thread_count : int(std::thread::hardware_concurrency());
+	thread_count = CLAMP(thread_count, 1, MAX_BUILD_THREADS);
+	thread_count = std::min(thread_count, job.chunk_count);
+
+	// The calling thread works too, with the decoder it already has.
+	std::vector<std::thread> threads;
+	for (int i = 1; i < thread_count; i++) {
+		threads.push_back(std::thread(_build_thread_func, &job));
+	}
+	_build_chunks(&job, decoder);
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
 
-		if (base_frames_seen < safe_stage0_frames_per_bin && frame_index != last_frame_index) {
-			continue;
-		}
+	memdelete(decoder);
+	decoder = nullptr;
 
-		int value_index = stage0_bin_index * std::max(1, info.channel_count);
-		stage0_mins[value_index] = base_min_left;
-		stage0_maxs[value_index] = base_max_left;
-		if (info.channel_count > 1) {
-			stage0_mins[value_index + 1] = base_min_right;
-			stage0_maxs[value_index + 1] = base_max_right;
-		}
-		stage0_bin_index++;
-		base_frames_seen = 0;
-		base_min_left = INFINITY;
-		base_max_left = -INFINITY;
-		base_min_right = INFINITY;
-		base_max_right = -INFINITY;
+	if (job.failed.load()) {
+		result["load_failed"] = true;
+		return result;
 	}
 
 	_merge_stages(stages, info.channel_count, peak_stage_scale);
@@ -363,5 +625,181 @@ Dictionary WaveformNativeBuilder::build_from_wav_path(
 	result["polyline_frame_stride"] = polyline_frame_stride;
 	result["polyline_samples"] = polyline_samples;
 	result["stages"] = _serialize_stages(stages);
+
+	if (has_key) {
+		_save_peak_file(p_file_path, key, result);
+	}
 	return result;
-}
\ No newline at end of file
+}
+
+// ---------------------------------------------------------------------------
+// Incremental building
+// ---------------------------------------------------------------------------
+
+void WaveformNativeBuilder::begin_incremental(int p_sample_rate, int p_channel_count, int p_stage0_frames_per_bin, int p_max_polyline_cache_samples, int p_peak_stage_shift_padding) {
+	_incremental_active = false;
+	_incremental_frame_count = 0;
+	_incremental_stages.clear();
+	_incremental_polyline.clear();
+	_incremental_polyline_stride = 1;
+
+	ERR_FAIL_COND_MSG(p_sample_rate <= 0, "WaveformNativeBuilder: Sample rate must be positive.");
+	ERR_FAIL_COND_MSG(p_channel_count < 1 || p_channel_count > 2, "WaveformNativeBuilder: Only mono and stereo audio is supported.");
+
+	_incremental_sample_rate = p_sample_rate;
+	_incremental_channel_count = p_channel_count;
+	_incremental_max_polyline_samples = std::max(1, p_max_polyline_cache_samples);
+	_incremental_peak_stage_scale = 1 << std::min(std::max(1, p_peak_stage_shift_padding), 8);
+
+	IncrementalStage stage0;
+	stage0.frames_per_bin = std::max(1, p_stage0_frames_per_bin);
+	_incremental_stages.push_back(stage0);
+	_incremental_active = true;
+}
+
+void WaveformNativeBuilder::_fold_incremental_bin(int64_t p_first_frame, const float *p_mins, const float *p_maxs) {
+	// Every stage's open bin is kept up to date, so results can be taken at any time.
+	for (IncrementalStage &stage : _incremental_stages) {
+		size_t value_index = size_t(p_first_frame / stage.frames_per_bin) * _incremental_channel_count;
+		if (stage.mins.size() <= value_index) {
+			stage.mins.insert(stage.mins.end(), p_mins, p_mins + _incremental_channel_count);
+			stage.maxs.insert(stage.maxs.end(), p_maxs, p_maxs + _incremental_channel_count);
+			continue;
+		}
+
+		for (int channel = 0; channel < _incremental_channel_count; channel++) {
+			stage.mins[value_index + channel] = std::min(stage.mins[value_index + channel], p_mins[channel]);
+			stage.maxs[value_index + channel] = std::max(stage.maxs[value_index + channel], p_maxs[channel]);
+		}
+	}
+}
+
+void WaveformNativeBuilder::_grow_incremental_stages() {
+	// Same rule as a file build: keep adding coarser stages until one bin covers everything.
+	while (_incremental_stages.back().frames_per_bin < _incremental_frame_count) {
+		const IncrementalStage &previous = _incremental_stages.back();
+		int64_t next_frames_per_bin = int64_t(previous.frames_per_bin) * _incremental_peak_stage_scale;
+		if (next_frames_per_bin > INT32_MAX) {
+			break;
+		}
+
+		IncrementalStage stage;
+		stage.frames_per_bin = int(next_frames_per_bin);
+		size_t previous_bin_count = previous.mins.size() / _incremental_channel_count;
+		for (size_t start = 0; start < previous_bin_count; start += _incremental_peak_stage_scale) {
+			size_t end = std::min(start + _incremental_peak_stage_scale, previous_bin_count);
+			for (int channel = 0; channel < _incremental_channel_count; channel++) {
+				float min_value = previous.mins[start * _incremental_channel_count + channel];
+				float max_value = previous.maxs[start * _incremental_channel_count + channel];
+				for (size_t bin = start + 1; bin < end; bin++) {
+					min_value = std::min(min_value, previous.mins[bin * _incremental_channel_count + channel]);
+					max_value = std::max(max_value, previous.maxs[bin * _incremental_channel_count + channel]);
+				}
+				stage.mins.push_back(min_value);
+				stage.maxs.push_back(max_value);
+			}
+		}
+		_incremental_stages.push_back(stage);
+	}
+}
+
+int WaveformNativeBuilder::append_frames(const PackedFloat32Array &p_interleaved, int p_frame_count) {
+	ERR_FAIL_COND_V_MSG(!_incremental_active, 0, "WaveformNativeBuilder: Call begin_incremental() before appending frames.");
+
+	const int channel_count = _incremental_channel_count;
+	int frame_count = int(p_interleaved.size() / channel_count);
+	if (p_frame_count > 0) {
+		frame_count = std::min(frame_count, p_frame_count);
+	}
+	frame_count = int(std::min(int64_t(frame_count), int64_t(INT32_MAX) - _incremental_frame_count));
+	if (frame_count <= 0) {
+		return 0;
+	}
+
+	const float *frames = p_interleaved.ptr();
+	const int stage0_frames_per_bin = _incremental_stages[0].frames_per_bin;
+
+	int offset = 0;
+	while (offset < frame_count) {
+		// Reduce up to the end of the current stage 0 bin, then fold that into every stage.
+		int64_t segment_start = _incremental_frame_count;
+		int segment = std::min(frame_count - offset, stage0_frames_per_bin - int(segment_start % stage0_frames_per_bin));
+		const float *segment_frames = frames + size_t(offset) * channel_count;
+
+		float segment_mins[2] = { INFINITY, INFINITY };
+		float segment_maxs[2] = { -INFINITY, -INFINITY };
+		_reduce_min_max(segment_frames, segment, channel_count, segment_mins, segment_maxs);
+		_fold_incremental_bin(segment_start, segment_mins, segment_maxs);
+
+		// When the polyline outgrows its budget, drop every other sample and double
+		// the stride, so it covers the whole recording at a coarser resolution.
+		int64_t polyline_frame = int64_t(_incremental_polyline.size()) * _incremental_polyline_stride;
+		while (polyline_frame < segment_start + segment) {
+			const float *frame = segment_frames + size_t(polyline_frame - segment_start) * channel_count;
+			_incremental_polyline.push_back((channel_count == 1) ? frame[0] : ((frame[0] + frame[1]) * 0.5f));
+
+			if (int(_incremental_polyline.size()) > _incremental_max_polyline_samples) {
+				size_t kept = 0;
+				for (size_t i = 0; i < _incremental_polyline.size(); i += 2) {
+					_incremental_polyline[kept++] = _incremental_polyline[i];
+				}
+				_incremental_polyline.resize(kept);
+				_incremental_polyline_stride *= 2;
+			}
+			polyline_frame = int64_t(_incremental_polyline.size()) * _incremental_polyline_stride;
+		}
+
+		_incremental_frame_count += segment;
+		offset += segment;
+	}
+
+	_grow_incremental_stages();
+	return frame_count;
+}
+
+Dictionary WaveformNativeBuilder::get_incremental_result() const {
+	Dictionary result = _make_empty_result();
+	if (!_incremental_active || _incremental_frame_count <= 0) {
+		return result;
+	}
+
+	Array stages;
+	for (const IncrementalStage &stage : _incremental_stages) {
+		Dictionary stage_dict;
+		stage_dict["frames_per_bin"] = stage.frames_per_bin;
+		stage_dict["bin_count"] = int(stage.mins.size() / _incremental_channel_count);
+		stage_dict["mins"] = _to_packed_floats(stage.mins);
+		stage_dict["maxs"] = _to_packed_floats(stage.maxs);
+		stages.push_back(stage_dict);
+	}
+
+	result["loaded"] = true;
+	result["sample_rate"] = _incremental_sample_rate;
+	result["channel_count"] = _incremental_channel_count;
+	result["frame_count"] = int(_incremental_frame_count);
+	result["duration_sec"] = double(_incremental_frame_count) / double(_incremental_sample_rate);
+	result["polyline_frame_stride"] = _incremental_polyline_stride;
+	result["polyline_samples"] = _to_packed_floats(_incremental_polyline);
+	result["stages"] = stages;
+	return result;
+}
+
+bool WaveformNativeBuilder::save_incremental_peaks(const String &p_source_path) const {
+	ERR_FAIL_COND_V_MSG(!_incremental_active || _incremental_frame_count <= 0, false, "WaveformNativeBuilder: No incremental peaks to save.");
+
+	// Only tie the peaks to a file that holds exactly the audio they describe.
+	SiOPMWaveDecoder *decoder = SiOPMWaveDecoder::create_for_file(p_source_path);
+	ERR_FAIL_NULL_V_MSG(decoder, false, "WaveformNativeBuilder: Cannot open '" + p_source_path + "' to save its peaks.");
+	SiOPMWaveDecoder::Info info = decoder->get_info();
+	memdelete(decoder);
+	ERR_FAIL_COND_V_MSG(info.frame_count != _incremental_frame_count || info.channel_count != _incremental_channel_count, false, "WaveformNativeBuilder: '" + p_source_path + "' doesn't match the appended audio.");
+
+	PeakFileKey key;
+	key.stage0_frames_per_bin = _incremental_stages[0].frames_per_bin;
+	key.peak_stage_scale = _incremental_peak_stage_scale;
+	key.max_polyline_cache_samples = _incremental_max_polyline_samples;
+	if (!_get_peak_file_key(p_source_path, key)) {
+		return false;
+	}
+	return _save_peak_file(p_source_path, key, get_incremental_result());
+}
@@ -9,16 +9,76 @@
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <cstdint>
+#include <vector>
 
 using namespace godot;
 
+// Builds multi-resolution min/max peak overviews of audio files for timeline display.
+//
+// Files are scanned in chunks by several threads at once, each with its own decoder.
+// Finished overviews are saved to a versioned peak file, keyed by the source's size
+// and modification time and by the build parameters, and reused on later opens. By
+// default the peak file sits next to the source as "<file>.sionpeaks"; when that
+// location isn't writable (a res:// path in an exported project, for example) it
+// goes to "user://sion_peaks/" instead.
+//
+// For audio that is still growing, such as a capture of the driver output or a live
+// stream, begin_incremental() starts an overview that append_frames() extends.
 class WaveformNativeBuilder : public RefCounted {
 	GDCLASS(WaveformNativeBuilder, RefCounted)
 
+public:
+	// Bumped whenever the peak file layout changes; files of other versions are rebuilt.
+	static constexpr uint32_t PEAK_FILE_VERSION = 1;
+
+private:
+	struct PeakFileKey {
+		uint64_t source_size = 0;
+		uint64_t source_modified_time = 0;
+		int stage0_frames_per_bin = 0;
+		int peak_stage_scale = 0;
+		int max_polyline_cache_samples = 0;
+	};
+
+	struct IncrementalStage {
+		int frames_per_bin = 1;
+		std::vector<float> mins; // Interleaved by channel; the last bin may be partial.
+		std::vector<float> maxs;
+	};
+
+	bool _use_peak_cache = true;
+	String _peak_cache_directory; // Empty: next to the source file.
+	int _thread_count = 0;        // 0: one per processor.
+
+	// Incremental overview state.
+	bool _incremental_active = false;
+	int _incremental_sample_rate = 0;
+	int _incremental_channel_count = 0;
+	int _incremental_peak_stage_scale = 8;
+	int _incremental_max_polyline_samples = 0;
+	int64_t _incremental_frame_count = 0;
+	std::vector<IncrementalStage> _incremental_stages;
+	std::vector<float> _incremental_polyline;
+	int _incremental_polyline_stride = 1;
+
+	bool _get_peak_file_key(const String &p_source_path, PeakFileKey &r_key) const;
+	String _get_peak_file_path(const String &p_source_path, bool p_fallback) const;
+	bool _load_peak_file(const String &p_source_path, const PeakFileKey &p_key, Dictionary &r_result) const;
+	bool _save_peak_file(const String &p_source_path, const PeakFileKey &p_key, const Dictionary &p_result) const;
+
+	void _fold_incremental_bin(int64_t p_first_frame, const float *p_mins, const float *p_maxs);
+	void _grow_incremental_stages();
+
 protected:
 	static void _bind_methods();
 
 public:
+	// Builds (or loads from the peak file) the overview of any file a SiOPMWaveDecoder
+	// supports. The name predates support for formats other than WAV.
 	Dictionary build_from_wav_path(
 		const String &p_file_path,
 		int p_stage0_frames_per_bin = 64,
@@ -26,8 +86,26 @@ public:
 		int p_peak_stage_shift_padding = 3
 	);
 
+	// Start an overview of audio that arrives in pieces. Replaces any previous one.
+	void begin_incremental(int p_sample_rate, int p_channel_count, int p_stage0_frames_per_bin = 64, int p_max_polyline_cache_samples = 262144, int p_peak_stage_shift_padding = 3);
+	// Append interleaved frames. Returns the number of frames appended.
+	int append_frames(const PackedFloat32Array &p_interleaved, int p_frame_count = 0);
+	// The overview so far, in the same format as build_from_wav_path().
+	Dictionary get_incremental_result() const;
+	// Save the incremental overview as the peak file of p_source_path, once the audio
+	// has been written there, so opening that file later reuses it.
+	bool save_incremental_peaks(const String &p_source_path) const;
+	int64_t get_incremental_frame_count() const { return _incremental_frame_count; }
+
+	bool get_use_peak_cache() const { return _use_peak_cache; }
+	void set_use_peak_cache(bool p_enabled) { _use_peak_cache = p_enabled; }
+	String get_peak_cache_directory() const { return _peak_cache_directory; }
+	void set_peak_cache_directory(const String &p_path) { _peak_cache_directory = p_path; }
+	int get_thread_count() const { return _thread_count; }
+	void set_thread_count(int p_count);
+
 	WaveformNativeBuilder() {}
 	~WaveformNativeBuilder() {}
 };
 
-#endif // SION_WAVEFORM_NATIVE_BUILDER_H
\ No newline at end of file
+#endif // SION_WAVEFORM_NATIVE_BUILDER_H
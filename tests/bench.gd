@@ -0,0 +1,74 @@
+###################################################
+# Part of GDSiON tests                            #
+# Copyright (c) 2024 Yuri Sizov and contributors  #
+# Provided under MIT                              #
+###################################################
+
+# Headless benchmark runner. Requires a library built with "benchmarks=yes".
+#
+#   godot --headless --path tests --script res://bench.gd -- --output bench.json
+#
+# Optional arguments: --polyphony N, --blocks N, --block-frames N.
+# Without --output the JSON report is printed to stdout.
+
+extends SceneTree
+
+
+func _init():
+	# Delay everything by one frame so the initialization is complete before we run benchmarks.
+	await process_frame
+
+	if not ClassDB.class_exists("SiONBenchmark"):
+		printerr("Fatal Error: SiONBenchmark is not available. Rebuild the library with 'benchmarks=yes'.")
+		quit(2)
+		return
+
+	var args := _get_args()
+
+	var bench: RefCounted = ClassDB.instantiate("SiONBenchmark")
+	if args.has("polyphony"):
+		bench.polyphony = int(args["polyphony"])
+	if args.has("blocks"):
+		bench.blocks = int(args["blocks"])
+	if args.has("block-frames"):
+		bench.block_frames = int(args["block-frames"])
+
+	var result: Dictionary = bench.run_all()
+	bench = null
+
+	var json := JSON.stringify(result, "\t")
+	if not args.has("output"):
+		print(json)
+		quit(0)
+		return
+
+	var output_path: String = args["output"]
+	var file := FileAccess.open(output_path, FileAccess.WRITE)
+	if not file:
+		printerr("Fatal Error: Unable to write the report to '%s' (code %d)." % [ output_path, FileAccess.get_open_error() ])
+		quit(2)
+		return
+
+	file.store_string(json)
+	file.close()
+	print("Benchmark report written to '%s'." % [ output_path ])
+	quit(0)
+
+
+func _get_args() -> Dictionary:
+	var values := {}
+
+	var args := OS.get_cmdline_user_args()
+	var i := 0
+	while i < args.size() - 1:
+		var arg_key := args[i]
+
+		if arg_key.begins_with("--"):
+			var arg_value := args[i + 1]
+			if not arg_value.begins_with("--"):
+				values[arg_key.substr(2)] = arg_value
+				i += 1
+
+		i += 1
+
+	return values